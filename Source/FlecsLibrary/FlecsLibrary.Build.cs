@@ -34,7 +34,9 @@ public class FlecsLibrary : ModuleRules
                 "FLECS_UNITS",
                 "FLECS_HTTP",
                 "FLECS_REST",
+                "FLECS_SPATIAL",
                 //"ECS_SIMD"
+                //"FLECS_MAP_OPEN_ADDRESSING"
             }
         );
         
@@ -7,6 +7,10 @@
 
 #ifdef FLECS_ALERTS
 
+#ifdef FLECS_STATS
+#include "stats/stats.h"
+#endif
+
 ECS_COMPONENT_DECLARE(FlecsAlerts);
 
 typedef struct EcsAlert {
@@ -23,6 +27,18 @@ typedef struct EcsAlert {
     ecs_primitive_kind_t kind;  /* Primitive type kind */
     ecs_ref_t ranges;           /* Reference to ranges component */
     int32_t var_id;             /* Variable from which to obtain data (0 = $this) */
+
+    /* Incremental evaluation */
+    bool incremental;           /* Only evaluate tables that changed */
+    int32_t change_count;       /* Number of times alert query changed */
+    int32_t instance_change_count; /* Last change count seen by instances */
+    int64_t instance_frame;     /* Last frame in which instances were evaluated */
+    bool instances_changed;     /* Did query change since last instance evaluation */
+
+    /* Evaluation statistics */
+    ecs_ftime_t time_spent;     /* Time spent evaluating alert */
+    int64_t tables_evaluated;   /* Number of tables evaluated */
+    int64_t tables_skipped;     /* Number of unchanged tables skipped */
 } EcsAlert;
 
 typedef struct EcsAlertTimeout {
@@ -37,6 +53,7 @@ ECS_CTOR(EcsAlert, ptr, {
     ecs_os_zeromem(ptr);
     ecs_map_init(&ptr->instances, NULL);
     ecs_vec_init_t(NULL, &ptr->severity_filters, ecs_alert_severity_filter_t, 0);
+    ptr->instance_frame = -1;
 })
 
 static
@@ -68,6 +85,14 @@ ECS_MOVE(EcsAlert, dst, src, {
     dst->kind = src->kind;
     dst->ranges = src->ranges;
     dst->var_id = src->var_id;
+    dst->incremental = src->incremental;
+    dst->change_count = src->change_count;
+    dst->instance_change_count = src->instance_change_count;
+    dst->instance_frame = src->instance_frame;
+    dst->instances_changed = src->instances_changed;
+    dst->time_spent = src->time_spent;
+    dst->tables_evaluated = src->tables_evaluated;
+    dst->tables_skipped = src->tables_skipped;
 })
 
 static
@@ -237,11 +262,52 @@ ecs_entity_t flecs_alert_out_of_range_kind(
     }
 }
 
+static
+bool flecs_alert_is_incremental(
+    const ecs_query_t *q,
+    const EcsAlert *alert)
+{
+    /* Change detection requires a query cache, and only tracks changes to the
+     * tables matched by $this. */
+    if (q->cache_kind == EcsQueryCacheNone) {
+        return false;
+    }
+
+    const ecs_flags32_t required = EcsQueryIsCacheable|
+        EcsQueryMatchOnlyThis|EcsQueryMatchOnlySelf;
+    if ((q->flags & required) != required) {
+        return false;
+    }
+
+    if (alert->var_id) {
+        return false;
+    }
+
+    int32_t i, count = ecs_vec_count(&alert->severity_filters);
+    ecs_alert_severity_filter_t *filters = 
+        ecs_vec_first(&alert->severity_filters);
+    for (i = 0; i < count; i ++) {
+        if (filters[i].var) {
+            return false;
+        }
+    }
+
+    /* Member values can be written in place without a modified call, which
+     * change detection can't see. Alerts that test a member value are always
+     * evaluated in full. */
+    if (alert->id) {
+        return false;
+    }
+
+    return true;
+}
+
 static
 void MonitorAlerts(ecs_iter_t *it) {
     ecs_world_t *world = it->real_world;
     EcsAlert *alert = ecs_field(it, EcsAlert, 0);
     EcsPoly *poly = ecs_field(it, EcsPoly, 1);
+    bool measure_time = world->flags & EcsWorldMeasureSystemTime;
 
     int32_t i, count = it->count;
     for (i = 0; i < count; i ++) {
@@ -261,10 +327,35 @@ void MonitorAlerts(ecs_iter_t *it) {
             ranges = ecs_ref_get(world, &alert[i].ranges, EcsMemberRanges);
         }
 
+        ecs_time_t t_start = {0};
+        if (measure_time) {
+            ecs_time_measure(&t_start);
+        }
+
+        /* If the alert is evaluated incrementally and nothing matched by the
+         * query changed since the last evaluation, there's nothing to do. */
+        if (alert[i].incremental) {
+            if (!ecs_query_changed(q)) {
+                alert[i].tables_skipped += flecs_query_cache_table_count(
+                    flecs_query_impl(q)->cache);
+                goto done;
+            }
+            alert[i].change_count ++;
+        }
+
         ecs_iter_t rit = ecs_query_iter(world, q);
         rit.flags |= EcsIterNoData;
 
         while (ecs_query_next(&rit)) {
+            if (alert[i].incremental && !ecs_iter_changed(&rit)) {
+                /* Table didn't change since last evaluation */
+                ecs_iter_skip(&rit);
+                alert[i].tables_skipped ++;
+                continue;
+            }
+
+            alert[i].tables_evaluated ++;
+
             ecs_entity_t severity = flecs_alert_get_severity(
                 world, &rit, &alert[i]);
             if (!severity) {
@@ -344,6 +435,11 @@ void MonitorAlerts(ecs_iter_t *it) {
                 }
             }
         }
+
+done:
+        if (measure_time) {
+            alert[i].time_spent += (ecs_ftime_t)ecs_time_measure(&t_start);
+        }
     }
 }
 
@@ -385,6 +481,24 @@ void MonitorAlertInstances(ecs_iter_t *it) {
         ranges = ecs_ref_get(world, &alert->ranges, EcsMemberRanges);
     }
 
+    ecs_time_t t_start = {0};
+    bool measure_time = world->flags & EcsWorldMeasureSystemTime;
+    if (measure_time) {
+        ecs_time_measure(&t_start);
+    }
+
+    /* Instances of an alert can be stored in multiple tables. Only test once
+     * per frame whether the alert query changed since the last evaluation. */
+    int64_t frame = world->info.frame_count_total;
+    if (alert->instance_frame != frame) {
+        alert->instance_frame = frame;
+        alert->instances_changed = 
+            alert->change_count != alert->instance_change_count;
+        alert->instance_change_count = alert->change_count;
+    }
+
+    bool unchanged = alert->incremental && !alert->instances_changed;
+
     ecs_script_vars_t *vars = ecs_script_vars_init(it->world);
     int32_t i, count = it->count;
     for (i = 0; i < count; i ++) {
@@ -398,74 +512,83 @@ void MonitorAlertInstances(ecs_iter_t *it) {
             continue;
         }
 
-        /* Check if alert instance still matches query */
-        ecs_iter_t rit = ecs_query_iter(world, query);
-        rit.flags |= EcsIterNoData;
-        ecs_iter_set_var(&rit, 0, e);
-
-        if (ecs_query_next(&rit)) {
-            bool match = true;
-
-            /* If alert is monitoring member range, test value against range */
-            if (ranges) {
-                ecs_entity_t member_src = e;
-                if (alert->var_id) {
-                    member_src = ecs_iter_get_var(&rit, alert->var_id);
-                }
+        if (unchanged) {
+            /* Nothing matched by the alert query changed since the instance
+             * was last evaluated, so its match state is also unchanged. */
+            if (!timeout || ECS_EQZERO(timeout[i].inactive_time)) {
+                value[i].value += (double)it->delta_system_time;
+                continue;
+            }
+        } else {
+            /* Check if alert instance still matches query */
+            ecs_iter_t rit = ecs_query_iter(world, query);
+            rit.flags |= EcsIterNoData;
+            ecs_iter_set_var(&rit, 0, e);
+
+            if (ecs_query_next(&rit)) {
+                bool match = true;
+
+                /* If alert is monitoring member range, test value against range */
+                if (ranges) {
+                    ecs_entity_t member_src = e;
+                    if (alert->var_id) {
+                        member_src = ecs_iter_get_var(&rit, alert->var_id);
+                    }
 
-                const void *member_data = ecs_get_id(
-                    world, member_src, member_id);
-                if (!member_data) {
-                    match = false;
-                } else {
-                    member_data = ECS_OFFSET(member_data, alert->offset);
-                    if (flecs_alert_out_of_range_kind(
-                        alert, ranges, member_data) == 0) 
-                    {
+                    const void *member_data = ecs_get_id(
+                        world, member_src, member_id);
+                    if (!member_data) {
                         match = false;
+                    } else {
+                        member_data = ECS_OFFSET(member_data, alert->offset);
+                        if (flecs_alert_out_of_range_kind(
+                            alert, ranges, member_data) == 0) 
+                        {
+                            match = false;
+                        }
                     }
                 }
-            }
 
-            if (match) {
-                /* Only increase alert duration if the alert was active */
-                value[i].value += (double)it->delta_system_time;
-
-                bool generate_message = alert->message;
-                if (generate_message) {
-                    if (alert_instance[i].message) {
-                        /* If a message was already generated, only regenerate if
-                        * query has multiple variables. Variable values could have 
-                        * changed, this ensures the message remains up to date. */
-                        generate_message = rit.variable_count > 1;
+                if (match) {
+                    /* Only increase alert duration if the alert was active */
+                    value[i].value += (double)it->delta_system_time;
+
+                    bool generate_message = alert->message;
+                    if (generate_message) {
+                        if (alert_instance[i].message) {
+                            /* If a message was already generated, only regenerate if
+                            * query has multiple variables. Variable values could have 
+                            * changed, this ensures the message remains up to date. */
+                            generate_message = rit.variable_count > 1;
+                        }
                     }
-                }
 
-                if (generate_message) {
-                    if (alert_instance[i].message) {
-                        ecs_os_free(alert_instance[i].message);
-                    }
+                    if (generate_message) {
+                        if (alert_instance[i].message) {
+                            ecs_os_free(alert_instance[i].message);
+                        }
 
-                    ecs_script_vars_from_iter(&rit, vars, 0);
-                    alert_instance[i].message = ecs_script_string_interpolate(
-                        world, alert->message, vars);
-                }
+                        ecs_script_vars_from_iter(&rit, vars, 0);
+                        alert_instance[i].message = ecs_script_string_interpolate(
+                            world, alert->message, vars);
+                    }
 
-                if (timeout) {
-                    if (ECS_NEQZERO(timeout[i].inactive_time)) {
-                        /* The alert just became active. Remove Disabled tag */
-                        flecs_alerts_add_alert_to_src(world, e, parent, ai);
-                        ecs_remove_id(world, ai, EcsDisabled);
+                    if (timeout) {
+                        if (ECS_NEQZERO(timeout[i].inactive_time)) {
+                            /* The alert just became active. Remove Disabled tag */
+                            flecs_alerts_add_alert_to_src(world, e, parent, ai);
+                            ecs_remove_id(world, ai, EcsDisabled);
+                        }
+                        timeout[i].inactive_time = 0;
                     }
-                    timeout[i].inactive_time = 0;
+
+                    /* Alert instance still matches query, keep it alive */
+                    ecs_iter_fini(&rit);
+                    continue;
                 }
 
-                /* Alert instance still matches query, keep it alive */
                 ecs_iter_fini(&rit);
-                continue;
             }
-
-            ecs_iter_fini(&rit);
         }
 
         /* Alert instance is no longer active */
@@ -491,6 +614,10 @@ void MonitorAlertInstances(ecs_iter_t *it) {
     }
 
     ecs_script_vars_fini(vars);
+
+    if (measure_time) {
+        alert->time_spent += (ecs_ftime_t)ecs_time_measure(&t_start);
+    }
 }
 
 ecs_entity_t ecs_alert_init(
@@ -619,6 +746,8 @@ ecs_entity_t ecs_alert_init(
         alert->var_id = var_id;
     }
 
+    alert->incremental = flecs_alert_is_incremental(q, alert);
+
     ecs_modified(world, result, EcsAlert);
 
     /* Register alert as metric */
@@ -706,6 +835,31 @@ error:
     return 0;
 }
 
+#ifdef FLECS_STATS
+
+bool flecs_alert_eval_stats_get(
+    const ecs_world_t *world,
+    ecs_entity_t alert,
+    ecs_alert_eval_stats_t *out)
+{
+    const EcsAlert *ptr = ecs_get(world, alert, EcsAlert);
+    if (!ptr) {
+        return false;
+    }
+
+    const EcsPoly *poly = ecs_get_pair(world, alert, EcsPoly, EcsQuery);
+    out->query = poly ? poly->poly : NULL;
+    out->time_spent = ptr->time_spent;
+    out->tables_evaluated = ptr->tables_evaluated;
+    out->tables_skipped = ptr->tables_skipped;
+    out->instance_count = ecs_map_count(&ptr->instances);
+    out->incremental = ptr->incremental;
+
+    return true;
+}
+
+#endif
+
 void FlecsAlertsImport(ecs_world_t *world) {
     ECS_MODULE_DEFINE(world, FlecsAlerts);
 
@@ -789,6 +943,19 @@ void FlecsAlertsImport(ecs_world_t *world) {
         .entity = ecs_id(MonitorAlertInstances),
         .interval = (ecs_ftime_t)0.5
     });
+
+#ifdef FLECS_STATS
+    /* Alert statistics are registered by whichever of the stats and alerts
+     * modules is imported last. */
+    ecs_entity_t stats = ecs_lookup(world, "flecs.stats");
+    if (stats) {
+        ecs_entity_t old_scope = ecs_set_scope(world, stats);
+        const char *old_prefix = ecs_set_name_prefix(world, "Ecs");
+        FlecsAlertMonitorImport(world);
+        ecs_set_name_prefix(world, old_prefix);
+        ecs_set_scope(world, old_scope);
+    }
+#endif
 }
 
 #endif
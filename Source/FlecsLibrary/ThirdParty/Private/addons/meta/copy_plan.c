@@ -0,0 +1,581 @@
+/**
+ * @file addons/meta/copy_plan.c
+ * @brief Compile serializer ops into flat programs that copy/convert values.
+ */
+
+#include "meta.h"
+
+#ifdef FLECS_META
+
+typedef enum ecs_meta_copy_op_kind_t {
+    EcsMetaCopyMemcpy,      /* memcpy size bytes */
+    EcsMetaCopyConvert,     /* Convert count primitive values */
+    EcsMetaCopyString,      /* Duplicate count strings */
+    EcsMetaCopyVector,      /* Copy vector with trivially copyable elements */
+    EcsMetaCopyHook         /* Copy count values with copy hook of type */
+} ecs_meta_copy_op_kind_t;
+
+typedef struct ecs_meta_copy_op_t {
+    ecs_meta_copy_op_kind_t kind;
+    ecs_size_t dst_offset;
+    ecs_size_t src_offset;
+    ecs_size_t size;                   /* Bytes for memcpy, element size for
+                                        * vector & convert */
+    ecs_size_t src_size;               /* Source element size for convert */
+    int32_t count;
+    ecs_meta_type_op_kind_t dst_kind;  /* Primitive kinds for convert */
+    ecs_meta_type_op_kind_t src_kind;
+    const ecs_type_info_t *ti;         /* Type info for hook */
+} ecs_meta_copy_op_t;
+
+struct ecs_meta_copy_plan_t {
+    ecs_vec_t ops;                     /* vector<ecs_meta_copy_op_t> */
+    ecs_size_t dst_size;
+    ecs_size_t src_size;
+    bool is_memcpy;                    /* Plan is a single memcpy of the value */
+};
+
+/* Value of a primitive while it's being converted */
+typedef struct ecs_meta_copy_num_t {
+    union {
+        int64_t i;
+        uint64_t u;
+        double f;
+    } is;
+    ecs_meta_type_op_kind_t kind;      /* EcsOpI64, EcsOpU64 or EcsOpF64 */
+} ecs_meta_copy_num_t;
+
+static
+ecs_meta_type_op_kind_t flecs_meta_copy_num_kind(
+    ecs_meta_type_op_kind_t kind)
+{
+    switch(kind) {
+    case EcsOpChar:
+    case EcsOpI8:
+    case EcsOpI16:
+    case EcsOpI32:
+    case EcsOpI64:
+    case EcsOpIPtr:
+        return EcsOpI64;
+    case EcsOpBool:
+    case EcsOpByte:
+    case EcsOpU8:
+    case EcsOpU16:
+    case EcsOpU32:
+    case EcsOpU64:
+    case EcsOpUPtr:
+    case EcsOpEntity:
+    case EcsOpId:
+        return EcsOpU64;
+    case EcsOpF32:
+    case EcsOpF64:
+        return EcsOpF64;
+    default:
+        return EcsOpPrimitive; /* Not a number */
+    }
+}
+
+static
+bool flecs_meta_copy_can_convert(
+    ecs_meta_type_op_kind_t dst,
+    ecs_meta_type_op_kind_t src)
+{
+    ecs_meta_type_op_kind_t dst_num = flecs_meta_copy_num_kind(dst);
+    ecs_meta_type_op_kind_t src_num = flecs_meta_copy_num_kind(src);
+    if (dst_num == EcsOpPrimitive || src_num == EcsOpPrimitive) {
+        return false;
+    }
+
+    /* Entities and ids can't be converted from/to floating point values */
+    bool dst_id = dst == EcsOpEntity || dst == EcsOpId;
+    bool src_id = src == EcsOpEntity || src == EcsOpId;
+    if ((dst_id && src_num == EcsOpF64) || (src_id && dst_num == EcsOpF64)) {
+        return false;
+    }
+
+    return true;
+}
+
+static
+ecs_meta_copy_num_t flecs_meta_copy_read(
+    ecs_meta_type_op_kind_t kind,
+    const void *ptr)
+{
+    ecs_meta_copy_num_t result = {0};
+    result.kind = flecs_meta_copy_num_kind(kind);
+
+    switch(kind) {
+    case EcsOpChar:   result.is.i = *(const ecs_char_t*)ptr; break;
+    case EcsOpI8:     result.is.i = *(const ecs_i8_t*)ptr; break;
+    case EcsOpI16:    result.is.i = *(const ecs_i16_t*)ptr; break;
+    case EcsOpI32:    result.is.i = *(const ecs_i32_t*)ptr; break;
+    case EcsOpI64:    result.is.i = *(const ecs_i64_t*)ptr; break;
+    case EcsOpIPtr:   result.is.i = *(const ecs_iptr_t*)ptr; break;
+    case EcsOpBool:   result.is.u = *(const ecs_bool_t*)ptr; break;
+    case EcsOpByte:   result.is.u = *(const ecs_byte_t*)ptr; break;
+    case EcsOpU8:     result.is.u = *(const ecs_u8_t*)ptr; break;
+    case EcsOpU16:    result.is.u = *(const ecs_u16_t*)ptr; break;
+    case EcsOpU32:    result.is.u = *(const ecs_u32_t*)ptr; break;
+    case EcsOpU64:    result.is.u = *(const ecs_u64_t*)ptr; break;
+    case EcsOpUPtr:   result.is.u = *(const ecs_uptr_t*)ptr; break;
+    case EcsOpEntity: result.is.u = *(const ecs_entity_t*)ptr; break;
+    case EcsOpId:     result.is.u = *(const ecs_id_t*)ptr; break;
+    case EcsOpF32:    result.is.f = (double)*(const ecs_f32_t*)ptr; break;
+    case EcsOpF64:    result.is.f = *(const ecs_f64_t*)ptr; break;
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
+
+    return result;
+}
+
+static
+int64_t flecs_meta_copy_to_int(
+    ecs_meta_copy_num_t v)
+{
+    if (v.kind == EcsOpF64) {
+        /* Out of range float to int conversions are undefined */
+        if (v.is.f <= (double)INT64_MIN) return INT64_MIN;
+        if (v.is.f >= (double)INT64_MAX) return INT64_MAX;
+        return (int64_t)v.is.f;
+    }
+    return v.is.i; /* Same bits for unsigned values */
+}
+
+static
+uint64_t flecs_meta_copy_to_uint(
+    ecs_meta_copy_num_t v)
+{
+    if (v.kind == EcsOpF64) {
+        if (v.is.f <= 0) return 0;
+        if (v.is.f >= (double)UINT64_MAX) return UINT64_MAX;
+        return (uint64_t)v.is.f;
+    }
+    return v.is.u;
+}
+
+static
+double flecs_meta_copy_to_float(
+    ecs_meta_copy_num_t v)
+{
+    if (v.kind == EcsOpI64) {
+        return (double)v.is.i;
+    } else if (v.kind == EcsOpU64) {
+        return (double)v.is.u;
+    }
+    return v.is.f;
+}
+
+static
+void flecs_meta_copy_write(
+    ecs_meta_type_op_kind_t kind,
+    void *ptr,
+    ecs_meta_copy_num_t v)
+{
+    switch(kind) {
+    case EcsOpChar:   *(ecs_char_t*)ptr = (ecs_char_t)flecs_meta_copy_to_int(v); break;
+    case EcsOpI8:     *(ecs_i8_t*)ptr = (ecs_i8_t)flecs_meta_copy_to_int(v); break;
+    case EcsOpI16:    *(ecs_i16_t*)ptr = (ecs_i16_t)flecs_meta_copy_to_int(v); break;
+    case EcsOpI32:    *(ecs_i32_t*)ptr = (ecs_i32_t)flecs_meta_copy_to_int(v); break;
+    case EcsOpI64:    *(ecs_i64_t*)ptr = flecs_meta_copy_to_int(v); break;
+    case EcsOpIPtr:   *(ecs_iptr_t*)ptr = (ecs_iptr_t)flecs_meta_copy_to_int(v); break;
+    case EcsOpByte:   *(ecs_byte_t*)ptr = (ecs_byte_t)flecs_meta_copy_to_uint(v); break;
+    case EcsOpU8:     *(ecs_u8_t*)ptr = (ecs_u8_t)flecs_meta_copy_to_uint(v); break;
+    case EcsOpU16:    *(ecs_u16_t*)ptr = (ecs_u16_t)flecs_meta_copy_to_uint(v); break;
+    case EcsOpU32:    *(ecs_u32_t*)ptr = (ecs_u32_t)flecs_meta_copy_to_uint(v); break;
+    case EcsOpU64:    *(ecs_u64_t*)ptr = flecs_meta_copy_to_uint(v); break;
+    case EcsOpUPtr:   *(ecs_uptr_t*)ptr = (ecs_uptr_t)flecs_meta_copy_to_uint(v); break;
+    case EcsOpEntity: *(ecs_entity_t*)ptr = flecs_meta_copy_to_uint(v); break;
+    case EcsOpId:     *(ecs_id_t*)ptr = flecs_meta_copy_to_uint(v); break;
+    case EcsOpF32:    *(ecs_f32_t*)ptr = (ecs_f32_t)flecs_meta_copy_to_float(v); break;
+    case EcsOpF64:    *(ecs_f64_t*)ptr = flecs_meta_copy_to_float(v); break;
+    case EcsOpBool:
+        if (v.kind == EcsOpF64) {
+            *(ecs_bool_t*)ptr = v.is.f != 0;
+        } else {
+            *(ecs_bool_t*)ptr = v.is.u != 0;
+        }
+        break;
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
+}
+
+static
+ecs_meta_copy_op_t* flecs_meta_copy_op_add(
+    ecs_meta_copy_plan_t *plan,
+    ecs_meta_copy_op_kind_t kind,
+    ecs_size_t dst_offset,
+    ecs_size_t src_offset)
+{
+    ecs_meta_copy_op_t *op = ecs_vec_append_t(NULL, &plan->ops,
+        ecs_meta_copy_op_t);
+    ecs_os_zeromem(op);
+    op->kind = kind;
+    op->dst_offset = dst_offset;
+    op->src_offset = src_offset;
+    op->count = 1;
+    return op;
+}
+
+static
+void flecs_meta_copy_add_memcpy(
+    ecs_meta_copy_plan_t *plan,
+    ecs_size_t dst_offset,
+    ecs_size_t src_offset,
+    ecs_size_t size)
+{
+    /* Merge with previous memcpy if both the source and destination ranges
+     * are adjacent, so a run of POD members is copied at once. */
+    ecs_meta_copy_op_t *last = NULL;
+    if (ecs_vec_count(&plan->ops)) {
+        last = ecs_vec_last_t(&plan->ops, ecs_meta_copy_op_t);
+    }
+
+    if (last && last->kind == EcsMetaCopyMemcpy) {
+        if ((last->dst_offset + last->size == dst_offset) &&
+            (last->src_offset + last->size == src_offset))
+        {
+            last->size += size;
+            return;
+        }
+    }
+
+    flecs_meta_copy_op_add(plan, EcsMetaCopyMemcpy, dst_offset, src_offset)
+        ->size = size;
+}
+
+static
+int flecs_meta_copy_compile(
+    const ecs_world_t *world,
+    ecs_meta_copy_plan_t *plan,
+    const ecs_meta_type_op_t *dst_op,
+    const ecs_meta_type_op_t *src_op,
+    ecs_size_t dst_base,
+    ecs_size_t src_base);
+
+static
+int flecs_meta_copy_compile_struct(
+    const ecs_world_t *world,
+    ecs_meta_copy_plan_t *plan,
+    const ecs_meta_type_op_t *dst_op,
+    const ecs_meta_type_op_t *src_op,
+    ecs_size_t dst_base,
+    ecs_size_t src_base)
+{
+    if (!dst_op->members || !src_op->members) {
+        return 0; /* Struct without members */
+    }
+
+    /* Member ops are between push & pop */
+    int32_t i, end = dst_op->op_count - 1;
+    for (i = 1; i < end; i += dst_op[i].op_count) {
+        const ecs_meta_type_op_t *dst_member = &dst_op[i];
+        ecs_assert(dst_member->name != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        const uint64_t *src_index = flecs_name_index_find_ptr(
+            src_op->members, dst_member->name, 0, 0);
+        if (!src_index) {
+            continue; /* Not in source type, leave value as is */
+        }
+
+        const ecs_meta_type_op_t *src_member =
+            &src_op[1 + flecs_uto(int32_t, src_index[0])];
+        if (flecs_meta_copy_compile(world, plan, dst_member, src_member,
+            dst_base, src_base))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static
+int flecs_meta_copy_compile_vector(
+    const ecs_world_t *world,
+    ecs_meta_copy_plan_t *plan,
+    const ecs_meta_type_op_t *dst_op,
+    const ecs_meta_type_op_t *src_op,
+    ecs_size_t dst_offset,
+    ecs_size_t src_offset,
+    int32_t count)
+{
+    const EcsVector *dst_vec = ecs_get(world, dst_op->type, EcsVector);
+    const EcsVector *src_vec = ecs_get(world, src_op->type, EcsVector);
+    ecs_assert(dst_vec != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(src_vec != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (dst_vec->type == src_vec->type) {
+        const ecs_type_info_t *elem_ti = ecs_get_type_info(
+            world, dst_vec->type);
+        ecs_assert(elem_ti != NULL, ECS_INTERNAL_ERROR, NULL);
+        if (!elem_ti->hooks.copy) {
+            int32_t i;
+            for (i = 0; i < count; i ++) {
+                ecs_meta_copy_op_t *op = flecs_meta_copy_op_add(plan,
+                    EcsMetaCopyVector,
+                    dst_offset + i * ECS_SIZEOF(ecs_vec_t),
+                    src_offset + i * ECS_SIZEOF(ecs_vec_t));
+                op->size = elem_ti->size;
+            }
+            return 0;
+        }
+    }
+
+    if (dst_op->type == src_op->type) {
+        ecs_meta_copy_op_t *op = flecs_meta_copy_op_add(plan,
+            EcsMetaCopyHook, dst_offset, src_offset);
+        op->count = count;
+        op->ti = ecs_get_type_info(world, dst_op->type);
+        return 0;
+    }
+
+    return -1;
+}
+
+static
+int flecs_meta_copy_compile(
+    const ecs_world_t *world,
+    ecs_meta_copy_plan_t *plan,
+    const ecs_meta_type_op_t *dst_op,
+    const ecs_meta_type_op_t *src_op,
+    ecs_size_t dst_base,
+    ecs_size_t src_base)
+{
+    int32_t count = dst_op->count;
+    if (src_op->count < count) {
+        count = src_op->count;
+    }
+    if (count < 1) {
+        count = 1;
+    }
+
+    ecs_size_t dst_offset = dst_base + dst_op->offset;
+    ecs_size_t src_offset = src_base + src_op->offset;
+    ecs_meta_type_op_kind_t dst_kind = dst_op->kind;
+    ecs_meta_type_op_kind_t src_kind = src_op->kind;
+
+    /* Values of the same type that don't have a copy hook are copied as is */
+    if (dst_op->type && dst_op->type == src_op->type) {
+        const ecs_type_info_t *ti = ecs_get_type_info(world, dst_op->type);
+        ecs_assert(ti != NULL, ECS_INTERNAL_ERROR, NULL);
+        if (!ti->hooks.copy) {
+            flecs_meta_copy_add_memcpy(plan, dst_offset, src_offset,
+                dst_op->size * count);
+            return 0;
+        }
+    }
+
+    if (dst_kind == EcsOpPush && src_kind == EcsOpPush) {
+        int32_t i;
+        for (i = 0; i < count; i ++) {
+            if (flecs_meta_copy_compile_struct(world, plan, dst_op, src_op,
+                dst_base + i * dst_op->size, src_base + i * src_op->size))
+            {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (dst_kind == EcsOpVector && src_kind == EcsOpVector) {
+        if (!flecs_meta_copy_compile_vector(world, plan, dst_op, src_op,
+            dst_offset, src_offset, count))
+        {
+            return 0;
+        }
+    } else if (dst_kind > EcsOpPrimitive && src_kind > EcsOpPrimitive) {
+        if (dst_kind == EcsOpString && src_kind == EcsOpString) {
+            flecs_meta_copy_op_add(plan, EcsMetaCopyString,
+                dst_offset, src_offset)->count = count;
+            return 0;
+        }
+
+        if (dst_kind == src_kind) {
+            flecs_meta_copy_add_memcpy(plan, dst_offset, src_offset,
+                dst_op->size * count);
+            return 0;
+        }
+
+        if (flecs_meta_copy_can_convert(dst_kind, src_kind)) {
+            ecs_meta_copy_op_t *op = flecs_meta_copy_op_add(plan,
+                EcsMetaCopyConvert, dst_offset, src_offset);
+            op->count = count;
+            op->size = dst_op->size;
+            op->src_size = src_op->size;
+            op->dst_kind = dst_kind;
+            op->src_kind = src_kind;
+            return 0;
+        }
+    } else if (dst_op->type == src_op->type) {
+        /* Arrays & opaque types with a copy hook */
+        ecs_meta_copy_op_t *op = flecs_meta_copy_op_add(plan,
+            EcsMetaCopyHook, dst_offset, src_offset);
+        op->count = count;
+        op->ti = ecs_get_type_info(world, dst_op->type);
+        return 0;
+    }
+
+    char *dst_path = ecs_get_path(world, dst_op->type);
+    char *src_path = ecs_get_path(world, src_op->type);
+    if (dst_op->name) {
+        ecs_err("cannot copy member '%s' from type '%s' to type '%s'",
+            dst_op->name, src_path, dst_path);
+    } else {
+        ecs_err("cannot copy type '%s' to type '%s'", src_path, dst_path);
+    }
+    ecs_os_free(dst_path);
+    ecs_os_free(src_path);
+    return -1;
+}
+
+ecs_meta_copy_plan_t* ecs_meta_copy_plan_init(
+    const ecs_world_t *world,
+    ecs_entity_t dst_type,
+    ecs_entity_t src_type)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(dst_type != 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(src_type != 0, ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    const EcsTypeSerializer *dst_ser = ecs_get(
+        world, dst_type, EcsTypeSerializer);
+    const EcsTypeSerializer *src_ser = ecs_get(
+        world, src_type, EcsTypeSerializer);
+    if (!dst_ser || !src_ser) {
+        char *path = ecs_get_path(world, dst_ser ? src_type : dst_type);
+        ecs_err("cannot create copy plan: missing reflection for '%s'", path);
+        ecs_os_free(path);
+        return NULL;
+    }
+
+    const ecs_type_info_t *dst_ti = ecs_get_type_info(world, dst_type);
+    const ecs_type_info_t *src_ti = ecs_get_type_info(world, src_type);
+    ecs_check(dst_ti != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(src_ti != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_meta_copy_plan_t *plan = ecs_os_calloc_t(ecs_meta_copy_plan_t);
+    ecs_vec_init_t(NULL, &plan->ops, ecs_meta_copy_op_t, 0);
+    plan->dst_size = dst_ti->size;
+    plan->src_size = src_ti->size;
+
+    if (flecs_meta_copy_compile(world, plan,
+        ecs_vec_first_t(&dst_ser->ops, ecs_meta_type_op_t),
+        ecs_vec_first_t(&src_ser->ops, ecs_meta_type_op_t), 0, 0))
+    {
+        ecs_meta_copy_plan_fini(plan);
+        return NULL;
+    }
+
+    /* A plan for two types with the same layout copies whole columns */
+    if (ecs_vec_count(&plan->ops) == 1 && plan->dst_size == plan->src_size) {
+        const ecs_meta_copy_op_t *op = ecs_vec_first(&plan->ops);
+        plan->is_memcpy = op->kind == EcsMetaCopyMemcpy &&
+            !op->dst_offset && !op->src_offset && op->size == plan->dst_size;
+    }
+
+    return plan;
+error:
+    return NULL;
+}
+
+void ecs_meta_copy_plan_fini(
+    ecs_meta_copy_plan_t *plan)
+{
+    ecs_check(plan != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_vec_fini_t(NULL, &plan->ops, ecs_meta_copy_op_t);
+    ecs_os_free(plan);
+error:
+    return;
+}
+
+static
+void flecs_meta_copy_run_op(
+    const ecs_meta_copy_op_t *op,
+    void *dst,
+    const void *src)
+{
+    void *dst_ptr = ECS_OFFSET(dst, op->dst_offset);
+    const void *src_ptr = ECS_OFFSET(src, op->src_offset);
+    int32_t i, count = op->count;
+
+    switch(op->kind) {
+    case EcsMetaCopyMemcpy:
+        ecs_os_memcpy(dst_ptr, src_ptr, op->size);
+        break;
+    case EcsMetaCopyConvert:
+        for (i = 0; i < count; i ++) {
+            flecs_meta_copy_write(op->dst_kind,
+                ECS_ELEM(dst_ptr, op->size, i),
+                flecs_meta_copy_read(op->src_kind,
+                    ECS_ELEM(src_ptr, op->src_size, i)));
+        }
+        break;
+    case EcsMetaCopyString: {
+        ecs_string_t *dst_str = dst_ptr;
+        const ecs_string_t *src_str = src_ptr;
+        for (i = 0; i < count; i ++) {
+            if (dst_str[i] != src_str[i]) {
+                ecs_os_free(dst_str[i]);
+                dst_str[i] = ecs_os_strdup(src_str[i]);
+            }
+        }
+        break;
+    }
+    case EcsMetaCopyVector: {
+        ecs_vec_t *dst_vec = dst_ptr;
+        const ecs_vec_t *src_vec = src_ptr;
+        int32_t elem_count = ecs_vec_count(src_vec);
+        ecs_vec_set_count(NULL, dst_vec, op->size, elem_count);
+        if (elem_count) {
+            ecs_os_memcpy(dst_vec->array, src_vec->array,
+                op->size * elem_count);
+        }
+        break;
+    }
+    case EcsMetaCopyHook: {
+        const ecs_type_info_t *ti = op->ti;
+        if (ti->hooks.copy) {
+            ti->hooks.copy(dst_ptr, src_ptr, count, ti);
+        } else {
+            ecs_os_memcpy(dst_ptr, src_ptr, ti->size * count);
+        }
+        break;
+    }
+    }
+}
+
+void ecs_meta_copy_plan_run(
+    const ecs_meta_copy_plan_t *plan,
+    void *dst,
+    const void *src,
+    int32_t count)
+{
+    ecs_check(plan != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || dst != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || src != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (plan->is_memcpy) {
+        ecs_os_memcpy(dst, src, plan->dst_size * count);
+        return;
+    }
+
+    const ecs_meta_copy_op_t *ops = ecs_vec_first(&plan->ops);
+    int32_t i, o, op_count = ecs_vec_count(&plan->ops);
+    ecs_size_t dst_size = plan->dst_size, src_size = plan->src_size;
+
+    for (i = 0; i < count; i ++) {
+        void *dst_elem = ECS_ELEM(dst, dst_size, i);
+        const void *src_elem = ECS_ELEM(src, src_size, i);
+        for (o = 0; o < op_count; o ++) {
+            flecs_meta_copy_run_op(&ops[o], dst_elem, src_elem);
+        }
+    }
+error:
+    return;
+}
+
+#endif
@@ -54,6 +54,15 @@ void* flecs_worker(void *arg) {
     ecs_os_mutex_unlock(world->sync_mutex);
 
     while (!(world->flags & EcsWorldQuitWorkers)) {
+        const ecs_worker_job_action_t job = world->worker_job;
+        if (job) {
+            /* Run job dispatched by flecs_workers_run instead of pipeline */
+            ecs_dbg_3("worker %d: run job", stage->id);
+            job(stage, world->worker_job_ctx);
+            flecs_sync_worker(world);
+            continue;
+        }
+
         const ecs_entity_t old_scope = ecs_set_scope((ecs_world_t*)stage, 0);
 
         ecs_dbg_3("worker %d: run", stage->id);
@@ -224,6 +233,44 @@ void flecs_join_worker_threads(
 }
 
 /* -- Private functions -- */
+bool flecs_workers_run(
+    ecs_world_t *world,
+    ecs_worker_job_action_t job,
+    void *ctx)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    ecs_assert(job != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(world->worker_job == NULL, ECS_INTERNAL_ERROR, NULL);
+
+    const int32_t stage_count = ecs_get_stage_count(world);
+    if (stage_count <= 1 || !world->sync_mutex) {
+        return false;
+    }
+
+    /* Workers are idle when they all wait to be signalled, which is the case
+     * between frames and while the main thread merges. Task threads only
+     * exist while the pipeline runs. */
+    ecs_os_mutex_lock(world->sync_mutex);
+    bool idle = world->workers_running == (stage_count - 1) && 
+        !world->workers_waiting;
+    ecs_os_mutex_unlock(world->sync_mutex);
+    if (!idle) {
+        return false;
+    }
+
+    world->worker_job = job;
+    world->worker_job_ctx = ctx;
+    flecs_signal_workers(world);
+
+    job(world->stages[0], ctx);
+
+    flecs_wait_for_sync(world);
+    world->worker_job = NULL;
+    world->worker_job_ctx = NULL;
+
+    return true;
+}
+
 void flecs_workers_progress(
     ecs_world_t *world,
     ecs_pipeline_state_t *pq,
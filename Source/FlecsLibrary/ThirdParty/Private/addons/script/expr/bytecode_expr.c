@@ -0,0 +1,1243 @@
+/**
+ * @file addons/script/expr/bytecode_expr.c
+ * @brief Compile expressions to register bytecode & evaluate bytecode.
+ */
+
+#include "flecs.h"
+
+#ifdef FLECS_SCRIPT
+#include "../script.h"
+
+typedef struct ecs_expr_compile_ctx_t {
+    ecs_script_t *script;
+    ecs_allocator_t *allocator;
+    ecs_expr_program_t *program;
+} ecs_expr_compile_ctx_t;
+
+typedef struct ecs_expr_vm_t {
+    ecs_world_t *world;
+    ecs_expr_reg_t *regs;             /* reg_count * lanes registers */
+    const char *src[FLECS_EXPR_VM_SOURCE_MAX];
+    ecs_size_t stride[FLECS_EXPR_VM_SOURCE_MAX];
+    int32_t lanes;                    /* Distance between registers */
+    int32_t count;                    /* Number of lanes to evaluate */
+} ecs_expr_vm_t;
+
+static
+ecs_expr_reg_kind_t flecs_expr_reg_kind(
+    ecs_entity_t type)
+{
+    if      (type == ecs_id(ecs_bool_t))   return EcsExprRegBool;
+    else if (type == ecs_id(ecs_i8_t))     return EcsExprRegI8;
+    else if (type == ecs_id(ecs_i16_t))    return EcsExprRegI16;
+    else if (type == ecs_id(ecs_i32_t))    return EcsExprRegI32;
+    else if (type == ecs_id(ecs_i64_t))    return EcsExprRegI64;
+    else if (type == ecs_id(ecs_u8_t))     return EcsExprRegU8;
+    else if (type == ecs_id(ecs_u16_t))    return EcsExprRegU16;
+    else if (type == ecs_id(ecs_u32_t))    return EcsExprRegU32;
+    else if (type == ecs_id(ecs_u64_t))    return EcsExprRegU64;
+    else if (type == ecs_id(ecs_f32_t))    return EcsExprRegF32;
+    else if (type == ecs_id(ecs_f64_t))    return EcsExprRegF64;
+    else if (type == ecs_id(ecs_entity_t)) return EcsExprRegEntity;
+    else if (type == ecs_id(ecs_iptr_t)) {
+        return sizeof(intptr_t) == 4 ? EcsExprRegI32 : EcsExprRegI64;
+    } else if (type == ecs_id(ecs_uptr_t)) {
+        return sizeof(uintptr_t) == 4 ? EcsExprRegU32 : EcsExprRegU64;
+    }
+
+    /* Strings, chars, enums, bitmasks & composite types aren't supported */
+    return EcsExprRegInvalid;
+}
+
+static
+bool flecs_expr_reg_is_int(
+    ecs_expr_reg_kind_t kind)
+{
+    return kind >= EcsExprRegI8 && kind <= EcsExprRegI64;
+}
+
+static
+bool flecs_expr_reg_is_uint(
+    ecs_expr_reg_kind_t kind)
+{
+    return (kind >= EcsExprRegU8 && kind <= EcsExprRegU64) ||
+        kind == EcsExprRegEntity;
+}
+
+static
+bool flecs_expr_reg_is_float(
+    ecs_expr_reg_kind_t kind)
+{
+    return kind == EcsExprRegF32 || kind == EcsExprRegF64;
+}
+
+static
+ecs_expr_reg_t flecs_expr_reg_from_ptr(
+    ecs_expr_reg_kind_t kind,
+    const void *ptr)
+{
+    ecs_expr_reg_t result;
+    switch(kind) {
+    case EcsExprRegBool:   result.u = *(const ecs_bool_t*)ptr; break;
+    case EcsExprRegI8:     result.i = *(const ecs_i8_t*)ptr; break;
+    case EcsExprRegI16:    result.i = *(const ecs_i16_t*)ptr; break;
+    case EcsExprRegI32:    result.i = *(const ecs_i32_t*)ptr; break;
+    case EcsExprRegI64:    result.i = *(const ecs_i64_t*)ptr; break;
+    case EcsExprRegU8:     result.u = *(const ecs_u8_t*)ptr; break;
+    case EcsExprRegU16:    result.u = *(const ecs_u16_t*)ptr; break;
+    case EcsExprRegU32:    result.u = *(const ecs_u32_t*)ptr; break;
+    case EcsExprRegU64:    result.u = *(const ecs_u64_t*)ptr; break;
+    case EcsExprRegEntity: result.u = *(const ecs_entity_t*)ptr; break;
+    case EcsExprRegF32:    result.f = (double)*(const ecs_f32_t*)ptr; break;
+    case EcsExprRegF64:    result.f = *(const ecs_f64_t*)ptr; break;
+    case EcsExprRegInvalid:
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
+    return result;
+}
+
+static
+void flecs_expr_reg_to_ptr(
+    ecs_expr_reg_kind_t kind,
+    const ecs_expr_reg_t *reg,
+    void *ptr)
+{
+    switch(kind) {
+    case EcsExprRegBool:   *(ecs_bool_t*)ptr = reg->u != 0; break;
+    case EcsExprRegI8:     *(ecs_i8_t*)ptr = (ecs_i8_t)reg->i; break;
+    case EcsExprRegI16:    *(ecs_i16_t*)ptr = (ecs_i16_t)reg->i; break;
+    case EcsExprRegI32:    *(ecs_i32_t*)ptr = (ecs_i32_t)reg->i; break;
+    case EcsExprRegI64:    *(ecs_i64_t*)ptr = reg->i; break;
+    case EcsExprRegU8:     *(ecs_u8_t*)ptr = (ecs_u8_t)reg->u; break;
+    case EcsExprRegU16:    *(ecs_u16_t*)ptr = (ecs_u16_t)reg->u; break;
+    case EcsExprRegU32:    *(ecs_u32_t*)ptr = (ecs_u32_t)reg->u; break;
+    case EcsExprRegU64:    *(ecs_u64_t*)ptr = reg->u; break;
+    case EcsExprRegEntity: *(ecs_entity_t*)ptr = reg->u; break;
+    case EcsExprRegF32:    *(ecs_f32_t*)ptr = (ecs_f32_t)reg->f; break;
+    case EcsExprRegF64:    *(ecs_f64_t*)ptr = reg->f; break;
+    case EcsExprRegInvalid:
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
+}
+
+/* Find instruction that converts between register kinds. The bounds are the
+ * same as the ones used by the meta cursor, so that values that fail to cast
+ * when evaluating the AST also fail when evaluating bytecode. Returns 1 if no
+ * instruction is needed, -1 if the conversion isn't supported. */
+static
+int flecs_expr_cast_op(
+    ecs_expr_reg_kind_t from,
+    ecs_expr_reg_kind_t to,
+    ecs_expr_op_t *op)
+{
+    if (from == to) {
+        return 1;
+    }
+
+    if (from == EcsExprRegInvalid || to == EcsExprRegInvalid) {
+        return -1;
+    }
+
+    /* Entities are converted with ecs_meta_set_entity */
+    if (from == EcsExprRegEntity) {
+        return -1;
+    }
+
+    if (to == EcsExprRegBool) {
+        op->kind = EcsExprOpToBool;
+        return 0;
+    }
+
+    if (flecs_expr_reg_is_float(to)) {
+        if (from == EcsExprRegBool) {
+            return -1; /* Not supported by meta cursor */
+        } else if (flecs_expr_reg_is_int(from)) {
+            op->kind = to == EcsExprRegF32 ? EcsExprOpIToF32 : EcsExprOpIToF;
+        } else if (flecs_expr_reg_is_uint(from)) {
+            op->kind = to == EcsExprRegF32 ? EcsExprOpUToF32 : EcsExprOpUToF;
+        } else if (to == EcsExprRegF64) {
+            return 1; /* f32 registers already store a double */
+        } else {
+            op->kind = EcsExprOpNarrowF32;
+        }
+        return 0;
+    }
+
+    /* Bools are always in range of integer types */
+    if (from == EcsExprRegBool) {
+        return 1;
+    }
+
+    if (flecs_expr_reg_is_int(from)) {
+        int64_t min = 0, max = INT64_MAX;
+        switch(to) {
+        case EcsExprRegI8:  min = INT8_MIN;  max = INT8_MAX;   break;
+        case EcsExprRegI16: min = INT16_MIN; max = INT16_MAX;  break;
+        case EcsExprRegI32: min = INT32_MIN; max = INT32_MAX;  break;
+        case EcsExprRegI64: return 1;
+        case EcsExprRegU8:  max = UINT8_MAX;  break;
+        case EcsExprRegU16: max = UINT16_MAX; break;
+        case EcsExprRegU32: max = UINT32_MAX; break;
+        case EcsExprRegU64:
+        case EcsExprRegEntity:
+            break;
+        case EcsExprRegInvalid:
+        case EcsExprRegBool:
+        case EcsExprRegF32:
+        case EcsExprRegF64:
+        default:
+            ecs_abort(ECS_INTERNAL_ERROR, NULL);
+        }
+
+        op->kind = EcsExprOpCastI;
+        op->is.bounds.min.i = min;
+        op->is.bounds.max.i = max;
+        return 0;
+    }
+
+    if (flecs_expr_reg_is_uint(from)) {
+        uint64_t max = UINT64_MAX;
+        switch(to) {
+        case EcsExprRegI8:  max = INT8_MAX;   break;
+        case EcsExprRegI16: max = INT16_MAX;  break;
+        case EcsExprRegI32: max = INT32_MAX;  break;
+        case EcsExprRegI64: max = INT64_MAX;  break;
+        case EcsExprRegU8:  max = UINT8_MAX;  break;
+        case EcsExprRegU16: max = UINT16_MAX; break;
+        case EcsExprRegU32: max = UINT32_MAX; break;
+        case EcsExprRegU64:
+        case EcsExprRegEntity:
+            return 1;
+        case EcsExprRegInvalid:
+        case EcsExprRegBool:
+        case EcsExprRegF32:
+        case EcsExprRegF64:
+        default:
+            ecs_abort(ECS_INTERNAL_ERROR, NULL);
+        }
+
+        op->kind = EcsExprOpCastU;
+        op->is.bounds.min.u = 0;
+        op->is.bounds.max.u = max;
+        return 0;
+    }
+
+    /* Floating point to integer */
+    double min = 0, max = 0;
+    switch(to) {
+    case EcsExprRegI8:  min = INT8_MIN;  max = INT8_MAX;  break;
+    case EcsExprRegI16: min = INT16_MIN; max = INT16_MAX; break;
+    case EcsExprRegI32: min = INT32_MIN; max = INT32_MAX; break;
+    case EcsExprRegI64: min = (double)INT64_MIN; max = (double)INT64_MAX; break;
+    case EcsExprRegU8:  max = UINT8_MAX;  break;
+    case EcsExprRegU16: max = UINT16_MAX; break;
+    case EcsExprRegU32: max = UINT32_MAX; break;
+    case EcsExprRegU64:
+    case EcsExprRegEntity:
+        max = (double)UINT64_MAX;
+        break;
+    case EcsExprRegInvalid:
+    case EcsExprRegBool:
+    case EcsExprRegF32:
+    case EcsExprRegF64:
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
+
+    op->kind = flecs_expr_reg_is_int(to) ?
+        EcsExprOpCastFToI : EcsExprOpCastFToU;
+    op->is.bounds.min.f = min;
+    op->is.bounds.max.f = max;
+    return 0;
+}
+
+static
+ecs_expr_op_t* flecs_expr_emit(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_node_t *node,
+    ecs_expr_op_kind_t kind,
+    int16_t dst,
+    int16_t a,
+    int16_t b)
+{
+    ecs_expr_program_t *program = ctx->program;
+    ecs_expr_op_t *op = ecs_vec_append_t(
+        ctx->allocator, &program->ops, ecs_expr_op_t);
+    ecs_os_zeromem(op);
+    op->kind = kind;
+    op->dst = dst;
+    op->a = a;
+    op->b = b;
+
+    ecs_vec_append_t(ctx->allocator, &program->nodes,
+        const ecs_expr_node_t*)[0] = node;
+
+    return op;
+}
+
+/* Wrap result of an arithmetic operation to the width of its type */
+static
+void flecs_expr_emit_narrow(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_node_t *node,
+    ecs_expr_reg_kind_t kind,
+    int16_t r)
+{
+    ecs_expr_op_kind_t op;
+    switch(kind) {
+    case EcsExprRegI8:  op = EcsExprOpNarrowI8;  break;
+    case EcsExprRegI16: op = EcsExprOpNarrowI16; break;
+    case EcsExprRegI32: op = EcsExprOpNarrowI32; break;
+    case EcsExprRegU8:  op = EcsExprOpNarrowU8;  break;
+    case EcsExprRegU16: op = EcsExprOpNarrowU16; break;
+    case EcsExprRegU32: op = EcsExprOpNarrowU32; break;
+    case EcsExprRegF32: op = EcsExprOpNarrowF32; break;
+    case EcsExprRegInvalid:
+    case EcsExprRegBool:
+    case EcsExprRegI64:
+    case EcsExprRegU64:
+    case EcsExprRegF64:
+    case EcsExprRegEntity:
+    default:
+        return;
+    }
+
+    flecs_expr_emit(ctx, node, op, r, r, r);
+}
+
+static
+int16_t flecs_expr_source(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_variable_t *var)
+{
+    ecs_expr_program_t *program = ctx->program;
+    ecs_expr_source_t *sources = ecs_vec_first(&program->sources);
+    int32_t i, count = ecs_vec_count(&program->sources);
+
+    bool is_global = var->node.kind == EcsExprGlobalVariable;
+    for (i = 0; i < count; i ++) {
+        if (is_global) {
+            if (!sources[i].name && sources[i].ptr == var->global_value.ptr) {
+                return flecs_ito(int16_t, i);
+            }
+        } else if (sources[i].name && !ecs_os_strcmp(sources[i].name, var->name)) {
+            return flecs_ito(int16_t, i);
+        }
+    }
+
+    if (count == FLECS_EXPR_VM_SOURCE_MAX) {
+        return -1;
+    }
+
+    ecs_expr_source_t *src = ecs_vec_append_t(
+        ctx->allocator, &program->sources, ecs_expr_source_t);
+    src->node = (const ecs_expr_node_t*)var;
+    src->type = var->node.type;
+    if (is_global) {
+        src->name = NULL;
+        src->ptr = var->global_value.ptr;
+    } else {
+        src->name = var->name;
+        src->ptr = NULL;
+    }
+
+    return flecs_ito(int16_t, count);
+}
+
+static
+int flecs_expr_compile_node(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_node_t *node,
+    int16_t r);
+
+static
+int flecs_expr_value_compile(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_value_node_t *node,
+    int16_t r)
+{
+    ecs_expr_reg_kind_t kind = flecs_expr_reg_kind(node->node.type);
+    if (kind == EcsExprRegInvalid) {
+        return -1;
+    }
+
+    ecs_expr_op_t *op = flecs_expr_emit(
+        ctx, (const ecs_expr_node_t*)node, EcsExprOpConst, r, r, r);
+    op->is.imm = flecs_expr_reg_from_ptr(kind, node->ptr);
+    return 0;
+}
+
+/* Variables & members of variables are compiled to a single load */
+static
+int flecs_expr_load_compile(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_node_t *node,
+    int16_t r)
+{
+    ecs_expr_reg_kind_t kind = flecs_expr_reg_kind(node->type);
+    const ecs_expr_node_t *cur = node;
+    uintptr_t offset = 0;
+
+    while (cur->kind == EcsExprMember) {
+        const ecs_expr_member_t *member = (const ecs_expr_member_t*)cur;
+        offset += member->offset;
+        cur = member->left;
+    }
+
+    if (cur->kind != EcsExprVariable && cur->kind != EcsExprGlobalVariable) {
+        return -1;
+    }
+
+    ecs_expr_op_kind_t op_kind;
+    switch(kind) {
+    case EcsExprRegBool:   op_kind = EcsExprOpLoadBool; break;
+    case EcsExprRegI8:     op_kind = EcsExprOpLoadI8;   break;
+    case EcsExprRegI16:    op_kind = EcsExprOpLoadI16;  break;
+    case EcsExprRegI32:    op_kind = EcsExprOpLoadI32;  break;
+    case EcsExprRegI64:    op_kind = EcsExprOpLoadI64;  break;
+    case EcsExprRegU8:     op_kind = EcsExprOpLoadU8;   break;
+    case EcsExprRegU16:    op_kind = EcsExprOpLoadU16;  break;
+    case EcsExprRegU32:    op_kind = EcsExprOpLoadU32;  break;
+    case EcsExprRegU64:    op_kind = EcsExprOpLoadU64;  break;
+    case EcsExprRegEntity: op_kind = EcsExprOpLoadU64;  break;
+    case EcsExprRegF32:    op_kind = EcsExprOpLoadF32;  break;
+    case EcsExprRegF64:    op_kind = EcsExprOpLoadF64;  break;
+    case EcsExprRegInvalid:
+    default:
+        return -1;
+    }
+
+    int16_t src = flecs_expr_source(ctx, (const ecs_expr_variable_t*)cur);
+    if (src == -1) {
+        return -1;
+    }
+
+    ecs_expr_op_t *op = flecs_expr_emit(ctx, node, op_kind, r, src, src);
+    op->is.offset = flecs_uto(ecs_size_t, offset);
+    return 0;
+}
+
+static
+int flecs_expr_unary_compile(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_unary_t *node,
+    int16_t r)
+{
+    if (node->operator != EcsTokNot) {
+        return -1;
+    }
+
+    if (flecs_expr_reg_kind(node->expr->type) != EcsExprRegBool) {
+        return -1;
+    }
+
+    if (flecs_expr_compile_node(ctx, node->expr, r)) {
+        return -1;
+    }
+
+    flecs_expr_emit(ctx, (const ecs_expr_node_t*)node, EcsExprOpNot, r, r, r);
+    return 0;
+}
+
+static
+int flecs_expr_binary_compile(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_binary_t *node,
+    int16_t r)
+{
+    /* Type visitor casts operands to the same type */
+    ecs_expr_reg_kind_t kind = flecs_expr_reg_kind(node->left->type);
+    ecs_expr_reg_kind_t result = flecs_expr_reg_kind(node->node.type);
+    if (kind == EcsExprRegInvalid || result == EcsExprRegInvalid) {
+        return -1;
+    }
+
+    if (kind != flecs_expr_reg_kind(node->right->type)) {
+        return -1;
+    }
+
+    bool is_float = flecs_expr_reg_is_float(kind);
+    bool is_signed = flecs_expr_reg_is_int(kind);
+    bool narrow = false;
+    ecs_expr_op_kind_t op;
+
+    switch(node->operator) {
+    case EcsTokAdd:
+        op = is_float ? EcsExprOpAddF : EcsExprOpAddInt;
+        narrow = true;
+        break;
+    case EcsTokSub:
+        op = is_float ? EcsExprOpSubF : EcsExprOpSubInt;
+        narrow = true;
+        break;
+    case EcsTokMul:
+        op = is_float ? EcsExprOpMulF : EcsExprOpMulInt;
+        narrow = true;
+        break;
+    case EcsTokDiv:
+        if (!is_float) {
+            return -1;
+        }
+        op = EcsExprOpDivF;
+        narrow = true;
+        break;
+    case EcsTokMod:
+        if (kind != EcsExprRegI64) {
+            return -1;
+        }
+        op = EcsExprOpModInt;
+        break;
+    case EcsTokBitwiseAnd:
+    case EcsTokBitwiseOr:
+    case EcsTokShiftLeft:
+    case EcsTokShiftRight:
+        if (is_float || kind == EcsExprRegBool || kind == EcsExprRegEntity) {
+            return -1;
+        }
+        if (node->operator == EcsTokBitwiseAnd) {
+            op = EcsExprOpAnd;
+        } else if (node->operator == EcsTokBitwiseOr) {
+            op = EcsExprOpOr;
+        } else if (node->operator == EcsTokShiftLeft) {
+            op = EcsExprOpShl;
+        } else {
+            op = is_signed ? EcsExprOpShrI : EcsExprOpShrU;
+        }
+        narrow = true;
+        break;
+    case EcsTokEq:
+        op = is_float ? EcsExprOpEqF : EcsExprOpEq;
+        break;
+    case EcsTokNeq:
+        op = is_float ? EcsExprOpNeqF : EcsExprOpNeq;
+        break;
+    case EcsTokLt:
+        op = is_float ? EcsExprOpLtF : is_signed ? EcsExprOpLtI : EcsExprOpLtU;
+        break;
+    case EcsTokLtEq:
+        op = is_float ? EcsExprOpLtEqF :
+            is_signed ? EcsExprOpLtEqI : EcsExprOpLtEqU;
+        break;
+    case EcsTokGt:
+        op = is_float ? EcsExprOpGtF : is_signed ? EcsExprOpGtI : EcsExprOpGtU;
+        break;
+    case EcsTokGtEq:
+        op = is_float ? EcsExprOpGtEqF :
+            is_signed ? EcsExprOpGtEqI : EcsExprOpGtEqU;
+        break;
+    case EcsTokAnd:
+    case EcsTokOr:
+        if (kind != EcsExprRegBool) {
+            return -1;
+        }
+        op = node->operator == EcsTokAnd ?
+            EcsExprOpLogicAnd : EcsExprOpLogicOr;
+        break;
+    case EcsTokEnd:
+    case EcsTokUnknown:
+    case EcsTokScopeOpen:
+    case EcsTokScopeClose:
+    case EcsTokParenOpen:
+    case EcsTokParenClose:
+    case EcsTokBracketOpen:
+    case EcsTokBracketClose:
+    case EcsTokMember:
+    case EcsTokComma:
+    case EcsTokSemiColon:
+    case EcsTokColon:
+    case EcsTokAssign:
+    case EcsTokNot:
+    case EcsTokOptional:
+    case EcsTokAnnotation:
+    case EcsTokNewline:
+    case EcsTokMatch:
+    case EcsTokRange:
+    case EcsTokIdentifier:
+    case EcsTokString:
+    case EcsTokNumber:
+    case EcsTokKeywordModule:
+    case EcsTokKeywordUsing:
+    case EcsTokKeywordWith:
+    case EcsTokKeywordIf:
+    case EcsTokKeywordElse:
+    case EcsTokKeywordFor:
+    case EcsTokKeywordIn:
+    case EcsTokKeywordTemplate:
+    case EcsTokKeywordProp:
+    case EcsTokKeywordConst:
+    default:
+        return -1;
+    }
+
+    /* Arithmetic results have the operand type, everything else is a bool */
+    if (narrow && result != kind) {
+        return -1;
+    }
+
+    if ((r + 1) >= FLECS_EXPR_VM_REG_MAX) {
+        return -1;
+    }
+
+    if (flecs_expr_compile_node(ctx, node->left, r)) {
+        return -1;
+    }
+
+    if (flecs_expr_compile_node(ctx, node->right, flecs_ito(int16_t, r + 1))) {
+        return -1;
+    }
+
+    flecs_expr_emit(ctx, (const ecs_expr_node_t*)node, op,
+        r, r, flecs_ito(int16_t, r + 1));
+
+    if (narrow) {
+        flecs_expr_emit_narrow(ctx, (const ecs_expr_node_t*)node, result, r);
+    }
+
+    return 0;
+}
+
+static
+int flecs_expr_cast_compile(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_cast_t *node,
+    int16_t r)
+{
+    ecs_expr_op_t cast = {0};
+    int result = flecs_expr_cast_op(flecs_expr_reg_kind(node->expr->type),
+        flecs_expr_reg_kind(node->node.type), &cast);
+    if (result == -1) {
+        return -1;
+    }
+
+    if (flecs_expr_compile_node(ctx, node->expr, r)) {
+        return -1;
+    }
+
+    if (result == 0) {
+        ecs_expr_op_t *op = flecs_expr_emit(
+            ctx, (const ecs_expr_node_t*)node, cast.kind, r, r, r);
+        op->is = cast.is;
+    }
+
+    return 0;
+}
+
+static
+int flecs_expr_function_compile(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_function_t *node,
+    int16_t r)
+{
+    ecs_expr_reg_kind_t result_kind = flecs_expr_reg_kind(node->node.type);
+    if (result_kind == EcsExprRegInvalid) {
+        return -1;
+    }
+
+    bool is_method = node->node.kind == EcsExprMethod;
+    if (is_method && !node->left) {
+        return -1;
+    }
+
+    int32_t i, argc = ecs_vec_count(&node->args->elements);
+    int32_t arg_count = argc + is_method;
+    if (arg_count > FLECS_EXPR_VM_ARG_MAX) {
+        return -1;
+    }
+
+    if ((r + arg_count) >= FLECS_EXPR_VM_REG_MAX) {
+        return -1;
+    }
+
+    ecs_expr_initializer_element_t *elems = ecs_vec_first(&node->args->elements);
+    ecs_expr_call_t *call = flecs_calloc_t(ctx->allocator, ecs_expr_call_t);
+    ecs_vec_append_t(ctx->allocator, &ctx->program->calls,
+        ecs_expr_call_t*)[0] = call;
+    call->calldata = node->calldata;
+    call->argc = argc;
+    call->result_type = node->node.type;
+    call->result_kind = result_kind;
+    ecs_vec_init_t(ctx->allocator, &call->args, ecs_expr_call_arg_t, arg_count);
+
+    for (i = 0; i < arg_count; i ++) {
+        const ecs_expr_node_t *arg_node;
+        if (is_method) {
+            arg_node = i ? elems[i - 1].value : node->left;
+        } else {
+            arg_node = elems[i].value;
+        }
+
+        ecs_expr_call_arg_t *arg = ecs_vec_append_t(
+            ctx->allocator, &call->args, ecs_expr_call_arg_t);
+        arg->type = arg_node->type;
+        arg->kind = flecs_expr_reg_kind(arg_node->type);
+        arg->reg = flecs_ito(int16_t, r + i);
+        if (arg->kind == EcsExprRegInvalid) {
+            return -1;
+        }
+
+        if (flecs_expr_compile_node(ctx, arg_node, arg->reg)) {
+            return -1;
+        }
+    }
+
+    ecs_expr_op_t *op = flecs_expr_emit(
+        ctx, (const ecs_expr_node_t*)node, EcsExprOpCall, r, r, r);
+    op->is.call = call;
+    return 0;
+}
+
+static
+int flecs_expr_compile_node(
+    ecs_expr_compile_ctx_t *ctx,
+    const ecs_expr_node_t *node,
+    int16_t r)
+{
+    if (r >= ctx->program->reg_count) {
+        ctx->program->reg_count = flecs_ito(int16_t, r + 1);
+    }
+
+    switch(node->kind) {
+    case EcsExprValue:
+        return flecs_expr_value_compile(
+            ctx, (const ecs_expr_value_node_t*)node, r);
+    case EcsExprUnary:
+        return flecs_expr_unary_compile(
+            ctx, (const ecs_expr_unary_t*)node, r);
+    case EcsExprBinary:
+        return flecs_expr_binary_compile(
+            ctx, (const ecs_expr_binary_t*)node, r);
+    case EcsExprIdentifier: {
+        const ecs_expr_identifier_t *ident =
+            (const ecs_expr_identifier_t*)node;
+        if (!ident->expr) {
+            return -1; /* Resolved at eval time */
+        }
+        return flecs_expr_compile_node(ctx, ident->expr, r);
+    }
+    case EcsExprVariable:
+    case EcsExprGlobalVariable:
+    case EcsExprMember:
+        return flecs_expr_load_compile(ctx, node, r);
+    case EcsExprFunction:
+    case EcsExprMethod:
+        return flecs_expr_function_compile(
+            ctx, (const ecs_expr_function_t*)node, r);
+    case EcsExprCast:
+        return flecs_expr_cast_compile(
+            ctx, (const ecs_expr_cast_t*)node, r);
+    case EcsExprInterpolatedString:
+    case EcsExprInitializer:
+    case EcsExprEmptyInitializer:
+    case EcsExprElement:
+    case EcsExprComponent:
+    default:
+        return -1;
+    }
+}
+
+ecs_expr_program_t* flecs_expr_compile(
+    ecs_script_t *script,
+    ecs_expr_node_t *node)
+{
+    ecs_script_impl_t *impl = flecs_script_impl(script);
+    ecs_allocator_t *a = &impl->allocator;
+
+    ecs_expr_reg_kind_t kind = flecs_expr_reg_kind(node->type);
+    if (kind == EcsExprRegInvalid) {
+        return NULL;
+    }
+
+    ecs_expr_program_t *program = flecs_calloc_t(a, ecs_expr_program_t);
+    program->node = node;
+    program->type = node->type;
+    program->kind = kind;
+    ecs_vec_init_t(a, &program->ops, ecs_expr_op_t, 0);
+    ecs_vec_init_t(a, &program->nodes, const ecs_expr_node_t*, 0);
+    ecs_vec_init_t(a, &program->calls, ecs_expr_call_t*, 0);
+    ecs_vec_init_t(a, &program->sources, ecs_expr_source_t, 0);
+
+    ecs_expr_compile_ctx_t ctx = {
+        .script = script,
+        .allocator = a,
+        .program = program
+    };
+
+    if (flecs_expr_compile_node(&ctx, node, 0)) {
+        flecs_expr_program_free(script, program);
+        return NULL;
+    }
+
+    program->result = 0;
+    return program;
+}
+
+void flecs_expr_program_free(
+    ecs_script_t *script,
+    ecs_expr_program_t *program)
+{
+    if (!program) {
+        return;
+    }
+
+    ecs_allocator_t *a = &flecs_script_impl(script)->allocator;
+    int32_t i, count = ecs_vec_count(&program->calls);
+    ecs_expr_call_t **calls = ecs_vec_first(&program->calls);
+    for (i = 0; i < count; i ++) {
+        ecs_vec_fini_t(a, &calls[i]->args, ecs_expr_call_arg_t);
+        flecs_free_t(a, ecs_expr_call_t, calls[i]);
+    }
+
+    ecs_vec_fini_t(a, &program->calls, ecs_expr_call_t*);
+    ecs_vec_fini_t(a, &program->ops, ecs_expr_op_t);
+    ecs_vec_fini_t(a, &program->nodes, const ecs_expr_node_t*);
+    ecs_vec_fini_t(a, &program->sources, ecs_expr_source_t);
+    flecs_free_t(a, ecs_expr_program_t, program);
+}
+
+/* Loop over the lanes of a register */
+#define ECS_EXPR_LANES(body)\
+    for (l = 0; l < count; l ++) { body; }
+
+#define ECS_EXPR_LOAD(T, member)\
+    {\
+        const char *ptr = vm->src[op->a] + op->is.offset;\
+        ecs_size_t stride = vm->stride[op->a];\
+        ECS_EXPR_LANES(d[l].member = *(const T*)ECS_OFFSET(ptr, l * stride))\
+    }
+
+static
+void flecs_expr_vm_cast_error(
+    const ecs_script_t *script,
+    const ecs_expr_node_t *node,
+    double value)
+{
+    char *type_str = ecs_get_path(script->world, node->type);
+    ecs_err("value %.0f is out of bounds for type %s", value, type_str);
+    ecs_os_free(type_str);
+    flecs_expr_visit_error(script, node, "failed to cast value");
+}
+
+static
+void flecs_expr_vm_call(
+    ecs_expr_vm_t *vm,
+    const ecs_expr_call_t *call,
+    ecs_expr_reg_t *d)
+{
+    ecs_function_ctx_t call_ctx = {
+        .world = vm->world,
+        .function = call->calldata.function,
+        .ctx = call->calldata.ctx
+    };
+
+    ecs_value_t argv[FLECS_EXPR_VM_ARG_MAX];
+    ecs_expr_small_value_t storage[FLECS_EXPR_VM_ARG_MAX];
+    ecs_expr_small_value_t result;
+    ecs_value_t result_value = { .type = call->result_type, .ptr = &result };
+
+    const ecs_expr_call_arg_t *args = ecs_vec_first(&call->args);
+    int32_t i, l, arg_count = ecs_vec_count(&call->args);
+    int32_t lanes = vm->lanes, count = vm->count;
+
+    for (i = 0; i < arg_count; i ++) {
+        argv[i].type = args[i].type;
+        argv[i].ptr = &storage[i];
+    }
+
+    for (l = 0; l < count; l ++) {
+        for (i = 0; i < arg_count; i ++) {
+            flecs_expr_reg_to_ptr(args[i].kind,
+                &vm->regs[args[i].reg * lanes + l], &storage[i]);
+        }
+
+        call->calldata.callback(&call_ctx, call->argc, argv, &result_value);
+        d[l] = flecs_expr_reg_from_ptr(call->result_kind, &result);
+    }
+}
+
+static
+int flecs_expr_vm_run(
+    const ecs_script_t *script,
+    const ecs_expr_op_t *ops,
+    const ecs_expr_node_t **nodes,
+    int32_t op_count,
+    ecs_expr_vm_t *vm)
+{
+    ecs_expr_reg_t *regs = vm->regs;
+    int32_t i, l, lanes = vm->lanes, count = vm->count;
+
+    for (i = 0; i < op_count; i ++) {
+        const ecs_expr_op_t *op = &ops[i];
+        ecs_expr_reg_t *d = &regs[op->dst * lanes];
+        const ecs_expr_reg_t *a = &regs[op->a * lanes];
+        const ecs_expr_reg_t *b = &regs[op->b * lanes];
+
+        switch(op->kind) {
+        case EcsExprOpConst: {
+            ecs_expr_reg_t imm = op->is.imm;
+            ECS_EXPR_LANES(d[l] = imm)
+            break;
+        }
+
+        case EcsExprOpLoadBool: ECS_EXPR_LOAD(ecs_bool_t, u) break;
+        case EcsExprOpLoadI8:   ECS_EXPR_LOAD(ecs_i8_t, i) break;
+        case EcsExprOpLoadI16:  ECS_EXPR_LOAD(ecs_i16_t, i) break;
+        case EcsExprOpLoadI32:  ECS_EXPR_LOAD(ecs_i32_t, i) break;
+        case EcsExprOpLoadI64:  ECS_EXPR_LOAD(ecs_i64_t, i) break;
+        case EcsExprOpLoadU8:   ECS_EXPR_LOAD(ecs_u8_t, u) break;
+        case EcsExprOpLoadU16:  ECS_EXPR_LOAD(ecs_u16_t, u) break;
+        case EcsExprOpLoadU32:  ECS_EXPR_LOAD(ecs_u32_t, u) break;
+        case EcsExprOpLoadU64:  ECS_EXPR_LOAD(ecs_u64_t, u) break;
+        case EcsExprOpLoadF32:  ECS_EXPR_LOAD(ecs_f32_t, f) break;
+        case EcsExprOpLoadF64:  ECS_EXPR_LOAD(ecs_f64_t, f) break;
+
+        case EcsExprOpNarrowI8:  ECS_EXPR_LANES(d[l].i = (ecs_i8_t)a[l].i) break;
+        case EcsExprOpNarrowI16: ECS_EXPR_LANES(d[l].i = (ecs_i16_t)a[l].i) break;
+        case EcsExprOpNarrowI32: ECS_EXPR_LANES(d[l].i = (ecs_i32_t)a[l].i) break;
+        case EcsExprOpNarrowU8:  ECS_EXPR_LANES(d[l].u = (ecs_u8_t)a[l].u) break;
+        case EcsExprOpNarrowU16: ECS_EXPR_LANES(d[l].u = (ecs_u16_t)a[l].u) break;
+        case EcsExprOpNarrowU32: ECS_EXPR_LANES(d[l].u = (ecs_u32_t)a[l].u) break;
+        case EcsExprOpNarrowF32: ECS_EXPR_LANES(d[l].f = (ecs_f32_t)a[l].f) break;
+
+        /* Unsigned arithmetic, so that overflow wraps like it does for the
+         * narrower types the tree walker computes with */
+        case EcsExprOpAddInt: ECS_EXPR_LANES(d[l].u = a[l].u + b[l].u) break;
+        case EcsExprOpSubInt: ECS_EXPR_LANES(d[l].u = a[l].u - b[l].u) break;
+        case EcsExprOpMulInt: ECS_EXPR_LANES(d[l].u = a[l].u * b[l].u) break;
+        case EcsExprOpModInt:
+            ECS_EXPR_LANES(
+                if (!b[l].i) {
+                    ecs_err("%s: division by zero",
+                        script->name ? script->name : "anonymous script");
+                    return -1;
+                }
+                d[l].i = a[l].i % b[l].i)
+            break;
+        case EcsExprOpAnd:  ECS_EXPR_LANES(d[l].u = a[l].u & b[l].u) break;
+        case EcsExprOpOr:   ECS_EXPR_LANES(d[l].u = a[l].u | b[l].u) break;
+        case EcsExprOpShl:  ECS_EXPR_LANES(d[l].u = a[l].u << b[l].u) break;
+        case EcsExprOpShrI: ECS_EXPR_LANES(d[l].i = a[l].i >> b[l].i) break;
+        case EcsExprOpShrU: ECS_EXPR_LANES(d[l].u = a[l].u >> b[l].u) break;
+        case EcsExprOpAddF: ECS_EXPR_LANES(d[l].f = a[l].f + b[l].f) break;
+        case EcsExprOpSubF: ECS_EXPR_LANES(d[l].f = a[l].f - b[l].f) break;
+        case EcsExprOpMulF: ECS_EXPR_LANES(d[l].f = a[l].f * b[l].f) break;
+        case EcsExprOpDivF:
+            /* Same test as flecs_value_is_0, which only rejects +0 */
+            ECS_EXPR_LANES(
+                if (!b[l].u) {
+                    ecs_err("%s: division by zero",
+                        script->name ? script->name : "anonymous script");
+                    return -1;
+                }
+                d[l].f = a[l].f / b[l].f)
+            break;
+
+        case EcsExprOpEq:     ECS_EXPR_LANES(d[l].u = a[l].u == b[l].u) break;
+        case EcsExprOpNeq:    ECS_EXPR_LANES(d[l].u = a[l].u != b[l].u) break;
+        case EcsExprOpEqF:    ECS_EXPR_LANES(d[l].u = a[l].f == b[l].f) break;
+        case EcsExprOpNeqF:   ECS_EXPR_LANES(d[l].u = a[l].f != b[l].f) break;
+        case EcsExprOpLtI:    ECS_EXPR_LANES(d[l].u = a[l].i < b[l].i) break;
+        case EcsExprOpLtEqI:  ECS_EXPR_LANES(d[l].u = a[l].i <= b[l].i) break;
+        case EcsExprOpGtI:    ECS_EXPR_LANES(d[l].u = a[l].i > b[l].i) break;
+        case EcsExprOpGtEqI:  ECS_EXPR_LANES(d[l].u = a[l].i >= b[l].i) break;
+        case EcsExprOpLtU:    ECS_EXPR_LANES(d[l].u = a[l].u < b[l].u) break;
+        case EcsExprOpLtEqU:  ECS_EXPR_LANES(d[l].u = a[l].u <= b[l].u) break;
+        case EcsExprOpGtU:    ECS_EXPR_LANES(d[l].u = a[l].u > b[l].u) break;
+        case EcsExprOpGtEqU:  ECS_EXPR_LANES(d[l].u = a[l].u >= b[l].u) break;
+        case EcsExprOpLtF:    ECS_EXPR_LANES(d[l].u = a[l].f < b[l].f) break;
+        case EcsExprOpLtEqF:  ECS_EXPR_LANES(d[l].u = a[l].f <= b[l].f) break;
+        case EcsExprOpGtF:    ECS_EXPR_LANES(d[l].u = a[l].f > b[l].f) break;
+        case EcsExprOpGtEqF:  ECS_EXPR_LANES(d[l].u = a[l].f >= b[l].f) break;
+
+        case EcsExprOpLogicAnd: ECS_EXPR_LANES(d[l].u = a[l].u && b[l].u) break;
+        case EcsExprOpLogicOr:  ECS_EXPR_LANES(d[l].u = a[l].u || b[l].u) break;
+        case EcsExprOpNot:      ECS_EXPR_LANES(d[l].u = !a[l].u) break;
+
+        /* Same test as ECS_EQZERO, which is used by the meta cursor */
+        case EcsExprOpToBool: ECS_EXPR_LANES(d[l].u = a[l].u != 0) break;
+        case EcsExprOpIToF:   ECS_EXPR_LANES(d[l].f = (double)a[l].i) break;
+        case EcsExprOpUToF:   ECS_EXPR_LANES(d[l].f = (double)a[l].u) break;
+        case EcsExprOpIToF32: ECS_EXPR_LANES(d[l].f = (ecs_f32_t)a[l].i) break;
+        case EcsExprOpUToF32: ECS_EXPR_LANES(d[l].f = (ecs_f32_t)a[l].u) break;
+        case EcsExprOpCastI: {
+            int64_t min = op->is.bounds.min.i, max = op->is.bounds.max.i;
+            ECS_EXPR_LANES(
+                if (a[l].i < min || a[l].i > max) {
+                    flecs_expr_vm_cast_error(script, nodes[i], (double)a[l].i);
+                    return -1;
+                }
+                d[l].i = a[l].i)
+            break;
+        }
+        case EcsExprOpCastU: {
+            uint64_t max = op->is.bounds.max.u;
+            ECS_EXPR_LANES(
+                if (a[l].u > max) {
+                    flecs_expr_vm_cast_error(script, nodes[i], (double)a[l].u);
+                    return -1;
+                }
+                d[l].u = a[l].u)
+            break;
+        }
+        case EcsExprOpCastFToI:
+        case EcsExprOpCastFToU: {
+            double min = op->is.bounds.min.f, max = op->is.bounds.max.f;
+            bool to_int = op->kind == EcsExprOpCastFToI;
+            ECS_EXPR_LANES(
+                if (a[l].f < min || a[l].f > max) {
+                    flecs_expr_vm_cast_error(script, nodes[i], a[l].f);
+                    return -1;
+                }
+                if (to_int) {
+                    d[l].i = (int64_t)a[l].f;
+                } else {
+                    d[l].u = (uint64_t)a[l].f;
+                })
+            break;
+        }
+
+        case EcsExprOpCall:
+            flecs_expr_vm_call(vm, op->is.call, d);
+            break;
+
+        default:
+            ecs_abort(ECS_INTERNAL_ERROR, "invalid expression instruction");
+        }
+    }
+
+    return 0;
+}
+
+/* Resolve variables to the memory they point to */
+static
+int flecs_expr_program_resolve(
+    const ecs_script_t *script,
+    const ecs_expr_program_t *program,
+    const ecs_script_vars_t *vars,
+    const ecs_expr_column_t *columns,
+    ecs_expr_vm_t *vm)
+{
+    const ecs_expr_source_t *sources = ecs_vec_first(&program->sources);
+    int32_t i, count = ecs_vec_count(&program->sources);
+
+    for (i = 0; i < count; i ++) {
+        const ecs_expr_source_t *src = &sources[i];
+        vm->stride[i] = 0;
+
+        if (!src->name) {
+            vm->src[i] = src->ptr;
+            continue;
+        }
+
+        if (columns) {
+            int32_t c;
+            for (c = 0; c < FLECS_EXPR_BATCH_COLUMN_MAX; c ++) {
+                const ecs_expr_column_t *column = &columns[c];
+                if (!column->name) {
+                    break;
+                }
+
+                if (ecs_os_strcmp(column->name, src->name)) {
+                    continue;
+                }
+
+                if (column->type != src->type) {
+                    flecs_expr_visit_error(script, src->node,
+                        "type of column '%s' does not match variable",
+                            src->name);
+                    return -1;
+                }
+
+                const ecs_type_info_t *ti = ecs_get_type_info(
+                    script->world, src->type);
+                ecs_assert(ti != NULL, ECS_INTERNAL_ERROR, NULL);
+                vm->src[i] = column->ptr;
+                vm->stride[i] = column->stride ? column->stride : ti->size;
+                break;
+            }
+
+            if (c < FLECS_EXPR_BATCH_COLUMN_MAX && columns[c].name) {
+                continue;
+            }
+        }
+
+        const ecs_script_var_t *var = ecs_script_vars_lookup(vars, src->name);
+        if (!var) {
+            flecs_expr_visit_error(script, src->node,
+                "unresolved variable '%s'", src->name);
+            return -1;
+        }
+
+        if (var->value.type != src->type) {
+            flecs_expr_visit_error(script, src->node,
+                "type of variable '%s' changed after parsing", src->name);
+            return -1;
+        }
+
+        vm->src[i] = var->value.ptr;
+    }
+
+    return 0;
+}
+
+int flecs_expr_program_eval(
+    const ecs_script_t *script,
+    const ecs_expr_program_t *program,
+    const ecs_expr_eval_desc_t *desc,
+    ecs_value_t *out)
+{
+    ecs_expr_reg_t regs[FLECS_EXPR_VM_REG_MAX];
+    ecs_expr_vm_t vm;
+    vm.world = script->world;
+    vm.regs = regs;
+    vm.lanes = 1;
+    vm.count = 1;
+
+    if (flecs_expr_program_resolve(script, program, desc->vars, NULL, &vm)) {
+        goto error;
+    }
+
+    if (flecs_expr_vm_run(script, ecs_vec_first(&program->ops),
+        ecs_vec_first(&program->nodes), ecs_vec_count(&program->ops), &vm))
+    {
+        goto error;
+    }
+
+    if (!out->type) {
+        out->type = desc->type;
+    }
+
+    if (!out->type) {
+        out->type = program->type;
+    }
+
+    if (!out->ptr) {
+        out->ptr = ecs_value_new(vm.world, out->type);
+    }
+
+    if (out->type == program->type) {
+        flecs_expr_reg_to_ptr(program->kind, &regs[program->result], out->ptr);
+    } else {
+        ecs_expr_small_value_t storage;
+        flecs_expr_reg_to_ptr(program->kind, &regs[program->result], &storage);
+        ecs_value_t result = { .type = program->type, .ptr = &storage };
+        if (flecs_value_copy_to(vm.world, out, &result)) {
+            flecs_expr_visit_error(script, program->node,
+                "failed to write to output");
+            goto error;
+        }
+    }
+
+    return 0;
+error:
+    return -1;
+}
+
+int flecs_expr_program_eval_batch(
+    const ecs_script_t *script,
+    const ecs_expr_program_t *program,
+    const ecs_expr_eval_batch_desc_t *desc)
+{
+    ecs_world_t *world = script->world;
+    ecs_expr_reg_t *regs = NULL;
+    ecs_expr_vm_t vm;
+    vm.world = world;
+    vm.lanes = FLECS_EXPR_VM_LANES;
+
+    if (flecs_expr_program_resolve(
+        script, program, desc->vars, desc->columns, &vm))
+    {
+        goto error;
+    }
+
+    ecs_entity_t type = desc->type ? desc->type : program->type;
+    const ecs_type_info_t *ti = ecs_get_type_info(world, type);
+    ecs_check(ti != NULL, ECS_INVALID_PARAMETER,
+        "output type of batch is not a type");
+    ecs_size_t out_stride = desc->out_stride ? desc->out_stride : ti->size;
+
+    /* Convert the result in place if output type is a different primitive.
+     * Other types are converted one value at a time with a meta cursor. */
+    ecs_expr_reg_kind_t out_kind = program->kind;
+    ecs_expr_op_t cast = {0};
+    const ecs_expr_node_t *cast_node = program->node;
+    int32_t cast_count = 0;
+    bool use_cursor = false;
+    if (type != program->type) {
+        int result = flecs_expr_cast_op(
+            program->kind, flecs_expr_reg_kind(type), &cast);
+        if (result == -1) {
+            use_cursor = true;
+        } else {
+            out_kind = flecs_expr_reg_kind(type);
+            if (result == 0) {
+                cast.dst = cast.a = cast.b = program->result;
+                cast_count = 1;
+            }
+        }
+    }
+
+    regs = ecs_os_malloc_n(ecs_expr_reg_t,
+        program->reg_count * FLECS_EXPR_VM_LANES);
+
+    const char *src[FLECS_EXPR_VM_SOURCE_MAX];
+    int32_t i, s, source_count = ecs_vec_count(&program->sources);
+    ecs_os_memcpy_n(src, vm.src, const char*, source_count);
+    vm.regs = regs;
+
+    const ecs_expr_op_t *ops = ecs_vec_first(&program->ops);
+    const ecs_expr_node_t **nodes = ecs_vec_first(&program->nodes);
+    int32_t op_count = ecs_vec_count(&program->ops);
+    const ecs_expr_reg_t *result = &regs[program->result * FLECS_EXPR_VM_LANES];
+
+    int32_t row;
+    for (row = 0; row < desc->count; row += FLECS_EXPR_VM_LANES) {
+        vm.count = desc->count - row;
+        if (vm.count > FLECS_EXPR_VM_LANES) {
+            vm.count = FLECS_EXPR_VM_LANES;
+        }
+
+        for (s = 0; s < source_count; s ++) {
+            vm.src[s] = src[s] + row * vm.stride[s];
+        }
+
+        if (flecs_expr_vm_run(script, ops, nodes, op_count, &vm)) {
+            goto error;
+        }
+
+        if (flecs_expr_vm_run(script, &cast, &cast_node, cast_count, &vm)) {
+            goto error;
+        }
+
+        void *out = ECS_OFFSET(desc->out, row * out_stride);
+        if (!use_cursor) {
+            for (i = 0; i < vm.count; i ++) {
+                flecs_expr_reg_to_ptr(out_kind, &result[i],
+                    ECS_OFFSET(out, i * out_stride));
+            }
+            continue;
+        }
+
+        for (i = 0; i < vm.count; i ++) {
+            ecs_expr_small_value_t storage;
+            flecs_expr_reg_to_ptr(out_kind, &result[i], &storage);
+            ecs_value_t value = { .type = program->type, .ptr = &storage };
+            ecs_value_t dst = {
+                .type = type, .ptr = ECS_OFFSET(out, i * out_stride) };
+            if (flecs_value_copy_to(world, &dst, &value)) {
+                flecs_expr_visit_error(script, program->node,
+                    "failed to write to output");
+                goto error;
+            }
+        }
+    }
+
+    ecs_os_free(regs);
+    return 0;
+error:
+    ecs_os_free(regs);
+    return -1;
+}
+
+#endif
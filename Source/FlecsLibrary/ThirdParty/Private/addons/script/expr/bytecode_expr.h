@@ -0,0 +1,208 @@
+/**
+ * @file addons/script/expr/bytecode_expr.h
+ * @brief Register bytecode for script expressions.
+ *
+ * Expressions that only use primitive values (numbers, bools, variables and
+ * members of variables, function calls with primitive arguments) are lowered
+ * after type checking & folding to a flat list of typed instructions that
+ * operate on 64 bit registers. Evaluating the program doesn't require walking
+ * the AST or allocating intermediate values.
+ *
+ * Every instruction operates on a block of lanes, which lets the same program
+ * evaluate an expression for many rows of a table column at once. A single
+ * evaluation runs with one lane.
+ */
+
+#ifndef FLECS_SCRIPT_EXPR_BYTECODE_H
+#define FLECS_SCRIPT_EXPR_BYTECODE_H
+
+/* Number of rows evaluated per instruction in batch mode */
+#define FLECS_EXPR_VM_LANES (64)
+
+/* Max number of registers in a program */
+#define FLECS_EXPR_VM_REG_MAX (256)
+
+/* Max number of variables a program can read from */
+#define FLECS_EXPR_VM_SOURCE_MAX (32)
+
+/* Max number of arguments of a function call, including method target */
+#define FLECS_EXPR_VM_ARG_MAX (16)
+
+/* Registers store values in a canonical 64 bit form: signed integers are sign
+ * extended, unsigned integers & bools are zero extended, and floating point
+ * values are stored as double (f32 values are rounded to float precision). */
+typedef union ecs_expr_reg_t {
+    int64_t i;
+    uint64_t u;
+    double f;
+} ecs_expr_reg_t;
+
+/* Storage kind of a primitive type in a register */
+typedef enum ecs_expr_reg_kind_t {
+    EcsExprRegInvalid,
+    EcsExprRegBool,
+    EcsExprRegI8,
+    EcsExprRegI16,
+    EcsExprRegI32,
+    EcsExprRegI64,
+    EcsExprRegU8,
+    EcsExprRegU16,
+    EcsExprRegU32,
+    EcsExprRegU64,
+    EcsExprRegF32,
+    EcsExprRegF64,
+    EcsExprRegEntity
+} ecs_expr_reg_kind_t;
+
+typedef enum ecs_expr_op_kind_t {
+    /* Values */
+    EcsExprOpConst,       /* r[dst] = imm */
+    EcsExprOpLoadBool,    /* r[dst] = *(T*)(src[a] + offset) */
+    EcsExprOpLoadI8,
+    EcsExprOpLoadI16,
+    EcsExprOpLoadI32,
+    EcsExprOpLoadI64,
+    EcsExprOpLoadU8,
+    EcsExprOpLoadU16,
+    EcsExprOpLoadU32,
+    EcsExprOpLoadU64,
+    EcsExprOpLoadF32,
+    EcsExprOpLoadF64,
+
+    /* Wrap result of integer operation to type width */
+    EcsExprOpNarrowI8,
+    EcsExprOpNarrowI16,
+    EcsExprOpNarrowI32,
+    EcsExprOpNarrowU8,
+    EcsExprOpNarrowU16,
+    EcsExprOpNarrowU32,
+    EcsExprOpNarrowF32,
+
+    /* Arithmetic. Add, sub, mul, and, or & shl are the same for signed and
+     * unsigned registers. */
+    EcsExprOpAddInt,
+    EcsExprOpSubInt,
+    EcsExprOpMulInt,
+    EcsExprOpModInt,
+    EcsExprOpAnd,
+    EcsExprOpOr,
+    EcsExprOpShl,
+    EcsExprOpShrI,
+    EcsExprOpShrU,
+    EcsExprOpAddF,
+    EcsExprOpSubF,
+    EcsExprOpMulF,
+    EcsExprOpDivF,
+
+    /* Comparisons */
+    EcsExprOpEq,
+    EcsExprOpNeq,
+    EcsExprOpEqF,
+    EcsExprOpNeqF,
+    EcsExprOpLtI,
+    EcsExprOpLtEqI,
+    EcsExprOpGtI,
+    EcsExprOpGtEqI,
+    EcsExprOpLtU,
+    EcsExprOpLtEqU,
+    EcsExprOpGtU,
+    EcsExprOpGtEqU,
+    EcsExprOpLtF,
+    EcsExprOpLtEqF,
+    EcsExprOpGtF,
+    EcsExprOpGtEqF,
+
+    /* Logic */
+    EcsExprOpLogicAnd,
+    EcsExprOpLogicOr,
+    EcsExprOpNot,
+
+    /* Casts. Checked casts fail if the value is outside of [min, max], same
+     * as when converting the value with a meta cursor. */
+    EcsExprOpToBool,
+    EcsExprOpIToF,
+    EcsExprOpUToF,
+    EcsExprOpIToF32,
+    EcsExprOpUToF32,
+    EcsExprOpCastI,
+    EcsExprOpCastU,
+    EcsExprOpCastFToI,
+    EcsExprOpCastFToU,
+
+    /* Function & method calls */
+    EcsExprOpCall
+} ecs_expr_op_kind_t;
+
+typedef struct ecs_expr_call_arg_t {
+    ecs_entity_t type;
+    ecs_expr_reg_kind_t kind;
+    int16_t reg;
+} ecs_expr_call_arg_t;
+
+typedef struct ecs_expr_call_t {
+    ecs_function_calldata_t calldata;
+    ecs_vec_t args;           /* vec<ecs_expr_call_arg_t>, this first for methods */
+    int32_t argc;             /* Number of arguments passed to callback */
+    ecs_entity_t result_type;
+    ecs_expr_reg_kind_t result_kind;
+} ecs_expr_call_t;
+
+typedef struct ecs_expr_op_t {
+    ecs_expr_op_kind_t kind;
+    int16_t dst;
+    int16_t a;
+    int16_t b;
+    union {
+        ecs_expr_reg_t imm;
+        ecs_size_t offset;
+        const ecs_expr_call_t *call;
+        struct {
+            ecs_expr_reg_t min;
+            ecs_expr_reg_t max;
+        } bounds;
+    } is;
+} ecs_expr_op_t;
+
+/* Memory read by load instructions. Global variables are resolved when the
+ * program is compiled, variables when it is evaluated. */
+typedef struct ecs_expr_source_t {
+    const char *name;         /* Variable name (NULL for global variables) */
+    ecs_entity_t type;
+    const void *ptr;          /* Global variable value */
+    const ecs_expr_node_t *node; /* First node that reads source */
+} ecs_expr_source_t;
+
+struct ecs_expr_program_t {
+    const ecs_expr_node_t *node; /* Expression that was compiled */
+    ecs_vec_t ops;            /* vec<ecs_expr_op_t> */
+    ecs_vec_t nodes;          /* vec<ecs_expr_node_t*>, node of each op */
+    ecs_vec_t sources;        /* vec<ecs_expr_source_t> */
+    ecs_vec_t calls;          /* vec<ecs_expr_call_t*> */
+    int16_t reg_count;
+    int16_t result;           /* Register that contains result */
+    ecs_entity_t type;        /* Type of result */
+    ecs_expr_reg_kind_t kind; /* Storage kind of result */
+};
+
+/* Returns NULL if the expression contains nodes that can't be lowered to
+ * bytecode, in which case it should be evaluated with the AST visitor. */
+ecs_expr_program_t* flecs_expr_compile(
+    ecs_script_t *script,
+    ecs_expr_node_t *node);
+
+void flecs_expr_program_free(
+    ecs_script_t *script,
+    ecs_expr_program_t *program);
+
+int flecs_expr_program_eval(
+    const ecs_script_t *script,
+    const ecs_expr_program_t *program,
+    const ecs_expr_eval_desc_t *desc,
+    ecs_value_t *out);
+
+int flecs_expr_program_eval_batch(
+    const ecs_script_t *script,
+    const ecs_expr_program_t *program,
+    const ecs_expr_eval_batch_desc_t *desc);
+
+#endif
@@ -9,6 +9,7 @@
 #include "stack_expr.h"
 #include "ast_expr.h"
 #include "visit_expr.h"
+#include "bytecode_expr.h"
 
 int flecs_value_copy_to(
     ecs_world_t *world,
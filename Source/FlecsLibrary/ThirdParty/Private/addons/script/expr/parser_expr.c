@@ -557,6 +557,10 @@ ecs_script_t* ecs_expr_parse(
         }
     }
 
+    if (!priv_desc.disable_bytecode) {
+        impl->program = flecs_expr_compile(script, impl->expr);
+    }
+
     // printf("%s\n", ecs_script_ast_to_str(script, true));
 
     return script;
@@ -585,11 +589,122 @@ int ecs_expr_eval(
         priv_desc.lookup_action = flecs_script_default_lookup;
     }
 
-    if (flecs_expr_visit_eval(script, impl->expr, &priv_desc, value)) {
-        goto error;
+    if (impl->program && !priv_desc.disable_bytecode) {
+        if (flecs_expr_program_eval(script, impl->program, &priv_desc, value)) {
+            goto error;
+        }
+    } else {
+        if (flecs_expr_visit_eval(script, impl->expr, &priv_desc, value)) {
+            goto error;
+        }
+    }
+
+    return 0;
+error:
+    return -1;
+}
+
+/* Evaluate expression one element at a time, by pointing variables at the
+ * elements of the columns. */
+static
+int flecs_expr_eval_batch_ast(
+    const ecs_script_t *script,
+    const ecs_expr_eval_batch_desc_t *desc)
+{
+    ecs_world_t *world = script->world;
+    ecs_script_impl_t *impl = flecs_script_impl(
+        ECS_CONST_CAST(ecs_script_t*, script));
+
+    /* Scope is popped before returning, which restores the parent scope */
+    ecs_script_vars_t *vars;
+    if (desc->vars) {
+        vars = ecs_script_vars_push(
+            ECS_CONST_CAST(ecs_script_vars_t*, desc->vars));
+    } else {
+        vars = ecs_script_vars_init(world);
+    }
+
+    ecs_script_var_t *column_vars[FLECS_EXPR_BATCH_COLUMN_MAX];
+    ecs_size_t strides[FLECS_EXPR_BATCH_COLUMN_MAX];
+    int32_t c, column_count = 0;
+
+    for (c = 0; c < FLECS_EXPR_BATCH_COLUMN_MAX; c ++) {
+        const ecs_expr_column_t *column = &desc->columns[c];
+        if (!column->name) {
+            break;
+        }
+
+        const ecs_type_info_t *ti = ecs_get_type_info(world, column->type);
+        ecs_check(ti != NULL, ECS_INVALID_PARAMETER, 
+            "type of column '%s' is not a type", column->name);
+
+        /* Variables don't own the column values, so they have no type_info */
+        ecs_script_var_t *var = ecs_script_vars_declare(vars, column->name);
+        ecs_check(var != NULL, ECS_INVALID_PARAMETER, 
+            "duplicate column '%s'", column->name);
+        var->value.type = column->type;
+        strides[c] = column->stride ? column->stride : ti->size;
+        column_count ++;
+    }
+
+    /* Variable storage can move while columns are declared, so get pointers
+     * after all columns are added. Column variables are the only variables in
+     * the scope, in column order. */
+    for (c = 0; c < column_count; c ++) {
+        column_vars[c] = ecs_vec_get_t(&vars->vars, ecs_script_var_t, c);
     }
 
+    ecs_entity_t type = desc->type ? desc->type : impl->expr->type;
+    const ecs_type_info_t *ti = ecs_get_type_info(world, type);
+    ecs_check(ti != NULL, ECS_INVALID_PARAMETER, 
+        "output type of batch is not a type");
+    ecs_size_t out_stride = desc->out_stride ? desc->out_stride : ti->size;
+
+    ecs_expr_eval_desc_t priv_desc = {
+        .vars = vars,
+        .type = type,
+        .lookup_action = flecs_script_default_lookup
+    };
+
+    int32_t i;
+    for (i = 0; i < desc->count; i ++) {
+        for (c = 0; c < column_count; c ++) {
+            column_vars[c]->value.ptr = ECS_OFFSET(
+                ECS_CONST_CAST(void*, desc->columns[c].ptr), i * strides[c]);
+        }
+
+        ecs_value_t out = {
+            .type = type, .ptr = ECS_OFFSET(desc->out, i * out_stride) };
+        if (flecs_expr_visit_eval(script, impl->expr, &priv_desc, &out)) {
+            goto error;
+        }
+    }
+
+    ecs_script_vars_pop(vars);
     return 0;
+error:
+    ecs_script_vars_pop(vars);
+    return -1;
+}
+
+int ecs_expr_eval_batch(
+    const ecs_script_t *script,
+    const ecs_expr_eval_batch_desc_t *desc)
+{
+    ecs_check(script != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(desc != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!desc->count || desc->out != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_script_impl_t *impl = flecs_script_impl(
+        /* Safe, won't be writing to script */
+        ECS_CONST_CAST(ecs_script_t*, script));
+    ecs_check(impl->expr != NULL, ECS_INVALID_PARAMETER, 
+        "script is not an expression");
+
+    if (impl->program) {
+        return flecs_expr_program_eval_batch(script, impl->program, desc);
+    }
+
+    return flecs_expr_eval_batch_ast(script, desc);
 error:
     return -1;
 }
@@ -613,6 +728,9 @@ const char* ecs_expr_run(
             "type of value parameter does not match desc->type");
     }
 
+    /* Expression is only evaluated once, compiling it is not worth it */
+    priv_desc.disable_bytecode = true;
+
     ecs_script_t *s = ecs_expr_parse(world, expr, &priv_desc);
     if (!s) {
         goto error;
@@ -14,12 +14,14 @@
 
 typedef struct ecs_script_scope_t ecs_script_scope_t;
 typedef struct ecs_script_entity_t ecs_script_entity_t;
+typedef struct ecs_expr_program_t ecs_expr_program_t;
 
 typedef struct ecs_script_impl_t {
     ecs_script_t pub;
     ecs_allocator_t allocator;
     ecs_script_scope_t *root;
     ecs_expr_node_t *expr; /* Only set if script is just an expression */
+    ecs_expr_program_t *program; /* Only set if expression was compiled */
     char *token_buffer;
     char *token_remaining; /* Remaining space in token buffer */
     const char *next_token; /* First character after expression */
@@ -86,6 +86,9 @@ void flecs_script_template_ctor(
 
         for (i = 0; i < count; i ++) {
             void *el = ECS_ELEM(ptr, ti->size, i);
+            if (mti->hooks.ctor) {
+                mti->hooks.ctor(ECS_OFFSET(el, member->offset), 1, mti);
+            }
             ecs_value_copy_w_type_info(world, mti, 
                 ECS_OFFSET(el, member->offset), value->value.ptr);
         }
@@ -123,6 +126,690 @@ void flecs_script_template_defer_on_set(
     });
 }
 
+/* Variable that statements in the template scope can depend on */
+typedef struct ecs_script_template_dep_var_t {
+    const char *name;
+    uint64_t props;
+} ecs_script_template_dep_var_t;
+
+typedef struct ecs_script_template_deps_ctx_t {
+    ecs_allocator_t *allocator;
+    ecs_vec_t vars; /* vec<ecs_script_template_dep_var_t> */
+    bool always;
+} ecs_script_template_deps_ctx_t;
+
+/* Visitor that evaluates the template scope for an instance */
+typedef struct ecs_script_template_visitor_t {
+    ecs_script_eval_visitor_t eval;
+    ecs_script_template_t *template;
+    ecs_script_template_instance_t *instance;
+    ecs_vec_t prev_emitted;  /* Output of statement in previous evaluation */
+    uint64_t changed;        /* Props that changed since previous evaluation */
+    int32_t stmt;            /* Current top level statement */
+    bool is_new;             /* First evaluation for instance */
+} ecs_script_template_visitor_t;
+
+static
+uint64_t flecs_script_template_prop_bit(
+    int32_t index)
+{
+    return 1llu << (index < 63 ? index : 63);
+}
+
+static
+uint64_t flecs_script_template_var_deps(
+    ecs_script_template_deps_ctx_t *ctx,
+    const char *name)
+{
+    if (name[0] == '$') {
+        name ++;
+    }
+
+    /* Variables are not scoped, so a name that's declared multiple times in
+     * different scopes depends on the props of all declarations. */
+    uint64_t result = 0;
+    int32_t i, count = ecs_vec_count(&ctx->vars);
+    ecs_script_template_dep_var_t *vars = ecs_vec_first(&ctx->vars);
+    for (i = 0; i < count; i ++) {
+        if (!ecs_os_strcmp(vars[i].name, name)) {
+            result |= vars[i].props;
+        }
+    }
+
+    return result;
+}
+
+/* Find variables in string that hasn't been parsed into expressions yet */
+static
+uint64_t flecs_script_template_string_deps(
+    ecs_script_template_deps_ctx_t *ctx,
+    const char *str)
+{
+    uint64_t result = 0;
+    char name[256];
+
+    while ((str = strchr(str, '$'))) {
+        int32_t len = 0;
+        str ++;
+
+        while (isalnum(str[0]) || str[0] == '_') {
+            if (len == (ECS_SIZEOF(name) - 1)) {
+                ctx->always = true;
+                return result;
+            }
+            name[len ++] = str[0];
+            str ++;
+        }
+
+        name[len] = '\0';
+        if (len) {
+            result |= flecs_script_template_var_deps(ctx, name);
+        }
+    }
+
+    return result;
+}
+
+static
+uint64_t flecs_script_template_expr_deps(
+    ecs_script_template_deps_ctx_t *ctx,
+    ecs_expr_node_t *node)
+{
+    if (!node) {
+        return 0;
+    }
+
+    uint64_t result = 0;
+    int32_t i, count;
+
+    switch(node->kind) {
+    case EcsExprValue:
+    case EcsExprGlobalVariable:
+        break;
+    case EcsExprInterpolatedString: {
+        ecs_expr_interpolated_string_t *str = 
+            (ecs_expr_interpolated_string_t*)node;
+        count = ecs_vec_count(&str->expressions);
+        if (!count) {
+            result = flecs_script_template_string_deps(ctx, str->value);
+        } else {
+            ecs_expr_node_t **exprs = ecs_vec_first(&str->expressions);
+            for (i = 0; i < count; i ++) {
+                result |= flecs_script_template_expr_deps(ctx, exprs[i]);
+            }
+        }
+        break;
+    }
+    case EcsExprInitializer:
+    case EcsExprEmptyInitializer: {
+        ecs_expr_initializer_t *init = (ecs_expr_initializer_t*)node;
+        ecs_expr_initializer_element_t *elems = ecs_vec_first(&init->elements);
+        count = ecs_vec_count(&init->elements);
+        for (i = 0; i < count; i ++) {
+            result |= flecs_script_template_expr_deps(ctx, elems[i].value);
+        }
+        break;
+    }
+    case EcsExprUnary:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_unary_t*)node)->expr);
+        break;
+    case EcsExprBinary:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_binary_t*)node)->left);
+        result |= flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_binary_t*)node)->right);
+        break;
+    case EcsExprIdentifier: {
+        ecs_expr_identifier_t *ident = (ecs_expr_identifier_t*)node;
+        result = flecs_script_template_var_deps(ctx, ident->value);
+        result |= flecs_script_template_expr_deps(ctx, ident->expr);
+        break;
+    }
+    case EcsExprVariable:
+        result = flecs_script_template_var_deps(ctx, 
+            ((ecs_expr_variable_t*)node)->name);
+        break;
+    case EcsExprMethod:
+        /* Methods read the state of the entity they're called on */
+        ctx->always = true;
+        /* fall through */
+    case EcsExprFunction:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_function_t*)node)->left);
+        result |= flecs_script_template_expr_deps(ctx, 
+            (ecs_expr_node_t*)((ecs_expr_function_t*)node)->args);
+        break;
+    case EcsExprMember:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_member_t*)node)->left);
+        break;
+    case EcsExprComponent:
+        /* Component values are read from the world */
+        ctx->always = true;
+        /* fall through */
+    case EcsExprElement:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_element_t*)node)->left);
+        result |= flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_element_t*)node)->index);
+        break;
+    case EcsExprCast:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_expr_cast_t*)node)->expr);
+        break;
+    }
+
+    return result;
+}
+
+static
+uint64_t flecs_script_template_id_deps(
+    ecs_script_template_deps_ctx_t *ctx,
+    ecs_script_id_t *id)
+{
+    uint64_t result = 0;
+    if (id->first && id->first[0] == '$') {
+        result |= flecs_script_template_var_deps(ctx, id->first);
+    }
+    if (id->second && id->second[0] == '$') {
+        result |= flecs_script_template_var_deps(ctx, id->second);
+    }
+    return result;
+}
+
+static
+uint64_t flecs_script_template_node_deps(
+    ecs_script_template_deps_ctx_t *ctx,
+    ecs_script_node_t *node);
+
+static
+uint64_t flecs_script_template_scope_deps(
+    ecs_script_template_deps_ctx_t *ctx,
+    ecs_script_scope_t *scope)
+{
+    if (!scope) {
+        return 0;
+    }
+
+    uint64_t result = 0;
+    ecs_script_node_t **stmts = ecs_vec_first(&scope->stmts);
+    int32_t i, count = ecs_vec_count(&scope->stmts);
+    for (i = 0; i < count; i ++) {
+        result |= flecs_script_template_node_deps(ctx, stmts[i]);
+    }
+
+    return result;
+}
+
+static
+uint64_t flecs_script_template_node_deps(
+    ecs_script_template_deps_ctx_t *ctx,
+    ecs_script_node_t *node)
+{
+    uint64_t result = 0;
+
+    switch(node->kind) {
+    case EcsAstScope:
+        result = flecs_script_template_scope_deps(ctx, 
+            (ecs_script_scope_t*)node);
+        break;
+    case EcsAstTag:
+    case EcsAstWithTag:
+        result = flecs_script_template_id_deps(ctx, 
+            &((ecs_script_tag_t*)node)->id);
+        break;
+    case EcsAstComponent:
+    case EcsAstWithComponent:
+        result = flecs_script_template_id_deps(ctx, 
+            &((ecs_script_component_t*)node)->id);
+        result |= flecs_script_template_expr_deps(ctx, 
+            ((ecs_script_component_t*)node)->expr);
+        break;
+    case EcsAstDefaultComponent:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_script_default_component_t*)node)->expr);
+        break;
+    case EcsAstVarComponent:
+        result = flecs_script_template_var_deps(ctx, 
+            ((ecs_script_var_component_t*)node)->name);
+        break;
+    case EcsAstWithVar:
+        result = flecs_script_template_var_deps(ctx, 
+            ((ecs_script_var_node_t*)node)->name);
+        break;
+    case EcsAstWith:
+        result = flecs_script_template_scope_deps(ctx, 
+            ((ecs_script_with_t*)node)->expressions);
+        result |= flecs_script_template_scope_deps(ctx, 
+            ((ecs_script_with_t*)node)->scope);
+        break;
+    case EcsAstUsing:
+    case EcsAstModule:
+    case EcsAstAnnotation:
+    case EcsAstTemplate:
+    case EcsAstProp:
+        break;
+    case EcsAstConst: {
+        ecs_script_var_node_t *var_node = (ecs_script_var_node_t*)node;
+        result = flecs_script_template_expr_deps(ctx, var_node->expr);
+        ecs_script_template_dep_var_t *var = ecs_vec_append_t(
+            ctx->allocator, &ctx->vars, ecs_script_template_dep_var_t);
+        var->name = var_node->name;
+        var->props = result;
+        break;
+    }
+    case EcsAstEntity: {
+        ecs_script_entity_t *entity = (ecs_script_entity_t*)node;
+        if (entity->kind && entity->kind[0] == '$') {
+            result = flecs_script_template_var_deps(ctx, entity->kind);
+        }
+        result |= flecs_script_template_expr_deps(ctx, entity->name_expr);
+        result |= flecs_script_template_scope_deps(ctx, entity->scope);
+        break;
+    }
+    case EcsAstPairScope:
+        result = flecs_script_template_id_deps(ctx, 
+            &((ecs_script_pair_scope_t*)node)->id);
+        result |= flecs_script_template_scope_deps(ctx, 
+            ((ecs_script_pair_scope_t*)node)->scope);
+        break;
+    case EcsAstIf:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_script_if_t*)node)->expr);
+        result |= flecs_script_template_scope_deps(ctx, 
+            ((ecs_script_if_t*)node)->if_true);
+        result |= flecs_script_template_scope_deps(ctx, 
+            ((ecs_script_if_t*)node)->if_false);
+        break;
+    case EcsAstFor:
+        result = flecs_script_template_expr_deps(ctx, 
+            ((ecs_script_for_range_t*)node)->from);
+        result |= flecs_script_template_expr_deps(ctx, 
+            ((ecs_script_for_range_t*)node)->to);
+        result |= flecs_script_template_scope_deps(ctx, 
+            ((ecs_script_for_range_t*)node)->scope);
+        break;
+    }
+
+    return result;
+}
+
+/* Find which props each top level statement of the template depends on, so 
+ * that only statements that depend on modified props are reevaluated. */
+static
+void flecs_script_template_init_deps(
+    ecs_world_t *world,
+    ecs_script_impl_t *script,
+    ecs_script_template_t *template)
+{
+    ecs_allocator_t *a = &script->allocator;
+    ecs_script_scope_t *scope = template->node->scope;
+    ecs_script_node_t **stmts = ecs_vec_first(&scope->stmts);
+    int32_t i, prop = 0, count = ecs_vec_count(&scope->stmts);
+
+    template->size = template->type_info->size;
+
+    const EcsStruct *st = ecs_get(world, template->entity, EcsStruct);
+    if (st) {
+        const ecs_member_t *members = st->members.array;
+        ecs_vec_set_count_t(a, &template->prop_offsets, ecs_size_t, 
+            st->members.count);
+        for (i = 0; i < st->members.count; i ++) {
+            ecs_vec_get_t(&template->prop_offsets, ecs_size_t, i)[0] = 
+                members[i].offset;
+        }
+    }
+
+    ecs_script_template_deps_ctx_t ctx = { .allocator = a };
+    ecs_vec_init_t(a, &ctx.vars, ecs_script_template_dep_var_t, 0);
+
+    /* Props are members of the template in order of declaration */
+    for (i = 0; i < count; i ++) {
+        ecs_script_var_node_t *node = (ecs_script_var_node_t*)stmts[i];
+        if (node->node.kind == EcsAstProp && node->type) {
+            ecs_script_template_dep_var_t *var = ecs_vec_append_t(
+                a, &ctx.vars, ecs_script_template_dep_var_t);
+            var->name = node->name;
+            var->props = flecs_script_template_prop_bit(prop ++);
+        }
+    }
+
+    ecs_vec_set_count_t(a, &template->stmt_deps, 
+        ecs_script_template_deps_t, count);
+    ecs_script_template_deps_t *deps = ecs_vec_first(&template->stmt_deps);
+
+    for (i = 0; i < count; i ++) {
+        ctx.always = false;
+        deps[i].props = flecs_script_template_node_deps(&ctx, stmts[i]);
+        deps[i].always = ctx.always;
+        deps[i].target = i;
+
+        switch(stmts[i]->kind) {
+        case EcsAstUsing:
+        case EcsAstModule:
+        case EcsAstConst:
+            /* Declare state that's used by the next statements */
+            deps[i].always = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    /* Annotations are applied to the next entity, so only evaluate them if the
+     * entity is evaluated. */
+    for (i = count - 1; i >= 0; i --) {
+        if (stmts[i]->kind == EcsAstAnnotation && (i < (count - 1))) {
+            deps[i].target = deps[i + 1].target;
+        }
+    }
+
+    ecs_vec_fini_t(a, &ctx.vars, ecs_script_template_dep_var_t);
+}
+
+static
+int flecs_script_template_emit_cmp(
+    const void *ptr_1,
+    const void *ptr_2)
+{
+    const ecs_script_template_emit_t *e1 = ptr_1;
+    const ecs_script_template_emit_t *e2 = ptr_2;
+    if (e1->entity != e2->entity) {
+        return (e1->entity > e2->entity) - (e1->entity < e2->entity);
+    }
+    return (e1->id > e2->id) - (e1->id < e2->id);
+}
+
+static
+bool flecs_script_template_emit_find(
+    ecs_vec_t *emitted,
+    const ecs_script_template_emit_t *emit,
+    bool is_sorted)
+{
+    ecs_script_template_emit_t *array = ecs_vec_first(emitted);
+    int32_t i, count = ecs_vec_count(emitted);
+    if (is_sorted) {
+        return bsearch(emit, array, flecs_itosize(count), 
+            ECS_SIZEOF(ecs_script_template_emit_t), 
+                flecs_script_template_emit_cmp) != NULL;
+    }
+
+    for (i = 0; i < count; i ++) {
+        if (array[i].entity == emit->entity && array[i].id == emit->id) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Remove components & delete entities that a statement emitted in the previous
+ * evaluation, but no longer emits. */
+static
+void flecs_script_template_apply_diff(
+    ecs_script_template_visitor_t *v,
+    int32_t stmt,
+    ecs_vec_t *prev,
+    ecs_vec_t *cur)
+{
+    int32_t i, count = ecs_vec_count(prev);
+    if (!count) {
+        return;
+    }
+
+    ecs_world_t *world = v->eval.world;
+    ecs_entity_t instance = v->eval.entity->eval;
+    ecs_script_template_emit_t *emits = ecs_vec_first(prev);
+    qsort(ecs_vec_first(cur), flecs_itosize(ecs_vec_count(cur)), 
+        ECS_SIZEOF(ecs_script_template_emit_t), flecs_script_template_emit_cmp);
+
+    for (i = 0; i < count; i ++) {
+        ecs_script_template_emit_t *emit = &emits[i];
+
+        /* Components of the instance itself are not removed, same as when the
+         * entire template is evaluated. */
+        if (emit->entity == instance) {
+            continue;
+        }
+
+        if (flecs_script_template_emit_find(cur, emit, true)) {
+            continue;
+        }
+
+        if (!ecs_is_alive(world, emit->entity)) {
+            continue;
+        }
+
+        if (!emit->id) {
+            ecs_delete(world, emit->entity);
+            continue;
+        }
+
+        /* Entity could also be populated by another statement */
+        int32_t s, stmt_count = ecs_vec_count(&v->template->stmt_deps);
+        for (s = 0; s < stmt_count; s ++) {
+            if (s == stmt) {
+                continue;
+            }
+
+            if (flecs_script_template_emit_find(
+                &v->instance->emitted[s], emit, false)) 
+            {
+                break;
+            }
+        }
+
+        if (s == stmt_count) {
+            ecs_remove_id(world, emit->entity, emit->id);
+        }
+    }
+}
+
+static
+bool flecs_script_template_stmt_is_dirty(
+    ecs_script_template_visitor_t *v,
+    int32_t stmt)
+{
+    if (v->is_new) {
+        return true;
+    }
+
+    ecs_script_template_deps_t *deps = ecs_vec_get_t(
+        &v->template->stmt_deps, ecs_script_template_deps_t, stmt);
+    if (deps->target != stmt) {
+        return flecs_script_template_stmt_is_dirty(v, deps->target);
+    }
+
+    if (deps->always || (deps->props & v->changed)) {
+        return true;
+    }
+
+    /* Reevaluate statement if one of its entities got deleted */
+    ecs_vec_t *emitted = &v->instance->emitted[stmt];
+    ecs_script_template_emit_t *emits = ecs_vec_first(emitted);
+    int32_t i, count = ecs_vec_count(emitted);
+    for (i = 0; i < count; i ++) {
+        if (!emits[i].id && !ecs_is_alive(v->eval.world, emits[i].entity)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Visit action that only evaluates top level statements of the template scope
+ * that depend on props that changed since the last evaluation. */
+static
+int flecs_script_template_eval_instance_node(
+    ecs_script_template_visitor_t *v,
+    ecs_script_node_t *node)
+{
+    /* Depth 1 is the template scope, 2 a top level statement */
+    if (v->eval.base.depth != 2) {
+        return flecs_script_eval_node(&v->eval, node);
+    }
+
+    int32_t stmt = v->stmt ++;
+    if (!flecs_script_template_stmt_is_dirty(v, stmt)) {
+        return 0;
+    }
+
+    /* Record new output of statement while keeping the previous output */
+    ecs_vec_t *emitted = &v->instance->emitted[stmt];
+    ecs_vec_t prev = *emitted;
+    *emitted = v->prev_emitted;
+    ecs_vec_clear(emitted);
+    v->prev_emitted = prev;
+
+    v->eval.emitted = emitted;
+    int result = flecs_script_eval_node(&v->eval, node);
+    v->eval.emitted = NULL;
+
+    if (!result) {
+        flecs_script_template_apply_diff(
+            v, stmt, &v->prev_emitted, emitted);
+    }
+
+    return result;
+}
+
+static
+bool flecs_script_template_prop_equals(
+    const ecs_type_info_t *ti,
+    const void *ptr_1,
+    const void *ptr_2)
+{
+    if (ti->component == ecs_id(ecs_string_t)) {
+        const char *str_1 = *(const char**)ptr_1;
+        const char *str_2 = *(const char**)ptr_2;
+        if (!str_1 || !str_2) {
+            return str_1 == str_2;
+        }
+        return !ecs_os_strcmp(str_1, str_2);
+    }
+
+    if (ti->hooks.copy) {
+        /* Can't compare types with resources, assume value changed */
+        return false;
+    }
+
+    return !ecs_os_memcmp(ptr_1, ptr_2, ti->size);
+}
+
+static
+uint64_t flecs_script_template_props_changed(
+    ecs_script_template_t *template,
+    ecs_script_template_instance_t *instance,
+    const void *data)
+{
+    uint64_t result = 0;
+    const ecs_size_t *offsets = ecs_vec_first(&template->prop_offsets);
+    const ecs_script_var_t *props = ecs_vec_first(&template->prop_defaults);
+    int32_t i, count = ecs_vec_count(&template->prop_offsets);
+    for (i = 0; i < count; i ++) {
+        if (!flecs_script_template_prop_equals(props[i].type_info, 
+            ECS_OFFSET(instance->props, offsets[i]), 
+            ECS_OFFSET(data, offsets[i])))
+        {
+            result |= flecs_script_template_prop_bit(i);
+        }
+    }
+
+    return result;
+}
+
+static
+void flecs_script_template_props_copy(
+    ecs_world_t *world,
+    ecs_script_template_t *template,
+    ecs_script_template_instance_t *instance,
+    const void *data)
+{
+    const ecs_size_t *offsets = ecs_vec_first(&template->prop_offsets);
+    const ecs_script_var_t *props = ecs_vec_first(&template->prop_defaults);
+    int32_t i, count = ecs_vec_count(&template->prop_offsets);
+    for (i = 0; i < count; i ++) {
+        ecs_value_copy_w_type_info(world, props[i].type_info,
+            ECS_OFFSET(instance->props, offsets[i]), 
+            ECS_OFFSET(data, offsets[i]));
+    }
+}
+
+static
+ecs_script_template_instance_t* flecs_script_template_instance_new(
+    ecs_script_impl_t *script,
+    ecs_script_template_t *template,
+    ecs_entity_t entity)
+{
+    ecs_allocator_t *a = &script->allocator;
+    ecs_script_template_instance_t *result = flecs_calloc_t(
+        a, ecs_script_template_instance_t);
+
+    result->props = flecs_calloc(a, template->size);
+    const ecs_size_t *offsets = ecs_vec_first(&template->prop_offsets);
+    const ecs_script_var_t *props = ecs_vec_first(&template->prop_defaults);
+    int32_t i, count = ecs_vec_count(&template->prop_offsets);
+    for (i = 0; i < count; i ++) {
+        const ecs_type_info_t *ti = props[i].type_info;
+        if (ti->hooks.ctor) {
+            ti->hooks.ctor(ECS_OFFSET(result->props, offsets[i]), 1, ti);
+        }
+    }
+
+    count = ecs_vec_count(&template->stmt_deps);
+    result->emitted = flecs_alloc_n(a, ecs_vec_t, count);
+    for (i = 0; i < count; i ++) {
+        ecs_vec_init_t(a, &result->emitted[i], ecs_script_template_emit_t, 0);
+    }
+
+    ecs_map_insert_ptr(&template->instances, entity, result);
+
+    return result;
+}
+
+static
+void flecs_script_template_instance_free(
+    ecs_script_impl_t *script,
+    ecs_script_template_t *template,
+    ecs_script_template_instance_t *instance)
+{
+    ecs_allocator_t *a = &script->allocator;
+    const ecs_size_t *offsets = ecs_vec_first(&template->prop_offsets);
+    const ecs_script_var_t *props = ecs_vec_first(&template->prop_defaults);
+    int32_t i, count = ecs_vec_count(&template->prop_offsets);
+    for (i = 0; i < count; i ++) {
+        const ecs_type_info_t *ti = props[i].type_info;
+        if (ti->hooks.dtor) {
+            ti->hooks.dtor(ECS_OFFSET(instance->props, offsets[i]), 1, ti);
+        }
+    }
+
+    flecs_free(a, template->size, instance->props);
+
+    count = ecs_vec_count(&template->stmt_deps);
+    for (i = 0; i < count; i ++) {
+        ecs_vec_fini_t(a, &instance->emitted[i], ecs_script_template_emit_t);
+    }
+
+    flecs_free_n(a, ecs_vec_t, count, instance->emitted);
+    flecs_free_t(a, ecs_script_template_instance_t, instance);
+}
+
+static
+void flecs_script_template_instance_remove(
+    ecs_script_impl_t *script,
+    ecs_script_template_t *template,
+    ecs_entity_t entity)
+{
+    ecs_script_template_instance_t *instance = ecs_map_get_deref(
+        &template->instances, ecs_script_template_instance_t, entity);
+    if (instance) {
+        flecs_script_template_instance_free(script, template, instance);
+        ecs_map_remove(&template->instances, entity);
+    }
+}
+
 static
 void flecs_script_template_instantiate(
     ecs_world_t *world,
@@ -150,21 +837,36 @@ void flecs_script_template_instantiate(
     const ecs_type_info_t *ti = template->type_info;
     ecs_assert(ti != NULL, ECS_INTERNAL_ERROR, NULL);
     const EcsStruct *st = ecs_record_get(world, r, EcsStruct);
+    ecs_script_impl_t *impl = flecs_script_impl(script->script);
+
+    /* Only track instances if props match the members of the template type */
+    int32_t member_count = st ? st->members.count : 0;
+    bool is_incremental = 
+        ecs_vec_count(&template->prop_offsets) == member_count &&
+        ecs_vec_count(&template->prop_defaults) == member_count;
 
-    ecs_script_eval_visitor_t v;
+    ecs_script_template_visitor_t tv = { .template = template };
+    ecs_script_eval_visitor_t *v = &tv.eval;
     ecs_script_eval_desc_t desc = {
         .runtime = flecs_script_runtime_get(world)
     };
 
-    flecs_script_eval_visit_init(flecs_script_impl(script->script), &v, &desc);
-    ecs_vec_t prev_using = v.r->using;
+    flecs_script_eval_visit_init(impl, v, &desc);
+    ecs_vec_t prev_using = v->r->using;
     ecs_vec_t prev_with = desc.runtime->with;
     ecs_vec_t prev_with_type_info = desc.runtime->with_type_info;
-    v.r->using = template->using_;
-    v.template_entity = template_entity;
+    v->r->using = template->using_;
+    v->template_entity = template_entity;
     ecs_vec_init_t(NULL, &desc.runtime->with, ecs_value_t, 0);
     ecs_vec_init_t(NULL, &desc.runtime->with_type_info, ecs_type_info_t*, 0);
 
+    if (is_incremental) {
+        v->base.visit = (ecs_visit_action_t)
+            flecs_script_template_eval_instance_node;
+        ecs_vec_init_t(&impl->allocator, &tv.prev_emitted, 
+            ecs_script_template_emit_t, 0);
+    }
+
     ecs_script_scope_t *scope = template->node->scope;
 
     /* Dummy entity node for instance */
@@ -176,18 +878,18 @@ void flecs_script_template_instantiate(
         .scope = scope
     };
 
-    v.entity = &instance_node;
+    v->entity = &instance_node;
 
     int32_t i, m;
     for (i = 0; i < count; i ++) {
-        v.parent = entities[i];
-        ecs_assert(ecs_is_alive(world, v.parent), ECS_INTERNAL_ERROR, NULL);
+        v->parent = entities[i];
+        ecs_assert(ecs_is_alive(world, v->parent), ECS_INTERNAL_ERROR, NULL);
 
         instance_node.eval = entities[i];
 
         /* Create variables to hold template properties */
         ecs_script_vars_t *vars = flecs_script_vars_push(
-            NULL, &v.r->stack, &v.r->allocator);
+            NULL, &v->r->stack, &v->r->allocator);
         vars->parent = template->vars; /* Include hoisted variables */
 
         /* Populate properties from template members */
@@ -210,11 +912,39 @@ void flecs_script_template_instantiate(
         var->value.type = ecs_id(ecs_entity_t);
         var->value.ptr = &instance;
 
-        ecs_script_clear(world, template_entity, instance);
+        tv.instance = NULL;
+        if (is_incremental) {
+            tv.instance = ecs_map_get_deref(&template->instances, 
+                ecs_script_template_instance_t, instance);
+        }
+
+        if (tv.instance) {
+            tv.changed = flecs_script_template_props_changed(
+                template, tv.instance, data);
+            tv.is_new = false;
+        } else {
+            ecs_script_clear(world, template_entity, instance);
+            if (is_incremental) {
+                tv.instance = flecs_script_template_instance_new(
+                    impl, template, instance);
+            }
+            tv.is_new = true;
+        }
 
         /* Run template code */
-        v.vars = vars;
-        ecs_script_visit_scope(&v, scope);
+        tv.stmt = 0;
+        v->vars = vars;
+        int result = ecs_script_visit_scope(v, scope);
+
+        if (tv.instance) {
+            if (result) {
+                /* Evaluate entire template next time */
+                flecs_script_template_instance_remove(impl, template, instance);
+            } else {
+                flecs_script_template_props_copy(
+                    world, template, tv.instance, data);
+            }
+        }
 
         /* Pop variable scope */
         ecs_script_vars_pop(vars);
@@ -222,15 +952,20 @@ void flecs_script_template_instantiate(
         data = ECS_OFFSET(data, ti->size);
     }
 
+    if (is_incremental) {
+        ecs_vec_fini_t(&impl->allocator, &tv.prev_emitted, 
+            ecs_script_template_emit_t);
+    }
+
     ecs_vec_fini_t(&desc.runtime->allocator, 
         &desc.runtime->with, ecs_value_t);
     ecs_vec_fini_t(&desc.runtime->allocator, 
         &desc.runtime->with_type_info, ecs_type_info_t*);
 
-    v.r->with = prev_with;
-    v.r->with_type_info = prev_with_type_info;
-    v.r->using = prev_using;
-    flecs_script_eval_visit_fini(&v, &desc);
+    v->r->with = prev_with;
+    v->r->with_type_info = prev_with_type_info;
+    v->r->using = prev_using;
+    flecs_script_eval_visit_fini(v, &desc);
 }
 
 static
@@ -291,6 +1026,30 @@ void flecs_script_template_on_set(
     return;
 }
 
+/* Template on_remove handler to forget result of last evaluation */
+static
+void flecs_script_template_on_remove(
+    ecs_iter_t *it)
+{
+    ecs_world_t *world = it->world;
+    ecs_entity_t template_entity = ecs_field_id(it, 0);
+    const EcsScript *script = ecs_get(world, template_entity, EcsScript);
+    if (!script || !script->template_) {
+        return;
+    }
+
+    ecs_script_template_t *template = script->template_;
+    if (!ecs_map_count(&template->instances)) {
+        return;
+    }
+
+    int32_t i;
+    for (i = 0; i < it->count; i ++) {
+        flecs_script_template_instance_remove(
+            flecs_script_impl(script->script), template, it->entities[i]);
+    }
+}
+
 static
 int flecs_script_template_eval_prop(
     ecs_script_eval_visitor_t *v,
@@ -319,10 +1078,14 @@ int flecs_script_template_eval_prop(
         }
 
         var->value.type = type;
-        var->value.ptr = flecs_stack_alloc(
+        var->value.ptr = flecs_stack_calloc(
             &v->r->stack, ti->size, ti->alignment);
         var->type_info = ti;
 
+        if (ti->hooks.ctor) {
+            ti->hooks.ctor(var->value.ptr, 1, ti);
+        }
+
         if (flecs_script_eval_expr(v, &node->expr, &var->value)) {
             return -1;
         }
@@ -464,6 +1227,9 @@ ecs_script_template_t* flecs_script_template_init(
     ecs_script_template_t *result = flecs_alloc_t(a, ecs_script_template_t);
     ecs_vec_init_t(NULL, &result->prop_defaults, ecs_script_var_t, 0);
     ecs_vec_init_t(NULL, &result->using_, ecs_entity_t, 0);
+    ecs_vec_init_t(NULL, &result->prop_offsets, ecs_size_t, 0);
+    ecs_vec_init_t(NULL, &result->stmt_deps, ecs_script_template_deps_t, 0);
+    ecs_map_init(&result->instances, a);
     result->vars = ecs_script_vars_init(script->pub.world);
     return result;
 }
@@ -475,6 +1241,13 @@ void flecs_script_template_fini(
     ecs_assert(script != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_allocator_t *a = &script->allocator;
 
+    ecs_map_iter_t it = ecs_map_iter(&template->instances);
+    while (ecs_map_next(&it)) {
+        flecs_script_template_instance_free(script, template, 
+            ecs_map_ptr(&it));
+    }
+    ecs_map_fini(&template->instances);
+
     int32_t i, count = ecs_vec_count(&template->prop_defaults);
     ecs_script_var_t *values = ecs_vec_first(&template->prop_defaults);
     for (i = 0; i < count; i ++) {
@@ -489,6 +1262,8 @@ void flecs_script_template_fini(
     ecs_vec_fini_t(a, &template->prop_defaults, ecs_script_var_t);
 
     ecs_vec_fini_t(a, &template->using_, ecs_entity_t);
+    ecs_vec_fini_t(a, &template->prop_offsets, ecs_size_t);
+    ecs_vec_fini_t(a, &template->stmt_deps, ecs_script_template_deps_t);
     ecs_script_vars_fini(template->vars);
     flecs_free_t(a, ecs_script_template_t, template);
 }
@@ -527,6 +1302,8 @@ int flecs_script_eval_template(
 
     template->type_info = ecs_get_type_info(v->world, template_entity);
 
+    flecs_script_template_init_deps(v->world, v->base.script, template);
+
     ecs_add_pair(v->world, template_entity, EcsOnInstantiate, EcsOverride);
 
     EcsScript *script = ecs_ensure(v->world, template_entity, EcsScript);
@@ -545,6 +1322,7 @@ int flecs_script_eval_template(
     ecs_set_hooks_id(v->world, template_entity, &(ecs_type_hooks_t) {
         .ctor = flecs_script_template_ctor,
         .on_set = flecs_script_template_on_set,
+        .on_remove = flecs_script_template_on_remove,
         .ctx = v->world
     });
 
@@ -8,6 +8,39 @@
 
 extern ECS_COMPONENT_DECLARE(EcsScriptTemplateSetEvent);
 
+/* Props & constants a top level statement of the template scope depends on */
+typedef struct ecs_script_template_deps_t {
+    /* Bit for each prop (by member index) read by the statement. Props with an
+     * index >= 63 share the last bit. */
+    uint64_t props;
+
+    /* Statement must be evaluated for each instance, either because it changes
+     * visitor state used by the next statements, or because its result depends
+     * on more than the template props. */
+    bool always;
+
+    /* Statement that determines whether this statement is evaluated. For
+     * annotations this is the entity the annotation applies to. */
+    int32_t target;
+} ecs_script_template_deps_t;
+
+/* Component or entity emitted by a top level statement for an instance */
+typedef struct ecs_script_template_emit_t {
+    ecs_entity_t entity;
+    ecs_id_t id;             /* 0 if statement created the entity */
+} ecs_script_template_emit_t;
+
+/* Result of the last evaluation of the template for an instance. Used to only
+ * reevaluate statements that depend on props that changed, and to remove the
+ * components & entities that are no longer emitted by the new evaluation. */
+typedef struct ecs_script_template_instance_t {
+    /* Prop values the template was evaluated with */
+    void *props;
+
+    /* vec<ecs_script_template_emit_t> per top level statement */
+    ecs_vec_t *emitted;
+} ecs_script_template_instance_t;
+
 struct ecs_script_template_t {
     /* Template handle */
     ecs_entity_t entity;
@@ -26,6 +59,19 @@ struct ecs_script_template_t {
 
     /* Type info for template component */
     const ecs_type_info_t *type_info;
+
+    /* Offset of each prop in template component */
+    ecs_vec_t prop_offsets; /* vec<ecs_size_t> */
+
+    /* Size of template component. Stored so that instances can be cleaned up
+     * after the component is deleted. */
+    ecs_size_t size;
+
+    /* Dependencies of top level statements */
+    ecs_vec_t stmt_deps; /* vec<ecs_script_template_deps_t> */
+
+    /* Last evaluation, per instance */
+    ecs_map_t instances; /* map<ecs_entity_t, ecs_script_template_instance_t*> */
 };
 
 #define ECS_TEMPLATE_SMALL_SIZE (36)
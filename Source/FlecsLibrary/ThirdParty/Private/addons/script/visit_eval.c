@@ -103,6 +103,22 @@ int32_t flecs_script_with_count(
     return 0;
 }
 
+/* Record component or entity added by template instance */
+static inline
+void flecs_script_eval_emit(
+    ecs_script_eval_visitor_t *v,
+    ecs_entity_t entity,
+    ecs_id_t id)
+{
+    if (v->emitted) {
+        ecs_script_template_emit_t *emit = ecs_vec_append_t(
+            &v->base.script->allocator, v->emitted, 
+                ecs_script_template_emit_t);
+        emit->entity = entity;
+        emit->id = id;
+    }
+}
+
 const ecs_type_info_t* flecs_script_get_type_info(
     ecs_script_eval_visitor_t *v,
     void *node,
@@ -503,6 +519,16 @@ int flecs_script_eval_entity(
 
     node->parent = v->entity;
 
+    if (v->emitted) {
+        flecs_script_eval_emit(v, node->eval, 0);
+
+        int32_t w, with_count = flecs_script_with_count(v);
+        ecs_value_t *with = ecs_vec_first_t(&v->r->with, ecs_value_t);
+        for (w = 0; w < with_count; w ++) {
+            flecs_script_eval_emit(v, node->eval, with[w].type);
+        }
+    }
+
     if (v->template_entity) {
         ecs_add_pair(
             v->world, node->eval, EcsScriptTemplate, v->template_entity);
@@ -518,6 +544,7 @@ int flecs_script_eval_entity(
         }
 
         ecs_add_pair(v->world, node->eval, EcsSlotOf, parent);
+        flecs_script_eval_emit(v, node->eval, ecs_pair(EcsSlotOf, parent));
     }
 
     const EcsDefaultChildComponent *default_comp = NULL;
@@ -526,6 +553,7 @@ int flecs_script_eval_entity(
 
     if (node->eval_kind) {
         ecs_add_id(v->world, node->eval, node->eval_kind);
+        flecs_script_eval_emit(v, node->eval, node->eval_kind);
 
         default_comp = 
             ecs_get(v->world, node->eval_kind, EcsDefaultChildComponent);
@@ -616,6 +644,10 @@ int flecs_script_eval_tag(
         v, v->entity->eval, node->id.eval);
     ecs_add_id(v->world, src, node->id.eval);
 
+    if (src == v->entity->eval) {
+        flecs_script_eval_emit(v, src, node->id.eval);
+    }
+
     return 0;
 }
 
@@ -711,6 +743,10 @@ int flecs_script_eval_component(
         ecs_add_id(v->world, src, node->id.eval);
     }
 
+    if (src == v->entity->eval) {
+        flecs_script_eval_emit(v, src, node->id.eval);
+    }
+
     return 0;
 }
 
@@ -752,6 +788,8 @@ int flecs_script_eval_var_component(
         ecs_add_id(v->world, v->entity->eval, var_id);
     }
 
+    flecs_script_eval_emit(v, v->entity->eval, var_id);
+
     return 0;
 }
 
@@ -805,6 +843,7 @@ int flecs_script_eval_default_component(
     }
 
     ecs_modified_id(v->world, v->entity->eval, default_type);
+    flecs_script_eval_emit(v, v->entity->eval, default_type);
 
     return 0;
 }
@@ -19,6 +19,7 @@ typedef struct ecs_script_eval_visitor_t {
     int32_t with_relationship_sp;
     bool is_with_scope;
     ecs_script_vars_t *vars;
+    ecs_vec_t *emitted; /* Set when recording output of template instance */
 } ecs_script_eval_visitor_t;
 
 void flecs_script_eval_error_(
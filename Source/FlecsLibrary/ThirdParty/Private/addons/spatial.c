@@ -0,0 +1,1215 @@
+/**
+ * @file addons/spatial.c
+ * @brief Spatial index addon.
+ *
+ * Entities are sorted into a uniform grid. The entities and positions of all
+ * cells are stored in two flat arrays, where each cell owns a contiguous range
+ * of slots. A cell that runs out of slots is moved to the end of the arrays,
+ * which leaves a hole that is reclaimed when the index is rebuilt.
+ *
+ * The index is updated by three systems:
+ * - Prepare: resizes the per-stage buffers and decides whether to rebuild
+ * - Collect: (multi threaded) checks which rows changed. Positions that stay
+ *   in the same cell are updated in place, other rows are appended to the
+ *   buffer of the stage.
+ * - Commit: moves entities between cells, or rebuilds the index from the
+ *   stage buffers with a counting sort.
+ *
+ * Change detection is done per table by comparing the table dirty state with
+ * the state of the last update, after which rows are diffed against the
+ * positions stored in the index. This doesn't use query change detection, as
+ * that can't be shared between worker threads.
+ */
+
+#include "../private_api.h"
+
+#ifdef FLECS_SPATIAL
+
+#include <math.h>
+
+/* Minimum number of slots allocated for a cell that runs out of space */
+#define FLECS_SPATIAL_MIN_CELL_CAPACITY (4)
+
+/* Minimum number of unused slots before the index is compacted */
+#define FLECS_SPATIAL_MIN_DEAD_SLOTS (256)
+
+/* Cell coordinates are packed in 21 bits per axis */
+#define FLECS_SPATIAL_CELL_MAX ((1 << 20) - 1)
+#define FLECS_SPATIAL_CELL_MASK ((uint64_t)0x1FFFFF)
+
+typedef struct ecs_spatial_cell_t {
+    int32_t coord[3];       /* Cell coordinates */
+    int32_t start;          /* First slot of cell */
+    int32_t count;          /* Number of used slots */
+    int32_t capacity;       /* Number of slots owned by cell */
+} ecs_spatial_cell_t;
+
+typedef struct ecs_spatial_record_t {
+    ecs_entity_t entity;
+    double pos[3];
+    int32_t coord[3];
+} ecs_spatial_record_t;
+
+typedef struct ecs_spatial_table_state_t {
+    uint64_t table;
+    uint64_t state;
+} ecs_spatial_table_state_t;
+
+/* Per stage buffers written to by the Collect system. These don't use the world
+ * allocator, since they're written to from worker threads. */
+typedef struct ecs_spatial_stage_t {
+    ecs_vec_t records;      /* vec<ecs_spatial_record_t> */
+    ecs_vec_t tables;       /* vec<ecs_spatial_table_state_t> */
+} ecs_spatial_stage_t;
+
+typedef struct ecs_spatial_index_t {
+    ecs_world_t *world;
+    ecs_entity_t component;
+    int32_t offset;
+    bool f64;
+    double cell_size;
+    double inv_cell_size;
+
+    /* Flat slot arrays */
+    ecs_vec_t entities;     /* vec<ecs_entity_t> */
+    ecs_vec_t positions;    /* vec<double[3]> */
+    ecs_vec_t slot_cells;   /* vec<int32_t>, cell that owns slot */
+
+    ecs_vec_t cells;        /* vec<ecs_spatial_cell_t> */
+    ecs_map_t cell_map;     /* map<cell key, cell index> */
+    ecs_map_t slots;        /* map<entity, slot> */
+    ecs_map_t tables;       /* map<table id, dirty state of last update> */
+
+    int32_t min[3];         /* Bounds of cells (may be larger than needed) */
+    int32_t max[3];
+
+    int32_t count;          /* Number of entities in index */
+    int32_t dead;           /* Number of slots no longer owned by a cell */
+    bool rebuild;           /* Rebuild index during next update */
+
+    ecs_spatial_stage_t *stages;
+    int32_t stage_count;
+} ecs_spatial_index_t;
+
+static
+int32_t flecs_spatial_coord(
+    const ecs_spatial_index_t *index,
+    double value)
+{
+    double c = floor(value * index->inv_cell_size);
+    if (c > FLECS_SPATIAL_CELL_MAX) {
+        return FLECS_SPATIAL_CELL_MAX;
+    }
+    if (c < -FLECS_SPATIAL_CELL_MAX) {
+        return -FLECS_SPATIAL_CELL_MAX;
+    }
+    return (int32_t)c;
+}
+
+static
+uint64_t flecs_spatial_cell_key(
+    const int32_t coord[3])
+{
+    /* Set high bit so that a key is never 0 */
+    return (1ull << 63) |
+        (((uint64_t)coord[0] & FLECS_SPATIAL_CELL_MASK) << 42) |
+        (((uint64_t)coord[1] & FLECS_SPATIAL_CELL_MASK) << 21) |
+        ((uint64_t)coord[2] & FLECS_SPATIAL_CELL_MASK);
+}
+
+static
+void flecs_spatial_read(
+    const ecs_spatial_index_t *index,
+    const void *ptr,
+    double *out)
+{
+    if (index->f64) {
+        const double *v = ptr;
+        out[0] = v[0];
+        out[1] = v[1];
+        out[2] = v[2];
+    } else {
+        const float *v = ptr;
+        out[0] = (double)v[0];
+        out[1] = (double)v[1];
+        out[2] = (double)v[2];
+    }
+}
+
+static
+double flecs_spatial_dist_sq(
+    const double *a,
+    const double *b)
+{
+    double x = a[0] - b[0], y = a[1] - b[1], z = a[2] - b[2];
+    return x * x + y * y + z * z;
+}
+
+static
+const ecs_spatial_cell_t* flecs_spatial_cell_get(
+    const ecs_spatial_index_t *index,
+    const int32_t coord[3])
+{
+    ecs_map_val_t *cell = ecs_map_get(
+        &index->cell_map, flecs_spatial_cell_key(coord));
+    if (!cell) {
+        return NULL;
+    }
+    return ecs_vec_get_t(
+        &index->cells, ecs_spatial_cell_t, (int32_t)*cell - 1);
+}
+
+static
+int32_t flecs_spatial_cell_ensure(
+    ecs_spatial_index_t *index,
+    const int32_t coord[3])
+{
+    ecs_map_val_t *cell = ecs_map_ensure(
+        &index->cell_map, flecs_spatial_cell_key(coord));
+    if (*cell) {
+        return (int32_t)*cell - 1;
+    }
+
+    ecs_allocator_t *a = &index->world->allocator;
+    int32_t result = ecs_vec_count(&index->cells);
+    ecs_spatial_cell_t *c = ecs_vec_append_t(a, &index->cells,
+        ecs_spatial_cell_t);
+    ecs_os_zeromem(c);
+    c->coord[0] = coord[0];
+    c->coord[1] = coord[1];
+    c->coord[2] = coord[2];
+    *cell = flecs_ito(uint64_t, result + 1);
+
+    int32_t i;
+    for (i = 0; i < 3; i ++) {
+        if (!result || coord[i] < index->min[i]) {
+            index->min[i] = coord[i];
+        }
+        if (!result || coord[i] > index->max[i]) {
+            index->max[i] = coord[i];
+        }
+    }
+
+    return result;
+}
+
+static
+void flecs_spatial_slots_grow(
+    ecs_spatial_index_t *index,
+    int32_t count)
+{
+    if (!count) {
+        return;
+    }
+
+    ecs_allocator_t *a = &index->world->allocator;
+    ecs_vec_grow_t(a, &index->entities, ecs_entity_t, count);
+    ecs_vec_grow(a, &index->positions, ECS_SIZEOF(double) * 3, count);
+    ecs_vec_grow_t(a, &index->slot_cells, int32_t, count);
+}
+
+/* Move cell that ran out of space to the end of the slot arrays */
+static
+void flecs_spatial_cell_relocate(
+    ecs_spatial_index_t *index,
+    int32_t cell_index)
+{
+    ecs_spatial_cell_t *cell = ecs_vec_get_t(
+        &index->cells, ecs_spatial_cell_t, cell_index);
+    int32_t capacity = cell->capacity * 2;
+    if (capacity < FLECS_SPATIAL_MIN_CELL_CAPACITY) {
+        capacity = FLECS_SPATIAL_MIN_CELL_CAPACITY;
+    }
+
+    int32_t start = ecs_vec_count(&index->entities);
+    flecs_spatial_slots_grow(index, capacity);
+
+    ecs_entity_t *entities = ecs_vec_first(&index->entities);
+    double (*positions)[3] = ecs_vec_first(&index->positions);
+    int32_t *slot_cells = ecs_vec_first(&index->slot_cells);
+
+    int32_t i;
+    for (i = 0; i < cell->count; i ++) {
+        int32_t src = cell->start + i, dst = start + i;
+        entities[dst] = entities[src];
+        ecs_os_memcpy_n(positions[dst], positions[src], double, 3);
+        slot_cells[dst] = cell_index;
+        entities[src] = 0;
+        *ecs_map_get(&index->slots, entities[dst]) = flecs_ito(uint64_t, dst);
+    }
+
+    for (; i < capacity; i ++) {
+        entities[start + i] = 0;
+        slot_cells[start + i] = cell_index;
+    }
+
+    index->dead += cell->capacity;
+    cell->start = start;
+    cell->capacity = capacity;
+}
+
+static
+void flecs_spatial_insert(
+    ecs_spatial_index_t *index,
+    ecs_entity_t entity,
+    const double *pos,
+    int32_t cell_index)
+{
+    ecs_spatial_cell_t *cell = ecs_vec_get_t(
+        &index->cells, ecs_spatial_cell_t, cell_index);
+    if (cell->count == cell->capacity) {
+        flecs_spatial_cell_relocate(index, cell_index);
+    }
+
+    int32_t slot = cell->start + cell->count ++;
+    ecs_vec_get_t(&index->entities, ecs_entity_t, slot)[0] = entity;
+    ecs_os_memcpy_n(ecs_vec_get(&index->positions,
+        ECS_SIZEOF(double) * 3, slot), pos, double, 3);
+    ecs_vec_get_t(&index->slot_cells, int32_t, slot)[0] = cell_index;
+    ecs_map_insert(&index->slots, entity, flecs_ito(uint64_t, slot));
+    index->count ++;
+}
+
+/* Remove entity from slot by swapping it with the last entity in the cell */
+static
+void flecs_spatial_remove_slot(
+    ecs_spatial_index_t *index,
+    int32_t slot)
+{
+    ecs_entity_t *entities = ecs_vec_first(&index->entities);
+    double (*positions)[3] = ecs_vec_first(&index->positions);
+    int32_t cell_index = ecs_vec_get_t(&index->slot_cells, int32_t, slot)[0];
+    ecs_spatial_cell_t *cell = ecs_vec_get_t(
+        &index->cells, ecs_spatial_cell_t, cell_index);
+
+    ecs_map_remove(&index->slots, entities[slot]);
+
+    int32_t last = cell->start + cell->count - 1;
+    if (slot != last) {
+        entities[slot] = entities[last];
+        ecs_os_memcpy_n(positions[slot], positions[last], double, 3);
+        *ecs_map_get(&index->slots, entities[slot]) =
+            flecs_ito(uint64_t, slot);
+    }
+
+    entities[last] = 0;
+    cell->count --;
+    index->count --;
+}
+
+static
+void flecs_spatial_clear(
+    ecs_spatial_index_t *index)
+{
+    ecs_vec_clear(&index->entities);
+    ecs_vec_clear(&index->positions);
+    ecs_vec_clear(&index->slot_cells);
+    ecs_vec_clear(&index->cells);
+    ecs_map_clear(&index->cell_map);
+    ecs_map_clear(&index->slots);
+    ecs_map_clear(&index->tables);
+    index->count = 0;
+    index->dead = 0;
+}
+
+static
+bool flecs_spatial_record_valid(
+    const ecs_spatial_index_t *index,
+    const ecs_spatial_record_t *r)
+{
+    /* Entity could have been deleted or lost the component while commands
+     * were merged between the Collect and Commit systems. */
+    const ecs_world_t *world = index->world;
+    return ecs_is_alive(world, r->entity) &&
+        ecs_owns_id(world, r->entity, index->component);
+}
+
+/* Rebuild index with counting sort from the records of all stages */
+static
+void flecs_spatial_rebuild(
+    ecs_spatial_index_t *index)
+{
+    ecs_allocator_t *a = &index->world->allocator;
+    ecs_vec_t record_cells;
+    ecs_vec_init_t(a, &record_cells, int32_t, 0);
+
+    flecs_spatial_clear(index);
+
+    /* Assign records to cells, and count the number of records per cell */
+    int32_t s, i, total = 0;
+    for (s = 0; s < index->stage_count; s ++) {
+        ecs_vec_t *records = &index->stages[s].records;
+        ecs_spatial_record_t *r = ecs_vec_first(records);
+        int32_t count = ecs_vec_count(records);
+        if (!count) {
+            continue;
+        }
+
+        int32_t *rc = ecs_vec_grow_t(a, &record_cells, int32_t, count);
+        for (i = 0; i < count; i ++) {
+            if (!flecs_spatial_record_valid(index, &r[i])) {
+                rc[i] = -1;
+                continue;
+            }
+
+            rc[i] = flecs_spatial_cell_ensure(index, r[i].coord);
+            ecs_vec_get_t(&index->cells, ecs_spatial_cell_t, rc[i])->count ++;
+        }
+    }
+
+    /* Assign slot ranges to cells. Leave some room in each cell so that
+     * entities can move between cells without immediately relocating them. */
+    ecs_spatial_cell_t *cells = ecs_vec_first(&index->cells);
+    int32_t cell_count = ecs_vec_count(&index->cells);
+    for (i = 0; i < cell_count; i ++) {
+        ecs_spatial_cell_t *cell = &cells[i];
+        cell->start = total;
+        cell->capacity = cell->count + (cell->count >> 2) + 1;
+        cell->count = 0;
+        total += cell->capacity;
+    }
+
+    flecs_spatial_slots_grow(index, total);
+    if (!total) {
+        ecs_vec_fini_t(a, &record_cells, int32_t);
+        return;
+    }
+
+    ecs_os_memset_n(ecs_vec_first(&index->entities), 0, ecs_entity_t, total);
+
+    ecs_entity_t *entities = ecs_vec_first(&index->entities);
+    double (*positions)[3] = ecs_vec_first(&index->positions);
+    int32_t *slot_cells = ecs_vec_first(&index->slot_cells);
+    for (i = 0; i < cell_count; i ++) {
+        int32_t j, end = cells[i].start + cells[i].capacity;
+        for (j = cells[i].start; j < end; j ++) {
+            slot_cells[j] = i;
+        }
+    }
+
+    int32_t *rc = ecs_vec_first(&record_cells);
+    for (s = 0; s < index->stage_count; s ++) {
+        ecs_vec_t *records = &index->stages[s].records;
+        ecs_spatial_record_t *r = ecs_vec_first(records);
+        int32_t count = ecs_vec_count(records);
+        for (i = 0; i < count; i ++) {
+            int32_t cell_index = rc[i];
+            if (cell_index == -1) {
+                continue;
+            }
+
+            ecs_spatial_cell_t *cell = &cells[cell_index];
+            int32_t slot = cell->start + cell->count ++;
+            entities[slot] = r[i].entity;
+            ecs_os_memcpy_n(positions[slot], r[i].pos, double, 3);
+            ecs_map_insert(&index->slots, r[i].entity,
+                flecs_ito(uint64_t, slot));
+            index->count ++;
+        }
+        rc += count;
+    }
+
+    ecs_vec_fini_t(a, &record_cells, int32_t);
+}
+
+static
+void flecs_spatial_update(
+    ecs_spatial_index_t *index)
+{
+    int32_t s, i;
+    for (s = 0; s < index->stage_count; s ++) {
+        ecs_vec_t *records = &index->stages[s].records;
+        ecs_spatial_record_t *r = ecs_vec_first(records);
+        int32_t count = ecs_vec_count(records);
+        for (i = 0; i < count; i ++) {
+            if (!flecs_spatial_record_valid(index, &r[i])) {
+                continue;
+            }
+
+            int32_t cell = flecs_spatial_cell_ensure(index, r[i].coord);
+            ecs_map_val_t *slot = ecs_map_get(&index->slots, r[i].entity);
+            if (slot) {
+                int32_t cur = (int32_t)*slot;
+                if (ecs_vec_get_t(&index->slot_cells, int32_t, cur)[0] == cell){
+                    ecs_os_memcpy_n(ecs_vec_get(&index->positions,
+                        ECS_SIZEOF(double) * 3, cur), r[i].pos,
+                            double, 3);
+                    continue;
+                }
+                flecs_spatial_remove_slot(index, cur);
+            }
+
+            flecs_spatial_insert(index, r[i].entity, r[i].pos, cell);
+        }
+    }
+}
+
+static
+uint64_t flecs_spatial_table_state(
+    const ecs_table_t *table,
+    const ecs_table_record_t *tr)
+{
+    /* Tables without dirty state are always considered changed. The Commit
+     * system creates the dirty state so the table can be skipped next time. */
+    int32_t *dirty_state = table->dirty_state;
+    if (!dirty_state) {
+        return 0;
+    }
+
+    return ((uint64_t)(uint32_t)dirty_state[0] << 32) |
+        (uint32_t)dirty_state[tr->column + 1];
+}
+
+static
+void flecs_spatial_prepare(
+    ecs_iter_t *it)
+{
+    ecs_spatial_index_t *index = it->ctx;
+    ecs_allocator_t *a = &index->world->allocator;
+    int32_t i, stage_count = ecs_get_stage_count(it->real_world);
+
+    if (stage_count != index->stage_count) {
+        for (i = 0; i < index->stage_count; i ++) {
+            ecs_vec_fini_t(NULL, &index->stages[i].records,
+                ecs_spatial_record_t);
+            ecs_vec_fini_t(NULL, &index->stages[i].tables,
+                ecs_spatial_table_state_t);
+        }
+        flecs_free_n(a, ecs_spatial_stage_t, index->stage_count,
+            index->stages);
+        index->stages = flecs_calloc_n(a, ecs_spatial_stage_t, stage_count);
+        index->stage_count = stage_count;
+
+        for (i = 0; i < stage_count; i ++) {
+            ecs_vec_init_t(NULL, &index->stages[i].records,
+                ecs_spatial_record_t, 0);
+            ecs_vec_init_t(NULL, &index->stages[i].tables,
+                ecs_spatial_table_state_t, 0);
+        }
+    }
+
+    for (i = 0; i < stage_count; i ++) {
+        ecs_vec_clear(&index->stages[i].records);
+        ecs_vec_clear(&index->stages[i].tables);
+    }
+
+    if (index->dead > index->count &&
+        index->dead >= FLECS_SPATIAL_MIN_DEAD_SLOTS)
+    {
+        index->rebuild = true;
+    }
+}
+
+static
+void flecs_spatial_collect(
+    ecs_iter_t *it)
+{
+    ecs_spatial_index_t *index = it->ctx;
+    int32_t stage_id = ecs_stage_get_id(it->world);
+    ecs_assert(stage_id < index->stage_count, ECS_INTERNAL_ERROR, NULL);
+    ecs_spatial_stage_t *stage = &index->stages[stage_id];
+    bool rebuild = index->rebuild;
+
+    uint64_t state = flecs_spatial_table_state(it->table, it->trs[0]);
+    if (!rebuild && state) {
+        ecs_map_val_t *last = ecs_map_get(&index->tables, it->table->id);
+        if (last && *last == state) {
+            return;
+        }
+    }
+
+    /* A table can be split up between workers, only let the worker with the
+     * first row of the table store its state. */
+    if (!it->offset) {
+        ecs_spatial_table_state_t *ts = ecs_vec_append_t(
+            NULL, &stage->tables, ecs_spatial_table_state_t);
+        ts->table = it->table->id;
+        ts->state = state;
+    }
+
+    const char *ptr = ecs_field_w_size(it, 0, 0);
+    ecs_size_t size = it->sizes[0];
+    ptr += index->offset;
+
+    double (*positions)[3] = ecs_vec_first(&index->positions);
+    const int32_t *slot_cells = ecs_vec_first(&index->slot_cells);
+    const ecs_spatial_cell_t *cells = ecs_vec_first(&index->cells);
+
+    int32_t i, count = it->count;
+    for (i = 0; i < count; i ++, ptr += size) {
+        double pos[3];
+        int32_t coord[3];
+        flecs_spatial_read(index, ptr, pos);
+        coord[0] = flecs_spatial_coord(index, pos[0]);
+        coord[1] = flecs_spatial_coord(index, pos[1]);
+        coord[2] = flecs_spatial_coord(index, pos[2]);
+
+        if (!rebuild) {
+            ecs_map_val_t *slot = ecs_map_get(&index->slots, it->entities[i]);
+            if (slot) {
+                double *cur = positions[*slot];
+                if (cur[0] == pos[0] && cur[1] == pos[1] && cur[2] == pos[2]) {
+                    continue;
+                }
+
+                /* Entities are unique per worker, so positions that don't
+                 * leave their cell can be written directly. */
+                const ecs_spatial_cell_t *cell = &cells[slot_cells[*slot]];
+                if (cell->coord[0] == coord[0] &&
+                    cell->coord[1] == coord[1] &&
+                    cell->coord[2] == coord[2])
+                {
+                    ecs_os_memcpy_n(cur, pos, double, 3);
+                    continue;
+                }
+            }
+        }
+
+        ecs_spatial_record_t *r = ecs_vec_append_t(
+            NULL, &stage->records, ecs_spatial_record_t);
+        r->entity = it->entities[i];
+        ecs_os_memcpy_n(r->pos, pos, double, 3);
+        ecs_os_memcpy_n(r->coord, coord, int32_t, 3);
+    }
+}
+
+static
+void flecs_spatial_commit(
+    ecs_iter_t *it)
+{
+    ecs_spatial_index_t *index = it->ctx;
+    ecs_world_t *world = index->world;
+
+    if (index->rebuild) {
+        flecs_spatial_rebuild(index);
+        index->rebuild = false;
+    } else {
+        flecs_spatial_update(index);
+    }
+
+    int32_t s, i;
+    for (s = 0; s < index->stage_count; s ++) {
+        ecs_vec_t *tables = &index->stages[s].tables;
+        ecs_spatial_table_state_t *ts = ecs_vec_first(tables);
+        int32_t count = ecs_vec_count(tables);
+        for (i = 0; i < count; i ++) {
+            if (!ts[i].state) {
+                ecs_table_t *table = flecs_sparse_try_t(
+                    &world->store.tables, ecs_table_t, ts[i].table);
+                if (table) {
+                    flecs_table_get_dirty_state(world, table);
+                }
+            }
+
+            ecs_map_ensure(&index->tables, ts[i].table)[0] = ts[i].state;
+        }
+    }
+}
+
+static
+void flecs_spatial_observer(
+    ecs_iter_t *it)
+{
+    ecs_spatial_index_t *index = it->ctx;
+
+    /* Don't bother keeping the index up to date while the world is deleted */
+    if (it->real_world->flags & EcsWorldFini) {
+        return;
+    }
+
+    int32_t i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_map_val_t *slot = ecs_map_get(&index->slots, it->entities[i]);
+        if (slot) {
+            flecs_spatial_remove_slot(index, (int32_t)*slot);
+        }
+    }
+}
+
+static
+void flecs_spatial_free(
+    void *ctx)
+{
+    ecs_spatial_index_t *index = ctx;
+    ecs_allocator_t *a = &index->world->allocator;
+
+    int32_t i;
+    for (i = 0; i < index->stage_count; i ++) {
+        ecs_vec_fini_t(NULL, &index->stages[i].records, ecs_spatial_record_t);
+        ecs_vec_fini_t(NULL, &index->stages[i].tables,
+            ecs_spatial_table_state_t);
+    }
+    flecs_free_n(a, ecs_spatial_stage_t, index->stage_count, index->stages);
+
+    ecs_vec_fini_t(a, &index->entities, ecs_entity_t);
+    ecs_vec_fini(a, &index->positions, ECS_SIZEOF(double) * 3);
+    ecs_vec_fini_t(a, &index->slot_cells, int32_t);
+    ecs_vec_fini_t(a, &index->cells, ecs_spatial_cell_t);
+    ecs_map_fini(&index->cell_map);
+    ecs_map_fini(&index->slots);
+    ecs_map_fini(&index->tables);
+    flecs_free_t(a, ecs_spatial_index_t, index);
+}
+
+static
+ecs_spatial_index_t* flecs_spatial_index_get(
+    const ecs_world_t *world,
+    ecs_entity_t index)
+{
+    const ecs_observer_t *o = ecs_observer_get(world, index);
+    ecs_check(o != NULL && o->callback == flecs_spatial_observer,
+        ECS_INVALID_PARAMETER, "entity is not a spatial index");
+    return o->ctx;
+error:
+    return NULL;
+}
+
+static
+ecs_entity_t flecs_spatial_system(
+    ecs_world_t *world,
+    ecs_entity_t index,
+    ecs_entity_t phase,
+    const char *name,
+    ecs_iter_action_t callback,
+    ecs_spatial_index_t *ctx,
+    bool multi_threaded)
+{
+    ecs_system_desc_t desc = {
+        .entity = ecs_entity(world, {
+            .name = name,
+            .parent = index,
+            .add = ecs_ids( ecs_dependson(phase) )
+        }),
+        .callback = callback,
+        .ctx = ctx,
+        .multi_threaded = multi_threaded
+    };
+
+    /* Only the system that collects changes iterates the component */
+    if (multi_threaded) {
+        desc.query.terms[0] = (ecs_term_t){
+            .id = ctx->component, .src.id = EcsSelf, .inout = EcsIn
+        };
+    }
+
+    return ecs_system_init(world, &desc);
+}
+
+static
+void flecs_spatial_result_init(
+    ecs_spatial_result_t *result,
+    int32_t count)
+{
+    ecs_vec_init_if_t(&result->entities, ecs_entity_t);
+    ecs_vec_init_if_t(&result->distances, double);
+    ecs_vec_init_if_t(&result->offsets, int32_t);
+    ecs_vec_clear(&result->entities);
+    ecs_vec_clear(&result->distances);
+    ecs_vec_set_count_t(NULL, &result->offsets, int32_t, count + 1);
+    ecs_vec_first_t(&result->offsets, int32_t)[0] = 0;
+    result->query_count = count;
+}
+
+static
+void flecs_spatial_result_append(
+    ecs_spatial_result_t *result,
+    ecs_entity_t entity,
+    double dist_sq)
+{
+    ecs_vec_append_t(NULL, &result->entities, ecs_entity_t)[0] = entity;
+    ecs_vec_append_t(NULL, &result->distances, double)[0] = dist_sq;
+}
+
+static
+void flecs_spatial_cell_radius(
+    const ecs_spatial_index_t *index,
+    const ecs_spatial_cell_t *cell,
+    const double *center,
+    double radius_sq,
+    ecs_spatial_result_t *result)
+{
+    const ecs_entity_t *entities = ecs_vec_first(&index->entities);
+    const double (*positions)[3] = ecs_vec_first(&index->positions);
+    int32_t i, end = cell->start + cell->count;
+    for (i = cell->start; i < end; i ++) {
+        double d = flecs_spatial_dist_sq(positions[i], center);
+        if (d <= radius_sq) {
+            flecs_spatial_result_append(result, entities[i], d);
+        }
+    }
+}
+
+static
+void flecs_spatial_find_radius(
+    const ecs_spatial_index_t *index,
+    const ecs_spatial_query_t *q,
+    ecs_spatial_result_t *result)
+{
+    int32_t lo[3], hi[3], i;
+    double volume = 1;
+    for (i = 0; i < 3; i ++) {
+        lo[i] = flecs_spatial_coord(index, q->center[i] - q->radius);
+        hi[i] = flecs_spatial_coord(index, q->center[i] + q->radius);
+        if (lo[i] < index->min[i]) lo[i] = index->min[i];
+        if (hi[i] > index->max[i]) hi[i] = index->max[i];
+        if (lo[i] > hi[i]) {
+            return;
+        }
+        volume *= hi[i] - lo[i] + 1;
+    }
+
+    double radius_sq = q->radius * q->radius;
+    int32_t cell_count = ecs_vec_count(&index->cells);
+
+    /* If the query box contains more cells than the index, it's cheaper to
+     * test the cells of the index against the box. */
+    if (volume > cell_count) {
+        const ecs_spatial_cell_t *cells = ecs_vec_first(&index->cells);
+        for (i = 0; i < cell_count; i ++) {
+            const ecs_spatial_cell_t *cell = &cells[i];
+            if (cell->coord[0] < lo[0] || cell->coord[0] > hi[0] ||
+                cell->coord[1] < lo[1] || cell->coord[1] > hi[1] ||
+                cell->coord[2] < lo[2] || cell->coord[2] > hi[2])
+            {
+                continue;
+            }
+            flecs_spatial_cell_radius(index, cell, q->center, radius_sq, result);
+        }
+        return;
+    }
+
+    int32_t coord[3];
+    for (coord[0] = lo[0]; coord[0] <= hi[0]; coord[0] ++) {
+        for (coord[1] = lo[1]; coord[1] <= hi[1]; coord[1] ++) {
+            for (coord[2] = lo[2]; coord[2] <= hi[2]; coord[2] ++) {
+                const ecs_spatial_cell_t *cell =
+                    flecs_spatial_cell_get(index, coord);
+                if (cell) {
+                    flecs_spatial_cell_radius(
+                        index, cell, q->center, radius_sq, result);
+                }
+            }
+        }
+    }
+}
+
+/* Max heap ordered by distance, used to find the k nearest entities */
+typedef struct ecs_spatial_heap_t {
+    ecs_entity_t *entities;
+    double *distances;
+    int32_t count;
+    int32_t k;
+} ecs_spatial_heap_t;
+
+static
+void flecs_spatial_heap_sift_down(
+    ecs_spatial_heap_t *h,
+    int32_t i,
+    int32_t count)
+{
+    for (;;) {
+        int32_t l = i * 2 + 1, r = l + 1, largest = i;
+        if (l < count && h->distances[l] > h->distances[largest]) {
+            largest = l;
+        }
+        if (r < count && h->distances[r] > h->distances[largest]) {
+            largest = r;
+        }
+        if (largest == i) {
+            return;
+        }
+
+        ecs_entity_t e = h->entities[i];
+        double d = h->distances[i];
+        h->entities[i] = h->entities[largest];
+        h->distances[i] = h->distances[largest];
+        h->entities[largest] = e;
+        h->distances[largest] = d;
+        i = largest;
+    }
+}
+
+static
+void flecs_spatial_heap_push(
+    ecs_spatial_heap_t *h,
+    ecs_entity_t entity,
+    double dist_sq)
+{
+    if (h->count < h->k) {
+        int32_t i = h->count ++;
+        while (i) {
+            int32_t parent = (i - 1) / 2;
+            if (h->distances[parent] >= dist_sq) {
+                break;
+            }
+            h->entities[i] = h->entities[parent];
+            h->distances[i] = h->distances[parent];
+            i = parent;
+        }
+        h->entities[i] = entity;
+        h->distances[i] = dist_sq;
+    } else if (dist_sq < h->distances[0]) {
+        h->entities[0] = entity;
+        h->distances[0] = dist_sq;
+        flecs_spatial_heap_sift_down(h, 0, h->count);
+    }
+}
+
+/* Sort heap in ascending order of distance */
+static
+void flecs_spatial_heap_sort(
+    ecs_spatial_heap_t *h)
+{
+    int32_t end;
+    for (end = h->count - 1; end > 0; end --) {
+        ecs_entity_t e = h->entities[0];
+        double d = h->distances[0];
+        h->entities[0] = h->entities[end];
+        h->distances[0] = h->distances[end];
+        h->entities[end] = e;
+        h->distances[end] = d;
+        flecs_spatial_heap_sift_down(h, 0, end);
+    }
+}
+
+static
+void flecs_spatial_cell_nearest(
+    const ecs_spatial_index_t *index,
+    const ecs_spatial_cell_t *cell,
+    const double *center,
+    double radius_sq,
+    ecs_spatial_heap_t *heap)
+{
+    const ecs_entity_t *entities = ecs_vec_first(&index->entities);
+    const double (*positions)[3] = ecs_vec_first(&index->positions);
+    int32_t i, end = cell->start + cell->count;
+    for (i = cell->start; i < end; i ++) {
+        double d = flecs_spatial_dist_sq(positions[i], center);
+        if (d <= radius_sq) {
+            flecs_spatial_heap_push(heap, entities[i], d);
+        }
+    }
+}
+
+static
+int32_t flecs_spatial_abs(
+    int32_t value)
+{
+    return value < 0 ? -value : value;
+}
+
+static
+int32_t flecs_spatial_ring(
+    const int32_t *a,
+    const int32_t *b)
+{
+    int32_t x = flecs_spatial_abs(a[0] - b[0]), y = flecs_spatial_abs(a[1] - b[1]), z = flecs_spatial_abs(a[2] - b[2]);
+    int32_t result = x > y ? x : y;
+    return result > z ? result : z;
+}
+
+static
+void flecs_spatial_find_knn(
+    const ecs_spatial_index_t *index,
+    const ecs_spatial_query_t *q,
+    ecs_spatial_result_t *result)
+{
+    int32_t offset = ecs_vec_count(&result->entities);
+    ecs_spatial_heap_t heap = {
+        .entities = ecs_vec_grow_t(NULL, &result->entities, ecs_entity_t, q->k),
+        .distances = ecs_vec_grow_t(NULL, &result->distances, double, q->k),
+        .k = q->k
+    };
+
+    double radius_sq = q->radius > 0 ? q->radius * q->radius : INFINITY;
+    int32_t cell_count = ecs_vec_count(&index->cells);
+    int32_t center[3], r, max_ring = 0, i;
+    for (i = 0; i < 3; i ++) {
+        center[i] = flecs_spatial_coord(index, q->center[i]);
+        int32_t lo = center[i] - index->min[i], hi = index->max[i] - center[i];
+        if (lo > max_ring) max_ring = lo;
+        if (hi > max_ring) max_ring = hi;
+    }
+
+    /* Visit cells in rings of increasing distance to the center cell. Entities
+     * in ring r + 1 are at least r * cell_size away from the center, so stop
+     * when the heap is full and the farthest entity is closer than that. */
+    for (r = 0; r <= max_ring; r ++) {
+        double ring_dist = (r - 1) * index->cell_size;
+        if (r && ring_dist * ring_dist > radius_sq) {
+            break;
+        }
+
+        int64_t side = 2 * r + 1;
+        int64_t ring_cells = r ? side * side * side - (side - 2) *
+            (side - 2) * (side - 2) : 1;
+
+        /* When the ring contains more cells than the index, visit all remaining
+         * cells of the index instead. */
+        if (ring_cells > cell_count) {
+            const ecs_spatial_cell_t *cells = ecs_vec_first(&index->cells);
+            for (i = 0; i < cell_count; i ++) {
+                if (flecs_spatial_ring(cells[i].coord, center) >= r) {
+                    flecs_spatial_cell_nearest(
+                        index, &cells[i], q->center, radius_sq, &heap);
+                }
+            }
+            break;
+        }
+
+        int32_t coord[3], dx, dy, dz;
+        for (dx = -r; dx <= r; dx ++) {
+            coord[0] = center[0] + dx;
+            if (coord[0] < index->min[0] || coord[0] > index->max[0]) {
+                continue;
+            }
+            for (dy = -r; dy <= r; dy ++) {
+                coord[1] = center[1] + dy;
+                if (coord[1] < index->min[1] || coord[1] > index->max[1]) {
+                    continue;
+                }
+
+                /* Only visit the shell of the ring */
+                bool shell = flecs_spatial_abs(dx) == r || flecs_spatial_abs(dy) == r;
+                int32_t step = shell || !r ? 1 : 2 * r;
+                for (dz = -r; dz <= r; dz += step) {
+                    coord[2] = center[2] + dz;
+                    if (coord[2] < index->min[2] || coord[2] > index->max[2]) {
+                        continue;
+                    }
+                    const ecs_spatial_cell_t *cell =
+                        flecs_spatial_cell_get(index, coord);
+                    if (cell) {
+                        flecs_spatial_cell_nearest(
+                            index, cell, q->center, radius_sq, &heap);
+                    }
+                }
+            }
+        }
+
+        if (heap.count == heap.k) {
+            double reach = r * index->cell_size;
+            if (heap.distances[0] <= reach * reach) {
+                break;
+            }
+        }
+    }
+
+    flecs_spatial_heap_sort(&heap);
+    ecs_vec_set_count_t(NULL, &result->entities, ecs_entity_t,
+        offset + heap.count);
+    ecs_vec_set_count_t(NULL, &result->distances, double,
+        offset + heap.count);
+}
+
+static
+int32_t flecs_spatial_find(
+    const ecs_world_t *world,
+    ecs_entity_t index_entity,
+    const ecs_spatial_query_t *queries,
+    int32_t count,
+    ecs_spatial_result_t *result,
+    bool nearest)
+{
+    ecs_check(queries != NULL || !count, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(result != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    const ecs_spatial_index_t *index =
+        flecs_spatial_index_get(world, index_entity);
+    ecs_check(index != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    flecs_spatial_result_init(result, count);
+
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        const ecs_spatial_query_t *q = &queries[i];
+        ecs_check(q->radius >= 0, ECS_INVALID_PARAMETER, NULL);
+        ecs_check(q->k >= 0, ECS_INVALID_PARAMETER, NULL);
+        int32_t start = ecs_vec_count(&result->entities);
+
+        if (index->count) {
+            if (nearest) {
+                if (q->k) {
+                    flecs_spatial_find_knn(index, q, result);
+                }
+            } else {
+                ecs_check(q->radius > 0, ECS_INVALID_PARAMETER,
+                    "radius query must have a radius");
+                flecs_spatial_find_radius(index, q, result);
+            }
+        }
+
+        int32_t end = ecs_vec_count(&result->entities);
+        double *distances = ecs_vec_first(&result->distances);
+        int32_t j;
+        for (j = start; j < end; j ++) {
+            distances[j] = sqrt(distances[j]);
+        }
+
+        ecs_vec_get_t(&result->offsets, int32_t, i + 1)[0] = end;
+    }
+
+    return ecs_vec_count(&result->entities);
+error:
+    return 0;
+}
+
+ecs_entity_t ecs_spatial_index_init(
+    ecs_world_t *world,
+    const ecs_spatial_index_desc_t *desc)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    ecs_check(desc != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(desc->_canary == 0, ECS_INVALID_PARAMETER,
+        "ecs_spatial_index_desc_t was not initialized to zero");
+    ecs_check(!(world->flags & EcsWorldReadonly), ECS_INVALID_OPERATION,
+        "cannot create spatial index while world is readonly");
+    ecs_check(desc->component != 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(desc->cell_size > 0, ECS_INVALID_PARAMETER,
+        "spatial index must have a cell size");
+
+    ecs_entity_t component = desc->component;
+    const ecs_type_info_t *ti = ecs_get_type_info(world, component);
+    ecs_check(ti != NULL, ECS_INVALID_PARAMETER,
+        "spatial index can only be created for components");
+    ecs_check(!ecs_has_id(world, component, EcsSparse), ECS_INVALID_PARAMETER,
+        "spatial index cannot be created for sparse components");
+
+    ecs_size_t pos_size = (desc->f64 ? ECS_SIZEOF(double) :
+        ECS_SIZEOF(float)) * 3;
+    ecs_check(desc->offset >= 0 && desc->offset + pos_size <= ti->size,
+        ECS_INVALID_PARAMETER, "position is out of bounds of component");
+
+    ecs_allocator_t *a = &world->allocator;
+    ecs_spatial_index_t *index = flecs_calloc_t(a, ecs_spatial_index_t);
+    index->world = world;
+    index->component = component;
+    index->offset = desc->offset;
+    index->f64 = desc->f64;
+    index->cell_size = desc->cell_size;
+    index->inv_cell_size = 1.0 / desc->cell_size;
+    index->rebuild = true;
+    ecs_vec_init_t(a, &index->entities, ecs_entity_t, 0);
+    ecs_vec_init(a, &index->positions, ECS_SIZEOF(double) * 3, 0);
+    ecs_vec_init_t(a, &index->slot_cells, int32_t, 0);
+    ecs_vec_init_t(a, &index->cells, ecs_spatial_cell_t, 0);
+    ecs_map_init(&index->cell_map, a);
+    ecs_map_init(&index->slots, a);
+    ecs_map_init(&index->tables, a);
+
+    ecs_entity_t result = ecs_observer_init(world, &(ecs_observer_desc_t){
+        .entity = desc->entity,
+        .query.terms = {{
+            .id = component, .src.id = EcsSelf, .inout = EcsIn
+        }},
+        .events = { EcsOnRemove },
+        .callback = flecs_spatial_observer,
+        .ctx = index,
+        .ctx_free = flecs_spatial_free
+    });
+
+    if (!result) {
+        flecs_spatial_free(index);
+        return 0;
+    }
+
+    ecs_entity_t phase = desc->phase ? desc->phase : EcsPostUpdate;
+    ecs_entity_t prepare = flecs_spatial_system(world, result, phase,
+        "Prepare", flecs_spatial_prepare, index, false);
+    ecs_entity_t collect = flecs_spatial_system(world, result, phase,
+        "Collect", flecs_spatial_collect, index, true);
+    ecs_entity_t commit = flecs_spatial_system(world, result, phase,
+        "Commit", flecs_spatial_commit, index, false);
+    if (!prepare || !collect || !commit) {
+        ecs_delete(world, result);
+        return 0;
+    }
+
+    /* Populate index with existing entities */
+    ecs_run(world, prepare, 0, NULL);
+    ecs_run(world, collect, 0, NULL);
+    ecs_run(world, commit, 0, NULL);
+
+    return result;
+error:
+    return 0;
+}
+
+void ecs_spatial_index_rebuild(
+    ecs_world_t *world,
+    ecs_entity_t index)
+{
+    ecs_spatial_index_t *impl = flecs_spatial_index_get(world, index);
+    ecs_check(impl != NULL, ECS_INVALID_PARAMETER, NULL);
+    impl->rebuild = true;
+error:
+    return;
+}
+
+int32_t ecs_spatial_count(
+    const ecs_world_t *world,
+    ecs_entity_t index)
+{
+    const ecs_spatial_index_t *impl = flecs_spatial_index_get(world, index);
+    ecs_check(impl != NULL, ECS_INVALID_PARAMETER, NULL);
+    return impl->count;
+error:
+    return 0;
+}
+
+int32_t ecs_spatial_find_in_radius(
+    const ecs_world_t *world,
+    ecs_entity_t index,
+    const ecs_spatial_query_t *queries,
+    int32_t count,
+    ecs_spatial_result_t *result)
+{
+    return flecs_spatial_find(world, index, queries, count, result, false);
+}
+
+int32_t ecs_spatial_find_nearest(
+    const ecs_world_t *world,
+    ecs_entity_t index,
+    const ecs_spatial_query_t *queries,
+    int32_t count,
+    ecs_spatial_result_t *result)
+{
+    return flecs_spatial_find(world, index, queries, count, result, true);
+}
+
+ecs_spatial_span_t ecs_spatial_result_get(
+    const ecs_spatial_result_t *result,
+    int32_t query)
+{
+    ecs_check(result != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(query >= 0 && query < result->query_count,
+        ECS_INVALID_PARAMETER, NULL);
+
+    const int32_t *offsets = ecs_vec_first(&result->offsets);
+    int32_t start = offsets[query], count = offsets[query + 1] - start;
+    if (!count) {
+        return (ecs_spatial_span_t){0};
+    }
+
+    return (ecs_spatial_span_t){
+        .entities = ecs_vec_get_t(&result->entities, ecs_entity_t, start),
+        .distances = ecs_vec_get_t(&result->distances, double, start),
+        .count = count
+    };
+error:
+    return (ecs_spatial_span_t){0};
+}
+
+void ecs_spatial_result_fini(
+    ecs_spatial_result_t *result)
+{
+    ecs_check(result != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_vec_fini_t(NULL, &result->entities, ecs_entity_t);
+    ecs_vec_fini_t(NULL, &result->distances, double);
+    ecs_vec_fini_t(NULL, &result->offsets, int32_t);
+    result->query_count = 0;
+error:
+    return;
+}
+
+#endif
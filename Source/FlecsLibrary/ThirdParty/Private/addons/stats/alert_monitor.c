@@ -0,0 +1,121 @@
+/**
+ * @file addons/stats/alert_monitor.c
+ * @brief Stats addon alert monitor
+ */
+
+#include "flecs.h"
+#include "stats.h"
+
+#if defined(FLECS_STATS) && defined(FLECS_ALERTS)
+
+ECS_COMPONENT_DECLARE(EcsAlertStats);
+
+static inline
+void flecs_alert_monitor_dtor(EcsAlertStats *ptr) {
+    ecs_map_iter_t it = ecs_map_iter(&ptr->stats);
+    while (ecs_map_next(&it)) {
+        ecs_alert_stats_t *stats = ecs_map_ptr(&it);
+        ecs_os_free(stats);
+    }
+    ecs_map_fini(&ptr->stats);
+}
+
+static ECS_CTOR(EcsAlertStats, ptr, {
+    ecs_os_zeromem(ptr);
+    ecs_map_init(&ptr->stats, NULL);
+})
+
+static ECS_COPY(EcsAlertStats, dst, src, {
+    (void)dst;
+    (void)src;
+    ecs_abort(ECS_INVALID_OPERATION, "cannot copy alert stats component");
+})
+
+static ECS_MOVE(EcsAlertStats, dst, src, {
+    flecs_alert_monitor_dtor(dst);
+    ecs_os_memcpy_t(dst, src, EcsAlertStats);
+    ecs_os_zeromem(src);
+})
+
+static ECS_DTOR(EcsAlertStats, ptr, {
+    flecs_alert_monitor_dtor(ptr);
+})
+
+static 
+void flecs_alert_stats_set_t(
+    void *stats, int32_t t)
+{
+    ecs_assert(t >= 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(t < ECS_STAT_WINDOW, ECS_INTERNAL_ERROR, NULL);
+    ((ecs_alert_stats_t*)stats)->query.t = t;
+}
+
+static
+void flecs_alert_stats_copy_last(
+    void *stats, 
+    void *src) 
+{
+    ecs_alert_stats_copy_last(stats, src);
+}
+
+static
+void flecs_alert_stats_get(
+    ecs_world_t *world, 
+    ecs_entity_t res, 
+    void *stats) 
+{
+    ecs_alert_stats_get(world, res, stats);
+}
+
+static
+void flecs_alert_stats_reduce(
+    void *stats, 
+    void *src) 
+{
+    ecs_alert_stats_reduce(stats, src);
+}
+
+static
+void flecs_alert_stats_reduce_last(
+    void *stats, 
+    void *last, 
+    int32_t reduce_count) 
+{
+    ecs_alert_stats_reduce_last(stats, last, reduce_count);
+}
+
+static
+void flecs_alert_stats_repeat_last(
+    void* stats) 
+{
+    ecs_alert_stats_repeat_last(stats);
+}
+
+void FlecsAlertMonitorImport(
+    ecs_world_t *world)
+{
+    ECS_COMPONENT_DEFINE(world, EcsAlertStats);
+
+    ecs_set_hooks(world, EcsAlertStats, {
+        .ctor = ecs_ctor(EcsAlertStats),
+        .copy = ecs_copy(EcsAlertStats),
+        .move = ecs_move(EcsAlertStats),
+        .dtor = ecs_dtor(EcsAlertStats)
+    });
+
+    ecs_stats_api_t api = {
+        .copy_last = flecs_alert_stats_copy_last,
+        .get = flecs_alert_stats_get,
+        .reduce = flecs_alert_stats_reduce,
+        .reduce_last = flecs_alert_stats_reduce_last,
+        .repeat_last = flecs_alert_stats_repeat_last,
+        .set_t = flecs_alert_stats_set_t,
+        .stats_size = ECS_SIZEOF(ecs_alert_stats_t),
+        .monitor_component_id = ecs_id(EcsAlertStats),
+        .query_component_id = ecs_id(EcsAlert)
+    };
+
+    flecs_stats_api_import(world, &api);
+}
+
+#endif
@@ -403,6 +403,11 @@ void FlecsStatsImport(
     FlecsWorldMonitorImport(world);
     FlecsSystemMonitorImport(world);
     FlecsPipelineMonitorImport(world);
+#ifdef FLECS_ALERTS
+    if (ecs_lookup(world, "flecs.alerts")) {
+        FlecsAlertMonitorImport(world);
+    }
+#endif
     
     if (ecs_os_has_time()) {
         ecs_measure_frame_time(world, true);
@@ -491,6 +491,80 @@ void ecs_system_stats_copy_last(
 
 #endif
 
+#ifdef FLECS_ALERTS
+
+bool ecs_alert_stats_get(
+    const ecs_world_t *world,
+    ecs_entity_t alert,
+    ecs_alert_stats_t *s)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(s != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(alert != 0, ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    ecs_alert_eval_stats_t eval;
+    if (!flecs_alert_eval_stats_get(world, alert, &eval) || !eval.query) {
+        return false;
+    }
+
+    ecs_query_stats_get(world, eval.query, &s->query);
+    int32_t t = s->query.t;
+
+    ECS_COUNTER_RECORD(&s->time_spent, t, eval.time_spent);
+    ECS_COUNTER_RECORD(&s->tables_evaluated, t, eval.tables_evaluated);
+    ECS_COUNTER_RECORD(&s->tables_skipped, t, eval.tables_skipped);
+    ECS_GAUGE_RECORD(&s->instance_count, t, eval.instance_count);
+
+    s->incremental = eval.incremental;
+
+    return true;
+error:
+    return false;
+}
+
+void ecs_alert_stats_reduce(
+    ecs_alert_stats_t *dst,
+    const ecs_alert_stats_t *src)
+{
+    ecs_query_cache_stats_reduce(&dst->query, &src->query);
+    dst->incremental = src->incremental;
+    flecs_stats_reduce(ECS_METRIC_FIRST(dst), ECS_METRIC_LAST(dst), 
+        ECS_METRIC_FIRST(src), dst->query.t, src->query.t);
+}
+
+void ecs_alert_stats_reduce_last(
+    ecs_alert_stats_t *dst,
+    const ecs_alert_stats_t *src,
+    int32_t count)
+{
+    ecs_query_cache_stats_reduce_last(&dst->query, &src->query, count);
+    dst->incremental = src->incremental;
+    flecs_stats_reduce_last(ECS_METRIC_FIRST(dst), ECS_METRIC_LAST(dst), 
+        ECS_METRIC_FIRST(src), dst->query.t, src->query.t, count);
+}
+
+void ecs_alert_stats_repeat_last(
+    ecs_alert_stats_t *stats)
+{
+    ecs_query_cache_stats_repeat_last(&stats->query);
+    flecs_stats_repeat_last(ECS_METRIC_FIRST(stats), ECS_METRIC_LAST(stats),
+        (stats->query.t));
+}
+
+void ecs_alert_stats_copy_last(
+    ecs_alert_stats_t *dst,
+    const ecs_alert_stats_t *src)
+{
+    ecs_query_cache_stats_copy_last(&dst->query, &src->query);
+    dst->incremental = src->incremental;
+    flecs_stats_copy_last(ECS_METRIC_FIRST(dst), ECS_METRIC_LAST(dst),
+        ECS_METRIC_FIRST(src), dst->query.t, t_next(src->query.t));
+}
+
+#endif
+
 #ifdef FLECS_PIPELINE
 
 bool ecs_pipeline_stats_get(
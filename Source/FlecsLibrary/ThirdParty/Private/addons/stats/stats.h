@@ -44,4 +44,26 @@ void FlecsSystemMonitorImport(
 void FlecsPipelineMonitorImport(
     ecs_world_t *world);
 
+#ifdef FLECS_ALERTS
+
+/* Evaluation statistics of an alert (implemented by alerts addon) */
+typedef struct {
+    const ecs_query_t *query;
+    ecs_ftime_t time_spent;
+    int64_t tables_evaluated;
+    int64_t tables_skipped;
+    int32_t instance_count;
+    bool incremental;
+} ecs_alert_eval_stats_t;
+
+bool flecs_alert_eval_stats_get(
+    const ecs_world_t *world,
+    ecs_entity_t alert,
+    ecs_alert_eval_stats_t *out);
+
+void FlecsAlertMonitorImport(
+    ecs_world_t *world);
+
+#endif
+
 #endif
@@ -9,6 +9,210 @@
 
 #ifdef FLECS_TIMER
 
+ECS_TAG_DECLARE(EcsTimerWheel);
+
+/* Timing wheel. Time is divided in slots of FLECS_TIMER_WHEEL_RESOLUTION
+ * seconds. Level 0 stores timers that expire within the next
+ * FLECS_TIMER_WHEEL_SLOTS slots, each next level covers a range that is 
+ * FLECS_TIMER_WHEEL_SLOTS times larger. When the wheel advances past the end
+ * of a range, the timers in the next slot of the level above are moved down. */
+#define FLECS_TIMER_WHEEL_RESOLUTION (1.0 / 64.0)
+#define FLECS_TIMER_WHEEL_BITS (6)
+#define FLECS_TIMER_WHEEL_SLOTS (1 << FLECS_TIMER_WHEEL_BITS)
+#define FLECS_TIMER_WHEEL_LEVELS (4)
+
+typedef struct ecs_timer_wheel_entry_t {
+    ecs_entity_t timer;
+    uint64_t serial;          /* Entry is stale if timer has a different serial */
+    double start;             /* Time at which timer period started */
+    double deadline;
+} ecs_timer_wheel_entry_t;
+
+typedef struct ecs_timer_wheel_t {
+    ecs_world_t *world;
+    ecs_entity_t system;      /* Disabled until the first timer is scheduled */
+    ecs_vec_t slots[FLECS_TIMER_WHEEL_LEVELS][FLECS_TIMER_WHEEL_SLOTS];
+    ecs_vec_t due;            /* Entries in processed slots that didn't expire */
+    ecs_vec_t expired;        /* Entries that expire this frame */
+    ecs_vec_t ticked;         /* Timers that ticked in the previous frame */
+    ecs_map_t serials;        /* timer -> serial of scheduled entry */
+    uint64_t last_serial;
+    int64_t slot;             /* Last processed slot */
+    double time;
+} ecs_timer_wheel_t;
+
+static
+int64_t flecs_timer_wheel_slot(
+    double time)
+{
+    return (int64_t)(time / FLECS_TIMER_WHEEL_RESOLUTION);
+}
+
+static
+void flecs_timer_wheel_insert(
+    ecs_timer_wheel_t *wheel,
+    const ecs_timer_wheel_entry_t *entry)
+{
+    ecs_allocator_t *a = &wheel->world->allocator;
+    int64_t slot = flecs_timer_wheel_slot(entry->deadline);
+    int64_t delta = slot - wheel->slot;
+    ecs_vec_t *vec;
+
+    if (delta <= 0) {
+        vec = &wheel->due;
+    } else {
+        int32_t level = 0;
+        while ((level < (FLECS_TIMER_WHEEL_LEVELS - 1)) && 
+            (delta >> ((level + 1) * FLECS_TIMER_WHEEL_BITS)))
+        {
+            level ++;
+        }
+
+        /* Timers beyond the range of the top level are reinserted each time
+         * their slot is cascaded, until they're in range. */
+        int32_t index = (int32_t)((slot >> (level * FLECS_TIMER_WHEEL_BITS)) &
+            (FLECS_TIMER_WHEEL_SLOTS - 1));
+        vec = &wheel->slots[level][index];
+    }
+
+    ecs_vec_append_t(a, vec, ecs_timer_wheel_entry_t)[0] = *entry;
+}
+
+static
+void flecs_timer_wheel_schedule(
+    ecs_timer_wheel_t *wheel,
+    ecs_entity_t timer,
+    const EcsTimer *value)
+{
+    if (!value->active) {
+        ecs_map_remove(&wheel->serials, timer);
+        return;
+    }
+
+    /* Entries that were scheduled before for this timer become stale */
+    uint64_t serial = ++ wheel->last_serial;
+    ecs_map_ensure(&wheel->serials, timer)[0] = serial;
+
+    ecs_timer_wheel_entry_t entry = {
+        .timer = timer,
+        .serial = serial,
+        .start = wheel->time - (double)value->time
+    };
+    entry.deadline = entry.start + (double)value->timeout;
+
+    flecs_timer_wheel_insert(wheel, &entry);
+}
+
+/* Move entries of slot to lower levels or to the due list */
+static
+void flecs_timer_wheel_cascade(
+    ecs_timer_wheel_t *wheel,
+    ecs_vec_t *slot)
+{
+    if (!ecs_vec_count(slot)) {
+        return;
+    }
+
+    /* Entries can be reinserted in the same slot */
+    ecs_vec_t entries = *slot;
+    ecs_vec_init_t(&wheel->world->allocator, slot, 
+        ecs_timer_wheel_entry_t, 0);
+
+    int32_t i, count = ecs_vec_count(&entries);
+    ecs_timer_wheel_entry_t *array = ecs_vec_first(&entries);
+    for (i = 0; i < count; i ++) {
+        flecs_timer_wheel_insert(wheel, &array[i]);
+    }
+
+    ecs_vec_fini_t(&wheel->world->allocator, &entries, 
+        ecs_timer_wheel_entry_t);
+}
+
+static
+void flecs_timer_wheel_advance(
+    ecs_timer_wheel_t *wheel)
+{
+    int64_t target = flecs_timer_wheel_slot(wheel->time);
+    while (wheel->slot < target) {
+        int64_t slot = ++ wheel->slot;
+        int32_t level;
+
+        for (level = FLECS_TIMER_WHEEL_LEVELS - 1; level > 0; level --) {
+            int32_t shift = level * FLECS_TIMER_WHEEL_BITS;
+            if (slot & ((INT64_C(1) << shift) - 1)) {
+                continue;
+            }
+
+            flecs_timer_wheel_cascade(wheel, &wheel->slots[level][
+                (slot >> shift) & (FLECS_TIMER_WHEEL_SLOTS - 1)]);
+        }
+
+        flecs_timer_wheel_cascade(wheel, &wheel->slots[0][
+            slot & (FLECS_TIMER_WHEEL_SLOTS - 1)]);
+    }
+
+    /* Collect expired timers from the due list */
+    ecs_allocator_t *a = &wheel->world->allocator;
+    ecs_timer_wheel_entry_t *due = ecs_vec_first(&wheel->due);
+    int32_t i, count = ecs_vec_count(&wheel->due), keep = 0;
+    for (i = 0; i < count; i ++) {
+        ecs_timer_wheel_entry_t *entry = &due[i];
+        uint64_t *serial = ecs_map_get(&wheel->serials, entry->timer);
+        if (!serial || serial[0] != entry->serial) {
+            continue; /* Timer was stopped, modified or deleted */
+        }
+
+        if (entry->deadline <= wheel->time) {
+            ecs_vec_append_t(a, &wheel->expired, 
+                ecs_timer_wheel_entry_t)[0] = *entry;
+        } else {
+            due[keep ++] = *entry;
+        }
+    }
+
+    ecs_vec_set_count_t(a, &wheel->due, ecs_timer_wheel_entry_t, keep);
+}
+
+static
+void flecs_timer_wheel_init(
+    ecs_timer_wheel_t *wheel)
+{
+    ecs_allocator_t *a = &wheel->world->allocator;
+    int32_t level, i;
+    for (level = 0; level < FLECS_TIMER_WHEEL_LEVELS; level ++) {
+        for (i = 0; i < FLECS_TIMER_WHEEL_SLOTS; i ++) {
+            ecs_vec_init_t(a, &wheel->slots[level][i], 
+                ecs_timer_wheel_entry_t, 0);
+        }
+    }
+
+    ecs_vec_init_t(a, &wheel->due, ecs_timer_wheel_entry_t, 0);
+    ecs_vec_init_t(a, &wheel->expired, ecs_timer_wheel_entry_t, 0);
+    ecs_vec_init_t(a, &wheel->ticked, ecs_entity_t, 0);
+    ecs_map_init(&wheel->serials, a);
+}
+
+static
+void flecs_timer_wheel_free(
+    void *ptr)
+{
+    ecs_timer_wheel_t *wheel = ptr;
+    ecs_allocator_t *a = &wheel->world->allocator;
+    int32_t level, i;
+    for (level = 0; level < FLECS_TIMER_WHEEL_LEVELS; level ++) {
+        for (i = 0; i < FLECS_TIMER_WHEEL_SLOTS; i ++) {
+            ecs_vec_fini_t(a, &wheel->slots[level][i], 
+                ecs_timer_wheel_entry_t);
+        }
+    }
+
+    ecs_vec_fini_t(a, &wheel->due, ecs_timer_wheel_entry_t);
+    ecs_vec_fini_t(a, &wheel->expired, ecs_timer_wheel_entry_t);
+    ecs_vec_fini_t(a, &wheel->ticked, ecs_entity_t);
+    ecs_map_fini(&wheel->serials);
+    ecs_os_free(wheel);
+}
+
 static inline
 void AddTickSource(ecs_iter_t *it) {
     for (int32_t i = 0; i < it->count; i ++) {
@@ -54,11 +258,122 @@ void ProgressTimers(ecs_iter_t *it) {
     }
 }
 
+static inline
+void ProgressTimerWheel(ecs_iter_t *it) {
+    ecs_world_t *world = it->world;
+    ecs_timer_wheel_t *wheel = it->ctx;
+    ecs_allocator_t *a = &wheel->world->allocator;
+
+    /* Only timers that ticked last frame need to be reset */
+    int32_t i, count = ecs_vec_count(&wheel->ticked);
+    ecs_entity_t *ticked = ecs_vec_first(&wheel->ticked);
+    for (i = 0; i < count; i ++) {
+        if (!ecs_is_alive(world, ticked[i])) {
+            continue;
+        }
+
+        EcsTickSource *tick_source = ecs_get_mut(
+            world, ticked[i], EcsTickSource);
+        if (tick_source) {
+            tick_source->tick = false;
+        }
+    }
+
+    ecs_vec_clear(&wheel->ticked);
+
+    wheel->time += (double)ecs_get_world_info(world)->delta_time_raw;
+    flecs_timer_wheel_advance(wheel);
+
+    count = ecs_vec_count(&wheel->expired);
+    ecs_timer_wheel_entry_t *expired = ecs_vec_first(&wheel->expired);
+    for (i = 0; i < count; i ++) {
+        ecs_timer_wheel_entry_t *entry = &expired[i];
+        ecs_entity_t e = entry->timer;
+        EcsTimer *timer = ecs_get_mut(world, e, EcsTimer);
+        EcsTickSource *tick_source = ecs_get_mut(world, e, EcsTickSource);
+        if (!timer || !timer->active) {
+            ecs_map_remove(&wheel->serials, e);
+            continue;
+        }
+
+        if (!tick_source) {
+            /* Tick source is added in this frame, try again next frame */
+            flecs_timer_wheel_insert(wheel, entry);
+            continue;
+        }
+
+        /* Same as ProgressTimers, with the elapsed time computed from the
+         * time at which the timer period started. */
+        ecs_ftime_t time_elapsed = (ecs_ftime_t)(wheel->time - entry->start);
+        ecs_ftime_t timeout = timer->timeout;
+        ecs_ftime_t t = time_elapsed - timeout;
+        if (t > timeout) {
+            t = 0;
+        }
+
+        timer->time = t;
+        tick_source->tick = true;
+        tick_source->time_elapsed = time_elapsed - timer->overshoot;
+        timer->overshoot = t;
+        ecs_vec_append_t(a, &wheel->ticked, ecs_entity_t)[0] = e;
+
+        if (timer->single_shot) {
+            timer->active = false;
+            ecs_map_remove(&wheel->serials, e);
+        } else {
+            entry->start = wheel->time - (double)t;
+            entry->deadline = entry->start + (double)timeout;
+            flecs_timer_wheel_insert(wheel, entry);
+        }
+    }
+
+    ecs_vec_clear(&wheel->expired);
+}
+
+static
+void flecs_timer_wheel_on_set(
+    ecs_iter_t *it)
+{
+    ecs_timer_wheel_t *wheel = it->ctx;
+    EcsTimer *timer = ecs_field(it, EcsTimer, 0);
+
+    if (wheel->system) {
+        ecs_enable(it->world, wheel->system, true);
+        wheel->system = 0;
+    }
+
+    for (int32_t i = 0; i < it->count; i ++) {
+        flecs_timer_wheel_schedule(wheel, it->entities[i], &timer[i]);
+    }
+}
+
+static
+void flecs_timer_wheel_on_remove(
+    ecs_iter_t *it)
+{
+    if (ecs_is_fini(it->world)) {
+        return; /* Wheel may already be freed */
+    }
+
+    ecs_timer_wheel_t *wheel = it->ctx;
+    for (int32_t i = 0; i < it->count; i ++) {
+        ecs_map_remove(&wheel->serials, it->entities[i]);
+    }
+}
+
+/* Rate filters often share a tick source. Tick sources are looked up once per
+ * table, the pointers stay valid while the (deferred) system runs. */
+#define FLECS_RATE_FILTER_SRC_CACHE (8)
+
 static inline
 void ProgressRateFilters(ecs_iter_t *it) {
     EcsRateFilter *filter = ecs_field(it, EcsRateFilter, 0);
     EcsTickSource *tick_dst = ecs_field(it, EcsTickSource, 1);
 
+    ecs_entity_t cache_src[FLECS_RATE_FILTER_SRC_CACHE] = {0};
+    const EcsTickSource *cache_ptr[FLECS_RATE_FILTER_SRC_CACHE];
+    int32_t cache_count = 0, cache_next = 0;
+
     for (int i = 0; i < it->count; i ++) {
         const ecs_entity_t src = filter[i].src;
         bool inc = false;
@@ -66,8 +381,26 @@ void ProgressRateFilters(ecs_iter_t *it) {
         filter[i].time_elapsed += it->delta_time;
 
         if (src) {
-            const EcsTickSource *tick_src = ecs_get(
-                it->world, src, EcsTickSource);
+            const EcsTickSource *tick_src = NULL;
+            int32_t c;
+            for (c = 0; c < cache_count; c ++) {
+                if (cache_src[c] == src) {
+                    break;
+                }
+            }
+
+            if (c != cache_count) {
+                tick_src = cache_ptr[c];
+            } else {
+                tick_src = ecs_get(it->world, src, EcsTickSource);
+                cache_src[cache_next] = src;
+                cache_ptr[cache_next] = tick_src;
+                cache_next = (cache_next + 1) % FLECS_RATE_FILTER_SRC_CACHE;
+                if (cache_count < FLECS_RATE_FILTER_SRC_CACHE) {
+                    cache_count ++;
+                }
+            }
+
             if (tick_src) {
                 inc = tick_src->tick;
             } else {
@@ -195,6 +528,9 @@ void ecs_start_timer(
     ecs_check(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
     ptr->active = true;
     ptr->time = 0;
+    if (ecs_has_id(world, timer, EcsTimerWheel)) {
+        ecs_modified(world, timer, EcsTimer); /* Reschedule timer */
+    }
 error:
     return;
 }
@@ -206,6 +542,9 @@ void ecs_stop_timer(
     EcsTimer *ptr = ecs_ensure(world, timer, EcsTimer);
     ecs_check(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
     ptr->active = false;
+    if (ecs_has_id(world, timer, EcsTimerWheel)) {
+        ecs_modified(world, timer, EcsTimer); /* Reschedule timer */
+    }
 error:
     return;
 }
@@ -217,6 +556,9 @@ void ecs_reset_timer(
     EcsTimer *ptr = ecs_ensure(world, timer, EcsTimer);
     ecs_check(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
     ptr->time = 0;
+    if (ecs_has_id(world, timer, EcsTimerWheel)) {
+        ecs_modified(world, timer, EcsTimer); /* Reschedule timer */
+    }
 error:
     return;   
 }
@@ -307,6 +649,12 @@ void FlecsTimerImport(
         .ctor = flecs_default_ctor
     });
 
+    ECS_TAG_DEFINE(world, EcsTimerWheel);
+
+    ecs_timer_wheel_t *wheel = ecs_os_calloc_t(ecs_timer_wheel_t);
+    wheel->world = world;
+    flecs_timer_wheel_init(wheel);
+
     /* Add EcsTickSource to timers and rate filters */
     ecs_system(world, {
         .entity = ecs_entity(world, {.name = "AddTickSource", .add = ecs_ids( ecs_dependson(EcsPreFrame) )}),
@@ -323,11 +671,42 @@ void FlecsTimerImport(
         .entity = ecs_entity(world, {.name = "ProgressTimers", .add = ecs_ids( ecs_dependson(EcsPreFrame))}),
         .query.terms = {
             { .id = ecs_id(EcsTimer) },
-            { .id = ecs_id(EcsTickSource) }
+            { .id = ecs_id(EcsTickSource) },
+            { .id = EcsTimerWheel, .oper = EcsNot }
         },
         .callback = ProgressTimers
     });
 
+    /* Timers on the timing wheel */
+    wheel->system = ecs_system(world, {
+        .entity = ecs_entity(world, {.name = "ProgressTimerWheel", .add = ecs_ids( ecs_dependson(EcsPreFrame), EcsDisabled)}),
+        .callback = ProgressTimerWheel,
+        .ctx = wheel,
+        .ctx_free = flecs_timer_wheel_free
+    });
+
+    ecs_observer(world, {
+        .entity = ecs_entity(world, {.name = "ScheduleTimerWheel"}),
+        .query.terms = {
+            { .id = ecs_id(EcsTimer), .inout = EcsIn },
+            { .id = EcsTimerWheel }
+        },
+        .events = { EcsOnSet, EcsOnAdd },
+        .callback = flecs_timer_wheel_on_set,
+        .ctx = wheel
+    });
+
+    ecs_observer(world, {
+        .entity = ecs_entity(world, {.name = "UnscheduleTimerWheel"}),
+        .query.terms = {
+            { .id = ecs_id(EcsTimer), .inout = EcsInOutNone },
+            { .id = EcsTimerWheel }
+        },
+        .events = { EcsOnRemove },
+        .callback = flecs_timer_wheel_on_remove,
+        .ctx = wheel
+    });
+
     /* Rate filter handling */
     ecs_system(world, {
         .entity = ecs_entity(world, {.name = "ProgressRateFilters", .add = ecs_ids( ecs_dependson(EcsPreFrame))}),
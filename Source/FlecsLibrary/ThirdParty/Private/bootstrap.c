@@ -97,6 +97,11 @@ void ecs_on_set(EcsIdentifier)(ecs_iter_t *it) {
             cur->index = NULL;
         }
 
+        if (kind == EcsName) {
+            /* Cached paths that resolve through the entity may have changed */
+            flecs_path_cache_remove(world, it->entities[i]);
+        }
+
         if (index) {
             const uint64_t index_hash = cur->index_hash;
             const ecs_entity_t e = it->entities[i];
@@ -203,10 +208,17 @@ bool flecs_set_id_flag(
     ecs_id_record_t *idr, 
     ecs_flags32_t flag)
 {
+    if (flag == EcsIdDontFragment && ECS_IS_PAIR(idr->id)) {
+        /* DontFragment only applies to components, not to pairs */
+        return false;
+    }
+
     if (!(idr->flags & flag)) {
         idr->flags |= flag;
         if (flag == EcsIdIsSparse) {
             flecs_id_record_init_sparse(world, idr);
+        } else if (flag == EcsIdDontFragment) {
+            flecs_id_record_init_dont_fragment(world, idr);
         }
         return true;
     }
@@ -724,6 +736,7 @@ void flecs_bootstrap(
     ecs_make_alive(world, EcsTarget);
     ecs_make_alive(world, EcsSparse);
     ecs_make_alive(world, EcsUnion);
+    ecs_make_alive(world, EcsDontFragment);
 
     /* Register type information for builtin components */
     flecs_type_info_init(world, EcsComponent, { 
@@ -848,6 +861,7 @@ void flecs_bootstrap(
     flecs_bootstrap_trait(world, EcsOnInstantiate);
     flecs_bootstrap_trait(world, EcsSparse);
     flecs_bootstrap_trait(world, EcsUnion);
+    flecs_bootstrap_trait(world, EcsDontFragment);
 
     flecs_bootstrap_tag(world, EcsRemove);
     flecs_bootstrap_tag(world, EcsDelete);
@@ -981,6 +995,15 @@ void flecs_bootstrap(
         .ctx = &sparse_trait
     });
 
+    static ecs_on_trait_ctx_t dont_fragment_trait = { EcsIdDontFragment, 0 };
+    ecs_observer(world, {
+        .query.terms = {{ .id = EcsDontFragment }},
+        .query.flags = EcsQueryMatchPrefab|EcsQueryMatchDisabled,
+        .events = {EcsOnAdd},
+        .callback = flecs_register_trait,
+        .ctx = &dont_fragment_trait
+    });
+
     static ecs_on_trait_ctx_t union_trait = { EcsIdIsUnion, 0 };
     ecs_observer(world, {
         .query.terms = {{ .id = EcsUnion }},
@@ -1080,6 +1103,7 @@ void flecs_bootstrap(
     ecs_add_pair(world, ecs_id(EcsComponent), EcsOnInstantiate, EcsDontInherit);
     ecs_add_pair(world, EcsOnDelete, EcsOnInstantiate, EcsDontInherit);
     ecs_add_pair(world, EcsUnion, EcsOnInstantiate, EcsDontInherit);
+    ecs_add_pair(world, EcsDontFragment, EcsOnInstantiate, EcsDontInherit);
 
     /* Acyclic/Traversable components */
     ecs_add_id(world, EcsIsA, EcsTraversable);
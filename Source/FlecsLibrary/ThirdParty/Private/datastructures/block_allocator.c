@@ -67,7 +67,8 @@ void flecs_ballocator_init(
     ba->data_size = size;
 #ifdef FLECS_SANITIZE
     ba->alloc_count = 0;
-    if (size != 24) { /* Prevent stack overflow as map uses block allocator */
+    /* Prevent stack overflow as map uses block allocator */
+    if (size != ECS_SIZEOF(ecs_bucket_entry_t)) {
         ba->outstanding = ecs_os_malloc_t(ecs_map_t);
         ecs_map_init(ba->outstanding, NULL);
     }
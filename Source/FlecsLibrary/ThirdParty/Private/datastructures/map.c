@@ -7,6 +7,9 @@
 
 #include "../private_api.h"
 
+/* Replaced by map_open_addressing.c */
+#ifndef FLECS_MAP_OPEN_ADDRESSING
+
 /* The ratio used to determine whether the map should flecs_map_rehash. If
  * (element_count * ECS_LOAD_FACTOR) > bucket_count, bucket count is increased. */
 #define ECS_LOAD_FACTOR (12)
@@ -466,3 +469,5 @@ void ecs_map_copy(
         ecs_map_insert(dst, ecs_map_key(&it), ecs_map_value(&it));
     }
 }
+
+#endif
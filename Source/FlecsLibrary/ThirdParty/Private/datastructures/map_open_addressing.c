@@ -0,0 +1,846 @@
+/**
+ * @file datastructures/map_open_addressing.c
+ * @brief Open addressing map data structure.
+ *
+ * Drop-in replacement for the chained map in map.c, enabled with the
+ * FLECS_MAP_OPEN_ADDRESSING define. Elements are stored in entries allocated
+ * from the entry allocator, and a power of two sized slot array points to the
+ * entries. Each slot has a control byte that is either empty, deleted, or
+ * contains 7 bits of the key hash. Probing loads a group of 16 control bytes at
+ * once and compares them against the hash of the key with SSE2 or NEON, so
+ * that only entries with a matching hash are visited.
+ *
+ * Growing the map or dropping deleted slots only moves the slots, which keeps
+ * pointers returned by ecs_map_get and ecs_map_ensure valid until the element
+ * is removed, like with the chained map.
+ */
+
+#include "../private_api.h"
+
+#ifdef FLECS_MAP_OPEN_ADDRESSING
+
+#if !defined(FLECS_MAP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || \
+    defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define FLECS_MAP_SSE2
+#include <emmintrin.h>
+#elif !defined(FLECS_MAP_NO_SIMD) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define FLECS_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/* The ratio used to determine whether the map should be rehashed. Uses the
+ * same growth policy as the chained map, which keeps the load factor under
+ * ~0.83 for all but the smallest maps. */
+#define ECS_LOAD_FACTOR (12)
+
+/* Number of control bytes that are compared at once */
+#define FLECS_MAP_GROUP_WIDTH (16)
+
+/* Control byte values. Full slots store the 7 bit hash, so have the top bit
+ * cleared, which means empty and deleted can be tested with the sign bit. */
+#define FLECS_MAP_CTRL_EMPTY ((int8_t)-128)
+#define FLECS_MAP_CTRL_DELETED ((int8_t)-2)
+
+/* Bitmask with one bit (or one nibble for NEON) per control byte in a group */
+typedef uint64_t flecs_map_mask_t;
+
+static
+uint8_t flecs_log2(uint32_t v) {
+    static const uint8_t log2table[32] =
+        {0, 9,  1,  10, 13, 21, 2,  29, 11, 14, 16, 18, 22, 25, 3, 30,
+         8, 12, 20, 28, 15, 17, 24, 7,  19, 27, 23, 6,  26, 5,  4, 31};
+
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    return log2table[(uint32_t)(v * 0x07C4ACDDU) >> 27];
+}
+
+/* Index of the lowest set bit, mask must not be 0 */
+static
+int32_t flecs_map_ctz(
+    flecs_map_mask_t mask)
+{
+    ecs_assert(mask != 0, ECS_INTERNAL_ERROR, NULL);
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (int32_t)index;
+#else
+    return (int32_t)__builtin_ctzll(mask);
+#endif
+}
+
+/* Index of the highest set bit, mask must not be 0 */
+static
+int32_t flecs_map_msb(
+    flecs_map_mask_t mask)
+{
+    ecs_assert(mask != 0, ECS_INTERNAL_ERROR, NULL);
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse64(&index, mask);
+    return (int32_t)index;
+#else
+    return 63 - (int32_t)__builtin_clzll(mask);
+#endif
+}
+
+/* Group of control bytes, loaded from an unaligned position in the ctrl array.
+ * Bit (i << FLECS_MAP_MASK_SHIFT) of a mask corresponds with byte i. */
+#if defined(FLECS_MAP_SSE2)
+
+#define FLECS_MAP_MASK_SHIFT (0)
+
+static
+flecs_map_mask_t flecs_map_group_match(
+    const int8_t *ctrl,
+    int8_t h2)
+{
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    __m128i match = _mm_cmpeq_epi8(group, _mm_set1_epi8(h2));
+    return (flecs_map_mask_t)(uint32_t)_mm_movemask_epi8(match);
+}
+
+static
+flecs_map_mask_t flecs_map_group_match_empty(
+    const int8_t *ctrl)
+{
+    return flecs_map_group_match(ctrl, FLECS_MAP_CTRL_EMPTY);
+}
+
+static
+flecs_map_mask_t flecs_map_group_match_free(
+    const int8_t *ctrl)
+{
+    /* Empty and deleted are the only control bytes with the sign bit set */
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (flecs_map_mask_t)(uint32_t)_mm_movemask_epi8(group);
+}
+
+#elif defined(FLECS_MAP_NEON)
+
+#define FLECS_MAP_MASK_SHIFT (2)
+
+/* NEON has no movemask, narrow each 16 bit lane to a byte instead which gives
+ * a nibble per control byte. Keep one bit per nibble so that clearing the
+ * lowest bit of the mask skips a whole byte. */
+static
+flecs_map_mask_t flecs_map_neon_mask(
+    uint8x16_t match)
+{
+    uint8x8_t narrow = vshrn_n_u16(vreinterpretq_u16_u8(match), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrow), 0) &
+        0x1111111111111111ull;
+}
+
+static
+flecs_map_mask_t flecs_map_group_match(
+    const int8_t *ctrl,
+    int8_t h2)
+{
+    int8x16_t group = vld1q_s8(ctrl);
+    return flecs_map_neon_mask(vceqq_s8(group, vdupq_n_s8(h2)));
+}
+
+static
+flecs_map_mask_t flecs_map_group_match_empty(
+    const int8_t *ctrl)
+{
+    return flecs_map_group_match(ctrl, FLECS_MAP_CTRL_EMPTY);
+}
+
+static
+flecs_map_mask_t flecs_map_group_match_free(
+    const int8_t *ctrl)
+{
+    int8x16_t group = vld1q_s8(ctrl);
+    return flecs_map_neon_mask(vcltq_s8(group, vdupq_n_s8(0)));
+}
+
+#else
+
+#define FLECS_MAP_MASK_SHIFT (0)
+
+static
+flecs_map_mask_t flecs_map_group_match(
+    const int8_t *ctrl,
+    int8_t h2)
+{
+    flecs_map_mask_t result = 0;
+    int32_t i;
+    for (i = 0; i < FLECS_MAP_GROUP_WIDTH; i ++) {
+        result |= (flecs_map_mask_t)(ctrl[i] == h2) << i;
+    }
+    return result;
+}
+
+static
+flecs_map_mask_t flecs_map_group_match_empty(
+    const int8_t *ctrl)
+{
+    return flecs_map_group_match(ctrl, FLECS_MAP_CTRL_EMPTY);
+}
+
+static
+flecs_map_mask_t flecs_map_group_match_free(
+    const int8_t *ctrl)
+{
+    flecs_map_mask_t result = 0;
+    int32_t i;
+    for (i = 0; i < FLECS_MAP_GROUP_WIDTH; i ++) {
+        result |= (flecs_map_mask_t)(ctrl[i] < 0) << i;
+    }
+    return result;
+}
+
+#endif
+
+/* Get bucket count for number of elements */
+static
+int32_t flecs_map_get_bucket_count(
+    int32_t count)
+{
+    return flecs_next_pow_of_2((int32_t)(count * ECS_LOAD_FACTOR * 0.1));
+}
+
+/* Get bucket shift amount for a given bucket count */
+static
+uint8_t flecs_map_get_bucket_shift (
+    int32_t bucket_count)
+{
+    return (uint8_t)(64u - flecs_log2((uint32_t)bucket_count));
+}
+
+/* Size of the allocation that holds the slots and control bytes. The control
+ * bytes are followed by a copy of the first group, so that a group can be
+ * loaded from any slot index without wrapping around. */
+static
+ecs_size_t flecs_map_alloc_size(
+    int32_t bucket_count)
+{
+    return bucket_count * ECS_SIZEOF(ecs_bucket_entry_t*) +
+        bucket_count + FLECS_MAP_GROUP_WIDTH;
+}
+
+/* Hash that is split into a slot index (h1) and a control byte (h2) */
+static
+uint64_t flecs_map_hash(
+    ecs_map_key_t key)
+{
+    return 11400714819323198485ull * key;
+}
+
+/* The top bits are used for the slot index, like the chained map */
+static
+int32_t flecs_map_h1(
+    const ecs_map_t *map,
+    uint64_t hash)
+{
+    ecs_assert(map->bucket_shift != 0, ECS_INTERNAL_ERROR, NULL);
+    return (int32_t)(hash >> map->bucket_shift);
+}
+
+/* The 7 bits below the slot index, so h2 adds information for large maps */
+static
+int8_t flecs_map_h2(
+    const ecs_map_t *map,
+    uint64_t hash)
+{
+    return (int8_t)((hash >> (map->bucket_shift - 7)) & 0x7F);
+}
+
+/* Set control byte, and update the copies that follow the control array. For
+ * maps smaller than a group the ctrl array is repeated until the group ends,
+ * so a single group load always sees every slot. */
+static
+void flecs_map_set_ctrl(
+    ecs_map_t *map,
+    int32_t index,
+    int8_t ctrl)
+{
+    int32_t bucket_count = map->bucket_count;
+    int32_t end = bucket_count + FLECS_MAP_GROUP_WIDTH;
+    map->ctrl[index] = ctrl;
+    for (index += bucket_count; index < end; index += bucket_count) {
+        map->ctrl[index] = ctrl;
+    }
+}
+
+/* Maximum number of groups that need to be probed to visit all slots */
+static
+int32_t flecs_map_probe_limit(
+    const ecs_map_t *map)
+{
+    int32_t groups = map->bucket_count / FLECS_MAP_GROUP_WIDTH;
+    return groups ? groups : 1;
+}
+
+/* Find slot index of key, returns -1 if the key is not in the map */
+static
+int32_t flecs_map_find(
+    const ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
+    uint64_t hash = flecs_map_hash(key);
+    int8_t h2 = flecs_map_h2(map, hash);
+    int32_t mask = map->bucket_count - 1;
+    int32_t pos = flecs_map_h1(map, hash);
+    int32_t probe, limit = flecs_map_probe_limit(map);
+    const int8_t *ctrl = map->ctrl;
+    ecs_bucket_entry_t *const *slots = map->slots;
+
+    /* Most keys are stored in their home slot. Test it before the group, as
+     * loading the control byte and the slot doesn't depend on each other. */
+    if (ctrl[pos] == h2 && slots[pos]->key == key) {
+        return pos;
+    }
+
+    /* Triangular probing over groups visits every group of a power of two
+     * sized map exactly once within the probe limit. */
+    for (probe = 0; probe < limit; probe ++) {
+        flecs_map_mask_t match = flecs_map_group_match(&ctrl[pos], h2);
+        while (match) {
+            int32_t index = (pos +
+                (flecs_map_ctz(match) >> FLECS_MAP_MASK_SHIFT)) & mask;
+            if (slots[index]->key == key) {
+                return index;
+            }
+            match &= match - 1;
+        }
+
+        /* An empty slot means the key was never inserted past this group */
+        if (flecs_map_group_match_empty(&ctrl[pos])) {
+            return -1;
+        }
+
+        pos = (pos + (probe + 1) * FLECS_MAP_GROUP_WIDTH) & mask;
+    }
+
+    return -1;
+}
+
+/* Find empty or deleted slot for a key that is not in the map */
+static
+int32_t flecs_map_find_free(
+    const ecs_map_t *map,
+    uint64_t hash)
+{
+    int32_t mask = map->bucket_count - 1;
+    int32_t pos = flecs_map_h1(map, hash);
+    int32_t probe, limit = flecs_map_probe_limit(map);
+
+    for (probe = 0; probe < limit; probe ++) {
+        flecs_map_mask_t match = flecs_map_group_match_free(&map->ctrl[pos]);
+        if (match) {
+            return (pos +
+                (flecs_map_ctz(match) >> FLECS_MAP_MASK_SHIFT)) & mask;
+        }
+
+        pos = (pos + (probe + 1) * FLECS_MAP_GROUP_WIDTH) & mask;
+    }
+
+    ecs_abort(ECS_INTERNAL_ERROR, "map has no free slots");
+    return -1;
+}
+
+/* Add slot for key that is not in the map, without checking whether to rehash */
+static
+void flecs_map_slot_add(
+    ecs_map_t *map,
+    ecs_bucket_entry_t *entry)
+{
+    uint64_t hash = flecs_map_hash(entry->key);
+    int32_t index = flecs_map_find_free(map, hash);
+    if (map->ctrl[index] == FLECS_MAP_CTRL_DELETED) {
+        map->deleted --;
+    }
+
+    flecs_map_set_ctrl(map, index, flecs_map_h2(map, hash));
+
+    map->slots[index] = entry;
+}
+
+/* Free entries of full slots */
+static
+void flecs_map_entries_free(
+    ecs_map_t *map)
+{
+    int32_t i, count = map->bucket_count;
+    for (i = 0; i < count; i ++) {
+        if (map->ctrl[i] >= 0) {
+            flecs_bfree(map->entry_allocator, map->slots[i]);
+        }
+    }
+}
+
+/* Allocate slots and control bytes for bucket count, and reinsert elements */
+static
+void flecs_map_rehash(
+    ecs_map_t *map,
+    int32_t count)
+{
+    count = flecs_next_pow_of_2(count);
+    if (count < 2) {
+        count = 2;
+    }
+
+    int32_t old_count = map->bucket_count;
+    ecs_bucket_entry_t **slots = map->slots;
+    int8_t *ctrl = map->ctrl;
+
+    ecs_size_t size = flecs_map_alloc_size(count);
+    if (map->allocator) {
+        map->slots = flecs_alloc(map->allocator, size);
+    } else {
+        map->slots = ecs_os_malloc(size);
+    }
+
+    map->ctrl = ECS_OFFSET(map->slots, count * ECS_SIZEOF(ecs_bucket_entry_t*));
+    ecs_os_memset(map->ctrl, FLECS_MAP_CTRL_EMPTY,
+        count + FLECS_MAP_GROUP_WIDTH);
+    map->bucket_count = count;
+    map->bucket_shift = flecs_map_get_bucket_shift(count);
+    map->deleted = 0;
+
+    /* Reinsert old slots, which also drops deleted slots. Entries are not
+     * moved, only the slots that point to them. */
+    int32_t i;
+    for (i = 0; i < old_count; i ++) {
+        if (ctrl[i] >= 0) {
+            flecs_map_slot_add(map, slots[i]);
+        }
+    }
+
+    if (slots) {
+        if (map->allocator) {
+            flecs_free(map->allocator, flecs_map_alloc_size(old_count), slots);
+        } else {
+            ecs_os_free(slots);
+        }
+    }
+}
+
+/* Remove deleted slots without reallocating. Full slots are temporarily marked
+ * as deleted and reinserted, deleted slots become empty. An element either
+ * stays if it's already in the first group of its probe sequence that has a
+ * free slot, is moved to an empty slot, or is swapped with an element that
+ * still has to be reinserted. */
+static
+void flecs_map_drop_deleted(
+    ecs_map_t *map)
+{
+    int32_t i, bucket_count = map->bucket_count;
+    int32_t mask = bucket_count - 1;
+    int8_t *ctrl = map->ctrl;
+    ecs_bucket_entry_t **slots = map->slots;
+
+    for (i = 0; i < bucket_count + FLECS_MAP_GROUP_WIDTH; i ++) {
+        ctrl[i] = ctrl[i] >= 0 ? FLECS_MAP_CTRL_DELETED : FLECS_MAP_CTRL_EMPTY;
+    }
+
+    for (i = 0; i < bucket_count; i ++) {
+        if (ctrl[i] != FLECS_MAP_CTRL_DELETED) {
+            continue;
+        }
+
+        uint64_t hash = flecs_map_hash(slots[i]->key);
+        int32_t pos = flecs_map_h1(map, hash);
+        int32_t new_i = flecs_map_find_free(map, hash);
+        int8_t h2 = flecs_map_h2(map, hash);
+
+        int32_t probe_i = ((i - pos) & mask) / FLECS_MAP_GROUP_WIDTH;
+        int32_t probe_new_i = ((new_i - pos) & mask) / FLECS_MAP_GROUP_WIDTH;
+        if (probe_i == probe_new_i) {
+            flecs_map_set_ctrl(map, i, h2);
+            continue;
+        }
+
+        if (ctrl[new_i] == FLECS_MAP_CTRL_EMPTY) {
+            flecs_map_set_ctrl(map, new_i, h2);
+            slots[new_i] = slots[i];
+            flecs_map_set_ctrl(map, i, FLECS_MAP_CTRL_EMPTY);
+        } else {
+            /* Target still has to be reinserted, swap and retry slot */
+            ecs_bucket_entry_t *tmp = slots[new_i];
+            flecs_map_set_ctrl(map, new_i, h2);
+            slots[new_i] = slots[i];
+            slots[i] = tmp;
+            i --;
+        }
+    }
+
+    map->deleted = 0;
+}
+
+/* Make sure there's space for inserting a new element. Deleted slots count
+ * towards the load, as they don't terminate probing for missing keys. */
+static
+void flecs_map_reserve_one(
+    ecs_map_t *map)
+{
+    int32_t count = map->count + 1;
+    int32_t bucket_count = map->bucket_count;
+    if (flecs_map_get_bucket_count(count + map->deleted) <= bucket_count) {
+        return;
+    }
+
+    /* Only clean up in place if that frees up enough slots to not have to do
+     * it again for a while, otherwise grow the map. */
+    if (map->deleted &&
+        flecs_map_get_bucket_count(count + bucket_count / 64) <= bucket_count)
+    {
+        flecs_map_drop_deleted(map);
+    } else {
+        int32_t tgt_bucket_count = flecs_map_get_bucket_count(count);
+        if (tgt_bucket_count <= bucket_count) {
+            tgt_bucket_count = bucket_count * 2;
+        }
+        flecs_map_rehash(map, tgt_bucket_count);
+    }
+}
+
+/* Insert element for key that is not in the map */
+static
+ecs_map_val_t* flecs_map_entry_add(
+    ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    flecs_map_reserve_one(map);
+
+    ecs_bucket_entry_t *entry = flecs_balloc(map->entry_allocator);
+    entry->key = key;
+    flecs_map_slot_add(map, entry);
+    map->count ++;
+    return &entry->value;
+}
+
+/* A removed slot can only be marked as empty if no probe sequence could have
+ * continued past it, which is when every group that contains the slot also
+ * contains an empty slot. Otherwise it's marked as deleted, so that lookups
+ * for keys that were inserted after a full group keep probing. */
+static
+bool flecs_map_was_never_full(
+    const ecs_map_t *map,
+    int32_t index)
+{
+    int32_t bucket_count = map->bucket_count;
+    if (bucket_count <= FLECS_MAP_GROUP_WIDTH) {
+        /* Small maps are always probed with a single group */
+        return true;
+    }
+
+    int32_t mask = bucket_count - 1;
+    const int8_t *ctrl = map->ctrl;
+    flecs_map_mask_t empty_before = flecs_map_group_match_empty(
+        &ctrl[(index - FLECS_MAP_GROUP_WIDTH) & mask]);
+    flecs_map_mask_t empty_after = flecs_map_group_match_empty(&ctrl[index]);
+    if (!empty_before || !empty_after) {
+        return false;
+    }
+
+    /* Number of full or deleted slots directly before and after the slot */
+    int32_t before = FLECS_MAP_GROUP_WIDTH - 1 -
+        (flecs_map_msb(empty_before) >> FLECS_MAP_MASK_SHIFT);
+    int32_t after = flecs_map_ctz(empty_after) >> FLECS_MAP_MASK_SHIFT;
+    return (before + after) < FLECS_MAP_GROUP_WIDTH;
+}
+
+void ecs_map_params_init(
+    ecs_map_params_t *params,
+    ecs_allocator_t *allocator)
+{
+    params->allocator = allocator;
+    flecs_ballocator_init_t(&params->entry_allocator, ecs_bucket_entry_t);
+}
+
+void ecs_map_params_fini(
+    ecs_map_params_t *params)
+{
+    flecs_ballocator_fini(&params->entry_allocator);
+}
+
+void ecs_map_init_w_params(
+    ecs_map_t *result,
+    ecs_map_params_t *params)
+{
+    ecs_os_zeromem(result);
+
+    result->allocator = params->allocator;
+
+    if (params->entry_allocator.chunk_size) {
+        result->entry_allocator = &params->entry_allocator;
+        result->shared_allocator = true;
+    } else {
+        result->entry_allocator = flecs_ballocator_new_t(ecs_bucket_entry_t);
+    }
+
+    flecs_map_rehash(result, 0);
+}
+
+void ecs_map_init_w_params_if(
+    ecs_map_t *result,
+    ecs_map_params_t *params)
+{
+    if (!ecs_map_is_init(result)) {
+        ecs_map_init_w_params(result, params);
+    }
+}
+
+void ecs_map_init(
+    ecs_map_t *result,
+    ecs_allocator_t *allocator)
+{
+    ecs_map_init_w_params(result, &(ecs_map_params_t) {
+        .allocator = allocator
+    });
+}
+
+void ecs_map_init_if(
+    ecs_map_t *result,
+    ecs_allocator_t *allocator)
+{
+    if (!ecs_map_is_init(result)) {
+        ecs_map_init(result, allocator);
+    }
+}
+
+void ecs_map_fini(
+    ecs_map_t *map)
+{
+    if (!ecs_map_is_init(map)) {
+        return;
+    }
+
+    bool sanitize = false;
+#if defined(FLECS_SANITIZE) || defined(FLECS_USE_OS_ALLOC)
+    sanitize = true;
+#endif
+
+    /* Free entries in sanitized mode, so we can replace the allocator with
+     * regular malloc/free and use asan/valgrind to find memory errors. */
+    ecs_block_allocator_t *ea = map->entry_allocator;
+    if (map->shared_allocator || sanitize) {
+        flecs_map_entries_free(map);
+    }
+
+    if (ea && !map->shared_allocator) {
+        flecs_ballocator_free(ea);
+        map->entry_allocator = NULL;
+    }
+
+    ecs_size_t size = flecs_map_alloc_size(map->bucket_count);
+    if (map->allocator) {
+        flecs_free(map->allocator, size, map->slots);
+    } else {
+        ecs_os_free(map->slots);
+    }
+
+    map->slots = NULL;
+    map->ctrl = NULL;
+    map->bucket_shift = 0;
+}
+
+ecs_map_val_t* ecs_map_get(
+    const ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    int32_t index = flecs_map_find(map, key);
+    if (index == -1) {
+        return NULL;
+    }
+    return &map->slots[index]->value;
+}
+
+void* ecs_map_get_deref_(
+    const ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    int32_t index = flecs_map_find(map, key);
+    if (index == -1) {
+        return NULL;
+    }
+    return (void*)(uintptr_t)map->slots[index]->value;
+}
+
+void ecs_map_insert(
+    ecs_map_t *map,
+    ecs_map_key_t key,
+    ecs_map_val_t value)
+{
+    ecs_assert(ecs_map_get(map, key) == NULL, ECS_INVALID_PARAMETER, NULL);
+    flecs_map_entry_add(map, key)[0] = value;
+}
+
+void* ecs_map_insert_alloc(
+    ecs_map_t *map,
+    ecs_size_t elem_size,
+    ecs_map_key_t key)
+{
+    void *elem = ecs_os_calloc(elem_size);
+    ecs_map_insert_ptr(map, key, (uintptr_t)elem);
+    return elem;
+}
+
+ecs_map_val_t* ecs_map_ensure(
+    ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    int32_t index = flecs_map_find(map, key);
+    if (index != -1) {
+        return &map->slots[index]->value;
+    }
+
+    ecs_map_val_t *v = flecs_map_entry_add(map, key);
+    *v = 0;
+    return v;
+}
+
+void* ecs_map_ensure_alloc(
+    ecs_map_t *map,
+    ecs_size_t elem_size,
+    ecs_map_key_t key)
+{
+    ecs_map_val_t *val = ecs_map_ensure(map, key);
+    if (!*val) {
+        void *elem = ecs_os_calloc(elem_size);
+        *val = (ecs_map_val_t)(uintptr_t)elem;
+        return elem;
+    } else {
+        return (void*)(uintptr_t)*val;
+    }
+}
+
+ecs_map_val_t ecs_map_remove(
+    ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    int32_t index = flecs_map_find(map, key);
+    if (index == -1) {
+        return 0;
+    }
+
+    /* Slots are never moved on remove, which keeps removing the current
+     * element while iterating safe. */
+    if (flecs_map_was_never_full(map, index)) {
+        flecs_map_set_ctrl(map, index, FLECS_MAP_CTRL_EMPTY);
+    } else {
+        flecs_map_set_ctrl(map, index, FLECS_MAP_CTRL_DELETED);
+        map->deleted ++;
+    }
+    map->count --;
+
+    ecs_bucket_entry_t *entry = map->slots[index];
+    ecs_map_val_t value = entry->value;
+    flecs_bfree(map->entry_allocator, entry);
+    return value;
+}
+
+void ecs_map_remove_free(
+    ecs_map_t *map,
+    ecs_map_key_t key)
+{
+    ecs_map_val_t val = ecs_map_remove(map, key);
+    if (val) {
+        ecs_os_free((void*)(uintptr_t)val);
+    }
+}
+
+void ecs_map_clear(
+    ecs_map_t *map)
+{
+    ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
+    flecs_map_entries_free(map);
+
+    ecs_size_t size = flecs_map_alloc_size(map->bucket_count);
+    if (map->allocator) {
+        flecs_free(map->allocator, size, map->slots);
+    } else {
+        ecs_os_free(map->slots);
+    }
+    map->slots = NULL;
+    map->ctrl = NULL;
+    map->bucket_count = 0;
+    map->count = 0;
+    flecs_map_rehash(map, 2);
+}
+
+ecs_map_iter_t ecs_map_iter(
+    const ecs_map_t *map)
+{
+    if (ecs_map_is_init(map)) {
+        return (ecs_map_iter_t){
+            .map = map,
+            .index = -1
+        };
+    } else {
+        return (ecs_map_iter_t){ 0 };
+    }
+}
+
+bool ecs_map_next(
+    ecs_map_iter_t *iter)
+{
+    const ecs_map_t *map = iter->map;
+    if (!map) {
+        return false;
+    }
+
+    int32_t index = iter->index + 1, count = map->bucket_count;
+    const int8_t *ctrl = map->ctrl;
+
+    /* Skip groups without full slots */
+    while (index < count) {
+        flecs_map_mask_t full = ~flecs_map_group_match_free(&ctrl[index]);
+        if (index + FLECS_MAP_GROUP_WIDTH > count) {
+            /* Don't visit the copies of the first group */
+            full &= ((flecs_map_mask_t)1 <<
+                ((count - index) << FLECS_MAP_MASK_SHIFT)) - 1;
+        }
+#ifdef FLECS_MAP_NEON
+        full &= 0x1111111111111111ull;
+#elif FLECS_MAP_GROUP_WIDTH < 64
+        full &= ((flecs_map_mask_t)1 << FLECS_MAP_GROUP_WIDTH) - 1;
+#endif
+        if (full) {
+            index += flecs_map_ctz(full) >> FLECS_MAP_MASK_SHIFT;
+            iter->index = index;
+            iter->res = &map->slots[index]->key;
+            return true;
+        }
+        index += FLECS_MAP_GROUP_WIDTH;
+    }
+
+    iter->index = count;
+    return false;
+}
+
+void ecs_map_copy(
+    ecs_map_t *dst,
+    const ecs_map_t *src)
+{
+    if (ecs_map_is_init(dst)) {
+        ecs_assert(ecs_map_count(dst) == 0, ECS_INVALID_PARAMETER, NULL);
+        ecs_map_fini(dst);
+    }
+
+    if (!ecs_map_is_init(src)) {
+        return;
+    }
+
+    ecs_map_init(dst, src->allocator);
+
+    ecs_map_iter_t it = ecs_map_iter(src);
+    while (ecs_map_next(&it)) {
+        ecs_map_insert(dst, ecs_map_key(&it), ecs_map_value(&it));
+    }
+}
+
+#endif
@@ -299,13 +299,22 @@ int32_t flecs_child_type_insert(
     return i;
 }
 
-static inline
+static
+void flecs_instantiate_entities(
+    ecs_world_t *world,
+    ecs_entity_t base,
+    const ecs_entity_t *entities,
+    int32_t count,
+    bool is_prefab,
+    const ecs_instantiate_ctx_t *ctx);
+
+static
 void flecs_instantiate_children(
     ecs_world_t *world,
     ecs_entity_t base,
-    ecs_table_t *table,
-    int32_t row,
+    const ecs_entity_t *instances,
     int32_t count,
+    bool is_prefab,
     ecs_table_t *child_table,
     const ecs_instantiate_ctx_t *ctx)
 {
@@ -350,7 +359,7 @@ void flecs_instantiate_children(
         /* If child is a slot, keep track of which parent to add it to, but
          * don't add slot relationship to child of instance. If this is a child
          * of a prefab, keep the SlotOf relationship intact. */
-        if (!(table->flags & EcsTableIsPrefab)) {
+        if (!is_prefab) {
             if (ECS_IS_PAIR(id) && ECS_PAIR_FIRST(id) == EcsSlotOf) {
                 ecs_assert(slot_of == 0, ECS_INTERNAL_ERROR, NULL);
                 slot_of = ecs_pair_second(world, id);
@@ -393,7 +402,7 @@ void flecs_instantiate_children(
     ecs_assert(childof_base_index != -1, ECS_INTERNAL_ERROR, NULL);
 
     /* If children are added to a prefab, make sure they are prefabs too */
-    if (table->flags & EcsTableIsPrefab) {
+    if (is_prefab) {
         if (flecs_child_type_insert(
             &diff.added, component_data, EcsPrefab) != -1) 
         {
@@ -401,13 +410,19 @@ void flecs_instantiate_children(
         }
     }
 
-    /* Instantiate the prefab child table for each new instance */
-    const ecs_entity_t *instances = ecs_table_entities(table);
+    /* Instantiate the prefab child table for each new instance. The children
+     * of all instances are stored in a single array, so that the children of
+     * the prefab children can be instantiated for all instances at once. */
+    const ecs_entity_t *children = ecs_table_entities(child_table);
     int32_t child_count = ecs_table_count(child_table);
-    ecs_entity_t *child_ids = flecs_walloc_n(world, ecs_entity_t, child_count);
+    int32_t total_count = child_count * count;
+    ecs_entity_t *child_ids = flecs_walloc_n(world, ecs_entity_t, total_count);
+    ecs_instantiate_ctx_t *child_ctx = flecs_walloc_n(
+        world, ecs_instantiate_ctx_t, count);
 
-    for (i = row; i < count + row; i ++) {
+    for (i = 0; i < count; i ++) {
         ecs_entity_t instance = instances[i];
+        ecs_entity_t *i_child_ids = &child_ids[i * child_count];
         ecs_table_t *i_table = NULL;
  
         /* Replace ChildOf element in the component array with instance id */
@@ -423,8 +438,6 @@ void flecs_instantiate_children(
         /* The instance is trying to instantiate from a base that is also
          * its parent. This would cause the hierarchy to instantiate itself
          * which would cause infinite recursion. */
-        const ecs_entity_t *children = ecs_table_entities(child_table);
-
 #ifdef FLECS_DEBUG
         for (j = 0; j < child_count; j ++) {
             ecs_entity_t child = children[j];        
@@ -442,13 +455,15 @@ void flecs_instantiate_children(
          * instance children, even across networked applications. */
         ecs_instantiate_ctx_t ctx_cur = {base, instance};
         if (ctx) {
-            ctx_cur = *ctx;
+            ctx_cur = ctx[i];
         }
 
+        child_ctx[i] = ctx_cur;
+
         for (j = 0; j < child_count; j ++) {
             if ((uint32_t)children[j] < (uint32_t)ctx_cur.root_prefab) {
                 /* Child id is smaller than root prefab id, can't use offset */
-                child_ids[j] = ecs_new(world);
+                i_child_ids[j] = ecs_new(world);
                 continue;
             }
 
@@ -462,7 +477,7 @@ void flecs_instantiate_children(
             ecs_entity_t alive_id = flecs_entities_get_alive(world, instance_child);
             if (alive_id && flecs_entities_is_alive(world, alive_id)) {
                 /* Alive entity with requested id exists, can't use offset id */
-                child_ids[j] = ecs_new(world);
+                i_child_ids[j] = ecs_new(world);
                 continue;
             }
 
@@ -471,42 +486,57 @@ void flecs_instantiate_children(
             flecs_entities_make_alive(world, instance_child);
             flecs_entities_ensure(world, instance_child);
             ecs_assert(ecs_is_alive(world, instance_child), ECS_INTERNAL_ERROR, NULL);
-            child_ids[j] = instance_child;
+            i_child_ids[j] = instance_child;
         }
 
         /* Create children */
-        int32_t child_row;
-        const ecs_entity_t *i_children = flecs_bulk_new(world, i_table, child_ids,
-            &diff.added, child_count, component_data, false, &child_row, &diff);
+        flecs_bulk_new(world, i_table, i_child_ids, &diff.added, child_count, 
+            component_data, false, NULL, &diff);
 
         /* If children are slots, add slot relationships to parent */
         if (slot_of) {
             for (j = 0; j < child_count; j ++) {
                 ecs_entity_t child = children[j];
-                ecs_entity_t i_child = i_children[j];
+                ecs_entity_t i_child = i_child_ids[j];
                 flecs_instantiate_slot(world, base, instance, slot_of,
                     child, i_child);
             }
         }
+    }
 
-        /* If prefab child table has children itself, recursively instantiate */
-        for (j = 0; j < child_count; j ++) {
-            ecs_entity_t child = children[j];
-            flecs_instantiate(world, child, i_table, child_row + j, 1, &ctx_cur);
+    /* If prefab child table has children itself, recursively instantiate. This
+     * is done once per prefab child for all instances, so that the hierarchy
+     * of a prefab child is only looked up once. */
+    ecs_entity_t *i_children = flecs_walloc_n(world, ecs_entity_t, count);
+    for (j = 0; j < child_count; j ++) {
+        ecs_entity_t child = children[j];
+        ecs_record_t *r = flecs_entities_get_any(world, child);
+        ecs_table_t *table = r->table;
+        if (!table || !(table->flags & (EcsTableIsPrefab|EcsTableHasUnion))) {
+            continue;
+        }
+
+        for (i = 0; i < count; i ++) {
+            i_children[i] = child_ids[i * child_count + j];
         }
+
+        flecs_instantiate_entities(
+            world, child, i_children, count, is_prefab, child_ctx);
     }
 
-    flecs_wfree_n(world, ecs_entity_t, child_count, child_ids);
+    flecs_wfree_n(world, ecs_entity_t, count, i_children);
 error:
-    return;    
+    flecs_wfree_n(world, ecs_instantiate_ctx_t, count, child_ctx);
+    flecs_wfree_n(world, ecs_entity_t, total_count, child_ids);
 }
 
-void flecs_instantiate(
+static
+void flecs_instantiate_entities(
     ecs_world_t *world,
     ecs_entity_t base,
-    ecs_table_t *table,
-    int32_t row,
+    const ecs_entity_t *entities,
     int32_t count,
+    bool is_prefab,
     const ecs_instantiate_ctx_t *ctx)
 {
     ecs_record_t *record = flecs_entities_get_any(world, base);
@@ -517,7 +547,6 @@ void flecs_instantiate(
 
     /* If prefab has union relationships, also set them on instance */
     if (base_table->flags & EcsTableHasUnion) {
-        const ecs_entity_t *entities = ecs_table_entities(table);
         ecs_id_record_t *union_idr = flecs_id_record_get(world, 
             ecs_pair(EcsWildcard, EcsUnion));
         ecs_assert(union_idr != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -532,7 +561,7 @@ void flecs_instantiate(
                 ecs_entity_t tgt = ecs_get_target(world, base, rel, 0);
                 ecs_assert(tgt != 0, ECS_INTERNAL_ERROR, NULL);
 
-                for (j = row; j < (row + count); j ++) {
+                for (j = 0; j < count; j ++) {
                     ecs_add_pair(world, entities[j], rel, tgt);
                 }
 
@@ -554,13 +583,35 @@ void flecs_instantiate(
         ecs_os_perf_trace_push("flecs.instantiate");
         const ecs_table_record_t *tr;
         while ((tr = flecs_table_cache_next(&it, ecs_table_record_t))) {
-            flecs_instantiate_children(
-                world, base, table, row, count, tr->hdr.table, ctx);
+            flecs_instantiate_children(world, base, entities, count, 
+                is_prefab, tr->hdr.table, ctx);
         }
         ecs_os_perf_trace_pop("flecs.instantiate");
     }
 }
 
+void flecs_instantiate(
+    ecs_world_t *world,
+    ecs_entity_t base,
+    ecs_table_t *table,
+    int32_t row,
+    int32_t count,
+    const ecs_instantiate_ctx_t *ctx)
+{
+    ecs_assert(ctx == NULL || count == 1, ECS_INTERNAL_ERROR, NULL);
+
+    /* Copy instance ids, as adding slots and unions to an instance moves it
+     * out of the table. */
+    ecs_entity_t *entities = flecs_walloc_n(world, ecs_entity_t, count);
+    ecs_os_memcpy_n(entities, &ecs_table_entities(table)[row], 
+        ecs_entity_t, count);
+
+    flecs_instantiate_entities(world, base, entities, count, 
+        (table->flags & EcsTableIsPrefab) != 0, ctx);
+
+    flecs_wfree_n(world, ecs_entity_t, count, entities);
+}
+
 static inline
 void flecs_sparse_on_add(
     ecs_world_t *world,
@@ -805,6 +856,9 @@ void flecs_update_name_index(
         const ecs_entity_t e = entities[i];
         EcsIdentifier *name = &names[i];
 
+        /* Parent changed, so the path of the entity changed */
+        flecs_path_cache_remove(world, e);
+
         const uint64_t index_hash = name->index_hash;
         if (index_hash) {
             flecs_name_index_remove(src_index, e, index_hash);
@@ -1016,6 +1070,12 @@ void flecs_commit(
      * component from, for example, a container. */
     if (is_trav) {
         flecs_update_component_monitors(world, &diff->added, &diff->removed);
+
+        /* OnRemove events invalidate the up traversal cache before the entity
+         * is moved, so invalidate again in case an observer repopulated it. */
+        if (record->idr && ecs_map_count(&world->trav_up_cache)) {
+            flecs_trav_up_cache_invalidate(world, record->idr);
+        }
     }
 
     if ((!src_table || !src_table->type.count) && world->range_check_enabled) {
@@ -1176,12 +1236,18 @@ void flecs_add_id(
 
     ecs_record_t *r = flecs_entities_get(world, entity);
     ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_table_diff_t diff = ECS_TABLE_DIFF_INIT;
-    ecs_table_t *src_table = r->table;
-    ecs_table_t *dst_table = flecs_table_traverse_add(
-        world, src_table, &id, &diff);
 
-    flecs_commit(world, entity, r, dst_table, &diff, true, 0);
+    ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+    if (idr) {
+        flecs_dont_fragment_ensure(world, entity, r, idr, true, NULL);
+    } else {
+        ecs_table_diff_t diff = ECS_TABLE_DIFF_INIT;
+        ecs_table_t *src_table = r->table;
+        ecs_table_t *dst_table = flecs_table_traverse_add(
+            world, src_table, &id, &diff);
+
+        flecs_commit(world, entity, r, dst_table, &diff, true, 0);
+    }
 
     flecs_defer_end(world, stage);
 }
@@ -1199,12 +1265,22 @@ void flecs_remove_id(
 
     ecs_record_t *r = flecs_entities_get(world, entity);
     ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_table_t *src_table = r->table;
-    ecs_table_diff_t diff = ECS_TABLE_DIFF_INIT;
-    ecs_table_t *dst_table = flecs_table_traverse_remove(
-        world, src_table, &id, &diff);
 
-    flecs_commit(world, entity, r, dst_table, &diff, true, 0);
+    ecs_id_record_t *idr = NULL;
+    if (r->row & EcsEntityHasDontFragment) {
+        idr = flecs_dont_fragment_get(world, id);
+    }
+
+    if (idr) {
+        flecs_dont_fragment_remove(world, entity, r, idr);
+    } else {
+        ecs_table_t *src_table = r->table;
+        ecs_table_diff_t diff = ECS_TABLE_DIFF_INIT;
+        ecs_table_t *dst_table = flecs_table_traverse_remove(
+            world, src_table, &id, &diff);
+
+        flecs_commit(world, entity, r, dst_table, &diff, true, 0);
+    }
 
     flecs_defer_end(world, stage);
 }
@@ -1256,6 +1332,14 @@ flecs_component_ptr_t flecs_ensure(
         }
     }
 
+    /* DontFragment components are not stored in the table */
+    ecs_id_record_t *df_idr = flecs_dont_fragment_get(world, id);
+    if (df_idr) {
+        dst.ptr = flecs_dont_fragment_ensure(world, entity, r, df_idr, true, NULL);
+        dst.ti = df_idr->type_info;
+        return dst;
+    }
+
     /* If entity didn't have component yet, add it */
     flecs_add_id_w_record(world, entity, r, id, true);
 
@@ -1605,6 +1689,7 @@ error:
 static inline
 void flecs_copy_id(
     ecs_world_t *world,
+    ecs_entity_t entity,
     ecs_record_t *r,
     ecs_id_t id,
     size_t size,
@@ -1622,6 +1707,14 @@ void flecs_copy_id(
         ecs_os_memcpy(dst_ptr, src_ptr, flecs_utosize(size));
     }
 
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            flecs_dont_fragment_on_set(world, entity, r, idr);
+            return;
+        }
+    }
+
     flecs_table_mark_dirty(world, r->table, id);
 
     ecs_table_t *table = r->table;
@@ -1766,12 +1859,20 @@ int flecs_traverse_add(
     ecs_record_t *r = flecs_entities_get(world, result);
     ecs_table_t* table = r->table;
 
+    /* DontFragment components are not part of the table, and are added after
+     * the entity is committed to its destination table. */
+    bool has_dont_fragment = false;
+
     /* Add components from the 'add' array */
     if (desc->add) {
         int32_t i = 0;
         ecs_id_t id;
 
         while ((id = desc->add[i ++])) {
+            if (flecs_dont_fragment_get(world, id)) {
+                has_dont_fragment = true;
+                continue;
+            }
             table = flecs_find_table_add(world, table, id, &diff);
         }
     }
@@ -1782,6 +1883,10 @@ int flecs_traverse_add(
         ecs_id_t id;
 
         while ((id = desc->set[i ++].type)) {
+            if (flecs_dont_fragment_get(world, id)) {
+                has_dont_fragment = true;
+                continue;
+            }
             table = flecs_find_table_add(world, table, id, &diff);
         }
     }
@@ -1791,6 +1896,10 @@ int flecs_traverse_add(
         const int32_t count = ecs_vec_count(&ids);
         const ecs_id_t *expr_ids = ecs_vec_first(&ids);
         for (int32_t i = 0; i < count; i ++) {
+            if (flecs_dont_fragment_get(world, expr_ids[i])) {
+                has_dont_fragment = true;
+                continue;
+            }
             table = flecs_find_table_add(world, table, expr_ids[i], &diff);
         }
     }
@@ -1818,10 +1927,50 @@ int flecs_traverse_add(
         flecs_defer_end(world, world->stages[0]);
     }
 
+    if (has_dont_fragment) {
+        flecs_defer_begin(world, world->stages[0]);
+        int32_t i = 0;
+        ecs_id_t id;
+        if (desc->add) {
+            while ((id = desc->add[i ++])) {
+                ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+                if (idr) {
+                    flecs_dont_fragment_ensure(world, result, r, idr, true, NULL);
+                }
+            }
+        }
+        if (desc->set) {
+            const ecs_value_t *v;
+            i = 0;
+            while ((void)(v = &desc->set[i ++]), v->type) {
+                ecs_id_record_t *idr = flecs_dont_fragment_get(world, v->type);
+                if (!idr) {
+                    continue;
+                }
+                void *ptr = flecs_dont_fragment_ensure(
+                    world, result, r, idr, true, NULL);
+                if (v->ptr && ptr) {
+                    const ecs_type_info_t *ti = idr->type_info;
+                    flecs_copy_id(world, result, r, v->type, 
+                        flecs_itosize(ti->size), ptr, v->ptr, ti);
+                }
+            }
+        }
+
+        const int32_t count = ecs_vec_count(&ids);
+        const ecs_id_t *expr_ids = ecs_vec_first(&ids);
+        for (i = 0; i < count; i ++) {
+            ecs_id_record_t *idr = flecs_dont_fragment_get(world, expr_ids[i]);
+            if (idr) {
+                flecs_dont_fragment_ensure(world, result, r, idr, true, NULL);
+            }
+        }
+        flecs_defer_end(world, world->stages[0]);
+    }
+
     /* Set component values */
     if (desc->set) {
         table = r->table;
-        ecs_assert(r->table != NULL, ECS_INTERNAL_ERROR, NULL);
         int32_t i = 0, row = ECS_RECORD_TO_ROW(r->row);
         const ecs_value_t *v;
         
@@ -1831,12 +1980,16 @@ int flecs_traverse_add(
             if (!v->ptr) {
                 continue;
             }
+            if (has_dont_fragment && flecs_dont_fragment_get(world, v->type)) {
+                continue;
+            }
+            ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
             ecs_assert(ECS_RECORD_TO_ROW(r->row) == row, ECS_INTERNAL_ERROR, NULL);
             ecs_id_record_t *idr = flecs_id_record_get(world, v->type);
             const flecs_component_ptr_t ptr = flecs_get_component_ptr(table, row, idr);
             ecs_check(ptr.ptr != NULL, ECS_INTERNAL_ERROR, NULL);
             const ecs_type_info_t *ti = idr->type_info;
-            flecs_copy_id(world, r, v->type, 
+            flecs_copy_id(world, result, r, v->type, 
                 flecs_itosize(ti->size), ptr.ptr, v->ptr, ti);
         }
 
@@ -2182,6 +2335,538 @@ error:
     return NULL;
 }
 
+/* -- World clone -- */
+
+typedef enum flecs_clone_state_t {
+    FlecsCloneSkip,      /* Table can't be copied to the destination world */
+    FlecsClonePending,   /* Table will be copied */
+    FlecsCloneCopied     /* Table has been copied */
+} flecs_clone_state_t;
+
+/* Per type index flags for ids that need more than copying the table data */
+#define FlecsCloneIdSparse (1u << 0)
+#define FlecsCloneIdUnion  (1u << 1)
+#define FlecsCloneIdToggle (1u << 2)
+
+typedef struct flecs_clone_t {
+    ecs_world_t *dst;
+    const ecs_world_t *src;
+    ecs_map_t tables;     /* map<table id, flecs_clone_state_t> */
+    uint64_t *pending;    /* Bitset of entity indices copied from src */
+    int32_t pending_words;
+} flecs_clone_t;
+
+static
+bool flecs_clone_is_pending(
+    const flecs_clone_t *clone,
+    uint64_t entity)
+{
+    uint32_t index = (uint32_t)entity;
+    if ((int32_t)(index >> 6) >= clone->pending_words) {
+        return false;
+    }
+    return (clone->pending[index >> 6] & (1ull << (index & 63))) != 0;
+}
+
+static
+flecs_clone_state_t flecs_clone_table_state(
+    const flecs_clone_t *clone,
+    const ecs_table_t *table)
+{
+    ecs_map_val_t *state = ecs_map_get(&clone->tables, table->id);
+    return state ? (flecs_clone_state_t)*state : FlecsCloneSkip;
+}
+
+/* Values with a destructor but no copy hook own resources that can't be
+ * duplicated by copying their bytes. */
+static
+bool flecs_clone_type_info_copyable(
+    const ecs_type_info_t *ti)
+{
+    if (!ti) {
+        return true;
+    }
+    if (ti->hooks.flags & ECS_TYPE_HOOK_COPY_ILLEGAL) {
+        return false;
+    }
+    return !ti->hooks.dtor || ti->hooks.copy;
+}
+
+static
+bool flecs_clone_table_copyable(
+    const ecs_world_t *src,
+    const ecs_table_t *table)
+{
+    int32_t i, count = table->type.count;
+    for (i = 0; i < count; i ++) {
+        ecs_id_t id = table->type.array[i];
+
+        /* Queries, observers and systems are not copied */
+        if (ECS_IS_PAIR(id) && ECS_PAIR_FIRST(id) == ecs_id(EcsPoly)) {
+            return false;
+        }
+
+        const ecs_id_record_t *idr = flecs_id_record_get(src, id);
+        if (idr && !flecs_clone_type_info_copyable(idr->type_info)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* An entity referenced by a copied table must either already exist in the
+ * destination world with the same id, or be copied itself. */
+static
+bool flecs_clone_entity_available(
+    const flecs_clone_t *clone,
+    uint32_t index)
+{
+    const ecs_world_t *src = clone->src;
+    ecs_entity_t e = flecs_entities_get_alive(src, index);
+    if (!e) {
+        return true;
+    }
+
+    ecs_entity_t dst_e = flecs_entities_get_alive(clone->dst, index);
+    if (dst_e) {
+        return dst_e == e;
+    }
+
+    const ecs_record_t *r = flecs_entities_get(src, e);
+    if (!r->table || !r->table->type.count) {
+        return true;
+    }
+
+    return flecs_clone_table_state(clone, r->table) != FlecsCloneSkip;
+}
+
+static
+bool flecs_clone_id_available(
+    const flecs_clone_t *clone,
+    ecs_id_t id)
+{
+    if (ECS_IS_PAIR(id)) {
+        return flecs_clone_entity_available(clone, ECS_PAIR_FIRST(id)) &&
+            flecs_clone_entity_available(clone, ECS_PAIR_SECOND(id));
+    }
+    return flecs_clone_entity_available(clone, (uint32_t)id);
+}
+
+/* Traits are registered by observers when the entity that has them is copied,
+ * so tables are copied after the tables of their components and relationships
+ * when possible. */
+static
+bool flecs_clone_table_ready(
+    const flecs_clone_t *clone,
+    const ecs_table_t *table)
+{
+    const ecs_world_t *src = clone->src;
+    int32_t i, count = table->type.count;
+    for (i = 0; i < count; i ++) {
+        ecs_id_t id = table->type.array[i];
+        uint64_t e = ECS_IS_PAIR(id) ? ECS_PAIR_FIRST(id) : (uint32_t)id;
+        if (!flecs_clone_is_pending(clone, e)) {
+            continue;
+        }
+
+        const ecs_record_t *r = flecs_entities_get_any(src, e);
+        const ecs_table_t *e_table = r->table;
+        if (e_table && e_table != table &&
+            flecs_clone_table_state(clone, e_table) == FlecsClonePending)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static
+void flecs_clone_row_extras(
+    flecs_clone_t *clone,
+    const ecs_table_t *table,
+    const ecs_flags32_t *id_flags,
+    ecs_entity_t e)
+{
+    ecs_world_t *dst = clone->dst;
+    const ecs_world_t *src = clone->src;
+    int32_t i, count = table->type.count;
+    for (i = 0; i < count; i ++) {
+        ecs_flags32_t flags = id_flags[i];
+        if (!flags) {
+            continue;
+        }
+
+        ecs_id_t id = table->type.array[i];
+        if (flags & FlecsCloneIdSparse) {
+            const ecs_type_info_t *ti = flecs_id_record_get(src, id)->type_info;
+            const void *ptr = ecs_get_id(src, e, id);
+            if (ti && ptr) {
+                ecs_set_id(dst, e, id, flecs_ito(size_t, ti->size), ptr);
+            }
+        }
+
+        if (flags & FlecsCloneIdUnion) {
+            ecs_entity_t rel = ECS_PAIR_FIRST(id);
+            ecs_entity_t tgt = ecs_get_target(src, e, rel, 0);
+            if (tgt && flecs_entities_get_alive(dst, tgt) == tgt) {
+                ecs_add_pair(dst, e, rel, tgt);
+            }
+        }
+
+        if (flags & FlecsCloneIdToggle) {
+            ecs_id_t toggled = id & ~ECS_TOGGLE;
+            ecs_enable_id(dst, e, toggled, ecs_is_enabled_id(src, e, toggled));
+        }
+    }
+}
+
+/* Slow path for entities that were added to a table by a side effect of
+ * copying another entity, like parents that become a module. */
+static
+void flecs_clone_entity(
+    flecs_clone_t *clone,
+    const ecs_table_t *table,
+    const ecs_flags32_t *id_flags,
+    int32_t row)
+{
+    ecs_world_t *dst = clone->dst;
+    ecs_entity_t e = ecs_table_entities(table)[row];
+    int32_t i, count = table->type.count;
+    for (i = 0; i < count; i ++) {
+        ecs_id_t id = table->type.array[i];
+        if (id_flags[i] & (FlecsCloneIdSparse|FlecsCloneIdUnion)) {
+            continue;
+        }
+
+        int32_t column = ecs_table_type_to_column_index(table, i);
+        if (column == -1) {
+            ecs_add_id(dst, e, id);
+        } else {
+            const ecs_column_t *c = &table->data.columns[column];
+            ecs_set_id(dst, e, id, flecs_ito(size_t, c->ti->size),
+                ECS_ELEM(c->data, c->ti->size, row));
+        }
+    }
+
+    flecs_clone_row_extras(clone, table, id_flags, e);
+}
+
+static
+void flecs_clone_table(
+    flecs_clone_t *clone,
+    const ecs_table_t *table)
+{
+    ecs_world_t *dst = clone->dst;
+    const ecs_world_t *src = clone->src;
+    int32_t count = ecs_table_count(table);
+    int32_t type_count = table->type.count;
+    if (!count || !type_count) {
+        return;
+    }
+
+    const ecs_entity_t *entities = ecs_table_entities(table);
+    ecs_flags32_t *id_flags = flecs_walloc_n(dst, ecs_flags32_t, type_count);
+    void **data = flecs_walloc_n(dst, void*, type_count);
+    bool has_extras = false;
+
+    /* Find the destination table and the ids that are added to it, in the
+     * same way as ecs_bulk_init. */
+    ecs_table_diff_builder_t diff = ECS_TABLE_DIFF_INIT;
+    flecs_table_diff_builder_init(dst, &diff);
+    ecs_table_t *dst_table = NULL;
+
+    int32_t i;
+    for (i = 0; i < type_count; i ++) {
+        ecs_id_t id = table->type.array[i];
+        dst_table = flecs_find_table_add(dst, dst_table, id, &diff);
+
+        ecs_flags32_t flags = 0;
+        const ecs_id_record_t *idr = flecs_id_record_get(src, id);
+        if (idr && (idr->flags & EcsIdIsSparse)) {
+            flags |= FlecsCloneIdSparse;
+        }
+        if (ECS_IS_PAIR(id) && ECS_PAIR_SECOND(id) == EcsUnion) {
+            flags |= FlecsCloneIdUnion;
+        }
+        if ((id & ECS_ID_FLAGS_MASK) == ECS_TOGGLE) {
+            flags |= FlecsCloneIdToggle;
+        }
+        id_flags[i] = flags;
+        has_extras |= flags != 0;
+    }
+
+    ecs_table_diff_t table_diff;
+    flecs_table_diff_build_noalloc(&diff, &table_diff);
+
+    int32_t row = 0;
+    while (row < count) {
+        if (!flecs_clone_is_pending(clone, entities[row])) {
+            row ++;
+            continue;
+        }
+
+        if (flecs_entities_get(dst, entities[row])->table) {
+            flecs_clone_entity(clone, table, id_flags, row);
+            row ++;
+            continue;
+        }
+
+        /* Copy consecutive rows that are not in the destination world yet in
+         * one operation, so that component values are copied per column. */
+        int32_t start = row;
+        do {
+            row ++;
+        } while (row < count &&
+            flecs_clone_is_pending(clone, entities[row]) &&
+            !flecs_entities_get(dst, entities[row])->table);
+
+        for (i = 0; i < type_count; i ++) {
+            int32_t column = ecs_table_type_to_column_index(table, i);
+            data[i] = column == -1 ? NULL :
+                ecs_table_get_column(table, column, start);
+        }
+
+        flecs_bulk_new(dst, dst_table, &entities[start],
+            ECS_CONST_CAST(ecs_type_t*, &table->type), row - start, data,
+            false, NULL, &table_diff);
+
+        if (has_extras) {
+            int32_t j;
+            for (j = start; j < row; j ++) {
+                flecs_clone_row_extras(clone, table, id_flags, entities[j]);
+            }
+        }
+    }
+
+    flecs_table_diff_builder_fini(dst, &diff);
+    flecs_wfree_n(dst, void*, type_count, data);
+    flecs_wfree_n(dst, ecs_flags32_t, type_count, id_flags);
+}
+
+/* Values of DontFragment components are not stored in tables */
+static
+void flecs_clone_dont_fragment(
+    flecs_clone_t *clone)
+{
+    ecs_world_t *dst = clone->dst;
+    const ecs_world_t *src = clone->src;
+    int32_t i, count = ecs_vec_count(&src->store.dont_fragment);
+    ecs_id_record_t **idrs = ecs_vec_first(&src->store.dont_fragment);
+    for (i = 0; i < count; i ++) {
+        const ecs_id_record_t *idr = idrs[i];
+        const ecs_type_info_t *ti = idr->type_info;
+        ecs_id_t id = idr->id;
+        if (!idr->sparse || !flecs_clone_type_info_copyable(ti)) {
+            continue;
+        }
+        if (flecs_entities_get_alive(dst, id) != id) {
+            continue;
+        }
+
+        int32_t j, value_count = flecs_sparse_count(idr->sparse);
+        const uint64_t *ids = flecs_sparse_ids(idr->sparse);
+        for (j = 0; j < value_count; j ++) {
+            ecs_entity_t e = ids[j];
+            if (!flecs_clone_is_pending(clone, e)) {
+                continue;
+            }
+
+            if (ti) {
+                const void *ptr = flecs_sparse_get_dense(
+                    idr->sparse, ti->size, j);
+                ecs_set_id(dst, e, id, flecs_ito(size_t, ti->size), ptr);
+            } else {
+                ecs_add_id(dst, e, id);
+            }
+        }
+    }
+}
+
+int ecs_world_clone_into(
+    ecs_world_t *dst,
+    const ecs_world_t *src)
+{
+    flecs_poly_assert(dst, ecs_world_t);
+    flecs_poly_assert(src, ecs_world_t);
+    ecs_check(dst != src, ECS_INVALID_PARAMETER,
+        "cannot clone world into itself");
+    ecs_check(!(dst->flags & EcsWorldReadonly), ECS_INVALID_OPERATION,
+        "cannot clone into world while it is in readonly mode");
+    ecs_check(!ecs_is_deferred(dst), ECS_INVALID_OPERATION,
+        "cannot clone into world while it is deferred");
+
+    flecs_clone_t clone = { .dst = dst, .src = src };
+    int32_t i, entity_count = flecs_entities_count(src);
+    const ecs_entity_t *entities = flecs_entities_ids(src);
+
+    uint32_t max_index = 0;
+    for (i = 0; i < entity_count; i ++) {
+        uint32_t index = (uint32_t)entities[i];
+        if (index > max_index) {
+            max_index = index;
+        }
+    }
+
+    clone.pending_words = flecs_uto(int32_t, (max_index >> 6) + 1);
+    clone.pending = flecs_wcalloc_n(dst, uint64_t, clone.pending_words);
+    ecs_map_init(&clone.tables, &dst->allocator);
+
+    /* Find tables that can be copied. A table can't be copied if it contains
+     * values that can't be copied, or if it references entities that are not
+     * copied and don't exist in the destination world. */
+    int32_t table_count = flecs_sparse_count(&src->store.tables);
+    for (i = 0; i < table_count; i ++) {
+        const ecs_table_t *table = flecs_sparse_get_dense_t(
+            &src->store.tables, ecs_table_t, i);
+        ecs_map_insert(&clone.tables, table->id,
+            flecs_clone_table_copyable(src, table)
+                ? FlecsClonePending : FlecsCloneSkip);
+    }
+
+    bool changed;
+    do {
+        changed = false;
+        for (i = 0; i < table_count; i ++) {
+            const ecs_table_t *table = flecs_sparse_get_dense_t(
+                &src->store.tables, ecs_table_t, i);
+            ecs_map_val_t *state = ecs_map_get(&clone.tables, table->id);
+            if (*state != FlecsClonePending) {
+                continue;
+            }
+
+            int32_t t;
+            for (t = 0; t < table->type.count; t ++) {
+                if (!flecs_clone_id_available(&clone, table->type.array[t])) {
+                    *state = FlecsCloneSkip;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    } while (changed);
+
+    /* Create the entities that are copied with the same ids as in src */
+    for (i = 0; i < entity_count; i ++) {
+        ecs_entity_t e = entities[i];
+        uint32_t index = (uint32_t)e;
+        if (flecs_entities_get_alive(dst, index)) {
+            continue;
+        }
+
+        const ecs_record_t *r = flecs_entities_get(src, e);
+        if (r->table &&
+            flecs_clone_table_state(&clone, r->table) == FlecsCloneSkip)
+        {
+            continue;
+        }
+
+        ecs_make_alive(dst, e);
+        clone.pending[index >> 6] |= 1ull << (index & 63);
+    }
+
+    /* Register type info of copied components before creating tables, so that
+     * tables that use a component before the component entity itself is
+     * copied have the correct storage. */
+    ecs_map_iter_t it = ecs_map_iter(&src->type_info);
+    while (ecs_map_next(&it)) {
+        ecs_entity_t component = ecs_map_key(&it);
+        const ecs_type_info_t *ti = ecs_map_ptr(&it);
+        if (!flecs_clone_is_pending(&clone, component)) {
+            continue;
+        }
+
+        /* Hooks share their context with the source world, which owns it */
+        ecs_type_hooks_t hooks = ti->hooks;
+        hooks.ctx_free = NULL;
+        hooks.binding_ctx_free = NULL;
+        hooks.lifecycle_ctx_free = NULL;
+        flecs_type_info_init_id(dst, component, ti->size, ti->alignment,
+            &hooks);
+    }
+
+    /* Copied entities are already instantiated, prevent adding an IsA pair
+     * from instantiating prefab children a second time. */
+    ecs_entity_t prev_base = dst->stages[0]->base;
+    dst->stages[0]->base = EcsIsA;
+
+    int32_t remaining = 0;
+    for (i = 0; i < table_count; i ++) {
+        const ecs_table_t *table = flecs_sparse_get_dense_t(
+            &src->store.tables, ecs_table_t, i);
+        remaining += flecs_clone_table_state(&clone, table) == FlecsClonePending;
+    }
+
+    /* Tables are copied in the order in which they were created, after the
+     * tables of the entities they depend on. Cycles are broken by copying the
+     * oldest table first. */
+    bool force = false;
+    while (remaining) {
+        bool progress = false;
+        for (i = 0; i < table_count; i ++) {
+            const ecs_table_t *table = flecs_sparse_get_dense_t(
+                &src->store.tables, ecs_table_t, i);
+            ecs_map_val_t *state = ecs_map_get(&clone.tables, table->id);
+            if (*state != FlecsClonePending) {
+                continue;
+            }
+            if (!force && !flecs_clone_table_ready(&clone, table)) {
+                continue;
+            }
+
+            *state = FlecsCloneCopied;
+            flecs_clone_table(&clone, table);
+            remaining --;
+            progress = true;
+            force = false;
+        }
+        force = !progress;
+    }
+
+    flecs_clone_dont_fragment(&clone);
+
+    dst->stages[0]->base = prev_base;
+
+    /* Component ids of language bindings */
+    int32_t id_count = ecs_vec_count(&src->component_ids);
+    const ecs_entity_t *ids = ecs_vec_first(&src->component_ids);
+    for (i = 0; i < id_count; i ++) {
+        ecs_entity_t component = ids[i];
+        if (!component || flecs_component_ids_get(dst, i)) {
+            continue;
+        }
+        if (flecs_entities_get_alive(dst, component) == component) {
+            flecs_component_ids_set(dst, i, component);
+        }
+    }
+
+    if (src->info.last_component_id > dst->info.last_component_id) {
+        dst->info.last_component_id = src->info.last_component_id;
+    }
+
+    ecs_map_fini(&clone.tables);
+    flecs_wfree_n(dst, uint64_t, clone.pending_words, clone.pending);
+
+    return 0;
+error:
+    return -1;
+}
+
+ecs_world_t* ecs_world_clone(
+    const ecs_world_t *src)
+{
+    flecs_poly_assert(src, ecs_world_t);
+
+    ecs_world_t *world = ecs_init();
+    if (ecs_world_clone_into(world, src)) {
+        ecs_fini(world);
+        return NULL;
+    }
+
+    return world;
+}
+
 static
 void flecs_check_component(
     ecs_world_t *world,
@@ -2314,6 +2999,26 @@ error:
     return NULL;
 }
 
+const ecs_entity_t* ecs_instantiate_n(
+    ecs_world_t *world,
+    ecs_entity_t prefab,
+    int32_t count)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(count >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(ecs_is_alive(world, prefab), ECS_INVALID_PARAMETER, NULL);
+
+    if (!count) {
+        return NULL;
+    }
+
+    /* Instances are created in a single table, which instantiates the prefab
+     * hierarchy for all instances in a single call to flecs_instantiate. */
+    return ecs_bulk_new_w_id(world, ecs_isa(prefab), count);
+error:
+    return NULL;
+}
+
 void ecs_clear(
     ecs_world_t *world,
     ecs_entity_t entity)
@@ -2329,6 +3034,8 @@ void ecs_clear(
     ecs_record_t *r = flecs_entities_get(world, entity);
     ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    flecs_dont_fragment_clear(world, entity, r);
+
     ecs_table_t *table = r->table;
     if (table) {
         ecs_table_diff_t diff = {
@@ -2516,9 +3223,15 @@ void flecs_id_mark_for_delete(
 
     idr->flags |= EcsIdMarkedForDelete;
     flecs_marked_id_push(world, idr, action, delete_id);
+}
 
+static
+void flecs_id_mark_tables_for_delete(
+    ecs_world_t *world,
+    ecs_id_record_t *idr,
+    ecs_entity_t action)
+{
     const ecs_id_t id = idr->id;
-
     bool delete_target = flecs_id_is_delete_target(id, action);
 
     /* Mark all tables with the id for delete */
@@ -2534,12 +3247,11 @@ void flecs_id_mark_for_delete(
             const ecs_entity_t cur_action = flecs_get_delete_action(table, tr, action,
                                                                     delete_target);
 
-            /* If this is a Delete action, recursively mark ids & tables */
+            /* If this is a Delete action, mark ids of deleted entities. Their
+             * tables are marked after the tables of the current level. */
             if (cur_action == EcsDelete) {
                 table->flags |= EcsTableMarkedForDelete;
-                ecs_log_push_2();
                 flecs_targets_mark_for_delete(world, table);
-                ecs_log_pop_2();
             } else if (cur_action == EcsPanic) {
                 flecs_throw_invalid_delete(world, id);
             }
@@ -2603,8 +3315,20 @@ bool flecs_on_delete_mark(
         return false;
     }
 
+    int32_t i = ecs_vec_count(&world->store.marked_ids);
     flecs_id_mark_for_delete(world, idr, action, delete_id);
 
+    /* Mark tables breadth first. Marking the tables of an id appends the ids
+     * of entities in deleted tables to marked_ids, which are visited after the
+     * current level. This keeps the stack depth constant for deep hierarchies
+     * and stores ids in level order, so that clearing them in reverse deletes
+     * hierarchies bottom to top. */
+    for (; i < ecs_vec_count(&world->store.marked_ids); i ++) {
+        const ecs_marked_id_t *m = ecs_vec_get_t(
+            &world->store.marked_ids, ecs_marked_id_t, i);
+        flecs_id_mark_tables_for_delete(world, m->idr, m->action);
+    }
+
     return true;
 }
 
@@ -2668,7 +3392,8 @@ void flecs_remove_from_table(
 
 static
 bool flecs_on_delete_clear_tables(
-    ecs_world_t *world)
+    ecs_world_t *world,
+    bool defer_dtor)
 {
     /* Iterate in reverse order so that DAGs get deleted bottom to top */
     int32_t last = ecs_vec_count(&world->store.marked_ids), first = 0;
@@ -2694,7 +3419,8 @@ bool flecs_on_delete_clear_tables(
                             ecs_dbg_3(
                                 "#[red]delete#[reset] entities from table %u", 
                                 (uint32_t)table->id);
-                            flecs_table_delete_entities(world, table);
+                            flecs_table_delete_entities(
+                                world, table, defer_dtor);
                         }
                     }
                 }
@@ -2778,6 +3504,136 @@ bool flecs_on_delete_clear_ids(
     return true;
 }
 
+/* Minimum number of components destructed per stage */
+#define FLECS_DELETE_DTOR_MIN_PER_STAGE (4096)
+
+typedef struct flecs_delete_dtor_job_t {
+    const ecs_deleted_column_t *columns;
+    int32_t column;                  /* First column */
+    int32_t row;                     /* First row in first column */
+    int32_t count;                   /* Number of components to destruct */
+} flecs_delete_dtor_job_t;
+
+typedef struct flecs_delete_dtor_jobs_t {
+    const flecs_delete_dtor_job_t *jobs;
+    int32_t count;
+} flecs_delete_dtor_jobs_t;
+
+static
+void flecs_delete_dtor_job(
+    const flecs_delete_dtor_job_t *job)
+{
+    const ecs_deleted_column_t *columns = job->columns;
+    int32_t c = job->column, row = job->row, remaining = job->count;
+
+    while (remaining) {
+        const ecs_deleted_column_t *dc = &columns[c ++];
+        const ecs_type_info_t *ti = dc->ti;
+        int32_t count = dc->count - row;
+        if (count > remaining) {
+            count = remaining;
+        }
+
+        ti->hooks.dtor(ECS_ELEM(dc->data, ti->size, row), count, ti);
+        remaining -= count;
+        row = 0;
+    }
+}
+
+#ifdef FLECS_PIPELINE
+/* Each stage runs the job with its stage id */
+static
+void flecs_delete_dtor_stage_job(
+    ecs_stage_t *stage,
+    void *ctx)
+{
+    const flecs_delete_dtor_jobs_t *jobs = ctx;
+    if (stage->id < jobs->count) {
+        flecs_delete_dtor_job(&jobs->jobs[stage->id]);
+    }
+}
+#endif
+
+/* Destruct & free storage of tables deleted by the cleanup action. Only
+ * components with thread safe destructors end up here. Destructors are split
+ * up between the calling thread and the worker stages if the workers are idle.
+ * Freeing happens on the calling thread, as the storage was allocated with the
+ * world allocator. */
+static
+void flecs_on_delete_dtor_columns(
+    ecs_world_t *world)
+{
+    int32_t i, count = ecs_vec_count(&world->store.deleted_columns);
+    if (!count) {
+        return;
+    }
+
+    ecs_deleted_column_t *columns = ecs_vec_first(&world->store.deleted_columns);
+    int32_t total = 0;
+    for (i = 0; i < count; i ++) {
+        total += columns[i].count;
+    }
+
+    ecs_os_perf_trace_push("flecs.delete.dtor");
+
+    int32_t job_count = world->stage_count;
+    if ((total / FLECS_DELETE_DTOR_MIN_PER_STAGE) < job_count) {
+        job_count = total / FLECS_DELETE_DTOR_MIN_PER_STAGE;
+    }
+
+    bool done = false;
+#ifdef FLECS_PIPELINE
+    if (job_count > 1) {
+        /* Split components evenly across jobs. Jobs can span multiple
+         * columns, and a column can be split up between jobs. */
+        flecs_delete_dtor_job_t *jobs = flecs_walloc_n(
+            world, flecs_delete_dtor_job_t, job_count);
+        int32_t per_job = total / job_count, column = 0, row = 0;
+
+        for (i = 0; i < job_count; i ++) {
+            int32_t job_total = per_job;
+            if (i == job_count - 1) {
+                job_total = total - per_job * (job_count - 1);
+            }
+
+            jobs[i] = (flecs_delete_dtor_job_t){ columns, column, row, job_total };
+
+            /* Find start of next job */
+            while (job_total) {
+                int32_t available = columns[column].count - row;
+                if (available > job_total) {
+                    row += job_total;
+                    break;
+                }
+
+                job_total -= available;
+                column ++;
+                row = 0;
+            }
+        }
+
+        flecs_delete_dtor_jobs_t ctx = { jobs, job_count };
+        done = flecs_workers_run(world, flecs_delete_dtor_stage_job, &ctx);
+
+        flecs_wfree_n(world, flecs_delete_dtor_job_t, job_count, jobs);
+    }
+#endif
+
+    if (!done) {
+        flecs_delete_dtor_job_t job = { columns, 0, 0, total };
+        flecs_delete_dtor_job(&job);
+    }
+
+    for (i = 0; i < count; i ++) {
+        ecs_deleted_column_t *dc = &columns[i];
+        flecs_free(&world->allocator, dc->ti->size * dc->size, dc->data);
+    }
+
+    ecs_vec_clear(&world->store.deleted_columns);
+
+    ecs_os_perf_trace_pop("flecs.delete.dtor");
+}
+
 static
 void flecs_on_delete(
     ecs_world_t *world,
@@ -2801,8 +3657,14 @@ void flecs_on_delete(
         ecs_dbg_2("#[red]delete#[reset]");
         ecs_log_push_2();
 
-        /* Empty tables with all the to be deleted ids */
-        flecs_on_delete_clear_tables(world);
+        /* Empty tables with all the to be deleted ids. When threaded dtors
+         * are enabled, thread safe destructors run after all tables are
+         * cleared so they can be split up between worker stages. */
+        flecs_on_delete_clear_tables(world, 
+            ECS_BIT_IS_SET(world->flags, EcsWorldThreadedDtors));
+
+        /* Destruct storage of deleted tables */
+        flecs_on_delete_dtor_columns(world);
 
         /* All marked tables are empty, ensure they're in the right list */
         ecs_run_aperiodic(world, EcsAperiodicEmptyTables);
@@ -2908,6 +3770,9 @@ void ecs_delete(
                     flecs_table_traversable_add(table, -1);
                 }
             }
+            if (row_flags & EcsEntityHasDontFragment) {
+                flecs_dont_fragment_clear(world, entity, r);
+            }
             /* Merge operations before deleting entity */
             flecs_defer_end(world, stage);
             flecs_defer_begin(world, stage);
@@ -3070,6 +3935,13 @@ const void* ecs_get_id(
     const ecs_record_t *r = flecs_entities_get(world, entity);
     ecs_assert(r != NULL, ECS_INVALID_PARAMETER, NULL);
 
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            return flecs_dont_fragment_try(idr, entity);
+        }
+    }
+
     ecs_table_t *table = r->table;
     if (!table) {
         return NULL;
@@ -3116,6 +3988,13 @@ void* ecs_get_mut_id(
     const ecs_record_t *r = flecs_entities_get(world, entity);
     ecs_assert(r != NULL, ECS_INVALID_PARAMETER, NULL);
 
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            return flecs_dont_fragment_try(idr, entity);
+        }
+    }
+
     ecs_table_t *table = r->table;
     if (!table) {
         return NULL;
@@ -3432,6 +4311,18 @@ void* ecs_emplace_id(
         "cannot emplace a component the entity already has");
 
     ecs_record_t *r = flecs_entities_get(world, entity);
+
+    ecs_id_record_t *df_idr = flecs_dont_fragment_get(world, id);
+    if (df_idr) {
+        void *df_ptr = flecs_dont_fragment_ensure(
+            world, entity, r, df_idr, false /* Add without ctor */, is_new);
+        flecs_defer_end(world, stage);
+        ecs_check(df_ptr != NULL, ECS_INVALID_PARAMETER, 
+            "emplaced component was removed during operation, make sure to not "
+            "remove component T in on_add(T) hook/OnAdd(T) observer");
+        return df_ptr;
+    }
+
     const ecs_table_t *table = r->table;
     flecs_add_id_w_record(world, entity, r, id, false /* Add without ctor */);
     flecs_defer_end(world, stage);
@@ -3468,9 +4359,20 @@ void flecs_modified_id_if(
         return;
     }
 
-    const ecs_record_t *r = flecs_entities_get(world, entity);
+    ecs_record_t *r = flecs_entities_get(world, entity);
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            if (flecs_dont_fragment_try(idr, entity)) {
+                flecs_dont_fragment_on_set(world, entity, r, idr);
+            }
+            flecs_defer_end(world, stage);
+            return;
+        }
+    }
+
     ecs_table_t *table = r->table;
-    if (!flecs_table_record_get(world, table, id)) {
+    if (!table || !flecs_table_record_get(world, table, id)) {
         flecs_defer_end(world, stage);
         return;
     }
@@ -3505,7 +4407,16 @@ void ecs_modified_id(
      * operations are being deferred. */
     ecs_check(ecs_has_id(world, entity, id), ECS_INVALID_PARAMETER, NULL);
 
-    const ecs_record_t *r = flecs_entities_get(world, entity);
+    ecs_record_t *r = flecs_entities_get(world, entity);
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            flecs_dont_fragment_on_set(world, entity, r, idr);
+            flecs_defer_end(world, stage);
+            return;
+        }
+    }
+
     ecs_table_t *table = r->table;
     ecs_type_t ids = { .array = &id, .count = 1 };
     flecs_notify_on_set(world, table, ECS_RECORD_TO_ROW(r->row), 1, &ids, true);
@@ -3534,7 +4445,7 @@ void flecs_set_id_copy(
     ecs_record_t *r = flecs_entities_get(world, entity);
     const flecs_component_ptr_t dst = flecs_ensure(world, entity, id, r);
 
-    flecs_copy_id(world, r, id, size, dst.ptr, ptr, dst.ti);
+    flecs_copy_id(world, entity, r, id, size, dst.ptr, ptr, dst.ti);
 
     flecs_defer_end(world, stage);
 }
@@ -3574,6 +4485,17 @@ void flecs_set_id_move(
         ecs_os_memcpy(dst.ptr, ptr, flecs_utosize(size));
     }
 
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            if (cmd_kind == EcsCmdSet) {
+                flecs_dont_fragment_on_set(world, entity, r, idr);
+            }
+            flecs_defer_end(world, stage);
+            return;
+        }
+    }
+
     flecs_table_mark_dirty(world, r->table, id);
 
     if (cmd_kind == EcsCmdSet) {
@@ -3717,6 +4639,14 @@ bool ecs_has_id(
 
     const ecs_record_t *r = flecs_entities_get_any(world, entity);
     ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            return flecs_dont_fragment_try(idr, entity) != NULL;
+        }
+    }
+
     ecs_table_t *table = r->table;
     if (!table) {
         return false;
@@ -3775,6 +4705,14 @@ bool ecs_owns_id(
 
     const ecs_record_t *r = flecs_entities_get_any(world, entity);
     ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (r->row & EcsEntityHasDontFragment) {
+        ecs_id_record_t *idr = flecs_dont_fragment_get(world, id);
+        if (idr) {
+            return flecs_dont_fragment_try(idr, entity) != NULL;
+        }
+    }
+
     ecs_table_t *table = r->table;
     if (!table) {
         return false;
@@ -4620,9 +5558,32 @@ void flecs_flush_bulk_new(
 
     if (cmd->id) {
         const int count = cmd->is._n.count;
+        bool is_empty = true;
         for (int i = 0; i < count; i ++) {
-            flecs_entities_ensure(world, entities[i]);
-            flecs_add_id(world, entities[i], cmd->id);
+            ecs_record_t *r = flecs_entities_ensure(world, entities[i]);
+            if (r->table) {
+                is_empty = false;
+            }
+        }
+
+        if (is_empty) {
+            /* Entities are not stored in a table yet, which is the case unless
+             * a command for one of the entities was flushed before this one.
+             * Add them in bulk, so that (IsA, prefab) instantiates the prefab
+             * hierarchy once for all entities. */
+            ecs_table_diff_builder_t diff = ECS_TABLE_DIFF_INIT;
+            flecs_table_diff_builder_init(world, &diff);
+            ecs_table_t *table = flecs_find_table_add(
+                world, &world->store.root, cmd->id, &diff);
+            ecs_table_diff_t td;
+            flecs_table_diff_build_noalloc(&diff, &td);
+            flecs_bulk_new(world, table, entities, NULL, count, NULL, false, 
+                NULL, &td);
+            flecs_table_diff_builder_fini(world, &diff);
+        } else {
+            for (int i = 0; i < count; i ++) {
+                flecs_add_id(world, entities[i], cmd->id);
+            }
         }
     }
 
@@ -4785,6 +5746,38 @@ ecs_table_t* flecs_cmd_batch_add_diff(
     return dst;
 }
 
+/* Clear DontFragment components of an entity when a batch contains a clear.
+ * Since commands for DontFragment components are not batched, commands that
+ * were queued before the clear must be discarded so they don't run after it. */
+static
+void flecs_cmd_batch_clear_dont_fragment(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r,
+    ecs_cmd_t *cmds,
+    int32_t start,
+    int32_t clear)
+{
+    if (!ecs_vec_count(&world->store.dont_fragment)) {
+        return;
+    }
+
+    int32_t cur = start;
+    while (cur != clear) {
+        ecs_cmd_t *cmd = &cmds[cur];
+        if (cmd->id && flecs_dont_fragment_get(world, cmd->id)) {
+            cmd->kind = EcsCmdSkip;
+        }
+
+        cur = cmd->next_for_entity;
+        if (cur < 0) {
+            cur *= -1;
+        }
+    }
+
+    flecs_dont_fragment_clear(world, entity, r);
+}
+
 static
 void flecs_cmd_batch_for_entity(
     ecs_world_t *world,
@@ -4839,6 +5832,12 @@ void flecs_cmd_batch_for_entity(
                 flecs_table_diff_builder_clear(diff);
                 return;
             }
+
+            /* DontFragment components don't change the table of the entity,
+             * so commands for them are not batched and run in queue order. */
+            if (flecs_dont_fragment_get(world, id)) {
+                continue;
+            }
         }
 
         const ecs_cmd_kind_t kind = cmd->kind;
@@ -4935,6 +5934,10 @@ void flecs_cmd_batch_for_entity(
                 diff->removed_flags |= table->flags & EcsTableRemoveEdgeFlags;
             }
             table = &world->store.root;
+            if (r) {
+                flecs_cmd_batch_clear_dont_fragment(world, entity, r, cmds, 
+                    start, cur);
+            }
             world->info.cmd.batched_command_count ++;
             break;
         case EcsCmdClone:
@@ -4997,6 +6000,11 @@ void flecs_cmd_batch_for_entity(
             switch(cmd->kind) {
             case EcsCmdSet:
             case EcsCmdEnsure: {
+                /* DontFragment commands weren't batched */
+                if (flecs_dont_fragment_get(world, cmd->id)) {
+                    break;
+                }
+
                 flecs_component_ptr_t ptr = {0};
                 if (r->table) {
                     ecs_id_record_t *idr = flecs_id_record_get(world, cmd->id);
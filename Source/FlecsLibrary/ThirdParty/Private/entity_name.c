@@ -310,6 +310,235 @@ ecs_entity_t flecs_get_parent_from_path(
     return parent;
 }
 
+/* Path cache element. The key (path, separator and prefix) is stored after the
+ * element so that string lookups can verify a cache hit. */
+typedef struct ecs_path_cache_elem_t {
+    ecs_entity_t entity;
+    ecs_size_t size;
+    ecs_size_t sep_offset;
+    ecs_size_t prefix_offset;    /* 0 if lookup had no prefix */
+} ecs_path_cache_elem_t;
+
+static
+uint64_t flecs_path_hash_combine(
+    uint64_t hash,
+    const char *str)
+{
+    uint64_t str_hash = flecs_hash(str, ecs_os_strlen(str));
+    return hash ^ (str_hash + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2));
+}
+
+static
+bool flecs_path_cache_stage_is_enabled(
+    const ecs_world_t *stage)
+{
+    if (ecs_get_scope(stage)) {
+        return false;
+    }
+
+    /* Bypass the cache when the application set a lookup path. The default
+     * lookup path only contains flecs.core. */
+    const ecs_entity_t *lookup_path = ecs_get_lookup_path(stage);
+    if (lookup_path && lookup_path[0] && 
+        (lookup_path[0] != EcsFlecsCore || lookup_path[1])) 
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static
+bool flecs_path_cache_is_enabled(
+    const ecs_world_t *stage,
+    ecs_entity_t parent,
+    const char *path,
+    const char *sep)
+{
+    /* Only lookups that start from the root are cached, as relative lookups
+     * depend on the scope and lookup path. */
+    if (parent || !sep[0] || !flecs_path_cache_stage_is_enabled(stage)) {
+        return false;
+    }
+
+    /* Don't cache lookups by id, these don't depend on entity names */
+    if (strchr(path, '#')) {
+        return false;
+    }
+
+    return true;
+}
+
+static
+ecs_entity_t flecs_path_cache_get(
+    const ecs_world_t *world,
+    uint64_t hash,
+    const char *path,
+    const char *sep,
+    const char *prefix)
+{
+    ecs_path_cache_elem_t *elem = ecs_map_get_deref(
+        &world->path_cache, ecs_path_cache_elem_t, hash);
+    if (!elem) {
+        return 0;
+    }
+
+    if (path) {
+        /* Verify that the cached key matches the lookup */
+        const char *key = ECS_OFFSET_T(elem, ecs_path_cache_elem_t);
+        if (ecs_os_strcmp(key, path)) {
+            return 0;
+        }
+        if (ecs_os_strcmp(&key[elem->sep_offset], sep)) {
+            return 0;
+        }
+        if (!prefix != !elem->prefix_offset) {
+            return 0;
+        }
+        if (prefix && ecs_os_strcmp(&key[elem->prefix_offset], prefix)) {
+            return 0;
+        }
+    }
+
+    if (!ecs_is_alive(world, elem->entity)) {
+        return 0;
+    }
+
+    return elem->entity;
+}
+
+static
+void flecs_path_cache_insert(
+    ecs_world_t *world,
+    uint64_t hash,
+    const char *path,
+    const char *sep,
+    const char *prefix,
+    ecs_entity_t entity)
+{
+    /* Lookups can happen from multiple threads in readonly mode */
+    if (world->flags & (EcsWorldReadonly|EcsWorldMultiThreaded)) {
+        return;
+    }
+
+    ecs_size_t path_len = ecs_os_strlen(path) + 1;
+    ecs_size_t sep_len = ecs_os_strlen(sep) + 1;
+    ecs_size_t prefix_len = prefix ? ecs_os_strlen(prefix) + 1 : 0;
+    ecs_size_t size = ECS_SIZEOF(ecs_path_cache_elem_t) + 
+        path_len + sep_len + prefix_len;
+
+    ecs_path_cache_elem_t **ptr = (ecs_path_cache_elem_t**)ecs_map_ensure(
+        &world->path_cache, hash);
+    ecs_path_cache_elem_t *elem = ptr[0];
+    if (elem && elem->size != size) {
+        flecs_free(&world->allocator, elem->size, elem);
+        elem = NULL;
+    }
+    if (!elem) {
+        elem = ptr[0] = flecs_alloc(&world->allocator, size);
+    }
+
+    char *key = ECS_OFFSET_T(elem, ecs_path_cache_elem_t);
+    ecs_os_memcpy(key, path, path_len);
+    ecs_os_memcpy(&key[path_len], sep, sep_len);
+    if (prefix) {
+        ecs_os_memcpy(&key[path_len + sep_len], prefix, prefix_len);
+    }
+
+    elem->entity = entity;
+    elem->size = size;
+    elem->sep_offset = path_len;
+    elem->prefix_offset = prefix ? path_len + sep_len : 0;
+
+    /* Register the entity and its parents, so that a name or parent change
+     * only invalidates the paths that resolve through the changed entity. */
+    ecs_entity_t cur = entity;
+    do {
+        ecs_map_ensure(&world->path_cache_refs, cur);
+    } while ((cur = ecs_get_target(world, cur, EcsChildOf, 0)));
+}
+
+static
+bool flecs_path_cache_elem_has_ref(
+    const ecs_world_t *world,
+    const ecs_path_cache_elem_t *elem,
+    ecs_entity_t entity)
+{
+    ecs_entity_t cur = elem->entity;
+    if (!ecs_is_alive(world, cur)) {
+        return true;
+    }
+
+    do {
+        if (cur == entity) {
+            return true;
+        }
+    } while ((cur = ecs_get_target(world, cur, EcsChildOf, 0)));
+
+    return false;
+}
+
+void flecs_path_cache_remove(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    if (!ecs_map_get(&world->path_cache_refs, entity)) {
+        return;
+    }
+
+    ecs_map_remove(&world->path_cache_refs, entity);
+
+    ecs_allocator_t *a = &world->allocator;
+    ecs_vec_t keys;
+    ecs_vec_init_t(a, &keys, ecs_map_key_t, 0);
+
+    ecs_map_iter_t it = ecs_map_iter(&world->path_cache);
+    while (ecs_map_next(&it)) {
+        ecs_path_cache_elem_t *elem = ecs_map_ptr(&it);
+        if (flecs_path_cache_elem_has_ref(world, elem, entity)) {
+            flecs_free(a, elem->size, elem);
+            ecs_vec_append_t(a, &keys, ecs_map_key_t)[0] = ecs_map_key(&it);
+        }
+    }
+
+    int32_t i, count = ecs_vec_count(&keys);
+    ecs_map_key_t *key_array = ecs_vec_first(&keys);
+    for (i = 0; i < count; i ++) {
+        ecs_map_remove(&world->path_cache, key_array[i]);
+    }
+
+    ecs_vec_fini_t(a, &keys, ecs_map_key_t);
+
+    if (!ecs_map_count(&world->path_cache)) {
+        ecs_map_clear(&world->path_cache_refs);
+    }
+}
+
+void flecs_path_cache_clear(
+    ecs_world_t *world)
+{
+    if (!ecs_map_count(&world->path_cache)) {
+        return;
+    }
+
+    ecs_map_iter_t it = ecs_map_iter(&world->path_cache);
+    while (ecs_map_next(&it)) {
+        ecs_path_cache_elem_t *elem = ecs_map_ptr(&it);
+        flecs_free(&world->allocator, elem->size, elem);
+    }
+
+    ecs_map_clear(&world->path_cache);
+    ecs_map_clear(&world->path_cache_refs);
+}
+
+void flecs_path_cache_fini(
+    ecs_world_t *world)
+{
+    flecs_path_cache_clear(world);
+    ecs_map_fini(&world->path_cache);
+    ecs_map_fini(&world->path_cache_refs);
+}
+
 static inline
 void flecs_on_set_symbol(ecs_iter_t *it) {
     const EcsIdentifier *n = ecs_field(it, EcsIdentifier, 0);
@@ -456,39 +685,24 @@ error:
     return 0;
 }
 
-ecs_entity_t ecs_lookup_path_w_sep(
-    const ecs_world_t *world,
+static
+ecs_entity_t flecs_lookup_path_w_sep(
+    const ecs_world_t *stage,
     ecs_entity_t parent,
     const char *path,
     const char *sep,
     const char *prefix,
-    bool recursive)
+    bool recursive,
+    uint64_t hash)
 {
-    if (!path) {
-        return 0;
-    }
-
-    ecs_check(world != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_check(!parent || ecs_is_valid(world, parent), 
-        ECS_INVALID_PARAMETER, NULL);
-    const ecs_world_t *stage = world;
-    world = ecs_get_world(world);
-
-    ecs_entity_t e = flecs_get_builtin(path);
-    if (e) {
-        return e;
-    }
+    ecs_world_t *world = ECS_CONST_CAST(ecs_world_t*, ecs_get_world(stage));
 
-    e = flecs_name_index_find(&world->aliases, path, 0, 0);
-    if (e) {
-        return e;
-    }
-    
     ecs_os_perf_trace_push("flecs.entity_name.lookup_path");
 
     char buff[ECS_NAME_BUFFER_LENGTH], *elem = buff;
     int32_t size = ECS_NAME_BUFFER_LENGTH;
     bool lookup_path_search = false;
+    const char *lookup = path;
 
     const ecs_entity_t *lookup_path = ecs_get_lookup_path(stage);
     const ecs_entity_t *lookup_path_cur = lookup_path;
@@ -496,10 +710,6 @@ ecs_entity_t ecs_lookup_path_w_sep(
         lookup_path_cur ++;
     }
 
-    if (!sep) {
-        sep = ".";
-    }
-
     bool error = false;
     parent = flecs_get_parent_from_path(
         stage, parent, &path, sep, prefix, true, &error);
@@ -535,6 +745,9 @@ retry:
 
 tail:
     if (!cur && recursive) {
+        /* Result depends on scope & lookup path, so it can't be cached */
+        hash = 0;
+
         if (!lookup_path_search) {
             if (parent) {
                 parent = ecs_get_target(world, parent, EcsChildOf, 0);
@@ -557,10 +770,127 @@ tail:
         ecs_os_free(elem);
     }
 
+    if (cur && hash) {
+        flecs_path_cache_insert(world, hash, lookup, sep, prefix, cur);
+    }
+
     ecs_os_perf_trace_pop("flecs.entity_name.lookup_path");
     return cur;
+}
+
+ecs_entity_t ecs_lookup_path_w_sep(
+    const ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *path,
+    const char *sep,
+    const char *prefix,
+    bool recursive)
+{
+    if (!path) {
+        return 0;
+    }
+
+    ecs_check(world != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_check(!parent || ecs_is_valid(world, parent), 
+        ECS_INVALID_PARAMETER, NULL);
+    const ecs_world_t *stage = world;
+    world = ecs_get_world(world);
+
+    ecs_entity_t e = flecs_get_builtin(path);
+    if (e) {
+        return e;
+    }
+
+    e = flecs_name_index_find(&world->aliases, path, 0, 0);
+    if (e) {
+        return e;
+    }
+
+    if (!sep) {
+        sep = ".";
+    }
+
+    uint64_t hash = 0;
+    if (flecs_path_cache_is_enabled(stage, parent, path, sep)) {
+        hash = ecs_path_hash(path, sep, prefix);
+        e = flecs_path_cache_get(world, hash, path, sep, prefix);
+        if (e) {
+            return e;
+        }
+    }
+
+    return flecs_lookup_path_w_sep(
+        stage, parent, path, sep, prefix, recursive, hash);
+error:
+    return 0;
+}
+
+uint64_t ecs_path_hash(
+    const char *path,
+    const char *sep,
+    const char *prefix)
+{
+    ecs_check(path != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    uint64_t hash = flecs_hash(path, ecs_os_strlen(path));
+    if (sep && ecs_os_strcmp(sep, ".")) {
+        hash = flecs_path_hash_combine(hash, sep);
+    }
+    if (prefix) {
+        hash = flecs_path_hash_combine(hash, prefix);
+    }
+
+    return hash;
+error:
+    return 0;
+}
+
+ecs_entity_t ecs_lookup_hashed(
+    const ecs_world_t *world,
+    uint64_t hash,
+    const char *path,
+    const char *sep,
+    const char *prefix)
+{
+    ecs_check(world != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_check(hash != 0, ECS_INVALID_PARAMETER, NULL);
+    const ecs_world_t *stage = world;
+    world = ecs_get_world(world);
+
+    /* A cache hit resolves from the root, which doesn't match the result of a
+     * lookup relative to a scope or lookup path. */
+    ecs_entity_t e = 0;
+    if (flecs_path_cache_stage_is_enabled(stage)) {
+        e = flecs_path_cache_get(world, hash, NULL, NULL, NULL);
+    }
+
+    if (e || !path) {
+        return e;
+    }
+
+    e = flecs_get_builtin(path);
+    if (e) {
+        return e;
+    }
+
+    e = flecs_name_index_find(&world->aliases, path, 0, 0);
+    if (e) {
+        return e;
+    }
+
+    if (!sep) {
+        sep = ".";
+    }
+
+    ecs_assert(hash == ecs_path_hash(path, sep, prefix), 
+        ECS_INVALID_PARAMETER, "hash does not match path");
+
+    if (!flecs_path_cache_is_enabled(stage, 0, path, sep)) {
+        hash = 0;
+    }
+
+    return flecs_lookup_path_w_sep(stage, 0, path, sep, prefix, true, hash);
 error:
-    ecs_os_perf_trace_pop("flecs.entity_name.lookup_path");
     return 0;
 }
 
@@ -191,7 +191,12 @@ void* ecs_field_at_w_size(
 
     ecs_entity_t src = it->sources[index];
     if (!src) {
-        src = ecs_table_entities(it->table)[row + it->offset];
+        if (it->table) {
+            src = ecs_table_entities(it->table)[row + it->offset];
+        } else {
+            /* Entity without table matched by a DontFragment component */
+            src = it->entities[row];
+        }
     }
 
     ecs_os_perf_trace_pop("flecs.field.at_w_size");
@@ -430,6 +430,11 @@ void flecs_emit_propagate_invalidate(
         if (idr_t) {
             /* Event is used as target in traversable relationship, propagate */
             flecs_emit_propagate_invalidate_tables(world, idr_t);
+
+            /* Invalidate up traversal results that are shared by queries */
+            if (ecs_map_count(&world->trav_up_cache)) {
+                flecs_trav_up_cache_invalidate(world, idr_t);
+            }
         }
     }
 }
@@ -1370,6 +1375,10 @@ repeat_event:
 
         ecs_assert(idr != NULL, ECS_INTERNAL_ERROR, NULL);
         ecs_table_record_t *tr = flecs_id_record_get_table(idr, table);
+        if (tr == NULL && idr->dont_fragment_tr) {
+            /* DontFragment components are not stored in the table */
+            tr = idr->dont_fragment_tr;
+        }
         if (tr == NULL) {
             /* When a single batch contains multiple add's for an exclusive
              * relationship, it's possible that an id was in the added list
@@ -9,6 +9,7 @@
 #include "private_types.h"
 #include "storage/table_cache.h"
 #include "storage/id_index.h"
+#include "storage/dont_fragment.h"
 #include "query/query.h"
 #include "observable.h"
 #include "iter.h"
@@ -239,6 +240,20 @@ bool flecs_name_is_id(
 ecs_entity_t flecs_name_to_id(
     const char *name);
 
+/* Clear cached path lookups */
+void flecs_path_cache_clear(
+    ecs_world_t *world);
+
+/* Remove cached path lookups that resolve through an entity. Called when the
+ * name or parent of a named entity changes. */
+void flecs_path_cache_remove(
+    ecs_world_t *world,
+    ecs_entity_t entity);
+
+/* Free path lookup cache */
+void flecs_path_cache_fini(
+    ecs_world_t *world);
+
 /* Convert floating point to string */
 char * ecs_ftoa(
     double f, 
@@ -289,4 +304,14 @@ int32_t flecs_query_pivot_term(
     const ecs_world_t *world,
     const ecs_query_t *query);
 
+#ifdef FLECS_PIPELINE
+/* Run job on the calling thread and on all worker stages. Returns false
+ * without running the job if the workers are not idle. Implemented by the
+ * pipeline addon, which owns the worker threads. */
+bool flecs_workers_run(
+    ecs_world_t *world,
+    ecs_worker_job_action_t job,
+    void *ctx);
+#endif
+
 #endif
@@ -257,6 +257,20 @@ typedef struct ecs_marked_id_t {
     bool delete_id;
 } ecs_marked_id_t;
 
+/* Job that can be dispatched to idle worker stages */
+typedef void (*ecs_worker_job_action_t)(
+    ecs_stage_t *stage,
+    void *ctx);
+
+/* Component storage of a table deleted during cleanup action, destructed
+ * after all tables are cleared */
+typedef struct ecs_deleted_column_t {
+    const ecs_type_info_t *ti;
+    void *data;
+    int32_t count;                   /* Number of elements to destruct */
+    int32_t size;                    /* Number of allocated elements */
+} ecs_deleted_column_t;
+
 typedef struct ecs_store_t {
     /* Entity lookup */
     ecs_entity_index_t entity_index;
@@ -280,6 +294,15 @@ typedef struct ecs_store_t {
      * type info so it's guaranteed that this data is available while the 
      * storage is cleaning up tables. */
     ecs_vec_t deleted_components;    /* vector<ecs_entity_t> */
+
+    /* Component storage of deleted tables with thread safe destructors. Only
+     * used when threaded dtors are enabled. Destructors run after all tables
+     * are cleared, on the calling thread and idle worker stages. */
+    ecs_vec_t deleted_columns;       /* vector<ecs_deleted_column_t> */
+
+    /* Id records of DontFragment components. Used to find the values of an
+     * entity that need to be cleaned up when it is deleted or cleared. */
+    ecs_vec_t dont_fragment;         /* vector<ecs_id_record_t*> */
 } ecs_store_t;
 
 /* fini actions */
@@ -329,12 +352,20 @@ struct ecs_world_t {
     /* Used to track when cache needs to be updated */
     ecs_monitor_set_t monitors;      /* map<id, ecs_monitor_t> */
 
+    /* Up traversal results shared by queries, see ecs_enable_trav_cache() */
+    ecs_map_t trav_up_cache;         /* map<table_id, ecs_trav_up_table_t*> */
+
     /* -- Systems -- */
     ecs_entity_t pipeline;           /* Current pipeline */
 
     /* -- Identifiers -- */
     ecs_hashmap_t aliases;
     ecs_hashmap_t symbols;
+    ecs_map_t path_cache;            /* map<path hash, ecs_path_cache_elem_t*> */
+    ecs_map_t path_cache_refs;       /* set<entity> of entities on cached paths */
+
+    /* -- Value indexes -- */
+    ecs_map_t value_indexes;         /* map<component, ecs_value_index_t*> */
 
     /* -- Staging -- */
     ecs_stage_t **stages;            /* Stages */
@@ -359,6 +390,8 @@ struct ecs_world_t {
     int32_t workers_running;         /* Number of threads running */
     int32_t workers_waiting;         /* Number of workers waiting on sync */
     ecs_pipeline_state_t* pq;        /* Pointer to the pipeline for the workers to execute */
+    ecs_worker_job_action_t worker_job; /* Job workers run instead of the pipeline */
+    void *worker_job_ctx;            /* Context passed to worker_job */
     bool workers_use_task_api;       /* Workers are short-lived tasks, not long-running threads */
 
     /* -- Time management -- */
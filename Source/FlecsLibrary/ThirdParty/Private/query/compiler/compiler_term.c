@@ -1086,6 +1086,20 @@ void flecs_query_set_op_kind(
         ecs_assert(ecs_term_ref_is_set(&term->second), ECS_INTERNAL_ERROR, NULL);
         op->kind = EcsQueryTrav;
 
+    /* If term queries for a DontFragment component, use instructions that
+     * match entities instead of tables. Not and Optional are evaluated by the
+     * instruction itself, as the result can differ between rows of a table. */
+    } else if (term->flags_ & EcsTermDontFragment) {
+        if (term->oper == EcsNot) {
+            op->kind = EcsQueryDontFragmentNot;
+        } else if (term->oper == EcsOptional) {
+            op->kind = EcsQueryDontFragmentOption;
+        } else if (src_is_var) {
+            op->kind = EcsQueryDontFragment;
+        } else {
+            op->kind = EcsQueryDontFragmentWith;
+        }
+
     /* If term queries for union pair, use union instruction */
     } else if (term->flags_ & EcsTermIsUnion) {
         if (op->kind == EcsQueryAnd) {
@@ -1346,6 +1360,12 @@ int flecs_query_compile_term(
         is_optional = true;
     }
 
+    /* DontFragment instructions evaluate Not and Optional per entity */
+    if (term->flags_ & EcsTermDontFragment) {
+        is_not = false;
+        is_optional = false;
+    }
+
     /* Handle Not, Optional, Or operators */
     if (is_not) {
         flecs_query_begin_block(EcsQueryNot, ctx);
@@ -218,6 +218,29 @@ bool flecs_query_union_self_up(
     const ecs_query_run_ctx_t *ctx);
 
 
+/* DontFragment evaluation */
+
+bool flecs_query_dont_fragment(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx);
+
+bool flecs_query_dont_fragment_with(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx);
+
+bool flecs_query_dont_fragment_not(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx);
+
+bool flecs_query_dont_fragment_option(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx);
+
+
 /* Toggle evaluation*/
 
 bool flecs_query_toggle(
@@ -693,7 +693,15 @@ bool flecs_query_each(
     const ecs_table_range_t range = flecs_query_var_get_range(op->first.var, ctx);
     ecs_table_t *table = range.table;
     if (!table) {
-        return false;
+        /* Entities without a table (matched by DontFragment components) are
+         * stored as a single entity in the table variable. */
+        const ecs_entity_t e = ctx->vars[op->first.var].entity;
+        if (redo || range.count != 1 || !e) {
+            return false;
+        }
+
+        flecs_query_var_set_entity(op, op->src.var, e, ctx);
+        return true;
     }
 
     if (!redo) {
@@ -1355,6 +1363,10 @@ bool flecs_query_dispatch(
     case EcsQueryUnionNeq: return flecs_query_union_neq(op, redo, ctx);
     case EcsQueryUnionEqUp: return flecs_query_union_up(op, redo, ctx);
     case EcsQueryUnionEqSelfUp: return flecs_query_union_self_up(op, redo, ctx);
+    case EcsQueryDontFragment: return flecs_query_dont_fragment(op, redo, ctx);
+    case EcsQueryDontFragmentWith: return flecs_query_dont_fragment_with(op, redo, ctx);
+    case EcsQueryDontFragmentNot: return flecs_query_dont_fragment_not(op, redo, ctx);
+    case EcsQueryDontFragmentOption: return flecs_query_dont_fragment_option(op, redo, ctx);
     case EcsQueryLookup: return flecs_query_lookup(op, redo, ctx);
     case EcsQuerySetVars: return flecs_query_setvars(op, redo, ctx);
     case EcsQuerySetThis: return flecs_query_setthis(op, redo, ctx);
@@ -0,0 +1,236 @@
+/**
+ * @file query/engine/eval_dont_fragment.c
+ * @brief DontFragment component evaluation.
+ *
+ * DontFragment components aren't stored in tables, so they can't be matched
+ * with the table index of an id record. When the source is not yet known the
+ * instructions iterate the dense array of the component's sparse set. When the
+ * source is known, the instructions test each row of the source range and
+ * yield runs of adjacent rows that (don't) have the component.
+ */
+
+#include "../../private_api.h"
+
+typedef enum {
+    FlecsQueryDontFragmentAnd,
+    FlecsQueryDontFragmentNot,
+    FlecsQueryDontFragmentOptional
+} flecs_query_dont_fragment_kind_t;
+
+static
+ecs_entity_t flecs_query_dont_fragment_entity(
+    const ecs_query_op_t *op,
+    const ecs_table_range_t *range,
+    int32_t row,
+    const ecs_query_run_ctx_t *ctx)
+{
+    if (range->table) {
+        return ecs_table_entities(range->table)[range->offset + row];
+    }
+
+    /* Entity doesn't have a table */
+    ecs_flags16_t flags = flecs_query_ref_flags(op->flags, EcsQuerySrc);
+    return flecs_get_ref_entity(&op->src, flags, ctx);
+}
+
+static
+bool flecs_query_dont_fragment_has(
+    const ecs_id_record_t *idr,
+    ecs_entity_t entity)
+{
+    return idr && flecs_dont_fragment_try(idr, entity) != NULL;
+}
+
+static
+bool flecs_query_dont_fragment_select(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx)
+{
+    ecs_query_dont_fragment_ctx_t *op_ctx = flecs_op_ctx(ctx, dont_fragment);
+    ecs_iter_t *it = ctx->it;
+    const int8_t field_index = op->field_index;
+
+    if (!redo) {
+        const ecs_id_t id = flecs_query_op_get_id(op, ctx);
+        op_ctx->idr = flecs_dont_fragment_get(ctx->world, id);
+        if (!op_ctx->idr) {
+            return false;
+        }
+
+        op_ctx->cur = -1;
+    }
+
+    ecs_id_record_t *idr = op_ctx->idr;
+
+    /* Fetch the dense array each time, as it can be reallocated when new
+     * entities get the component while the result is being iterated. */
+    const uint64_t *entities = flecs_sparse_ids(idr->sparse);
+    const int32_t count = flecs_sparse_count(idr->sparse);
+
+    for (op_ctx->cur ++; op_ctx->cur < count; op_ctx->cur ++) {
+        const ecs_entity_t e = entities[op_ctx->cur];
+        ecs_record_t *r = flecs_entities_get(ctx->world, e);
+        ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        ecs_table_t *table = r->table;
+        if (table && flecs_query_table_filter(table, op->other,
+            (EcsTableNotQueryable|EcsTableIsPrefab|EcsTableIsDisabled)))
+        {
+            continue;
+        }
+
+        ecs_var_id_t var_id = op->src.var;
+        if (ctx->query_vars[var_id].kind == EcsVarEntity) {
+            flecs_query_var_set_entity(op, var_id, e, ctx);
+        } else if (table) {
+            flecs_query_var_set_range(op, var_id,
+                table, ECS_RECORD_TO_ROW(r->row), 1, ctx);
+        } else {
+            /* Entities without a table are stored as entity in the table
+             * variable, which is how the iterator yields single entities. */
+            ecs_var_t *var = &ctx->vars[var_id];
+            var->range = (ecs_table_range_t){ .count = 1 };
+            var->entity = e;
+        }
+
+        it->ids[field_index] = idr->id;
+        it->trs[field_index] = idr->dont_fragment_tr;
+        return true;
+    }
+
+    return false;
+}
+
+static
+bool flecs_query_dont_fragment_cmp(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx,
+    flecs_query_dont_fragment_kind_t kind)
+{
+    ecs_query_dont_fragment_ctx_t *op_ctx = flecs_op_ctx(ctx, dont_fragment);
+    ecs_iter_t *it = ctx->it;
+    const int8_t field_index = op->field_index;
+    const bool src_is_var = op->flags & (EcsQueryIsVar << EcsQuerySrc);
+
+    ecs_table_range_t range;
+    if (!redo) {
+        range = flecs_query_get_range(op, &op->src, EcsQuerySrc, ctx);
+        if (range.table && !range.count) {
+            range.count = ecs_table_count(range.table);
+        }
+
+        const ecs_id_t id = flecs_query_op_get_id(op, ctx);
+        op_ctx->idr = flecs_dont_fragment_get(ctx->world, id);
+        op_ctx->range = range;
+        op_ctx->row = 0;
+        it->ids[field_index] = id;
+    } else {
+        range = op_ctx->range;
+    }
+
+    const ecs_id_record_t *idr = op_ctx->idr;
+    int32_t row = op_ctx->row;
+    bool has = false;
+
+    /* Find first row that matches */
+    for (; row < range.count; row ++) {
+        ecs_entity_t e = flecs_query_dont_fragment_entity(op, &range, row, ctx);
+        has = flecs_query_dont_fragment_has(idr, e);
+        if (kind == FlecsQueryDontFragmentAnd && !has) {
+            continue;
+        }
+        if (kind == FlecsQueryDontFragmentNot && has) {
+            continue;
+        }
+        break;
+    }
+
+    if (row >= range.count) {
+        /* Restore range */
+        if (src_is_var && range.table) {
+            flecs_query_var_narrow_range(op->src.var, range.table,
+                range.offset, range.count, ctx);
+        }
+        return false;
+    }
+
+    /* Table variables can return multiple entities, so extend the result to
+     * the adjacent rows for which the component has the same state. */
+    const int32_t start = row;
+    row ++;
+    if (src_is_var && range.table &&
+        ctx->query_vars[op->src.var].kind == EcsVarTable)
+    {
+        const ecs_entity_t *entities = ecs_table_entities(range.table);
+        for (; row < range.count; row ++) {
+            ecs_entity_t e = entities[range.offset + row];
+            if (flecs_query_dont_fragment_has(idr, e) != has) {
+                break;
+            }
+        }
+    }
+
+    op_ctx->row = row;
+
+    if (src_is_var && range.table) {
+        flecs_query_var_narrow_range(op->src.var, range.table,
+            range.offset + start, row - start, ctx);
+    }
+
+    if (op->flags & (EcsQueryIsEntity << EcsQuerySrc)) {
+        it->sources[field_index] = op->src.entity;
+    }
+
+    if (has) {
+        ECS_TERMSET_SET(it->set_fields, 1u << field_index);
+        it->trs[field_index] = idr->dont_fragment_tr;
+    } else {
+        ECS_TERMSET_CLEAR(it->set_fields, 1u << field_index);
+        it->trs[field_index] = NULL;
+    }
+
+    return true;
+}
+
+bool flecs_query_dont_fragment(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx)
+{
+    const uint64_t written = ctx->written[ctx->op_index];
+    if (written & (1ull << op->src.var)) {
+        return flecs_query_dont_fragment_cmp(
+            op, redo, ctx, FlecsQueryDontFragmentAnd);
+    } else {
+        return flecs_query_dont_fragment_select(op, redo, ctx);
+    }
+}
+
+bool flecs_query_dont_fragment_with(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx)
+{
+    return flecs_query_dont_fragment_cmp(
+        op, redo, ctx, FlecsQueryDontFragmentAnd);
+}
+
+bool flecs_query_dont_fragment_not(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx)
+{
+    return flecs_query_dont_fragment_cmp(
+        op, redo, ctx, FlecsQueryDontFragmentNot);
+}
+
+bool flecs_query_dont_fragment_option(
+    const ecs_query_op_t *op,
+    bool redo,
+    const ecs_query_run_ctx_t *ctx)
+{
+    return flecs_query_dont_fragment_cmp(
+        op, redo, ctx, FlecsQueryDontFragmentOptional);
+}
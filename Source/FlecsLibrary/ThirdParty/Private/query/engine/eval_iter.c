@@ -105,14 +105,91 @@ void flecs_query_iter_constrain(
     ecs_os_perf_trace_pop("flecs.query.iter.constrain");
 }
 
+static
+void flecs_query_iter_reset_nodes(
+    ecs_query_iter_t *qit,
+    ecs_query_cache_t *cache)
+{
+    qit->node = cache->list.first;
+    qit->last = cache->list.last;
+
+    if (cache->order_by_callback && cache->list.info.table_count) {
+        qit->node = ecs_vec_first(&cache->table_slices);
+        qit->last = ecs_vec_last_t(
+            &cache->table_slices, ecs_query_cache_table_match_t);
+    }
+}
+
+static
+void flecs_query_iter_fini_ctx(
+    ecs_iter_t *it,
+    ecs_query_iter_t *qit);
+
+/* Restart iteration for the next entity of a variable that was constrained by
+ * value (see ecs_iter_set_var_by_value). */
+static
+bool flecs_query_iter_next_value(
+    ecs_iter_t *it)
+{
+    ecs_query_iter_t *qit = &it->priv_.iter.query;
+    ecs_entity_t e = 0;
+    while (qit->value_cur < qit->value_count) {
+        e = qit->value_entities[qit->value_cur ++];
+        if (ecs_is_alive(it->real_world, e)) {
+            break;
+        }
+        e = 0;
+    }
+
+    if (!e) {
+        return false;
+    }
+
+    ecs_query_impl_t *impl = flecs_query_impl(qit->query);
+    int32_t i, var_count = impl->var_count;
+    int32_t op_count = impl->op_count ? impl->op_count : 1;
+
+    flecs_query_iter_fini_ctx(it, qit);
+    ecs_os_memset_n(qit->op_ctx, 0, ecs_query_op_ctx_t, op_count);
+    ecs_os_memset_n(qit->written, 0, ecs_write_flags_t, op_count);
+
+    for (i = 0; i < var_count; i ++) {
+        if (it->constrained_vars & (1llu << i)) {
+            continue;
+        }
+        qit->vars[i] = (ecs_var_t){ .entity = i ? EcsWildcard : 0 };
+    }
+
+    if (impl->cache) {
+        flecs_query_iter_reset_nodes(qit, impl->cache);
+    }
+
+    qit->prev = NULL;
+    qit->skip_count = 0;
+    qit->op = 0;
+    qit->sp = 0;
+
+    it->flags &= ~EcsIterIsValid;
+    ecs_iter_set_var(it, qit->value_var, e);
+
+    return true;
+}
+
 bool ecs_query_next(
     ecs_iter_t *it)
 {
     ecs_assert(it != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(it->next == ecs_query_next, ECS_INVALID_PARAMETER, NULL);
 
+    if (it->flags & EcsIterNoResults) {
+        /* Iterator was constrained to a value that no entity has */
+        ecs_iter_fini(it);
+        return false;
+    }
+
     ecs_os_perf_trace_push("flecs.query.next");
 
+retry: ;
     ecs_query_iter_t *qit = &it->priv_.iter.query;
     ecs_query_impl_t *impl = ECS_CONST_CAST(ecs_query_impl_t*, qit->query);
     ecs_query_run_ctx_t ctx;
@@ -186,6 +263,11 @@ bool ecs_query_next(
         }
     }
 
+    /* Iterate results for the next entity with the constrained value */
+    if (qit->value_entities && flecs_query_iter_next_value(it)) {
+        goto retry;
+    }
+
     /* Done iterating */
     flecs_query_mark_fixed_fields_dirty(impl, it);
     if (ctx.query->monitor) {
@@ -207,7 +289,7 @@ yield:
     return true;
 }
 
-static inline
+static
 void flecs_query_iter_fini_ctx(
     ecs_iter_t *it,
     ecs_query_iter_t *qit)
@@ -263,6 +345,10 @@ void flecs_query_iter_fini(
 #endif
 
     flecs_query_iter_fini_ctx(it, qit);
+    if (qit->value_entities) {
+        flecs_iter_free_n(qit->value_entities, ecs_entity_t, qit->value_count);
+        qit->value_entities = NULL;
+    }
     flecs_iter_free_n(qit->vars, ecs_var_t, var_count);
     flecs_iter_free_n(qit->written, ecs_write_flags_t, op_count);
     flecs_iter_free_n(qit->op_ctx, ecs_query_op_ctx_t, op_count);
@@ -330,16 +416,12 @@ ecs_iter_t flecs_query_iter(
 
     ecs_query_cache_t *cache = impl->cache;
     if (cache) {
-        qit->node = cache->list.first;
-        qit->last = cache->list.last;
-
         if (cache->order_by_callback && cache->list.info.table_count) {
             flecs_query_cache_sort_tables(it.real_world, impl);
-            qit->node = ecs_vec_first(&cache->table_slices);
-            qit->last = ecs_vec_last_t(
-                &cache->table_slices, ecs_query_cache_table_match_t);
         }
 
+        flecs_query_iter_reset_nodes(qit, cache);
+
         cache->prev_match_count = cache->match_count;
     }
 
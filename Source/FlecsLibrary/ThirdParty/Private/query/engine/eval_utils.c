@@ -27,6 +27,8 @@ void flecs_query_set_iter_this(
             it->entities += it->offset;
         }
     } else if (count == 1) {
+        it->table = NULL;
+        it->offset = 0;
         it->count = 1;
         it->entities = &ctx->vars[0].entity;
     }
@@ -58,3 +58,24 @@ ecs_trav_up_t* flecs_query_get_up_cache(
 /* Free up traversal cache */
 void flecs_query_up_cache_fini(
     ecs_trav_up_cache_t *cache);
+
+/* World up traversal cache, see ecs_enable_trav_cache() */
+
+/* Invalidate results for tables that can reach an entity through a traversable
+ * relationship, called with the (*, entity) id record. */
+void flecs_trav_up_cache_invalidate(
+    ecs_world_t *world,
+    ecs_id_record_t *tgt_idr);
+
+/* Remove results for a table that is deleted */
+void flecs_trav_up_cache_table_fini(
+    ecs_world_t *world,
+    const ecs_table_t *table);
+
+/* Remove all results */
+void flecs_trav_up_cache_clear(
+    ecs_world_t *world);
+
+/* Free world up traversal cache */
+void flecs_trav_up_cache_fini(
+    ecs_world_t *world);
@@ -161,6 +161,213 @@ found:
     return up;
 }
 
+/* World traversal cache. Stores up traversal results per table so they can be
+ * shared between queries and reused across iterations. Results are stored for
+ * two kinds of tables: tables that are matched by a query (the search starts at
+ * the relationship targets of the table), and tables of traversed targets (the
+ * search also follows IsA for inheritable components). Results for a table are
+ * invalidated when one of its relationship targets changes tables. */
+
+typedef struct ecs_trav_up_elem_t {
+    ecs_id_t trav;        /* Traversed relationship, as (R, *) */
+    ecs_id_t with;
+    bool is_tgt;          /* Table of a traversed target */
+    ecs_trav_up_t up;
+} ecs_trav_up_elem_t;
+
+typedef struct ecs_trav_up_table_t {
+    ecs_vec_t elems;      /* vector<ecs_trav_up_elem_t> */
+} ecs_trav_up_table_t;
+
+static
+ecs_trav_up_t* flecs_trav_up_world_get(
+    const ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_id_t trav,
+    ecs_id_t with,
+    bool is_tgt)
+{
+    ecs_trav_up_table_t *cache = ecs_map_get_deref(
+        &world->trav_up_cache, ecs_trav_up_table_t, table->id);
+    if (!cache) {
+        return NULL;
+    }
+
+    ecs_trav_up_elem_t *elems = ecs_vec_first_t(
+        &cache->elems, ecs_trav_up_elem_t);
+    int32_t i, count = ecs_vec_count(&cache->elems);
+    for (i = 0; i < count; i ++) {
+        ecs_trav_up_elem_t *elem = &elems[i];
+        if (elem->with == with && elem->trav == trav && 
+            elem->is_tgt == is_tgt) 
+        {
+            return &elem->up;
+        }
+    }
+
+    return NULL;
+}
+
+static
+ecs_trav_up_t* flecs_trav_up_world_insert(
+    ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_id_t trav,
+    ecs_id_t with,
+    bool is_tgt)
+{
+    ecs_allocator_t *a = &world->allocator;
+    ecs_trav_up_table_t **cache = ecs_map_ensure_ref(
+        &world->trav_up_cache, ecs_trav_up_table_t, table->id);
+    if (!cache[0]) {
+        cache[0] = flecs_alloc_t(a, ecs_trav_up_table_t);
+        ecs_vec_init_t(a, &cache[0]->elems, ecs_trav_up_elem_t, 1);
+    }
+
+    ecs_trav_up_elem_t *elem = ecs_vec_append_t(
+        a, &cache[0]->elems, ecs_trav_up_elem_t);
+    ecs_os_zeromem(elem);
+    elem->trav = trav;
+    elem->with = with;
+    elem->is_tgt = is_tgt;
+    return &elem->up;
+}
+
+static
+ecs_trav_up_t* flecs_trav_up_world_table(
+    ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_id_t with,
+    ecs_id_record_t *idr_with,
+    ecs_id_record_t *idr_trav,
+    bool is_tgt);
+
+static
+bool flecs_trav_up_world_entity(
+    ecs_world_t *world,
+    ecs_entity_t src,
+    ecs_id_t with,
+    ecs_id_record_t *idr_with,
+    ecs_id_record_t *idr_trav,
+    ecs_trav_up_t *result)
+{
+    ecs_record_t *src_record = flecs_entities_get_any(world, src);
+    ecs_table_t *table = src_record->table;
+    if (!table) {
+        return false;
+    }
+
+    ecs_type_t type = table->type;
+    if (flecs_trav_type_search(result, table, idr_with, &type) >= 0) {
+        result->src = src;
+        return true;
+    }
+
+    const ecs_trav_up_t *up = flecs_trav_up_world_table(
+        world, table, with, idr_with, idr_trav, true);
+    if (up->tr) {
+        result->src = up->src;
+        result->tr = up->tr;
+        result->id = up->id;
+        return true;
+    }
+
+    return false;
+}
+
+static
+bool flecs_trav_up_world_targets(
+    ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_id_t with,
+    ecs_id_record_t *idr_with,
+    ecs_id_record_t *idr_trav,
+    ecs_trav_up_t *result)
+{
+    const ecs_table_record_t *tr = ecs_table_cache_get(&idr_trav->cache, table);
+    if (!tr) {
+        return false;
+    }
+
+    int32_t i = tr->index, end = i + tr->count;
+    for (; i < end; i ++) {
+        ecs_entity_t tgt = ECS_PAIR_SECOND(table->type.array[i]);
+        ecs_assert(tgt != 0, ECS_INTERNAL_ERROR, NULL);
+        if (flecs_trav_up_world_entity(
+            world, tgt, with, idr_with, idr_trav, result)) 
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static
+ecs_trav_up_t* flecs_trav_up_world_table(
+    ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_id_t with,
+    ecs_id_record_t *idr_with,
+    ecs_id_record_t *idr_trav,
+    bool is_tgt)
+{
+    ecs_id_t trav = idr_trav->id;
+    ecs_trav_up_t *up = flecs_trav_up_world_get(
+        world, table, trav, with, is_tgt);
+    if (up) {
+        /* If the result isn't ready this is a cycle, which is not found */
+        return up;
+    }
+
+    ecs_os_perf_trace_push("flecs.trav.world_table_up");
+
+    /* Insert empty result before traversing so that cycles terminate */
+    flecs_trav_up_world_insert(world, table, trav, with, is_tgt);
+
+    ecs_trav_up_t result = {0};
+    if (!is_tgt) {
+        flecs_trav_up_world_targets(
+            world, table, with, idr_with, idr_trav, &result);
+    } else if (table->flags & EcsTableHasPairs) {
+        bool is_a = idr_trav == world->idr_isa_wildcard;
+        if (is_a) {
+            if (!(table->flags & EcsTableHasIsA)) {
+                goto done;
+            }
+
+            if (!flecs_type_can_inherit_id(world, table, idr_with, with)) {
+                goto done;
+            }
+        }
+
+        if (flecs_trav_up_world_targets(
+            world, table, with, idr_with, idr_trav, &result)) 
+        {
+            goto done;
+        }
+
+        if (!is_a && (idr_with->flags & EcsIdOnInstantiateInherit)) {
+            flecs_trav_up_world_targets(world, table, with, idr_with, 
+                world->idr_isa_wildcard, &result);
+        }
+    }
+
+done:
+    /* Traversing may have inserted results, so lookup the element again */
+    up = flecs_trav_up_world_get(world, table, trav, with, is_tgt);
+    ecs_assert(up != NULL, ECS_INTERNAL_ERROR, NULL);
+    if (result.tr) {
+        up->src = result.src;
+        up->id = result.id;
+        up->tr = result.tr;
+    }
+    up->ready = true;
+
+    ecs_os_perf_trace_pop("flecs.trav.world_table_up");
+    return up;
+}
+
 ecs_trav_up_t* flecs_query_get_up_cache(
     const ecs_query_run_ctx_t *ctx,
     ecs_trav_up_cache_t *cache,
@@ -170,11 +377,25 @@ ecs_trav_up_t* flecs_query_get_up_cache(
     ecs_id_record_t *idr_with,
     ecs_id_record_t *idr_trav)
 {
+    ecs_world_t *world = ctx->it->real_world;
+    if (world->flags & EcsWorldTravCache) {
+        /* Use world cache. When the result isn't cached yet and the world is
+         * multithreaded, fall back to the iterator cache. */
+        ecs_trav_up_t *up = flecs_trav_up_world_get(
+            world, table, idr_trav->id, with, false);
+        if (!up && !(world->flags & EcsWorldMultiThreaded)) {
+            up = flecs_trav_up_world_table(
+                world, table, with, idr_with, idr_trav, false);
+        }
+        if (up) {
+            return up->tr ? up : NULL;
+        }
+    }
+
     if (cache->with && cache->with != with) {
         flecs_query_up_cache_fini(cache);
     }
 
-    ecs_world_t *world = ctx->it->real_world;
     ecs_allocator_t *a = flecs_query_get_allocator(ctx->it);
     ecs_map_init_if(&cache->src, a);
 
@@ -209,3 +430,90 @@ void flecs_query_up_cache_fini(
 {
     ecs_map_fini(&cache->src);
 }
+
+static
+bool flecs_trav_up_cache_remove(
+    ecs_world_t *world,
+    const ecs_table_t *table)
+{
+    ecs_trav_up_table_t *cache = ecs_map_remove_ptr(
+        &world->trav_up_cache, table->id);
+    if (!cache) {
+        return false;
+    }
+
+    ecs_vec_fini_t(&world->allocator, &cache->elems, ecs_trav_up_elem_t);
+    flecs_free_t(&world->allocator, ecs_trav_up_table_t, cache);
+    return true;
+}
+
+void flecs_trav_up_cache_invalidate(
+    ecs_world_t *world,
+    ecs_id_record_t *tgt_idr)
+{
+    ecs_assert(tgt_idr != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    /* Invalidate tables that have the entity as target of a traversable
+     * relationship */
+    ecs_id_record_t *cur = tgt_idr;
+    while ((cur = cur->trav.next)) {
+        ecs_table_cache_iter_t it;
+        if (!flecs_table_cache_all_iter(&cur->cache, &it)) {
+            continue;
+        }
+
+        const ecs_table_record_t *tr;
+        while ((tr = flecs_table_cache_next(&it, ecs_table_record_t))) {
+            const ecs_table_t *table = tr->hdr.table;
+            if (!flecs_trav_up_cache_remove(world, table)) {
+                /* Results for tables below this table are only cached when 
+                 * the traversal passed through this table, so if it doesn't
+                 * have results, tables below it don't either. */
+                continue;
+            }
+
+            if (!table->_->traversable_count) {
+                continue;
+            }
+
+            const int32_t entity_count = ecs_table_count(table);
+            const ecs_entity_t *entities = ecs_table_entities(table);
+            for (int32_t e = 0; e < entity_count; e ++) {
+                const ecs_record_t *r = flecs_entities_get(world, entities[e]);
+                ecs_id_record_t *idr_t = r->idr;
+                if (idr_t) {
+                    flecs_trav_up_cache_invalidate(world, idr_t);
+                }
+            }
+        }
+    }
+}
+
+void flecs_trav_up_cache_table_fini(
+    ecs_world_t *world,
+    const ecs_table_t *table)
+{
+    if (ecs_map_count(&world->trav_up_cache)) {
+        flecs_trav_up_cache_remove(world, table);
+    }
+}
+
+void flecs_trav_up_cache_clear(
+    ecs_world_t *world)
+{
+    ecs_map_iter_t it = ecs_map_iter(&world->trav_up_cache);
+    while (ecs_map_next(&it)) {
+        ecs_trav_up_table_t *cache = ecs_map_ptr(&it);
+        ecs_vec_fini_t(&world->allocator, &cache->elems, ecs_trav_up_elem_t);
+        flecs_free_t(&world->allocator, ecs_trav_up_table_t, cache);
+    }
+
+    ecs_map_clear(&world->trav_up_cache);
+}
+
+void flecs_trav_up_cache_fini(
+    ecs_world_t *world)
+{
+    flecs_trav_up_cache_clear(world);
+    ecs_map_fini(&world->trav_up_cache);
+}
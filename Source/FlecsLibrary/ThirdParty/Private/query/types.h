@@ -82,6 +82,10 @@ typedef enum {
     EcsQueryUnionNeq,       /* Evaluate union relationship */
     EcsQueryUnionEqUp,      /* Evaluate union relationship w/up traversal */
     EcsQueryUnionEqSelfUp,  /* Evaluate union relationship w/self|up traversal */
+    EcsQueryDontFragment,   /* Evaluate DontFragment component */
+    EcsQueryDontFragmentWith, /* Evaluate DontFragment component against fixed or variable source */
+    EcsQueryDontFragmentNot, /* Match entities that don't have DontFragment component */
+    EcsQueryDontFragmentOption, /* DontFragment component for optional terms */
     EcsQueryLookup,         /* Lookup relative to variable */
     EcsQuerySetVars,        /* Populate it.sources from variables */
     EcsQuerySetThis,        /* Populate This entity variable */
@@ -144,6 +148,14 @@ typedef struct {
     int32_t row;
 } ecs_query_union_ctx_t;
 
+/* DontFragment context */
+typedef struct {
+    ecs_id_record_t *idr;
+    ecs_table_range_t range;
+    int32_t cur;
+    int32_t row;
+} ecs_query_dont_fragment_ctx_t;
+
 /* Down traversal cache (for resolving up queries w/unknown source) */
 typedef struct {
     ecs_table_t *table;
@@ -296,6 +308,7 @@ typedef struct ecs_query_op_ctx_t {
         ecs_query_membereq_ctx_t membereq;
         ecs_query_toggle_ctx_t toggle;
         ecs_query_union_ctx_t union_;
+        ecs_query_dont_fragment_ctx_t dont_fragment;
     } is;
 } ecs_query_op_ctx_t;
 
@@ -214,6 +214,10 @@ const char* flecs_query_op_str(
     case EcsQueryUnionNeq:       return "unionneq  ";
     case EcsQueryUnionEqUp:      return "union_up  ";
     case EcsQueryUnionEqSelfUp:  return "union_sup ";
+    case EcsQueryDontFragment:   return "dontfrag  ";
+    case EcsQueryDontFragmentWith: return "dontfrag_w";
+    case EcsQueryDontFragmentNot: return "dontfragn ";
+    case EcsQueryDontFragmentOption: return "dontfrago ";
     case EcsQueryLookup:         return "lookup    ";
     case EcsQuerySetVars:        return "setvars   ";
     case EcsQuerySetThis:        return "setthis   ";
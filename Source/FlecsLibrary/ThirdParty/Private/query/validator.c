@@ -1326,6 +1326,28 @@ int flecs_query_finalize_terms(
                     q->row_fields |= flecs_uto(uint32_t, 1llu << i);
                 }
             }
+
+            if (idr->flags & EcsIdDontFragment) {
+                if (term->src.id & EcsUp) {
+                    flecs_query_validator_error(&ctx, 
+                        "DontFragment components can't be matched with up "
+                        "traversal");
+                    return -1;
+                }
+
+                if (term->oper == EcsOr || prev_is_or) {
+                    flecs_query_validator_error(&ctx, 
+                        "DontFragment components can't be used with the OR "
+                        "operator");
+                    return -1;
+                }
+
+                /* Values aren't stored in tables, so there is no table column
+                 * for change detection to track. */
+                term->flags_ |= EcsTermDontFragment;
+                ECS_TERMSET_CLEAR(q->write_fields, 1u << term->field_index);
+                ECS_TERMSET_CLEAR(q->read_fields, 1u << term->field_index);
+            }
         }
 
         if (term->oper == EcsOptional || term->oper == EcsNot) {
@@ -1634,7 +1656,9 @@ bool flecs_query_finalize_simple(
                 q->data_fields |= (ecs_termset_t)(1llu << i);
             }
 
-            if (idr->flags & EcsIdOnInstantiateInherit) {
+            if ((idr->flags & EcsIdOnInstantiateInherit) && 
+                !(idr->flags & EcsIdDontFragment)) 
+            {
                 term->src.id |= EcsUp;
                 term->trav = EcsIsA;
                 up_count ++;
@@ -1658,6 +1682,11 @@ bool flecs_query_finalize_simple(
                 cacheable = false; trivial = false;
                 q->row_fields |= flecs_uto(uint32_t, 1llu << i);
             }
+
+            if (idr->flags & EcsIdDontFragment) {
+                term->flags_ |= EcsTermDontFragment;
+                cacheable = false; trivial = false;
+            }
         }
 
         if (ECS_IS_PAIR(id)) {
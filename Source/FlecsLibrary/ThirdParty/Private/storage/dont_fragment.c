@@ -0,0 +1,202 @@
+/**
+ * @file storage/dont_fragment.c
+ * @brief Storage for components with the DontFragment trait.
+ *
+ * Values of DontFragment components are stored in a sparse set per component
+ * that is keyed by entity id. Adding or removing a DontFragment component does
+ * not change the table of an entity, which means that frequently toggled
+ * components don't create new tables or move entities between tables.
+ *
+ * Entities that don't have a table when a DontFragment component is added are
+ * stored in the root table, so that observers for the component are invoked.
+ *
+ * Queries find entities with a DontFragment component by iterating the dense
+ * array of the sparse set. The entity record is flagged when it has one or
+ * more DontFragment components, so that deleting or clearing entities that
+ * don't have them stays free.
+ */
+
+#include "../private_api.h"
+
+ecs_id_record_t* flecs_dont_fragment_get(
+    const ecs_world_t *world,
+    ecs_id_t id)
+{
+    if (!ecs_vec_count(&world->store.dont_fragment)) {
+        return NULL;
+    }
+
+    if (ECS_IS_PAIR(id)) {
+        return NULL;
+    }
+
+    ecs_id_record_t *idr = flecs_id_record_get(world, id);
+    if (idr && (idr->flags & EcsIdDontFragment)) {
+        return idr;
+    }
+
+    return NULL;
+}
+
+void* flecs_dont_fragment_try(
+    const ecs_id_record_t *idr,
+    ecs_entity_t entity)
+{
+    return flecs_sparse_try(idr->sparse, 0, entity);
+}
+
+static
+void flecs_dont_fragment_invoke_hook(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    const ecs_record_t *r,
+    const ecs_id_record_t *idr,
+    ecs_entity_t event,
+    ecs_iter_action_t hook)
+{
+    ecs_table_t *table = r->table;
+    int32_t row = table ? ECS_RECORD_TO_ROW(r->row) : 0;
+    flecs_invoke_hook(world, table, idr->dont_fragment_tr, 1, row, &entity,
+        idr->id, idr->type_info, event, hook);
+}
+
+static
+void flecs_dont_fragment_emit(
+    ecs_world_t *world,
+    const ecs_record_t *r,
+    const ecs_id_record_t *idr,
+    ecs_entity_t event,
+    ecs_flags32_t event_flag)
+{
+    ecs_table_t *table = r->table;
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (!((idr->flags | world->idr_wildcard->flags) & event_flag)) {
+        return;
+    }
+
+    ecs_id_t id = idr->id;
+    ecs_type_t ids = { .array = &id, .count = 1 };
+    flecs_emit(world, world, 0, &(ecs_event_desc_t) {
+        .event = event,
+        .ids = &ids,
+        .table = table,
+        .offset = ECS_RECORD_TO_ROW(r->row),
+        .count = 1,
+        .observable = world
+    });
+}
+
+void* flecs_dont_fragment_ensure(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r,
+    ecs_id_record_t *idr,
+    bool construct,
+    bool *is_new)
+{
+    ecs_assert(idr->flags & EcsIdDontFragment, ECS_INTERNAL_ERROR, NULL);
+
+    void *ptr = flecs_sparse_try(idr->sparse, 0, entity);
+    if (ptr) {
+        if (is_new) {
+            *is_new = false;
+        }
+        return ptr;
+    }
+
+    if (!r->table) {
+        /* Observers are emitted for a table, so store entities that don't have
+         * a table yet in the root table. */
+        ecs_table_t *root = &world->store.root;
+        int32_t row = flecs_table_append(world, root, entity, false, false);
+        r->table = root;
+        r->row = ECS_ROW_TO_RECORD(row, r->row & ECS_ROW_FLAGS_MASK);
+    }
+
+    const ecs_type_info_t *ti = idr->type_info;
+    ptr = flecs_sparse_ensure(idr->sparse, 0, entity);
+    ecs_assert(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
+    if (construct && ti->hooks.ctor) {
+        ti->hooks.ctor(ptr, 1, ti);
+    }
+
+    r->row |= EcsEntityHasDontFragment;
+
+    if (ti->hooks.on_add) {
+        flecs_dont_fragment_invoke_hook(
+            world, entity, r, idr, EcsOnAdd, ti->hooks.on_add);
+    }
+
+    flecs_dont_fragment_emit(world, r, idr, EcsOnAdd, EcsIdHasOnAdd);
+
+    if (is_new) {
+        *is_new = true;
+    }
+
+    /* Pages of the sparse set are stable, so the pointer is still valid unless
+     * the component was removed by a hook or observer. */
+    return flecs_sparse_try(idr->sparse, 0, entity);
+}
+
+void flecs_dont_fragment_remove(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r,
+    ecs_id_record_t *idr)
+{
+    ecs_assert(idr->flags & EcsIdDontFragment, ECS_INTERNAL_ERROR, NULL);
+
+    if (!flecs_sparse_try(idr->sparse, 0, entity)) {
+        return;
+    }
+
+    const ecs_type_info_t *ti = idr->type_info;
+    flecs_dont_fragment_emit(world, r, idr, EcsOnRemove, EcsIdHasOnRemove);
+
+    if (ti->hooks.on_remove) {
+        flecs_dont_fragment_invoke_hook(
+            world, entity, r, idr, EcsOnRemove, ti->hooks.on_remove);
+    }
+
+    void *ptr = flecs_sparse_remove_fast(idr->sparse, 0, entity);
+    ecs_assert(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
+    if (ti->hooks.dtor) {
+        ti->hooks.dtor(ptr, 1, ti);
+    }
+}
+
+void flecs_dont_fragment_clear(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r)
+{
+    if (!(r->row & EcsEntityHasDontFragment)) {
+        return;
+    }
+
+    /* Don't cache the vector array, hooks could register new components */
+    int32_t i;
+    for (i = 0; i < ecs_vec_count(&world->store.dont_fragment); i ++) {
+        ecs_id_record_t *idr = ecs_vec_get_t(
+            &world->store.dont_fragment, ecs_id_record_t*, i)[0];
+        flecs_dont_fragment_remove(world, entity, r, idr);
+    }
+
+    r->row &= ~EcsEntityHasDontFragment;
+}
+
+void flecs_dont_fragment_on_set(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r,
+    ecs_id_record_t *idr)
+{
+    const ecs_type_info_t *ti = idr->type_info;
+    if (ti->hooks.on_set) {
+        flecs_dont_fragment_invoke_hook(
+            world, entity, r, idr, EcsOnSet, ti->hooks.on_set);
+    }
+
+    flecs_dont_fragment_emit(world, r, idr, EcsOnSet, EcsIdHasOnSet);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file storage/dont_fragment.h
+ * @brief Storage for components with the DontFragment trait.
+ */
+
+#ifndef FLECS_DONT_FRAGMENT_H
+#define FLECS_DONT_FRAGMENT_H
+
+/* Get id record if id is a DontFragment component, or NULL if it isn't. */
+ecs_id_record_t* flecs_dont_fragment_get(
+    const ecs_world_t *world,
+    ecs_id_t id);
+
+/* Get component value, or NULL if entity doesn't have the component. */
+void* flecs_dont_fragment_try(
+    const ecs_id_record_t *idr,
+    ecs_entity_t entity);
+
+/* Add component to entity. Returns pointer to the component value. If the
+ * entity already had the component, no hooks or observers are invoked. */
+void* flecs_dont_fragment_ensure(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r,
+    ecs_id_record_t *idr,
+    bool construct,
+    bool *is_new);
+
+/* Remove component from entity. */
+void flecs_dont_fragment_remove(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r,
+    ecs_id_record_t *idr);
+
+/* Remove all DontFragment components from entity. */
+void flecs_dont_fragment_clear(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r);
+
+/* Invoke OnSet hook and observers for component. */
+void flecs_dont_fragment_on_set(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_record_t *r,
+    ecs_id_record_t *idr);
+
+#endif
@@ -148,11 +148,81 @@ void flecs_id_record_init_sparse(
     }
 }
 
+void flecs_id_record_init_dont_fragment(
+    ecs_world_t *world,
+    ecs_id_record_t *idr)
+{
+    ecs_assert(!ECS_IS_PAIR(idr->id), ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!(idr->flags & EcsIdIsUnion), ECS_CONSTRAINT_VIOLATED,
+        "cannot mix union and DontFragment traits");
+    ecs_assert(idr->type_info != NULL, ECS_INVALID_OPERATION, 
+        "only components can be marked as DontFragment");
+
+    if (idr->dont_fragment_tr) {
+        return;
+    }
+
+    idr->flags |= EcsIdIsSparse;
+    flecs_id_record_init_sparse(world, idr);
+
+    /* DontFragment components aren't stored in tables. Fields and hooks still
+     * need a table record to find the storage of the component, so create one
+     * that isn't registered with any table. */
+    ecs_table_record_t *tr = flecs_walloc_t(world, ecs_table_record_t);
+    ecs_os_zeromem(tr);
+    tr->hdr.cache = &idr->cache;
+    tr->index = -1;
+    tr->column = -1;
+    tr->count = 1;
+    idr->dont_fragment_tr = tr;
+
+    ecs_vec_append_t(&world->allocator, &world->store.dont_fragment, 
+        ecs_id_record_t*)[0] = idr;
+}
+
+static
+void flecs_id_record_fini_dont_fragment(
+    ecs_world_t *world,
+    ecs_id_record_t *idr)
+{
+    ecs_sparse_t *sparse = idr->sparse;
+    const ecs_type_info_t *ti = idr->type_info;
+    ecs_xtor_t dtor = ti->hooks.dtor;
+
+    /* Entities that are deleted remove their DontFragment components, but 
+     * entities in the root table are not cleaned up when the world is deleted.
+     * Destruct the values that are still alive. */
+    int32_t i, count = flecs_sparse_count(sparse);
+    if (dtor) {
+        for (i = 0; i < count; i ++) {
+            dtor(flecs_sparse_get_dense(sparse, 0, i), 1, ti);
+        }
+    }
+    flecs_sparse_clear(sparse);
+
+    ecs_vec_t *v = &world->store.dont_fragment;
+    ecs_id_record_t **idrs = ecs_vec_first_t(v, ecs_id_record_t*);
+    count = ecs_vec_count(v);
+    for (i = 0; i < count; i ++) {
+        if (idrs[i] == idr) {
+            ecs_vec_remove_t(v, ecs_id_record_t*, i);
+            break;
+        }
+    }
+
+    flecs_wfree_t(world, ecs_table_record_t, idr->dont_fragment_tr);
+    idr->dont_fragment_tr = NULL;
+}
+
 static
 void flecs_id_record_fini_sparse(
     ecs_world_t *world,
     ecs_id_record_t *idr)
 {
+    if (idr->dont_fragment_tr) {
+        flecs_id_record_fini_dont_fragment(world, idr);
+    }
+
     if (idr->sparse) {
         if (idr->flags & EcsIdIsSparse) {
             ecs_assert(flecs_sparse_count(idr->sparse) == 0, 
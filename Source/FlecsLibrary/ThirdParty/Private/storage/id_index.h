@@ -47,6 +47,10 @@ struct ecs_id_record_t {
     /* Storage for sparse components or union relationships */
     void *sparse;
 
+    /* Table record used for fields and hooks of DontFragment components, 
+     * which are not stored in tables. */
+    ecs_table_record_t *dont_fragment_tr;
+
     /* Lists for all id records that match a pair wildcard. The wildcard id
      * record is at the head of the list. */
     ecs_id_record_elem_t first;   /* (R, *) */
@@ -129,6 +133,11 @@ void flecs_id_record_init_sparse(
     ecs_world_t *world,
     ecs_id_record_t *idr);
 
+/* Init storage for DontFragment component */
+void flecs_id_record_init_dont_fragment(
+    ecs_world_t *world,
+    ecs_id_record_t *idr);
+
 /* Bootstrap cached id records */
 void flecs_init_id_records(
     ecs_world_t *world);
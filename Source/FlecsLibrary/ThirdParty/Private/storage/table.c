@@ -540,6 +540,8 @@ void flecs_table_init(
         tr = &dst_tr[i];
         idr = (ecs_id_record_t*)dst_tr[i].hdr.cache;
         ecs_assert(idr != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_assert(!(idr->flags & EcsIdDontFragment), ECS_INTERNAL_ERROR,
+            "DontFragment components can't be added to tables");
 
         if (ecs_table_cache_get(&idr->cache, table)) {
             /* If this is a target wildcard record it has already been 
@@ -788,6 +790,16 @@ void flecs_table_invoke_remove_hooks(
     }
 }
 
+/* Whether the dtor of a column can be deferred to after the table is cleared,
+ * where it may run on a worker thread */
+static
+bool flecs_table_column_defer_dtor(
+    const ecs_column_t *column)
+{
+    const ecs_type_hooks_t *hooks = &column->ti->hooks;
+    return hooks->dtor && (hooks->flags & ECS_TYPE_HOOK_DTOR_THREAD_SAFE);
+}
+
 /* Destruct all components and/or delete all entities in table in range */
 static
 void flecs_table_dtor_all(
@@ -795,7 +807,8 @@ void flecs_table_dtor_all(
     ecs_table_t *table,
     int32_t row,
     int32_t count,
-    bool is_delete)
+    bool is_delete,
+    bool defer_dtor)
 {
     const ecs_entity_t *entities = ecs_table_entities(table);
     const int32_t column_count = table->column_count;
@@ -810,6 +823,19 @@ void flecs_table_dtor_all(
         flecs_emit_propagate_invalidate(world, table, row, count);
     }
 
+    /* Remove values of DontFragment components, which aren't stored in the
+     * table. During world cleanup the values are freed with the storage. */
+    if (ecs_vec_count(&world->store.dont_fragment) && 
+        !(world->flags & EcsWorldFini)) 
+    {
+        for (i = row; i < end; i ++) {
+            ecs_record_t *record = flecs_entities_get(world, entities[i]);
+            if (record && (record->row & EcsEntityHasDontFragment)) {
+                flecs_dont_fragment_clear(world, entities[i], record);
+            }
+        }
+    }
+
     /* If table has components with destructors, iterate component columns */
     if (table->flags & EcsTableHasDtors) {
         /* Throw up a lock just to be sure */
@@ -825,9 +851,13 @@ void flecs_table_dtor_all(
             }
         }
 
-        /* Destruct components */
+        /* Destruct components, unless the storage is destructed later */
         for (c = 0; c < column_count; c++) {
-            flecs_table_invoke_dtor(&table->data.columns[c], row, count);
+            ecs_column_t *column = &table->data.columns[c];
+            if (defer_dtor && flecs_table_column_defer_dtor(column)) {
+                continue;
+            }
+            flecs_table_invoke_dtor(column, row, count);
         }
 
         /* Iterate entities first, then components. This ensures that only one
@@ -887,7 +917,8 @@ void flecs_table_fini_data(
     bool do_on_remove,
     bool is_delete,
     bool deactivate,
-    bool deallocate)
+    bool deallocate,
+    bool defer_dtor)
 {
     ecs_assert(!table->_->lock, ECS_LOCKED_STORAGE, FLECS_LOCKED_STORAGE_MSG);
 
@@ -896,8 +927,9 @@ void flecs_table_fini_data(
     }
 
     const int32_t count = ecs_table_count(table);
+    defer_dtor &= deallocate && count && (table->flags & EcsTableHasDtors);
     if (count) {
-        flecs_table_dtor_all(world, table, 0, count, is_delete);
+        flecs_table_dtor_all(world, table, 0, count, is_delete, defer_dtor);
     }
 
     if (deallocate) {
@@ -906,6 +938,20 @@ void flecs_table_fini_data(
             const int32_t column_count = table->column_count;
             for (int32_t c = 0; c < column_count; c ++) {
                 ecs_column_t *column = &columns[c];
+                if (defer_dtor && flecs_table_column_defer_dtor(column)) {
+                    /* Hand storage to the world, which destructs and frees it
+                     * after all tables of the cleanup action are cleared */
+                    ecs_deleted_column_t *dc = ecs_vec_append_t(
+                        &world->allocator, &world->store.deleted_columns,
+                        ecs_deleted_column_t);
+                    dc->ti = column->ti;
+                    dc->data = column->data;
+                    dc->count = count;
+                    dc->size = table->data.size;
+                    column->data = NULL;
+                    continue;
+                }
+
                 ecs_vec_t v = ecs_vec_from_column(column, table, column->ti->size);
                 ecs_vec_fini(&world->allocator, &v, column->ti->size);
                 column->data = NULL;
@@ -965,7 +1011,7 @@ void ecs_table_clear_entities(
     ecs_world_t* world,
     ecs_table_t* table)
 {
-    flecs_table_fini_data(world, table, true, true, true, false);
+    flecs_table_fini_data(world, table, true, true, true, false, false);
 }
 
 /* Cleanup, no OnRemove, clear entity index, deactivate table, free allocations */
@@ -973,7 +1019,7 @@ void flecs_table_clear_entities_silent(
     ecs_world_t *world,
     ecs_table_t *table)
 {
-    flecs_table_fini_data(world, table, false, false, true, true);
+    flecs_table_fini_data(world, table, false, false, true, true, false);
 }
 
 /* Cleanup, run OnRemove, clear entity index, deactivate table, free allocations */
@@ -981,15 +1027,18 @@ void flecs_table_clear_entities(
     ecs_world_t *world,
     ecs_table_t *table)
 {
-    flecs_table_fini_data(world, table, true, false, true, true);
+    flecs_table_fini_data(world, table, true, false, true, true, false);
 }
 
-/* Cleanup, run OnRemove, delete from entity index, deactivate table, free allocations */
+/* Cleanup, run OnRemove, delete from entity index, deactivate table, free allocations.
+ * If defer_dtor is true, storage with thread safe destructors is moved to
+ * deleted_columns. */
 void flecs_table_delete_entities(
     ecs_world_t *world,
-    ecs_table_t *table)
+    ecs_table_t *table,
+    bool defer_dtor)
 {
-    flecs_table_fini_data(world, table, true, true, true, true);
+    flecs_table_fini_data(world, table, true, true, true, true, defer_dtor);
 }
 
 /* Unset all components in table. This function is called before a table is 
@@ -1036,8 +1085,9 @@ void flecs_table_fini(
     world->info.empty_table_count -= (ecs_table_count(table) == 0);
 
     /* Cleanup data, no OnRemove, delete from entity index, don't deactivate */
-    flecs_table_fini_data(world, table, false, true, false, true);
+    flecs_table_fini_data(world, table, false, true, false, true, false);
     flecs_table_clear_edges(world, table);
+    flecs_trav_up_cache_table_fini(world, table);
 
     if (!is_root) {
         const ecs_type_t ids = {
@@ -259,7 +259,8 @@ void flecs_table_notify(
 
 void flecs_table_delete_entities(
     ecs_world_t *world,
-    ecs_table_t *table);
+    ecs_table_t *table,
+    bool defer_dtor);
 
 /* Increase observer count of table */
 void flecs_table_traversable_add(
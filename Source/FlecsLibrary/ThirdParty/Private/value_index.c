@@ -0,0 +1,468 @@
+/**
+ * @file value_index.c
+ * @brief Index that maps component values to entities.
+ *
+ * A value index stores a map from the hash of a key to the entities with a
+ * component value that has that key. A second map stores the hash of the
+ * current key of each entity, so that an entity can be removed from its old
+ * bucket when its value changes or the component is removed.
+ *
+ * Lookups compare the key with the current component value of the entities in
+ * a bucket. This resolves hash collisions, and guarantees that an entity is
+ * not returned for a key it no longer has.
+ */
+
+#include "private_api.h"
+
+typedef struct ecs_value_index_t {
+    ecs_world_t *world;
+    ecs_entity_t component;
+    ecs_size_t size;                  /* Size of component */
+    ecs_size_t offset;                /* Offset of key in component value */
+    ecs_size_t key_size;              /* Size of key (for bytewise keys) */
+    bool key_is_string;               /* Key is a string member */
+    ecs_hash_value_action_t hash;     /* Hash of component value (optional) */
+    ecs_compare_action_t compare;     /* Compare component values (optional) */
+    ecs_map_t buckets;                /* map<key hash, ecs_vec_t<ecs_entity_t>*> */
+    ecs_map_t entities;               /* map<entity, key hash> */
+} ecs_value_index_t;
+
+static
+const void* flecs_value_index_key(
+    const ecs_value_index_t *index,
+    const void *value)
+{
+    return ECS_OFFSET(value, index->offset);
+}
+
+static
+uint64_t flecs_value_index_hash(
+    const ecs_value_index_t *index,
+    const void *key)
+{
+    if (index->hash) {
+        return index->hash(key);
+    }
+
+    if (index->key_is_string) {
+        const char *str = *(char* const*)key;
+        if (!str) {
+            return 0;
+        }
+        return flecs_hash(str, ecs_os_strlen(str));
+    }
+
+    return flecs_hash(key, index->key_size);
+}
+
+static
+bool flecs_value_index_equals(
+    const ecs_value_index_t *index,
+    const void *key_1,
+    const void *key_2)
+{
+    if (index->compare) {
+        return index->compare(key_1, key_2) == 0;
+    }
+
+    if (index->key_is_string) {
+        const char *str_1 = *(char* const*)key_1;
+        const char *str_2 = *(char* const*)key_2;
+        if (!str_1 || !str_2) {
+            return str_1 == str_2;
+        }
+        return ecs_os_strcmp(str_1, str_2) == 0;
+    }
+
+    return ecs_os_memcmp(key_1, key_2, index->key_size) == 0;
+}
+
+static
+void flecs_value_index_remove(
+    ecs_value_index_t *index,
+    ecs_entity_t entity)
+{
+    ecs_map_val_t *hash_ptr = ecs_map_get(&index->entities, entity);
+    if (!hash_ptr) {
+        return;
+    }
+
+    ecs_map_key_t hash = hash_ptr[0];
+    ecs_map_remove(&index->entities, entity);
+
+    ecs_vec_t *bucket = ecs_map_get_deref(&index->buckets, ecs_vec_t, hash);
+    ecs_assert(bucket != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_entity_t *entities = ecs_vec_first_t(bucket, ecs_entity_t);
+    int32_t i, count = ecs_vec_count(bucket);
+    for (i = 0; i < count; i ++) {
+        if (entities[i] == entity) {
+            /* Preserve order, so that lookups for keys that are shared by
+             * multiple entities keep returning the same entity. */
+            ecs_os_memmove_n(&entities[i], &entities[i + 1], ecs_entity_t,
+                count - i - 1);
+            ecs_vec_remove_last(bucket);
+            break;
+        }
+    }
+
+    if (!ecs_vec_count(bucket)) {
+        ecs_allocator_t *a = &index->world->allocator;
+        ecs_vec_fini_t(a, bucket, ecs_entity_t);
+        flecs_free_t(a, ecs_vec_t, bucket);
+        ecs_map_remove(&index->buckets, hash);
+    }
+}
+
+static
+void flecs_value_index_insert(
+    ecs_value_index_t *index,
+    ecs_entity_t entity,
+    const void *value)
+{
+    uint64_t hash = flecs_value_index_hash(index,
+        flecs_value_index_key(index, value));
+
+    ecs_map_val_t *hash_ptr = ecs_map_get(&index->entities, entity);
+    if (hash_ptr) {
+        if (hash_ptr[0] == hash) {
+            /* Entity is already in the right bucket */
+            return;
+        }
+        flecs_value_index_remove(index, entity);
+    }
+
+    ecs_allocator_t *a = &index->world->allocator;
+    ecs_vec_t **bucket = (ecs_vec_t**)ecs_map_ensure(&index->buckets, hash);
+    if (!bucket[0]) {
+        bucket[0] = flecs_calloc_t(a, ecs_vec_t);
+        ecs_vec_init_t(a, bucket[0], ecs_entity_t, 1);
+    }
+
+    ecs_vec_append_t(a, bucket[0], ecs_entity_t)[0] = entity;
+    ecs_map_insert(&index->entities, entity, hash);
+}
+
+static
+void flecs_value_index_insert_n(
+    ecs_value_index_t *index,
+    const ecs_entity_t *entities,
+    const void *values,
+    int32_t count)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        flecs_value_index_insert(index, entities[i],
+            ECS_ELEM(values, index->size, i));
+    }
+}
+
+static
+void flecs_value_index_observer(
+    ecs_iter_t *it)
+{
+    ecs_value_index_t *index = it->ctx;
+
+    /* Don't bother keeping the index up to date while the world is deleted */
+    if (it->real_world->flags & EcsWorldFini) {
+        return;
+    }
+
+    if (it->event == EcsOnRemove) {
+        int32_t i;
+        for (i = 0; i < it->count; i ++) {
+            flecs_value_index_remove(index, it->entities[i]);
+        }
+    } else {
+        const void *values = ecs_field_w_size(
+            it, flecs_uto(size_t, index->size), 0);
+        ecs_assert(values != NULL, ECS_INTERNAL_ERROR, NULL);
+        flecs_value_index_insert_n(index, it->entities, values, it->count);
+    }
+}
+
+static
+void flecs_value_index_free(
+    void *ctx)
+{
+    ecs_value_index_t *index = ctx;
+    ecs_world_t *world = index->world;
+    ecs_allocator_t *a = &world->allocator;
+
+    ecs_map_remove(&world->value_indexes, index->component);
+
+    ecs_map_iter_t it = ecs_map_iter(&index->buckets);
+    while (ecs_map_next(&it)) {
+        ecs_vec_t *bucket = ecs_map_ptr(&it);
+        ecs_vec_fini_t(a, bucket, ecs_entity_t);
+        flecs_free_t(a, ecs_vec_t, bucket);
+    }
+
+    ecs_map_fini(&index->buckets);
+    ecs_map_fini(&index->entities);
+    flecs_free_t(a, ecs_value_index_t, index);
+}
+
+static
+int flecs_value_index_init_member(
+    ecs_world_t *world,
+    ecs_value_index_t *index,
+    ecs_entity_t member)
+{
+#ifdef FLECS_META
+    const EcsMember *m = ecs_get(world, member, EcsMember);
+    ecs_check(m != NULL, ECS_INVALID_PARAMETER,
+        "index member is not a member entity");
+    ecs_check(ecs_get_parent(world, member) == index->component,
+        ECS_INVALID_PARAMETER, "index member is not a member of component");
+
+    const EcsComponent *type = ecs_get(world, m->type, EcsComponent);
+    ecs_check(type != NULL, ECS_INVALID_PARAMETER,
+        "type of index member is not a type");
+
+    const EcsPrimitive *p = ecs_get(world, m->type, EcsPrimitive);
+    ecs_check(p || ecs_has(world, m->type, EcsEnum) ||
+        ecs_has(world, m->type, EcsBitmask), ECS_INVALID_PARAMETER,
+            "index member must have a primitive, enum or bitmask type");
+
+    int32_t count = m->count ? m->count : 1;
+    index->offset = m->offset;
+    index->key_size = type->size * count;
+    if (p && p->kind == EcsString) {
+        ecs_check(count == 1, ECS_INVALID_PARAMETER,
+            "index member cannot be a string array");
+        index->key_is_string = true;
+    }
+
+    return 0;
+error:
+    return -1;
+#else
+    (void)world;
+    (void)index;
+    (void)member;
+    ecs_err("index member requires FLECS_META addon");
+    return -1;
+#endif
+}
+
+ecs_entity_t ecs_value_index_init(
+    ecs_world_t *world,
+    const ecs_value_index_desc_t *desc)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    ecs_check(desc != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(desc->_canary == 0, ECS_INVALID_PARAMETER,
+        "ecs_value_index_desc_t was not initialized to zero");
+    ecs_check(!(world->flags & EcsWorldReadonly), ECS_INVALID_OPERATION,
+        "cannot create value index while world is readonly");
+    ecs_check(desc->component != 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!desc->hash == !desc->compare, ECS_INVALID_PARAMETER,
+        "hash and compare must be provided together");
+    ecs_check(!desc->member || !desc->hash, ECS_INVALID_PARAMETER,
+        "value index can't have both a member and a hash function");
+
+    ecs_entity_t component = desc->component;
+    ecs_check(!ecs_map_get(&world->value_indexes, component),
+        ECS_INVALID_OPERATION, "component already has a value index");
+
+    const ecs_type_info_t *ti = ecs_get_type_info(world, component);
+    ecs_check(ti != NULL, ECS_INVALID_PARAMETER,
+        "value index can only be created for components");
+
+    ecs_allocator_t *a = &world->allocator;
+    ecs_value_index_t *index = flecs_calloc_t(a, ecs_value_index_t);
+    index->world = world;
+    index->component = component;
+    index->size = ti->size;
+    index->key_size = ti->size;
+    index->hash = desc->hash;
+    index->compare = desc->compare;
+    ecs_map_init(&index->buckets, a);
+    ecs_map_init(&index->entities, a);
+
+    if (desc->member) {
+        if (flecs_value_index_init_member(world, index, desc->member)) {
+            flecs_value_index_free(index);
+            return 0;
+        }
+    }
+
+    /* Register index before creating the observer, which takes ownership of
+     * the index and removes it from the world when it is deleted. */
+    ecs_map_insert_ptr(&world->value_indexes, component, index);
+
+    ecs_entity_t result = ecs_observer_init(world, &(ecs_observer_desc_t){
+        .entity = desc->entity,
+        .query.terms = {{
+            .id = component, .src.id = EcsSelf, .inout = EcsIn
+        }},
+        .query.flags = EcsQueryMatchPrefab|EcsQueryMatchDisabled,
+        .events = { EcsOnSet, EcsOnRemove },
+        .callback = flecs_value_index_observer,
+        .ctx = index,
+        .ctx_free = flecs_value_index_free
+    });
+
+    if (!result) {
+        if (ecs_map_get(&world->value_indexes, component)) {
+            flecs_value_index_free(index);
+        }
+        return 0;
+    }
+
+    /* Populate index with existing component values */
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ .id = component, .src.id = EcsSelf, .inout = EcsIn }},
+        .flags = EcsQueryMatchPrefab|EcsQueryMatchDisabled
+    });
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    while (ecs_query_next(&it)) {
+        const void *values = ecs_field_w_size(
+            &it, flecs_uto(size_t, index->size), 0);
+        flecs_value_index_insert_n(index, it.entities, values, it.count);
+    }
+
+    ecs_query_fini(q);
+
+    return result;
+error:
+    return 0;
+}
+
+static
+const ecs_value_index_t* flecs_value_index_get(
+    const ecs_world_t *world,
+    ecs_entity_t component)
+{
+    const ecs_value_index_t *index = ecs_map_get_deref(
+        &world->value_indexes, ecs_value_index_t, component);
+    ecs_check(index != NULL, ECS_INVALID_PARAMETER,
+        "component does not have a value index");
+    return index;
+error:
+    return NULL;
+}
+
+/* Returns whether the current value of an entity in a bucket has the key. */
+static
+bool flecs_value_index_match(
+    const ecs_world_t *world,
+    const ecs_value_index_t *index,
+    ecs_entity_t entity,
+    const void *key)
+{
+    const void *value = ecs_get_id(world, entity, index->component);
+    if (!value) {
+        return false;
+    }
+
+    return flecs_value_index_equals(index,
+        flecs_value_index_key(index, value), key);
+}
+
+ecs_entity_t ecs_lookup_by_value(
+    const ecs_world_t *world,
+    ecs_entity_t component,
+    const void *key)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(component != 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(key != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    const ecs_value_index_t *index = flecs_value_index_get(world, component);
+    if (!index) {
+        return 0;
+    }
+
+    const ecs_vec_t *bucket = ecs_map_get_deref(&index->buckets, ecs_vec_t,
+        flecs_value_index_hash(index, key));
+    if (!bucket) {
+        return 0;
+    }
+
+    const ecs_entity_t *entities = ecs_vec_first_t(bucket, ecs_entity_t);
+    int32_t i, count = ecs_vec_count(bucket);
+    for (i = 0; i < count; i ++) {
+        if (flecs_value_index_match(world, index, entities[i], key)) {
+            return entities[i];
+        }
+    }
+
+error:
+    return 0;
+}
+
+ecs_entity_t ecs_iter_set_var_by_value(
+    ecs_iter_t *it,
+    int32_t var_id,
+    ecs_entity_t component,
+    const void *key)
+{
+    ecs_check(it != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(it->next == ecs_query_next, ECS_INVALID_PARAMETER,
+        "iterator is not a query iterator");
+    ecs_check(!(it->flags & EcsIterIsValid), ECS_INVALID_PARAMETER,
+        "cannot constrain variable while iterating");
+    ecs_check(key != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    const ecs_world_t *world = it->real_world;
+    const ecs_value_index_t *index = flecs_value_index_get(world, component);
+    if (!index) {
+        return 0;
+    }
+
+    const ecs_vec_t *bucket = ecs_map_get_deref(&index->buckets, ecs_vec_t,
+        flecs_value_index_hash(index, key));
+
+    /* Find all entities with the key, skipping hash collisions */
+    int32_t i, count = 0, bucket_count = bucket ? ecs_vec_count(bucket) : 0;
+    const ecs_entity_t *entities = bucket ? 
+        ecs_vec_first_t(bucket, ecs_entity_t) : NULL;
+    for (i = 0; i < bucket_count; i ++) {
+        count += flecs_value_index_match(world, index, entities[i], key);
+    }
+
+    if (!count) {
+        /* No entity has the key, so the query can't have results */
+        it->flags |= EcsIterNoResults;
+        return 0;
+    }
+
+    ecs_entity_t first = 0;
+    ecs_query_iter_t *qit = &it->priv_.iter.query;
+    if (count > 1) {
+        /* The query is evaluated for each entity, which happens when the
+         * iterator runs out of results for the previous entity. */
+        ecs_entity_t *value_entities = flecs_iter_calloc_n(
+            it, ecs_entity_t, count);
+        int32_t cur = 0;
+        for (i = 0; i < bucket_count; i ++) {
+            if (flecs_value_index_match(world, index, entities[i], key)) {
+                value_entities[cur ++] = entities[i];
+            }
+        }
+
+        qit->value_entities = value_entities;
+        qit->value_count = count;
+        qit->value_cur = 1;
+        qit->value_var = var_id;
+        first = value_entities[0];
+    } else {
+        for (i = 0; i < bucket_count; i ++) {
+            if (flecs_value_index_match(world, index, entities[i], key)) {
+                first = entities[i];
+                break;
+            }
+        }
+    }
+
+    ecs_iter_set_var(it, var_id, first);
+
+    return first;
+error:
+    return 0;
+}
@@ -95,6 +95,7 @@ const ecs_entity_t EcsPanic =                       FLECS_HI_COMPONENT_ID + 54;
 /* Storage */
 const ecs_entity_t EcsSparse =                      FLECS_HI_COMPONENT_ID + 55;
 const ecs_entity_t EcsUnion =                       FLECS_HI_COMPONENT_ID + 56;
+const ecs_entity_t EcsDontFragment =                FLECS_HI_COMPONENT_ID + 121;
 
 /* Misc */
 const ecs_entity_t ecs_id(EcsDefaultChildComponent) = FLECS_HI_COMPONENT_ID + 57;
@@ -588,6 +589,8 @@ void flecs_init_store(
     ecs_vec_init_t(a, &world->store.records, ecs_table_record_t, 0);
     ecs_vec_init_t(a, &world->store.marked_ids, ecs_marked_id_t, 0);
     ecs_vec_init_t(a, &world->store.deleted_components, ecs_entity_t, 0);
+    ecs_vec_init_t(a, &world->store.deleted_columns, ecs_deleted_column_t, 0);
+    ecs_vec_init_t(a, &world->store.dont_fragment, ecs_id_record_t*, 0);
 
     /* Initialize entity index */
     flecs_entities_init(world);
@@ -742,11 +745,15 @@ void flecs_fini_store(ecs_world_t *world) {
         ECS_INTERNAL_ERROR, NULL);
     ecs_assert(ecs_vec_count(&world->store.deleted_components) == 0, 
         ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(ecs_vec_count(&world->store.deleted_columns) == 0, 
+        ECS_INTERNAL_ERROR, NULL);
 
     ecs_allocator_t *a = &world->allocator;
     ecs_vec_fini_t(a, &world->store.records, ecs_table_record_t);
     ecs_vec_fini_t(a, &world->store.marked_ids, ecs_marked_id_t);
     ecs_vec_fini_t(a, &world->store.deleted_components, ecs_entity_t);
+    ecs_vec_fini_t(a, &world->store.deleted_columns, ecs_deleted_column_t);
+    ecs_vec_fini_t(a, &world->store.dont_fragment, ecs_id_record_t*);
 }
 
 static 
@@ -829,6 +836,9 @@ static const char *flecs_addons_info[] = {
 #ifdef FLECS_ALERTS
     "FLECS_ALERTS",
 #endif
+#ifdef FLECS_SPATIAL
+    "FLECS_SPATIAL",
+#endif
 #ifdef FLECS_SYSTEM
     "FLECS_SYSTEM",
 #endif
@@ -983,6 +993,10 @@ ecs_world_t *ecs_mini(void) {
 
     flecs_name_index_init(&world->aliases, a);
     flecs_name_index_init(&world->symbols, a);
+    ecs_map_init(&world->path_cache, a);
+    ecs_map_init(&world->path_cache_refs, a);
+    ecs_map_init(&world->trav_up_cache, a);
+    ecs_map_init(&world->value_indexes, a);
     ecs_vec_init_t(a, &world->fini_actions, ecs_action_elem_t, 0);
     ecs_vec_init_t(a, &world->component_ids, ecs_id_t, 0);
 
@@ -1659,6 +1673,9 @@ int ecs_fini(
     flecs_observable_fini(&world->observable);
     flecs_name_index_fini(&world->aliases);
     flecs_name_index_fini(&world->symbols);
+    flecs_path_cache_fini(world);
+    flecs_trav_up_cache_fini(world);
+    ecs_map_fini(&world->value_indexes);
     ecs_set_stage_count(world, 0);
     ecs_vec_fini_t(&world->allocator, &world->component_ids, ecs_id_t);
     ecs_log_pop_1();
@@ -1724,6 +1741,30 @@ error:
     return;
 }
 
+void ecs_enable_trav_cache(
+    ecs_world_t *world,
+    bool enable)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    ecs_check(!(world->flags & EcsWorldMultiThreaded), 
+        ECS_INVALID_OPERATION, 
+            "cannot toggle traversal cache while world is multithreaded");
+    if (!enable) {
+        flecs_trav_up_cache_clear(world);
+    }
+    ECS_BIT_COND(world->flags, EcsWorldTravCache, enable);
+error:
+    return;
+}
+
+void ecs_enable_threaded_dtors(
+    ecs_world_t *world,
+    bool enable)
+{
+    flecs_poly_assert(world, ecs_world_t);
+    ECS_BIT_COND(world->flags, EcsWorldThreadedDtors, enable);
+}
+
 void ecs_set_target_fps(
     ecs_world_t *world,
     ecs_ftime_t fps)
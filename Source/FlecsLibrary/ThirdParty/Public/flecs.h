@@ -194,6 +194,16 @@
  */
 // #define FLECS_CPP_NO_AUTO_REGISTRATION
 
+/** @def FLECS_MAP_OPEN_ADDRESSING
+ * Replaces the chained hash table behind ecs_map_t with an open addressing
+ * table. Lookups compare a group of 16 control bytes at a time using SSE2 or
+ * NEON (with a scalar fallback) instead of walking bucket chains. Elements are
+ * stored in separately allocated entries like the chained map, so pointers to
+ * map values remain valid when the map grows.
+ * The ecs_map_* API is the same for both implementations.
+ */
+// #define FLECS_MAP_OPEN_ADDRESSING
+
 #define FLECS_NO_OS_API_IMPL
 
 #ifndef FLECS_CUSTOM_BUILD
@@ -214,6 +224,7 @@
 #define FLECS_PIPELINE       /**< Pipeline support */
 #define FLECS_REST           /**< REST API for querying application data */
 #define FLECS_SCRIPT         /**< Flecs entity notation language */
+#define FLECS_SPATIAL        /**< Spatial index for range and nearest queries */
 // #define FLECS_SCRIPT_MATH /**< Math functions for flecs script (may require linking with libm) */
 #define FLECS_SYSTEM         /**< System support */
 #define FLECS_STATS          /**< Track runtime statistics */
@@ -941,6 +952,10 @@ struct ecs_observer_t {
 #define ECS_TYPE_HOOK_CTOR_MOVE_DTOR_ILLEGAL (1 << 14)
 #define ECS_TYPE_HOOK_MOVE_DTOR_ILLEGAL      (1 << 15)
 
+/* Flag that can be set to indicate that the dtor of a type does not access the
+ * world, and can run on a worker thread. See ecs_enable_threaded_dtors(). */
+#define ECS_TYPE_HOOK_DTOR_THREAD_SAFE       (1 << 16)
+
 /* All valid hook flags */
 #define ECS_TYPE_HOOKS (ECS_TYPE_HOOK_CTOR|ECS_TYPE_HOOK_DTOR|\
     ECS_TYPE_HOOK_COPY|ECS_TYPE_HOOK_MOVE|ECS_TYPE_HOOK_COPY_CTOR|\
@@ -1438,6 +1453,34 @@ typedef struct ecs_event_desc_t {
     ecs_flags32_t flags;
 } ecs_event_desc_t;
 
+/** Used with ecs_value_index_init().
+ *
+ * @ingroup value_index
+ */
+typedef struct ecs_value_index_desc_t {
+    /** Used for validity testing. Must be 0. */
+    int32_t _canary;
+
+    /** Existing entity to associate with the index (optional) */
+    ecs_entity_t entity;
+
+    /** Component to index */
+    ecs_entity_t component;
+
+    /** Member of the component that is used as key. The member type must be a
+     * primitive type, an entity or a string. Requires the meta addon. */
+    ecs_entity_t member;
+
+    /** Hash function for component values. When set, the key passed to
+     * ecs_lookup_by_value() is a value of the component type. Must be set
+     * together with compare. */
+    ecs_hash_value_action_t hash;
+
+    /** Compare function for component values. Must return 0 when the keys of
+     * two component values are equal. */
+    ecs_compare_action_t compare;
+} ecs_value_index_desc_t;
+
 
 /**
  * @defgroup misc_types Miscellaneous types
@@ -1885,6 +1928,13 @@ FLECS_API extern const ecs_entity_t EcsSparse;
 /** Mark relationship as union */
 FLECS_API extern const ecs_entity_t EcsUnion;
 
+/** Mark component as non-fragmenting.
+ * Values of a DontFragment component are stored in a sparse set that is keyed
+ * by entity. Adding or removing the component does not move the entity to a
+ * different table, which makes it cheap to toggle. Queries iterate the dense
+ * array of the sparse set to find entities with the component. */
+FLECS_API extern const ecs_entity_t EcsDontFragment;
+
 /** Marker used to indicate `$var == ...` matching in queries. */
 FLECS_API extern const ecs_entity_t EcsPredEq;
 
@@ -2004,6 +2054,46 @@ FLECS_API
 bool ecs_is_fini(
     const ecs_world_t *world);
 
+/** Copy the entities of a world into another world.
+ * This operation copies the entities, components and tables of the source world
+ * into the destination world, so that the destination world does not have to
+ * repeat the work that created them. Entities keep their ids, component values
+ * of a table are copied per column with the copy hook of the component, or with
+ * memcpy if the component doesn't have one.
+ *
+ * The operation is intended for creating many worlds from a template world,
+ * and has the following limitations:
+ * - The destination world must be created in the same way as the source world
+ *   (for example with ecs_init()), so that builtin entities have the same ids.
+ * - Entities that already exist in the destination world are not copied.
+ * - Queries, observers and systems are not copied. Entities that depend on
+ *   them, or that have a component with a destructor but no copy hook, are not
+ *   copied either.
+ * - Prefab instances are copied as is, prefab children are not instantiated
+ *   again.
+ * - Component hooks share their context with the source world, which must
+ *   outlive the worlds that are copied from it.
+ *
+ * @param dst The world to copy into.
+ * @param src The world to copy from.
+ * @return Zero if successful, non-zero if failed.
+ */
+FLECS_API
+int ecs_world_clone_into(
+    ecs_world_t *dst,
+    const ecs_world_t *src);
+
+/** Create a new world from a template world.
+ * Same as ecs_init() followed by ecs_world_clone_into(). The template world
+ * must be created with ecs_init().
+ *
+ * @param src The template world.
+ * @return A new world, or NULL if failed.
+ */
+FLECS_API
+ecs_world_t* ecs_world_clone(
+    const ecs_world_t *src);
+
 /** Register action to be executed when world is destroyed.
  * Fini actions are typically used when a module needs to clean up before a
  * world shuts down.
@@ -2167,6 +2257,53 @@ FLECS_API void ecs_measure_system_time(
     ecs_world_t *world,
     bool enable);
 
+/** Enable/disable the world traversal cache.
+ * Query terms that traverse upwards (like `Position(up)` or components that
+ * are inherited from a prefab) by default cache traversal results only for the
+ * duration of a single iterator. This means that each iteration of such a
+ * query traverses the hierarchy again.
+ *
+ * When the traversal cache is enabled, results are stored in a world-level
+ * cache keyed by table, relationship and component, which is shared by all
+ * queries. Cached results for a table are invalidated when an entity that is
+ * reachable from the table through a traversable relationship changes tables
+ * or is deleted.
+ *
+ * The cache is only written to when the world is not in multithreaded mode.
+ * Disabling the cache frees all cached results.
+ *
+ * @param world The world.
+ * @param enable Whether to enable or disable the traversal cache.
+ */
+FLECS_API
+void ecs_enable_trav_cache(
+    ecs_world_t *world,
+    bool enable);
+
+/** Enable/disable threaded destructors for cleanup actions.
+ * When enabled, cleanup actions that delete tables, like deleting the
+ * children of a parent or ecs_delete_with(), run the destructors of deleted
+ * components after all tables are cleared. The destructors are split up
+ * between the calling thread and the worker stages of the world.
+ *
+ * Only components with the ECS_TYPE_HOOK_DTOR_THREAD_SAFE hook flag are
+ * destructed this way. Their destructors run after OnRemove observers and
+ * hooks, and must not access the world. Other components are destructed on
+ * the calling thread, in the same order as when the feature is disabled.
+ *
+ * Workers are only used when they are idle, which is the case between frames
+ * and during merges. Otherwise destructors run on the calling thread.
+ *
+ * Threaded destructors are disabled by default.
+ *
+ * @param world The world.
+ * @param enable Whether to enable or disable threaded destructors.
+ */
+FLECS_API
+void ecs_enable_threaded_dtors(
+    ecs_world_t *world,
+    bool enable);
+
 /** Set target frames per second (FPS) for application.
  * Setting the target FPS ensures that ecs_progress() is not invoked faster than
  * the specified FPS. When enabled, ecs_progress() tracks the time passed since
@@ -2874,6 +3011,28 @@ const ecs_entity_t* ecs_bulk_new_w_id(
     ecs_id_t id,
     int32_t count);
 
+/** Create N instances of a prefab.
+ * This operation creates N entities with an IsA relationship to the prefab.
+ * The prefab hierarchy is instantiated for all instances at once: the layout
+ * of each prefab child table is computed once, and the children of each
+ * prefab child are instantiated for all instances in a single pass. Component
+ * values are copied per column, and OnAdd/OnSet events are emitted per batch
+ * of instances.
+ *
+ * When the world is deferred, the instances are created when the command queue
+ * is flushed.
+ *
+ * @param world The world.
+ * @param prefab The prefab to instantiate.
+ * @param count The number of instances to create.
+ * @return Array with the ids of the created instances, NULL if count is 0.
+ */
+FLECS_API
+const ecs_entity_t* ecs_instantiate_n(
+    ecs_world_t *world,
+    ecs_entity_t prefab,
+    int32_t count);
+
 /** Clone an entity
  * This operation clones the components of one entity into another entity. If
  * no destination entity is provided, a new entity will be created. Component
@@ -3990,6 +4149,9 @@ ecs_entity_t ecs_lookup_child(
  * the entity is still not found, the lookup will search in the flecs.core
  * scope. If the entity is not found there either, the function returns 0.
  *
+ * Lookups from the root (no parent and no scope) are cached, which makes
+ * repeated lookups of the same path constant time.
+ *
  * @param world The world.
  * @param parent The entity from which to resolve the path.
  * @param path The path to resolve.
@@ -4011,6 +4173,56 @@ ecs_entity_t ecs_lookup_path_w_sep(
     const char *prefix,
     bool recursive);
 
+/** Compute hash for a path lookup.
+ * The returned hash can be passed to ecs_lookup_hashed(). Applications that
+ * repeatedly lookup the same path can compute the hash once, which avoids
+ * hashing and tokenizing the path string on each lookup.
+ *
+ * @param path The entity path.
+ * @param sep The path separator (NULL for ".").
+ * @param prefix The path prefix.
+ * @return The hash for the path lookup.
+ *
+ * @see ecs_lookup_hashed()
+ */
+FLECS_API
+uint64_t ecs_path_hash(
+    const char *path,
+    const char *sep,
+    const char *prefix);
+
+/** Lookup an entity from a path with a precomputed hash.
+ * Absolute path lookups (lookups from the root, without a scope or lookup path)
+ * are stored in a world-level cache. When the path is found in the cache, this
+ * operation returns the entity without doing any string operations. Cached
+ * paths that resolve through an entity are removed when the name or parent of
+ * that entity changes. Lookups with a scope or lookup path bypass the cache.
+ *
+ * If the path is not found in the cache, it is resolved as with
+ * ecs_lookup_path_w_sep() with parent 0 and recursive set to true, and the
+ * result is added to the cache. If path is NULL, only the cache is checked.
+ *
+ * Because a cache hit does not compare the path string, the hash must have
+ * been computed with ecs_path_hash() for the same path, sep and prefix.
+ *
+ * @param world The world.
+ * @param hash The hash computed by ecs_path_hash().
+ * @param path The entity path (optional).
+ * @param sep The path separator (NULL for ".").
+ * @param prefix The path prefix.
+ * @return The entity if found, else 0.
+ *
+ * @see ecs_path_hash()
+ * @see ecs_lookup_path_w_sep()
+ */
+FLECS_API
+ecs_entity_t ecs_lookup_hashed(
+    const ecs_world_t *world,
+    uint64_t hash,
+    const char *path,
+    const char *sep,
+    const char *prefix);
+
 /** Lookup an entity by its symbol name.
  * This looks up an entity by symbol stored in `(EcsIdentifier, EcsSymbol)`. The
  * operation does not take into account hierarchies.
@@ -4288,6 +4500,95 @@ const ecs_type_hooks_t* ecs_get_hooks_id(
 
 /** @} */
 
+/**
+ * @defgroup value_index Value indexes
+ * Functions for looking up entities by component value.
+ *
+ * @{
+ */
+
+/** Create an index on the values of a component.
+ * A value index maps the key of a component value to the entities that have
+ * the value, which allows for finding entities by component value without
+ * iterating all entities with the component.
+ *
+ * The key is determined by the descriptor:
+ * - If a member is provided, the key is the value of the member.
+ * - If a hash and compare function are provided, the key is computed from the
+ *   entire component value by these functions.
+ * - Otherwise the key is the entire component value, compared bytewise. This
+ *   only works for components without padding and pointers.
+ *
+ * The index is kept up to date by an observer for OnSet and OnRemove events,
+ * and is populated with existing component values when it is created. Values
+ * that are modified in place must be followed by ecs_modified(), as is the case
+ * for any OnSet observer. Only owned components are indexed.
+ *
+ * The index is associated with the observer entity, and is deleted when the
+ * entity is deleted. A component can have at most one index.
+ *
+ * @param world The world.
+ * @param desc Value index parameters.
+ * @return The index entity, or 0 if failed.
+ *
+ * @see ecs_lookup_by_value()
+ */
+FLECS_API
+ecs_entity_t ecs_value_index_init(
+    ecs_world_t *world,
+    const ecs_value_index_desc_t *desc);
+
+/** Lookup an entity by component value.
+ * This operation finds an entity with a component value that matches the
+ * provided key in the value index of the component. If more than one entity
+ * has the key, the entity that got the key first is returned.
+ *
+ * The key is a value of the type of the index member, or a value of the
+ * component type if the index has no member. The operation compares the key
+ * with the current component value of the entity, so an entity is never
+ * returned for a key it no longer has.
+ *
+ * @param world The world.
+ * @param component The indexed component.
+ * @param key Pointer to the key.
+ * @return The entity with the key, or 0 if not found.
+ *
+ * @see ecs_value_index_init()
+ */
+FLECS_API
+ecs_entity_t ecs_lookup_by_value(
+    const ecs_world_t *world,
+    ecs_entity_t component,
+    const void *key);
+
+/** Constrain a query variable to the entities with a component value.
+ * This operation looks up the entities with the key in the value index and
+ * assigns them to the variable with ecs_iter_set_var(), which seeds query
+ * evaluation with the entities instead of searching tables. When multiple
+ * entities have the key, the query is evaluated for each entity in turn. If no
+ * entity has the key, the iterator returns no results.
+ *
+ * Variable 0 is the $this variable, which constrains the query to the entities
+ * with the key.
+ *
+ * @param it The query iterator.
+ * @param var_id The variable to constrain.
+ * @param component The indexed component.
+ * @param key Pointer to the key.
+ * @return The first entity assigned to the variable, or 0 if not found.
+ *
+ * @see ecs_lookup_by_value()
+ * @see ecs_iter_set_var()
+ */
+FLECS_API
+ecs_entity_t ecs_iter_set_var_by_value(
+    ecs_iter_t *it,
+    int32_t var_id,
+    ecs_entity_t component,
+    const void *key);
+
+/** @} */
+
 /**
  * @defgroup ids Ids
  * Functions for working with `ecs_id_t`.
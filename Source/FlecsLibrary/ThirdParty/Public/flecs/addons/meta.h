@@ -944,6 +944,63 @@ double ecs_meta_ptr_to_float(
     ecs_primitive_kind_t type_kind,
     const void *ptr);
 
+/* Copy plans */
+
+/** Precompiled program that copies values of one type to another type.
+ * A copy plan is compiled from the serializer ops of the two types. Members
+ * are matched by name, contiguous runs of trivially copyable members are
+ * merged into a single memcpy, and members of a different primitive type are
+ * converted (e.g. a struct with f64 members to a struct with f32 members).
+ *
+ * Strings are duplicated, vectors with trivially copyable elements are
+ * resized & copied with a single memcpy, and other values that have a copy
+ * hook (opaque types, arrays/vectors of non-trivial types) are copied with
+ * the hook. Unlike a cursor, a plan does not dispatch on each member when
+ * it is ran, which makes it suitable for copying entire table columns.
+ *
+ * Members of the destination type that don't exist in the source type are
+ * not modified. Members with the same name that can't be converted cause
+ * plan creation to fail.
+ */
+typedef struct ecs_meta_copy_plan_t ecs_meta_copy_plan_t;
+
+/** Create a copy plan.
+ *
+ * @param world The world.
+ * @param dst_type The type to copy to.
+ * @param src_type The type to copy from.
+ * @return The copy plan, or NULL if the types can't be converted.
+ */
+FLECS_API
+ecs_meta_copy_plan_t* ecs_meta_copy_plan_init(
+    const ecs_world_t *world,
+    ecs_entity_t dst_type,
+    ecs_entity_t src_type);
+
+/** Free a copy plan.
+ *
+ * @param plan The copy plan.
+ */
+FLECS_API
+void ecs_meta_copy_plan_fini(
+    ecs_meta_copy_plan_t *plan);
+
+/** Run a copy plan.
+ * Copies count values from src to dst. Both arrays must be tightly packed
+ * (e.g. a table column). Values in dst must be constructed.
+ *
+ * @param plan The copy plan.
+ * @param dst Array of count values of the destination type.
+ * @param src Array of count values of the source type.
+ * @param count The number of values to copy.
+ */
+FLECS_API
+void ecs_meta_copy_plan_run(
+    const ecs_meta_copy_plan_t *plan,
+    void *dst,
+    const void *src,
+    int32_t count);
+
 /* API functions for creating meta types */
 
 /** Used with ecs_primitive_init(). */
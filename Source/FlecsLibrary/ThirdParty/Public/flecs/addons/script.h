@@ -512,6 +512,10 @@ typedef struct ecs_expr_eval_desc_t {
      * be created in between parsing & evaluating. */
     bool allow_unresolved_identifiers;
 
+    /* Disable compiling the expression to bytecode (slower evaluation, faster
+     * parsing). Expressions that can't be compiled always use the AST. */
+    bool disable_bytecode;
+
     ecs_script_runtime_t *runtime;   /**< Reusable runtime (optional) */
 } ecs_expr_eval_desc_t;
 
@@ -571,6 +575,64 @@ int ecs_expr_eval(
     ecs_value_t *value,
     const ecs_expr_eval_desc_t *desc);
 
+#ifndef FLECS_EXPR_BATCH_COLUMN_MAX
+/** Max number of columns that can be bound with ecs_expr_eval_batch(). */
+#define FLECS_EXPR_BATCH_COLUMN_MAX (16)
+#endif
+
+/** Column bound to a variable, used with ecs_expr_eval_batch(). */
+typedef struct ecs_expr_column_t {
+    const char *name;                /**< Name of variable */
+    ecs_entity_t type;               /**< Element type, must match variable type */
+    const void *ptr;                 /**< Pointer to first element */
+    ecs_size_t stride;               /**< Distance between elements (0 = type size) */
+} ecs_expr_column_t;
+
+/** Used with ecs_expr_eval_batch(). */
+typedef struct ecs_expr_eval_batch_desc_t {
+    int32_t count;                   /**< Number of elements to evaluate */
+
+    /** Variables bound to columns. For each element, the variable points to
+     * the element at the same index in the column. Terminated by an element 
+     * with a NULL name. */
+    ecs_expr_column_t columns[FLECS_EXPR_BATCH_COLUMN_MAX];
+
+    const ecs_script_vars_t *vars;   /**< Variables that are not bound to a column */
+    ecs_entity_t type;               /**< Output type (default = expression type) */
+    void *out;                       /**< Output array with count elements */
+    ecs_size_t out_stride;           /**< Distance between outputs (0 = type size) */
+} ecs_expr_eval_batch_desc_t;
+
+/** Evaluate expression for a batch of elements.
+ * This operation evaluates an expression parsed with ecs_expr_parse() once for
+ * each element of a set of columns, and stores the results in an output array.
+ * This is typically used to evaluate an expression for the component columns
+ * of a table, like for example:
+ * 
+ * @code
+ * ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+ *     .count = it->count,
+ *     .columns = {{ "p", ecs_id(Position), ecs_field(it, Position, 0) }},
+ *     .out = result
+ * });
+ * @endcode
+ * 
+ * Column variables must have been provided with the same type to 
+ * ecs_expr_parse(). Expressions that were compiled to bytecode evaluate all
+ * elements with a single pass over the program, other expressions are 
+ * evaluated one element at a time.
+ * 
+ * The output array must contain initialized values of the output type.
+ * 
+ * @param script The script containing the expression.
+ * @param desc The batch parameters.
+ * @return Zero if successful, non-zero if failed.
+ */
+FLECS_API
+int ecs_expr_eval_batch(
+    const ecs_script_t *script,
+    const ecs_expr_eval_batch_desc_t *desc);
+
 /** Evaluate interpolated expressions in string.
  * This operation evaluates expressions in a string, and replaces them with
  * their evaluated result. Supported expression formats are:
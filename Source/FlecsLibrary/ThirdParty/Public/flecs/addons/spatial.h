@@ -0,0 +1,220 @@
+/**
+ * @file addons/spatial.h
+ * @brief Spatial index addon.
+ *
+ * The spatial addon maintains a uniform grid over a position stored in a
+ * component, which makes it possible to find entities within a radius or the
+ * nearest entities to a point without iterating all matching tables.
+ */
+
+#ifdef FLECS_SPATIAL
+
+/**
+ * @defgroup c_addons_spatial Spatial
+ * @ingroup c_addons
+ * Uniform grid index for range and nearest neighbor queries.
+ *
+ * @{
+ */
+
+#ifndef FLECS_SPATIAL_H
+#define FLECS_SPATIAL_H
+
+#ifndef FLECS_PIPELINE
+#define FLECS_PIPELINE
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Spatial index descriptor, used with ecs_spatial_index_init(). */
+typedef struct ecs_spatial_index_desc_t {
+    int32_t _canary;
+
+    /** Entity associated with the index (optional). */
+    ecs_entity_t entity;
+
+    /** Component that stores the position of an entity. */
+    ecs_entity_t component;
+
+    /** Offset of the position in the component. The position must be stored
+     * as three consecutive x, y, z scalars. */
+    int32_t offset;
+
+    /** When true, position scalars are 64 bit floats. Defaults to 32 bit. */
+    bool f64;
+
+    /** Size of a grid cell. Works best when it is close to the radius used by
+     * most queries. */
+    double cell_size;
+
+    /** Pipeline phase in which the index is updated. Defaults to
+     * EcsPostUpdate. */
+    ecs_entity_t phase;
+} ecs_spatial_index_desc_t;
+
+/** Spatial query. */
+typedef struct ecs_spatial_query_t {
+    /** Center of the query. */
+    double center[3];
+
+    /** Search radius. Must be larger than zero for ecs_spatial_find_in_radius().
+     * For ecs_spatial_find_nearest() a radius of zero means unbounded. */
+    double radius;
+
+    /** Maximum number of entities to return (ecs_spatial_find_nearest() only). */
+    int32_t k;
+} ecs_spatial_query_t;
+
+/** Results for a batch of spatial queries.
+ * Results for all queries are stored in the same flat arrays. Use
+ * ecs_spatial_result_get() to obtain the results for a single query. A result
+ * can be reused for multiple batches, and must be cleaned up with
+ * ecs_spatial_result_fini(). Results don't use the world allocator, so that
+ * batches can be evaluated from multiple threads at the same time. */
+typedef struct ecs_spatial_result_t {
+    ecs_vec_t entities;  /**< ecs_entity_t, matched entities */
+    ecs_vec_t distances; /**< double, distance of entity to query center */
+    ecs_vec_t offsets;   /**< int32_t, query_count + 1 offsets into entities */
+    int32_t query_count; /**< Number of queries in last batch */
+} ecs_spatial_result_t;
+
+/** Results for a single spatial query. */
+typedef struct ecs_spatial_span_t {
+    const ecs_entity_t *entities; /**< Matched entities */
+    const double *distances;      /**< Distance of entities to query center */
+    int32_t count;                /**< Number of matched entities */
+} ecs_spatial_span_t;
+
+/** Create a spatial index.
+ * A spatial index sorts entities with the specified component into a uniform
+ * grid, where the cell of an entity is determined by the position stored in
+ * the component. Entities in the same cell are stored next to each other, so
+ * that queries only have to visit the cells that overlap with the query.
+ *
+ * The index is updated once per frame in the specified phase:
+ * - tables that weren't written to since the last update are skipped
+ * - for other tables, only rows whose position changed are updated
+ * - the update is split up between worker threads, while moving entities
+ *   between cells happens on the main thread.
+ *
+ * When a large number of entities has moved between cells, the index is
+ * rebuilt from scratch, which is also done in parallel.
+ *
+ * Entities are removed from the index when the component is removed. Entities
+ * that already have the component are added when the index is created.
+ *
+ * The returned entity is an observer that owns the index. Deleting it deletes
+ * the index.
+ *
+ * @param world The world.
+ * @param desc Spatial index description.
+ * @return The spatial index entity, or 0 if failed.
+ */
+FLECS_API
+ecs_entity_t ecs_spatial_index_init(
+    ecs_world_t *world,
+    const ecs_spatial_index_desc_t *desc);
+
+/** Create a spatial index.
+ * @see ecs_spatial_index_init()
+ */
+#define ecs_spatial_index(world, ...)\
+    ecs_spatial_index_init(world, &(ecs_spatial_index_desc_t)__VA_ARGS__)
+
+/** Rebuild spatial index during the next update.
+ * This can be used to compact the index after a large number of entities was
+ * added or moved between cells.
+ *
+ * @param world The world.
+ * @param index The spatial index.
+ */
+FLECS_API
+void ecs_spatial_index_rebuild(
+    ecs_world_t *world,
+    ecs_entity_t index);
+
+/** Return number of entities in spatial index.
+ *
+ * @param world The world.
+ * @param index The spatial index.
+ * @return The number of entities in the index.
+ */
+FLECS_API
+int32_t ecs_spatial_count(
+    const ecs_world_t *world,
+    ecs_entity_t index);
+
+/** Find entities within a radius for a batch of queries.
+ * The results for each query contain all entities in the index for which the
+ * distance to the query center is less than or equal to the query radius.
+ * Entities are not returned in a specific order.
+ *
+ * Queries return the positions as they were during the last update of the
+ * index, and must not be evaluated while the index is being updated.
+ *
+ * @param world The world.
+ * @param index The spatial index.
+ * @param queries Array with queries.
+ * @param count Number of queries.
+ * @param result Result to store matched entities in.
+ * @return Total number of matched entities for all queries.
+ */
+FLECS_API
+int32_t ecs_spatial_find_in_radius(
+    const ecs_world_t *world,
+    ecs_entity_t index,
+    const ecs_spatial_query_t *queries,
+    int32_t count,
+    ecs_spatial_result_t *result);
+
+/** Find nearest entities for a batch of queries.
+ * The results for each query contain at most k entities that are nearest to
+ * the query center, sorted by distance. When the query has a radius, only
+ * entities within the radius are returned.
+ *
+ * @param world The world.
+ * @param index The spatial index.
+ * @param queries Array with queries.
+ * @param count Number of queries.
+ * @param result Result to store matched entities in.
+ * @return Total number of matched entities for all queries.
+ * @see ecs_spatial_find_in_radius()
+ */
+FLECS_API
+int32_t ecs_spatial_find_nearest(
+    const ecs_world_t *world,
+    ecs_entity_t index,
+    const ecs_spatial_query_t *queries,
+    int32_t count,
+    ecs_spatial_result_t *result);
+
+/** Get results for a single query in a batch.
+ *
+ * @param result The batch result.
+ * @param query Index of the query in the batch.
+ * @return The matched entities for the query.
+ */
+FLECS_API
+ecs_spatial_span_t ecs_spatial_result_get(
+    const ecs_spatial_result_t *result,
+    int32_t query);
+
+/** Free resources of spatial query result.
+ *
+ * @param result The result to free.
+ */
+FLECS_API
+void ecs_spatial_result_fini(
+    ecs_spatial_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @} */
+
+#endif
@@ -189,6 +189,20 @@ typedef struct ecs_system_stats_t {
     ecs_query_stats_t query;
 } ecs_system_stats_t;
 
+/** Statistics for a single alert (use ecs_alert_stats_get()) */
+typedef struct ecs_alert_stats_t {
+    int64_t first_;
+    ecs_metric_t time_spent;       /**< Time spent evaluating an alert */
+    ecs_metric_t tables_evaluated; /**< Number of tables evaluated */
+    ecs_metric_t tables_skipped;   /**< Number of unchanged tables skipped */
+    ecs_metric_t instance_count;   /**< Number of alert instances */
+    int64_t last_;
+
+    bool incremental;              /**< Is alert evaluated incrementally */
+
+    ecs_query_stats_t query;
+} ecs_alert_stats_t;
+
 /** Statistics for sync point */
 typedef struct ecs_sync_stats_t {
     int64_t first_;
@@ -335,6 +349,45 @@ void ecs_system_stats_copy_last(
     ecs_system_stats_t *dst,
     const ecs_system_stats_t *src);
 
+/** Get alert statistics.
+ * Obtain evaluation statistics for the provided alert. Time spent is only
+ * measured when system time measurement is enabled for the world.
+ *
+ * @param world The world.
+ * @param alert The alert.
+ * @param stats Out parameter for statistics.
+ * @return true if success, false if not an alert.
+ */
+FLECS_API
+bool ecs_alert_stats_get(
+    const ecs_world_t *world,
+    ecs_entity_t alert,
+    ecs_alert_stats_t *stats);
+
+/** Reduce source measurement window into single destination measurement */
+FLECS_API
+void ecs_alert_stats_reduce(
+    ecs_alert_stats_t *dst,
+    const ecs_alert_stats_t *src);
+
+/** Reduce last measurement into previous measurement, restore old value. */
+FLECS_API
+void ecs_alert_stats_reduce_last(
+    ecs_alert_stats_t *stats,
+    const ecs_alert_stats_t *old,
+    int32_t count);
+
+/** Repeat last measurement. */
+FLECS_API
+void ecs_alert_stats_repeat_last(
+    ecs_alert_stats_t *stats);
+
+/** Copy last measurement from source to destination. */
+FLECS_API
+void ecs_alert_stats_copy_last(
+    ecs_alert_stats_t *dst,
+    const ecs_alert_stats_t *src);
+
 /** Get pipeline statistics.
  * Obtain statistics for the provided pipeline.
  *
@@ -414,6 +467,7 @@ FLECS_API extern ECS_COMPONENT_DECLARE(EcsWorldStats);     /**< Component id for
 FLECS_API extern ECS_COMPONENT_DECLARE(EcsWorldSummary);   /**< Component id for EcsWorldSummary. */
 FLECS_API extern ECS_COMPONENT_DECLARE(EcsSystemStats);    /**< Component id for EcsSystemStats. */
 FLECS_API extern ECS_COMPONENT_DECLARE(EcsPipelineStats);  /**< Component id for EcsPipelineStats. */
+FLECS_API extern ECS_COMPONENT_DECLARE(EcsAlertStats);     /**< Component id for EcsAlertStats. */
 
 FLECS_API extern ecs_entity_t EcsPeriod1s;                 /**< Tag used for metrics collected in last second. */
 FLECS_API extern ecs_entity_t EcsPeriod1m;                 /**< Tag used for metrics collected in last minute. */
@@ -445,6 +499,12 @@ typedef struct {
     ecs_map_t stats;
 } EcsPipelineStats;
 
+/** Component that stores alert statistics. */
+typedef struct {
+    EcsStatsHeader hdr;
+    ecs_map_t stats;
+} EcsAlertStats;
+
 /** Component that stores a summary of world statistics. */
 typedef struct {
     /* Time */
@@ -49,6 +49,26 @@ typedef struct EcsRateFilter {
     ecs_ftime_t time_elapsed;    /**< Time elapsed since last tick */
 } EcsRateFilter;
 
+/** Tag that schedules a timer on the timing wheel.
+ * Timers with this tag are not visited each frame. Instead they are stored
+ * in a hierarchical timing wheel, and only timers that are due in the
+ * current frame are processed. This makes inactive and long running timers
+ * free, which is useful for large numbers of per-entity timers (cooldowns,
+ * expiration) of which only a few fire each frame.
+ *
+ * The EcsTimer::time member of a wheel timer is not updated each frame. It
+ * is only updated when the timer fires. Changes to the EcsTimer component
+ * must be signaled with ecs_modified() (or ecs_set()) to reschedule the
+ * timer. The timer functions in this addon do this automatically.
+ *
+ * Usage:
+ * @code
+ * ecs_entity_t t = ecs_set_timeout(world, 0, 10.0);
+ * ecs_add_id(world, t, EcsTimerWheel);
+ * @endcode
+ */
+FLECS_API extern ECS_TAG_DECLARE(EcsTimerWheel);
+
 
 /** Set timer timeout.
  * This operation executes any systems associated with the timer after the
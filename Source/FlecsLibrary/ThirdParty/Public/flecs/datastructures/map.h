@@ -16,6 +16,8 @@ typedef uint64_t ecs_map_data_t;
 typedef ecs_map_data_t ecs_map_key_t;
 typedef ecs_map_data_t ecs_map_val_t;
 
+#ifndef FLECS_MAP_OPEN_ADDRESSING
+
 /* Map type */
 typedef struct ecs_bucket_entry_t {
     ecs_map_key_t key;
@@ -44,6 +46,39 @@ typedef struct ecs_map_iter_t {
     ecs_map_data_t *res;
 } ecs_map_iter_t;
 
+#else
+
+/* Open addressing map type. The slot array stores a pointer to the entry of
+ * each element, with one control byte per slot that holds either the 7 low
+ * bits of the key hash, or whether the slot is empty or deleted. Lookups
+ * compare a group of control bytes at a time, and only visit slots for which
+ * the hash matches. Entries are allocated from the entry allocator like the
+ * chained map, so pointers to values stay valid when the map grows. */
+typedef struct ecs_bucket_entry_t {
+    ecs_map_key_t key;
+    ecs_map_val_t value;
+} ecs_bucket_entry_t;
+
+struct ecs_map_t {
+    uint8_t bucket_shift;
+    bool shared_allocator;
+    ecs_bucket_entry_t **slots;       /* Slot array, bucket_count elements */
+    int8_t *ctrl;                     /* Control bytes, stored after slots */
+    int32_t bucket_count;
+    int32_t count;
+    int32_t deleted;
+    struct ecs_block_allocator_t *entry_allocator;
+    struct ecs_allocator_t *allocator;
+};
+
+typedef struct ecs_map_iter_t {
+    const ecs_map_t *map;
+    int32_t index;
+    ecs_map_data_t *res;
+} ecs_map_iter_t;
+
+#endif
+
 typedef struct ecs_map_params_t {
     struct ecs_allocator_t *allocator;
     struct ecs_block_allocator_t entry_allocator;
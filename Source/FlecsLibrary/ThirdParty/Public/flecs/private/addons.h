@@ -30,6 +30,9 @@
 #ifdef FLECS_NO_ALERTS
 #undef FLECS_ALERTS
 #endif
+#ifdef FLECS_NO_SPATIAL
+#undef FLECS_SPATIAL
+#endif
 #ifdef FLECS_NO_PIPELINE
 #undef FLECS_PIPELINE
 #endif
@@ -87,6 +90,12 @@
 #endif
 #endif
 
+#ifdef FLECS_SPATIAL
+#ifndef FLECS_PIPELINE
+#define FLECS_PIPELINE
+#endif
+#endif
+
 #ifdef FLECS_APP
 #ifdef FLECS_NO_APP
 #error "FLECS_NO_APP failed: APP is required by other addons"
@@ -150,6 +159,13 @@
 #include "../addons/alerts.h"
 #endif
 
+#ifdef FLECS_SPATIAL
+#ifdef FLECS_NO_SPATIAL
+#error "FLECS_NO_SPATIAL failed: SPATIAL is required by other addons"
+#endif
+#include "../addons/spatial.h"
+#endif
+
 #ifdef FLECS_JSON
 #ifdef FLECS_NO_JSON
 #error "FLECS_NO_JSON failed: JSON is required by other addons"
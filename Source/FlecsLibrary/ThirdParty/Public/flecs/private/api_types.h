@@ -130,6 +130,12 @@ typedef struct ecs_query_iter_t {
     uint64_t *written;
     int32_t skip_count;
 
+    /* Remaining entities for a variable constrained by value */
+    ecs_entity_t *value_entities;
+    int32_t value_count;
+    int32_t value_cur;
+    int32_t value_var;
+
     ecs_query_op_profile_t *profile;
 
     int16_t op;
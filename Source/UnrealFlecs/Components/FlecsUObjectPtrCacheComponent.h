@@ -0,0 +1,45 @@
+﻿// Solstice Games © 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SolidMacros/Macros.h"
+#include "UObject/Object.h"
+#include "FlecsUObjectPtrCacheComponent.generated.h"
+
+/**
+ * @brief Raw pointer to the object of the FFlecsUObjectComponent on the same entity.
+ * Added together with FFlecsUObjectComponent and resolved in batches by the world:
+ * when the object component is set, once per frame for tables where it changed and after every garbage collection.
+ * Reading it does not resolve the weak pointer, so hot systems should prefer it over FFlecsUObjectComponent.
+ */
+USTRUCT(BlueprintType)
+struct alignas(8) UNREALFLECS_API FFlecsUObjectPtrCacheComponent
+{
+	GENERATED_BODY()
+
+public:
+	FORCEINLINE FFlecsUObjectPtrCacheComponent() = default;
+	FORCEINLINE FFlecsUObjectPtrCacheComponent(UObject* InObject) : Object(InObject) {}
+
+	FORCEINLINE NO_DISCARD UObject* GetObject() const { return Object; }
+
+	template <typename T>
+	FORCEINLINE NO_DISCARD T* GetObject() const { return Cast<T>(Object); }
+
+	FORCEINLINE NO_DISCARD UObject* GetObjectChecked() const
+	{
+		solid_checkf(IsValid(), TEXT("Object is not valid!"));
+		return Object;
+	}
+
+	template <typename T>
+	FORCEINLINE NO_DISCARD T* GetObjectChecked() const { return CastChecked<T>(GetObjectChecked()); }
+
+	FORCEINLINE NO_DISCARD bool IsValid() const { return Object != nullptr; }
+	FORCEINLINE operator bool() const { return IsValid(); }
+
+	/** Not a UPROPERTY, the cache must never keep the object alive */
+	UObject* Object = nullptr;
+	
+}; // struct FFlecsUObjectPtrCacheComponent
@@ -45,6 +45,22 @@ FString FFlecsEntityHandle::GetWorldName() const
     return GetFlecsWorld()->GetWorldName();
 }
 
+FString FFlecsEntityHandle::ToJson(const bool bSerializePath, const bool bSerializeLabel,
+    const bool bSerializeBrief, const bool bSerializeLink, const bool bSerializeColor, const bool bSerializeIds,
+    const bool bSerializeIdLabels, const bool bSerializeBaseComponents, const bool bSerializeComponents) const
+{
+    // Members of script structs are only built when something serializes them
+    GetFlecsWorld()->EnsureEntityTypeReflection(*this);
+    return FString(GetEntity().to_json().c_str());
+}
+
+void FFlecsEntityHandle::FromJson(const FString& InJson) const
+{
+    // The json can hold components the entity doesn't have yet
+    GetFlecsWorld()->EnableTypeReflection();
+    GetEntity().from_json(StringCast<char>(*InJson).Get());
+}
+
 bool FFlecsEntityHandle::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
     /*if (Ar.IsLoading())
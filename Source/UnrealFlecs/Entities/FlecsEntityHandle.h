@@ -515,15 +515,9 @@ public:
 	SOLID_INLINE NO_DISCARD FString ToJson(const bool bSerializePath = true,
 		const bool bSerializeLabel = false, const bool bSerializeBrief = false, const bool bSerializeLink = false,
 		const bool bSerializeColor = false, const bool bSerializeIds = true, const bool bSerializeIdLabels = false,
-		const bool bSerializeBaseComponents = true, const bool bSerializeComponents = true) const
-	{
-		return FString(GetEntity().to_json().c_str());
-	}
+		const bool bSerializeBaseComponents = true, const bool bSerializeComponents = true) const;
 
-	SOLID_INLINE void FromJson(const FString& InJson) const
-	{
-		GetEntity().from_json(StringCast<char>(*InJson).Get());
-	}
+	SOLID_INLINE void FromJson(const FString& InJson) const;
 
 	SOLID_INLINE bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
 
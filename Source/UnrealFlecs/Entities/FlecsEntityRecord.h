@@ -273,6 +273,33 @@ struct UNREALFLECS_API FFlecsComponentTypeInfo final
 	{
 		return !(*this == Other);
 	}
+
+	FORCEINLINE void ApplyTraitsToEntity(const FFlecsEntityHandle& InEntityHandle) const
+	{
+		solid_checkf(NodeType == EFlecsComponentNodeType::ScriptStruct, TEXT("Traits require a ScriptStruct node"));
+		
+		for (const auto& [TraitNodeType, TraitScriptStruct, TraitEntityHandle, TraitGameplayTag, TraitPair] : Traits)
+		{
+			switch (TraitNodeType)
+			{
+			case EFlecsComponentNodeType::ScriptStruct:
+				InEntityHandle.SetTrait(const_cast<UScriptStruct*>(ScriptStruct.GetScriptStruct()), TraitScriptStruct);
+				break;
+			case EFlecsComponentNodeType::EntityHandle:
+				InEntityHandle.AddTrait(const_cast<UScriptStruct*>(ScriptStruct.GetScriptStruct()), TraitEntityHandle);
+				break;
+			case EFlecsComponentNodeType::FGameplayTag:
+				InEntityHandle.AddTrait(const_cast<UScriptStruct*>(ScriptStruct.GetScriptStruct()), TraitGameplayTag);
+				break;
+			case EFlecsComponentNodeType::Pair:
+				TraitPair.AddToEntity(InEntityHandle);
+				break;
+			default: UNLIKELY_ATTRIBUTE
+				solid_checkf(false, TEXT("Invalid TraitNodeType"));
+				break;
+			}
+		}
+	}
 	
 }; // struct FFlecsComponentTypeInfo
 
@@ -317,36 +344,15 @@ struct UNREALFLECS_API FFlecsEntityRecord
 			InEntityHandle.SetName(Name);
 		}
 
-		for (const auto& [NodeType, ScriptStruct, EntityHandle, GameplayTag, Pair, Traits] : Components)
+		for (const FFlecsComponentTypeInfo& Component : Components)
 		{
+			const auto& [NodeType, ScriptStruct, EntityHandle, GameplayTag, Pair, Traits] = Component;
+			
 			switch (NodeType)
 			{
 			case EFlecsComponentNodeType::ScriptStruct:
-				
 				InEntityHandle.Set(ScriptStruct);
-
-				for (const auto& [TraitNodeType, TraitScriptStruct, TraitEntityHandle, TraitGameplayTag, TraitPair] : Traits)
-				{
-					switch (TraitNodeType)
-					{
-					case EFlecsComponentNodeType::ScriptStruct:
-						InEntityHandle.SetTrait(const_cast<UScriptStruct*>(ScriptStruct.GetScriptStruct()), TraitScriptStruct);
-						break;
-					case EFlecsComponentNodeType::EntityHandle:
-						InEntityHandle.AddTrait(const_cast<UScriptStruct*>(ScriptStruct.GetScriptStruct()), TraitEntityHandle);
-						break;
-					case EFlecsComponentNodeType::FGameplayTag:
-						InEntityHandle.AddTrait(const_cast<UScriptStruct*>(ScriptStruct.GetScriptStruct()), TraitGameplayTag);
-						break;
-					case EFlecsComponentNodeType::Pair:
-						TraitPair.AddToEntity(InEntityHandle);
-						break;
-					default: UNLIKELY_ATTRIBUTE
-						solid_checkf(false, TEXT("Invalid TraitNodeType"));
-						break;
-					}
-				}
-				
+				Component.ApplyTraitsToEntity(InEntityHandle);
 				break;
 			case EFlecsComponentNodeType::EntityHandle:
 				InEntityHandle.Add(EntityHandle);
@@ -363,6 +369,11 @@ struct UNREALFLECS_API FFlecsEntityRecord
 			}
 		}
 
+		ApplySubEntitiesToEntity(InEntityHandle);
+	}
+
+	FORCEINLINE void ApplySubEntitiesToEntity(const FFlecsEntityHandle& InEntityHandle) const
+	{
 		for (const TInstancedStruct<FFlecsEntityRecord>& SubEntity : SubEntities)
 		{
 			FFlecsEntityRecord NewEntityRecord = SubEntity.Get();
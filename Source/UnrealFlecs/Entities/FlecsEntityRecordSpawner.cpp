@@ -0,0 +1,440 @@
+﻿// Solstice Games © 2024. All Rights Reserved.
+
+#include "FlecsEntityRecordSpawner.h"
+#include "Worlds/FlecsWorld.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlecsEntityRecordSpawner::Compile"),
+	STAT_FlecsEntityRecordSpawnerCompile, STATGROUP_FlecsWorld);
+DECLARE_CYCLE_STAT(TEXT("FlecsEntityRecordSpawner::Spawn"),
+	STAT_FlecsEntityRecordSpawnerSpawn, STATGROUP_FlecsWorld);
+
+namespace
+{
+	FORCEINLINE NO_DISCARD uint64 GetTagLayoutToken(const FGameplayTag& InTag)
+	{
+		const FName TagName = InTag.GetTagName();
+		return (static_cast<uint64>(TagName.GetComparisonIndex().ToUnstableInt()) << 32)
+			| static_cast<uint64>(static_cast<uint32>(TagName.GetNumber()));
+	}
+
+	void AddPairSlotLayout(const FFlecsPairSlot& InSlot, TArray<uint64>& OutLayout)
+	{
+		OutLayout.Add(static_cast<uint64>(InSlot.NodeType));
+
+		switch (InSlot.NodeType)
+		{
+		case EFlecsPairNodeType::ScriptStruct:
+			OutLayout.Add(reinterpret_cast<UPTRINT>(InSlot.ScriptStruct.GetScriptStruct()));
+			break;
+		case EFlecsPairNodeType::EntityHandle:
+			OutLayout.Add(InSlot.EntityHandle.GetId());
+			break;
+		case EFlecsPairNodeType::FGameplayTag:
+			OutLayout.Add(GetTagLayoutToken(InSlot.GameplayTag));
+			break;
+		default: UNLIKELY_ATTRIBUTE
+			solid_checkf(false, TEXT("Invalid NodeType"));
+			break;
+		}
+	}
+
+	NO_DISCARD flecs::entity_t ResolvePairSlot(const UFlecsWorld* InWorld, const FFlecsPairSlot& InSlot)
+	{
+		switch (InSlot.NodeType)
+		{
+		case EFlecsPairNodeType::ScriptStruct:
+			return InWorld->ObtainComponentTypeStruct(InSlot.ScriptStruct.GetScriptStruct()).GetId();
+		case EFlecsPairNodeType::EntityHandle:
+			return InSlot.EntityHandle.GetId();
+		case EFlecsPairNodeType::FGameplayTag:
+			return InWorld->GetTagEntity(InSlot.GameplayTag).GetId();
+		default: UNLIKELY_ATTRIBUTE
+			solid_checkf(false, TEXT("Invalid NodeType"));
+			return 0;
+		}
+	}
+
+	NO_DISCARD const FInstancedStruct& GetValueSource(const FFlecsEntityRecord& InRecord,
+		const FFlecsCompiledRecordValue& InValue)
+	{
+		const FFlecsComponentTypeInfo& Component = InRecord.Components[InValue.ComponentIndex];
+
+		switch (InValue.Source)
+		{
+		case EFlecsCompiledRecordValueSource::PairFirst:
+			return Component.Pair.First.ScriptStruct;
+		case EFlecsCompiledRecordValueSource::PairSecond:
+			return Component.Pair.Second.ScriptStruct;
+		default:
+			return Component.ScriptStruct;
+		}
+	}
+
+	/** Entities created by name are created in the current scope and with the current with id */
+	NO_DISCARD flecs::table_t* AddScopeToTable(flecs::world_t* InWorld, flecs::table_t* InTable)
+	{
+		if (const flecs::entity_t Scope = ecs_get_scope(InWorld))
+		{
+			InTable = ecs_table_add_id(InWorld, InTable, ecs_childof(Scope));
+		}
+
+		if (const flecs::id_t With = ecs_get_with(InWorld))
+		{
+			InTable = ecs_table_add_id(InWorld, InTable, With);
+		}
+
+		return InTable;
+	}
+
+	/** Parts of a record that can't be resolved to ids ahead of time (Trait holders and Sub-Entities) */
+	void ApplyPostSpawn(const FFlecsEntityRecord& InRecord, const FFlecsEntityHandle& InEntityHandle)
+	{
+		for (const FFlecsComponentTypeInfo& Component : InRecord.Components)
+		{
+			if (Component.NodeType == EFlecsComponentNodeType::ScriptStruct && !Component.Traits.IsEmpty())
+			{
+				Component.ApplyTraitsToEntity(InEntityHandle);
+			}
+		}
+
+		InRecord.ApplySubEntitiesToEntity(InEntityHandle);
+	}
+
+} // namespace
+
+void FFlecsEntityRecordSpawner::BuildLayout(const FFlecsEntityRecord& InRecord, TArray<uint64>& OutLayout)
+{
+	OutLayout.Reset();
+	OutLayout.Add(InRecord.Name.IsEmpty() ? 0 : 1);
+
+	for (const FFlecsComponentTypeInfo& Component : InRecord.Components)
+	{
+		OutLayout.Add(static_cast<uint64>(Component.NodeType));
+
+		switch (Component.NodeType)
+		{
+		case EFlecsComponentNodeType::ScriptStruct:
+			OutLayout.Add(reinterpret_cast<UPTRINT>(Component.ScriptStruct.GetScriptStruct()));
+			break;
+		case EFlecsComponentNodeType::EntityHandle:
+			OutLayout.Add(Component.EntityHandle.GetId());
+			break;
+		case EFlecsComponentNodeType::FGameplayTag:
+			OutLayout.Add(GetTagLayoutToken(Component.GameplayTag));
+			break;
+		case EFlecsComponentNodeType::Pair:
+			AddPairSlotLayout(Component.Pair.First, OutLayout);
+			AddPairSlotLayout(Component.Pair.Second, OutLayout);
+			OutLayout.Add(static_cast<uint64>(Component.Pair.PairType));
+			break;
+		default: UNLIKELY_ATTRIBUTE
+			solid_checkf(false, TEXT("Invalid NodeType"));
+			break;
+		}
+	}
+}
+
+const FFlecsCompiledEntityRecord& FFlecsEntityRecordSpawner::ObtainCompiledRecord(const UFlecsWorld* InWorld,
+	const FFlecsEntityRecord& InRecord)
+{
+	BuildLayout(InRecord, LayoutScratch);
+	const TArray<uint64>& Layout = LayoutScratch;
+
+	const uint32 LayoutHash = FCrc::MemCrc32(Layout.GetData(), Layout.Num() * sizeof(uint64));
+	const int64 TableDeleteTotal = ecs_get_world_info(InWorld->World)->table_delete_total;
+
+	FFlecsCompiledEntityRecord& CompiledRecord = CompiledRecords.FindOrAdd(LayoutHash);
+
+	// Tables are only deleted when they are cleaned up or one of their ids is deleted,
+	// in both cases the compiled tables (and possibly ids) are stale
+	if UNLIKELY_IF(CompiledRecord.TableDeleteTotal != TableDeleteTotal || CompiledRecord.Layout != Layout)
+	{
+		CompiledRecord = FFlecsCompiledEntityRecord();
+		Compile(InWorld, InRecord, CompiledRecord);
+		CompiledRecord.Layout = Layout;
+		CompiledRecord.TableDeleteTotal = ecs_get_world_info(InWorld->World)->table_delete_total;
+	}
+
+	return CompiledRecord;
+}
+
+void FFlecsEntityRecordSpawner::Compile(const UFlecsWorld* InWorld, const FFlecsEntityRecord& InRecord,
+	FFlecsCompiledEntityRecord& OutCompiledRecord) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlecsEntityRecordSpawnerCompile);
+
+	flecs::world_t* World = InWorld->World.c_ptr();
+	flecs::table_t* Table = nullptr;
+
+	const auto AddValue = [&](const flecs::id_t InId, const int32 InComponentIndex,
+		const EFlecsCompiledRecordValueSource InSource, const flecs::entity_t InStructEntity)
+	{
+		// Only copy the value if the storage type of the id is the struct of the record
+		if (ecs_get_typeid(World, InId) != InStructEntity)
+		{
+			return;
+		}
+
+		// Later values for the same id overwrite earlier ones, same as setting them one by one
+		OutCompiledRecord.Values.RemoveAll([InId](const FFlecsCompiledRecordValue& InValue)
+		{
+			return InValue.Id == InId;
+		});
+
+		OutCompiledRecord.Values.Add(FFlecsCompiledRecordValue{ InId, InComponentIndex, InSource });
+	};
+
+	for (int32 Index = 0; Index < InRecord.Components.Num(); ++Index)
+	{
+		const FFlecsComponentTypeInfo& Component = InRecord.Components[Index];
+
+		switch (Component.NodeType)
+		{
+		case EFlecsComponentNodeType::ScriptStruct:
+			{
+				const flecs::entity_t ComponentId
+					= InWorld->ObtainComponentTypeStruct(Component.ScriptStruct.GetScriptStruct()).GetId();
+				Table = ecs_table_add_id(World, Table, ComponentId);
+				AddValue(ComponentId, Index, EFlecsCompiledRecordValueSource::Component, ComponentId);
+			}
+			break;
+		case EFlecsComponentNodeType::EntityHandle:
+			Table = ecs_table_add_id(World, Table, Component.EntityHandle.GetId());
+			break;
+		case EFlecsComponentNodeType::FGameplayTag:
+			Table = ecs_table_add_id(World, Table, InWorld->GetTagEntity(Component.GameplayTag).GetId());
+			break;
+		case EFlecsComponentNodeType::Pair:
+			{
+				const FFlecsPair& Pair = Component.Pair;
+
+				const flecs::entity_t First = ResolvePairSlot(InWorld, Pair.First);
+				const flecs::entity_t Second = ResolvePairSlot(InWorld, Pair.Second);
+				solid_checkf(First != 0 && Second != 0, TEXT("Pair could not be resolved"));
+
+				const flecs::id_t PairId = ecs_pair(First, Second);
+				Table = ecs_table_add_id(World, Table, PairId);
+
+				// Mirrors FFlecsPair::AddToEntity
+				if (Pair.First.NodeType == EFlecsPairNodeType::ScriptStruct)
+				{
+					if (Pair.Second.NodeType == EFlecsPairNodeType::ScriptStruct
+						&& Pair.PairType == EFlecsValuePairType::First)
+					{
+						AddValue(PairId, Index, EFlecsCompiledRecordValueSource::PairFirst, First);
+					}
+				}
+				else if (Pair.Second.NodeType == EFlecsPairNodeType::ScriptStruct)
+				{
+					AddValue(PairId, Index, EFlecsCompiledRecordValueSource::PairSecond, Second);
+				}
+			}
+			break;
+		default: UNLIKELY_ATTRIBUTE
+			solid_checkf(false, TEXT("Invalid NodeType"));
+			break;
+		}
+	}
+
+	OutCompiledRecord.Table = Table;
+
+	if (!InRecord.Name.IsEmpty())
+	{
+		OutCompiledRecord.NamedTable = ecs_table_add_id(World, Table, ecs_pair(ecs_id(EcsIdentifier), EcsName));
+	}
+}
+
+const flecs::entity_t* FFlecsEntityRecordSpawner::SpawnInternal(const UFlecsWorld* InWorld,
+	const FFlecsEntityRecord& InRecord, const FFlecsCompiledEntityRecord& InCompiledRecord, flecs::table_t* InTable,
+	const flecs::entity_t* InIds, const int32 InCount) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlecsEntityRecordSpawnerSpawn);
+
+	flecs::world_t* World = InWorld->World.c_ptr();
+
+	struct FValueBuffer
+	{
+		void* Memory = nullptr;
+		const UScriptStruct* ScriptStruct = nullptr;
+		bool bMoved = false;
+	}; // struct FValueBuffer
+
+	TArray<void*, TInlineAllocator<32>> Data;
+	TArray<FValueBuffer, TInlineAllocator<16>> Buffers;
+
+	if (InTable)
+	{
+		Data.SetNumZeroed(ecs_table_get_type(InTable)->count);
+	}
+
+	for (const FFlecsCompiledRecordValue& Value : InCompiledRecord.Values)
+	{
+		const FInstancedStruct& Source = GetValueSource(InRecord, Value);
+		const UScriptStruct* ScriptStruct = Source.GetScriptStruct();
+
+		if UNLIKELY_IF(!ScriptStruct || !Source.GetMemory())
+		{
+			continue;
+		}
+
+		const int32 TypeIndex = ecs_search(World, InTable, Value.Id, nullptr);
+		solid_checkf(TypeIndex != -1, TEXT("Compiled id is not in the target table"));
+
+		const ecs_type_info_t* TypeInfo = ecs_get_type_info(World, Value.Id);
+		solid_checkf(TypeInfo && TypeInfo->size == ScriptStruct->GetStructureSize(),
+			TEXT("Component size does not match script struct %s"), *ScriptStruct->GetStructCPPName());
+
+		// Values are copy constructed once into a contiguous buffer and then moved (or memcpy'd)
+		// into the table columns by ecs_bulk_init, which also batches the OnSet notifications
+		uint8* Memory = static_cast<uint8*>(FMemory::Malloc(TypeInfo->size * InCount, TypeInfo->alignment));
+		ScriptStruct->InitializeStruct(Memory, InCount);
+
+		for (int32 Index = 0; Index < InCount; ++Index)
+		{
+			ScriptStruct->CopyScriptStruct(Memory + Index * TypeInfo->size, Source.GetMemory());
+		}
+
+		Data[TypeIndex] = Memory;
+		Buffers.Add(FValueBuffer{ Memory, ScriptStruct, TypeInfo->hooks.move != nullptr });
+	}
+
+	ecs_bulk_desc_t Desc = {};
+	Desc.entities = const_cast<flecs::entity_t*>(InIds);
+	Desc.count = InCount;
+	Desc.table = InTable;
+	Desc.data = Buffers.IsEmpty() ? nullptr : Data.GetData();
+
+	const flecs::entity_t* Entities = ecs_bulk_init(World, &Desc);
+
+	for (const FValueBuffer& Buffer : Buffers)
+	{
+		// Without a move hook the storage took ownership of the memcpy'd values
+		if (Buffer.bMoved)
+		{
+			Buffer.ScriptStruct->DestroyStruct(Buffer.Memory, InCount);
+		}
+
+		FMemory::Free(Buffer.Memory);
+	}
+
+	return Entities;
+}
+
+FFlecsEntityHandle FFlecsEntityRecordSpawner::Spawn(const UFlecsWorld* InWorld, const FFlecsEntityRecord& InRecord,
+	const flecs::entity_t InId)
+{
+	solid_checkf(IsValid(InWorld), TEXT("Flecs World is not valid"));
+	solid_checkf(InRecord.IsValid(), TEXT("Entity Record is not valid"));
+
+	flecs::world_t* World = InWorld->World.c_ptr();
+
+	const bool bNamed = !InRecord.Name.IsEmpty();
+	const auto NameString = StringCast<char>(*InRecord.Name);
+
+	// ecs_bulk_init can't be deferred, paths create a hierarchy and
+	// existing entities with the same name are reused, all of these keep the per-component path
+	bool bSlowPath = ecs_is_deferred(World) || ecs_stage_is_readonly(World);
+
+	if (!bSlowPath && InId != 0)
+	{
+		bSlowPath = ecs_is_alive(World, InId) && ecs_get_table(World, InId) != nullptr;
+	}
+
+	if (!bSlowPath && bNamed)
+	{
+		bSlowPath = InRecord.Name.Contains(TEXT("::"))
+			|| ecs_lookup_path_w_sep(World, ecs_get_scope(World), NameString.Get(), "::", "::", false) != 0;
+	}
+
+	if (bSlowPath)
+	{
+		const FFlecsEntityHandle Entity = InId != 0
+			? InWorld->CreateEntityWithId(InId)
+			: InWorld->CreateEntity(InRecord.Name);
+		InRecord.ApplyRecordToEntity(Entity);
+		return Entity;
+	}
+
+	const FFlecsCompiledEntityRecord& CompiledRecord = ObtainCompiledRecord(InWorld, InRecord);
+
+	flecs::table_t* Table = bNamed ? CompiledRecord.NamedTable : CompiledRecord.Table;
+
+	// Entities created with an explicit id ignore the scope, same as make_alive
+	if (InId == 0)
+	{
+		Table = AddScopeToTable(World, Table);
+	}
+
+	const flecs::entity_t* Entities = SpawnInternal(InWorld, InRecord, CompiledRecord, Table,
+		InId != 0 ? &InId : nullptr, 1);
+	solid_check(Entities);
+
+	const FFlecsEntityHandle Entity(InWorld, Entities[0]);
+
+	if (bNamed)
+	{
+		// The entity already has the (Identifier, Name) pair, so this doesn't move it
+		ecs_set_name(World, Entity.GetId(), NameString.Get());
+	}
+
+	ApplyPostSpawn(InRecord, Entity);
+	return Entity;
+}
+
+TArray<FFlecsEntityHandle> FFlecsEntityRecordSpawner::SpawnBulk(const UFlecsWorld* InWorld,
+	const FFlecsEntityRecord& InRecord, const int32 InCount)
+{
+	solid_checkf(IsValid(InWorld), TEXT("Flecs World is not valid"));
+	solid_checkf(InRecord.IsValid(), TEXT("Entity Record is not valid"));
+
+	TArray<FFlecsEntityHandle> Result;
+
+	if UNLIKELY_IF(InCount <= 0)
+	{
+		return Result;
+	}
+
+	Result.Reserve(InCount);
+
+	flecs::world_t* World = InWorld->World.c_ptr();
+
+	// Names are unique per scope, so they are not applied to bulk spawned entities
+	if UNLIKELY_IF(ecs_is_deferred(World) || ecs_stage_is_readonly(World))
+	{
+		FFlecsEntityRecord UnnamedRecord = InRecord;
+		UnnamedRecord.Name.Reset();
+
+		for (int32 Index = 0; Index < InCount; ++Index)
+		{
+			const FFlecsEntityHandle Entity = InWorld->CreateEntity();
+
+			if (UnnamedRecord.IsValid())
+			{
+				UnnamedRecord.ApplyRecordToEntity(Entity);
+			}
+			
+			Result.Add(Entity);
+		}
+
+		return Result;
+	}
+
+	const FFlecsCompiledEntityRecord& CompiledRecord = ObtainCompiledRecord(InWorld, InRecord);
+	flecs::table_t* Table = AddScopeToTable(World, CompiledRecord.Table);
+
+	const flecs::entity_t* Entities = SpawnInternal(InWorld, InRecord, CompiledRecord, Table, nullptr, InCount);
+	solid_check(Entities);
+
+	// The returned array is owned by the entity index and may move when new entities are created
+	for (int32 Index = 0; Index < InCount; ++Index)
+	{
+		Result.Emplace(InWorld, Entities[Index]);
+	}
+
+	for (const FFlecsEntityHandle& Entity : Result)
+	{
+		ApplyPostSpawn(InRecord, Entity);
+	}
+
+	return Result;
+}
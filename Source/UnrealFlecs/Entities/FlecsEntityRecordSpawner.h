@@ -0,0 +1,89 @@
+﻿// Solstice Games © 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "flecs.h"
+#include "FlecsEntityRecord.h"
+
+class UFlecsWorld;
+
+enum class EFlecsCompiledRecordValueSource : uint8
+{
+	Component = 0,
+	PairFirst = 1,
+	PairSecond = 2
+}; // enum class EFlecsCompiledRecordValueSource
+
+/**
+ * @brief A value of an entity record that is copied into the spawned entity,
+ * the memory is read from the record passed to the spawn call.
+ */
+struct FFlecsCompiledRecordValue
+{
+	flecs::id_t Id = 0;
+	int32 ComponentIndex = INDEX_NONE;
+	EFlecsCompiledRecordValueSource Source = EFlecsCompiledRecordValueSource::Component;
+
+}; // struct FFlecsCompiledRecordValue
+
+/**
+ * @brief An entity record resolved into the final table of the entity,
+ * only depends on the layout of the record (types, tags and entities) and not on the values.
+ */
+struct FFlecsCompiledEntityRecord
+{
+	/** Layout the record was compiled from, used to detect hash collisions */
+	TArray<uint64> Layout;
+
+	flecs::table_t* Table = nullptr;
+
+	/** Table with the (Identifier, Name) pair, so setting the name does not move the entity again */
+	flecs::table_t* NamedTable = nullptr;
+
+	TArray<FFlecsCompiledRecordValue> Values;
+
+	/** Value of ecs_world_info_t::table_delete_total when the record was compiled */
+	int64 TableDeleteTotal = 0;
+
+}; // struct FFlecsCompiledEntityRecord
+
+/**
+ * @brief Spawns entities from FFlecsEntityRecords with a single table append per call.
+ * Records are compiled once into their target table and cached by layout.
+ */
+struct UNREALFLECS_API FFlecsEntityRecordSpawner
+{
+	FFlecsEntityHandle Spawn(const UFlecsWorld* InWorld, const FFlecsEntityRecord& InRecord,
+		const flecs::entity_t InId = 0);
+
+	TArray<FFlecsEntityHandle> SpawnBulk(const UFlecsWorld* InWorld, const FFlecsEntityRecord& InRecord,
+		const int32 InCount);
+
+	/** Returns the compiled record, compiling it if the layout is not cached (or the table was deleted) */
+	const FFlecsCompiledEntityRecord& ObtainCompiledRecord(const UFlecsWorld* InWorld, const FFlecsEntityRecord& InRecord);
+
+	FORCEINLINE void Reset()
+	{
+		CompiledRecords.Empty();
+	}
+
+	FORCEINLINE NO_DISCARD int32 Num() const
+	{
+		return CompiledRecords.Num();
+	}
+
+	static void BuildLayout(const FFlecsEntityRecord& InRecord, TArray<uint64>& OutLayout);
+
+private:
+	void Compile(const UFlecsWorld* InWorld, const FFlecsEntityRecord& InRecord,
+		FFlecsCompiledEntityRecord& OutCompiledRecord) const;
+
+	const flecs::entity_t* SpawnInternal(const UFlecsWorld* InWorld, const FFlecsEntityRecord& InRecord,
+		const FFlecsCompiledEntityRecord& InCompiledRecord, flecs::table_t* InTable,
+		const flecs::entity_t* InIds, const int32 InCount) const;
+
+	TMap<uint32, FFlecsCompiledEntityRecord> CompiledRecords;
+	TArray<uint64> LayoutScratch;
+
+}; // struct FFlecsEntityRecordSpawner
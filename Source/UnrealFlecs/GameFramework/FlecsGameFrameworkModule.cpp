@@ -1,15 +1,126 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "FlecsGameFrameworkModule.h"
+#include "Components/FlecsActorTag.h"
+#include "Components/FlecsUObjectComponent.h"
+#include "Components/FlecsUObjectPtrCacheComponent.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "Transforms/FlecsTransformComponents.h"
+#include "Worlds/FlecsWorld.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsGameFrameworkModule)
 
+DECLARE_STATS_GROUP(TEXT("FlecsGameFrameworkModule"), STATGROUP_FlecsGameFrameworkModule, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("FlecsGameFrameworkModule::CollectActorTransforms"),
+	STAT_FlecsGameFrameworkModule_CollectActorTransforms, STATGROUP_FlecsGameFrameworkModule);
+DECLARE_CYCLE_STAT(TEXT("FlecsGameFrameworkModule::ApplyActorTransforms"),
+	STAT_FlecsGameFrameworkModule_ApplyActorTransforms, STATGROUP_FlecsGameFrameworkModule);
+
 void UFlecsGameFrameworkModule::InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity)
 {
-	
+	if (!bSyncActorTransforms)
+	{
+		return;
+	}
+
+	SyncActorTransformsSystem = InWorld->CreateSystemWithBuilder<const FFlecsWorldTransformComponent,
+		const FFlecsUObjectPtrCacheComponent>(TEXT("SyncActorTransformsSystem"))
+		.with<FFlecsActorTag, FFlecsUObjectComponent>()
+		// No phase, actors can only be moved on the game thread and the pipeline may run on the workers
+		.kind(0)
+		.cached()
+		.run([this](flecs::iter& Iter)
+		{
+			{
+				SCOPE_CYCLE_COUNTER(STAT_FlecsGameFrameworkModule_CollectActorTransforms);
+
+				PendingActorTransforms.Reset();
+
+				while (Iter.next())
+				{
+					// Only tables where the world transform was written since the last sync
+					if (!Iter.changed())
+					{
+						continue;
+					}
+
+					const flecs::field<const FFlecsWorldTransformComponent> Transforms
+						= Iter.field<const FFlecsWorldTransformComponent>(0);
+					const flecs::field<const FFlecsUObjectPtrCacheComponent> Objects
+						= Iter.field<const FFlecsUObjectPtrCacheComponent>(1);
+
+					for (const size_t Index : Iter)
+					{
+						// The actor pair guarantees that the object is an actor
+						AActor* Actor = static_cast<AActor*>(Objects[Index].GetObject());
+
+						if UNLIKELY_IF(!IsValid(Actor))
+						{
+							continue;
+						}
+
+						USceneComponent* RootComponent = Actor->GetRootComponent();
+
+						if UNLIKELY_IF(!RootComponent)
+						{
+							continue;
+						}
+
+						const FTransform Transform = Transforms[Index].GetTransform();
+
+						if (RootComponent->GetComponentTransform().Equals(Transform, ActorTransformTolerance))
+						{
+							continue;
+						}
+
+						PendingActorTransforms.Add({ RootComponent, Transform });
+					}
+				}
+			}
+
+			ApplyActorTransforms();
+		});
+
+	InWorld->AddGameThreadSystem(SyncActorTransformsSystem);
 }
 
 void UFlecsGameFrameworkModule::DeinitializeModule(UFlecsWorld* InWorld)
 {
-	
+	if (SyncActorTransformsSystem)
+	{
+		InWorld->RemoveGameThreadSystem(SyncActorTransformsSystem);
+		SyncActorTransformsSystem.destruct();
+	}
+
+	PendingActorTransforms.Empty();
+	NumSyncedActorTransforms = 0;
+}
+
+void UFlecsGameFrameworkModule::ApplyActorTransforms()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlecsGameFrameworkModule_ApplyActorTransforms);
+
+	NumSyncedActorTransforms = PendingActorTransforms.Num();
+
+	if (PendingActorTransforms.IsEmpty())
+	{
+		return;
+	}
+
+	// Scene components can only be moved on the game thread. Every component gets a deferred movement scope,
+	// so that overlaps are updated once all actors of the batch are at their new location.
+	// Scopes register themselves with their component, the array must not reallocate while they are alive.
+	TArray<FScopedMovementUpdate> MovementScopes;
+	MovementScopes.Reserve(PendingActorTransforms.Num());
+
+	for (const FActorTransformUpdate& Update : PendingActorTransforms)
+	{
+		MovementScopes.Emplace(Update.Component, EScopedUpdate::DeferredUpdates);
+		Update.Component->SetWorldTransform(Update.Transform, false, nullptr, ETeleportType::None);
+	}
+
+	// Each component has its own scope stack, so the scopes can be ended in any order
+	MovementScopes.Empty();
+	PendingActorTransforms.Reset();
 }
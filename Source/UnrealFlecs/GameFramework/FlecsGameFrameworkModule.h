@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Modules/FlecsModuleObject.h"
+#include "Systems/FlecsSystem.h"
 #include "FlecsGameFrameworkModule.generated.h"
 
+class USceneComponent;
+
 UCLASS(BlueprintType, DisplayName = "Flecs GameFramework Module")
 class UNREALFLECS_API UFlecsGameFrameworkModule final : public UFlecsModuleObject
 {
@@ -20,5 +23,41 @@ public:
 		return TEXT("Flecs GameFramework Module");
 	}
 
+	/**
+	 * Write the FFlecsWorldTransformComponent of actor entities to the root component of their actor
+	 * on the game thread after the pipeline.
+	 * Only tables where the world transform changed are visited, the transforms are collected first
+	 * and then applied in a single pass, overlaps are updated once all actors were moved.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flecs | GameFramework")
+	bool bSyncActorTransforms = true;
+
+	/** Actors that are closer than this to the transform of their entity are not moved */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flecs | GameFramework",
+		meta = (EditCondition = "bSyncActorTransforms", ClampMin = "0.0"))
+	double ActorTransformTolerance = UE_KINDA_SMALL_NUMBER;
+
+	/** Number of actors moved by the last sync */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | GameFramework")
+	FORCEINLINE int32 GetNumSyncedActorTransforms() const
+	{
+		return NumSyncedActorTransforms;
+	}
+
+	flecs::system SyncActorTransformsSystem;
+
+private:
+	struct FActorTransformUpdate
+	{
+		USceneComponent* Component = nullptr;
+		FTransform Transform;
+	}; // struct FActorTransformUpdate
+
+	void ApplyActorTransforms();
+
+	/** Reused between frames to avoid reallocating */
+	TArray<FActorTransformUpdate> PendingActorTransforms;
+
+	int32 NumSyncedActorTransforms = 0;
 
 }; // class UFlecsGameFrameworkModule
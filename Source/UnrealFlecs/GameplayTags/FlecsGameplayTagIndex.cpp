@@ -0,0 +1,282 @@
+// Solstice Games © 2024. All Rights Reserved.
+
+#include "FlecsGameplayTagIndex.h"
+#include "Worlds/FlecsWorld.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlecsGameplayTagIndex::Build"),
+	STAT_FlecsGameplayTagIndexBuild, STATGROUP_FlecsWorld);
+
+void FFlecsGameplayTagIndex::Build(const UFlecsWorld* InWorld,
+	const TMap<FGameplayTag, TArray<FGameplayTag>>& InTagHierarchy)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlecsGameplayTagIndexBuild);
+
+	solid_checkf(IsValid(InWorld), TEXT("Flecs World is not valid"));
+
+	flecs::world_t* World = InWorld->World.c_ptr();
+	solid_checkf(!ecs_is_deferred(World), TEXT("Gameplay tag entities can't be created while deferred"));
+
+	Reset();
+
+	TArray<FGameplayTag> RootTags;
+
+	for (const TTuple<FGameplayTag, TArray<FGameplayTag>>& Pair : InTagHierarchy)
+	{
+		if (!Pair.Key.IsValid())
+		{
+			continue;
+		}
+
+		const FGameplayTag ParentTag = Pair.Key.RequestDirectParent();
+
+		if (!ParentTag.IsValid() || !InTagHierarchy.Contains(ParentTag))
+		{
+			RootTags.Add(Pair.Key);
+		}
+	}
+
+	// Sorted so the intervals are stable between runs
+	RootTags.Sort([](const FGameplayTag& A, const FGameplayTag& B)
+	{
+		return A.GetTagName().LexicalLess(B.GetTagName());
+	});
+
+	TMap<FGameplayTag, FFlecsGameplayTagInterval> TagIntervals;
+	TArray<TPair<FGameplayTag, TArray<FGameplayTag>>> SiblingGroups;
+	SiblingGroups.Emplace(FGameplayTag::EmptyTag, RootTags);
+
+	int32 PreOrder = 0;
+
+	for (const FGameplayTag& RootTag : RootTags)
+	{
+		AssignIntervals(RootTag, InTagHierarchy, TagIntervals, SiblingGroups, PreOrder);
+	}
+
+	const flecs::entity_t TagComponent = InWorld->ObtainComponentType<FGameplayTag>().GetId();
+	const flecs::entity_t IntervalComponent = InWorld->ObtainComponentType<FFlecsGameplayTagInterval>().GetId();
+
+	flecs::table_t* TagTable = ecs_table_add_id(World, nullptr, TagComponent);
+	TagTable = ecs_table_add_id(World, TagTable, IntervalComponent);
+	TagTable = ecs_table_add_id(World, TagTable, ecs_pair(ecs_id(EcsIdentifier), EcsName));
+
+	TagEntities.Reserve(TagIntervals.Num());
+	Intervals.Reserve(TagIntervals.Num());
+
+	TArray<FGameplayTag> BulkTags;
+	TArray<flecs::entity_t> BulkEntities;
+
+	// Groups are in pre-order, so the parent of a group is always created before the group itself
+	for (const TPair<FGameplayTag, TArray<FGameplayTag>>& SiblingGroup : SiblingGroups)
+	{
+		const flecs::entity_t ParentEntity = SiblingGroup.Key.IsValid() ? GetTagEntity(SiblingGroup.Key) : 0;
+
+		BulkTags.Reset();
+
+		for (const FGameplayTag& Tag : SiblingGroup.Value)
+		{
+			const FString Name = ExtractLastPartOfTagName(Tag.GetTagName().ToString());
+
+			// Entities that already exist (e.g. created by name before the world started) keep their id
+			if (const flecs::entity_t ExistingEntity
+				= ecs_lookup_path_w_sep(World, ParentEntity, StringCast<char>(*Name).Get(), ".", ".", false))
+			{
+				const FFlecsEntityHandle TagEntity(InWorld, ExistingEntity);
+				TagEntity.Set<FGameplayTag>(Tag);
+				TagEntity.Set<FFlecsGameplayTagInterval>(TagIntervals.FindChecked(Tag));
+
+				TagEntities.Add(Tag, ExistingEntity);
+				Intervals.Add(ExistingEntity, TagIntervals.FindChecked(Tag));
+				continue;
+			}
+
+			BulkTags.Add(Tag);
+		}
+
+		if (BulkTags.IsEmpty())
+		{
+			continue;
+		}
+
+		ecs_bulk_desc_t Desc = {};
+		Desc.count = BulkTags.Num();
+		Desc.table = ParentEntity ? ecs_table_add_id(World, TagTable, ecs_childof(ParentEntity)) : TagTable;
+
+		// The returned array is owned by the entity index and may move when new entities are created
+		const flecs::entity_t* Entities = ecs_bulk_init(World, &Desc);
+		BulkEntities = TArray<flecs::entity_t>(Entities, BulkTags.Num());
+
+		for (int32 Index = 0; Index < BulkTags.Num(); ++Index)
+		{
+			const FGameplayTag& Tag = BulkTags[Index];
+			const FFlecsGameplayTagInterval& Interval = TagIntervals.FindChecked(Tag);
+
+			// The entities already have all components, so none of these move them
+			const FFlecsEntityHandle TagEntity(InWorld, BulkEntities[Index]);
+			TagEntity.SetName(ExtractLastPartOfTagName(Tag.GetTagName().ToString()));
+			TagEntity.Set<FGameplayTag>(Tag);
+			TagEntity.Set<FFlecsGameplayTagInterval>(Interval);
+
+			TagEntities.Add(Tag, BulkEntities[Index]);
+			Intervals.Add(BulkEntities[Index], Interval);
+		}
+	}
+}
+
+void FFlecsGameplayTagIndex::AssignIntervals(const FGameplayTag& InTag,
+	const TMap<FGameplayTag, TArray<FGameplayTag>>& InTagHierarchy,
+	TMap<FGameplayTag, FFlecsGameplayTagInterval>& OutIntervals,
+	TArray<TPair<FGameplayTag, TArray<FGameplayTag>>>& OutSiblingGroups, int32& InOutPreOrder) const
+{
+	if UNLIKELY_IF(OutIntervals.Contains(InTag))
+	{
+		return;
+	}
+
+	OutIntervals.Add(InTag, FFlecsGameplayTagInterval(InOutPreOrder++, INDEX_NONE));
+
+	if (const TArray<FGameplayTag>* Children = InTagHierarchy.Find(InTag); Children && !Children->IsEmpty())
+	{
+		TArray<FGameplayTag> SortedChildren = *Children;
+		SortedChildren.Sort([](const FGameplayTag& A, const FGameplayTag& B)
+		{
+			return A.GetTagName().LexicalLess(B.GetTagName());
+		});
+
+		OutSiblingGroups.Emplace(InTag, SortedChildren);
+
+		for (const FGameplayTag& ChildTag : SortedChildren)
+		{
+			AssignIntervals(ChildTag, InTagHierarchy, OutIntervals, OutSiblingGroups, InOutPreOrder);
+		}
+	}
+
+	// The map may have grown while visiting the children
+	OutIntervals.FindChecked(InTag).Post = InOutPreOrder - 1;
+}
+
+void FFlecsGameplayTagIndex::Reset()
+{
+	TagEntities.Empty();
+	Intervals.Empty();
+	TablePreOrders.Empty();
+	TableDeleteTotal = 0;
+}
+
+void FFlecsGameplayTagIndex::CopyFrom(const FFlecsGameplayTagIndex& InOther)
+{
+	// Tag entities keep their ids in the copy, the cached tables belong to the other world
+	TagEntities = InOther.TagEntities;
+	Intervals = InOther.Intervals;
+	TablePreOrders.Empty();
+	TableDeleteTotal = 0;
+}
+
+bool FFlecsGameplayTagIndex::IsTagUnder(const FGameplayTag& InTag, const FGameplayTag& InAncestor) const
+{
+	const FFlecsGameplayTagInterval* TagInterval = GetInterval(InTag);
+	const FFlecsGameplayTagInterval* AncestorInterval = GetInterval(InAncestor);
+
+	if UNLIKELY_IF(!TagInterval || !AncestorInterval)
+	{
+		return false;
+	}
+
+	return AncestorInterval->Contains(*TagInterval);
+}
+
+bool FFlecsGameplayTagIndex::TableHasTagUnder(const flecs::world_t* InWorld, const flecs::table_t* InTable,
+	const FFlecsGameplayTagInterval& InAncestor)
+{
+	if (!InTable || !InAncestor.IsValid())
+	{
+		return false;
+	}
+
+	const TArray<int32>& PreOrders = ObtainTablePreOrders(InWorld, InTable);
+	return AnyPreOrderWithin(PreOrders.GetData(), PreOrders.Num(), InAncestor);
+}
+
+const TArray<int32>& FFlecsGameplayTagIndex::ObtainTablePreOrders(const flecs::world_t* InWorld,
+	const flecs::table_t* InTable)
+{
+	// Table pointers are reused after a table is deleted
+	const int64 CurrentTableDeleteTotal = ecs_get_world_info(InWorld)->table_delete_total;
+
+	if UNLIKELY_IF(TableDeleteTotal != CurrentTableDeleteTotal)
+	{
+		TablePreOrders.Reset();
+		TableDeleteTotal = CurrentTableDeleteTotal;
+	}
+
+	if (const TArray<int32>* PreOrders = TablePreOrders.Find(InTable))
+	{
+		return *PreOrders;
+	}
+
+	TArray<int32>& PreOrders = TablePreOrders.Add(InTable);
+
+	const ecs_type_t* Type = ecs_table_get_type(InTable);
+
+	for (int32 Index = 0; Index < Type->count; ++Index)
+	{
+		if (ECS_IS_PAIR(Type->array[Index]))
+		{
+			continue;
+		}
+
+		if (const FFlecsGameplayTagInterval* Interval = GetInterval(Type->array[Index]))
+		{
+			PreOrders.Add(Interval->Pre);
+		}
+	}
+
+	return PreOrders;
+}
+
+bool FFlecsGameplayTagIndex::AnyPreOrderWithin(const int32* InPreOrders, const int32 InNum,
+	const FFlecsGameplayTagInterval& InInterval)
+{
+	const VectorRegister4Int Pre = VectorIntSet1(InInterval.Pre);
+	const VectorRegister4Int Post = VectorIntSet1(InInterval.Post);
+
+	int32 Index = 0;
+
+	for (; Index + 4 <= InNum; Index += 4)
+	{
+		const VectorRegister4Int PreOrders = VectorIntLoad(InPreOrders + Index);
+
+		// A lane is outside if it is before the tag or after its last descendant
+		const VectorRegister4Int Outside = VectorIntOr(
+			VectorIntCompareLT(PreOrders, Pre), VectorIntCompareGT(PreOrders, Post));
+
+		if (VectorMaskBits(VectorCastIntToFloat(Outside)) != 0xF)
+		{
+			return true;
+		}
+	}
+
+	for (; Index < InNum; ++Index)
+	{
+		if (InInterval.ContainsPreOrder(InPreOrders[Index]))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FString FFlecsGameplayTagIndex::ExtractLastPartOfTagName(const FString& FullTagName)
+{
+	if (FullTagName.IsEmpty())
+	{
+		return FString();
+	}
+
+	if (int32 LastDotIndex; FullTagName.FindLastChar(TEXT('.'), LastDotIndex))
+	{
+		return FullTagName.RightChop(LastDotIndex + 1);
+	}
+
+	return FullTagName;
+}
@@ -0,0 +1,81 @@
+// Solstice Games © 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "flecs.h"
+#include "GameplayTagContainer.h"
+#include "FlecsGameplayTagInterval.h"
+
+class UFlecsWorld;
+
+/**
+ * @brief Index of the gameplay tag entities of a world.
+ * Every tag entity gets a FFlecsGameplayTagInterval, ancestry tests are two integer compares
+ * instead of traversing the ChildOf hierarchy of the tag entities.
+ */
+struct UNREALFLECS_API FFlecsGameplayTagIndex
+{
+	/**
+	 * @brief Create the tag entities of the hierarchy, one table append per group of siblings.
+	 * @param InTagHierarchy Map of every tag to its direct children
+	 */
+	void Build(const UFlecsWorld* InWorld, const TMap<FGameplayTag, TArray<FGameplayTag>>& InTagHierarchy);
+
+	void Reset();
+
+	/** Copy the tags and intervals of the index of a world this world was copied from */
+	void CopyFrom(const FFlecsGameplayTagIndex& InOther);
+
+	FORCEINLINE NO_DISCARD int32 Num() const
+	{
+		return TagEntities.Num();
+	}
+
+	/** Returns 0 if the tag is not indexed */
+	FORCEINLINE NO_DISCARD flecs::entity_t GetTagEntity(const FGameplayTag& InTag) const
+	{
+		const flecs::entity_t* TagEntity = TagEntities.Find(InTag);
+		return TagEntity ? *TagEntity : 0;
+	}
+
+	FORCEINLINE NO_DISCARD const FFlecsGameplayTagInterval* GetInterval(const flecs::entity_t InTagEntity) const
+	{
+		return Intervals.Find(InTagEntity);
+	}
+
+	FORCEINLINE NO_DISCARD const FFlecsGameplayTagInterval* GetInterval(const FGameplayTag& InTag) const
+	{
+		return GetInterval(GetTagEntity(InTag));
+	}
+
+	/** True if InTag is InAncestor or one of its descendants */
+	NO_DISCARD bool IsTagUnder(const FGameplayTag& InTag, const FGameplayTag& InAncestor) const;
+
+	/** True if the table has InAncestor or any of its descendants as a tag */
+	NO_DISCARD bool TableHasTagUnder(const flecs::world_t* InWorld, const flecs::table_t* InTable,
+		const FFlecsGameplayTagInterval& InAncestor);
+
+	/** Pre-order indices of the tag entities in the type of the table, cached per table */
+	NO_DISCARD const TArray<int32>& ObtainTablePreOrders(const flecs::world_t* InWorld, const flecs::table_t* InTable);
+
+	/** Vectorized scan, true if any of the pre-order indices is inside of the interval */
+	static NO_DISCARD bool AnyPreOrderWithin(const int32* InPreOrders, const int32 InNum,
+		const FFlecsGameplayTagInterval& InInterval);
+
+	static NO_DISCARD FString ExtractLastPartOfTagName(const FString& FullTagName);
+
+private:
+	void AssignIntervals(const FGameplayTag& InTag, const TMap<FGameplayTag, TArray<FGameplayTag>>& InTagHierarchy,
+		TMap<FGameplayTag, FFlecsGameplayTagInterval>& OutIntervals,
+		TArray<TPair<FGameplayTag, TArray<FGameplayTag>>>& OutSiblingGroups, int32& InOutPreOrder) const;
+
+	TMap<FGameplayTag, flecs::entity_t> TagEntities;
+	TMap<flecs::entity_t, FFlecsGameplayTagInterval> Intervals;
+
+	TMap<const flecs::table_t*, TArray<int32>> TablePreOrders;
+
+	/** Value of ecs_world_info_t::table_delete_total when TablePreOrders was last validated */
+	int64 TableDeleteTotal = 0;
+
+}; // struct FFlecsGameplayTagIndex
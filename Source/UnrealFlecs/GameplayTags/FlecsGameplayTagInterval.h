@@ -0,0 +1,56 @@
+﻿// Solstice Games © 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SolidMacros/Macros.h"
+#include "FlecsGameplayTagInterval.generated.h"
+
+/**
+ * @brief Nested-set interval of a gameplay tag entity, set on every tag entity at world start.
+ * Pre is the depth-first pre-order index of the tag and Post is the largest pre-order index in its subtree,
+ * so [Pre, Post] covers exactly the tag and all of its descendants.
+ */
+USTRUCT(BlueprintType)
+struct UNREALFLECS_API FFlecsGameplayTagInterval
+{
+	GENERATED_BODY()
+
+public:
+	FORCEINLINE FFlecsGameplayTagInterval() = default;
+	FORCEINLINE FFlecsGameplayTagInterval(const int32 InPre, const int32 InPost) : Pre(InPre), Post(InPost) {}
+
+	/** True if the tag with the given pre-order index is this tag or one of its descendants */
+	FORCEINLINE NO_DISCARD bool ContainsPreOrder(const int32 InPreOrder) const
+	{
+		return Pre <= InPreOrder && InPreOrder <= Post;
+	}
+
+	/** True if the other tag is this tag or one of its descendants */
+	FORCEINLINE NO_DISCARD bool Contains(const FFlecsGameplayTagInterval& Other) const
+	{
+		return ContainsPreOrder(Other.Pre);
+	}
+
+	FORCEINLINE NO_DISCARD bool IsValid() const
+	{
+		return Pre != INDEX_NONE;
+	}
+
+	FORCEINLINE NO_DISCARD bool operator==(const FFlecsGameplayTagInterval& Other) const
+	{
+		return Pre == Other.Pre && Post == Other.Post;
+	}
+
+	FORCEINLINE NO_DISCARD bool operator!=(const FFlecsGameplayTagInterval& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flecs | Gameplay Tags")
+	int32 Pre = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flecs | Gameplay Tags")
+	int32 Post = INDEX_NONE;
+	
+}; // struct FFlecsGameplayTagInterval
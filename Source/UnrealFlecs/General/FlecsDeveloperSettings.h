@@ -23,4 +23,12 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = "Flecs", meta = (EditCondition = "bUseTaskThreads"))
 	int32 TaskThreadCount = 4;
 
+	/** Share up traversal results (e.g. components inherited from parents or prefabs) between queries and frames */
+	UPROPERTY(EditAnywhere, Config, Category = "Flecs")
+	bool bUseTraversalCache = false;
+
+	/** Build the meta members of every type when it is registered instead of when a serializer or REST asks for them */
+	UPROPERTY(EditAnywhere, Config, Category = "Flecs")
+	bool bReflectTypesOnRegistration = false;
+
 }; // class UFlecsDeveloperSettings
@@ -0,0 +1,501 @@
+﻿// Solstice Games © 2024. All Rights Reserved.
+
+#include "EntityBatchFunctionLibrary.h"
+#include "Logs/FlecsCategories.h"
+#include "Worlds/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EntityBatchFunctionLibrary)
+
+DECLARE_STATS_GROUP(TEXT("EntityBatchFunctionLibrary"), STATGROUP_EntityBatchFunctionLibrary, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("EntityBatchFunctionLibrary::GetQueryComponentValues"),
+	STAT_EntityBatchFunctionLibrary_GetQueryComponentValues, STATGROUP_EntityBatchFunctionLibrary);
+DECLARE_CYCLE_STAT(TEXT("EntityBatchFunctionLibrary::GetComponentValues"),
+	STAT_EntityBatchFunctionLibrary_GetComponentValues, STATGROUP_EntityBatchFunctionLibrary);
+DECLARE_CYCLE_STAT(TEXT("EntityBatchFunctionLibrary::SetComponentValues"),
+	STAT_EntityBatchFunctionLibrary_SetComponentValues, STATGROUP_EntityBatchFunctionLibrary);
+
+namespace
+{
+	/**
+	 * Calls InFunction for every run of consecutive entities that are stored in consecutive rows of the same table,
+	 * with the column of the component at the first row of the run.
+	 * The column is nullptr for entities that are not alive or that don't store the component in their table,
+	 * e.g. inherited or non-fragmenting components, these are passed one entity at a time.
+	 * Records are looked up right before a run is passed, so InFunction is allowed to move the entities of its run.
+	 */
+	template <typename TFunction>
+	void ForEachComponentRun(const UFlecsWorld* InWorld, const TArray<FFlecsEntityHandle>& InEntities,
+		const flecs::entity_t InComponent, TFunction&& InFunction)
+	{
+		flecs::world_t* World = InWorld->World.c_ptr();
+
+		const ecs_table_t* ColumnTable = nullptr;
+		int32 ColumnIndex = -1;
+
+		int32 Index = 0;
+
+		while (Index < InEntities.Num())
+		{
+			const ecs_record_t* Record = ecs_record_find(World, InEntities[Index].GetId());
+
+			if UNLIKELY_IF(!Record || !Record->table)
+			{
+				InFunction(Index, nullptr, 1);
+				++Index;
+				continue;
+			}
+
+			if (Record->table != ColumnTable)
+			{
+				ColumnTable = Record->table;
+				ColumnIndex = ecs_table_get_column_index(World, Record->table, InComponent);
+			}
+
+			if (ColumnIndex == -1)
+			{
+				InFunction(Index, nullptr, 1);
+				++Index;
+				continue;
+			}
+
+			const int32 Row = ECS_RECORD_TO_ROW(Record->row);
+			int32 Count = 1;
+
+			while (Index + Count < InEntities.Num())
+			{
+				const ecs_record_t* NextRecord = ecs_record_find(World, InEntities[Index + Count].GetId());
+
+				if (!NextRecord || NextRecord->table != Record->table
+					|| ECS_RECORD_TO_ROW(NextRecord->row) != Row + Count)
+				{
+					break;
+				}
+
+				++Count;
+			}
+
+			InFunction(Index, ecs_table_get_column(Record->table, ColumnIndex, Row), Count);
+			Index += Count;
+		}
+	}
+
+	NO_DISCARD const UScriptStruct* GetArrayStruct(const FArrayProperty* InArrayProperty)
+	{
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(InArrayProperty->Inner);
+
+		if UNLIKELY_IF(!InnerProperty)
+		{
+			UN_LOGF(LogFlecsEntity, Error, "Component arrays must be arrays of structs, got %s",
+				*InArrayProperty->Inner->GetCPPType());
+			return nullptr;
+		}
+
+		return InnerProperty->Struct;
+	}
+
+	/** Values must be initialized, copying into uninitialized memory is only allowed for plain old data */
+	void CopyComponentValues(const UScriptStruct* InStruct, void* InDest, const void* InSrc, const int32 InCount)
+	{
+		if (InStruct->StructFlags & STRUCT_IsPlainOldData)
+		{
+			FMemory::Memcpy(InDest, InSrc, static_cast<SIZE_T>(InStruct->GetStructureSize()) * InCount);
+		}
+		else
+		{
+			InStruct->CopyScriptStruct(InDest, InSrc, InCount);
+		}
+	}
+	
+} // namespace
+
+TArray<FFlecsEntityHandle> UEntityBatchFunctionLibrary::GetQueryEntities(UFlecsWorld* World,
+	const FFlecsQueryDefinition& Definition)
+{
+	TArray<FFlecsEntityHandle> Entities;
+
+	if UNLIKELY_IF(!IsValid(World))
+	{
+		return Entities;
+	}
+
+	flecs::query_builder<> QueryBuilder = World->World.query_builder<>();
+	Definition.Apply(World, QueryBuilder);
+
+	flecs::query<> Query = QueryBuilder.build();
+	Entities.Reserve(Query.count());
+
+	Query.run([World, &Entities](flecs::iter& Iter)
+	{
+		while (Iter.next())
+		{
+			for (const size_t Index : Iter)
+			{
+				Entities.Emplace(World, Iter.entity(Index));
+			}
+		}
+	});
+
+	Query.destruct();
+	return Entities;
+}
+
+void UEntityBatchFunctionLibrary::GetQueryComponentValues(UFlecsWorld* World,
+	const FFlecsQueryDefinition& Definition, TArray<FFlecsEntityHandle>& OutEntities, TArray<int32>& Values)
+{
+	// Never called, the custom thunk calls GenericGetQueryComponentValues
+	checkNoEntry();
+}
+
+void UEntityBatchFunctionLibrary::GetComponentValues(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, TArray<int32>& Values)
+{
+	checkNoEntry();
+}
+
+void UEntityBatchFunctionLibrary::SetComponentValues(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, const TArray<int32>& Values)
+{
+	checkNoEntry();
+}
+
+DEFINE_FUNCTION(UEntityBatchFunctionLibrary::execGetQueryComponentValues)
+{
+	P_GET_OBJECT(UFlecsWorld, World);
+	P_GET_STRUCT_REF(FFlecsQueryDefinition, Definition);
+	P_GET_TARRAY_REF(FFlecsEntityHandle, OutEntities);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FArrayProperty>(nullptr);
+	void* ValuesAddress = Stack.MostRecentPropertyAddress;
+	const FArrayProperty* ValuesProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+	P_FINISH;
+
+	if UNLIKELY_IF(!ValuesProperty)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	GenericGetQueryComponentValues(World, Definition, OutEntities, ValuesAddress, ValuesProperty);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UEntityBatchFunctionLibrary::execGetComponentValues)
+{
+	P_GET_OBJECT(UFlecsWorld, World);
+	P_GET_TARRAY_REF(FFlecsEntityHandle, Entities);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FArrayProperty>(nullptr);
+	void* ValuesAddress = Stack.MostRecentPropertyAddress;
+	const FArrayProperty* ValuesProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+	P_FINISH;
+
+	if UNLIKELY_IF(!ValuesProperty)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	GenericGetComponentValues(World, Entities, ValuesAddress, ValuesProperty);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(UEntityBatchFunctionLibrary::execSetComponentValues)
+{
+	P_GET_OBJECT(UFlecsWorld, World);
+	P_GET_TARRAY_REF(FFlecsEntityHandle, Entities);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FArrayProperty>(nullptr);
+	const void* ValuesAddress = Stack.MostRecentPropertyAddress;
+	const FArrayProperty* ValuesProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+	P_FINISH;
+
+	if UNLIKELY_IF(!ValuesProperty)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	GenericSetComponentValues(World, Entities, ValuesAddress, ValuesProperty);
+	P_NATIVE_END;
+}
+
+void UEntityBatchFunctionLibrary::GenericGetQueryComponentValues(UFlecsWorld* World,
+	const FFlecsQueryDefinition& Definition, TArray<FFlecsEntityHandle>& OutEntities,
+	void* ValuesAddress, const FArrayProperty* ValuesProperty)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EntityBatchFunctionLibrary_GetQueryComponentValues);
+
+	FScriptArrayHelper Values(ValuesProperty, ValuesAddress);
+	Values.EmptyValues();
+	OutEntities.Reset();
+
+	const UScriptStruct* Struct = GetArrayStruct(ValuesProperty);
+
+	if UNLIKELY_IF(!IsValid(World) || !Struct)
+	{
+		return;
+	}
+
+	const flecs::entity_t Component = World->ObtainComponentTypeStruct(Struct).GetId();
+	const int32 StructSize = Struct->GetStructureSize();
+
+	flecs::query_builder<> QueryBuilder = World->World.query_builder<>();
+	Definition.Apply(World, QueryBuilder);
+
+	flecs::query<> Query = QueryBuilder.build();
+
+	Query.run([&](flecs::iter& Iter)
+	{
+		while (Iter.next())
+		{
+			const ecs_iter_t* It = Iter.c_ptr();
+			const int32 Count = static_cast<int32>(Iter.count());
+			const int32 First = OutEntities.Num();
+
+			for (const size_t Index : Iter)
+			{
+				OutEntities.Emplace(World, Iter.entity(Index));
+			}
+
+			const int32 ColumnIndex = It->table
+				? ecs_table_get_column_index(It->real_world, It->table, Component) : -1;
+
+			// Plain old data is copied into uninitialized values straight from the column
+			if (ColumnIndex != -1 && (Struct->StructFlags & STRUCT_IsPlainOldData))
+			{
+				Values.AddUninitializedValues(Count);
+				FMemory::Memcpy(Values.GetRawPtr(First),
+					ecs_table_get_column(It->table, ColumnIndex, It->offset),
+					static_cast<SIZE_T>(StructSize) * Count);
+				continue;
+			}
+
+			Values.AddValues(Count);
+
+			if (ColumnIndex != -1)
+			{
+				Struct->CopyScriptStruct(Values.GetRawPtr(First),
+					ecs_table_get_column(It->table, ColumnIndex, It->offset), Count);
+				continue;
+			}
+
+			// Inherited, non-fragmenting or not matched by the query
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				if (const void* Value = ecs_get_id(It->real_world, OutEntities[First + Index].GetId(), Component))
+				{
+					Struct->CopyScriptStruct(Values.GetRawPtr(First + Index), Value);
+				}
+			}
+		}
+	});
+
+	Query.destruct();
+}
+
+void UEntityBatchFunctionLibrary::GenericGetComponentValues(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, void* ValuesAddress, const FArrayProperty* ValuesProperty)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EntityBatchFunctionLibrary_GetComponentValues);
+
+	FScriptArrayHelper Values(ValuesProperty, ValuesAddress);
+	Values.EmptyValues();
+
+	const UScriptStruct* Struct = GetArrayStruct(ValuesProperty);
+
+	if UNLIKELY_IF(!IsValid(World) || !Struct)
+	{
+		return;
+	}
+
+	const flecs::entity_t Component = World->ObtainComponentTypeStruct(Struct).GetId();
+
+	Values.AddValues(Entities.Num());
+
+	ForEachComponentRun(World, Entities, Component,
+		[&](const int32 InIndex, const void* InColumn, const int32 InCount)
+		{
+			if (InColumn)
+			{
+				CopyComponentValues(Struct, Values.GetRawPtr(InIndex), InColumn, InCount);
+			}
+			else if (const void* Value = ecs_get_id(World->World.c_ptr(), Entities[InIndex].GetId(), Component))
+			{
+				Struct->CopyScriptStruct(Values.GetRawPtr(InIndex), Value);
+			}
+		});
+}
+
+void UEntityBatchFunctionLibrary::GenericSetComponentValues(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, const void* ValuesAddress, const FArrayProperty* ValuesProperty)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EntityBatchFunctionLibrary_SetComponentValues);
+
+	FScriptArrayHelper Values(ValuesProperty, ValuesAddress);
+
+	const UScriptStruct* Struct = GetArrayStruct(ValuesProperty);
+
+	if UNLIKELY_IF(!IsValid(World) || !Struct)
+	{
+		return;
+	}
+
+	if UNLIKELY_IF(Values.Num() != Entities.Num())
+	{
+		UN_LOGF(LogFlecsEntity, Error, "Expected %d values for %d entities, got %d",
+			Entities.Num(), Entities.Num(), Values.Num());
+		return;
+	}
+
+	flecs::world_t* FlecsWorld = World->World.c_ptr();
+	const flecs::entity_t Component = World->ObtainComponentTypeStruct(Struct).GetId();
+	const int32 StructSize = Struct->GetStructureSize();
+
+	// Columns can't be written directly while commands are deferred
+	if (ecs_is_deferred(FlecsWorld))
+	{
+		for (int32 Index = 0; Index < Entities.Num(); ++Index)
+		{
+			ecs_set_id(FlecsWorld, Entities[Index].GetId(), Component, StructSize, Values.GetRawPtr(Index));
+		}
+
+		return;
+	}
+
+	ForEachComponentRun(World, Entities, Component,
+		[&](const int32 InIndex, void* InColumn, const int32 InCount)
+		{
+			if (!InColumn)
+			{
+				ecs_set_id(FlecsWorld, Entities[InIndex].GetId(), Component, StructSize, Values.GetRawPtr(InIndex));
+				return;
+			}
+
+			CopyComponentValues(Struct, InColumn, Values.GetRawPtr(InIndex), InCount);
+
+			// Marks the table as changed and runs OnSet observers
+			for (int32 Index = InIndex; Index < InIndex + InCount; ++Index)
+			{
+				ecs_modified_id(FlecsWorld, Entities[Index].GetId(), Component);
+			}
+		});
+}
+
+void UEntityBatchFunctionLibrary::GetComponentInstancedStructs(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, UScriptStruct* ComponentType, TArray<FInstancedStruct>& OutValues)
+{
+	OutValues.Reset(Entities.Num());
+
+	if UNLIKELY_IF(!IsValid(World) || !IsValid(ComponentType))
+	{
+		return;
+	}
+
+	const flecs::entity_t Component = World->ObtainComponentTypeStruct(ComponentType).GetId();
+
+	OutValues.SetNum(Entities.Num());
+
+	ForEachComponentRun(World, Entities, Component,
+		[&](const int32 InIndex, const void* InColumn, const int32 InCount)
+		{
+			if (!InColumn)
+			{
+				OutValues[InIndex].InitializeAs(ComponentType,
+					static_cast<const uint8*>(ecs_get_id(World->World.c_ptr(), Entities[InIndex].GetId(), Component)));
+				return;
+			}
+
+			const int32 StructSize = ComponentType->GetStructureSize();
+
+			for (int32 Index = 0; Index < InCount; ++Index)
+			{
+				OutValues[InIndex + Index].InitializeAs(ComponentType,
+					static_cast<const uint8*>(InColumn) + static_cast<SIZE_T>(StructSize) * Index);
+			}
+		});
+}
+
+void UEntityBatchFunctionLibrary::SetComponentInstancedStructs(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, const TArray<FInstancedStruct>& Values)
+{
+	if UNLIKELY_IF(!IsValid(World))
+	{
+		return;
+	}
+
+	if UNLIKELY_IF(Values.Num() != Entities.Num())
+	{
+		UN_LOGF(LogFlecsEntity, Error, "Expected %d values for %d entities, got %d",
+			Entities.Num(), Entities.Num(), Values.Num());
+		return;
+	}
+
+	flecs::world_t* FlecsWorld = World->World.c_ptr();
+
+	const UScriptStruct* LastStruct = nullptr;
+	flecs::entity_t Component = 0;
+
+	for (int32 Index = 0; Index < Entities.Num(); ++Index)
+	{
+		const UScriptStruct* Struct = Values[Index].GetScriptStruct();
+
+		if UNLIKELY_IF(!Struct)
+		{
+			continue;
+		}
+
+		// Values are usually all of the same type
+		if (Struct != LastStruct)
+		{
+			LastStruct = Struct;
+			Component = World->ObtainComponentTypeStruct(Struct).GetId();
+		}
+
+		ecs_set_id(FlecsWorld, Entities[Index].GetId(), Component,
+			Struct->GetStructureSize(), Values[Index].GetMemory());
+	}
+}
+
+void UEntityBatchFunctionLibrary::AddComponentToEntities(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, UScriptStruct* ComponentType)
+{
+	if UNLIKELY_IF(!IsValid(World) || !IsValid(ComponentType))
+	{
+		return;
+	}
+
+	flecs::world_t* FlecsWorld = World->World.c_ptr();
+	const flecs::entity_t Component = World->ObtainComponentTypeStruct(ComponentType).GetId();
+
+	// Moves between the same tables reuse the cached table graph edge
+	for (const FFlecsEntityHandle& Entity : Entities)
+	{
+		ecs_add_id(FlecsWorld, Entity.GetId(), Component);
+	}
+}
+
+void UEntityBatchFunctionLibrary::RemoveComponentFromEntities(UFlecsWorld* World,
+	const TArray<FFlecsEntityHandle>& Entities, UScriptStruct* ComponentType)
+{
+	if UNLIKELY_IF(!IsValid(World) || !IsValid(ComponentType))
+	{
+		return;
+	}
+
+	flecs::world_t* FlecsWorld = World->World.c_ptr();
+	const flecs::entity_t Component = World->ObtainComponentTypeStruct(ComponentType).GetId();
+
+	for (const FFlecsEntityHandle& Entity : Entities)
+	{
+		ecs_remove_id(FlecsWorld, Entity.GetId(), Component);
+	}
+}
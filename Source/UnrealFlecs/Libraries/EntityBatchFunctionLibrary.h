@@ -0,0 +1,73 @@
+﻿// Solstice Games © 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Entities/FlecsEntityHandle.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Queries/FlecsQueryDefinition.h"
+#include "StructUtils/InstancedStruct.h"
+#include "EntityBatchFunctionLibrary.generated.h"
+
+class UFlecsWorld;
+
+/**
+ * @brief Blueprint nodes that operate on many entities with a single call.
+ * Component values are copied per run of entities that are stored next to each other in the same table,
+ * entities returned by GetQueryEntities are in table order, so the copies are usually whole table columns.
+ * Nodes with a wildcard array take the component type from the struct type of the connected array.
+ */
+UCLASS()
+class UNREALFLECS_API UEntityBatchFunctionLibrary final : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Run the query once and return every matched entity */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Batch")
+	static TArray<FFlecsEntityHandle> GetQueryEntities(UFlecsWorld* World, const FFlecsQueryDefinition& Definition);
+
+	/** Run the query once and return every matched entity with its value of the component stored in Values */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Flecs | Batch", meta = (ArrayParm = "Values"))
+	static void GetQueryComponentValues(UFlecsWorld* World, const FFlecsQueryDefinition& Definition,
+		TArray<FFlecsEntityHandle>& OutEntities, UPARAM(ref) TArray<int32>& Values);
+	DECLARE_FUNCTION(execGetQueryComponentValues);
+
+	/** Values of entities that don't have the component are default initialized */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Flecs | Batch", meta = (ArrayParm = "Values"))
+	static void GetComponentValues(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		UPARAM(ref) TArray<int32>& Values);
+	DECLARE_FUNCTION(execGetComponentValues);
+
+	/** Entities that don't have the component get it added, Values must have one value per entity */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Flecs | Batch", meta = (ArrayParm = "Values"))
+	static void SetComponentValues(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		const TArray<int32>& Values);
+	DECLARE_FUNCTION(execSetComponentValues);
+
+	/** Values of entities that don't have the component are default initialized */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Batch")
+	static void GetComponentInstancedStructs(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		UScriptStruct* ComponentType, TArray<FInstancedStruct>& OutValues);
+
+	/** The component of each entity is the type of its value, Values must have one value per entity */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Batch")
+	static void SetComponentInstancedStructs(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		const TArray<FInstancedStruct>& Values);
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Batch")
+	static void AddComponentToEntities(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		UScriptStruct* ComponentType);
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Batch")
+	static void RemoveComponentFromEntities(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		UScriptStruct* ComponentType);
+
+	static void GenericGetQueryComponentValues(UFlecsWorld* World, const FFlecsQueryDefinition& Definition,
+		TArray<FFlecsEntityHandle>& OutEntities, void* ValuesAddress, const FArrayProperty* ValuesProperty);
+	static void GenericGetComponentValues(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		void* ValuesAddress, const FArrayProperty* ValuesProperty);
+	static void GenericSetComponentValues(UFlecsWorld* World, const TArray<FFlecsEntityHandle>& Entities,
+		const void* ValuesAddress, const FArrayProperty* ValuesProperty);
+	
+}; // class UEntityBatchFunctionLibrary
@@ -8,6 +8,9 @@
 
 void UFlecsRestModule::InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity)
 {
+	// The explorer reads the members of every component
+	InWorld->EnableTypeReflection();
+
 	InWorld->SetSingleton<flecs::Rest>(flecs::Rest());
 	RestEntity = InWorld->GetSingletonEntity<flecs::Rest>();
 
@@ -0,0 +1,50 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PhysicsInterfaceDeclaresCore.h"
+#include "SolidMacros/Macros.h"
+#include "FlecsPhysicsBodyComponent.generated.h"
+
+/**
+ * @brief Links an entity to a Chaos particle proxy.
+ * The physics module copies the simulated pose of linked bodies into their
+ * FFlecsLocationComponent and FFlecsRotationComponent, or the other way around for kinematic bodies.
+ */
+USTRUCT(BlueprintType)
+struct UNREALFLECS_API FFlecsPhysicsBodyComponent
+{
+	GENERATED_BODY()
+
+public:
+	FORCEINLINE FFlecsPhysicsBodyComponent() = default;
+	FORCEINLINE FFlecsPhysicsBodyComponent(const FPhysicsActorHandle& InPhysicsActorHandle)
+		: PhysicsActorHandle(InPhysicsActorHandle)
+	{
+	}
+
+	FORCEINLINE NO_DISCARD bool IsValid() const { return PhysicsActorHandle != nullptr; }
+
+	FORCEINLINE bool operator==(const FFlecsPhysicsBodyComponent& Other) const
+	{
+		return PhysicsActorHandle == Other.PhysicsActorHandle;
+	}
+
+	FORCEINLINE bool operator!=(const FFlecsPhysicsBodyComponent& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	FPhysicsActorHandle PhysicsActorHandle = nullptr;
+	
+}; // struct FFlecsPhysicsBodyComponent
+
+/**
+ * @brief Bodies with this tag are driven by their entity, the location and rotation are pushed as kinematic targets.
+ */
+USTRUCT(BlueprintType)
+struct UNREALFLECS_API FFlecsPhysicsKinematicTag
+{
+	GENERATED_BODY()
+}; // struct FFlecsPhysicsKinematicTag
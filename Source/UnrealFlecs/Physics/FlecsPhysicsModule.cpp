@@ -1,13 +1,17 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "FlecsPhysicsModule.h"
+#include "FlecsPhysicsBodyComponent.h"
 #include "FlecsPhysicsSceneComponent.h"
 #include "PBDRigidsSolver.h"
 #include "TickerPhysicsHistoryComponent.h"
 #include "Components/UWorldPtrComponent.h"
+#include "Physics/Experimental/PhysInterface_Chaos.h"
 #include "Physics/Experimental/PhysScene_Chaos.h"
+#include "Physics/PhysicsInterfaceCore.h"
 #include "Ticker/FlecsTickerComponent.h"
 #include "Ticker/FlecsTickerModule.h"
+#include "Transforms/FlecsTransformComponents.h"
 #include "Worlds/FlecsWorld.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsPhysicsModule)
@@ -17,6 +21,10 @@ UNLOG_CATEGORY(LogFlecsPhysicsModule);
 DECLARE_STATS_GROUP(TEXT("FlecsPhysicsModule"), STATGROUP_FlecsPhysicsModule, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("FlecsPhysicsModule::ResimulationHandlers"),
 	STAT_FlecsPhysicsModule_ResimulationHandlers, STATGROUP_FlecsPhysicsModule);
+DECLARE_CYCLE_STAT(TEXT("FlecsPhysicsModule::PullBodyTransforms"),
+	STAT_FlecsPhysicsModule_PullBodyTransforms, STATGROUP_FlecsPhysicsModule);
+DECLARE_CYCLE_STAT(TEXT("FlecsPhysicsModule::PushKinematicTargets"),
+	STAT_FlecsPhysicsModule_PushKinematicTargets, STATGROUP_FlecsPhysicsModule);
 
 void UFlecsPhysicsModule::InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity)
 {
@@ -45,6 +53,11 @@ void UFlecsPhysicsModule::InitializeModule(UFlecsWorld* InWorld, const FFlecsEnt
 			{
 				ResimulationHandlers();
 			}
+
+			if (bSyncBodyTransforms)
+			{
+				BodySyncHandlers();
+			}
 		});
 }
 
@@ -55,6 +68,26 @@ void UFlecsPhysicsModule::DeinitializeModule(UFlecsWorld* InWorld)
 		return;
 	}
 	
+	if (BodySyncPostAdvanceHandle.IsValid())
+	{
+		if (const FPhysScene* Scene = InWorld->GetWorld()->GetPhysicsScene())
+		{
+			Scene->GetSolver()->RemovePostAdvanceCallback(BodySyncPostAdvanceHandle);
+		}
+
+		BodySyncPostAdvanceHandle.Reset();
+	}
+
+	if (PullBodyTransformsSystem)
+	{
+		PullBodyTransformsSystem.destruct();
+	}
+
+	if (PushKinematicTargetsSystem)
+	{
+		PushKinematicTargetsSystem.destruct();
+	}
+	
 	GetFlecsWorld()->RemoveSingleton<FFlecsPhysicsSceneComponent>();
 
 	if (bAllowResimulation)
@@ -129,3 +162,133 @@ inline void UFlecsPhysicsModule::ResimulationHandlers()
 	Scene->GetSolver()->AddPostAdvanceCallback(PostAdvanceDelegate);
 }
 
+void UFlecsPhysicsModule::ProgressModule(double InDeltaTime)
+{
+	const uint32 CurrentPhysicsResultsVersion = PhysicsResultsVersion.load(std::memory_order_acquire);
+	bPhysicsResultsPending = bInterpolatedPhysicsResults
+		|| CurrentPhysicsResultsVersion != SyncedPhysicsResultsVersion;
+	SyncedPhysicsResultsVersion = CurrentPhysicsResultsVersion;
+}
+
+inline void UFlecsPhysicsModule::BodySyncHandlers()
+{
+	FPhysScene* Scene = GetFlecsWorld()->GetWorld()->GetPhysicsScene();
+	solid_check(Scene);
+
+	// With async results (e.g. BlockForBestInterpolation) the game thread pose moves between solver steps
+	bInterpolatedPhysicsResults = Scene->GetSolver()->IsUsingAsyncResults();
+
+	// In async mode this runs on the physics thread, the results are pulled on the game thread
+	// by the pull system, which is skipped for frames where the solver did not advance and nothing is interpolated
+	FSolverPostAdvance::FDelegate PostAdvanceDelegate;
+	PostAdvanceDelegate.BindWeakLambda(this, [this](MAYBE_UNUSED float InDeltaTime)
+	{
+		PhysicsResultsVersion.fetch_add(1, std::memory_order_release);
+	});
+	
+	BodySyncPostAdvanceHandle = Scene->GetSolver()->AddPostAdvanceCallback(PostAdvanceDelegate);
+
+	PullBodyTransformsSystem = GetFlecsWorld()->CreateSystemWithBuilder<const FFlecsPhysicsBodyComponent,
+		FFlecsLocationComponent, FFlecsRotationComponent>(TEXT("PullPhysicsBodyTransformsSystem"))
+		.without<FFlecsPhysicsKinematicTag>()
+		.kind(flecs::OnLoad)
+		.cached()
+		.run([this, Scene](flecs::iter& Iter)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FlecsPhysicsModule_PullBodyTransforms);
+
+			if (!bPhysicsResultsPending)
+			{
+				Iter.fini();
+				return;
+			}
+
+			// Single threaded, the poses are read under the scene read lock as the world can be stepped
+			// outside of the game thread by a world group
+			FPhysicsCommand::ExecuteRead(Scene, [&Iter, this]()
+			{
+				while (Iter.next())
+				{
+					const flecs::field<const FFlecsPhysicsBodyComponent> Bodies
+						= Iter.field<const FFlecsPhysicsBodyComponent>(0);
+					const flecs::field<FFlecsLocationComponent> Locations = Iter.field<FFlecsLocationComponent>(1);
+					const flecs::field<FFlecsRotationComponent> Rotations = Iter.field<FFlecsRotationComponent>(2);
+
+					bool bAnyMoved = false;
+
+					for (const size_t Index : Iter)
+					{
+						const FPhysicsActorHandle& PhysicsActorHandle = Bodies[Index].PhysicsActorHandle;
+
+						if UNLIKELY_IF(!PhysicsActorHandle)
+						{
+							continue;
+						}
+
+						// Game thread data of the particle, already interpolated from the latest results
+						const FTransform Pose = FPhysicsInterface::GetGlobalPose_AssumesLocked(PhysicsActorHandle);
+						const FVector Location = Pose.GetLocation();
+						const FRotator Rotation = Pose.Rotator();
+
+						if (Locations[Index].Location.Equals(Location, BodySyncTolerance)
+							&& Rotations[Index].Rotation.Equals(Rotation, BodySyncTolerance))
+						{
+							continue;
+						}
+
+						Locations[Index].Location = Location;
+						Rotations[Index].Rotation = Rotation;
+						bAnyMoved = true;
+					}
+
+					// Tables without moved bodies are not marked as changed
+					if (!bAnyMoved)
+					{
+						Iter.skip();
+					}
+				}
+			});
+		});
+
+	PushKinematicTargetsSystem = GetFlecsWorld()->CreateSystemWithBuilder<const FFlecsPhysicsBodyComponent,
+		const FFlecsLocationComponent, const FFlecsRotationComponent>(TEXT("PushPhysicsKinematicTargetsSystem"))
+		.with<FFlecsPhysicsKinematicTag>()
+		.kind(flecs::OnStore)
+		.cached()
+		.run([Scene](flecs::iter& Iter)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FlecsPhysicsModule_PushKinematicTargets);
+			
+			FPhysicsCommand::ExecuteWrite(Scene, [&Iter]()
+			{
+				while (Iter.next())
+				{
+					// Only tables where the location or rotation was written since the last push
+					if (!Iter.changed())
+					{
+						continue;
+					}
+
+					const flecs::field<const FFlecsPhysicsBodyComponent> Bodies
+						= Iter.field<const FFlecsPhysicsBodyComponent>(0);
+					const flecs::field<const FFlecsLocationComponent> Locations
+						= Iter.field<const FFlecsLocationComponent>(1);
+					const flecs::field<const FFlecsRotationComponent> Rotations
+						= Iter.field<const FFlecsRotationComponent>(2);
+
+					for (const size_t Index : Iter)
+					{
+						const FPhysicsActorHandle& PhysicsActorHandle = Bodies[Index].PhysicsActorHandle;
+
+						if UNLIKELY_IF(!PhysicsActorHandle)
+						{
+							continue;
+						}
+
+						FPhysicsInterface::SetKinematicTarget_AssumesLocked(PhysicsActorHandle,
+							FTransform(Rotations[Index].Rotation, Locations[Index].Location));
+					}
+				}
+			});
+		});
+}
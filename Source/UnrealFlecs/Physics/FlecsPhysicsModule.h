@@ -5,13 +5,14 @@
 #include "CoreMinimal.h"
 #include "TickerPhysicsHistoryComponent.h"
 #include "Modules/FlecsModuleObject.h"
+#include "Modules/FlecsModuleProgressInterface.h"
 #include "Systems/FlecsSystem.h"
 #include "Ticker/FlecsTickerComponent.h"
 #include "UObject/Object.h"
 #include "FlecsPhysicsModule.generated.h"
 
 UCLASS(BlueprintType, DefaultToInstanced, EditInlineNew)
-class UNREALFLECS_API UFlecsPhysicsModule final : public UFlecsModuleObject
+class UNREALFLECS_API UFlecsPhysicsModule final : public UFlecsModuleObject, public IFlecsModuleProgressInterface
 {
 	GENERATED_BODY()
 
@@ -19,7 +20,10 @@ public:
 	virtual void InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity) override;
 	virtual void DeinitializeModule(UFlecsWorld* InWorld) override;
 
+	virtual void ProgressModule(double InDeltaTime) override;
+
 	FORCEINLINE void ResimulationHandlers();
+	FORCEINLINE void BodySyncHandlers();
 
 	FORCEINLINE virtual FString GetModuleName_Implementation() const override
 	{
@@ -33,11 +37,35 @@ public:
 		meta = (EditCondition = "bAllowResimulation"))
 	int32 MaxFrameHistory = 300;
 
+	/** Copy the pose of bodies linked with FFlecsPhysicsBodyComponent into their location and rotation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | Physics")
+	bool bSyncBodyTransforms = true;
+
+	/** Bodies that moved less than this are not written, so their tables are not marked as changed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | Physics",
+		meta = (EditCondition = "bSyncBodyTransforms", ClampMin = "0.0"))
+	double BodySyncTolerance = UE_KINDA_SMALL_NUMBER;
+
 	flecs::observer AddPhysicsComponentObserver;
 
+	flecs::system PullBodyTransformsSystem;
+	flecs::system PushKinematicTargetsSystem;
+
 private:
 	int32 PreResimValue = 0;
 
+	/** Incremented by the solver post-advance callback, which runs on the physics thread in async mode */
+	std::atomic<uint32> PhysicsResultsVersion = 0;
+	uint32 SyncedPhysicsResultsVersion = 0;
+
+	/** Set once per Progress, before the pull system runs */
+	bool bPhysicsResultsPending = false;
+
+	/** Game thread poses are interpolated between solver results every frame, so they are pulled every frame */
+	bool bInterpolatedPhysicsResults = false;
+
+	FDelegateHandle BodySyncPostAdvanceHandle;
+
 	FTickerPhysicsHistoryComponent* PhysicsHistoryComponentRef;
 	FFlecsTickerComponent* TickerComponentRef;
 	
@@ -13,12 +13,34 @@
 #include "StructUtils/InstancedStruct.h"
 #include "Unlog/Unlog.h"
 
+using FFlecsComponentPropertyStructsFactory = TArray<FInstancedStruct>(*)();
+
 struct UNREALFLECS_API FFlecsComponentProperties
 {
 	std::string Name;
 	std::vector<flecs::entity_t> Entities;
 	
 	TArray<FInstancedStruct> ComponentPropertyStructs;
+
+	/** Build the property structs of REGISTER_COMPONENT_TRAIT_PROPERTIES when the type is first obtained in a world */
+	std::vector<FFlecsComponentPropertyStructsFactory> ComponentPropertyStructFactories;
+
+	template <typename FunctionType>
+	void ForEachComponentPropertyStruct(FunctionType&& Function) const
+	{
+		for (const FInstancedStruct& ComponentPropertyStruct : ComponentPropertyStructs)
+		{
+			Function(ComponentPropertyStruct);
+		}
+
+		for (const FFlecsComponentPropertyStructsFactory Factory : ComponentPropertyStructFactories)
+		{
+			for (const FInstancedStruct& ComponentPropertyStruct : Factory())
+			{
+				Function(ComponentPropertyStruct);
+			}
+		}
+	}
 }; // struct FFlecsComponentProperties
 
 DECLARE_DELEGATE_OneParam(FOnComponentPropertiesRegistered, FFlecsComponentProperties);
@@ -80,6 +102,24 @@ public:
 		OnComponentPropertiesRegistered.ExecuteIfBound(ComponentProperties[Name]);
 	}
 
+	/** Store the factory only, the structs are built every time the properties are applied to a new type entity */
+	FORCEINLINE void RegisterComponentPropertyStructsFactory(const std::string& Name,
+		const FFlecsComponentPropertyStructsFactory Factory)
+	{
+		solid_check(Factory != nullptr);
+
+		FFlecsComponentProperties& Properties = ComponentProperties[Name];
+		Properties.Name = Name;
+		Properties.ComponentPropertyStructFactories.emplace_back(Factory);
+	}
+
+	/** Single lookup used when a type is obtained, nullptr for types without properties */
+	FORCEINLINE NO_DISCARD const FFlecsComponentProperties* FindComponentProperties(const std::string& Name) const
+	{
+		const auto It = ComponentProperties.find(Name);
+		return It != ComponentProperties.end() ? &It->second : nullptr;
+	}
+
 	FORCEINLINE NO_DISCARD bool ContainsComponentProperties(const std::string& Name) const
 	{
 		return ComponentProperties.contains(Name);
@@ -147,11 +187,11 @@ public:
 		{ \
 			FAutoRegister##ComponentType##_Traits() \
 			{ \
-				FCoreDelegates::OnPostEngineInit.AddLambda([&]() \
-				{ \
-					TArray<FInstancedStruct> ComponentPropertyStructs = { __VA_ARGS__ }; \
-					FFlecsComponentPropertiesRegistry::Get().RegisterComponentProperties(#ComponentType, {}, ComponentPropertyStructs); \
-				}); \
+				FFlecsComponentPropertiesRegistry::Get().RegisterComponentPropertyStructsFactory(#ComponentType, \
+					[]() -> TArray<FInstancedStruct> \
+					{ \
+						return { __VA_ARGS__ }; \
+					}); \
 			} \
 		}; \
 		inline FAutoRegister##ComponentType##_Traits AutoRegister##ComponentType##_Instance_Traits; \
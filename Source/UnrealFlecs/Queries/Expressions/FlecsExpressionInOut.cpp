@@ -12,3 +12,8 @@ void FFlecsExpressionInOut::Apply(UFlecsWorld* InWorld, flecs::query_builder<>&
 {
 	InQueryBuilder.inout_stage(static_cast<flecs::inout_kind_t>(InOut));
 }
+
+uint32 FFlecsExpressionInOut::GetExpressionHash() const
+{
+	return HashCombine(Super::GetExpressionHash(), GetTypeHash(InOut));
+}
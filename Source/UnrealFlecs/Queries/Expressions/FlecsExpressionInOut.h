@@ -16,6 +16,7 @@ public:
 	FORCEINLINE FFlecsExpressionInOut();
 	
 	virtual void Apply(UFlecsWorld* InWorld, flecs::query_builder<>& InQueryBuilder) const override;
+	virtual NO_DISCARD uint32 GetExpressionHash() const override;
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Flecs | Query")
 	EFlecsQueryInOut InOut = EFlecsQueryInOut::Default;
@@ -12,3 +12,8 @@ void FFlecsOperQueryExpression::Apply(UFlecsWorld* InWorld, flecs::query_builder
 {
 	InQueryBuilder.oper(static_cast<flecs::oper_kind_t>(Operator));
 }
+
+uint32 FFlecsOperQueryExpression::GetExpressionHash() const
+{
+	return HashCombine(Super::GetExpressionHash(), GetTypeHash(Operator));
+}
@@ -17,6 +17,7 @@ public:
 	FORCEINLINE FFlecsOperQueryExpression();
 	
 	virtual void Apply(UFlecsWorld* InWorld, flecs::query_builder<>& InQueryBuilder) const override;
+	virtual NO_DISCARD uint32 GetExpressionHash() const override;
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Flecs | Query")
 	EFlecsQueryOperator Operator = EFlecsQueryOperator::Default;
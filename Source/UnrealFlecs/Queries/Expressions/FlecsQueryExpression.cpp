@@ -15,3 +15,20 @@ void FFlecsQueryExpression::Apply(UFlecsWorld* InWorld, flecs::query_builder<>&
 		Child.GetPtr<FFlecsQueryExpression>()->Apply(InWorld, InQueryBuilder);
 	}
 }
+
+uint32 FFlecsQueryExpression::GetExpressionHash() const
+{
+	uint32 Hash = GetTypeHash(Children.Num());
+
+	for (const TInstancedStruct<FFlecsQueryExpression>& Child : Children)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Child.GetScriptStruct()));
+
+		if (const FFlecsQueryExpression* ChildExpression = Child.GetPtr<FFlecsQueryExpression>())
+		{
+			Hash = HashCombine(Hash, ChildExpression->GetExpressionHash());
+		}
+	}
+
+	return Hash;
+}
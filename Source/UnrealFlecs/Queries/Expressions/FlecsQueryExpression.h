@@ -26,6 +26,12 @@ public:
 	
 	virtual void Apply(UFlecsWorld* InWorld, flecs::query_builder<>& InQueryBuilder) const;
 
+	/**
+	 * @brief Hash of the expression and its children, equal expressions must return the same hash.
+	 * Used to share compiled queries between identical query definitions.
+	 */
+	virtual NO_DISCARD uint32 GetExpressionHash() const;
+
 	#if WITH_EDITORONLY_DATA
 
 	UPROPERTY(VisibleAnywhere, Category = "Flecs | Query")
@@ -47,4 +47,10 @@ void FFlecsQueryTermExpression::Apply(UFlecsWorld* InWorld, flecs::query_builder
 	}
 
 	Super::Apply(InWorld, InQueryBuilder);
-}
\ No newline at end of file
+}
+
+uint32 FFlecsQueryTermExpression::GetExpressionHash() const
+{
+	uint32 Hash = HashCombine(GetTypeHash(InputType), GetTypeHash(bWithout));
+	return HashCombine(Hash, Super::GetExpressionHash());
+}
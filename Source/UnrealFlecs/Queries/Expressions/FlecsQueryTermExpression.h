@@ -23,5 +23,6 @@ public:
 	bool bWithout = false;
 
 	virtual void Apply(UFlecsWorld* InWorld, flecs::query_builder<>& InQueryBuilder) const override;
+	virtual NO_DISCARD uint32 GetExpressionHash() const override;
 	
 }; // struct FFlecsQueryTermExpression
@@ -24,6 +24,10 @@ public:
     FORCEINLINE FFlecsQuery(const flecs::query<>& InQuery) : Query(InQuery) {}
     FORCEINLINE FFlecsQuery(const flecs::query<>* InQuery) : Query(*InQuery) {}
 
+    /** Keeps the entity of the query, which can be checked after the query was freed with its entity */
+    FORCEINLINE FFlecsQuery(const flecs::query<>& InQuery, const flecs::entity_t InQueryEntity)
+        : Query(InQuery), QueryEntity(InQueryEntity) {}
+
     FORCEINLINE FFlecsQuery(flecs::query_builder<>& InQueryBuilder)
     {
         Query = InQueryBuilder.build();
@@ -70,6 +74,12 @@ public:
         return FFlecsEntityHandle(ecs_get_entity(Query));
     }
 
+    /** The entity the query was created with, 0 if it wasn't kept. Doesn't access the query */
+    FORCEINLINE NO_DISCARD flecs::entity_t GetQueryEntityId() const
+    {
+        return QueryEntity;
+    }
+
     FORCEINLINE NO_DISCARD bool operator==(const FFlecsQuery& Other) const
     {
         return GetEntity() == Other.GetEntity();
@@ -87,6 +97,7 @@ public:
 
 private:
     flecs::query<> Query;
+    flecs::entity_t QueryEntity = 0;
 }; // struct FFlecsQuery
 
 
@@ -12,9 +12,56 @@ struct UNREALFLECS_API FFlecsQueryDefinition
 {
 	GENERATED_BODY()
 
+	FORCEINLINE friend NO_DISCARD uint32 GetTypeHash(const FFlecsQueryDefinition& InDefinition)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(InDefinition.Flags), GetTypeHash(InDefinition.Terms.Num()));
+
+		for (const FFlecsQueryTermExpression& Term : InDefinition.Terms)
+		{
+			Hash = HashCombine(Hash, Term.GetExpressionHash());
+		}
+
+		for (const TInstancedStruct<FFlecsQueryExpression>& Expression : InDefinition.OtherExpressions)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Expression.GetScriptStruct()));
+
+			if (const FFlecsQueryExpression* ExpressionPtr = Expression.GetPtr<FFlecsQueryExpression>())
+			{
+				Hash = HashCombine(Hash, ExpressionPtr->GetExpressionHash());
+			}
+		}
+
+		return Hash;
+	}
+
 public:
 	FORCEINLINE FFlecsQueryDefinition() = default;
 
+	FORCEINLINE NO_DISCARD bool operator==(const FFlecsQueryDefinition& Other) const
+	{
+		return StaticStruct()->CompareScriptStruct(this, &Other, PPF_None);
+	}
+
+	FORCEINLINE NO_DISCARD bool operator!=(const FFlecsQueryDefinition& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	void Apply(UFlecsWorld* InWorld, flecs::query_builder<>& InQueryBuilder) const
+	{
+		for (const FFlecsQueryTermExpression& Term : Terms)
+		{
+			Term.Apply(InWorld, InQueryBuilder);
+		}
+
+		for (const TInstancedStruct<FFlecsQueryExpression>& Expression : OtherExpressions)
+		{
+			Expression.Get().Apply(InWorld, InQueryBuilder);
+		}
+
+		InQueryBuilder.query_flags(static_cast<ecs_flags32_t>(Flags));
+	}
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | Query")
 	TArray<FFlecsQueryTermExpression> Terms;
 
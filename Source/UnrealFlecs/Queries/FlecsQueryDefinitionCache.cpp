@@ -0,0 +1,158 @@
+// Solstice Games © 2024. All Rights Reserved.
+
+#include "FlecsQueryDefinitionCache.h"
+#include "Worlds/FlecsWorld.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlecsQueryDefinitionCache::Compile"),
+	STAT_FlecsQueryDefinitionCacheCompile, STATGROUP_FlecsWorld);
+
+FFlecsQuery FFlecsQueryDefinitionCache::Obtain(UFlecsWorld* InWorld, const FFlecsQueryDefinition& InDefinition)
+{
+	solid_checkf(IsValid(InWorld), TEXT("Flecs World is not valid"));
+
+	// The query is freed with its entity, e.g. when the scope it was created in is deleted
+	if UNLIKELY_IF(!DeleteObserver || !InWorld->World.is_alive(DeleteObserver))
+	{
+		DeleteObserver = InWorld->World.observer<>()
+			.with<flecs::Poly>(flecs::Query)
+			.event(flecs::OnRemove)
+			.each([this](const flecs::entity InQueryEntity)
+			{
+				Purge(InQueryEntity.id());
+			});
+	}
+
+	const uint32 Hash = GetTypeHash(InDefinition);
+	TArray<FFlecsCompiledQuery, TInlineAllocator<1>>& Bucket = CompiledQueries.FindOrAdd(Hash);
+
+	for (FFlecsCompiledQuery& CompiledQuery : Bucket)
+	{
+		if (CompiledQuery.Definition == InDefinition)
+		{
+			++CompiledQuery.RefCount;
+			return FFlecsQuery(CompiledQuery.Query, CompiledQuery.QueryEntity);
+		}
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_FlecsQueryDefinitionCacheCompile);
+
+	flecs::query_builder<> QueryBuilder = InWorld->World.query_builder<>();
+
+	// Cached so that every user shares the table matching of a single query, unless the definition sets a cache kind
+	QueryBuilder.cache_kind(flecs::QueryCacheAuto);
+	InDefinition.Apply(InWorld, QueryBuilder);
+
+	FFlecsCompiledQuery& CompiledQuery = Bucket.AddDefaulted_GetRef();
+	CompiledQuery.Definition = InDefinition;
+	CompiledQuery.Query = QueryBuilder.build();
+	CompiledQuery.QueryEntity = CompiledQuery.Query.entity().id();
+	CompiledQuery.RefCount = 1;
+
+	QueryHashes.Add(CompiledQuery.QueryEntity, Hash);
+	return FFlecsQuery(CompiledQuery.Query, CompiledQuery.QueryEntity);
+}
+
+bool FFlecsQueryDefinitionCache::Release(const UFlecsWorld* InWorld, const FFlecsQuery& InQuery)
+{
+	solid_checkf(IsValid(InWorld), TEXT("Flecs World is not valid"));
+
+	uint32 Hash;
+	int32 Index;
+	FFlecsCompiledQuery* CompiledQuery = Find(InQuery.GetQueryEntityId(), Hash, Index);
+
+	if UNLIKELY_IF(!CompiledQuery)
+	{
+		return false;
+	}
+
+	const flecs::entity_t QueryEntity = CompiledQuery->QueryEntity;
+
+	if UNLIKELY_IF(!InWorld->World.is_alive(QueryEntity))
+	{
+		Purge(QueryEntity);
+		return false;
+	}
+
+	if (--CompiledQuery->RefCount > 0)
+	{
+		return false;
+	}
+
+	// Removed before the query is destructed, the delete observer doesn't find it anymore
+	const flecs::query<> Query = CompiledQuery->Query;
+	Purge(QueryEntity);
+
+	Query.destruct();
+	return true;
+}
+
+void FFlecsQueryDefinitionCache::Reset(const UFlecsWorld* InWorld)
+{
+	// Destructing a query runs the delete observer, which must not see the maps that are iterated
+	TMap<uint32, TArray<FFlecsCompiledQuery, TInlineAllocator<1>>> OldCompiledQueries = MoveTemp(CompiledQueries);
+	CompiledQueries.Reset();
+	QueryHashes.Reset();
+
+	for (TPair<uint32, TArray<FFlecsCompiledQuery, TInlineAllocator<1>>>& Bucket : OldCompiledQueries)
+	{
+		for (FFlecsCompiledQuery& CompiledQuery : Bucket.Value)
+		{
+			if (InWorld->World.is_alive(CompiledQuery.QueryEntity))
+			{
+				CompiledQuery.Query.destruct();
+			}
+		}
+	}
+}
+
+int32 FFlecsQueryDefinitionCache::GetRefCount(const FFlecsQuery& InQuery) const
+{
+	uint32 Hash;
+	int32 Index;
+	const FFlecsCompiledQuery* CompiledQuery = const_cast<FFlecsQueryDefinitionCache*>(this)->Find(
+		InQuery.GetQueryEntityId(), Hash, Index);
+	return CompiledQuery ? CompiledQuery->RefCount : 0;
+}
+
+void FFlecsQueryDefinitionCache::Purge(const flecs::entity_t InQueryEntity)
+{
+	uint32 Hash;
+	int32 Index;
+
+	if (!Find(InQueryEntity, Hash, Index))
+	{
+		return;
+	}
+
+	TArray<FFlecsCompiledQuery, TInlineAllocator<1>>& Bucket = CompiledQueries.FindChecked(Hash);
+	Bucket.RemoveAtSwap(Index);
+
+	if (Bucket.IsEmpty())
+	{
+		CompiledQueries.Remove(Hash);
+	}
+
+	QueryHashes.Remove(InQueryEntity);
+}
+
+FFlecsCompiledQuery* FFlecsQueryDefinitionCache::Find(const flecs::entity_t InQueryEntity,
+	uint32& OutHash, int32& OutIndex)
+{
+	const uint32* HashPtr = QueryHashes.Find(InQueryEntity);
+
+	if (!HashPtr)
+	{
+		return nullptr;
+	}
+
+	OutHash = *HashPtr;
+	TArray<FFlecsCompiledQuery, TInlineAllocator<1>>& Bucket = CompiledQueries.FindChecked(OutHash);
+
+	OutIndex = Bucket.IndexOfByPredicate([InQueryEntity](const FFlecsCompiledQuery& InCompiledQuery)
+	{
+		return InCompiledQuery.QueryEntity == InQueryEntity;
+	});
+	solid_checkf(OutIndex != INDEX_NONE, TEXT("Query is not in the bucket of its definition hash"));
+
+	return &Bucket[OutIndex];
+}
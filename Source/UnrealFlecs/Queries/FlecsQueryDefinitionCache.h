@@ -0,0 +1,65 @@
+// Solstice Games © 2024. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "flecs.h"
+#include "FlecsQuery.h"
+#include "FlecsQueryDefinition.h"
+
+class UFlecsWorld;
+
+/**
+ * @brief A query compiled from a FFlecsQueryDefinition, shared by every user of an identical definition.
+ */
+struct FFlecsCompiledQuery
+{
+	FFlecsQueryDefinition Definition;
+	flecs::query<> Query;
+
+	/** Kept separately as the query is freed with its entity, which can happen outside of the cache */
+	flecs::entity_t QueryEntity = 0;
+
+	int32 RefCount = 0;
+
+}; // struct FFlecsCompiledQuery
+
+/**
+ * @brief Interns compiled queries by the hash of their definition,
+ * obtaining a query for a definition that was already compiled only costs a hash lookup.
+ * Queries are reference counted and destructed when the last user releases them.
+ */
+struct UNREALFLECS_API FFlecsQueryDefinitionCache
+{
+	FFlecsQuery Obtain(UFlecsWorld* InWorld, const FFlecsQueryDefinition& InDefinition);
+
+	/** Returns true if this was the last reference and the query was destructed */
+	bool Release(const UFlecsWorld* InWorld, const FFlecsQuery& InQuery);
+
+	/** Destructs all compiled queries, used when the world is reset or destroyed */
+	void Reset(const UFlecsWorld* InWorld);
+
+	FORCEINLINE NO_DISCARD int32 Num() const
+	{
+		return QueryHashes.Num();
+	}
+
+	NO_DISCARD int32 GetRefCount(const FFlecsQuery& InQuery) const;
+
+private:
+	/** Drops the compiled query of a query entity that is being deleted, without destructing it */
+	void Purge(const flecs::entity_t InQueryEntity);
+
+	/** The compiled query of a query entity and its position in the buckets, nullptr if it is not cached */
+	NO_DISCARD FFlecsCompiledQuery* Find(const flecs::entity_t InQueryEntity, uint32& OutHash, int32& OutIndex);
+
+	/** Several definitions can share a hash, so every bucket is compared before a query is reused */
+	TMap<uint32, TArray<FFlecsCompiledQuery, TInlineAllocator<1>>> CompiledQueries;
+
+	/** Query entity to definition hash, used to find the bucket of a released query */
+	TMap<flecs::entity_t, uint32> QueryHashes;
+
+	/** Purges the entries of queries deleted outside of the cache, created with the first query */
+	flecs::entity_t DeleteObserver = 0;
+
+}; // struct FFlecsQueryDefinitionCache
@@ -21,6 +21,26 @@ struct UNREALFLECS_API FFlecsQueryInput
 {
 	GENERATED_BODY()
 
+	FORCEINLINE friend NO_DISCARD uint32 GetTypeHash(const FFlecsQueryInput& InInput)
+	{
+		const uint32 TypeHash = GetTypeHash(InInput.Type);
+
+		switch (InInput.Type)
+		{
+			case EFlecsQueryInputType::ScriptStruct:
+				return HashCombine(TypeHash, GetTypeHash(InInput.ScriptStruct));
+			case EFlecsQueryInputType::Entity:
+				return HashCombine(TypeHash, GetTypeHash(InInput.Entity));
+			case EFlecsQueryInputType::String:
+				// Query expressions are case-sensitive, GetTypeHash(FString) is not
+				return HashCombine(TypeHash, FCrc::StrCrc32(*InInput.Expr.Expr));
+			case EFlecsQueryInputType::GameplayTag:
+				return HashCombine(TypeHash, GetTypeHash(InInput.Tag));
+		}
+
+		return TypeHash;
+	}
+
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | Query")
 	EFlecsQueryInputType Type = EFlecsQueryInputType::ScriptStruct;
@@ -0,0 +1,142 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FlecsSpatialModule.h"
+#include "Transforms/FlecsTransformComponents.h"
+#include "Worlds/FlecsWorld.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsSpatialModule)
+
+UNLOG_CATEGORY(LogFlecsSpatialModule);
+
+DECLARE_STATS_GROUP(TEXT("FlecsSpatialModule"), STATGROUP_FlecsSpatialModule, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("FlecsSpatialModule::FindInRadius"),
+	STAT_FlecsSpatialModule_FindInRadius, STATGROUP_FlecsSpatialModule);
+DECLARE_CYCLE_STAT(TEXT("FlecsSpatialModule::FindNearest"),
+	STAT_FlecsSpatialModule_FindNearest, STATGROUP_FlecsSpatialModule);
+
+// The index reads the location as three consecutive doubles
+static_assert(std::is_same_v<FVector::FReal, double>, "FFlecsLocationComponent must store double precision");
+
+void UFlecsSpatialModule::InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity)
+{
+	ecs_spatial_index_desc_t Desc = {};
+	Desc.component = InWorld->ObtainComponentType<FFlecsLocationComponent>().GetEntity();
+	Desc.offset = STRUCT_OFFSET(FFlecsLocationComponent, Location);
+	Desc.f64 = true;
+	Desc.cell_size = CellSize;
+	Desc.phase = flecs::PostUpdate;
+
+	SpatialIndexEntity = FFlecsEntityHandle(InWorld, ecs_spatial_index_init(InWorld->World, &Desc));
+
+	if UNLIKELY_IF(!SpatialIndexEntity.IsValid())
+	{
+		UN_LOGF(LogFlecsSpatialModule, Error, "Failed to create spatial index");
+	}
+}
+
+void UFlecsSpatialModule::DeinitializeModule(UFlecsWorld* InWorld)
+{
+	if (SpatialIndexEntity.IsValid())
+	{
+		SpatialIndexEntity.Destroy();
+	}
+
+	SpatialIndexEntity = FFlecsEntityHandle();
+}
+
+void UFlecsSpatialModule::FindInRadius(TConstArrayView<ecs_spatial_query_t> InQueries,
+	FFlecsSpatialQueryResult& OutResult) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlecsSpatialModule_FindInRadius);
+	solid_check(SpatialIndexEntity.IsValid());
+
+	ecs_spatial_find_in_radius(GetFlecsWorld()->World, SpatialIndexEntity,
+		InQueries.GetData(), InQueries.Num(), OutResult.Get());
+}
+
+void UFlecsSpatialModule::FindNearest(TConstArrayView<ecs_spatial_query_t> InQueries,
+	FFlecsSpatialQueryResult& OutResult) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlecsSpatialModule_FindNearest);
+	solid_check(SpatialIndexEntity.IsValid());
+
+	ecs_spatial_find_nearest(GetFlecsWorld()->World, SpatialIndexEntity,
+		InQueries.GetData(), InQueries.Num(), OutResult.Get());
+}
+
+int32 UFlecsSpatialModule::FindEntitiesInRadius(const FVector& InCenter, const double InRadius,
+	TArray<FFlecsEntityHandle>& OutEntities) const
+{
+	OutEntities.Reset();
+
+	if UNLIKELY_IF(InRadius <= 0.0)
+	{
+		return 0;
+	}
+
+	const ecs_spatial_query_t Query = MakeQuery(InCenter, InRadius);
+
+	FFlecsSpatialQueryResult Result;
+	FindInRadius(MakeArrayView(&Query, 1), Result);
+	CopyEntities(Result, OutEntities);
+	return OutEntities.Num();
+}
+
+int32 UFlecsSpatialModule::FindNearestEntities(const FVector& InCenter, const int32 InCount,
+	TArray<FFlecsEntityHandle>& OutEntities, const double InMaxRadius) const
+{
+	OutEntities.Reset();
+
+	if UNLIKELY_IF(InCount <= 0 || InMaxRadius < 0.0)
+	{
+		return 0;
+	}
+
+	const ecs_spatial_query_t Query = MakeQuery(InCenter, InMaxRadius, InCount);
+
+	FFlecsSpatialQueryResult Result;
+	FindNearest(MakeArrayView(&Query, 1), Result);
+	CopyEntities(Result, OutEntities);
+	return OutEntities.Num();
+}
+
+void UFlecsSpatialModule::RebuildIndex() const
+{
+	solid_check(SpatialIndexEntity.IsValid());
+	ecs_spatial_index_rebuild(GetFlecsWorld()->World, SpatialIndexEntity);
+}
+
+int32 UFlecsSpatialModule::GetNumIndexedEntities() const
+{
+	if UNLIKELY_IF(!SpatialIndexEntity.IsValid())
+	{
+		return 0;
+	}
+
+	return ecs_spatial_count(GetFlecsWorld()->World, SpatialIndexEntity);
+}
+
+ecs_spatial_query_t UFlecsSpatialModule::MakeQuery(const FVector& InCenter, const double InRadius,
+	const int32 InCount)
+{
+	ecs_spatial_query_t Query = {};
+	Query.center[0] = InCenter.X;
+	Query.center[1] = InCenter.Y;
+	Query.center[2] = InCenter.Z;
+	Query.radius = InRadius;
+	Query.k = InCount;
+	return Query;
+}
+
+void UFlecsSpatialModule::CopyEntities(const FFlecsSpatialQueryResult& InResult,
+	TArray<FFlecsEntityHandle>& OutEntities) const
+{
+	const TConstArrayView<flecs::entity_t> Entities = InResult.GetEntities(0);
+
+	OutEntities.Reset(Entities.Num());
+
+	for (const flecs::entity_t Entity : Entities)
+	{
+		OutEntities.Emplace(GetFlecsWorld(), Entity);
+	}
+}
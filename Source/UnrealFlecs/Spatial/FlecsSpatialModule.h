@@ -0,0 +1,64 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FlecsSpatialQueryResult.h"
+#include "Entities/FlecsEntityHandle.h"
+#include "Modules/FlecsModuleObject.h"
+#include "FlecsSpatialModule.generated.h"
+
+/**
+ * @brief Indexes FFlecsLocationComponent in a uniform grid for radius and nearest entity queries.
+ * The index is updated once per frame in PostUpdate, tables and rows that didn't move are skipped,
+ * queries see the locations of the last update.
+ */
+UCLASS(BlueprintType, DefaultToInstanced, EditInlineNew, DisplayName = "Flecs Spatial Module")
+class UNREALFLECS_API UFlecsSpatialModule final : public UFlecsModuleObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity) override;
+	virtual void DeinitializeModule(UFlecsWorld* InWorld) override;
+
+	FORCEINLINE virtual FString GetModuleName_Implementation() const override
+	{
+		return TEXT("Flecs Spatial Module");
+	}
+
+	/** Find the entities of a batch of queries, each query needs a radius */
+	void FindInRadius(TConstArrayView<ecs_spatial_query_t> InQueries, FFlecsSpatialQueryResult& OutResult) const;
+
+	/** Find the K nearest entities of a batch of queries sorted by distance, a radius of 0 is unbounded */
+	void FindNearest(TConstArrayView<ecs_spatial_query_t> InQueries, FFlecsSpatialQueryResult& OutResult) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Spatial")
+	int32 FindEntitiesInRadius(const FVector& InCenter, const double InRadius,
+		TArray<FFlecsEntityHandle>& OutEntities) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Spatial")
+	int32 FindNearestEntities(const FVector& InCenter, const int32 InCount,
+		TArray<FFlecsEntityHandle>& OutEntities, const double InMaxRadius = 0.0) const;
+
+	/** Compacts the index during the next update */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Spatial")
+	void RebuildIndex() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | Spatial")
+	int32 GetNumIndexedEntities() const;
+
+	/** Close to the radius of most queries, larger cells visit fewer cells but test more entities */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flecs | Spatial", meta = (ClampMin = "1.0"))
+	double CellSize = 1000.0;
+
+	UPROPERTY()
+	FFlecsEntityHandle SpatialIndexEntity;
+
+private:
+	static NO_DISCARD ecs_spatial_query_t MakeQuery(const FVector& InCenter, const double InRadius,
+		const int32 InCount = 0);
+
+	void CopyEntities(const FFlecsSpatialQueryResult& InResult, TArray<FFlecsEntityHandle>& OutEntities) const;
+
+}; // class UFlecsSpatialModule
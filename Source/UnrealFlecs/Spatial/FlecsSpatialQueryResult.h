@@ -0,0 +1,58 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "flecs.h"
+#include "SolidMacros/Macros.h"
+
+/**
+ * @brief Owns the results of a batch of spatial queries.
+ * Results of all queries are stored in the same flat arrays, GetEntities returns the span of a single query.
+ * Reusing the same result for multiple batches avoids reallocating the arrays.
+ * Results don't use the world allocator, so batches can be evaluated from multiple threads with one result per thread.
+ */
+struct UNREALFLECS_API FFlecsSpatialQueryResult
+{
+public:
+	FORCEINLINE FFlecsSpatialQueryResult() = default;
+
+	FORCEINLINE ~FFlecsSpatialQueryResult()
+	{
+		ecs_spatial_result_fini(&Result);
+	}
+
+	FFlecsSpatialQueryResult(const FFlecsSpatialQueryResult&) = delete;
+	FFlecsSpatialQueryResult& operator=(const FFlecsSpatialQueryResult&) = delete;
+
+	FORCEINLINE NO_DISCARD int32 NumQueries() const
+	{
+		return Result.query_count;
+	}
+
+	FORCEINLINE NO_DISCARD int32 NumEntities() const
+	{
+		return ecs_vec_count(&Result.entities);
+	}
+
+	FORCEINLINE NO_DISCARD TConstArrayView<flecs::entity_t> GetEntities(const int32 InQueryIndex) const
+	{
+		const ecs_spatial_span_t Span = ecs_spatial_result_get(&Result, InQueryIndex);
+		return TConstArrayView<flecs::entity_t>(Span.entities, Span.count);
+	}
+
+	FORCEINLINE NO_DISCARD TConstArrayView<double> GetDistances(const int32 InQueryIndex) const
+	{
+		const ecs_spatial_span_t Span = ecs_spatial_result_get(&Result, InQueryIndex);
+		return TConstArrayView<double>(Span.distances, Span.count);
+	}
+
+	FORCEINLINE NO_DISCARD ecs_spatial_result_t* Get()
+	{
+		return &Result;
+	}
+
+private:
+	ecs_spatial_result_t Result = {};
+
+}; // struct FFlecsSpatialQueryResult
@@ -144,3 +144,121 @@ public:
 }; // struct FFlecsScaleComponent
 
 DEFINE_STD_HASH(FFlecsScaleComponent)
+
+/**
+ * @brief Transform of an entity relative to the closest parent with a world transform,
+ * or the world transform itself for entities without such a parent.
+ * Adding it also adds FFlecsWorldTransformComponent, which is written by the transform module.
+ */
+USTRUCT(BlueprintType)
+struct FFlecsRelativeTransformComponent
+{
+	GENERATED_BODY()
+
+	FORCEINLINE friend NO_DISCARD uint32 GetTypeHash(const FFlecsRelativeTransformComponent& InTransformComponent)
+	{
+		return HashCombine(HashCombine(GetTypeHash(InTransformComponent.Rotation),
+			GetTypeHash(InTransformComponent.Location)), GetTypeHash(InTransformComponent.Scale));
+	}
+
+public:
+	FORCEINLINE FFlecsRelativeTransformComponent() = default;
+
+	FORCEINLINE FFlecsRelativeTransformComponent(const FTransform& InTransform)
+		: Rotation(InTransform.GetRotation())
+		, Location(InTransform.GetLocation())
+		, Scale(InTransform.GetScale3D())
+	{
+	}
+
+	FORCEINLINE FFlecsRelativeTransformComponent(const FQuat& InRotation, const FVector& InLocation,
+		const FVector& InScale = FVector::OneVector)
+		: Rotation(InRotation)
+		, Location(InLocation)
+		, Scale(InScale)
+	{
+	}
+
+	FORCEINLINE NO_DISCARD bool operator==(const FFlecsRelativeTransformComponent& Other) const
+	{
+		return Rotation == Other.Rotation && Location == Other.Location && Scale == Other.Scale;
+	}
+
+	FORCEINLINE NO_DISCARD bool operator!=(const FFlecsRelativeTransformComponent& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	FORCEINLINE void SetTransform(const FTransform& InTransform)
+	{
+		Rotation = InTransform.GetRotation();
+		Location = InTransform.GetLocation();
+		Scale = InTransform.GetScale3D();
+	}
+
+	FORCEINLINE NO_DISCARD FTransform GetTransform() const { return FTransform(Rotation, Location, Scale); }
+	FORCEINLINE operator FTransform() const { return GetTransform(); }
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | Transform")
+	FQuat Rotation = FQuat::Identity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | Transform")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | Transform")
+	FVector Scale = FVector::OneVector;
+	
+}; // struct FFlecsRelativeTransformComponent
+
+DEFINE_STD_HASH(FFlecsRelativeTransformComponent)
+
+/**
+ * @brief World transform of an entity, computed from its relative transform and the world transform of its parent.
+ * Written by the transform module in PostUpdate, should be treated as read only by other systems.
+ */
+USTRUCT(BlueprintType)
+struct FFlecsWorldTransformComponent
+{
+	GENERATED_BODY()
+
+	FORCEINLINE friend NO_DISCARD uint32 GetTypeHash(const FFlecsWorldTransformComponent& InTransformComponent)
+	{
+		return HashCombine(HashCombine(GetTypeHash(InTransformComponent.Rotation),
+			GetTypeHash(InTransformComponent.Location)), GetTypeHash(InTransformComponent.Scale));
+	}
+
+public:
+	FORCEINLINE FFlecsWorldTransformComponent() = default;
+
+	FORCEINLINE FFlecsWorldTransformComponent(const FTransform& InTransform)
+		: Rotation(InTransform.GetRotation())
+		, Location(InTransform.GetLocation())
+		, Scale(InTransform.GetScale3D())
+	{
+	}
+
+	FORCEINLINE NO_DISCARD bool operator==(const FFlecsWorldTransformComponent& Other) const
+	{
+		return Rotation == Other.Rotation && Location == Other.Location && Scale == Other.Scale;
+	}
+
+	FORCEINLINE NO_DISCARD bool operator!=(const FFlecsWorldTransformComponent& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	FORCEINLINE NO_DISCARD FTransform GetTransform() const { return FTransform(Rotation, Location, Scale); }
+	FORCEINLINE operator FTransform() const { return GetTransform(); }
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flecs | Transform")
+	FQuat Rotation = FQuat::Identity;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flecs | Transform")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flecs | Transform")
+	FVector Scale = FVector::OneVector;
+	
+}; // struct FFlecsWorldTransformComponent
+
+DEFINE_STD_HASH(FFlecsWorldTransformComponent)
@@ -2,11 +2,26 @@
 
 #include "FlecsTransformModule.h"
 #include "FlecsTransformDefaultEntities.h"
+#include "Async/ParallelFor.h"
 #include "Translators/FlecsTranslationModule.h"
 #include "Worlds/FlecsWorld.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsTransformModule)
 
+DECLARE_STATS_GROUP(TEXT("FlecsTransformModule"), STATGROUP_FlecsTransformModule, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("FlecsTransformModule::PropagateWorldTransforms"),
+	STAT_FlecsTransformModule_PropagateWorldTransforms, STATGROUP_FlecsTransformModule);
+
+// The propagation loads the rotation as four and the location and scale as three consecutive doubles
+static_assert(std::is_same_v<FVector::FReal, double>, "Transform components must store double precision");
+static_assert(STRUCT_OFFSET(FFlecsRelativeTransformComponent, Rotation)
+	== STRUCT_OFFSET(FFlecsWorldTransformComponent, Rotation)
+	&& STRUCT_OFFSET(FFlecsRelativeTransformComponent, Location)
+	== STRUCT_OFFSET(FFlecsWorldTransformComponent, Location)
+	&& STRUCT_OFFSET(FFlecsRelativeTransformComponent, Scale)
+	== STRUCT_OFFSET(FFlecsWorldTransformComponent, Scale),
+	"Relative and world transform components must have the same layout");
+
 UFlecsTransformModule::UFlecsTransformModule()
 {
 }
@@ -14,8 +29,149 @@ UFlecsTransformModule::UFlecsTransformModule()
 void UFlecsTransformModule::InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity)
 {
 	const flecs::entity_t FlecsTransformSystemKind = flecs::PostUpdate;
+
+	// Entities with a relative transform always get a world transform
+	InWorld->ObtainComponentType<FFlecsRelativeTransformComponent>().GetEntity()
+		.add(flecs::With, InWorld->ObtainComponentType<FFlecsWorldTransformComponent>().GetEntity());
+
+	if (!bPropagateWorldTransforms)
+	{
+		return;
+	}
+
+	// The cascade term groups tables by depth, parents are iterated before their children
+	PropagateWorldTransformsSystem = InWorld->CreateSystemWithBuilder<const FFlecsRelativeTransformComponent,
+		FFlecsWorldTransformComponent>(TEXT("PropagateWorldTransformsSystem"))
+		.term_at(1).out()
+		.with<FFlecsWorldTransformComponent>().in().cascade().optional()
+		.kind(FlecsTransformSystemKind)
+		.cached()
+		.run([this](flecs::iter& Iter)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FlecsTransformModule_PropagateWorldTransforms);
+
+			uint64 CurrentDepth = 0;
+
+			while (Iter.next())
+			{
+				// Written parents of the previous depth are marked as changed when the iterator moves past them,
+				// the world transforms of a depth have to be computed before the next depth reads them
+				if (Iter.group_id() != CurrentDepth)
+				{
+					FlushWorldTransformBatches();
+					CurrentDepth = Iter.group_id();
+				}
+
+				// Only tables where the relative transform or the world transform of the parent was written
+				if (!Iter.changed())
+				{
+					Iter.skip();
+					continue;
+				}
+
+				const flecs::field<const FFlecsRelativeTransformComponent> Relatives
+					= Iter.field<const FFlecsRelativeTransformComponent>(0);
+				const flecs::field<FFlecsWorldTransformComponent> Worlds
+					= Iter.field<FFlecsWorldTransformComponent>(1);
+
+				FWorldTransformBatch Batch;
+				Batch.Relative = &Relatives[0];
+				Batch.World = &Worlds[0];
+				Batch.Count = static_cast<int32>(Iter.count());
+
+				if (Iter.is_set(2))
+				{
+					Batch.Parent = &Iter.field<const FFlecsWorldTransformComponent>(2)[0];
+				}
+
+				AddWorldTransformBatches(Batch);
+			}
+
+			FlushWorldTransformBatches();
+		});
 }
 
 void UFlecsTransformModule::DeinitializeModule(UFlecsWorld* InWorld)
 {
+	if (PropagateWorldTransformsSystem)
+	{
+		PropagateWorldTransformsSystem.destruct();
+	}
+
+	PendingBatches.Empty();
+	PendingEntityCount = 0;
+}
+
+void UFlecsTransformModule::AddWorldTransformBatches(const FWorldTransformBatch& InBatch)
+{
+	// Large tables are split so that their entities can be computed by multiple workers
+	for (int32 Offset = 0; Offset < InBatch.Count; Offset += MinEntitiesPerTask)
+	{
+		FWorldTransformBatch& Batch = PendingBatches.Add_GetRef(InBatch);
+		Batch.Relative += Offset;
+		Batch.World += Offset;
+		Batch.Count = FMath::Min(MinEntitiesPerTask, InBatch.Count - Offset);
+	}
+
+	PendingEntityCount += InBatch.Count;
+}
+
+void UFlecsTransformModule::FlushWorldTransformBatches()
+{
+	if (PendingBatches.IsEmpty())
+	{
+		return;
+	}
+
+	ParallelFor(PendingBatches.Num(), [this](const int32 BatchIndex)
+	{
+		ComputeWorldTransforms(PendingBatches[BatchIndex]);
+	}, PendingEntityCount < MinEntitiesPerTask ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	PendingBatches.Reset();
+	PendingEntityCount = 0;
+}
+
+void UFlecsTransformModule::ComputeWorldTransforms(const FWorldTransformBatch& InBatch)
+{
+	if (!InBatch.Parent)
+	{
+		FMemory::Memcpy(InBatch.World, InBatch.Relative, sizeof(FFlecsWorldTransformComponent) * InBatch.Count);
+		return;
+	}
+
+	// Same as FTransform::Multiply, the parent is loaded once for the whole batch
+	const VectorRegister4Double ParentRotation = VectorLoad(&InBatch.Parent->Rotation.X);
+	const VectorRegister4Double ParentLocation = VectorLoadFloat3_W0(&InBatch.Parent->Location.X);
+	const VectorRegister4Double ParentScale = VectorLoadFloat3_W0(&InBatch.Parent->Scale.X);
+	const bool bParentNegativeScale = VectorAnyLesserThan(ParentScale, GlobalVectorConstants::DoubleZero);
+
+	for (int32 Index = 0; Index < InBatch.Count; ++Index)
+	{
+		const FFlecsRelativeTransformComponent& Relative = InBatch.Relative[Index];
+		FFlecsWorldTransformComponent& World = InBatch.World[Index];
+
+		const VectorRegister4Double Rotation = VectorLoad(&Relative.Rotation.X);
+		const VectorRegister4Double Location = VectorLoadFloat3_W0(&Relative.Location.X);
+		const VectorRegister4Double Scale = VectorLoadFloat3_W0(&Relative.Scale.X);
+
+		// Negative scales need the matrix path of FTransform to keep the result consistent
+		if UNLIKELY_IF(bParentNegativeScale || VectorAnyLesserThan(Scale, GlobalVectorConstants::DoubleZero))
+		{
+			const FTransform RelativeTransform = Relative.GetTransform();
+			const FTransform ParentTransform = InBatch.Parent->GetTransform();
+
+			FTransform WorldTransform;
+			FTransform::Multiply(&WorldTransform, &RelativeTransform, &ParentTransform);
+			World = FFlecsWorldTransformComponent(WorldTransform);
+			continue;
+		}
+
+		const VectorRegister4Double WorldLocation = VectorAdd(
+			VectorQuaternionRotateVector(ParentRotation, VectorMultiply(ParentScale, Location)), ParentLocation);
+
+		VectorStore(VectorQuaternionMultiply2(ParentRotation, Rotation), &World.Rotation.X);
+		VectorStoreFloat3(WorldLocation, &World.Location.X);
+		VectorStoreFloat3(VectorMultiply(ParentScale, Scale), &World.Scale.X);
+	}
 }
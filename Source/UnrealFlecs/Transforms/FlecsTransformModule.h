@@ -3,9 +3,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FlecsTransformComponents.h"
 #include "Modules/FlecsModuleObject.h"
+#include "Systems/FlecsSystem.h"
 #include "FlecsTransformModule.generated.h"
 
+/**
+ * @brief Computes FFlecsWorldTransformComponent from FFlecsRelativeTransformComponent and the world transform
+ * of the closest ChildOf parent that has one. Depths are computed in order, the entities of a depth in parallel,
+ * tables whose relative transform and parent world transform didn't change are skipped.
+ */
 UCLASS(BlueprintType, DisplayName = "Flecs Transform Module")
 class UNREALFLECS_API UFlecsTransformModule final : public UFlecsModuleObject
 {
@@ -22,5 +29,35 @@ public:
 	virtual void InitializeModule(UFlecsWorld* InWorld, const FFlecsEntityHandle& InModuleEntity) override;
 	virtual void DeinitializeModule(UFlecsWorld* InWorld) override;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flecs | Transform")
+	bool bPropagateWorldTransforms = true;
+
+	/** Entities of a depth are split in tasks of this size, depths with fewer entities run on the calling thread */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flecs | Transform",
+		meta = (EditCondition = "bPropagateWorldTransforms", ClampMin = "1"))
+	int32 MinEntitiesPerTask = 1024;
+
+	flecs::system PropagateWorldTransformsSystem;
+
+private:
+	struct FWorldTransformBatch
+	{
+		const FFlecsRelativeTransformComponent* Relative = nullptr;
+		FFlecsWorldTransformComponent* World = nullptr;
+
+		/** World transform of the parent shared by all entities of the batch, nullptr for roots */
+		const FFlecsWorldTransformComponent* Parent = nullptr;
+
+		int32 Count = 0;
+	}; // struct FWorldTransformBatch
+
+	void AddWorldTransformBatches(const FWorldTransformBatch& InBatch);
+	void FlushWorldTransformBatches();
+
+	static void ComputeWorldTransforms(const FWorldTransformBatch& InBatch);
+
+	/** Batches of the depth that is being collected, computed when the next depth starts */
+	TArray<FWorldTransformBatch> PendingBatches;
+	int32 PendingEntityCount = 0;
 
 }; // class UFlecsTransformModule
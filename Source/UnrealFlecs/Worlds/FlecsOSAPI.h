@@ -144,6 +144,9 @@ struct FFlecsConditionWrapper
 	FCriticalSection* Mutex;
 }; // struct ConditionWrapper
 
+/**
+ * The hooks are shared by every world and keep no state of their own, so worlds can progress concurrently.
+ */
 struct FOSApiInitializer
 {
 	FOSApiInitializer()
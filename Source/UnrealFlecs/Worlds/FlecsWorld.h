@@ -12,8 +12,11 @@
 #include "Components/FlecsModuleComponent.h"
 #include "Components/FlecsPrimaryAssetComponent.h"
 #include "Components/FlecsUObjectComponent.h"
+#include "Components/FlecsUObjectPtrCacheComponent.h"
 #include "Components/FlecsWorldNameComponent.h"
 #include "Entities/FlecsEntityRecord.h"
+#include "Entities/FlecsEntityRecordSpawner.h"
+#include "GameplayTags/FlecsGameplayTagIndex.h"
 #include "SolidMacros/Concepts/SolidConcepts.h"
 #include "Entities/FlecsId.h"
 #include "Logs/FlecsCategories.h"
@@ -21,7 +24,9 @@
 #include "Modules/FlecsModuleInitEvent.h"
 #include "Modules/FlecsModuleInterface.h"
 #include "Modules/FlecsModuleProgressInterface.h"
+#include "Networking/FlecsNetworkIdComponent.h"
 #include "Prefabs/FlecsPrefabAsset.h"
+#include "Queries/FlecsQueryDefinitionCache.h"
 #include "FlecsWorld.generated.h"
 
 DECLARE_STATS_GROUP(TEXT("FlecsWorld"), STATGROUP_FlecsWorld, STATCAT_Advanced);
@@ -29,6 +34,10 @@ DECLARE_STATS_GROUP(TEXT("FlecsWorld"), STATGROUP_FlecsWorld, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("FlecsWorld::Progress"), STAT_FlecsWorldProgress, STATGROUP_FlecsWorld);
 DECLARE_CYCLE_STAT(TEXT("FlecsWorld::Progress::ProgressModule"),
 	STAT_FlecsWorldProgressModule, STATGROUP_FlecsWorld);
+DECLARE_CYCLE_STAT(TEXT("FlecsWorld::ResolveUObjectPtrCache"),
+	STAT_FlecsWorldResolveUObjectPtrCache, STATGROUP_FlecsWorld);
+DECLARE_CYCLE_STAT(TEXT("FlecsWorld::ProgressGameThreadSystems"),
+	STAT_FlecsWorldProgressGameThreadSystems, STATGROUP_FlecsWorld);
 
 UCLASS(BlueprintType)
 class UNREALFLECS_API UFlecsWorld final : public UObject
@@ -66,14 +75,69 @@ public:
 		}
 	}
 
-	void WorldBeginPlay()
+	void WorldBeginPlay(const bool bInCopiedFromTemplate = false)
 	{
 		UN_LOG(LogFlecsWorld, Log, "Flecs World begin play");
 		
-		InitializeSystems();
+		InitializeSystems(bInCopiedFromTemplate);
 		InitializeAssetRegistry();
 	}
 
+	/**
+	 * @brief Copy the entities of a template world into this world, must be called before anything is added to it.
+	 * Components, reflection data and gameplay tags registered in the template keep their ids,
+	 * systems, observers and queries are not copied. The template must outlive this world.
+	 * Type reflection, the traversal cache, threaded destructors, time measurements, time scale and target FPS
+	 * of the template are applied to this world, threads are not.
+	 */
+	void CopyFromTemplate(const UFlecsWorld* InTemplateWorld)
+	{
+		solid_check(IsValid(InTemplateWorld));
+
+		const int Result = ecs_world_clone_into(World, InTemplateWorld->World);
+		solid_checkf(Result == 0, TEXT("Failed to copy template world %s"), *InTemplateWorld->GetName());
+
+		*TypeMapComponent = *InTemplateWorld->TypeMapComponent;
+		TagIndex.CopyFrom(InTemplateWorld->TagIndex);
+
+		// Settings are stored in the world, not in the copied entities
+		const ecs_flags32_t TemplateFlags = ecs_world_get_flags(InTemplateWorld->World.c_ptr());
+
+		if (TemplateFlags & EcsWorldTravCache)
+		{
+			EnableTraversalCache(true);
+		}
+
+		if (TemplateFlags & EcsWorldThreadedDtors)
+		{
+			ecs_enable_threaded_dtors(World.c_ptr(), true);
+		}
+
+		if (TemplateFlags & EcsWorldMeasureFrameTime)
+		{
+			ecs_measure_frame_time(World.c_ptr(), true);
+		}
+
+		if (TemplateFlags & EcsWorldMeasureSystemTime)
+		{
+			ecs_measure_system_time(World.c_ptr(), true);
+		}
+
+		const ecs_world_info_t* TemplateInfo = InTemplateWorld->World.get_info();
+		World.set_time_scale(TemplateInfo->time_scale);
+
+		if (TemplateInfo->target_fps > 0)
+		{
+			World.set_target_fps(TemplateInfo->target_fps);
+		}
+
+		// Members of the copied types are already built, this only builds the ones the template skipped
+		if (InTemplateWorld->bTypeReflectionEnabled)
+		{
+			EnableTypeReflection();
+		}
+	}
+
 	void InitializeDefaultComponents() const
 	{
 		World.component<FString>()
@@ -175,52 +239,75 @@ public:
 			});
 	}
 
-	void InitializeSystems()
+	void InitializeSystems(const bool bInCopiedFromTemplate)
 	{
+		// Script structs copied from a template already have their properties
 		CreateObserver<const FFlecsScriptStructComponent>("ScriptStructComponentObserver")
 			.with_symbol_component().filter()
 			.event(flecs::OnSet)
-			.yield_existing()
+			.yield_existing(!bInCopiedFromTemplate)
 			.each([&](flecs::iter& Iter, size_t IterIndex,
 				const FFlecsScriptStructComponent& InScriptStructComponent)
 			{
 				FFlecsEntityHandle EntityHandle = Iter.entity(IterIndex);
 
-				const FString StructSymbol = EntityHandle.GetSymbol();
+				const char* StructSymbol = ecs_get_symbol(Iter.world(), EntityHandle);
 				
-				if (FFlecsComponentPropertiesRegistry::Get().ContainsComponentProperties(
-					StringCast<char>(*StructSymbol).Get()))
+				if (const FFlecsComponentProperties* Properties = FFlecsComponentPropertiesRegistry::Get()
+					.FindComponentProperties(StructSymbol))
 				{
-					const FFlecsComponentProperties* Properties = FFlecsComponentPropertiesRegistry::Get().
-						GetComponentProperties(StringCast<char>(*StructSymbol).Get());
-					
 					for (const flecs::entity_t Entity : Properties->Entities)
 					{
 						EntityHandle.Add(Entity);
 					}
 
-					for (const FInstancedStruct& InstancedStruct : Properties->ComponentPropertyStructs)
+					Properties->ForEachComponentPropertyStruct([&EntityHandle](const FInstancedStruct& InstancedStruct)
 					{
 						solid_check(InstancedStruct.IsValid());
 						EntityHandle.Set(InstancedStruct);
-					}
+					});
 
 					UN_LOGF(LogFlecsWorld, Log,
-						"Component properties %s found with %d entities and %d component properties",
-						*StructSymbol, Properties->Entities.size(),
-						Properties->ComponentPropertyStructs.Num());
+						"Component properties %hs found with %d entities",
+						StructSymbol, Properties->Entities.size());
 				}
 				#if WITH_EDITOR
 				else
 				{
 					UN_LOGF(LogFlecsWorld, Log,
-						"Component properties %s not found", *StructSymbol);
+						"Component properties %hs not found", StructSymbol);
 				}
 				#endif // WITH_EDITOR
-				
-				RegisterMemberProperties(InScriptStructComponent.ScriptStruct.Get(), EntityHandle);
+
+				// Members are built on demand, see EnableTypeReflection
+				if (bTypeReflectionEnabled)
+				{
+					RegisterMemberProperties(InScriptStructComponent.ScriptStruct.Get(), EntityHandle);
+				}
+			});
+
+		// Every entity with an object gets the raw pointer cache in the same table move
+		World.component<FFlecsUObjectComponent>()
+			.add(flecs::With, World.component<FFlecsUObjectPtrCacheComponent>());
+
+		CreateObserver<const FFlecsUObjectComponent, FFlecsUObjectPtrCacheComponent>(
+			TEXT("UObjectPtrCacheObserver"))
+			.term_at(1).filter()
+			.event(flecs::OnSet)
+			.each([](const FFlecsUObjectComponent& InUObjectComponent,
+				FFlecsUObjectPtrCacheComponent& InPtrCacheComponent)
+			{
+				InPtrCacheComponent.Object = InUObjectComponent.GetObject();
 			});
 
+		UObjectPtrCacheQuery = World.query_builder<const FFlecsUObjectComponent, FFlecsUObjectPtrCacheComponent>(
+			"UObjectPtrCacheQuery")
+			.cached()
+			.build();
+
+		// Entities are resolved from their network id when references are replicated
+		CreateValueIndex<FFlecsNetworkIdComponent>();
+
 		ObjectDestructionComponentQuery = World.query_builder<FFlecsUObjectComponent>("UObjectDestructionComponentQuery")
 			.without<FFlecsUObjectComponent>(DontDeleteUObjectEntity)
 			.begin_scope_traits<FFlecsUObjectComponent>().optional()
@@ -241,6 +328,9 @@ public:
 					InEntity.destruct();
 				}
 			});
+
+			// Objects of entities that were kept alive may have been collected as well
+			ResolveUObjectPtrCache(true);
 		});
 
 		ModuleComponentQuery = World.query_builder<FFlecsModuleComponent>("ModuleComponentQuery")
@@ -444,6 +534,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Flecs | World")
 	void Reset()
 	{
+		GameThreadSystems.Reset();
+		RecordSpawner.Reset();
+		QueryDefinitionCache.Reset(this);
+		TagIndex.Reset();
 		World.reset();
 	}
 
@@ -486,20 +580,85 @@ public:
 		return World.entity().is_a(InPrefab.GetEntity());
 	}
 
+	/**
+	 * @brief Create multiple instances of a prefab with one ecs_instantiate_n call,
+	 * the children of the prefab are instantiated once per prefab child for all instances.
+	 * @param InPrefab The prefab to instantiate
+	 * @param InCount The number of instances to create
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
+	TArray<FFlecsEntityHandle> CreateEntitiesWithPrefab(const FFlecsEntityHandle& InPrefab, const int32 InCount) const
+	{
+		solid_checkf(InPrefab.IsValid(), TEXT("Prefab is not valid"));
+
+		TArray<FFlecsEntityHandle> Result;
+
+		if UNLIKELY_IF(InCount <= 0)
+		{
+			return Result;
+		}
+
+		const flecs::entity_t* Entities = ecs_instantiate_n(World.c_ptr(), InPrefab.GetEntity(), InCount);
+		solid_check(Entities);
+
+		Result.Reserve(InCount);
+
+		// The returned array is owned by the entity index and may move when new entities are created
+		for (int32 Index = 0; Index < InCount; ++Index)
+		{
+			Result.Emplace(this, Entities[Index]);
+		}
+
+		return Result;
+	}
+
+	/**
+	 * @brief Create an entity from a record, the record is compiled once into its target table
+	 * so the entity is created with a single table append.
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
 	FFlecsEntityHandle CreateEntityWithRecord(const FFlecsEntityRecord& InRecord) const
 	{
-		FFlecsEntityHandle Entity = CreateEntity(InRecord.Name);
-		InRecord.ApplyRecordToEntity(Entity);
-		return Entity;
+		return RecordSpawner.Spawn(this, InRecord);
 	}
 
 	FFlecsEntityHandle CreateEntityWithRecordWithId(const FFlecsEntityRecord& InRecord,
 		const flecs::entity_t InId) const
 	{
-		const FFlecsEntityHandle Entity = CreateEntityWithId(InId);
-		InRecord.ApplyRecordToEntity(Entity);
-		return Entity;
+		return RecordSpawner.Spawn(this, InRecord, InId);
+	}
+
+	/**
+	 * @brief Create multiple entities from a record with one ecs_bulk_init call,
+	 * the name of the record is not applied as names are unique.
+	 * @param InRecord The record to create the entities from
+	 * @param InCount The number of entities to create
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
+	TArray<FFlecsEntityHandle> CreateEntitiesWithRecord(const FFlecsEntityRecord& InRecord, const int32 InCount) const
+	{
+		return RecordSpawner.SpawnBulk(this, InRecord, InCount);
+	}
+
+	/**
+	 * @brief Obtain the compiled query of a definition, identical definitions share one cached query.
+	 * Every call adds a reference that has to be released with ReleaseQuery.
+	 * @param InDefinition The definition to compile
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
+	FFlecsQuery ObtainQuery(const FFlecsQueryDefinition& InDefinition)
+	{
+		return QueryDefinitionCache.Obtain(this, InDefinition);
+	}
+
+	/**
+	 * @brief Release a query obtained with ObtainQuery, the query is destructed with its last reference.
+	 * @return True if the query was destructed
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
+	bool ReleaseQuery(const FFlecsQuery& InQuery)
+	{
+		return QueryDefinitionCache.Release(this, InQuery);
 	}
 	
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World",
@@ -510,6 +669,40 @@ public:
 		return World.lookup(StringCast<char>(*Name).Get(), StringCast<char>(*Separator).Get(),
 			StringCast<char>(*RootSeparator).Get(), bRecursive);
 	}
+
+	/**
+	 * @brief Index the values of a component, so entities can be found with LookupEntityByValue.
+	 * Values are hashed with GetTypeHash and compared with operator== of the component type.
+	 * The index is updated on OnSet/OnRemove, values changed in place must be followed by Modified.
+	 * @return The index entity, destroying it removes the index
+	 */
+	template <typename T>
+	FFlecsEntityHandle CreateValueIndex() const
+	{
+		ecs_value_index_desc_t Desc = {};
+		Desc.component = ObtainComponentType<T>().GetEntity();
+		Desc.hash = [](const void* InValue) -> uint64
+		{
+			return GetTypeHash(*static_cast<const T*>(InValue));
+		};
+		Desc.compare = [](const void* InA, const void* InB) -> int
+		{
+			return *static_cast<const T*>(InA) == *static_cast<const T*>(InB) ? 0 : 1;
+		};
+		
+		return flecs::entity(World, ecs_value_index_init(World, &Desc));
+	}
+
+	/**
+	 * @brief Find the entity with a component value, requires an index created with CreateValueIndex.
+	 * @return The entity with the value, or a null handle if no entity has the value
+	 */
+	template <typename T>
+	FFlecsEntityHandle LookupEntityByValue(const T& InValue) const
+	{
+		return flecs::entity(World,
+			ecs_lookup_by_value(World, ObtainComponentType<T>().GetEntity(), &InValue));
+	}
 	
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
 	void DestroyEntityByName(const FString& Name, const bool bSearchPath = true) const
@@ -760,11 +953,64 @@ public:
 		World.set_ctx(InContext);
 	}
 
+	/**
+	 * @brief Resolve the FFlecsUObjectPtrCacheComponent of every entity from its FFlecsUObjectComponent.
+	 * @param bForce Resolve all tables instead of only the ones where the object component changed
+	 */
+	void ResolveUObjectPtrCache(const bool bForce = false)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlecsWorldResolveUObjectPtrCache);
+
+		if (!bForce && !UObjectPtrCacheQuery.changed())
+		{
+			return;
+		}
+
+		UObjectPtrCacheQuery.run([bForce](flecs::iter& Iter)
+		{
+			while (Iter.next())
+			{
+				if (!bForce && !Iter.changed())
+				{
+					// Don't mark the cache column as written for tables that weren't touched
+					Iter.skip();
+					continue;
+				}
+
+				const flecs::field<const FFlecsUObjectComponent> UObjectComponents
+					= Iter.field<const FFlecsUObjectComponent>(0);
+				const flecs::field<FFlecsUObjectPtrCacheComponent> PtrCacheComponents
+					= Iter.field<FFlecsUObjectPtrCacheComponent>(1);
+
+				for (const size_t Index : Iter)
+				{
+					PtrCacheComponents[Index].Object = UObjectComponents[Index].GetObject();
+				}
+			}
+		});
+	}
+
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
 	bool Progress(const double DeltaTime = 0.0)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_FlecsWorldProgress);
 
+		ProgressGameThread(DeltaTime);
+		const bool bProgressed = ProgressPipeline(DeltaTime);
+		ProgressGameThreadSystems();
+		return bProgressed;
+	}
+
+	/**
+	 * @brief The game thread part of Progress, resolves the UObject pointer cache and progresses the modules.
+	 * Must be followed by ProgressPipeline.
+	 */
+	void ProgressGameThread(const double DeltaTime = 0.0)
+	{
+		solid_checkf(IsInGameThread(), TEXT("Modules must be progressed on the game thread"));
+		
+		ResolveUObjectPtrCache();
+
 		{
 			SCOPE_CYCLE_COUNTER(STAT_FlecsWorldProgressModule);
 			
@@ -774,10 +1020,51 @@ public:
 				Module->ProgressModule(DeltaTime);
 			}
 		}
-		
+	}
+
+	/**
+	 * @brief Runs the pipeline of the world, the part of Progress that may run off the game thread.
+	 */
+	bool ProgressPipeline(const double DeltaTime = 0.0)
+	{
 		return World.progress(DeltaTime);
 	}
 
+	/**
+	 * @brief Runs the game thread systems with the delta time of the last frame, must follow ProgressPipeline.
+	 */
+	void ProgressGameThreadSystems()
+	{
+		solid_checkf(IsInGameThread(), TEXT("Game thread systems must be run on the game thread"));
+
+		SCOPE_CYCLE_COUNTER(STAT_FlecsWorldProgressGameThreadSystems);
+
+		for (const flecs::system& System : GameThreadSystems)
+		{
+			System.run(World.delta_time());
+		}
+	}
+
+	/**
+	 * @brief Run the system on the game thread after the pipeline instead of in the pipeline,
+	 * for systems that touch UObjects or other game thread state.
+	 * The system must not have a phase, it is run by ProgressGameThreadSystems in the order it was added.
+	 */
+	void AddGameThreadSystem(const flecs::system& InSystem)
+	{
+		solid_checkf(InSystem.is_alive(), TEXT("Game thread system is not alive"));
+		solid_checkf(!InSystem.has(flecs::DependsOn, flecs::Wildcard),
+			TEXT("Game thread system %s must not have a phase, it would also run in the pipeline"),
+			StringCast<TCHAR>(InSystem.name().c_str()).Get());
+
+		GameThreadSystems.AddUnique(InSystem);
+	}
+
+	bool RemoveGameThreadSystem(const flecs::system& InSystem)
+	{
+		return GameThreadSystems.Remove(InSystem) > 0;
+	}
+
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs | World")
 	void SetTimeScale(const double InTimeScale) const
 	{
@@ -796,6 +1083,12 @@ public:
 		ModuleComponentQuery.destruct();
 		DependenciesComponentQuery.destruct();
 		ObjectDestructionComponentQuery.destruct();
+		UObjectPtrCacheQuery.destruct();
+
+		GameThreadSystems.Reset();
+		RecordSpawner.Reset();
+		QueryDefinitionCache.Reset(this);
+		TagIndex.Reset();
 		
 		const FAssetRegistryModule* AssetRegistryModule
 			= FModuleManager::LoadModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry"));
@@ -927,6 +1220,13 @@ public:
 		World.enable_range_check(bInEnforce);
 	}
 
+	/** Cache up traversal results in the world, shared by all queries until the traversed entities change */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World")
+	void EnableTraversalCache(const bool bInEnable) const
+	{
+		ecs_enable_trav_cache(World.c_ptr(), bInEnable);
+	}
+
 	template <typename FunctionType>
 	void ForEachChild(FunctionType&& Function) const
 	{
@@ -1099,8 +1399,9 @@ public:
 			}
 			else if (Property->IsA<FStructProperty>())
 			{
-				FFlecsEntityHandle StructComponent
-					= ObtainComponentTypeStruct(CastFieldChecked<FStructProperty>(Property)->Struct);
+				const UScriptStruct* PropertyStruct = CastFieldChecked<FStructProperty>(Property)->Struct;
+				FFlecsEntityHandle StructComponent = ObtainComponentTypeStruct(PropertyStruct);
+				EnsureTypeReflection(PropertyStruct);
 				UntypedComponent.member(StructComponent,
 					StringCast<char>(*Property->GetName()).Get(), 1,
 					Property->GetOffset_ForInternal());
@@ -1136,6 +1437,98 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Build the meta members of every registered script struct and enum, and of every type registered after.
+	 * Types are registered without members by default, only serializers, REST and the editor read them.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World")
+	void EnableTypeReflection()
+	{
+		if (bTypeReflectionEnabled)
+		{
+			return;
+		}
+
+		bTypeReflectionEnabled = true;
+
+		// Reflecting a struct can register the structs of its properties, which grows the map
+		TArray<const UScriptStruct*> ScriptStructs;
+		ScriptStructs.Reserve(TypeMapComponent->ScriptStructMap.size());
+
+		for (const auto& [ScriptStructComponent, Entity] : TypeMapComponent->ScriptStructMap)
+		{
+			ScriptStructs.Add(ScriptStructComponent.ScriptStruct.Get());
+		}
+
+		for (const UScriptStruct* ScriptStruct : ScriptStructs)
+		{
+			EnsureTypeReflection(ScriptStruct);
+		}
+
+		for (const auto& [ScriptEnumComponent, Entity] : TypeMapComponent->ScriptEnumMap)
+		{
+			EnsureEnumReflection(ScriptEnumComponent.ScriptEnum.Get());
+		}
+	}
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | World")
+	bool IsTypeReflectionEnabled() const
+	{
+		return bTypeReflectionEnabled;
+	}
+
+	/** Build the meta members of a script struct if they weren't built yet */
+	void EnsureTypeReflection(const UScriptStruct* ScriptStruct) const
+	{
+		if UNLIKELY_IF(!IsValid(ScriptStruct))
+		{
+			return;
+		}
+
+		const FFlecsEntityHandle StructComponent = ObtainComponentTypeStruct(ScriptStruct);
+
+		if (!StructComponent.Has<flecs::Struct>())
+		{
+			RegisterMemberProperties(ScriptStruct, StructComponent);
+		}
+	}
+
+	/** Build the constants of a script enum if they weren't built yet */
+	void EnsureEnumReflection(UEnum* Enum) const
+	{
+		if UNLIKELY_IF(!IsValid(Enum))
+		{
+			return;
+		}
+
+		const FFlecsEntityHandle EnumComponent = ObtainScriptEnumType(Enum);
+
+		if (!EnumComponent.Has<flecs::Enum>() && !EnumComponent.Has<flecs::Bitmask>())
+		{
+			RegisterEnumProperties(Enum, EnumComponent);
+		}
+	}
+
+	/** Build the meta members of the script struct components of an entity, called before it is serialized */
+	void EnsureEntityTypeReflection(const FFlecsEntityHandle& InEntity) const
+	{
+		InEntity.GetEntity().each([this](const flecs::id& InId)
+		{
+			const flecs::entity TypeEntity = InId.type_id();
+
+			if (!TypeEntity)
+			{
+				return;
+			}
+
+			if (const FFlecsScriptStructComponent* ScriptStructComponent
+				= TypeEntity.get<FFlecsScriptStructComponent>())
+			{
+				EnsureTypeReflection(ScriptStructComponent->ScriptStruct.Get());
+			}
+		});
+	}
+
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Flecs")
 	FFlecsEntityHandle RegisterScriptEnum(UEnum* Enum) const
 	{
@@ -1145,7 +1538,11 @@ public:
 
 		if (const FFlecsEntityHandle Handle = LookupEntity(Enum->GetName()))
 		{
-			RegisterEnumProperties(Enum, Handle);
+			if (bTypeReflectionEnabled)
+			{
+				RegisterEnumProperties(Enum, Handle);
+			}
+
 			SetScope(OldScope);
 			return Handle;
 		}
@@ -1156,11 +1553,10 @@ public:
 		
 		TypeMapComponent->ScriptEnumMap.emplace(Enum, EnumComponent.GetEntity());
 
-		//#if WITH_EDITOR
-
-		RegisterEnumProperties(Enum, EnumComponent);
-
-		//#endif // WITH_EDITOR
+		if (bTypeReflectionEnabled)
+		{
+			RegisterEnumProperties(Enum, EnumComponent);
+		}
 
 		SetScope(OldScope);
 		return EnumComponent;
@@ -1193,6 +1589,9 @@ public:
 			ResumeDefer();
 		}
 
+		// Later obtains hit the map, the properties and members of the type are only applied once
+		TypeMapComponent->ScriptStructMap.emplace(ScriptStruct, ScriptStructComponent);
+
 		ScriptStructComponent.set<FFlecsScriptStructComponent>({ ScriptStruct });
 
 		SetScope(OldScope);
@@ -1311,10 +1710,52 @@ public:
 	FFlecsEntityHandle GetTagEntity(const FGameplayTag& Tag) const
 	{
 		solid_checkf(Tag.IsValid(), TEXT("Tag is not valid"));
+
+		if LIKELY_IF(const flecs::entity_t TagEntity = TagIndex.GetTagEntity(Tag))
+		{
+			return FFlecsEntityHandle(this, TagEntity);
+		}
+		
 		return LookupEntity(
 			StringCast<char>(*Tag.GetTagName().ToString()).Get(), ".", ".");
 	}
 
+	/**
+	 * @brief Create the gameplay tag entities in bulk and assign their nested-set intervals.
+	 * @param InTagHierarchy Map of every tag to its direct children
+	 */
+	void RegisterGameplayTagHierarchy(const TMap<FGameplayTag, TArray<FGameplayTag>>& InTagHierarchy) const
+	{
+		TagIndex.Build(this, InTagHierarchy);
+	}
+
+	/** True if InTag is InAncestor or one of its descendants, without traversing the tag hierarchy */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Gameplay Tags")
+	bool IsTagUnder(const FGameplayTag& InTag, const FGameplayTag& InAncestor) const
+	{
+		return TagIndex.IsTagUnder(InTag, InAncestor);
+	}
+
+	/** True if the entity has InAncestor or any of its descendants as a tag */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | Gameplay Tags")
+	bool HasTagUnder(const FFlecsEntityHandle& InEntity, const FGameplayTag& InAncestor) const
+	{
+		const FFlecsGameplayTagInterval* AncestorInterval = TagIndex.GetInterval(InAncestor);
+
+		if UNLIKELY_IF(!AncestorInterval)
+		{
+			return false;
+		}
+
+		return TagIndex.TableHasTagUnder(World.c_ptr(), ecs_get_table(World.c_ptr(), InEntity.GetId()),
+			*AncestorInterval);
+	}
+
+	FORCEINLINE NO_DISCARD FFlecsGameplayTagIndex& GetTagIndex() const
+	{
+		return TagIndex;
+	}
+
 	template <typename T>
 	void EnableType() const
 	{
@@ -1462,8 +1903,20 @@ public:
 
 	flecs::query<FFlecsModuleComponent> ModuleComponentQuery;
 	flecs::query<FFlecsUObjectComponent> ObjectDestructionComponentQuery;
+	flecs::query<const FFlecsUObjectComponent, FFlecsUObjectPtrCacheComponent> UObjectPtrCacheQuery;
 	flecs::query<FFlecsDependenciesComponent> DependenciesComponentQuery;
 
+	/** Systems without a phase that are run on the game thread after the pipeline */
+	TArray<flecs::system> GameThreadSystems;
+
 	FFlecsTypeMapComponent* TypeMapComponent;
+
+	mutable FFlecsEntityRecordSpawner RecordSpawner;
+
+	FFlecsQueryDefinitionCache QueryDefinitionCache;
+
+	mutable FFlecsGameplayTagIndex TagIndex;
+
+	bool bTypeReflectionEnabled = false;
 	
 }; // class UFlecsWorld
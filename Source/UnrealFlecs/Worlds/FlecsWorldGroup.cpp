@@ -0,0 +1,257 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FlecsWorldGroup.h"
+#include "FlecsWorld.h"
+#include "Components/FlecsWorldPtrComponent.h"
+#include "Components/UWorldPtrComponent.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/Event.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlecsWorldGroup)
+
+DECLARE_STATS_GROUP(TEXT("FlecsWorldGroup"), STATGROUP_FlecsWorldGroup, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("FlecsWorldGroup::Step"), STAT_FlecsWorldGroup_Step, STATGROUP_FlecsWorldGroup);
+DECLARE_CYCLE_STAT(TEXT("FlecsWorldGroup::WaitForWorkers"),
+	STAT_FlecsWorldGroup_WaitForWorkers, STATGROUP_FlecsWorldGroup);
+DECLARE_CYCLE_STAT(TEXT("FlecsWorldGroup::ProgressWorld"),
+	STAT_FlecsWorldGroup_ProgressWorld, STATGROUP_FlecsWorldGroup);
+
+namespace
+{
+	// Same pool as FFlecsTask::TaskThread, the stage tasks of a world must be scheduled on the workers it reserved
+	constexpr ENamedThreads::Type WorldTaskThread = ENamedThreads::AnyHiPriThreadNormalTask;
+} // namespace
+
+void UFlecsWorldGroup::AddWorld(UFlecsWorld* InWorld, const int32 InThreadBudget)
+{
+	solid_checkf(IsInGameThread(), TEXT("Worlds must be added to a group from the game thread"));
+	solid_checkf(IsValid(InWorld), TEXT("World is nullptr"));
+	solid_checkf(!Worlds.Contains(InWorld), TEXT("World %s is already in the group"), *InWorld->GetName());
+
+	Worlds.Add(InWorld);
+	RequestedThreadBudgets.Add(FMath::Max(InThreadBudget, 0));
+	ThreadBudgets.Add(1);
+	LastWorldStepTimes.Add(0.0);
+
+	ApplyThreadBudgets(GetNumWorkerThreads());
+}
+
+bool UFlecsWorldGroup::RemoveWorld(UFlecsWorld* InWorld)
+{
+	solid_checkf(IsInGameThread(), TEXT("Worlds must be removed from a group on the game thread"));
+
+	const int32 WorldIndex = Worlds.IndexOfByKey(InWorld);
+
+	if UNLIKELY_IF(WorldIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Worlds.RemoveAt(WorldIndex);
+	RequestedThreadBudgets.RemoveAt(WorldIndex);
+	ThreadBudgets.RemoveAt(WorldIndex);
+	LastWorldStepTimes.RemoveAt(WorldIndex);
+
+	ApplyThreadBudgets(GetNumWorkerThreads());
+	return true;
+}
+
+void UFlecsWorldGroup::SetThreadBudget(UFlecsWorld* InWorld, const int32 InThreadBudget)
+{
+	solid_checkf(IsInGameThread(), TEXT("Thread budgets must be set on the game thread"));
+
+	const int32 WorldIndex = Worlds.IndexOfByKey(InWorld);
+	solid_checkf(WorldIndex != INDEX_NONE, TEXT("World is not in the group"));
+
+	RequestedThreadBudgets[WorldIndex] = FMath::Max(InThreadBudget, 0);
+	ApplyThreadBudgets(GetNumWorkerThreads());
+}
+
+int32 UFlecsWorldGroup::GetThreadBudget(const UFlecsWorld* InWorld) const
+{
+	const int32 WorldIndex = Worlds.IndexOfByKey(InWorld);
+
+	if UNLIKELY_IF(WorldIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	return ThreadBudgets[WorldIndex];
+}
+
+bool UFlecsWorldGroup::Step(const double DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlecsWorldGroup_Step);
+	solid_checkf(IsInGameThread(), TEXT("World groups must be stepped from the game thread"));
+
+	if UNLIKELY_IF(Worlds.IsEmpty())
+	{
+		return true;
+	}
+
+	const int32 NumWorkerThreads = GetNumWorkerThreads();
+
+	if (NumWorkerThreads != AppliedNumWorkerThreads)
+	{
+		ApplyThreadBudgets(NumWorkerThreads);
+	}
+
+	// Longest world first, a slow world started last would stretch the step while the other workers idle
+	StepOrder.Reset(Worlds.Num());
+
+	for (int32 WorldIndex = 0; WorldIndex < Worlds.Num(); ++WorldIndex)
+	{
+		StepOrder.Add(WorldIndex);
+	}
+
+	StepOrder.StableSort([this](const int32 A, const int32 B)
+	{
+		return LastWorldStepTimes[A] > LastWorldStepTimes[B];
+	});
+
+	std::atomic<int32> FreeWorkerThreads { NumWorkerThreads };
+	std::atomic<bool> bAllProgressed { true };
+	FEventRef WorkersReleasedEvent(EEventMode::AutoReset);
+
+	FGraphEventArray Tasks;
+	Tasks.Reserve(Worlds.Num());
+
+	const double StepStartTime = FPlatformTime::Seconds();
+
+	for (const int32 WorldIndex : StepOrder)
+	{
+		const int32 ThreadBudget = ThreadBudgets[WorldIndex];
+		UFlecsWorld* World = Worlds[WorldIndex];
+
+		// UObject pointers and modules are only safe to touch on the game thread,
+		// this overlaps with the pipelines of the worlds that are already running
+		World->ProgressGameThread(DeltaTime);
+
+		// Worlds are started in order, waiting for the first one that doesn't fit keeps the order fair
+		if (FreeWorkerThreads.load() < ThreadBudget)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FlecsWorldGroup_WaitForWorkers);
+
+			while (FreeWorkerThreads.load() < ThreadBudget)
+			{
+				WorkersReleasedEvent->Wait();
+			}
+		}
+
+		FreeWorkerThreads.fetch_sub(ThreadBudget);
+
+		Tasks.Emplace(FFunctionGraphTask::CreateAndDispatchWhenReady(
+			[this, World, WorldIndex, ThreadBudget, DeltaTime,
+				&FreeWorkerThreads, &bAllProgressed, &WorkersReleasedEvent]()
+			{
+				const double WorldStartTime = FPlatformTime::Seconds();
+
+				if UNLIKELY_IF(!World->ProgressPipeline(DeltaTime))
+				{
+					bAllProgressed.store(false);
+				}
+
+				LastWorldStepTimes[WorldIndex] = FPlatformTime::Seconds() - WorldStartTime;
+
+				FreeWorkerThreads.fetch_add(ThreadBudget);
+				WorkersReleasedEvent->Trigger();
+			}, GET_STATID(STAT_FlecsWorldGroup_ProgressWorld), nullptr, WorldTaskThread));
+	}
+
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+
+	// Actors and other UObjects are written by these, they can't run on the workers with the pipeline
+	for (const int32 WorldIndex : StepOrder)
+	{
+		Worlds[WorldIndex]->ProgressGameThreadSystems();
+	}
+
+	const double StepTime = FPlatformTime::Seconds() - StepStartTime;
+
+	Stats.NumWorlds = Worlds.Num();
+	++Stats.StepCount;
+	Stats.LastStepTime = StepTime;
+	Stats.TotalStepTime += StepTime;
+	Stats.AverageStepTime = Stats.TotalStepTime / Stats.StepCount;
+	Stats.LastTotalWorldTime = 0.0;
+	Stats.LastMinWorldTime = TNumericLimits<double>::Max();
+	Stats.LastMaxWorldTime = 0.0;
+
+	for (const double WorldStepTime : LastWorldStepTimes)
+	{
+		Stats.LastTotalWorldTime += WorldStepTime;
+		Stats.LastMinWorldTime = FMath::Min(Stats.LastMinWorldTime, WorldStepTime);
+		Stats.LastMaxWorldTime = FMath::Max(Stats.LastMaxWorldTime, WorldStepTime);
+	}
+
+	return bAllProgressed.load();
+}
+
+void UFlecsWorldGroup::DestroyWorlds()
+{
+	solid_checkf(IsInGameThread(), TEXT("Worlds must be destroyed on the game thread"));
+
+	for (UFlecsWorld* World : Worlds)
+	{
+		if (IsValid(World))
+		{
+			World->RemoveSingleton<FFlecsWorldPtrComponent>();
+			World->RemoveSingleton<FUWorldPtrComponent>();
+			World->DestroyWorld();
+		}
+	}
+
+	Worlds.Reset();
+	RequestedThreadBudgets.Reset();
+	ThreadBudgets.Reset();
+	LastWorldStepTimes.Reset();
+}
+
+double UFlecsWorldGroup::GetLastWorldStepTime(const UFlecsWorld* InWorld) const
+{
+	const int32 WorldIndex = Worlds.IndexOfByKey(InWorld);
+
+	if UNLIKELY_IF(WorldIndex == INDEX_NONE)
+	{
+		return 0.0;
+	}
+
+	return LastWorldStepTimes[WorldIndex];
+}
+
+int32 UFlecsWorldGroup::GetNumWorkerThreads() const
+{
+	// High priority tasks run on the foreground workers, the pool the world and stage tasks are scheduled on
+	const int32 NumWorkerThreads = FMath::Max(FTaskGraphInterface::Get().GetNumForegroundThreads(), 1);
+
+	if (MaxWorkerThreads > 0)
+	{
+		return FMath::Min(MaxWorkerThreads, NumWorkerThreads);
+	}
+
+	return NumWorkerThreads;
+}
+
+void UFlecsWorldGroup::ApplyThreadBudgets(const int32 InNumWorkerThreads)
+{
+	AppliedNumWorkerThreads = InNumWorkerThreads;
+
+	if UNLIKELY_IF(Worlds.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 EvenThreadBudget = FMath::Max(InNumWorkerThreads / Worlds.Num(), 1);
+
+	for (int32 WorldIndex = 0; WorldIndex < Worlds.Num(); ++WorldIndex)
+	{
+		const int32 RequestedThreadBudget = RequestedThreadBudgets[WorldIndex];
+
+		ThreadBudgets[WorldIndex] = RequestedThreadBudget > 0
+			? FMath::Min(RequestedThreadBudget, InNumWorkerThreads)
+			: EvenThreadBudget;
+
+		// Stages run as tasks on the shared workers instead of dedicated threads per world
+		Worlds[WorldIndex]->SetTaskThreads(ThreadBudgets[WorldIndex]);
+	}
+}
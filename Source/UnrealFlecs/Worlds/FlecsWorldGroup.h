@@ -0,0 +1,133 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SolidMacros/Macros.h"
+#include "UObject/Object.h"
+#include "FlecsWorldGroup.generated.h"
+
+class UFlecsWorld;
+
+USTRUCT(BlueprintType)
+struct UNREALFLECS_API FFlecsWorldGroupStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	int64 StepCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	int32 NumWorlds = 0;
+
+	/** Wall time of the last step in seconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	double LastStepTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	double AverageStepTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	double TotalStepTime = 0.0;
+
+	/** Sum of the progress times of all worlds in the last step, divided by LastStepTime it is the achieved parallelism */
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	double LastTotalWorldTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	double LastMinWorldTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Flecs | World Group")
+	double LastMaxWorldTime = 0.0;
+	
+}; // struct FFlecsWorldGroupStats
+
+/**
+ * @brief Steps a group of independent Flecs worlds concurrently on the high priority task graph workers.
+ * Each world is progressed once per step with up to its thread budget of workers, including the worker
+ * that progresses it. Worlds are only started while the budgets of the running worlds fit in the workers,
+ * the stage tasks of a world wait on each other so oversubscribing the workers could deadlock them.
+ * Worlds that took the longest in the last step are started first.
+ * The UObject pointer cache and progress modules of a world are updated on the game thread before its
+ * pipeline is started on the workers, so pipeline systems must not touch game thread state.
+ * Systems that do are added with UFlecsWorld::AddGameThreadSystem and run on the game thread once every
+ * world finished its pipeline. Worlds must be created, destroyed and added to the group from the game thread.
+ */
+UCLASS(BlueprintType)
+class UNREALFLECS_API UFlecsWorldGroup final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** A thread budget of 0 shares the workers evenly between the worlds of the group */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World Group")
+	void AddWorld(UFlecsWorld* InWorld, const int32 InThreadBudget = 0);
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World Group")
+	bool RemoveWorld(UFlecsWorld* InWorld);
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World Group")
+	void SetThreadBudget(UFlecsWorld* InWorld, const int32 InThreadBudget);
+
+	/** The number of threads the world progresses with */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | World Group")
+	int32 GetThreadBudget(const UFlecsWorld* InWorld) const;
+
+	/** Progresses every world of the group once, returns false if any world requested to quit */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World Group")
+	bool Step(const double DeltaTime = 0.0);
+
+	/** Destroys the worlds of the group and removes them from it */
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World Group")
+	void DestroyWorlds();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | World Group")
+	FORCEINLINE int32 GetNumWorlds() const
+	{
+		return Worlds.Num();
+	}
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | World Group")
+	FORCEINLINE TArray<UFlecsWorld*> GetWorlds() const
+	{
+		return ObjectPtrDecay(Worlds);
+	}
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | World Group")
+	FORCEINLINE FFlecsWorldGroupStats GetStats() const
+	{
+		return Stats;
+	}
+
+	/** Pipeline progress time of the world in the last step in seconds */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Flecs | World Group")
+	double GetLastWorldStepTime(const UFlecsWorld* InWorld) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs | World Group")
+	FORCEINLINE void ResetStats()
+	{
+		Stats = FFlecsWorldGroupStats();
+	}
+
+	/** Workers shared by the worlds of the group, 0 uses all high priority task graph workers */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flecs | World Group", meta = (ClampMin = "0"))
+	int32 MaxWorkerThreads = 0;
+
+private:
+	NO_DISCARD int32 GetNumWorkerThreads() const;
+	void ApplyThreadBudgets(const int32 InNumWorkerThreads);
+
+	UPROPERTY()
+	TArray<TObjectPtr<UFlecsWorld>> Worlds;
+
+	/** Requested budget of each world, 0 is an even share */
+	TArray<int32> RequestedThreadBudgets;
+	TArray<int32> ThreadBudgets;
+	TArray<double> LastWorldStepTimes;
+	TArray<int32> StepOrder;
+
+	int32 AppliedNumWorkerThreads = 0;
+
+	FFlecsWorldGroupStats Stats;
+	
+}; // class UFlecsWorldGroup
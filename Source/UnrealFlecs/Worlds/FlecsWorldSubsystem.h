@@ -11,6 +11,7 @@
 #include "CoreMinimal.h"
 #include "flecs.h"
 #include "FlecsWorld.h"
+#include "FlecsWorldGroup.h"
 #include "FlecsWorldSettings.h"
 #include "FlecsWorldSettingsAsset.h"
 #include "FlecsWorldStartComponent.h"
@@ -82,6 +83,13 @@ public:
 
 	virtual void Deinitialize() override
 	{
+		for (UFlecsWorldGroup* WorldGroup : WorldGroups)
+		{
+			WorldGroup->DestroyWorlds();
+		}
+
+		WorldGroups.Reset();
+		
 		if (IsValid(DefaultWorld))
 		{
 			DefaultWorld->RemoveSingleton<FFlecsWorldPtrComponent>();
@@ -91,6 +99,16 @@ public:
 
 		DefaultWorld = nullptr;
 
+		// Worlds copied from a template share its component hooks, so templates are destroyed last
+		for (UFlecsWorld* TemplateWorld : TemplateWorlds)
+		{
+			TemplateWorld->RemoveSingleton<FFlecsWorldPtrComponent>();
+			TemplateWorld->RemoveSingleton<FUWorldPtrComponent>();
+			TemplateWorld->DestroyWorld();
+		}
+
+		TemplateWorlds.Reset();
+
 		Super::Deinitialize();
 	}
 
@@ -103,85 +121,113 @@ public:
 	{
 		Super::Tick(DeltaTime);
 		
-		const bool bResult = DefaultWorld->Progress(DeltaTime);
+		if LIKELY_IF(IsValid(DefaultWorld))
+		{
+			const bool bResult = DefaultWorld->Progress(DeltaTime);
 
-		#if WITH_EDITOR
+			#if WITH_EDITOR
 
-		if UNLIKELY_IF(!bResult)
-		{
-			UN_LOGF(LogFlecsCore, Error, "Failed to progress Flecs world");
+			if UNLIKELY_IF(!bResult)
+			{
+				UN_LOGF(LogFlecsCore, Error, "Failed to progress Flecs world");
+			}
+
+			#endif // WITH_EDITOR
 		}
 
-		#endif // WITH_EDITOR
+		for (UFlecsWorldGroup* WorldGroup : WorldGroups)
+		{
+			WorldGroup->Step(DeltaTime);
+		}
 	}
 	
 	UFUNCTION()
 	FORCEINLINE UFlecsWorld* CreateWorld(const FString& Name, const FFlecsWorldSettings& Settings)
 	{
-		solid_checkf(!Name.IsEmpty(), TEXT("World name cannot be NAME_None"));
-		
-		TArray<FFlecsDefaultMetaEntity> DefaultEntities = FFlecsDefaultEntityEngine::Get().AddedDefaultEntities;
-		TMap<FString, flecs::entity_t> DefaultEntityIds = FFlecsDefaultEntityEngine::Get().DefaultEntityOptions;
+		return CreateWorldInternal(Name, Settings, true);
+	}
 
-		UFlecsWorld* NewFlecsWorld = NewObject<UFlecsWorld>(this, static_cast<FName>(Name));
-		
-		DefaultWorld = NewFlecsWorld;
-		
-		NewFlecsWorld->SetContext(this);
+	/** Creates a group of worlds that is stepped every tick after the default world */
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	UFlecsWorldGroup* CreateWorldGroup(const FName Name)
+	{
+		UFlecsWorldGroup* WorldGroup = NewObject<UFlecsWorldGroup>(this, Name);
+		WorldGroups.Add(WorldGroup);
+		return WorldGroup;
+	}
 
-		NewFlecsWorld->SetSingleton<FFlecsWorldPtrComponent>(FFlecsWorldPtrComponent{ NewFlecsWorld });
-		NewFlecsWorld->SetSingleton<FUWorldPtrComponent>(FUWorldPtrComponent{ GetWorld() });
-		
-		DefaultWorld->InitializeDefaultComponents();
-		
-		for (int32 Index = 0; Index < DefaultEntities.Num(); ++Index)
-		{
-			FString EntityName = DefaultEntities[Index].EntityRecord.Name;
-			const flecs::entity_t EntityId = DefaultEntityIds[EntityName];
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	void DestroyWorldGroup(UFlecsWorldGroup* InWorldGroup)
+	{
+		solid_checkf(IsValid(InWorldGroup), TEXT("World group is nullptr"));
 
-			#if WITH_EDITOR
-			
-			FFlecsEntityHandle NewEntity =
-				
-			#endif // WITH_EDITOR
-				
-			NewFlecsWorld->CreateEntityWithRecordWithId(DefaultEntities[Index].EntityRecord, EntityId);
+		InWorldGroup->DestroyWorlds();
+		WorldGroups.Remove(InWorldGroup);
+	}
 
-			UN_LOGF(LogFlecsCore, Log,
-				"Created default entity %s with id %d", *EntityName, EntityId);
-			
-			UN_LOGF(LogFlecsCore, Log,
-				"Entity %s with id %d", *NewEntity.GetName(), NewEntity.GetId());
-		}
+	/**
+	 * Creates a world that is progressed by the group instead of the subsystem,
+	 * a thread budget of 0 shares the workers evenly between the worlds of the group.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	UFlecsWorld* CreateWorldInGroup(UFlecsWorldGroup* InWorldGroup, const FString& Name,
+		const FFlecsWorldSettings& Settings, const int32 ThreadBudget = 0)
+	{
+		solid_checkf(IsValid(InWorldGroup), TEXT("World group is nullptr"));
 
-		NewFlecsWorld->SetWorldName(Name);
+		UFlecsWorld* NewFlecsWorld = CreateWorldInternal(Name, Settings, false);
+		InWorldGroup->AddWorld(NewFlecsWorld, ThreadBudget);
+		return NewFlecsWorld;
+	}
 
-		if (DeveloperSettings->bUseTaskThreads)
-		{
-			NewFlecsWorld->SetTaskThreads(DeveloperSettings->TaskThreadCount);
-		}
-		else
-		{
-			NewFlecsWorld->SetThreads(std::thread::hardware_concurrency());
-		}
+	/**
+	 * Creates a world that is never progressed and doesn't import modules, entities and prefabs
+	 * added to it are copied to the worlds created from it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	UFlecsWorld* CreateTemplateWorld(const FString& Name)
+	{
+		UFlecsWorld* TemplateWorld = CreateWorldInternal(Name, FFlecsWorldSettings(), false);
+		TemplateWorlds.Add(TemplateWorld);
+		return TemplateWorld;
+	}
 
-		NewFlecsWorld->WorldBeginPlay();
+	/**
+	 * Creates the default world by copying a template world, which skips registering the default entities,
+	 * gameplay tags and reflection data the template already has.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	UFlecsWorld* CreateWorldFromTemplate(const UFlecsWorld* InTemplateWorld, const FString& Name,
+		const FFlecsWorldSettings& Settings)
+	{
+		solid_checkf(TemplateWorlds.Contains(InTemplateWorld), TEXT("World is not a template world"));
+		return CreateWorldInternal(Name, Settings, true, InTemplateWorld);
+	}
 
-		RegisterAllGameplayTags(NewFlecsWorld);
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	UFlecsWorld* CreateWorldInGroupFromTemplate(UFlecsWorldGroup* InWorldGroup, const UFlecsWorld* InTemplateWorld,
+		const FString& Name, const FFlecsWorldSettings& Settings, const int32 ThreadBudget = 0)
+	{
+		solid_checkf(IsValid(InWorldGroup), TEXT("World group is nullptr"));
+		solid_checkf(TemplateWorlds.Contains(InTemplateWorld), TEXT("World is not a template world"));
 
-		for (UObject* Module : Settings.Modules)
-		{
-			solid_checkf(Module->GetClass()->ImplementsInterface(UFlecsModuleInterface::StaticClass()),
-				TEXT("Module %s does not implement UFlecsModuleInterface"), *Module->GetName());
-			
-			NewFlecsWorld->ImportModule(Module);
-		}
-		
-		OnWorldCreated.Broadcast(NewFlecsWorld);
-		
+		UFlecsWorld* NewFlecsWorld = CreateWorldInternal(Name, Settings, false, InTemplateWorld);
+		InWorldGroup->AddWorld(NewFlecsWorld, ThreadBudget);
 		return NewFlecsWorld;
 	}
 
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	FORCEINLINE TArray<UFlecsWorld*> GetTemplateWorlds() const
+	{
+		return ObjectPtrDecay(TemplateWorlds);
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Flecs")
+	FORCEINLINE TArray<UFlecsWorldGroup*> GetWorldGroups() const
+	{
+		return ObjectPtrDecay(WorldGroups);
+	}
+
 	UFUNCTION(BlueprintCallable, Category = "Flecs")
 	FORCEINLINE UFlecsWorld* GetDefaultWorld() const
 	{
@@ -225,88 +271,136 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UFlecsWorld> DefaultWorld;
 
+	UPROPERTY()
+	TArray<TObjectPtr<UFlecsWorldGroup>> WorldGroups;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UFlecsWorld>> TemplateWorlds;
+
 	UPROPERTY()
 	TWeakObjectPtr<const UFlecsDeveloperSettings> DeveloperSettings;
 
-	void RegisterAllGameplayTags(UFlecsWorld* InFlecsWorld)
+	UFlecsWorld* CreateWorldInternal(const FString& Name, const FFlecsWorldSettings& Settings, const bool bDefaultWorld,
+		const UFlecsWorld* InTemplateWorld = nullptr)
 	{
-		TMap<FGameplayTag, TArray<FGameplayTag>> TagHierarchy;
-		BuildTagHierarchyMap(TagHierarchy);
+		solid_checkf(!Name.IsEmpty(), TEXT("World name cannot be NAME_None"));
+		solid_checkf(IsInGameThread(), TEXT("Flecs worlds must be created on the game thread"));
+		
+		TArray<FFlecsDefaultMetaEntity> DefaultEntities = FFlecsDefaultEntityEngine::Get().AddedDefaultEntities;
+		TMap<FString, flecs::entity_t> DefaultEntityIds = FFlecsDefaultEntityEngine::Get().DefaultEntityOptions;
 
-		TSet<FName> ProcessedTags;
+		UFlecsWorld* NewFlecsWorld = NewObject<UFlecsWorld>(this, static_cast<FName>(Name));
+
+		if (bDefaultWorld)
+		{
+			DefaultWorld = NewFlecsWorld;
+		}
 		
-		for (const TTuple<FGameplayTag, TArray<FGameplayTag>>& Pair : TagHierarchy)
+		NewFlecsWorld->SetContext(this);
+
+		if (InTemplateWorld)
+		{
+			NewFlecsWorld->CopyFromTemplate(InTemplateWorld);
+		}
+
+		NewFlecsWorld->SetSingleton<FFlecsWorldPtrComponent>(FFlecsWorldPtrComponent{ NewFlecsWorld });
+		NewFlecsWorld->SetSingleton<FUWorldPtrComponent>(FUWorldPtrComponent{ GetWorld() });
+
+		// Default components and entities are copied from the template
+		if (!InTemplateWorld)
 		{
-			if (!Pair.Key.IsValid())
+			NewFlecsWorld->InitializeDefaultComponents();
+
+			for (int32 Index = 0; Index < DefaultEntities.Num(); ++Index)
 			{
-				continue;
-			}
+				FString EntityName = DefaultEntities[Index].EntityRecord.Name;
+				const flecs::entity_t EntityId = DefaultEntityIds[EntityName];
+
+				#if WITH_EDITOR
+			
+				FFlecsEntityHandle NewEntity =
+				
+				#endif // WITH_EDITOR
+				
+				NewFlecsWorld->CreateEntityWithRecordWithId(DefaultEntities[Index].EntityRecord, EntityId);
+
+				UN_LOGF(LogFlecsCore, Log,
+					"Created default entity %s with id %d", *EntityName, EntityId);
 			
-			RegisterGameplayTagEntityRecursively(Pair.Key, InFlecsWorld, TagHierarchy, ProcessedTags);
+				UN_LOGF(LogFlecsCore, Log,
+					"Entity %s with id %d", *NewEntity.GetName(), NewEntity.GetId());
+			}
 		}
-	}
 
-	void BuildTagHierarchyMap(TMap<FGameplayTag, TArray<FGameplayTag>>& InTagHierarchy)
-	{
-		FGameplayTagContainer AllTags;
-		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, false);
+		NewFlecsWorld->SetWorldName(Name);
 
-		for (const FGameplayTag& Tag : AllTags)
+		// Grouped worlds get their threads from the group
+		if (bDefaultWorld)
 		{
-			if (FGameplayTag ParentTag = Tag.RequestDirectParent(); ParentTag.IsValid())
+			if (DeveloperSettings->bUseTaskThreads)
 			{
-				InTagHierarchy.FindOrAdd(ParentTag).Add(Tag);
+				NewFlecsWorld->SetTaskThreads(DeveloperSettings->TaskThreadCount);
 			}
 			else
 			{
-				InTagHierarchy.FindOrAdd(Tag);
+				NewFlecsWorld->SetThreads(std::thread::hardware_concurrency());
 			}
 		}
-	}
 
-	FFlecsEntityHandle RegisterGameplayTagEntityRecursively(const FGameplayTag& Tag, UFlecsWorld* NewFlecsWorld,
-		const TMap<FGameplayTag, TArray<FGameplayTag>>& TagHierarchy, TSet<FName>& ProcessedTags)
-	{
-		if (ProcessedTags.Contains(Tag.GetTagName()))
+		if (DeveloperSettings->bUseTraversalCache)
 		{
-			return FFlecsEntityHandle();
+			NewFlecsWorld->EnableTraversalCache(true);
 		}
-		
-		ProcessedTags.Add(Tag.GetTagName());
 
-		const FString LastPartOfTagName = ExtractLastPartOfTagName(Tag.GetTagName().ToString());
-
-		const FFlecsEntityHandle TagEntity = NewFlecsWorld->CreateEntity(LastPartOfTagName);
-		
-		TagEntity.Set<FGameplayTag>(Tag);
-		
-		if (const TArray<FGameplayTag>* Children = TagHierarchy.Find(Tag))
+		if (DeveloperSettings->bReflectTypesOnRegistration)
 		{
-			for (const FGameplayTag& ChildTag : *Children)
-			{
-				FFlecsEntityHandle ChildEntity = RegisterGameplayTagEntityRecursively(ChildTag, NewFlecsWorld,
-					TagHierarchy, ProcessedTags);
-				
-				ChildEntity.SetParent(TagEntity);
-			}
+			NewFlecsWorld->EnableTypeReflection();
 		}
 
-		return TagEntity;
-	}
+		NewFlecsWorld->WorldBeginPlay(InTemplateWorld != nullptr);
 
-	FString ExtractLastPartOfTagName(const FString& FullTagName)
-	{
-		if (FullTagName.IsEmpty())
+		if (!InTemplateWorld)
 		{
-			return FString();
+			RegisterAllGameplayTags(NewFlecsWorld);
 		}
 
-		if (int32 LastDotIndex; FullTagName.FindLastChar(TEXT('.'), LastDotIndex))
+		for (UObject* Module : Settings.Modules)
 		{
-			return FullTagName.RightChop(LastDotIndex + 1);
+			solid_checkf(Module->GetClass()->ImplementsInterface(UFlecsModuleInterface::StaticClass()),
+				TEXT("Module %s does not implement UFlecsModuleInterface"), *Module->GetName());
+			
+			NewFlecsWorld->ImportModule(Module);
 		}
 		
-		return FullTagName;
+		OnWorldCreated.Broadcast(NewFlecsWorld);
+		
+		return NewFlecsWorld;
+	}
+
+	void RegisterAllGameplayTags(UFlecsWorld* InFlecsWorld)
+	{
+		TMap<FGameplayTag, TArray<FGameplayTag>> TagHierarchy;
+		BuildTagHierarchyMap(TagHierarchy);
+
+		InFlecsWorld->RegisterGameplayTagHierarchy(TagHierarchy);
+	}
+
+	void BuildTagHierarchyMap(TMap<FGameplayTag, TArray<FGameplayTag>>& InTagHierarchy)
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, false);
+
+		for (const FGameplayTag& Tag : AllTags)
+		{
+			if (FGameplayTag ParentTag = Tag.RequestDirectParent(); ParentTag.IsValid())
+			{
+				InTagHierarchy.FindOrAdd(ParentTag).Add(Tag);
+			}
+			else
+			{
+				InTagHierarchy.FindOrAdd(Tag);
+			}
+		}
 	}
 	
 }; // class UFlecsWorldSubsystem
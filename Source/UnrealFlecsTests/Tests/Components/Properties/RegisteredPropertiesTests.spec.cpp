@@ -12,6 +12,8 @@ BEGIN_DEFINE_SPEC(FRegisteredPropertiesTestsSpec,
 
 FFlecsTestFixture Fixture;
 
+FFlecsEntityHandle RegisteredType;
+
 END_DEFINE_SPEC(FRegisteredPropertiesTestsSpec);
 
 void FRegisteredPropertiesTestsSpec::Define()
@@ -143,6 +145,48 @@ void FRegisteredPropertiesTestsSpec::Define()
 				TestType.Has(flecs::PairIsTag));
 		});
 	});
+
+	Describe("Type Reflection", [this]()
+	{
+		BeforeEach([this]()
+		{
+			RegisteredType
+				= Fixture.FlecsWorld->ObtainComponentTypeStruct(FTestRegisteredPropertyStruct2_RegisterPropertyTest::StaticStruct());
+		});
+
+		AfterEach([this]()
+		{
+			RegisteredType = FFlecsEntityHandle();
+		});
+
+		It("Should build members only when reflection is requested",
+			[this]()
+		{
+			if (!Fixture.FlecsWorld->IsTypeReflectionEnabled())
+			{
+				TestFalse("Members should not be built on registration",
+					RegisteredType.Has<flecs::Struct>());
+			}
+
+			Fixture.FlecsWorld->EnsureTypeReflection(FTestRegisteredPropertyStruct2_RegisterPropertyTest::StaticStruct());
+
+			TestTrue("Members should be built on demand", RegisteredType.Has<flecs::Struct>());
+			TestTrue("Registered properties should be kept",
+				RegisteredType.Has<FTestRegisteredTraitProperty_RegisterPropertyTest>());
+		});
+
+		It("Should build members of registered and new types when reflection is enabled",
+			[this]()
+		{
+			Fixture.FlecsWorld->EnableTypeReflection();
+
+			const FFlecsEntityHandle NewType
+				= Fixture.FlecsWorld->ObtainComponentTypeStruct(FTestRegisteredPropertyStruct3_RegisterPropertyTest::StaticStruct());
+
+			TestTrue("Registered type should be reflected", RegisteredType.Has<flecs::Struct>());
+			TestTrue("New type should be reflected", NewType.Has<flecs::Struct>());
+		});
+	});
 }
 
 
@@ -0,0 +1,53 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Components/FlecsUObjectComponent.h"
+#include "Components/FlecsUObjectPtrCacheComponent.h"
+
+BEGIN_DEFINE_SPEC(FUObjectPtrCacheTestsSpec,
+                  "Flecs.Components.UObjectPtrCache",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+END_DEFINE_SPEC(FUObjectPtrCacheTestsSpec);
+
+void FUObjectPtrCacheTestsSpec::Define()
+{
+	FLECS_FIXTURE_LIFECYCLE(Fixture);
+
+	Describe("UObject Pointer Cache", [this]()
+	{
+		It("Should add and resolve the cache with the object component", [this]()
+		{
+			UObject* Object = NewObject<UObject>();
+
+			const FFlecsEntityHandle TestEntity = Fixture.FlecsWorld->CreateEntity();
+			TestEntity.Set<FFlecsUObjectComponent>(FFlecsUObjectComponent(Object));
+
+			if (TestTrue("Entity should have the pointer cache",
+				TestEntity.Has<FFlecsUObjectPtrCacheComponent>()))
+			{
+				TestEqual("Cached pointer should be the object",
+					TestEntity.Get<FFlecsUObjectPtrCacheComponent>().GetObject(), Object);
+			}
+		});
+
+		It("Should clear the cache when the object is no longer valid", [this]()
+		{
+			UObject* Object = NewObject<UObject>();
+
+			const FFlecsEntityHandle TestEntity = Fixture.FlecsWorld->CreateEntity();
+			TestEntity.Set<FFlecsUObjectComponent>(FFlecsUObjectComponent(Object));
+
+			Object->MarkAsGarbage();
+			Fixture.FlecsWorld->ResolveUObjectPtrCache(true);
+
+			TestFalse("Cached pointer should be cleared",
+				TestEntity.Get<FFlecsUObjectPtrCacheComponent>().IsValid());
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,92 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Tests/Components/Structs/ComponentTestStructs.h"
+
+BEGIN_DEFINE_SPEC(FEntityRecordTestsSpec,
+                  "Flecs.Entity.Record",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+FFlecsEntityRecord Record;
+
+END_DEFINE_SPEC(FEntityRecordTestsSpec);
+
+void FEntityRecordTestsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Fixture.SetUp();
+
+		FFlecsComponentTypeInfo Component;
+		Component.NodeType = EFlecsComponentNodeType::ScriptStruct;
+		Component.ScriptStruct = FInstancedStruct::Make(FUStructTestComponent_RegisterComponentTest{ 1 });
+
+		Record = FFlecsEntityRecord();
+		Record.Components.Add(Component);
+	});
+
+	AfterEach([this]()
+	{
+		Record = FFlecsEntityRecord();
+		Fixture.TearDown();
+	});
+
+	Describe("Entity Record Spawning", [this]()
+	{
+		It("Should create an entity with the record components", [this]()
+		{
+			const FFlecsEntityHandle EntityHandle = Fixture.FlecsWorld->CreateEntityWithRecord(Record);
+			TestTrue("Entity should be valid", EntityHandle.IsValid());
+
+			if (TestTrue("Entity should have the record component",
+				EntityHandle.Has<FUStructTestComponent_RegisterComponentTest>()))
+			{
+				TestEqual("Component value should be copied from the record",
+					EntityHandle.Get<FUStructTestComponent_RegisterComponentTest>().Value, 1);
+			}
+		});
+
+		It("Should create a named entity with the record components", [this]()
+		{
+			Record.Name = TEXT("RecordEntity");
+
+			const FFlecsEntityHandle EntityHandle = Fixture.FlecsWorld->CreateEntityWithRecord(Record);
+			TestTrue("Entity should be valid", EntityHandle.IsValid());
+			TestEqual("Entity name should be RecordEntity", EntityHandle.GetName(), TEXT("RecordEntity"));
+			TestEqual("Component value should be copied from the record",
+				EntityHandle.Get<FUStructTestComponent_RegisterComponentTest>().Value, 1);
+		});
+
+		It("Should reuse the compiled record for records with the same layout", [this]()
+		{
+			const FFlecsEntityHandle FirstEntity = Fixture.FlecsWorld->CreateEntityWithRecord(Record);
+
+			Record.Components[0].ScriptStruct.GetMutable<FUStructTestComponent_RegisterComponentTest>().Value = 2;
+			const FFlecsEntityHandle SecondEntity = Fixture.FlecsWorld->CreateEntityWithRecord(Record);
+
+			TestTrue("Entities should share a table", FirstEntity.GetType() == SecondEntity.GetType());
+			TestEqual("First entity should keep its value",
+				FirstEntity.Get<FUStructTestComponent_RegisterComponentTest>().Value, 1);
+			TestEqual("Second entity should have its own value",
+				SecondEntity.Get<FUStructTestComponent_RegisterComponentTest>().Value, 2);
+		});
+
+		It("Should create entities in bulk with the record components", [this]()
+		{
+			const TArray<FFlecsEntityHandle> Entities = Fixture.FlecsWorld->CreateEntitiesWithRecord(Record, 16);
+			TestEqual("Should create 16 entities", Entities.Num(), 16);
+
+			for (const FFlecsEntityHandle& EntityHandle : Entities)
+			{
+				TestTrue("Entity should be valid", EntityHandle.IsValid());
+				TestEqual("Component value should be copied from the record",
+					EntityHandle.Get<FUStructTestComponent_RegisterComponentTest>().Value, 1);
+			}
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,113 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Components/FlecsActorTag.h"
+#include "Components/FlecsUObjectComponent.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/FlecsGameFrameworkModule.h"
+#include "Transforms/FlecsTransformComponents.h"
+#include "Transforms/FlecsTransformModule.h"
+
+BEGIN_DEFINE_SPEC(FActorTransformSyncTestsSpec,
+                  "Flecs.GameFramework.ActorTransformSync",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+TArray<AActor*> Actors;
+TArray<FFlecsEntityHandle> Entities;
+
+const UFlecsGameFrameworkModule* Module = nullptr;
+
+static constexpr int32 ActorCount = 5000;
+
+END_DEFINE_SPEC(FActorTransformSyncTestsSpec);
+
+void FActorTransformSyncTestsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Fixture.SetUp({ NewObject<UFlecsTransformModule>(), NewObject<UFlecsGameFrameworkModule>() });
+		Module = Fixture.FlecsWorld->GetModule<UFlecsGameFrameworkModule>();
+
+		for (int32 Index = 0; Index < ActorCount; ++Index)
+		{
+			AActor* Actor = Fixture.TestWorld->SpawnActor<AActor>();
+
+			USceneComponent* RootComponent = NewObject<USceneComponent>(Actor);
+			Actor->SetRootComponent(RootComponent);
+			RootComponent->RegisterComponent();
+
+			const FFlecsEntityHandle Entity = Fixture.FlecsWorld->CreateEntity();
+			Entity.Set<FFlecsUObjectComponent>(FFlecsUObjectComponent(Actor));
+			Entity.AddPair<FFlecsActorTag, FFlecsUObjectComponent>();
+			Entity.Set<FFlecsRelativeTransformComponent>(FTransform(FVector(Index, 0.0, 0.0)));
+
+			Actors.Add(Actor);
+			Entities.Add(Entity);
+		}
+	});
+
+	AfterEach([this]()
+	{
+		Module = nullptr;
+		Actors.Reset();
+		Entities.Reset();
+		Fixture.TearDown();
+	});
+
+	Describe("Actor Transform Sync", [this]()
+	{
+		It("Should move actors to the world transform of their entity", [this]()
+		{
+			Fixture.FlecsWorld->Progress();
+
+			for (int32 Index = 0; Index < Actors.Num(); ++Index)
+			{
+				TestEqual("Actor should be at the location of its entity",
+					Actors[Index]->GetActorLocation(), FVector(Index, 0.0, 0.0));
+			}
+		});
+
+		It("Should only move actors whose transform changed", [this]()
+		{
+			Fixture.FlecsWorld->Progress();
+			TestEqual("All actors should be moved once", Module->GetNumSyncedActorTransforms(), ActorCount);
+
+			Fixture.FlecsWorld->Progress();
+			TestEqual("Unchanged actors should not be moved", Module->GetNumSyncedActorTransforms(), 0);
+
+			Entities[3].Set<FFlecsRelativeTransformComponent>(FTransform(FVector(0.0, 100.0, 0.0)));
+
+			Fixture.FlecsWorld->Progress();
+			TestEqual("Only the changed actor should be moved", Module->GetNumSyncedActorTransforms(), 1);
+			TestEqual("Changed actor should be at its new location",
+				Actors[3]->GetActorLocation(), FVector(0.0, 100.0, 0.0));
+		});
+
+		It("Should sync several thousand actors", [this]()
+		{
+			Fixture.FlecsWorld->Progress();
+
+			for (int32 Index = 0; Index < ActorCount; ++Index)
+			{
+				Entities[Index].Set<FFlecsRelativeTransformComponent>(
+					FTransform(FRotator(0.0, Index, 0.0), FVector(Index, Index, 0.0)));
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			Fixture.FlecsWorld->Progress();
+			const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			AddInfo(FString::Printf(TEXT("Synced %d actor transforms in %.2f ms"),
+				Module->GetNumSyncedActorTransforms(), ElapsedMs));
+
+			TestEqual("All actors should be moved", Module->GetNumSyncedActorTransforms(), ActorCount);
+			TestEqual("Last actor should be at the location of its entity",
+				Actors.Last()->GetActorLocation(), FVector(ActorCount - 1, ActorCount - 1, 0.0));
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,140 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "NativeGameplayTags.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "GameplayTags/FlecsGameplayTagIndex.h"
+
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_FlecsTest, "FlecsTest");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_FlecsTest_Parent, "FlecsTest.Parent");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_FlecsTest_Parent_Child, "FlecsTest.Parent.Child");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_FlecsTest_Unrelated, "FlecsTest.Unrelated");
+
+BEGIN_DEFINE_SPEC(FGameplayTagIntervalTestsSpec,
+                  "Flecs.GameplayTags.Interval",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+// A(0, 3) -> B(1, 2) -> C(2, 2), D(3, 3)
+FFlecsGameplayTagInterval A;
+FFlecsGameplayTagInterval B;
+FFlecsGameplayTagInterval C;
+FFlecsGameplayTagInterval D;
+
+TArray<int32> PreOrders;
+
+FFlecsTestFixture Fixture;
+
+END_DEFINE_SPEC(FGameplayTagIntervalTestsSpec);
+
+void FGameplayTagIntervalTestsSpec::Define()
+{
+	Describe("Gameplay Tag Interval", [this]()
+	{
+		BeforeEach([this]()
+		{
+			A = FFlecsGameplayTagInterval(0, 3);
+			B = FFlecsGameplayTagInterval(1, 2);
+			C = FFlecsGameplayTagInterval(2, 2);
+			D = FFlecsGameplayTagInterval(3, 3);
+
+			PreOrders = { 1, 4, 7, 9, 12, 15, 18 };
+		});
+
+		It("Should contain itself and its descendants", [this]()
+		{
+			TestTrue("A should contain itself", A.Contains(A));
+			TestTrue("A should contain C", A.Contains(C));
+			TestTrue("B should contain C", B.Contains(C));
+			TestFalse("B should not contain D", B.Contains(D));
+			TestFalse("C should not contain B", C.Contains(B));
+		});
+
+		It("Should find pre-orders inside of an interval", [this]()
+		{
+			TestTrue("Should find 18 in the scalar tail",
+				FFlecsGameplayTagIndex::AnyPreOrderWithin(PreOrders.GetData(), PreOrders.Num(),
+					FFlecsGameplayTagInterval(17, 20)));
+			TestTrue("Should find 7 in the vectorized part",
+				FFlecsGameplayTagIndex::AnyPreOrderWithin(PreOrders.GetData(), PreOrders.Num(),
+					FFlecsGameplayTagInterval(5, 8)));
+			TestFalse("Should not find anything between 10 and 11",
+				FFlecsGameplayTagIndex::AnyPreOrderWithin(PreOrders.GetData(), PreOrders.Num(),
+					FFlecsGameplayTagInterval(10, 11)));
+		});
+	});
+
+	Describe("Gameplay Tag Index", [this]()
+	{
+		BeforeEach([this]()
+		{
+			Fixture.SetUp();
+
+			// Rebuild the index with only the test tags, so the intervals don't depend on the project tags
+			TMap<FGameplayTag, TArray<FGameplayTag>> TagHierarchy;
+			TagHierarchy.Add(TAG_FlecsTest, { TAG_FlecsTest_Parent, TAG_FlecsTest_Unrelated });
+			TagHierarchy.Add(TAG_FlecsTest_Parent, { TAG_FlecsTest_Parent_Child });
+			TagHierarchy.Add(TAG_FlecsTest_Parent_Child, {});
+			TagHierarchy.Add(TAG_FlecsTest_Unrelated, {});
+
+			Fixture.FlecsWorld->RegisterGameplayTagHierarchy(TagHierarchy);
+		});
+
+		AfterEach([this]()
+		{
+			Fixture.TearDown();
+		});
+
+		It("Should create an entity for every tag of the hierarchy", [this]()
+		{
+			TestEqual("Every tag should be indexed", Fixture.FlecsWorld->GetTagIndex().Num(), 4);
+
+			const FFlecsEntityHandle ParentEntity = Fixture.FlecsWorld->GetTagEntity(TAG_FlecsTest_Parent);
+			const FFlecsEntityHandle ChildEntity = Fixture.FlecsWorld->GetTagEntity(TAG_FlecsTest_Parent_Child);
+
+			TestTrue("Parent tag entity should be alive", ParentEntity.IsAlive());
+			TestTrue("Child tag entity should be alive", ChildEntity.IsAlive());
+			TestEqual("Child tag entity should be named after the last part of its tag",
+				ChildEntity.GetName(), TEXT("Child"));
+			TestTrue("Child tag entity should be a child of the parent tag entity",
+				ChildEntity.GetParent() == ParentEntity);
+			TestTrue("Tag entity should store its tag",
+				ChildEntity.Get<FGameplayTag>() == TAG_FlecsTest_Parent_Child.GetTag());
+		});
+
+		It("Should test whether a tag is under another tag", [this]()
+		{
+			const UFlecsWorld* FlecsWorld = Fixture.FlecsWorld.Get();
+
+			TestTrue("Child should be under its parent",
+				FlecsWorld->IsTagUnder(TAG_FlecsTest_Parent_Child, TAG_FlecsTest_Parent));
+			TestTrue("Child should be under the root",
+				FlecsWorld->IsTagUnder(TAG_FlecsTest_Parent_Child, TAG_FlecsTest));
+			TestTrue("Tag should be under itself",
+				FlecsWorld->IsTagUnder(TAG_FlecsTest_Parent, TAG_FlecsTest_Parent));
+			TestFalse("Child should not be under an unrelated tag",
+				FlecsWorld->IsTagUnder(TAG_FlecsTest_Parent_Child, TAG_FlecsTest_Unrelated));
+			TestFalse("Parent should not be under its child",
+				FlecsWorld->IsTagUnder(TAG_FlecsTest_Parent, TAG_FlecsTest_Parent_Child));
+		});
+
+		It("Should test whether an entity has a tag under another tag", [this]()
+		{
+			const FFlecsEntityHandle TestEntity = Fixture.FlecsWorld->CreateEntity();
+			TestEntity.Add(TAG_FlecsTest_Parent_Child);
+
+			TestTrue("Entity should have a tag under the parent",
+				Fixture.FlecsWorld->HasTagUnder(TestEntity, TAG_FlecsTest_Parent));
+			TestTrue("Entity should have a tag under the root",
+				Fixture.FlecsWorld->HasTagUnder(TestEntity, TAG_FlecsTest));
+			TestFalse("Entity should not have a tag under an unrelated tag",
+				Fixture.FlecsWorld->HasTagUnder(TestEntity, TAG_FlecsTest_Unrelated));
+
+			TestEntity.Remove(TAG_FlecsTest_Parent_Child);
+
+			TestFalse("Entity without tags should not have a tag under the root",
+				Fixture.FlecsWorld->HasTagUnder(TestEntity, TAG_FlecsTest));
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,120 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Libraries/EntityBatchFunctionLibrary.h"
+#include "Tests/Components/Structs/ComponentTestStructs.h"
+
+BEGIN_DEFINE_SPEC(FEntityBatchFunctionLibraryTestsSpec,
+                  "Flecs.Libraries.EntityBatch",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+TArray<FFlecsEntityHandle> Entities;
+FFlecsQueryDefinition Definition;
+
+static constexpr int32 EntityCount = 8;
+
+END_DEFINE_SPEC(FEntityBatchFunctionLibraryTestsSpec);
+
+void FEntityBatchFunctionLibraryTestsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Fixture.SetUp();
+
+		for (int32 Index = 0; Index < EntityCount; ++Index)
+		{
+			Entities.Add(Fixture.FlecsWorld->CreateEntity());
+		}
+
+		FFlecsQueryTermExpression Term;
+		Term.InputType.Type = EFlecsQueryInputType::ScriptStruct;
+		Term.InputType.ScriptStruct = FUStructTestComponent_RegisterComponentTest::StaticStruct();
+
+		Definition = FFlecsQueryDefinition();
+		Definition.Terms.Add(Term);
+	});
+
+	AfterEach([this]()
+	{
+		Entities.Reset();
+		Definition = FFlecsQueryDefinition();
+		Fixture.TearDown();
+	});
+
+	Describe("Entity Batch Function Library", [this]()
+	{
+		It("Should add and remove a component on all entities", [this]()
+		{
+			UScriptStruct* ComponentType = FUStructTestComponent_RegisterComponentTest::StaticStruct();
+
+			UEntityBatchFunctionLibrary::AddComponentToEntities(Fixture.FlecsWorld.Get(), Entities, ComponentType);
+
+			TestEqual("Query should return every entity",
+				UEntityBatchFunctionLibrary::GetQueryEntities(Fixture.FlecsWorld.Get(), Definition).Num(), EntityCount);
+
+			UEntityBatchFunctionLibrary::RemoveComponentFromEntities(Fixture.FlecsWorld.Get(), Entities, ComponentType);
+
+			TestEqual("Query should not return any entity",
+				UEntityBatchFunctionLibrary::GetQueryEntities(Fixture.FlecsWorld.Get(), Definition).Num(), 0);
+		});
+
+		It("Should set and get component values of all entities", [this]()
+		{
+			TArray<FInstancedStruct> Values;
+
+			for (int32 Index = 0; Index < Entities.Num(); ++Index)
+			{
+				FUStructTestComponent_RegisterComponentTest Value;
+				Value.Value = Index;
+				Values.Add(FInstancedStruct::Make(Value));
+			}
+
+			UEntityBatchFunctionLibrary::SetComponentInstancedStructs(Fixture.FlecsWorld.Get(), Entities, Values);
+
+			// Query order is table order, which is the order in which the entities got the component
+			const TArray<FFlecsEntityHandle> QueryEntities
+				= UEntityBatchFunctionLibrary::GetQueryEntities(Fixture.FlecsWorld.Get(), Definition);
+
+			TArray<FInstancedStruct> OutValues;
+			UEntityBatchFunctionLibrary::GetComponentInstancedStructs(Fixture.FlecsWorld.Get(), QueryEntities,
+				FUStructTestComponent_RegisterComponentTest::StaticStruct(), OutValues);
+
+			if (TestEqual("Should get a value per entity", OutValues.Num(), Entities.Num()))
+			{
+				for (int32 Index = 0; Index < OutValues.Num(); ++Index)
+				{
+					TestEqual("Value should match the value of the entity",
+						OutValues[Index].Get<FUStructTestComponent_RegisterComponentTest>().Value,
+						QueryEntities[Index].Get<FUStructTestComponent_RegisterComponentTest>().Value);
+				}
+			}
+		});
+
+		It("Should default initialize values of entities without the component", [this]()
+		{
+			FUStructTestComponent_RegisterComponentTest Value;
+			Value.Value = 42;
+			Entities[0].Set<FUStructTestComponent_RegisterComponentTest>(Value);
+
+			TArray<FInstancedStruct> OutValues;
+			UEntityBatchFunctionLibrary::GetComponentInstancedStructs(Fixture.FlecsWorld.Get(), Entities,
+				FUStructTestComponent_RegisterComponentTest::StaticStruct(), OutValues);
+
+			if (TestEqual("Should get a value per entity", OutValues.Num(), EntityCount))
+			{
+				TestEqual("First value should be set",
+					OutValues[0].Get<FUStructTestComponent_RegisterComponentTest>().Value, 42);
+
+				for (int32 Index = 1; Index < OutValues.Num(); ++Index)
+				{
+					TestTrue("Other values should be valid", OutValues[Index].IsValid());
+				}
+			}
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,95 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Physics/FlecsPhysicsBodyComponent.h"
+#include "Physics/FlecsPhysicsModule.h"
+#include "Ticker/FlecsTickerModule.h"
+#include "Transforms/FlecsTransformComponents.h"
+
+// Nothing is rendered, the spec runs in a headless -nullrhi session
+BEGIN_DEFINE_SPEC(FPhysicsBodySyncTestsSpec,
+                  "Flecs.Physics.BodySync",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext
+                  | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+USphereComponent* Body = nullptr;
+FFlecsEntityHandle BodyEntity;
+
+static constexpr int32 FrameCount = 30;
+static constexpr float FrameDeltaTime = 1.0f / 60.0f;
+
+END_DEFINE_SPEC(FPhysicsBodySyncTestsSpec);
+
+void FPhysicsBodySyncTestsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Fixture.SetUp({ NewObject<UFlecsTickerModule>(), NewObject<UFlecsPhysicsModule>() });
+		Fixture.TestWorld->bShouldSimulatePhysics = true;
+
+		AActor* Actor = Fixture.TestWorld->SpawnActor<AActor>();
+
+		Body = NewObject<USphereComponent>(Actor);
+		Body->SetSphereRadius(50.0f);
+		Body->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+		Body->SetWorldLocation(FVector(0.0, 0.0, 1000.0));
+		Actor->SetRootComponent(Body);
+		Body->RegisterComponent();
+		Body->SetSimulatePhysics(true);
+
+		BodyEntity = Fixture.FlecsWorld->CreateEntity();
+		BodyEntity.Set<FFlecsPhysicsBodyComponent>(
+			FFlecsPhysicsBodyComponent(Body->GetBodyInstance()->GetPhysicsActorHandle()));
+		BodyEntity.Set<FFlecsLocationComponent>(FFlecsLocationComponent(FVector(0.0, 0.0, 1000.0)));
+		BodyEntity.Set<FFlecsRotationComponent>(FFlecsRotationComponent(FRotator::ZeroRotator));
+	});
+
+	AfterEach([this]()
+	{
+		Body = nullptr;
+		BodyEntity = FFlecsEntityHandle();
+		Fixture.TearDown();
+	});
+
+	Describe("Physics Body Sync", [this]()
+	{
+		It("Should pull the pose of simulated bodies into their entity", [this]()
+		{
+			for (int32 Frame = 0; Frame < FrameCount; ++Frame)
+			{
+				Fixture.TestWorld->Tick(LEVELTICK_All, FrameDeltaTime);
+				Fixture.FlecsWorld->Progress(FrameDeltaTime);
+			}
+
+			const FVector BodyLocation = Body->GetBodyInstance()->GetUnrealWorldTransform().GetLocation();
+			const FVector EntityLocation = BodyEntity.Get<FFlecsLocationComponent>().Location;
+
+			TestTrue("Body should fall", BodyLocation.Z < 1000.0);
+			TestTrue("Entity should be at the location of its body", EntityLocation.Equals(BodyLocation, 0.1));
+		});
+
+		It("Should push the location of kinematic entities to their body", [this]()
+		{
+			Body->SetSimulatePhysics(false);
+			BodyEntity.Add<FFlecsPhysicsKinematicTag>();
+			BodyEntity.Set<FFlecsLocationComponent>(FFlecsLocationComponent(FVector(500.0, 0.0, 1000.0)));
+
+			for (int32 Frame = 0; Frame < FrameCount; ++Frame)
+			{
+				Fixture.FlecsWorld->Progress(FrameDeltaTime);
+				Fixture.TestWorld->Tick(LEVELTICK_All, FrameDeltaTime);
+			}
+
+			TestTrue("Body should be at the location of its entity",
+				Body->GetBodyInstance()->GetUnrealWorldTransform().GetLocation().Equals(
+					FVector(500.0, 0.0, 1000.0), 1.0));
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
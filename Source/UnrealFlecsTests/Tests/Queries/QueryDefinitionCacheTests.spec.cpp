@@ -0,0 +1,100 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Queries/FlecsQueryDefinition.h"
+#include "Tests/Components/Structs/ComponentTestStructs.h"
+
+BEGIN_DEFINE_SPEC(FQueryDefinitionCacheTestsSpec,
+                  "Flecs.Queries.DefinitionCache",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+FFlecsQueryDefinition Definition;
+FFlecsQueryDefinition WithoutDefinition;
+
+END_DEFINE_SPEC(FQueryDefinitionCacheTestsSpec);
+
+void FQueryDefinitionCacheTestsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Fixture.SetUp();
+
+		FFlecsQueryTermExpression Term;
+		Term.InputType.Type = EFlecsQueryInputType::ScriptStruct;
+		Term.InputType.ScriptStruct = FUStructTestComponent_RegisterComponentTest::StaticStruct();
+
+		Definition = FFlecsQueryDefinition();
+		Definition.Terms.Add(Term);
+
+		Term.bWithout = true;
+
+		WithoutDefinition = FFlecsQueryDefinition();
+		WithoutDefinition.Terms.Add(Term);
+	});
+
+	AfterEach([this]()
+	{
+		Definition = FFlecsQueryDefinition();
+		WithoutDefinition = FFlecsQueryDefinition();
+		Fixture.TearDown();
+	});
+
+	Describe("Query Definition Cache", [this]()
+	{
+		It("Should share the query of identical definitions", [this]()
+		{
+			const FFlecsQuery FirstQuery = Fixture.FlecsWorld->ObtainQuery(Definition);
+			const FFlecsQuery SecondQuery = Fixture.FlecsWorld->ObtainQuery(Definition);
+
+			TestTrue("Queries should be the same", FirstQuery == SecondQuery);
+		});
+
+		It("Should not share the query of different definitions", [this]()
+		{
+			const FFlecsQuery FirstQuery = Fixture.FlecsWorld->ObtainQuery(Definition);
+			const FFlecsQuery SecondQuery = Fixture.FlecsWorld->ObtainQuery(WithoutDefinition);
+
+			TestTrue("Queries should be different", FirstQuery != SecondQuery);
+		});
+
+		It("Should match entities with the definition terms", [this]()
+		{
+			const FFlecsEntityHandle TestEntity = Fixture.FlecsWorld->CreateEntity();
+			TestEntity.Add<FUStructTestComponent_RegisterComponentTest>();
+
+			const FFlecsQuery Query = Fixture.FlecsWorld->ObtainQuery(Definition);
+			TestTrue("Query should have matches", Query.HasMatches());
+		});
+
+		It("Should destruct the query with the last reference", [this]()
+		{
+			const FFlecsQuery FirstQuery = Fixture.FlecsWorld->ObtainQuery(Definition);
+			const FFlecsQuery SecondQuery = Fixture.FlecsWorld->ObtainQuery(Definition);
+
+			TestFalse("Query should not be destructed with a reference left",
+				Fixture.FlecsWorld->ReleaseQuery(FirstQuery));
+			TestTrue("Query should be destructed with the last reference",
+				Fixture.FlecsWorld->ReleaseQuery(SecondQuery));
+		});
+
+		It("Should drop queries deleted outside of the cache", [this]()
+		{
+			const FFlecsQuery FirstQuery = Fixture.FlecsWorld->ObtainQuery(Definition);
+			const flecs::entity_t FirstQueryEntity = FirstQuery.GetQueryEntityId();
+
+			FirstQuery.GetEntity().Destroy();
+
+			TestFalse("Deleted query should not be released",
+				Fixture.FlecsWorld->ReleaseQuery(FirstQuery));
+
+			const FFlecsQuery SecondQuery = Fixture.FlecsWorld->ObtainQuery(Definition);
+			TestTrue("Query should be compiled again", SecondQuery.GetQueryEntityId() != FirstQueryEntity);
+			TestTrue("Query should be alive", Fixture.FlecsWorld->World.is_alive(SecondQuery.GetQueryEntityId()));
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
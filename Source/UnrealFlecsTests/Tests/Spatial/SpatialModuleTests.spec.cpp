@@ -0,0 +1,101 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Spatial/FlecsSpatialModule.h"
+#include "Transforms/FlecsTransformComponents.h"
+
+BEGIN_DEFINE_SPEC(FSpatialModuleTestsSpec,
+                  "Flecs.Spatial.Module",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+const UFlecsSpatialModule* SpatialModule = nullptr;
+TArray<FFlecsEntityHandle> Entities;
+
+static constexpr int32 EntityCount = 16;
+static constexpr double EntitySpacing = 100.0;
+
+END_DEFINE_SPEC(FSpatialModuleTestsSpec);
+
+void FSpatialModuleTestsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Fixture.SetUp({ NewObject<UFlecsSpatialModule>() });
+		SpatialModule = Fixture.FlecsWorld->GetModule<UFlecsSpatialModule>();
+
+		// One entity every EntitySpacing units along the X axis
+		for (int32 Index = 0; Index < EntityCount; ++Index)
+		{
+			const FFlecsEntityHandle Entity = Fixture.FlecsWorld->CreateEntity();
+			Entity.Set<FFlecsLocationComponent>(FFlecsLocationComponent(FVector(Index * EntitySpacing, 0.0, 0.0)));
+			Entities.Add(Entity);
+		}
+
+		Fixture.FlecsWorld->Progress();
+	});
+
+	AfterEach([this]()
+	{
+		SpatialModule = nullptr;
+		Entities.Reset();
+		Fixture.TearDown();
+	});
+
+	Describe("Spatial Module", [this]()
+	{
+		It("Should index every entity with a location", [this]()
+		{
+			TestEqual("Every entity should be indexed", SpatialModule->GetNumIndexedEntities(), EntityCount);
+		});
+
+		It("Should find the entities in a radius", [this]()
+		{
+			TArray<FFlecsEntityHandle> OutEntities;
+			SpatialModule->FindEntitiesInRadius(FVector(500.0, 0.0, 0.0), 150.0, OutEntities);
+
+			TestEqual("Should find 3 entities", OutEntities.Num(), 3);
+			TestTrue("Should find the entity at the center", OutEntities.Contains(Entities[5]));
+			TestTrue("Should find the entity before the center", OutEntities.Contains(Entities[4]));
+			TestTrue("Should find the entity after the center", OutEntities.Contains(Entities[6]));
+		});
+
+		It("Should find the nearest entities sorted by distance", [this]()
+		{
+			TArray<FFlecsEntityHandle> OutEntities;
+			SpatialModule->FindNearestEntities(FVector(1020.0, 0.0, 0.0), 2, OutEntities);
+
+			if (TestEqual("Should find 2 entities", OutEntities.Num(), 2))
+			{
+				TestTrue("Nearest entity should be first", OutEntities[0] == Entities[10]);
+				TestTrue("Second nearest entity should be second", OutEntities[1] == Entities[11]);
+			}
+		});
+
+		It("Should find moved entities after the next update", [this]()
+		{
+			Entities[0].Set<FFlecsLocationComponent>(FFlecsLocationComponent(FVector(0.0, 5000.0, 0.0)));
+
+			Fixture.FlecsWorld->Progress();
+
+			TArray<FFlecsEntityHandle> OutEntities;
+			SpatialModule->FindEntitiesInRadius(FVector(0.0, 5000.0, 0.0), 10.0, OutEntities);
+
+			TestEqual("Should find the moved entity", OutEntities.Num(), 1);
+			TestTrue("Moved entity should be found at its new location", OutEntities.Contains(Entities[0]));
+		});
+
+		It("Should stop indexing deleted entities", [this]()
+		{
+			Entities[0].Destroy();
+
+			Fixture.FlecsWorld->Progress();
+
+			TestEqual("Deleted entity should not be indexed", SpatialModule->GetNumIndexedEntities(), EntityCount - 1);
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
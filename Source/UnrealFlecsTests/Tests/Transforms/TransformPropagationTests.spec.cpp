@@ -0,0 +1,97 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Transforms/FlecsTransformComponents.h"
+#include "Transforms/FlecsTransformModule.h"
+
+BEGIN_DEFINE_SPEC(FTransformPropagationTestsSpec,
+                  "Flecs.Transforms.Propagation",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+FFlecsTestFixture Fixture;
+
+FFlecsEntityHandle Parent;
+FFlecsEntityHandle Child;
+
+END_DEFINE_SPEC(FTransformPropagationTestsSpec);
+
+void FTransformPropagationTestsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Fixture.SetUp({ NewObject<UFlecsTransformModule>() });
+
+		Parent = Fixture.FlecsWorld->CreateEntity();
+		Parent.Set<FFlecsRelativeTransformComponent>(FTransform::Identity);
+
+		Child = Fixture.FlecsWorld->CreateEntity();
+		Child.SetParent(Parent);
+		Child.Set<FFlecsRelativeTransformComponent>(FTransform::Identity);
+	});
+
+	AfterEach([this]()
+	{
+		Parent = FFlecsEntityHandle();
+		Child = FFlecsEntityHandle();
+		Fixture.TearDown();
+	});
+
+	Describe("World Transform Propagation", [this]()
+	{
+		It("Should compute the world transforms of a hierarchy", [this]()
+		{
+			const FTransform ParentTransform(FRotator(0.0, 90.0, 0.0), FVector(100.0, 0.0, 0.0), FVector(2.0));
+			const FTransform ChildTransform(FRotator(0.0, 45.0, 0.0), FVector(10.0, 0.0, 0.0));
+			const FTransform GrandChildTransform(FQuat::Identity, FVector(0.0, 0.0, 5.0), FVector(0.5));
+
+			Parent.Set<FFlecsRelativeTransformComponent>(ParentTransform);
+			Child.Set<FFlecsRelativeTransformComponent>(ChildTransform);
+
+			const FFlecsEntityHandle GrandChild = Fixture.FlecsWorld->CreateEntity();
+			GrandChild.SetParent(Child);
+			GrandChild.Set<FFlecsRelativeTransformComponent>(GrandChildTransform);
+
+			Fixture.FlecsWorld->Progress();
+
+			TestTrue("Parent world transform should be its relative transform",
+				Parent.Get<FFlecsWorldTransformComponent>().GetTransform().Equals(ParentTransform));
+			TestTrue("Child world transform should be relative to the parent",
+				Child.Get<FFlecsWorldTransformComponent>().GetTransform().Equals(ChildTransform * ParentTransform));
+			TestTrue("Grandchild world transform should be relative to the child",
+				GrandChild.Get<FFlecsWorldTransformComponent>().GetTransform()
+					.Equals(GrandChildTransform * ChildTransform * ParentTransform));
+		});
+
+		It("Should update children when the relative transform of a parent changes", [this]()
+		{
+			Parent.Set<FFlecsRelativeTransformComponent>(FTransform(FVector(100.0, 0.0, 0.0)));
+			Child.Set<FFlecsRelativeTransformComponent>(FTransform(FVector(10.0, 0.0, 0.0)));
+
+			Fixture.FlecsWorld->Progress();
+
+			Parent.Set<FFlecsRelativeTransformComponent>(FTransform(FVector(0.0, 200.0, 0.0)));
+
+			Fixture.FlecsWorld->Progress();
+
+			TestEqual("Child world location should follow the parent",
+				Child.Get<FFlecsWorldTransformComponent>().Location, FVector(10.0, 200.0, 0.0));
+		});
+
+		It("Should use the matrix path for negative scales", [this]()
+		{
+			const FTransform ParentTransform(FRotator(0.0, 30.0, 0.0), FVector(0.0, 50.0, 0.0), FVector(-1.0, 1.0, 1.0));
+			const FTransform ChildTransform(FRotator(10.0, 0.0, 0.0), FVector(10.0, 0.0, 0.0));
+
+			Parent.Set<FFlecsRelativeTransformComponent>(ParentTransform);
+			Child.Set<FFlecsRelativeTransformComponent>(ChildTransform);
+
+			Fixture.FlecsWorld->Progress();
+
+			TestTrue("Child world transform should match FTransform multiplication",
+				Child.Get<FFlecsWorldTransformComponent>().GetTransform().Equals(ChildTransform * ParentTransform));
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,189 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Transforms/FlecsTransformComponents.h"
+#include "Worlds/FlecsWorldGroup.h"
+
+BEGIN_DEFINE_SPEC(FFlecsWorldGroupTestsSpec, "Flecs.World.WorldGroup",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	FFlecsTestFixture Fixture;
+
+	UFlecsWorldGroup* CreateGroupWithWorlds(const int32 InWorldCount, const int32 InEntityCount)
+	{
+		UFlecsWorldGroup* WorldGroup = Fixture.WorldSubsystem->CreateWorldGroup(
+			*FString::Printf(TEXT("WorldGroup_%d"), InWorldCount));
+
+		for (int32 WorldIndex = 0; WorldIndex < InWorldCount; ++WorldIndex)
+		{
+			const FString WorldName = FString::Printf(TEXT("GroupWorld_%d_%d"), InWorldCount, WorldIndex);
+
+			FFlecsWorldSettings WorldSettings;
+			WorldSettings.WorldName = WorldName;
+
+			UFlecsWorld* World = Fixture.WorldSubsystem->CreateWorldInGroup(WorldGroup, WorldName, WorldSettings);
+
+			for (int32 EntityIndex = 0; EntityIndex < InEntityCount; ++EntityIndex)
+			{
+				World->CreateEntity().Set<FFlecsLocationComponent>(
+					FFlecsLocationComponent(FVector(static_cast<double>(EntityIndex))));
+			}
+
+			World->CreateSystemWithBuilder<FFlecsLocationComponent>(TEXT("MoveSystem"))
+				.multi_threaded()
+				.each([](FFlecsLocationComponent& Location)
+				{
+					Location.Location = Location.Location.RotateAngleAxis(1.0, FVector::UpVector) + FVector(1.0);
+				});
+		}
+
+		return WorldGroup;
+	}
+
+END_DEFINE_SPEC(FFlecsWorldGroupTestsSpec)
+
+void FFlecsWorldGroupTestsSpec::Define()
+{
+	FLECS_FIXTURE_LIFECYCLE(Fixture);
+
+	Describe("World Group Stepping", [this]()
+	{
+		It("Should progress every world once per step", [this]()
+		{
+			UFlecsWorldGroup* WorldGroup = CreateGroupWithWorlds(4, 0);
+
+			TArray<int32> ProgressCounts;
+			ProgressCounts.SetNumZeroed(WorldGroup->GetNumWorlds());
+
+			for (int32 WorldIndex = 0; WorldIndex < WorldGroup->GetNumWorlds(); ++WorldIndex)
+			{
+				WorldGroup->GetWorlds()[WorldIndex]->CreateSystemWithBuilder<>(TEXT("CountSystem"))
+					.run([&ProgressCounts, WorldIndex](flecs::iter& Iter)
+					{
+						++ProgressCounts[WorldIndex];
+					});
+			}
+
+			for (int32 Step = 0; Step < 3; ++Step)
+			{
+				TestTrue("Step should progress all worlds", WorldGroup->Step(1.0 / 60.0));
+			}
+
+			for (int32 WorldIndex = 0; WorldIndex < ProgressCounts.Num(); ++WorldIndex)
+			{
+				TestEqual("World should be progressed once per step", ProgressCounts[WorldIndex], 3);
+			}
+
+			const FFlecsWorldGroupStats Stats = WorldGroup->GetStats();
+			TestEqual("Stats should count the steps", Stats.StepCount, static_cast<int64>(3));
+			TestEqual("Stats should count the worlds", Stats.NumWorlds, 4);
+			TestTrue("Slowest world should not take longer than the step",
+				Stats.LastMaxWorldTime <= Stats.LastStepTime);
+
+			Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+		});
+
+		It("Should keep thread budgets within the shared workers", [this]()
+		{
+			UFlecsWorldGroup* WorldGroup = CreateGroupWithWorlds(2, 0);
+			WorldGroup->MaxWorkerThreads = 2;
+
+			UFlecsWorld* World = WorldGroup->GetWorlds()[0];
+			WorldGroup->SetThreadBudget(World, 64);
+
+			TestTrue("Budget should not exceed the workers", WorldGroup->GetThreadBudget(World) <= 2);
+			TestTrue("Step should progress all worlds", WorldGroup->Step());
+
+			TestTrue("World should be removed", WorldGroup->RemoveWorld(World));
+			TestEqual("Group should have one world left", WorldGroup->GetNumWorlds(), 1);
+			TestFalse("Removed world should not be found", WorldGroup->RemoveWorld(World));
+
+			World->DestroyWorld();
+			Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+		});
+
+		It("Should run game thread systems on the game thread after the pipeline", [this]()
+		{
+			UFlecsWorldGroup* WorldGroup = CreateGroupWithWorlds(4, 0);
+
+			TArray<int32> PipelineCounts;
+			PipelineCounts.SetNumZeroed(WorldGroup->GetNumWorlds());
+
+			TArray<int32> GameThreadCounts;
+			GameThreadCounts.SetNumZeroed(WorldGroup->GetNumWorlds());
+
+			bool bRanOffGameThread = false;
+			bool bRanBeforePipeline = false;
+
+			for (int32 WorldIndex = 0; WorldIndex < WorldGroup->GetNumWorlds(); ++WorldIndex)
+			{
+				UFlecsWorld* World = WorldGroup->GetWorlds()[WorldIndex];
+
+				World->CreateSystemWithBuilder<>(TEXT("CountSystem"))
+					.run([&PipelineCounts, WorldIndex](flecs::iter& Iter)
+					{
+						++PipelineCounts[WorldIndex];
+					});
+
+				World->AddGameThreadSystem(World->CreateSystemWithBuilder<>(TEXT("GameThreadCountSystem"))
+					.kind(0)
+					.run([&, WorldIndex](flecs::iter& Iter)
+					{
+						bRanOffGameThread |= !IsInGameThread();
+						bRanBeforePipeline |= GameThreadCounts[WorldIndex] >= PipelineCounts[WorldIndex];
+						++GameThreadCounts[WorldIndex];
+					}));
+			}
+
+			for (int32 Step = 0; Step < 3; ++Step)
+			{
+				TestTrue("Step should progress all worlds", WorldGroup->Step(1.0 / 60.0));
+			}
+
+			for (int32 WorldIndex = 0; WorldIndex < GameThreadCounts.Num(); ++WorldIndex)
+			{
+				TestEqual("Game thread system should run once per step", GameThreadCounts[WorldIndex], 3);
+			}
+
+			TestFalse("Game thread systems should only run on the game thread", bRanOffGameThread);
+			TestFalse("Game thread systems should run after the pipeline", bRanBeforePipeline);
+
+			Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+		});
+
+		It("Should scale from 1 to 64 worlds", [this]()
+		{
+			constexpr int32 EntityCount = 4096;
+			constexpr int32 StepCount = 16;
+
+			for (int32 WorldCount = 1; WorldCount <= 64; WorldCount *= 2)
+			{
+				UFlecsWorldGroup* WorldGroup = CreateGroupWithWorlds(WorldCount, EntityCount);
+
+				// Warm up the pipelines and the worker threads
+				WorldGroup->Step(1.0 / 60.0);
+				WorldGroup->ResetStats();
+
+				for (int32 Step = 0; Step < StepCount; ++Step)
+				{
+					WorldGroup->Step(1.0 / 60.0);
+				}
+
+				const FFlecsWorldGroupStats Stats = WorldGroup->GetStats();
+
+				AddInfo(FString::Printf(
+					TEXT("%d worlds of %d entities: %.3f ms per step, %.3f ms per world, parallelism %.2f"),
+					WorldCount, EntityCount, Stats.AverageStepTime * 1000.0,
+					Stats.AverageStepTime * 1000.0 / WorldCount,
+					Stats.LastTotalWorldTime / FMath::Max(Stats.LastStepTime, UE_DOUBLE_SMALL_NUMBER)));
+
+				TestEqual("Every step should be counted", Stats.StepCount, static_cast<int64>(StepCount));
+
+				Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+			}
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
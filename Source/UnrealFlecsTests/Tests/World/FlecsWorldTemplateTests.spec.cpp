@@ -0,0 +1,185 @@
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Fixtures/FlecsWorldFixture.h"
+#include "Transforms/FlecsTransformComponents.h"
+#include "Worlds/FlecsWorldGroup.h"
+
+BEGIN_DEFINE_SPEC(FFlecsWorldTemplateTestsSpec, "Flecs.World.Template",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	FFlecsTestFixture Fixture;
+
+	static void PopulateWorld(const UFlecsWorld* InWorld, const int32 InEntityCount)
+	{
+		for (int32 EntityIndex = 0; EntityIndex < InEntityCount; ++EntityIndex)
+		{
+			InWorld->CreateEntity().Set<FFlecsLocationComponent>(
+				FFlecsLocationComponent(FVector(static_cast<double>(EntityIndex))));
+		}
+	}
+
+END_DEFINE_SPEC(FFlecsWorldTemplateTestsSpec)
+
+void FFlecsWorldTemplateTestsSpec::Define()
+{
+	FLECS_FIXTURE_LIFECYCLE(Fixture);
+
+	Describe("World Templates", [this]()
+	{
+		It("Should copy the entities of the template", [this]()
+		{
+			UFlecsWorld* TemplateWorld = Fixture.WorldSubsystem->CreateTemplateWorld(TEXT("TemplateWorld"));
+
+			const FFlecsEntityHandle Prefab = TemplateWorld->CreatePrefab(TEXT("TemplatePrefab"));
+			Prefab.Set<FFlecsLocationComponent>(FFlecsLocationComponent(FVector(1.0, 2.0, 3.0)));
+
+			const FFlecsEntityHandle Instance = TemplateWorld->CreateEntity(TEXT("TemplateInstance"));
+			Instance.SetParent(Prefab, true);
+
+			UFlecsWorldGroup* WorldGroup = Fixture.WorldSubsystem->CreateWorldGroup(TEXT("TemplateGroup"));
+
+			FFlecsWorldSettings WorldSettings;
+			WorldSettings.WorldName = TEXT("CopiedWorld");
+
+			UFlecsWorld* CopiedWorld = Fixture.WorldSubsystem->CreateWorldInGroupFromTemplate(
+				WorldGroup, TemplateWorld, WorldSettings.WorldName, WorldSettings);
+
+			const FFlecsEntityHandle CopiedInstance = CopiedWorld->LookupEntity(TEXT("TemplateInstance"));
+			TestTrue("Instance should be copied", CopiedInstance.IsValid());
+			TestEqual("Instance should keep its id", CopiedInstance.GetId(), Instance.GetId());
+			TestTrue("Instance should inherit the location", CopiedInstance.Has<FFlecsLocationComponent>());
+			TestEqual("Location should be copied",
+				CopiedInstance.Get<FFlecsLocationComponent>().Location, FVector(1.0, 2.0, 3.0));
+
+			TestEqual("World name should not be copied", CopiedWorld->GetWorldName(), WorldSettings.WorldName);
+			TestTrue("Copied world should progress", WorldGroup->Step(1.0 / 60.0));
+
+			Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+		});
+
+		It("Should not share entities with the template", [this]()
+		{
+			UFlecsWorld* TemplateWorld = Fixture.WorldSubsystem->CreateTemplateWorld(TEXT("TemplateWorld"));
+
+			const FFlecsEntityHandle Entity = TemplateWorld->CreateEntity(TEXT("TemplateEntity"));
+			Entity.Set<FFlecsLocationComponent>(FFlecsLocationComponent(FVector::ZeroVector));
+
+			UFlecsWorldGroup* WorldGroup = Fixture.WorldSubsystem->CreateWorldGroup(TEXT("TemplateGroup"));
+
+			FFlecsWorldSettings WorldSettings;
+			WorldSettings.WorldName = TEXT("CopiedWorld");
+
+			UFlecsWorld* CopiedWorld = Fixture.WorldSubsystem->CreateWorldInGroupFromTemplate(
+				WorldGroup, TemplateWorld, WorldSettings.WorldName, WorldSettings);
+
+			const FFlecsEntityHandle CopiedEntity = CopiedWorld->LookupEntity(TEXT("TemplateEntity"));
+			CopiedEntity.Set<FFlecsLocationComponent>(FFlecsLocationComponent(FVector::OneVector));
+			CopiedWorld->CreateEntity(TEXT("CopiedOnlyEntity"));
+
+			TestEqual("Template value should not change",
+				Entity.Get<FFlecsLocationComponent>().Location, FVector::ZeroVector);
+			TestFalse("Template should not see entities of the copy",
+				TemplateWorld->LookupEntity(TEXT("CopiedOnlyEntity")).IsValid());
+
+			Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+		});
+
+		It("Should copy type reflection of the template", [this]()
+		{
+			UFlecsWorld* TemplateWorld = Fixture.WorldSubsystem->CreateTemplateWorld(TEXT("TemplateWorld"));
+			TemplateWorld->EnableTypeReflection();
+			TemplateWorld->RegisterScriptStruct(FFlecsLocationComponent::StaticStruct());
+
+			UFlecsWorldGroup* WorldGroup = Fixture.WorldSubsystem->CreateWorldGroup(TEXT("TemplateGroup"));
+
+			FFlecsWorldSettings WorldSettings;
+			WorldSettings.WorldName = TEXT("CopiedWorld");
+
+			UFlecsWorld* CopiedWorld = Fixture.WorldSubsystem->CreateWorldInGroupFromTemplate(
+				WorldGroup, TemplateWorld, WorldSettings.WorldName, WorldSettings);
+
+			TestTrue("Type reflection should be enabled", CopiedWorld->IsTypeReflectionEnabled());
+			TestTrue("Members of template types should be copied",
+				CopiedWorld->ObtainComponentTypeStruct(FFlecsLocationComponent::StaticStruct())
+					.Has<flecs::Struct>());
+
+			// Types registered after the copy are reflected like they are in the template
+			const FFlecsEntityHandle RotationComponent
+				= CopiedWorld->RegisterScriptStruct(FFlecsRotationComponent::StaticStruct());
+			TestTrue("Members of new types should be built", RotationComponent.Has<flecs::Struct>());
+
+			Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+		});
+
+		It("Should copy the world settings of the template", [this]()
+		{
+			UFlecsWorld* TemplateWorld = Fixture.WorldSubsystem->CreateTemplateWorld(TEXT("TemplateWorld"));
+			TemplateWorld->EnableTraversalCache(true);
+			TemplateWorld->SetTimeScale(0.5);
+
+			UFlecsWorldGroup* WorldGroup = Fixture.WorldSubsystem->CreateWorldGroup(TEXT("TemplateGroup"));
+
+			FFlecsWorldSettings WorldSettings;
+			WorldSettings.WorldName = TEXT("CopiedWorld");
+
+			UFlecsWorld* CopiedWorld = Fixture.WorldSubsystem->CreateWorldInGroupFromTemplate(
+				WorldGroup, TemplateWorld, WorldSettings.WorldName, WorldSettings);
+
+			TestTrue("Traversal cache should be enabled",
+				(ecs_world_get_flags(CopiedWorld->World.c_ptr()) & EcsWorldTravCache) != 0);
+			TestEqual("Time scale should be copied", CopiedWorld->World.get_info()->time_scale, 0.5f);
+
+			Fixture.WorldSubsystem->DestroyWorldGroup(WorldGroup);
+		});
+
+		It("Should create worlds faster than populating them", [this]()
+		{
+			constexpr int32 EntityCount = 4096;
+			constexpr int32 WorldCount = 16;
+
+			UFlecsWorld* TemplateWorld = Fixture.WorldSubsystem->CreateTemplateWorld(TEXT("TemplateWorld"));
+			PopulateWorld(TemplateWorld, EntityCount);
+
+			UFlecsWorldGroup* PopulatedGroup = Fixture.WorldSubsystem->CreateWorldGroup(TEXT("PopulatedGroup"));
+			UFlecsWorldGroup* CopiedGroup = Fixture.WorldSubsystem->CreateWorldGroup(TEXT("CopiedGroup"));
+
+			double StartTime = FPlatformTime::Seconds();
+
+			for (int32 WorldIndex = 0; WorldIndex < WorldCount; ++WorldIndex)
+			{
+				FFlecsWorldSettings WorldSettings;
+				WorldSettings.WorldName = FString::Printf(TEXT("PopulatedWorld_%d"), WorldIndex);
+
+				PopulateWorld(Fixture.WorldSubsystem->CreateWorldInGroup(
+					PopulatedGroup, WorldSettings.WorldName, WorldSettings), EntityCount);
+			}
+
+			const double PopulatedTime = FPlatformTime::Seconds() - StartTime;
+			StartTime = FPlatformTime::Seconds();
+
+			for (int32 WorldIndex = 0; WorldIndex < WorldCount; ++WorldIndex)
+			{
+				FFlecsWorldSettings WorldSettings;
+				WorldSettings.WorldName = FString::Printf(TEXT("CopiedWorld_%d"), WorldIndex);
+
+				UFlecsWorld* CopiedWorld = Fixture.WorldSubsystem->CreateWorldInGroupFromTemplate(
+					CopiedGroup, TemplateWorld, WorldSettings.WorldName, WorldSettings);
+
+				TestEqual("Copied world should have every entity",
+					CopiedWorld->World.count<FFlecsLocationComponent>(), EntityCount);
+			}
+
+			const double CopiedTime = FPlatformTime::Seconds() - StartTime;
+
+			AddInfo(FString::Printf(
+				TEXT("%d worlds of %d entities: %.3f ms per populated world, %.3f ms per copied world"),
+				WorldCount, EntityCount, PopulatedTime * 1000.0 / WorldCount, CopiedTime * 1000.0 / WorldCount));
+
+			Fixture.WorldSubsystem->DestroyWorldGroup(PopulatedGroup);
+			Fixture.WorldSubsystem->DestroyWorldGroup(CopiedGroup);
+		});
+	});
+}
+
+#endif // WITH_AUTOMATION_TESTS
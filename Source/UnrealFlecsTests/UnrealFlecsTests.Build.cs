@@ -31,6 +31,8 @@ public class UnrealFlecsTests : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "GameplayTags",
+                "PhysicsCore",
                 "Slate",
                 "SlateCore",
             }
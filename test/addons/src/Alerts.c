@@ -2585,3 +2585,303 @@ void Alerts_alert_counts(void) {
 
     ecs_fini(world);
 }
+
+void Alerts_alert_incremental_skip_unchanged(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsAlerts);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_entity(world, { .name = "e1" });
+    ecs_add(world, e1, Position);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "position_without_velocity" }),
+        .query.expr = "Position, !Velocity",
+        .message = "$this: missing velocity"
+    });
+    test_assert(alert != 0);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+    test_assert(ecs_get_alert_count(world, e1, alert) == 1);
+
+    ecs_alert_stats_t stats = {0};
+    test_bool(ecs_alert_stats_get(world, alert, &stats), true);
+    test_bool(stats.incremental, true);
+    int32_t t = stats.query.t;
+    test_int(stats.tables_evaluated.counter.value[t], 1);
+    test_int(stats.tables_skipped.counter.value[t], 0);
+    test_int(stats.instance_count.gauge.avg[t], 1);
+
+    ecs_entity_t ai = ecs_get_alert(world, e1, alert);
+    test_assert(ai != 0);
+
+    /* Adding AlertsActive moved the entity to a new table */
+    ecs_progress(world, 1.0);
+
+    test_bool(ecs_alert_stats_get(world, alert, &stats), true);
+    t = stats.query.t;
+    test_int(stats.tables_evaluated.counter.value[t], 2);
+    test_int(stats.tables_skipped.counter.value[t], 0);
+
+    ecs_progress(world, 1.0);
+
+    /* Nothing changed, table should not have been evaluated */
+    test_bool(ecs_alert_stats_get(world, alert, &stats), true);
+    t = stats.query.t;
+    test_int(stats.tables_evaluated.counter.value[t], 2);
+    test_int(stats.tables_skipped.counter.value[t], 1);
+    test_int(stats.instance_count.gauge.avg[t], 1);
+
+    /* Alert should still be active, and duration should have increased */
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+    test_assert(ecs_get_alert(world, e1, alert) == ai);
+    {
+        const EcsMetricValue *value = ecs_get(world, ai, EcsMetricValue);
+        test_assert(value != NULL);
+        test_flt(value->value, 3.0);
+        const EcsAlertInstance *instance = ecs_get(world, ai, EcsAlertInstance);
+        test_assert(instance != NULL);
+        test_str(instance->message, "e1: missing velocity");
+    }
+
+    ecs_fini(world);
+}
+
+void Alerts_alert_incremental_new_match(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsAlerts);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t e1 = ecs_entity(world, { .name = "e1" });
+    ecs_add(world, e1, Position);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "position_without_velocity" }),
+        .query.expr = "Position, !Velocity"
+    });
+    test_assert(alert != 0);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+    test_assert(ecs_get_alert_count(world, e1, alert) == 1);
+
+    /* Entity in new table */
+    ecs_entity_t e2 = ecs_entity(world, { .name = "e2" });
+    ecs_add(world, e2, Position);
+    ecs_add(world, e2, Tag);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 2);
+    test_assert(ecs_get_alert_count(world, e1, alert) == 1);
+    test_assert(ecs_get_alert_count(world, e2, alert) == 1);
+
+    /* Entity in existing table */
+    ecs_entity_t e3 = ecs_entity(world, { .name = "e3" });
+    ecs_add(world, e3, Position);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 3);
+    test_assert(ecs_get_alert_count(world, e3, alert) == 1);
+
+    ecs_fini(world);
+}
+
+void Alerts_alert_incremental_clear_on_remove(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsAlerts);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_entity(world, { .name = "e1" });
+    ecs_entity_t e2 = ecs_entity(world, { .name = "e2" });
+    ecs_add(world, e1, Position);
+    ecs_add(world, e2, Position);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "position_without_velocity" }),
+        .query.expr = "Position, !Velocity"
+    });
+    test_assert(alert != 0);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 2);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 2);
+
+    ecs_add(world, e1, Velocity);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+    test_assert(!ecs_has(world, e1, EcsAlertsActive));
+    test_assert(ecs_get_alert_count(world, e2, alert) == 1);
+
+    ecs_remove(world, e2, Position);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 0);
+    test_assert(!ecs_has(world, e2, EcsAlertsActive));
+
+    ecs_fini(world);
+}
+
+void Alerts_alert_member_range_not_incremental(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsAlerts);
+
+    ECS_COMPONENT(world, Mass);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Mass),
+        .members = {{ "value", ecs_id(ecs_f32_t), .warning_range = { 0, 100 }}}
+    });
+
+    ecs_entity_t e1 = ecs_entity(world, { .name = "e1" });
+    ecs_set(world, e1, Mass, {50});
+
+    ecs_entity_t member = ecs_lookup(world, "Mass.value");
+    test_assert(member != 0);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "high_mass" }),
+        .query.expr = "Mass",
+        .member = member
+    });
+    test_assert(alert != 0);
+
+    ecs_alert_stats_t stats = {0};
+    test_bool(ecs_alert_stats_get(world, alert, &stats), true);
+    test_bool(stats.incremental, false);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 0);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 0);
+
+    /* Write in place without ecs_modified */
+    *ecs_get_mut(world, e1, Mass) = 150;
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+    test_assert(ecs_get_alert_count(world, e1, alert) == 1);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+    test_assert(ecs_get_alert_count(world, e1, alert) == 1);
+
+    *ecs_get_mut(world, e1, Mass) = 25;
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 0);
+    test_assert(!ecs_has(world, e1, EcsAlertsActive));
+
+    ecs_fini(world);
+}
+
+void Alerts_alert_incremental_retain_period(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsAlerts);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_entity(world, { .name = "e1" });
+    ecs_add(world, e1, Position);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "position_without_velocity" }),
+        .query.expr = "Position, !Velocity",
+        .retain_period = 1.5
+    });
+    test_assert(alert != 0);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+    ecs_entity_t ai = ecs_get_alert(world, e1, alert);
+    test_assert(ai != 0);
+
+    ecs_add(world, e1, Velocity);
+
+    ecs_progress(world, 1.0);
+
+    /* Alert is inactive but retained */
+    test_assert(ecs_is_alive(world, ai));
+    test_assert(ecs_has_id(world, ai, EcsDisabled));
+    test_assert(!ecs_has(world, e1, EcsAlertsActive));
+
+    /* Query didn't change, inactive time of retained alert must advance */
+    ecs_progress(world, 1.0);
+    test_assert(ecs_is_alive(world, ai));
+
+    ecs_progress(world, 1.0);
+    test_assert(!ecs_is_alive(world, ai));
+    test_int(ecs_count(world, EcsAlertInstance), 0);
+
+    ecs_fini(world);
+}
+
+void Alerts_alert_uncached_not_incremental(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsAlerts);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_entity(world, { .name = "e1" });
+    ecs_add(world, e1, Position);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "position_without_velocity" }),
+        .query.expr = "Position, !Velocity",
+        .query.cache_kind = EcsQueryCacheNone
+    });
+    test_assert(alert != 0);
+
+    ecs_progress(world, 1.0);
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 1);
+
+    ecs_alert_stats_t stats = {0};
+    test_bool(ecs_alert_stats_get(world, alert, &stats), true);
+    test_bool(stats.incremental, false);
+    int32_t t = stats.query.t;
+    test_int(stats.tables_evaluated.counter.value[t], 2);
+    test_int(stats.tables_skipped.counter.value[t], 0);
+
+    ecs_add(world, e1, Velocity);
+
+    ecs_progress(world, 1.0);
+
+    test_int(ecs_count(world, EcsAlertInstance), 0);
+
+    ecs_fini(world);
+}
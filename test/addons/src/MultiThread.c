@@ -1394,3 +1394,121 @@ void MultiThread_run_single_thread_on_main(void) {
 
     ecs_fini(world);
 }
+
+typedef struct ThreadDtor {
+    int32_t *dtor_count;
+} ThreadDtor;
+
+static ECS_COMPONENT_DECLARE(ThreadDtor);
+
+static int thread_dtor_worker_count = 0;
+
+static
+void ThreadDtor_dtor(void *ptr, int32_t count, const ecs_type_info_t *ti) {
+    ThreadDtor *data = ptr;
+    for (int i = 0; i < count; i ++) {
+        if (data[i].dtor_count) {
+            data[i].dtor_count[0] ++;
+        }
+    }
+
+    if (main_thread != ecs_os_thread_self()) {
+        ecs_os_ainc(&thread_dtor_worker_count);
+    }
+}
+
+static
+ecs_world_t* thread_dtor_init(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT_DEFINE(world, ThreadDtor);
+    ecs_set_hooks(world, ThreadDtor, {
+        .ctor = flecs_default_ctor,
+        .dtor = ThreadDtor_dtor,
+        .flags = ECS_TYPE_HOOK_DTOR_THREAD_SAFE
+    });
+
+    ecs_enable_threaded_dtors(world, true);
+    set_worker_kind(world, 4);
+
+    main_thread = ecs_os_thread_self();
+    thread_dtor_worker_count = 0;
+
+    return world;
+}
+
+static
+ecs_entity_t thread_dtor_new_children(
+    ecs_world_t *world, 
+    int32_t *dtor_counts, 
+    int32_t count)
+{
+    ecs_entity_t parent = ecs_new(world);
+    for (int i = 0; i < count; i ++) {
+        ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent);
+        ecs_set(world, child, ThreadDtor, { &dtor_counts[i] });
+    }
+    return parent;
+}
+
+void MultiThread_threaded_dtors_on_workers(void) {
+    ecs_world_t *world = thread_dtor_init();
+
+    /* Make sure workers are running */
+    ecs_progress(world, 0);
+
+    int32_t i, count = 20000;
+    int32_t *dtor_counts = ecs_os_calloc_n(int32_t, count);
+    ecs_entity_t parent = thread_dtor_new_children(world, dtor_counts, count);
+
+    ecs_delete(world, parent);
+
+    for (i = 0; i < count; i ++) {
+        test_int(dtor_counts[i], 1);
+    }
+
+    const char *worker_kind = test_param("worker_kind");
+    if (!worker_kind || !strcmp(worker_kind, "thread")) {
+        test_assert(thread_dtor_worker_count != 0);
+    } else {
+        /* Task threads only exist while the pipeline runs */
+        test_int(thread_dtor_worker_count, 0);
+    }
+
+    ecs_os_free(dtor_counts);
+
+    ecs_fini(world);
+}
+
+static
+void DeleteParent(ecs_iter_t *it) {
+    ecs_delete(it->world, *(ecs_entity_t*)it->ctx);
+}
+
+void MultiThread_threaded_dtors_on_workers_in_merge(void) {
+    ecs_world_t *world = thread_dtor_init();
+
+    int32_t i, count = 20000;
+    int32_t *dtor_counts = ecs_os_calloc_n(int32_t, count);
+    ecs_entity_t parent = thread_dtor_new_children(world, dtor_counts, count);
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, { .add = ecs_ids( ecs_dependson(EcsOnUpdate) )}),
+        .callback = DeleteParent,
+        .ctx = &parent
+    });
+
+    /* Delete is merged while workers wait for the next sync point */
+    ecs_progress(world, 0);
+
+    test_assert(!ecs_is_alive(world, parent));
+    for (i = 0; i < count; i ++) {
+        test_int(dtor_counts[i], 1);
+    }
+
+    test_assert(thread_dtor_worker_count != 0);
+
+    ecs_os_free(dtor_counts);
+
+    ecs_fini(world);
+}
@@ -0,0 +1,752 @@
+#include <addons.h>
+
+typedef struct Point {
+    float x, y, z;
+} Point;
+
+typedef struct Transform {
+    int32_t flags;
+    double location[3];
+} Transform;
+
+static ECS_COMPONENT_DECLARE(Point);
+static ECS_COMPONENT_DECLARE(Transform);
+
+static
+ecs_entity_t point_new(
+    ecs_world_t *world,
+    float x,
+    float y,
+    float z)
+{
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, Point, {x, y, z});
+    return e;
+}
+
+static
+ecs_entity_t index_new(
+    ecs_world_t *world,
+    double cell_size)
+{
+    ecs_entity_t index = ecs_spatial_index(world, {
+        .component = ecs_id(Point),
+        .cell_size = cell_size
+    });
+    test_assert(index != 0);
+    return index;
+}
+
+static
+bool span_has(
+    ecs_spatial_span_t span,
+    ecs_entity_t e)
+{
+    int32_t i;
+    for (i = 0; i < span.count; i ++) {
+        if (span.entities[i] == e) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static
+int32_t find_radius(
+    ecs_world_t *world,
+    ecs_entity_t index,
+    double x,
+    double y,
+    double z,
+    double radius,
+    ecs_spatial_result_t *result)
+{
+    return ecs_spatial_find_in_radius(world, index, &(ecs_spatial_query_t){
+        .center = {x, y, z}, .radius = radius
+    }, 1, result);
+}
+
+/* Compare radius query against iterating all entities */
+static
+void verify_radius(
+    ecs_world_t *world,
+    ecs_entity_t index,
+    double x,
+    double y,
+    double z,
+    double radius)
+{
+    ecs_spatial_result_t result = {0};
+    find_radius(world, index, x, y, z, radius, &result);
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+
+    int32_t expect = 0;
+    ecs_iter_t it = ecs_each(world, Point);
+    while (ecs_each_next(&it)) {
+        Point *p = ecs_field(&it, Point, 0);
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            double dx = p[i].x - x, dy = p[i].y - y, dz = p[i].z - z;
+            if ((dx * dx + dy * dy + dz * dz) <= radius * radius) {
+                test_assert(span_has(span, it.entities[i]));
+                expect ++;
+            }
+        }
+    }
+
+    test_int(span.count, expect);
+    ecs_spatial_result_fini(&result);
+}
+
+static
+void move_random(
+    ecs_world_t *world,
+    ecs_entity_t *entities,
+    int32_t count,
+    float range)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        if (rand() % 3) {
+            continue; /* Leave some entities in place */
+        }
+        ecs_set(world, entities[i], Point, {
+            (float)(rand() % 1000) / 1000.0f * range,
+            (float)(rand() % 1000) / 1000.0f * range,
+            (float)(rand() % 1000) / 1000.0f * range
+        });
+    }
+}
+
+void Spatial_setup(void) {
+    ecs_log_set_level(-4);
+}
+
+void Spatial_init_w_existing(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t e1 = point_new(world, 1, 1, 1);
+    ecs_entity_t e2 = point_new(world, 50, 50, 50);
+
+    ecs_entity_t index = index_new(world, 10);
+    test_int(ecs_spatial_count(world, index), 2);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 5, &result), 1);
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 1);
+    test_uint(span.entities[0], e1);
+    test_flt(span.distances[0], sqrt(3));
+
+    test_int(find_radius(world, index, 48, 48, 48, 5, &result), 1);
+    span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 1);
+    test_uint(span.entities[0], e2);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_radius(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e1 = point_new(world, 0, 0, 0);
+    ecs_entity_t e2 = point_new(world, 9, 0, 0);
+    ecs_entity_t e3 = point_new(world, 11, 0, 0);
+    ecs_entity_t e4 = point_new(world, -10, 0, 0);
+    ecs_entity_t e5 = point_new(world, 0, 0, 25);
+
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 5);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 10, &result), 3);
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 3);
+    test_assert(span_has(span, e1));
+    test_assert(span_has(span, e2));
+    test_assert(!span_has(span, e3));
+    test_assert(span_has(span, e4));
+    test_assert(!span_has(span, e5));
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_radius_batch(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e1 = point_new(world, 0, 0, 0);
+    ecs_entity_t e2 = point_new(world, 100, 0, 0);
+    ecs_entity_t e3 = point_new(world, 105, 0, 0);
+
+    ecs_progress(world, 0);
+
+    ecs_spatial_query_t queries[] = {
+        { .center = {0, 0, 0}, .radius = 1 },
+        { .center = {-100, 0, 0}, .radius = 1 },
+        { .center = {102, 0, 0}, .radius = 5 }
+    };
+
+    ecs_spatial_result_t result = {0};
+    test_int(ecs_spatial_find_in_radius(world, index, queries, 3, &result), 3);
+    test_int(result.query_count, 3);
+
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 1);
+    test_uint(span.entities[0], e1);
+
+    span = ecs_spatial_result_get(&result, 1);
+    test_int(span.count, 0);
+
+    span = ecs_spatial_result_get(&result, 2);
+    test_int(span.count, 2);
+    test_assert(span_has(span, e2));
+    test_assert(span_has(span, e3));
+
+    /* Results can be reused */
+    test_int(ecs_spatial_find_in_radius(world, index, queries, 1, &result), 1);
+    test_int(result.query_count, 1);
+    span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 1);
+    test_uint(span.entities[0], e1);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_radius_large(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 1);
+
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        point_new(world, (float)(i * 10), (float)(i % 7), (float)(i % 3));
+    }
+
+    ecs_progress(world, 0);
+
+    /* Query box has many more cells than the index */
+    verify_radius(world, index, 500, 0, 0, 400);
+    verify_radius(world, index, 0, 0, 0, 10000);
+    verify_radius(world, index, 250, 3, 1, 25);
+
+    ecs_fini(world);
+}
+
+void Spatial_radius_empty_index(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 10, &result), 0);
+    test_int(ecs_spatial_result_get(&result, 0).count, 0);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_nearest(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e1 = point_new(world, 30, 0, 0);
+    ecs_entity_t e2 = point_new(world, 5, 0, 0);
+    ecs_entity_t e3 = point_new(world, 0, 12, 0);
+    point_new(world, 0, 0, -40);
+
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(ecs_spatial_find_nearest(world, index, &(ecs_spatial_query_t){
+        .center = {0, 0, 0}, .k = 3
+    }, 1, &result), 3);
+
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 3);
+    test_uint(span.entities[0], e2);
+    test_uint(span.entities[1], e3);
+    test_uint(span.entities[2], e1);
+    test_flt(span.distances[0], 5);
+    test_flt(span.distances[1], 12);
+    test_flt(span.distances[2], 30);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_nearest_w_radius(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e1 = point_new(world, 5, 0, 0);
+    point_new(world, 25, 0, 0);
+    point_new(world, 0, 300, 0);
+
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(ecs_spatial_find_nearest(world, index, &(ecs_spatial_query_t){
+        .center = {0, 0, 0}, .k = 3, .radius = 20
+    }, 1, &result), 1);
+
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 1);
+    test_uint(span.entities[0], e1);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_nearest_batch(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e1 = point_new(world, 0, 0, 0);
+    ecs_entity_t e2 = point_new(world, 1, 0, 0);
+    ecs_entity_t e3 = point_new(world, 1000, 0, 0);
+
+    ecs_progress(world, 0);
+
+    ecs_spatial_query_t queries[] = {
+        { .center = {0, 0, 0}, .k = 1 },
+        { .center = {900, 0, 0}, .k = 2 },
+        { .center = {0, 0, 0}, .k = 0 }
+    };
+
+    ecs_spatial_result_t result = {0};
+    test_int(ecs_spatial_find_nearest(world, index, queries, 3, &result), 3);
+
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    test_int(span.count, 1);
+    test_uint(span.entities[0], e1);
+
+    span = ecs_spatial_result_get(&result, 1);
+    test_int(span.count, 2);
+    test_uint(span.entities[0], e3);
+    test_uint(span.entities[1], e2);
+
+    span = ecs_spatial_result_get(&result, 2);
+    test_int(span.count, 0);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_nearest_k_exceeds_count(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    point_new(world, 0, 0, 0);
+    point_new(world, 100, 100, 100);
+
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(ecs_spatial_find_nearest(world, index, &(ecs_spatial_query_t){
+        .center = {-500, 0, 0}, .k = 10
+    }, 1, &result), 2);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_nearest_sparse(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 1);
+
+    int32_t i;
+    ecs_entity_t entities[64];
+    for (i = 0; i < 64; i ++) {
+        entities[i] = point_new(world,
+            (float)(i * 37 % 500), (float)(i * 91 % 500), (float)(i * 13 % 500));
+    }
+
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(ecs_spatial_find_nearest(world, index, &(ecs_spatial_query_t){
+        .center = {250, 250, 250}, .k = 5
+    }, 1, &result), 5);
+
+    /* Verify against distances of all entities */
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    for (i = 0; i < 64; i ++) {
+        const Point *p = ecs_get(world, entities[i], Point);
+        double dx = p->x - 250, dy = p->y - 250, dz = p->z - 250;
+        double d = sqrt(dx * dx + dy * dy + dz * dz);
+        if (!span_has(span, entities[i])) {
+            test_assert(d >= span.distances[4]);
+        }
+    }
+
+    for (i = 1; i < 5; i ++) {
+        test_assert(span.distances[i - 1] <= span.distances[i]);
+    }
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_update_same_cell(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e = point_new(world, 1, 1, 1);
+    ecs_progress(world, 0);
+
+    ecs_set(world, e, Point, {8, 8, 8});
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 2, &result), 0);
+    test_int(find_radius(world, index, 8, 8, 8, 1, &result), 1);
+    test_uint(ecs_spatial_result_get(&result, 0).entities[0], e);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_update_move_cell(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e1 = point_new(world, 1, 1, 1);
+    ecs_entity_t e2 = point_new(world, 2, 2, 2);
+    ecs_progress(world, 0);
+
+    ecs_set(world, e1, Point, {100, 100, 100});
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 2);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 5, &result), 1);
+    test_uint(ecs_spatial_result_get(&result, 0).entities[0], e2);
+    test_int(find_radius(world, index, 100, 100, 100, 1, &result), 1);
+    test_uint(ecs_spatial_result_get(&result, 0).entities[0], e1);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_update_from_system(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e = point_new(world, 0, 0, 0);
+    ecs_progress(world, 0);
+
+    ecs_query_t *q = ecs_query(world, { .terms = {{ ecs_id(Point) }} });
+    ecs_iter_t it = ecs_query_iter(world, q);
+    while (ecs_query_next(&it)) {
+        Point *p = ecs_field(&it, Point, 0);
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            p[i].x += 50;
+        }
+    }
+
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 50, 0, 0, 1, &result), 1);
+    test_uint(ecs_spatial_result_get(&result, 0).entities[0], e);
+
+    ecs_spatial_result_fini(&result);
+    ecs_query_fini(q);
+    ecs_fini(world);
+}
+
+void Spatial_skip_unchanged_table(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t e = point_new(world, 0, 0, 0);
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    /* Writing without marking the component modified doesn't change the table
+     * dirty state, so the index doesn't see the change. */
+    Point *p = ecs_get_mut(world, e, Point);
+    p->x = 100;
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 1, &result), 1);
+
+    ecs_modified(world, e, Point);
+    ecs_progress(world, 0);
+    test_int(find_radius(world, index, 0, 0, 0, 1, &result), 0);
+    test_int(find_radius(world, index, 100, 0, 0, 1, &result), 1);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_add_after_init(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t index = index_new(world, 10);
+    point_new(world, 0, 0, 0);
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 1);
+
+    /* Entity in existing table */
+    point_new(world, 1, 0, 0);
+
+    /* Entity in new table */
+    ecs_entity_t e = point_new(world, 2, 0, 0);
+    ecs_add(world, e, Tag);
+
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 3);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 5, &result), 3);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_remove_component(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+    ecs_entity_t e1 = point_new(world, 0, 0, 0);
+    ecs_entity_t e2 = point_new(world, 1, 0, 0);
+    ecs_progress(world, 0);
+
+    ecs_remove(world, e1, Point);
+    test_int(ecs_spatial_count(world, index), 1);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 5, &result), 1);
+    test_uint(ecs_spatial_result_get(&result, 0).entities[0], e2);
+
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 1);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_delete_entity(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+    ecs_entity_t e1 = point_new(world, 0, 0, 0);
+    point_new(world, 1, 0, 0);
+    ecs_progress(world, 0);
+
+    ecs_delete(world, e1);
+    test_int(ecs_spatial_count(world, index), 1);
+
+    ecs_spatial_result_t result = {0};
+    test_int(find_radius(world, index, 0, 0, 0, 5, &result), 1);
+    test_assert(ecs_spatial_result_get(&result, 0).entities[0] != e1);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_delete_after_set(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+    ecs_entity_t e1 = point_new(world, 0, 0, 0);
+    ecs_progress(world, 0);
+
+    /* Entity is deleted in the same frame it's moved */
+    ecs_set(world, e1, Point, {100, 0, 0});
+    ecs_delete(world, e1);
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 0);
+
+    ecs_fini(world);
+}
+
+void Spatial_f64_w_offset(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Transform);
+
+    ecs_entity_t index = ecs_spatial_index(world, {
+        .component = ecs_id(Transform),
+        .offset = offsetof(Transform, location),
+        .f64 = true,
+        .cell_size = 100
+    });
+    test_assert(index != 0);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, Transform, {1, {1e7, 0, 0}});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, Transform, {2, {1e7 + 50, 0, 0}});
+    ecs_progress(world, 0);
+
+    ecs_spatial_result_t result = {0};
+    test_int(ecs_spatial_find_nearest(world, index, &(ecs_spatial_query_t){
+        .center = {1e7 + 40, 0, 0}, .k = 2
+    }, 1, &result), 2);
+
+    ecs_spatial_span_t span = ecs_spatial_result_get(&result, 0);
+    test_uint(span.entities[0], e2);
+    test_uint(span.entities[1], e1);
+    test_flt(span.distances[0], 10);
+    test_flt(span.distances[1], 40);
+
+    ecs_spatial_result_fini(&result);
+    ecs_fini(world);
+}
+
+void Spatial_rebuild(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+
+    ecs_entity_t entities[100];
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        entities[i] = point_new(world, (float)i, 0, 0);
+    }
+    ecs_progress(world, 0);
+
+    ecs_spatial_index_rebuild(world, index);
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 100);
+
+    verify_radius(world, index, 50, 0, 0, 20);
+
+    ecs_delete(world, entities[50]);
+    ecs_spatial_index_rebuild(world, index);
+    ecs_progress(world, 0);
+    test_int(ecs_spatial_count(world, index), 99);
+    verify_radius(world, index, 50, 0, 0, 20);
+
+    ecs_fini(world);
+}
+
+void Spatial_random_moves(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 5);
+
+    srand(1);
+
+    ecs_entity_t entities[1000];
+    int32_t i, frame;
+    for (i = 0; i < 1000; i ++) {
+        entities[i] = point_new(world, 0, 0, 0);
+    }
+
+    for (frame = 0; frame < 20; frame ++) {
+        move_random(world, entities, 1000, 100);
+        ecs_progress(world, 0);
+        test_int(ecs_spatial_count(world, index), 1000);
+        verify_radius(world, index, 50, 50, 50, 20);
+        verify_radius(world, index, 10, 90, 30, 7);
+    }
+
+    ecs_fini(world);
+}
+
+void Spatial_random_moves_multi_threaded(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t index = index_new(world, 5);
+    ecs_set_threads(world, 4);
+
+    srand(2);
+
+    ecs_entity_t entities[1000];
+    int32_t i, frame;
+    for (i = 0; i < 1000; i ++) {
+        entities[i] = point_new(world, 0, 0, 0);
+        if (i % 2) {
+            ecs_add(world, entities[i], Tag);
+        }
+    }
+
+    for (frame = 0; frame < 20; frame ++) {
+        move_random(world, entities, 1000, 100);
+        ecs_progress(world, 0);
+        test_int(ecs_spatial_count(world, index), 1000);
+        verify_radius(world, index, 50, 50, 50, 20);
+        verify_radius(world, index, 90, 10, 60, 9);
+    }
+
+    ecs_fini(world);
+}
+
+void Spatial_delete_index(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    ecs_entity_t index = index_new(world, 10);
+    point_new(world, 0, 0, 0);
+    ecs_progress(world, 0);
+
+    ecs_delete(world, index);
+    test_assert(!ecs_is_alive(world, index));
+
+    /* Index systems are deleted with the index */
+    ecs_progress(world, 0);
+
+    ecs_fini(world);
+}
+
+void Spatial_invalid_index(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_new(world);
+
+    test_expect_abort();
+    ecs_spatial_count(world, e);
+}
+
+void Spatial_no_cell_size(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Point);
+
+    test_expect_abort();
+    ecs_spatial_index(world, {
+        .component = ecs_id(Point)
+    });
+}
@@ -283,3 +283,80 @@ void Stats_progress_stats_systems_w_empty_table_flag(void) {
 
     ecs_fini(world);
 }
+
+void Stats_get_alert_stats(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats);
+    ECS_IMPORT(world, FlecsAlerts);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_add(world, e1, Position);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "position_without_velocity" }),
+        .query.expr = "Position, !Velocity"
+    });
+    test_assert(alert != 0);
+
+    test_bool(ecs_alert_stats_get(world, e1, &(ecs_alert_stats_t){0}), false);
+
+    ecs_progress(world, 1.0);
+
+    const EcsAlertStats *s = ecs_get_pair(
+        world, EcsWorld, EcsAlertStats, EcsPeriod1s);
+    test_assert(s != NULL);
+
+    ecs_alert_stats_t *stats = ecs_map_get_deref(
+        &s->stats, ecs_alert_stats_t, alert);
+    test_assert(stats != NULL);
+    test_bool(stats->incremental, true);
+
+    ecs_fini(world);
+}
+
+void Stats_get_alert_stats_import_alerts_first(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsAlerts);
+    ECS_IMPORT(world, FlecsStats);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_add(world, e1, Position);
+
+    ecs_entity_t alert = ecs_alert(world, {
+        .entity = ecs_entity(world, { .name = "position" }),
+        .query.expr = "Position"
+    });
+    test_assert(alert != 0);
+
+    ecs_progress(world, 1.0);
+
+    const EcsAlertStats *s = ecs_get_pair(
+        world, EcsWorld, EcsAlertStats, EcsPeriod1s);
+    test_assert(s != NULL);
+    test_assert(ecs_map_get_deref(
+        &s->stats, ecs_alert_stats_t, alert) != NULL);
+    test_assert(ecs_lookup(world, "flecs.stats.AlertStats") != 0);
+
+    ecs_fini(world);
+}
+
+void Stats_import_stats_no_alerts(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats);
+
+    test_assert(ecs_lookup(world, "flecs.alerts") == 0);
+    test_assert(ecs_lookup(world, "flecs.metrics") == 0);
+    test_assert(ecs_lookup(world, "flecs.stats.AlertStats") == 0);
+
+    ecs_progress(world, 1.0);
+
+    ecs_fini(world);
+}
@@ -756,3 +756,211 @@ void Timer_randomize_timers(void) {
 
     ecs_fini(world);
 }
+
+void Timer_wheel_timeout(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, SystemA, EcsOnUpdate, Position);
+
+    ecs_new_w(world, Position);
+
+    ecs_entity_t timer = ecs_set_timeout(world, SystemA, 3.0);
+    test_assert(timer == SystemA);
+    ecs_add_id(world, timer, EcsTimerWheel);
+
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, true);
+
+    system_a_invoked = false;
+
+    /* Make sure this was a one-shot timer */
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);    
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+    ecs_progress(world, 1.0);
+    test_bool(system_a_invoked, false);
+
+    const EcsTimer *t = ecs_get(world, timer, EcsTimer);
+    test_assert(t != NULL);
+    test_bool(t->active, false);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_interval(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, SystemA, EcsOnUpdate, Position);
+
+    ecs_new_w(world, Position);
+
+    ecs_entity_t timer = ecs_set_interval(world, SystemA, 3.0);
+    test_assert(timer == SystemA);
+    ecs_add_id(world, timer, EcsTimerWheel);
+
+    for (int i = 0; i < 4; i ++) {
+        ecs_progress(world, 1.0);
+        test_bool(system_a_invoked, false);
+        ecs_progress(world, 1.0);
+        test_bool(system_a_invoked, false);
+        ecs_progress(world, 1.0);
+        test_bool(system_a_invoked, true);
+        system_a_invoked = false;
+    }
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_start_stop(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t timer = ecs_set_interval(world, 0, 1.0);
+    ecs_add_id(world, timer, EcsTimerWheel);
+
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, true);
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+
+    ecs_stop_timer(world, timer);
+
+    for (int i = 0; i < 6; i ++) {
+        ecs_progress(world, 0.5);
+        test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+    }
+
+    ecs_start_timer(world, timer);
+
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, true);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_reset(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t timer = ecs_set_timeout(world, 0, 1.0);
+    ecs_add_id(world, timer, EcsTimerWheel);
+
+    ecs_progress(world, 0.75);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+
+    ecs_reset_timer(world, timer);
+
+    ecs_progress(world, 0.75);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+    ecs_progress(world, 0.25);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, true);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_long_timeout(void) {
+    ecs_world_t *world = ecs_init();
+
+    /* Past the range of the first levels of the wheel */
+    ecs_entity_t timer = ecs_set_timeout(world, 0, 5000.0);
+    ecs_add_id(world, timer, EcsTimerWheel);
+
+    for (int i = 0; i < 4999; i ++) {
+        ecs_progress(world, 1.0);
+        test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+    }
+
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, true);
+    test_flt(ecs_get(world, timer, EcsTickSource)->time_elapsed, 5000.0);
+
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, timer, EcsTickSource)->tick, false);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_many_timers(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t timers[300];
+    for (int i = 0; i < 300; i ++) {
+        timers[i] = ecs_set_timeout(world, 0, (ecs_ftime_t)(i + 1) * 0.5f);
+        ecs_add_id(world, timers[i], EcsTimerWheel);
+    }
+
+    for (int frame = 1; frame <= 320; frame ++) {
+        ecs_progress(world, 0.5);
+        for (int i = 0; i < 300; i ++) {
+            const EcsTickSource *src = ecs_get(world, timers[i], EcsTickSource);
+            test_assert(src != NULL);
+            test_bool(src->tick, frame == (i + 1));
+        }
+    }
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_delete_timer(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t timer_a = ecs_set_interval(world, 0, 1.0);
+    ecs_add_id(world, timer_a, EcsTimerWheel);
+    ecs_entity_t timer_b = ecs_set_interval(world, 0, 1.0);
+    ecs_add_id(world, timer_b, EcsTimerWheel);
+
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, timer_a, EcsTickSource)->tick, true);
+    test_bool(ecs_get(world, timer_b, EcsTickSource)->tick, true);
+
+    ecs_delete(world, timer_a);
+
+    ecs_progress(world, 1.0);
+    test_bool(ecs_get(world, timer_b, EcsTickSource)->tick, true);
+
+    ecs_remove_id(world, timer_b, EcsTimerWheel);
+
+    /* Timer is progressed by regular timer system */
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, timer_b, EcsTickSource)->tick, false);
+    ecs_progress(world, 0.5);
+    test_bool(ecs_get(world, timer_b, EcsTickSource)->tick, true);
+
+    ecs_fini(world);
+}
+
+void Timer_wheel_rate_filter(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t timer = ecs_set_interval(world, 0, 1.0);
+    ecs_add_id(world, timer, EcsTimerWheel);
+
+    ecs_entity_t filters[10];
+    for (int i = 0; i < 10; i ++) {
+        filters[i] = ecs_set_rate(world, 0, 2, timer);
+    }
+
+    for (int frame = 1; frame <= 8; frame ++) {
+        ecs_progress(world, 1.0);
+        for (int i = 0; i < 10; i ++) {
+            const EcsTickSource *src = ecs_get(world, filters[i], EcsTickSource);
+            test_assert(src != NULL);
+            test_bool(src->tick, !(frame % 2));
+        }
+    }
+
+    ecs_fini(world);
+}
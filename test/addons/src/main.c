@@ -250,6 +250,14 @@ void Timer_naked_tick_entity(void);
 void Timer_stop_timer_w_rate(void);
 void Timer_stop_timer_w_rate_same_src(void);
 void Timer_randomize_timers(void);
+void Timer_wheel_timeout(void);
+void Timer_wheel_interval(void);
+void Timer_wheel_start_stop(void);
+void Timer_wheel_reset(void);
+void Timer_wheel_long_timeout(void);
+void Timer_wheel_many_timers(void);
+void Timer_wheel_delete_timer(void);
+void Timer_wheel_rate_filter(void);
 
 // Testsuite 'SystemCascade'
 void SystemCascade_cascade_depth_1(void);
@@ -324,6 +332,9 @@ void Stats_get_pipeline_stats_w_task_system(void);
 void Stats_get_not_alive_entity_count(void);
 void Stats_progress_stats_systems(void);
 void Stats_progress_stats_systems_w_empty_table_flag(void);
+void Stats_get_alert_stats(void);
+void Stats_get_alert_stats_import_alerts_first(void);
+void Stats_import_stats_no_alerts(void);
 
 // Testsuite 'Run'
 void Run_setup(void);
@@ -385,6 +396,8 @@ void MultiThread_bulk_new_in_no_readonly_w_multithread(void);
 void MultiThread_bulk_new_in_no_readonly_w_multithread_2(void);
 void MultiThread_run_first_worker_on_main(void);
 void MultiThread_run_single_thread_on_main(void);
+void MultiThread_threaded_dtors_on_workers(void);
+void MultiThread_threaded_dtors_on_workers_in_merge(void);
 
 // Testsuite 'MultiThreadStaging'
 void MultiThreadStaging_setup(void);
@@ -538,6 +551,40 @@ void Alerts_member_range_from_var(void);
 void Alerts_member_range_from_var_after_remove(void);
 void Alerts_retained_alert_w_dead_source(void);
 void Alerts_alert_counts(void);
+void Alerts_alert_incremental_skip_unchanged(void);
+void Alerts_alert_incremental_new_match(void);
+void Alerts_alert_incremental_clear_on_remove(void);
+void Alerts_alert_member_range_not_incremental(void);
+void Alerts_alert_incremental_retain_period(void);
+void Alerts_alert_uncached_not_incremental(void);
+
+// Testsuite 'Spatial'
+void Spatial_setup(void);
+void Spatial_init_w_existing(void);
+void Spatial_radius(void);
+void Spatial_radius_batch(void);
+void Spatial_radius_large(void);
+void Spatial_radius_empty_index(void);
+void Spatial_nearest(void);
+void Spatial_nearest_w_radius(void);
+void Spatial_nearest_batch(void);
+void Spatial_nearest_k_exceeds_count(void);
+void Spatial_nearest_sparse(void);
+void Spatial_update_same_cell(void);
+void Spatial_update_move_cell(void);
+void Spatial_update_from_system(void);
+void Spatial_skip_unchanged_table(void);
+void Spatial_add_after_init(void);
+void Spatial_remove_component(void);
+void Spatial_delete_entity(void);
+void Spatial_delete_after_set(void);
+void Spatial_f64_w_offset(void);
+void Spatial_rebuild(void);
+void Spatial_random_moves(void);
+void Spatial_random_moves_multi_threaded(void);
+void Spatial_delete_index(void);
+void Spatial_invalid_index(void);
+void Spatial_no_cell_size(void);
 
 bake_test_case Doc_testcases[] = {
     {
@@ -1483,6 +1530,38 @@ bake_test_case Timer_testcases[] = {
     {
         "randomize_timers",
         Timer_randomize_timers
+    },
+    {
+        "wheel_timeout",
+        Timer_wheel_timeout
+    },
+    {
+        "wheel_interval",
+        Timer_wheel_interval
+    },
+    {
+        "wheel_start_stop",
+        Timer_wheel_start_stop
+    },
+    {
+        "wheel_reset",
+        Timer_wheel_reset
+    },
+    {
+        "wheel_long_timeout",
+        Timer_wheel_long_timeout
+    },
+    {
+        "wheel_many_timers",
+        Timer_wheel_many_timers
+    },
+    {
+        "wheel_delete_timer",
+        Timer_wheel_delete_timer
+    },
+    {
+        "wheel_rate_filter",
+        Timer_wheel_rate_filter
     }
 };
 
@@ -1731,6 +1810,18 @@ bake_test_case Stats_testcases[] = {
     {
         "progress_stats_systems_w_empty_table_flag",
         Stats_progress_stats_systems_w_empty_table_flag
+    },
+    {
+        "get_alert_stats",
+        Stats_get_alert_stats
+    },
+    {
+        "get_alert_stats_import_alerts_first",
+        Stats_get_alert_stats_import_alerts_first
+    },
+    {
+        "import_stats_no_alerts",
+        Stats_import_stats_no_alerts
     }
 };
 
@@ -1957,6 +2048,14 @@ bake_test_case MultiThread_testcases[] = {
     {
         "run_single_thread_on_main",
         MultiThread_run_single_thread_on_main
+    },
+    {
+        "threaded_dtors_on_workers",
+        MultiThread_threaded_dtors_on_workers
+    },
+    {
+        "threaded_dtors_on_workers_in_merge",
+        MultiThread_threaded_dtors_on_workers_in_merge
     }
 };
 
@@ -2526,6 +2625,133 @@ bake_test_case Alerts_testcases[] = {
     {
         "alert_counts",
         Alerts_alert_counts
+    },
+    {
+        "alert_incremental_skip_unchanged",
+        Alerts_alert_incremental_skip_unchanged
+    },
+    {
+        "alert_incremental_new_match",
+        Alerts_alert_incremental_new_match
+    },
+    {
+        "alert_incremental_clear_on_remove",
+        Alerts_alert_incremental_clear_on_remove
+    },
+    {
+        "alert_member_range_not_incremental",
+        Alerts_alert_member_range_not_incremental
+    },
+    {
+        "alert_incremental_retain_period",
+        Alerts_alert_incremental_retain_period
+    },
+    {
+        "alert_uncached_not_incremental",
+        Alerts_alert_uncached_not_incremental
+    }
+};
+
+bake_test_case Spatial_testcases[] = {
+    {
+        "init_w_existing",
+        Spatial_init_w_existing
+    },
+    {
+        "radius",
+        Spatial_radius
+    },
+    {
+        "radius_batch",
+        Spatial_radius_batch
+    },
+    {
+        "radius_large",
+        Spatial_radius_large
+    },
+    {
+        "radius_empty_index",
+        Spatial_radius_empty_index
+    },
+    {
+        "nearest",
+        Spatial_nearest
+    },
+    {
+        "nearest_w_radius",
+        Spatial_nearest_w_radius
+    },
+    {
+        "nearest_batch",
+        Spatial_nearest_batch
+    },
+    {
+        "nearest_k_exceeds_count",
+        Spatial_nearest_k_exceeds_count
+    },
+    {
+        "nearest_sparse",
+        Spatial_nearest_sparse
+    },
+    {
+        "update_same_cell",
+        Spatial_update_same_cell
+    },
+    {
+        "update_move_cell",
+        Spatial_update_move_cell
+    },
+    {
+        "update_from_system",
+        Spatial_update_from_system
+    },
+    {
+        "skip_unchanged_table",
+        Spatial_skip_unchanged_table
+    },
+    {
+        "add_after_init",
+        Spatial_add_after_init
+    },
+    {
+        "remove_component",
+        Spatial_remove_component
+    },
+    {
+        "delete_entity",
+        Spatial_delete_entity
+    },
+    {
+        "delete_after_set",
+        Spatial_delete_after_set
+    },
+    {
+        "f64_w_offset",
+        Spatial_f64_w_offset
+    },
+    {
+        "rebuild",
+        Spatial_rebuild
+    },
+    {
+        "random_moves",
+        Spatial_random_moves
+    },
+    {
+        "random_moves_multi_threaded",
+        Spatial_random_moves_multi_threaded
+    },
+    {
+        "delete_index",
+        Spatial_delete_index
+    },
+    {
+        "invalid_index",
+        Spatial_invalid_index
+    },
+    {
+        "no_cell_size",
+        Spatial_no_cell_size
     }
 };
 
@@ -2571,7 +2797,7 @@ static bake_test_suite suites[] = {
         "Timer",
         NULL,
         NULL,
-        19,
+        27,
         Timer_testcases
     },
     {
@@ -2627,7 +2853,7 @@ static bake_test_suite suites[] = {
         "Stats",
         NULL,
         NULL,
-        13,
+        16,
         Stats_testcases
     },
     {
@@ -2641,7 +2867,7 @@ static bake_test_suite suites[] = {
         "MultiThread",
         MultiThread_setup,
         NULL,
-        50,
+        52,
         MultiThread_testcases,
         1,
         MultiThread_params
@@ -2694,11 +2920,18 @@ static bake_test_suite suites[] = {
         "Alerts",
         NULL,
         NULL,
-        36,
+        42,
         Alerts_testcases
+    },
+    {
+        "Spatial",
+        Spatial_setup,
+        NULL,
+        25,
+        Spatial_testcases
     }
 };
 
 int main(int argc, char *argv[]) {
-    return bake_test_run("addons", argc, argv, suites, 22);
+    return bake_test_run("addons", argc, argv, suites, 23);
 }
@@ -0,0 +1,15 @@
+#ifndef EXPR_BENCH_H
+#define EXPR_BENCH_H
+
+/* This generated file contains includes for project dependencies */
+#include <expr_bench/bake_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
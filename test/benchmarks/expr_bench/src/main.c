@@ -0,0 +1,203 @@
+#include <expr_bench.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Microbenchmarks for script expression evaluation. Compares evaluating an
+ * expression by walking the AST with evaluating its bytecode program, both
+ * one value at a time and for a whole column at once with 
+ * ecs_expr_eval_batch. Usage: expr_bench [count]
+ *
+ * Every benchmark is repeated until at least BENCH_MIN_OPS evaluations have
+ * run, and reports the average time per evaluation in nanoseconds. */
+
+#define BENCH_MIN_OPS (4 * 1000 * 1000)
+
+typedef struct Position {
+    float x;
+    float y;
+} Position;
+
+/* Doesn't use ecs_time_measure, which requires the OS API implementation */
+static
+double bench_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 * 1000.0 * 1000.0 + (double)ts.tv_nsec;
+}
+
+static
+double bench_ns(
+    double ns,
+    int64_t ops)
+{
+    return ns / (double)ops;
+}
+
+typedef struct bench_data_t {
+    int32_t count;
+    int32_t *x;
+    int32_t *y;
+    Position *p;
+    double *out;      /* Large enough for any primitive result type */
+} bench_data_t;
+
+typedef struct bench_expr_t {
+    const char *expr;
+    ecs_entity_t type;
+} bench_expr_t;
+
+/* Evaluate expression once per row through variables */
+static
+double bench_eval(
+    ecs_world_t *world,
+    ecs_script_vars_t *vars,
+    const bench_expr_t *expr,
+    const bench_data_t *data,
+    bool disable_bytecode,
+    int32_t repeat)
+{
+    ecs_expr_eval_desc_t desc = { 
+        .vars = vars, .disable_bytecode = disable_bytecode };
+    ecs_script_t *s = ecs_expr_parse(world, expr->expr, &desc);
+    if (!s) {
+        return -1;
+    }
+
+    ecs_script_var_t *x = ecs_script_vars_lookup(vars, "x");
+    ecs_script_var_t *y = ecs_script_vars_lookup(vars, "y");
+    ecs_script_var_t *p = ecs_script_vars_lookup(vars, "p");
+    desc.type = expr->type;
+
+    double t = bench_now();
+    int32_t r, i;
+    for (r = 0; r < repeat; r ++) {
+        for (i = 0; i < data->count; i ++) {
+            *(int32_t*)x->value.ptr = data->x[i];
+            *(int32_t*)y->value.ptr = data->y[i];
+            *(Position*)p->value.ptr = data->p[i];
+            ecs_value_t v = { expr->type, &data->out[i] };
+            if (ecs_expr_eval(s, &v, &desc)) {
+                ecs_script_free(s);
+                return -1;
+            }
+        }
+    }
+    t = bench_now() - t;
+
+    ecs_script_free(s);
+    return bench_ns(t, (int64_t)data->count * repeat);
+}
+
+/* Evaluate expression for all rows at once */
+static
+double bench_eval_batch(
+    ecs_world_t *world,
+    ecs_script_vars_t *vars,
+    ecs_entity_t position,
+    const bench_expr_t *expr,
+    const bench_data_t *data,
+    bool disable_bytecode,
+    int32_t repeat)
+{
+    ecs_expr_eval_desc_t desc = { 
+        .vars = vars, .disable_bytecode = disable_bytecode };
+    ecs_script_t *s = ecs_expr_parse(world, expr->expr, &desc);
+    if (!s) {
+        return -1;
+    }
+
+    ecs_expr_eval_batch_desc_t batch_desc = {
+        .count = data->count,
+        .columns = {
+            { "x", ecs_id(ecs_i32_t), data->x },
+            { "y", ecs_id(ecs_i32_t), data->y },
+            { "p", position, data->p }
+        },
+        .type = expr->type,
+        .out = data->out,
+        .out_stride = ECS_SIZEOF(double)
+    };
+
+    double t = bench_now();
+    int32_t r;
+    for (r = 0; r < repeat; r ++) {
+        if (ecs_expr_eval_batch(s, &batch_desc)) {
+            ecs_script_free(s);
+            return -1;
+        }
+    }
+    t = bench_now() - t;
+
+    ecs_script_free(s);
+    return bench_ns(t, (int64_t)data->count * repeat);
+}
+
+int main(int argc, char *argv[]) {
+    int32_t count = 10 * 1000;
+    if (argc > 1) {
+        count = atoi(argv[1]);
+    }
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t position = ecs_struct(world, {
+        .entity = ecs_entity(world, { .name = "Position" }),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) }
+        }
+    });
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define(vars, "x", ecs_i32_t);
+    ecs_script_vars_define(vars, "y", ecs_i32_t);
+    ecs_script_vars_define_id(vars, "p", position);
+
+    bench_data_t data = { .count = count };
+    data.x = ecs_os_malloc_n(int32_t, count);
+    data.y = ecs_os_malloc_n(int32_t, count);
+    data.p = ecs_os_malloc_n(Position, count);
+    data.out = ecs_os_malloc_n(double, count);
+
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        data.x[i] = i % 100;
+        data.y[i] = (i * 7) % 50;
+        data.p[i] = (Position){ (float)i * 0.5f, (float)(count - i) };
+    }
+
+    const bench_expr_t exprs[] = {
+        { "$x + $y * 2", ecs_id(ecs_f64_t) },
+        { "($x * $x + $y * $y) / 2.0", ecs_id(ecs_f64_t) },
+        { "$p.x * 10 + $p.y", ecs_id(ecs_f64_t) },
+        { "$x > 10 && $y < 20", ecs_id(ecs_bool_t) },
+        { "($p.x - $x) * ($p.y - $y) / 3", ecs_id(ecs_f64_t) }
+    };
+
+    int32_t repeat = BENCH_MIN_OPS / count;
+    if (repeat < 1) {
+        repeat = 1;
+    }
+
+    printf("%-34s %9s %9s %9s %9s   (ns/eval, %d rows)\n",
+        "expression", "ast", "bytecode", "ast_n", "bytecode_n", count);
+
+    for (i = 0; i < (int32_t)(sizeof(exprs) / sizeof(exprs[0])); i ++) {
+        printf("%-34s %9.2f %9.2f %9.2f %9.2f\n", exprs[i].expr,
+            bench_eval(world, vars, &exprs[i], &data, true, repeat),
+            bench_eval(world, vars, &exprs[i], &data, false, repeat),
+            bench_eval_batch(
+                world, vars, position, &exprs[i], &data, true, repeat),
+            bench_eval_batch(
+                world, vars, position, &exprs[i], &data, false, repeat));
+    }
+
+    ecs_script_vars_fini(vars);
+    ecs_os_free(data.x);
+    ecs_os_free(data.y);
+    ecs_os_free(data.p);
+    ecs_os_free(data.out);
+
+    return ecs_fini(world);
+}
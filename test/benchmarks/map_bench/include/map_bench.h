@@ -0,0 +1,15 @@
+#ifndef MAP_BENCH_H
+#define MAP_BENCH_H
+
+/* This generated file contains includes for project dependencies */
+#include <map_bench/bake_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
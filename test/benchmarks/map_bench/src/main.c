@@ -0,0 +1,187 @@
+#include <map_bench.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Microbenchmarks for ecs_map_t. Build once with and once without
+ * FLECS_MAP_OPEN_ADDRESSING to compare the chained and open addressing
+ * implementations. Usage: map_bench [max_count]
+ *
+ * Every benchmark is repeated until at least BENCH_MIN_OPS operations have
+ * run, and reports the average time per operation in nanoseconds. */
+
+#define BENCH_MIN_OPS (10 * 1000 * 1000)
+
+typedef enum bench_keys_t {
+    BenchEntityKeys,    /* Entity ids, like the keys of id record maps */
+    BenchPairKeys       /* Random pairs, like the keys of hi table edges */
+} bench_keys_t;
+
+static uint64_t bench_rng = 0x9E3779B97F4A7C15ull;
+
+static
+uint64_t bench_rand(void) {
+    bench_rng ^= bench_rng << 13;
+    bench_rng ^= bench_rng >> 7;
+    bench_rng ^= bench_rng << 17;
+    return bench_rng;
+}
+
+static
+uint64_t* bench_keys(
+    bench_keys_t kind,
+    int32_t count,
+    uint64_t offset)
+{
+    uint64_t *keys = ecs_os_malloc_n(uint64_t, count);
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        if (kind == BenchEntityKeys) {
+            keys[i] = FLECS_HI_COMPONENT_ID + offset + (uint64_t)i;
+        } else {
+            /* Relationship from a small set, target from a large set. Offset
+             * keeps the miss keys disjoint from the inserted keys. */
+            uint64_t rel = FLECS_HI_COMPONENT_ID + (bench_rand() % 64);
+            uint64_t tgt = FLECS_HI_COMPONENT_ID + offset +
+                (uint64_t)i * 4 + (bench_rand() % 4);
+            keys[i] = ecs_pair(rel, (uint32_t)tgt);
+        }
+    }
+    return keys;
+}
+
+/* Shuffle keys so lookups don't visit slots in insertion order */
+static
+void bench_shuffle(
+    uint64_t *keys,
+    int32_t count)
+{
+    int32_t i;
+    for (i = count - 1; i > 0; i --) {
+        int32_t j = (int32_t)(bench_rand() % (uint64_t)(i + 1));
+        uint64_t tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+}
+
+static
+void bench_populate(
+    ecs_map_t *map,
+    const uint64_t *keys,
+    int32_t count)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        ecs_map_insert(map, keys[i], keys[i]);
+    }
+}
+
+/* Doesn't use ecs_time_measure, which requires the OS API implementation */
+static
+double bench_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 * 1000.0 * 1000.0 + (double)ts.tv_nsec;
+}
+
+static
+double bench_ns(
+    double ns,
+    int64_t ops)
+{
+    return ns / (double)ops;
+}
+
+static
+void bench_run(
+    bench_keys_t kind,
+    int32_t count)
+{
+    uint64_t *keys = bench_keys(kind, count, 0);
+    uint64_t *lookup_keys = ecs_os_memdup_n(keys, uint64_t, count);
+    uint64_t *miss_keys = bench_keys(kind, count, (uint64_t)count * 8);
+    bench_shuffle(lookup_keys, count);
+
+    int32_t r, i, repeat = BENCH_MIN_OPS / count;
+    if (repeat < 1) {
+        repeat = 1;
+    }
+
+    int64_t ops = (int64_t)count * repeat;
+    double t_insert = 0, t_hit = 0, t_miss = 0, t_iter = 0, t_erase = 0;
+    uint64_t sum = 0;
+
+    for (r = 0; r < repeat; r ++) {
+        ecs_map_t map;
+        ecs_map_init(&map, NULL);
+
+        double t = bench_now(), t_end;
+        bench_populate(&map, keys, count);
+        t_insert += (t_end = bench_now()) - t;
+
+        t = t_end;
+        for (i = 0; i < count; i ++) {
+            sum += ecs_map_get(&map, lookup_keys[i])[0];
+        }
+        t_hit += (t_end = bench_now()) - t;
+
+        t = t_end;
+        for (i = 0; i < count; i ++) {
+            sum += ecs_map_get(&map, miss_keys[i]) != NULL;
+        }
+        t_miss += (t_end = bench_now()) - t;
+
+        t = t_end;
+        ecs_map_iter_t it = ecs_map_iter(&map);
+        while (ecs_map_next(&it)) {
+            sum += ecs_map_value(&it);
+        }
+        t_iter += (t_end = bench_now()) - t;
+
+        t = t_end;
+        for (i = 0; i < count; i ++) {
+            sum += ecs_map_remove(&map, lookup_keys[i]);
+        }
+        t_erase += bench_now() - t;
+
+        ecs_map_fini(&map);
+    }
+
+    printf("%-7s %9d %9.2f %9.2f %9.2f %9.2f %9.2f   (%llu)\n",
+        kind == BenchEntityKeys ? "entity" : "pair", count,
+        bench_ns(t_insert, ops), bench_ns(t_hit, ops), bench_ns(t_miss, ops),
+        bench_ns(t_iter, ops), bench_ns(t_erase, ops),
+        (unsigned long long)(sum & 0xFF));
+
+    ecs_os_free(keys);
+    ecs_os_free(lookup_keys);
+    ecs_os_free(miss_keys);
+}
+
+int main(int argc, char *argv[]) {
+    int32_t max_count = 10 * 1000 * 1000;
+    if (argc > 1) {
+        max_count = atoi(argv[1]);
+    }
+
+    ecs_os_set_api_defaults();
+    ecs_os_init();
+
+#ifdef FLECS_MAP_OPEN_ADDRESSING
+    printf("ecs_map_t: open addressing\n");
+#else
+    printf("ecs_map_t: chained\n");
+#endif
+    printf("%-7s %9s %9s %9s %9s %9s %9s   (ns/op)\n",
+        "keys", "count", "insert", "get", "get_miss", "iter", "remove");
+
+    int32_t count;
+    for (count = 1000; count <= max_count; count *= 10) {
+        bench_run(BenchEntityKeys, count);
+        bench_run(BenchPairKeys, count);
+    }
+
+    ecs_os_fini();
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef STORAGE_BENCH_H
+#define STORAGE_BENCH_H
+
+/* This generated file contains includes for project dependencies */
+#include <storage_bench/bake_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,189 @@
+#include <storage_bench.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Benchmarks that compare adding, removing and iterating a short-lived
+ * component (like a status effect) for the different storage kinds:
+ *  - table:    regular component, stored in table columns
+ *  - sparse:   Sparse component, stored in a sparse set but still fragmenting
+ *  - dontfrag: DontFragment component, stored in a sparse set and doesn't
+ *              change the table of the entity
+ *
+ * Entities are spread out over a number of tables so that adding/removing a
+ * fragmenting component has to move entities between tables, which is what
+ * typically happens in an application.
+ *
+ * Usage: storage_bench [max_count] */
+
+#define BENCH_MIN_OPS (4 * 1000 * 1000)
+#define BENCH_TABLE_COUNT (16)
+
+typedef struct {
+    float x, y;
+} Position, Velocity;
+
+typedef struct {
+    float value;
+} Status;
+
+typedef enum bench_storage_t {
+    BenchTable,
+    BenchSparse,
+    BenchDontFragment
+} bench_storage_t;
+
+static const char *bench_storage_str[] = {
+    "table", "sparse", "dontfrag"
+};
+
+static
+double bench_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 * 1000.0 * 1000.0 + (double)ts.tv_nsec;
+}
+
+static
+double bench_ns(
+    double ns,
+    int64_t ops)
+{
+    return ops ? ns / (double)ops : 0;
+}
+
+static
+double bench_iter(
+    ecs_world_t *world,
+    ecs_query_t *q,
+    int8_t field)
+{
+    double sum = 0;
+    ecs_iter_t it = ecs_query_iter(world, q);
+    while (ecs_query_next(&it)) {
+        int32_t i;
+        if (q->row_fields & (1u << field)) {
+            for (i = 0; i < it.count; i ++) {
+                sum += ecs_field_at(&it, Status, field, i)->value;
+            }
+        } else {
+            Status *s = ecs_field(&it, Status, field);
+            for (i = 0; i < it.count; i ++) {
+                sum += s[i].value;
+            }
+        }
+    }
+    return sum;
+}
+
+static
+void bench_run(
+    bench_storage_t storage,
+    int32_t count,
+    int32_t stride)
+{
+    int32_t r, i, with_status = count / stride;
+    int32_t repeat = BENCH_MIN_OPS / with_status;
+    if (repeat < 1) {
+        repeat = 1;
+    }
+
+    int64_t ops = (int64_t)with_status * repeat;
+    double t_add = 0, t_iter = 0, t_iter_w = 0, t_remove = 0, sum = 0;
+    int32_t tables_added = 0;
+
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Status);
+
+    if (storage == BenchSparse) {
+        ecs_add_id(world, ecs_id(Status), EcsSparse);
+    } else if (storage == BenchDontFragment) {
+        ecs_add_id(world, ecs_id(Status), EcsDontFragment);
+    }
+
+    ecs_entity_t tags[BENCH_TABLE_COUNT];
+    for (i = 0; i < BENCH_TABLE_COUNT; i ++) {
+        tags[i] = ecs_new(world);
+    }
+
+    ecs_entity_t *entities = ecs_os_malloc_n(ecs_entity_t, count);
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = entities[i] = ecs_new(world);
+        ecs_set(world, e, Position, {1, 2});
+        ecs_set(world, e, Velocity, {1, 2});
+        ecs_add_id(world, e, tags[i % BENCH_TABLE_COUNT]);
+    }
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ ecs_id(Status) }}
+    });
+
+    ecs_query_t *q_w = ecs_query(world, {
+        .terms = {{ ecs_id(Velocity) }, { ecs_id(Status) }}
+    });
+
+    int32_t table_count = ecs_get_world_info(world)->table_count;
+
+    for (r = 0; r < repeat; r ++) {
+        double t = bench_now(), t_end;
+        for (i = 0; i < count; i += stride) {
+            ecs_set(world, entities[i], Status, {1});
+        }
+        t_add += (t_end = bench_now()) - t;
+
+        t = t_end;
+        sum += bench_iter(world, q, 0);
+        t_iter += (t_end = bench_now()) - t;
+
+        t = t_end;
+        sum += bench_iter(world, q_w, 1);
+        t_iter_w += (t_end = bench_now()) - t;
+
+        t = t_end;
+        for (i = 0; i < count; i += stride) {
+            ecs_remove(world, entities[i], Status);
+        }
+        t_remove += bench_now() - t;
+    }
+
+    tables_added = ecs_get_world_info(world)->table_count - table_count;
+
+    printf("%-9s %9d %6d%% %9.2f %9.2f %9.2f %9.2f %7d   (%d)\n",
+        bench_storage_str[storage], count, 100 / stride,
+        bench_ns(t_add, ops), bench_ns(t_iter, ops), bench_ns(t_iter_w, ops),
+        bench_ns(t_remove, ops), tables_added, (int)sum & 0xFF);
+
+    ecs_query_fini(q);
+    ecs_query_fini(q_w);
+    ecs_os_free(entities);
+    ecs_fini(world);
+}
+
+int main(int argc, char *argv[]) {
+    int32_t max_count = 1000 * 1000;
+    if (argc > 1) {
+        max_count = atoi(argv[1]);
+    }
+
+    ecs_os_set_api_defaults();
+    ecs_os_init();
+
+    printf("%-9s %9s %7s %9s %9s %9s %9s %7s   (ns/op)\n",
+        "storage", "count", "with", "add", "iter", "iter_w", "remove",
+        "tables");
+
+    int32_t count, stride;
+    for (count = 10 * 1000; count <= max_count; count *= 10) {
+        for (stride = 1; stride <= 10; stride *= 10) {
+            bench_run(BenchTable, count, stride);
+            bench_run(BenchSparse, count, stride);
+            bench_run(BenchDontFragment, count, stride);
+        }
+    }
+
+    ecs_os_fini();
+    return 0;
+}
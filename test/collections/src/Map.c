@@ -497,3 +497,34 @@ void Map_randomized_after_clear(void) {
 
     ecs_os_free(keys);
 }
+
+void Map_ensure_ptr_stable(void) {
+    uint64_t *keys = generate_random_keys(1000);
+    uint64_t **ptrs = ecs_os_malloc_n(uint64_t*, 1000);
+
+    ecs_map_t map;
+    ecs_map_init(&map, NULL);
+
+    for (int i = 0; i < 1000; i ++) {
+        ptrs[i] = ecs_map_ensure(&map, keys[i]);
+        *ptrs[i] = keys[i];
+    }
+
+    /* Grow the map and leave deleted slots behind, values must not move */
+    for (int i = 0; i < 1000; i += 2) {
+        test_assert(ecs_map_remove(&map, keys[i]) == keys[i]);
+    }
+
+    for (int i = 0; i < 4000; i ++) {
+        ecs_map_insert(&map, i + 1000000, i);
+    }
+
+    for (int i = 1; i < 1000; i += 2) {
+        test_assert(ecs_map_get(&map, keys[i]) == ptrs[i]);
+        test_assert(*ptrs[i] == keys[i]);
+    }
+
+    ecs_map_fini(&map);
+    ecs_os_free(ptrs);
+    ecs_os_free(keys);
+}
@@ -39,6 +39,7 @@ void Map_randomized_remove(void);
 void Map_randomized_insert_large(void);
 void Map_randomized_remove_large(void);
 void Map_randomized_after_clear(void);
+void Map_ensure_ptr_stable(void);
 
 // Testsuite 'Sparse'
 void Sparse_setup(void);
@@ -223,6 +224,10 @@ bake_test_case Map_testcases[] = {
     {
         "randomized_after_clear",
         Map_randomized_after_clear
+    },
+    {
+        "ensure_ptr_stable",
+        Map_ensure_ptr_stable
     }
 };
 
@@ -473,7 +478,7 @@ static bake_test_suite suites[] = {
         "Map",
         Map_setup,
         NULL,
-        29,
+        30,
         Map_testcases
     },
     {
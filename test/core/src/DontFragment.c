@@ -0,0 +1,779 @@
+#include <core.h>
+
+void DontFragment_has(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    test_bool(false, ecs_has(world, e, Position));
+
+    ecs_add(world, e, Position);
+    test_bool(true, ecs_has(world, e, Position));
+    test_bool(true, ecs_owns(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_get(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    test_assert(NULL == ecs_get(world, e, Position));
+    test_assert(NULL == ecs_get_mut(world, e, Position));
+
+    ecs_add(world, e, Position);
+    test_assert(NULL != ecs_get(world, e, Position));
+    test_assert(ecs_get(world, e, Position) == ecs_get_mut(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_set(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, Position, {10, 20});
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_set(world, e, Position, {30, 40});
+    test_assert(p == ecs_get(world, e, Position));
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void DontFragment_ensure(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    Position *p = ecs_ensure(world, e, Position);
+    test_assert(p != NULL);
+    test_assert(p == ecs_ensure(world, e, Position));
+    test_assert(p == ecs_get_mut(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_emplace(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+
+    bool is_new;
+    Position *p = ecs_emplace(world, e, Position, &is_new);
+    test_assert(p != NULL);
+    test_bool(true, is_new);
+
+    test_assert(p == ecs_emplace(world, e, Position, &is_new));
+    test_bool(false, is_new);
+
+    ecs_fini(world);
+}
+
+void DontFragment_remove(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, Position, {10, 20});
+    test_bool(true, ecs_has(world, e, Position));
+
+    ecs_remove(world, e, Position);
+    test_bool(false, ecs_has(world, e, Position));
+    test_assert(NULL == ecs_get(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_add_doesnt_change_table(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+    ecs_table_t *table = ecs_get_table(world, e);
+    test_assert(table != NULL);
+
+    ecs_add(world, e, Position);
+    test_assert(table == ecs_get_table(world, e));
+    test_bool(true, ecs_has(world, e, Position));
+    test_bool(true, ecs_has(world, e, Velocity));
+
+    ecs_remove(world, e, Position);
+    test_assert(table == ecs_get_table(world, e));
+    test_bool(false, ecs_has(world, e, Position));
+    test_bool(true, ecs_has(world, e, Velocity));
+
+    ecs_fini(world);
+}
+
+void DontFragment_add_to_empty_entity(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    test_assert(ecs_get_table(world, e) == NULL);
+
+    ecs_set(world, e, Position, {10, 20});
+    test_bool(true, ecs_has(world, e, Position));
+
+    /* Entity is stored in the root table */
+    const ecs_type_t *type = ecs_get_type(world, e);
+    test_assert(type != NULL);
+    test_int(type->count, 0);
+
+    ecs_remove(world, e, Position);
+    test_bool(false, ecs_has(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_not_in_type(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+    ecs_add(world, e, Position);
+
+    const ecs_type_t *type = ecs_get_type(world, e);
+    test_assert(type != NULL);
+    test_int(type->count, 1);
+    test_uint(type->array[0], ecs_id(Velocity));
+
+    ecs_fini(world);
+}
+
+void DontFragment_clear(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+    ecs_set(world, e, Position, {10, 20});
+
+    ecs_clear(world, e);
+    test_bool(false, ecs_has(world, e, Position));
+    test_bool(false, ecs_has(world, e, Velocity));
+
+    ecs_fini(world);
+}
+
+void DontFragment_delete(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, Position, {10, 20});
+
+    ecs_delete(world, e);
+    test_bool(false, ecs_is_alive(world, e));
+
+    ecs_entity_t e2 = ecs_new(world);
+    test_assert((uint32_t)e2 == (uint32_t)e);
+    test_bool(false, ecs_has(world, e2, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_delete_parent(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t parent = ecs_new(world);
+    ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_set(world, child, Position, {10, 20});
+
+    ecs_delete(world, parent);
+    test_bool(false, ecs_is_alive(world, parent));
+    test_bool(false, ecs_is_alive(world, child));
+
+    ecs_entity_t e = ecs_new(world);
+    test_bool(false, ecs_has(world, e, Position));
+    e = ecs_new(world);
+    test_bool(false, ecs_has(world, e, Position));
+
+    ecs_fini(world);
+}
+
+static int position_ctor_invoked = 0;
+static int position_dtor_invoked = 0;
+static int position_on_add_invoked = 0;
+static int position_on_remove_invoked = 0;
+static int position_on_set_invoked = 0;
+
+static ECS_CTOR(Position, ptr, {
+    position_ctor_invoked ++;
+    ptr->x = 10;
+    ptr->y = 20;
+})
+
+static ECS_DTOR(Position, ptr, {
+    position_dtor_invoked ++;
+})
+
+static void Position_on_add(ecs_iter_t *it) {
+    test_int(1, position_ctor_invoked);
+    Position *p = ecs_field_at(it, Position, 0, 0);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+    test_uint(it->event, EcsOnAdd);
+    position_on_add_invoked ++;
+}
+
+static void Position_on_remove(ecs_iter_t *it) {
+    test_int(0, position_dtor_invoked);
+    Position *p = ecs_field_at(it, Position, 0, 0);
+    test_assert(p != NULL);
+    test_uint(it->event, EcsOnRemove);
+    position_on_remove_invoked ++;
+}
+
+static void Position_on_set(ecs_iter_t *it) {
+    Position *p = ecs_field_at(it, Position, 0, 0);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+    test_uint(it->event, EcsOnSet);
+    position_on_set_invoked ++;
+}
+
+void DontFragment_ctor_dtor(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_hooks(world, Position, {
+        .ctor = ecs_ctor(Position),
+        .dtor = ecs_dtor(Position)
+    });
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_add(world, e, Position);
+    test_int(1, position_ctor_invoked);
+    test_int(0, position_dtor_invoked);
+
+    ecs_remove(world, e, Position);
+    test_int(1, position_ctor_invoked);
+    test_int(1, position_dtor_invoked);
+
+    ecs_add(world, e, Position);
+    test_int(2, position_ctor_invoked);
+    test_int(1, position_dtor_invoked);
+
+    ecs_delete(world, e);
+    test_int(2, position_ctor_invoked);
+    test_int(2, position_dtor_invoked);
+
+    ecs_fini(world);
+}
+
+void DontFragment_dtor_after_fini(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_hooks(world, Position, {
+        .ctor = ecs_ctor(Position),
+        .dtor = ecs_dtor(Position)
+    });
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_add(world, e1, Position);
+    ecs_entity_t e2 = ecs_new_w_id(world, EcsPrefab);
+    ecs_add(world, e2, Position);
+    test_int(2, position_ctor_invoked);
+    test_int(0, position_dtor_invoked);
+
+    ecs_fini(world);
+
+    test_int(2, position_ctor_invoked);
+    test_int(2, position_dtor_invoked);
+}
+
+void DontFragment_on_add_remove_hooks(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_set_hooks(world, Position, {
+        .ctor = ecs_ctor(Position),
+        .on_add = Position_on_add,
+        .on_remove = Position_on_remove
+    });
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+    ecs_add(world, e, Position);
+    test_int(1, position_on_add_invoked);
+    test_int(0, position_on_remove_invoked);
+
+    ecs_add(world, e, Position);
+    test_int(1, position_on_add_invoked);
+    test_int(0, position_on_remove_invoked);
+
+    ecs_remove(world, e, Position);
+    test_int(1, position_on_add_invoked);
+    test_int(1, position_on_remove_invoked);
+
+    ecs_fini(world);
+}
+
+void DontFragment_on_set_hook(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_hooks(world, Position, {
+        .on_set = Position_on_set
+    });
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, Position, {30, 40});
+    test_int(1, position_on_set_invoked);
+
+    Position *p = ecs_ensure(world, e, Position);
+    test_assert(p != NULL);
+    test_int(1, position_on_set_invoked);
+    ecs_modified(world, e, Position);
+    test_int(2, position_on_set_invoked);
+
+    ecs_fini(world);
+}
+
+static
+void Position_observer(ecs_iter_t *it) {
+    probe_iter(it);
+    test_int(it->count, 1);
+    Position *p = ecs_field_at(it, Position, 0, 0);
+    test_assert(p != NULL);
+}
+
+void DontFragment_on_add_observer(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    Probe ctx = {0};
+    ecs_observer(world, {
+        .query.terms = {{ .id = ecs_id(Position) }},
+        .events = {EcsOnAdd},
+        .callback = Position_observer,
+        .ctx = &ctx
+    });
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+    test_int(ctx.invoked, 0);
+
+    ecs_add(world, e, Position);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1);
+    test_uint(ctx.event, EcsOnAdd);
+    test_uint(ctx.e[0], e);
+    test_uint(ctx.c[0][0], ecs_id(Position));
+
+    ecs_add(world, e, Position);
+    test_int(ctx.invoked, 1);
+
+    ecs_fini(world);
+}
+
+void DontFragment_on_set_observer(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    Probe ctx = {0};
+    ecs_observer(world, {
+        .query.terms = {{ .id = ecs_id(Position) }},
+        .events = {EcsOnSet},
+        .callback = Position_observer,
+        .ctx = &ctx
+    });
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+    ecs_add(world, e, Position);
+    test_int(ctx.invoked, 0);
+
+    ecs_set(world, e, Position, {10, 20});
+    test_int(ctx.invoked, 1);
+    test_uint(ctx.event, EcsOnSet);
+    test_uint(ctx.e[0], e);
+
+    ecs_modified(world, e, Position);
+    test_int(ctx.invoked, 2);
+
+    ecs_fini(world);
+}
+
+void DontFragment_on_remove_observer(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    Probe ctx = {0};
+    ecs_observer(world, {
+        .query.terms = {{ .id = ecs_id(Position) }},
+        .events = {EcsOnRemove},
+        .callback = Position_observer,
+        .ctx = &ctx
+    });
+
+    ecs_entity_t e1 = ecs_new_w(world, Velocity);
+    ecs_entity_t e2 = ecs_new_w(world, Velocity);
+    ecs_add(world, e1, Position);
+    ecs_add(world, e2, Position);
+    test_int(ctx.invoked, 0);
+
+    ecs_remove(world, e1, Position);
+    test_int(ctx.invoked, 1);
+    test_uint(ctx.e[0], e1);
+
+    ecs_delete(world, e2);
+    test_int(ctx.invoked, 2);
+
+    ecs_fini(world);
+}
+
+void DontFragment_defer_add(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+
+    ecs_defer_begin(world);
+    ecs_add(world, e, Position);
+    ecs_add(world, e, Velocity);
+    test_bool(false, ecs_has(world, e, Position));
+    ecs_defer_end(world);
+
+    test_bool(true, ecs_has(world, e, Position));
+    test_bool(true, ecs_has(world, e, Velocity));
+    test_int(ecs_get_type(world, e)->count, 1);
+
+    ecs_fini(world);
+}
+
+void DontFragment_defer_set(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+    ecs_defer_end(world);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
+
+void DontFragment_defer_remove(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, Position, {10, 20});
+
+    ecs_defer_begin(world);
+    ecs_remove(world, e, Position);
+    test_bool(true, ecs_has(world, e, Position));
+    ecs_defer_end(world);
+
+    test_bool(false, ecs_has(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_defer_set_remove(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(world);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_remove(world, e, Position);
+    ecs_defer_end(world);
+
+    test_bool(false, ecs_has(world, e, Position));
+
+    ecs_defer_begin(world);
+    ecs_remove(world, e, Position);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_defer_end(world);
+
+    test_bool(true, ecs_has(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_defer_set_clear(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_clear(world, e);
+    ecs_defer_end(world);
+
+    test_bool(false, ecs_has(world, e, Position));
+    test_bool(false, ecs_has(world, e, Velocity));
+
+    ecs_defer_begin(world);
+    ecs_clear(world, e);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_defer_end(world);
+
+    test_bool(true, ecs_has(world, e, Position));
+
+    ecs_fini(world);
+}
+
+void DontFragment_entity_init_w_add(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_entity(world, {
+        .add = ecs_ids(ecs_id(Position), ecs_id(Velocity))
+    });
+
+    test_bool(true, ecs_has(world, e, Position));
+    test_bool(true, ecs_has(world, e, Velocity));
+    test_int(ecs_get_type(world, e)->count, 1);
+
+    ecs_fini(world);
+}
+
+void DontFragment_entity_init_w_set(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_entity(world, {
+        .set = ecs_values(
+            ecs_value(Position, {10, 20}),
+            ecs_value(Velocity, {1, 2}))
+    });
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
+
+void DontFragment_no_tables_created(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TAG(world, Tag);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new_w(world, Velocity);
+    ecs_add(world, e, Tag);
+
+    int32_t table_count = ecs_get_world_info(world)->table_count;
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_add(world, e, Position);
+        ecs_remove(world, e, Position);
+    }
+
+    test_int(table_count, ecs_get_world_info(world)->table_count);
+
+    ecs_fini(world);
+}
+
+void DontFragment_observers_empty_entity(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    Probe on_add = {0};
+    ecs_observer(world, {
+        .query.terms = {{ .id = ecs_id(Position) }},
+        .events = {EcsOnAdd},
+        .callback = Position_observer,
+        .ctx = &on_add
+    });
+
+    Probe on_set = {0};
+    ecs_observer(world, {
+        .query.terms = {{ .id = ecs_id(Position) }},
+        .events = {EcsOnSet},
+        .callback = Position_observer,
+        .ctx = &on_set
+    });
+
+    Probe on_remove = {0};
+    ecs_observer(world, {
+        .query.terms = {{ .id = ecs_id(Position) }},
+        .events = {EcsOnRemove},
+        .callback = Position_observer,
+        .ctx = &on_remove
+    });
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, Position, {10, 20});
+    test_int(on_add.invoked, 1);
+    test_uint(on_add.e[0], e);
+    test_int(on_set.invoked, 1);
+    test_uint(on_set.e[0], e);
+
+    ecs_delete(world, e);
+    test_int(on_remove.invoked, 1);
+    test_uint(on_remove.e[0], e);
+
+    ecs_fini(world);
+}
+
+void DontFragment_defer_set_empty_entity(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_add_id(world, ecs_id(Position), EcsDontFragment);
+
+    Probe ctx = {0};
+    ecs_observer(world, {
+        .query.terms = {{ .id = ecs_id(Position) }},
+        .events = {EcsOnSet},
+        .callback = Position_observer,
+        .ctx = &ctx
+    });
+
+    ecs_entity_t e = ecs_new(world);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+    ecs_defer_end(world);
+
+    test_int(ctx.invoked, 1);
+    test_uint(ctx.e[0], e);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
@@ -949,3 +949,217 @@ void Lookup_lookup_path_65_chars(void) {
 
     ecs_fini(world);
 }
+
+void Lookup_lookup_cached_after_rename(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t p = ecs_entity(world, { .name = "parent" });
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+    test_assert(ecs_has_pair(world, e, EcsChildOf, p));
+
+    test_assert(ecs_lookup(world, "parent.child") == e);
+    test_assert(ecs_lookup(world, "parent.child") == e);
+
+    ecs_set_name(world, e, "foo");
+    test_assert(ecs_lookup(world, "parent.child") == 0);
+    test_assert(ecs_lookup(world, "parent.foo") == e);
+
+    ecs_set_name(world, p, "bar");
+    test_assert(ecs_lookup(world, "parent.foo") == 0);
+    test_assert(ecs_lookup(world, "bar.foo") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_cached_after_reparent(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t p1 = ecs_entity(world, { .name = "p1" });
+    ecs_entity_t p2 = ecs_entity(world, { .name = "p2" });
+    ecs_entity_t e = ecs_entity(world, { .name = "p1.child" });
+
+    test_assert(ecs_lookup(world, "p1.child") == e);
+
+    ecs_add_pair(world, e, EcsChildOf, p2);
+    test_assert(ecs_lookup(world, "p1.child") == 0);
+    test_assert(ecs_lookup(world, "p2.child") == e);
+
+    ecs_remove_pair(world, e, EcsChildOf, p2);
+    test_assert(ecs_lookup(world, "p2.child") == 0);
+    test_assert(ecs_lookup(world, "child") == e);
+
+    (void)p1;
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_cached_after_delete(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t p = ecs_entity(world, { .name = "parent" });
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+
+    test_assert(ecs_lookup(world, "parent.child") == e);
+    test_assert(ecs_lookup(world, "parent") == p);
+
+    ecs_delete(world, p);
+    test_assert(!ecs_is_alive(world, e));
+    test_assert(ecs_lookup(world, "parent.child") == 0);
+    test_assert(ecs_lookup(world, "parent") == 0);
+
+    ecs_entity_t p_2 = ecs_entity(world, { .name = "parent" });
+    ecs_entity_t e_2 = ecs_entity(world, { .name = "parent.child" });
+    test_assert(ecs_lookup(world, "parent.child") == e_2);
+    test_assert(ecs_lookup(world, "parent") == p_2);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_cached_w_scope(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t p = ecs_entity(world, { .name = "parent" });
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+    ecs_entity_t c = ecs_entity(world, { .name = "child" });
+    test_assert(e != c);
+
+    test_assert(ecs_lookup(world, "child") == c);
+
+    ecs_entity_t old_scope = ecs_set_scope(world, p);
+    test_assert(ecs_lookup(world, "child") == e);
+    ecs_set_scope(world, old_scope);
+
+    test_assert(ecs_lookup(world, "child") == c);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_hashed(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+
+    uint64_t hash = ecs_path_hash("parent.child", NULL, NULL);
+    test_assert(hash != 0);
+
+    /* Not yet cached */
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == 0);
+
+    test_assert(ecs_lookup_hashed(world, hash, "parent.child", NULL, NULL) == e);
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == e);
+
+    /* Cache is shared with regular lookups */
+    test_assert(ecs_lookup(world, "parent.child") == e);
+
+    ecs_set_name(world, e, "foo");
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == 0);
+    test_assert(ecs_lookup_hashed(world, hash, "parent.child", NULL, NULL) == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_hashed_w_sep(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+
+    uint64_t hash = ecs_path_hash("::parent::child", "::", "::");
+    test_assert(hash != 0);
+    test_assert(hash != ecs_path_hash("::parent::child", NULL, NULL));
+
+    test_assert(ecs_lookup_hashed(
+        world, hash, "::parent::child", "::", "::") == e);
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == e);
+
+    test_assert(ecs_lookup_path_w_sep(
+        world, 0, "::parent::child", "::", "::", true) == e);
+    test_assert(ecs_lookup_path_w_sep(
+        world, 0, "parent::child", "::", "::", true) == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_hashed_builtin(void) {
+    ecs_world_t *world = ecs_mini();
+
+    uint64_t hash = ecs_path_hash("flecs.core.Component", NULL, NULL);
+    test_assert(ecs_lookup_hashed(world, hash, "flecs.core.Component", 
+        NULL, NULL) == ecs_id(EcsComponent));
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == 
+        ecs_id(EcsComponent));
+
+    /* Found through lookup path, not cached */
+    hash = ecs_path_hash("Component", NULL, NULL);
+    test_assert(ecs_lookup_hashed(world, hash, "Component", 
+        NULL, NULL) == ecs_id(EcsComponent));
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_hashed_w_scope(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t p = ecs_entity(world, { .name = "parent" });
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+    ecs_entity_t c = ecs_entity(world, { .name = "child" });
+    test_assert(e != c);
+
+    uint64_t hash = ecs_path_hash("child", NULL, NULL);
+    test_assert(ecs_lookup_hashed(world, hash, "child", NULL, NULL) == c);
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == c);
+
+    ecs_entity_t old_scope = ecs_set_scope(world, p);
+    test_assert(ecs_lookup_hashed(world, hash, "child", NULL, NULL) == e);
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == 0);
+    ecs_set_scope(world, old_scope);
+
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == c);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_hashed_w_lookup_path(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t p = ecs_entity(world, { .name = "parent" });
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+
+    uint64_t hash = ecs_path_hash("parent.child", NULL, NULL);
+    test_assert(ecs_lookup_hashed(world, hash, "parent.child", NULL, NULL) == e);
+
+    ecs_entity_t lookup_path[] = { p, 0 };
+    ecs_entity_t *old_path = ecs_set_lookup_path(world, lookup_path);
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == 0);
+    test_assert(ecs_lookup_hashed(world, hash, "parent.child", NULL, NULL) == e);
+    ecs_set_lookup_path(world, old_path);
+
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_cached_after_set_other_name(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t p = ecs_entity(world, { .name = "parent" });
+    ecs_entity_t e = ecs_entity(world, { .name = "parent.child" });
+    ecs_entity_t other = ecs_entity(world, { .name = "other" });
+
+    uint64_t hash = ecs_path_hash("parent.child", NULL, NULL);
+    test_assert(ecs_lookup_hashed(world, hash, "parent.child", NULL, NULL) == e);
+
+    /* Names that aren't on the cached path don't invalidate the cache */
+    ecs_entity(world, { .name = "parent.sibling" });
+    ecs_entity(world, { .name = "foo" });
+    ecs_set_name(world, other, "bar");
+    ecs_add_pair(world, other, EcsChildOf, p);
+    ecs_delete(world, other);
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == e);
+
+    ecs_set_name(world, p, "new_parent");
+    test_assert(ecs_lookup_hashed(world, hash, NULL, NULL, NULL) == 0);
+    test_assert(ecs_lookup(world, "new_parent.child") == e);
+
+    ecs_fini(world);
+}
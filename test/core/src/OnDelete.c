@@ -3365,3 +3365,277 @@ void OnDelete_delete_with_3(void) {
 
     ecs_fini(world);
 }
+
+typedef struct DtorFlag {
+    int32_t *dtor_count;
+} DtorFlag;
+
+static ECS_COMPONENT_DECLARE(DtorFlag);
+
+static
+void DtorFlag_dtor(void *ptr, int32_t count, const ecs_type_info_t *ti) {
+    DtorFlag *flags = ptr;
+    for (int i = 0; i < count; i ++) {
+        if (flags[i].dtor_count) {
+            flags[i].dtor_count[0] ++;
+        }
+    }
+}
+
+static
+void DtorFlag_on_remove(ecs_iter_t *it) {
+    DtorFlag *flags = ecs_field(it, DtorFlag, 0);
+    for (int i = 0; i < it->count; i ++) {
+        /* Component must not be destructed before on_remove hook */
+        test_int(flags[i].dtor_count[0], 0);
+    }
+}
+
+static
+void dtor_flag_register(
+    ecs_world_t *world, 
+    ecs_iter_action_t on_remove, 
+    bool thread_safe)
+{
+    ECS_COMPONENT_DEFINE(world, DtorFlag);
+    ecs_set_hooks(world, DtorFlag, {
+        .ctor = flecs_default_ctor,
+        .dtor = DtorFlag_dtor,
+        .on_remove = on_remove,
+        .flags = thread_safe ? ECS_TYPE_HOOK_DTOR_THREAD_SAFE : 0
+    });
+}
+
+static
+void dtor_flag_delete_children(int32_t child_count, int32_t table_count) {
+    ecs_world_t *world = ecs_mini();
+
+    dtor_flag_register(world, NULL, true);
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    ecs_set_stage_count(world, 4);
+    ecs_enable_threaded_dtors(world, true);
+
+    int32_t *dtor_counts = ecs_os_calloc_n(int32_t, child_count);
+    ecs_entity_t *children = ecs_os_malloc_n(ecs_entity_t, child_count);
+
+    ecs_entity_t parent = ecs_new(world);
+    for (int i = 0; i < child_count; i ++) {
+        ecs_entity_t child = children[i] = ecs_new_w_pair(world, EcsChildOf, parent);
+        ecs_set(world, child, DtorFlag, { &dtor_counts[i] });
+        if ((i % table_count) & 1) {
+            ecs_add(world, child, TagA);
+        }
+        if ((i % table_count) & 2) {
+            ecs_add(world, child, TagB);
+        }
+    }
+
+    ecs_delete(world, parent);
+    test_assert(!ecs_is_alive(world, parent));
+
+    for (int i = 0; i < child_count; i ++) {
+        test_assert(!ecs_is_alive(world, children[i]));
+        test_int(dtor_counts[i], 1);
+    }
+
+    test_int(ecs_count(world, DtorFlag), 0);
+
+    ecs_os_free(children);
+    ecs_os_free(dtor_counts);
+
+    ecs_fini(world);
+}
+
+void OnDelete_delete_children_w_dtor_multi_stage(void) {
+    dtor_flag_delete_children(64, 4);
+}
+
+void OnDelete_delete_large_hierarchy_w_dtor_multi_stage(void) {
+    dtor_flag_delete_children(20000, 4);
+}
+
+void OnDelete_delete_with_w_dtor_multi_stage(void) {
+    ecs_world_t *world = ecs_mini();
+
+    dtor_flag_register(world, NULL, true);
+    ECS_TAG(world, Tag);
+    ECS_TAG(world, Foo);
+
+    ecs_set_stage_count(world, 2);
+    ecs_enable_threaded_dtors(world, true);
+
+    int32_t dtor_counts[3] = {0};
+    ecs_entity_t e1 = ecs_new_w(world, Tag);
+    ecs_set(world, e1, DtorFlag, { &dtor_counts[0] });
+    ecs_entity_t e2 = ecs_new_w(world, Tag);
+    ecs_set(world, e2, DtorFlag, { &dtor_counts[1] });
+    ecs_add(world, e2, Foo);
+    ecs_entity_t e3 = ecs_new(world);
+    ecs_set(world, e3, DtorFlag, { &dtor_counts[2] });
+
+    ecs_delete_with(world, Tag);
+
+    test_assert(!ecs_is_alive(world, e1));
+    test_assert(!ecs_is_alive(world, e2));
+    test_assert(ecs_is_alive(world, e3));
+    test_int(dtor_counts[0], 1);
+    test_int(dtor_counts[1], 1);
+    test_int(dtor_counts[2], 0);
+
+    ecs_fini(world);
+
+    test_int(dtor_counts[2], 1);
+}
+
+void OnDelete_delete_deep_hierarchy(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t root = ecs_new(world);
+    ecs_entity_t parent = root;
+    for (int i = 0; i < 100; i ++) {
+        for (int j = 0; j < 10; j ++) {
+            ecs_entity_t e = ecs_new_w_pair(world, EcsChildOf, parent);
+            ecs_set(world, e, Position, {i, j});
+        }
+
+        parent = ecs_new_w_pair(world, EcsChildOf, parent);
+        ecs_set(world, parent, Position, {i, i});
+    }
+
+    ecs_entity_t leaf = parent;
+
+    ecs_delete(world, root);
+    test_assert(!ecs_is_alive(world, root));
+    test_assert(!ecs_is_alive(world, leaf));
+    test_int(ecs_count(world, Position), 0);
+
+    ecs_fini(world);
+}
+
+static
+void DtorFlag_on_remove_order(ecs_iter_t *it) {
+    ecs_vec_t *order = it->ctx;
+    for (int i = 0; i < it->count; i ++) {
+        ecs_vec_append_t(NULL, order, ecs_entity_t)[0] = it->entities[i];
+    }
+}
+
+void OnDelete_on_remove_before_dtor_multi_stage(void) {
+    ecs_world_t *world = ecs_mini();
+
+    dtor_flag_register(world, DtorFlag_on_remove, true);
+
+    ecs_set_stage_count(world, 2);
+    ecs_enable_threaded_dtors(world, true);
+
+    ecs_vec_t order;
+    ecs_vec_init_t(NULL, &order, ecs_entity_t, 0);
+
+    ecs_observer(world, {
+        .query.terms = {{ ecs_id(DtorFlag) }},
+        .events = { EcsOnRemove },
+        .callback = DtorFlag_on_remove_order,
+        .ctx = &order
+    });
+
+    int32_t dtor_counts[3] = {0};
+    ecs_entity_t parent = ecs_new(world);
+    ecs_set(world, parent, DtorFlag, { &dtor_counts[0] });
+    ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_set(world, child, DtorFlag, { &dtor_counts[1] });
+    ecs_entity_t grand_child = ecs_new_w_pair(world, EcsChildOf, child);
+    ecs_set(world, grand_child, DtorFlag, { &dtor_counts[2] });
+
+    ecs_delete(world, parent);
+
+    test_int(dtor_counts[0], 1);
+    test_int(dtor_counts[1], 1);
+    test_int(dtor_counts[2], 1);
+
+    /* Children are notified before their parents */
+    test_int(ecs_vec_count(&order), 3);
+    ecs_entity_t *entities = ecs_vec_first(&order);
+    test_uint(entities[0], grand_child);
+    test_uint(entities[1], child);
+    test_uint(entities[2], parent);
+
+    ecs_vec_fini_t(NULL, &order, ecs_entity_t);
+
+    ecs_fini(world);
+}
+
+typedef struct dtor_on_parent_remove_t {
+    ecs_entity_t parent;
+    int32_t *child_dtor_count;
+    int32_t child_dtor_count_on_remove;
+} dtor_on_parent_remove_t;
+
+static
+void DtorFlag_on_parent_remove(ecs_iter_t *it) {
+    dtor_on_parent_remove_t *ctx = it->ctx;
+    for (int i = 0; i < it->count; i ++) {
+        if (it->entities[i] == ctx->parent) {
+            ctx->child_dtor_count_on_remove = ctx->child_dtor_count[0];
+        }
+    }
+}
+
+/* Returns the number of times the dtor of the child ran before the OnRemove
+ * observer of its parent was invoked. Both are deleted by the cleanup action
+ * of the root. */
+static
+int32_t dtor_count_on_parent_remove(bool enable, bool thread_safe) {
+    ecs_world_t *world = ecs_mini();
+
+    dtor_flag_register(world, NULL, thread_safe);
+
+    ecs_set_stage_count(world, 2);
+    if (enable) {
+        ecs_enable_threaded_dtors(world, true);
+    }
+
+    int32_t dtor_counts[2] = {0};
+    ecs_entity_t root = ecs_new(world);
+    ecs_entity_t parent = ecs_new_w_pair(world, EcsChildOf, root);
+    ecs_set(world, parent, DtorFlag, { &dtor_counts[0] });
+    ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_set(world, child, DtorFlag, { &dtor_counts[1] });
+
+    dtor_on_parent_remove_t ctx = { parent, &dtor_counts[1], -1 };
+    ecs_observer(world, {
+        .query.terms = {{ ecs_id(DtorFlag) }},
+        .events = { EcsOnRemove },
+        .callback = DtorFlag_on_parent_remove,
+        .ctx = &ctx
+    });
+
+    ecs_delete(world, root);
+
+    test_assert(!ecs_is_alive(world, parent));
+    test_assert(!ecs_is_alive(world, child));
+    test_int(dtor_counts[0], 1);
+    test_int(dtor_counts[1], 1);
+
+    ecs_fini(world);
+
+    return ctx.child_dtor_count_on_remove;
+}
+
+void OnDelete_threaded_dtors_disabled_by_default(void) {
+    /* Child is destructed inline, before the parent is removed */
+    test_int(dtor_count_on_parent_remove(false, true), 1);
+}
+
+void OnDelete_threaded_dtors_after_on_remove(void) {
+    /* Child is destructed after all tables are cleared */
+    test_int(dtor_count_on_parent_remove(true, true), 0);
+}
+
+void OnDelete_threaded_dtors_not_thread_safe(void) {
+    /* Components without thread safe dtor are destructed inline */
+    test_int(dtor_count_on_parent_remove(true, false), 1);
+}
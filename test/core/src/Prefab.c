@@ -5133,3 +5133,241 @@ void Prefab_prefab_w_union_and_component(void) {
 
     ecs_fini(world);
 }
+
+void Prefab_instantiate_n(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_new_w_id(world, EcsPrefab);
+    ecs_set(world, base, Position, {10, 20});
+
+    const ecs_entity_t *ids = ecs_instantiate_n(world, base, 10);
+    test_assert(ids != NULL);
+
+    ecs_entity_t instances[10];
+    ecs_os_memcpy_n(instances, ids, ecs_entity_t, 10);
+
+    for (int i = 0; i < 10; i ++) {
+        ecs_entity_t inst = instances[i];
+        test_assert(inst != 0);
+        test_assert(ecs_has_pair(world, inst, EcsIsA, base));
+        test_assert(!ecs_has_id(world, inst, EcsPrefab));
+
+        const Position *p = ecs_get(world, inst, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_instantiate_n_w_children(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t base = ecs_entity(world, { .name = "Base", .add = ecs_ids( EcsPrefab ) });
+    ecs_entity_t child_1 = ecs_entity(world, { .name = "Base.Child1" });
+    ecs_set(world, child_1, Position, {1, 2});
+    ecs_entity_t child_2 = ecs_entity(world, { .name = "Base.Child2" });
+    ecs_set(world, child_2, Position, {3, 4});
+    ecs_entity_t child_3 = ecs_entity(world, { .name = "Base.Child3" });
+    ecs_set(world, child_3, Velocity, {5, 6});
+
+    ecs_entity_t instances[5];
+    ecs_os_memcpy_n(instances, ecs_instantiate_n(world, base, 5), 
+        ecs_entity_t, 5);
+
+    for (int i = 0; i < 5; i ++) {
+        ecs_entity_t inst = instances[i];
+
+        ecs_entity_t inst_child_1 = ecs_lookup_child(world, inst, "Child1");
+        test_assert(inst_child_1 != 0);
+        test_assert(ecs_has_pair(world, inst_child_1, EcsChildOf, inst));
+        test_assert(!ecs_has_id(world, inst_child_1, EcsPrefab));
+        const Position *p = ecs_get(world, inst_child_1, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 1);
+        test_int(p->y, 2);
+
+        ecs_entity_t inst_child_2 = ecs_lookup_child(world, inst, "Child2");
+        test_assert(inst_child_2 != 0);
+        test_assert(ecs_has_pair(world, inst_child_2, EcsChildOf, inst));
+        p = ecs_get(world, inst_child_2, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 3);
+        test_int(p->y, 4);
+
+        ecs_entity_t inst_child_3 = ecs_lookup_child(world, inst, "Child3");
+        test_assert(inst_child_3 != 0);
+        test_assert(ecs_has_pair(world, inst_child_3, EcsChildOf, inst));
+        const Velocity *v = ecs_get(world, inst_child_3, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 5);
+        test_int(v->y, 6);
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_instantiate_n_w_nested_children(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_entity(world, { .name = "Base", .add = ecs_ids( EcsPrefab ) });
+    ecs_entity_t child = ecs_entity(world, { .name = "Base.Child", .add = ecs_ids( EcsPrefab ) });
+    ecs_set(world, child, Position, {1, 2});
+    ecs_entity_t grand_child = ecs_entity(world, { .name = "Base.Child.GrandChild", .add = ecs_ids( EcsPrefab ) });
+    ecs_set(world, grand_child, Position, {3, 4});
+    ecs_entity(world, { .name = "Base.Child.GrandChild.Leaf", .add = ecs_ids( EcsPrefab ) });
+
+    ecs_entity_t instances[8];
+    ecs_os_memcpy_n(instances, ecs_instantiate_n(world, base, 8), 
+        ecs_entity_t, 8);
+
+    for (int i = 0; i < 8; i ++) {
+        ecs_entity_t inst = instances[i];
+
+        ecs_entity_t inst_child = ecs_lookup_child(world, inst, "Child");
+        test_assert(inst_child != 0);
+        test_assert(ecs_has_pair(world, inst_child, EcsChildOf, inst));
+        test_assert(!ecs_has_id(world, inst_child, EcsPrefab));
+        const Position *p = ecs_get(world, inst_child, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 1);
+        test_int(p->y, 2);
+
+        ecs_entity_t inst_grand_child = ecs_lookup_child(
+            world, inst_child, "GrandChild");
+        test_assert(inst_grand_child != 0);
+        test_assert(ecs_has_pair(world, inst_grand_child, EcsChildOf, inst_child));
+        test_assert(!ecs_has_id(world, inst_grand_child, EcsPrefab));
+        p = ecs_get(world, inst_grand_child, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 3);
+        test_int(p->y, 4);
+
+        ecs_entity_t inst_leaf = ecs_lookup_child(
+            world, inst_grand_child, "Leaf");
+        test_assert(inst_leaf != 0);
+        test_assert(ecs_has_pair(world, inst_leaf, EcsChildOf, inst_grand_child));
+        test_assert(!ecs_has_id(world, inst_leaf, EcsPrefab));
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_instantiate_n_w_override(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_entity(world, { .name = "Base", .add = ecs_ids( EcsPrefab ) });
+    ecs_entity_t child = ecs_entity(world, { .name = "Base.Child" });
+    ecs_set(world, child, Position, {1, 2});
+    ecs_auto_override(world, child, Position);
+
+    ecs_entity_t instances[4];
+    ecs_os_memcpy_n(instances, ecs_instantiate_n(world, base, 4), 
+        ecs_entity_t, 4);
+
+    const Position *prev = NULL;
+    for (int i = 0; i < 4; i ++) {
+        ecs_entity_t inst_child = ecs_lookup_child(world, instances[i], "Child");
+        test_assert(inst_child != 0);
+        test_assert(ecs_owns(world, inst_child, Position));
+        const Position *p = ecs_get(world, inst_child, Position);
+        test_assert(p != NULL);
+        test_assert(p != prev);
+        test_int(p->x, 1);
+        test_int(p->y, 2);
+        prev = p;
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_instantiate_n_w_slot(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t base = ecs_entity(world, { .name = "Base", .add = ecs_ids( EcsPrefab ) });
+    ecs_entity_t base_slot = ecs_entity(world, { .name = "Base.Slot", .add = ecs_ids( EcsPrefab ) });
+    ecs_add_pair(world, base_slot, EcsSlotOf, base);
+
+    ecs_entity_t instances[3];
+    ecs_os_memcpy_n(instances, ecs_instantiate_n(world, base, 3), 
+        ecs_entity_t, 3);
+
+    for (int i = 0; i < 3; i ++) {
+        ecs_entity_t inst = instances[i];
+        ecs_entity_t inst_slot = ecs_get_target(world, inst, base_slot, 0);
+        test_assert(inst_slot != 0);
+        test_assert(inst_slot == ecs_lookup_child(world, inst, "Slot"));
+        test_assert(ecs_has_pair(world, inst_slot, EcsChildOf, inst));
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_instantiate_n_deferred(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_entity(world, { .name = "Base", .add = ecs_ids( EcsPrefab ) });
+    ecs_set(world, base, Position, {10, 20});
+    ecs_entity_t child = ecs_entity(world, { .name = "Base.Child" });
+    ecs_set(world, child, Position, {1, 2});
+
+    ecs_defer_begin(world);
+
+    ecs_entity_t instances[6];
+    ecs_os_memcpy_n(instances, ecs_instantiate_n(world, base, 6), 
+        ecs_entity_t, 6);
+
+    for (int i = 0; i < 6; i ++) {
+        test_assert(instances[i] != 0);
+        test_assert(!ecs_has_pair(world, instances[i], EcsIsA, base));
+    }
+
+    ecs_defer_end(world);
+
+    for (int i = 0; i < 6; i ++) {
+        ecs_entity_t inst = instances[i];
+        test_assert(ecs_has_pair(world, inst, EcsIsA, base));
+
+        const Position *p = ecs_get(world, inst, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+
+        ecs_entity_t inst_child = ecs_lookup_child(world, inst, "Child");
+        test_assert(inst_child != 0);
+        p = ecs_get(world, inst_child, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 1);
+        test_int(p->y, 2);
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_instantiate_n_zero(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t base = ecs_entity(world, { .name = "Base", .add = ecs_ids( EcsPrefab ) });
+    ecs_entity(world, { .name = "Base.Child" });
+
+    int32_t child_count = ecs_count_id(world, 
+        ecs_pair(EcsChildOf, EcsWildcard));
+    ecs_instantiate_n(world, base, 0);
+    test_int(ecs_count_id(world, ecs_pair(EcsIsA, base)), 0);
+    test_int(ecs_count_id(world, ecs_pair(EcsChildOf, EcsWildcard)), 
+        child_count);
+
+    ecs_fini(world);
+}
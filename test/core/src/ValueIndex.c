@@ -0,0 +1,686 @@
+#include <core.h>
+
+typedef struct NetworkId {
+    uint32_t value;
+} NetworkId;
+
+/* Component with a key and a value that isn't part of the key */
+typedef struct Keyed {
+    int32_t key;
+    float payload;
+} Keyed;
+
+static
+uint64_t Keyed_hash(const void *ptr) {
+    const Keyed *k = ptr;
+    return (uint64_t)k->key * 0x9E3779B97F4A7C15ull;
+}
+
+static
+int Keyed_compare(const void *ptr_1, const void *ptr_2) {
+    const Keyed *k_1 = ptr_1, *k_2 = ptr_2;
+    return (k_1->key > k_2->key) - (k_1->key < k_2->key);
+}
+
+void ValueIndex_setup(void) {
+    ecs_log_set_level(-3);
+}
+
+void ValueIndex_lookup(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    test_assert(ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    }) != 0);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {20});
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){20}), e2);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_not_found(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {20});
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_existing(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {20});
+    ecs_set(world, e2, Position, {1, 2});
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){20}), e2);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_after_set(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {10});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_set(world, e, NetworkId, {20});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){20}), e);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_after_modified(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {10});
+
+    NetworkId *id = ecs_ensure(world, e, NetworkId);
+    id->value = 20;
+
+    /* Not yet notified, but lookup doesn't return stale matches */
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+
+    ecs_modified(world, e, NetworkId);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){20}), e);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_after_remove(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {10});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_remove(world, e, NetworkId);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+
+    ecs_set(world, e, NetworkId, {10});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_after_delete(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {10});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_delete(world, e);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_after_table_move(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {20});
+
+    ecs_set(world, e1, Position, {1, 2});
+    ecs_add(world, e2, Tag);
+    ecs_remove(world, e1, Position);
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){20}), e2);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_duplicate_key(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {10});
+    ecs_entity_t e3 = ecs_new(world);
+    ecs_set(world, e3, NetworkId, {10});
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e1);
+
+    ecs_delete(world, e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e2);
+
+    ecs_set(world, e2, NetworkId, {20});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e3);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){20}), e2);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_deferred(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e = ecs_new(world);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e, NetworkId, {10});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), 0);
+    ecs_defer_end(world);
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_w_hash(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Keyed);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(Keyed),
+        .hash = Keyed_hash,
+        .compare = Keyed_compare
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, Keyed, {10, 1.0f});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, Keyed, {20, 2.0f});
+
+    /* Only the key is used for lookups */
+    test_uint(ecs_lookup_by_value(world, ecs_id(Keyed), &(Keyed){10, 5.0f}), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Keyed), &(Keyed){20}), e2);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Keyed), &(Keyed){30}), 0);
+
+    /* Changing the payload doesn't change the key */
+    ecs_set(world, e1, Keyed, {10, 3.0f});
+    test_uint(ecs_lookup_by_value(world, ecs_id(Keyed), &(Keyed){10}), e1);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_inherited(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t base = ecs_new(world);
+    ecs_set(world, base, NetworkId, {10});
+
+    ecs_entity_t inst = ecs_new_w_pair(world, EcsIsA, base);
+    test_assert(ecs_get(world, inst, NetworkId) != NULL);
+
+    /* Only owned components are indexed */
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), base);
+
+    /* Deleting the base copies the component to the instance */
+    ecs_delete(world, base);
+    test_assert(ecs_owns(world, inst, NetworkId));
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), inst);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_lookup_prefab(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t p = ecs_new_w_id(world, EcsPrefab);
+    ecs_set(world, p, NetworkId, {10});
+
+    ecs_entity_t e = ecs_new_w_id(world, EcsDisabled);
+    ecs_set(world, e, NetworkId, {20});
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), p);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){20}), e);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_delete_index(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_entity_t index = ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+    test_assert(index != 0);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {10});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_delete(world, index);
+
+    /* Component can be indexed again after the index is deleted */
+    index = ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+    test_assert(index != 0);
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_init_w_entity(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    ecs_entity_t index = ecs_entity(world, { .name = "NetworkIdIndex" });
+    test_uint(ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .entity = index,
+        .component = ecs_id(NetworkId)
+    }), index);
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {10});
+    test_uint(ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10}), e);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_init_twice(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    test_assert(ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    }) != 0);
+
+    test_expect_abort();
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+}
+
+void ValueIndex_init_tag(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_TAG(world, Tag);
+
+    test_expect_abort();
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = Tag
+    });
+}
+
+void ValueIndex_lookup_no_index(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+
+    test_expect_abort();
+    ecs_lookup_by_value(world, ecs_id(NetworkId), &(NetworkId){10});
+}
+
+void ValueIndex_query_set_var(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_set(world, e1, Position, {1, 2});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {20});
+    ecs_set(world, e2, Position, {3, 4});
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ ecs_id(NetworkId) }, { ecs_id(Position) }}
+    });
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, 0, ecs_id(NetworkId),
+        &(NetworkId){20}), e2);
+
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e2);
+    Position *p = ecs_field(&it, Position, 1);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+    test_bool(false, ecs_query_next(&it));
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_query_set_var_not_found(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e = ecs_new(world);
+    ecs_set(world, e, NetworkId, {10});
+    ecs_set(world, e, Position, {1, 2});
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ ecs_id(NetworkId) }, { ecs_id(Position) }}
+    });
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, 0, ecs_id(NetworkId),
+        &(NetworkId){20}), 0);
+    test_bool(false, ecs_query_next(&it));
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_query_set_var_no_match(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_set(world, e1, Position, {1, 2});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {20});
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ ecs_id(NetworkId) }, { ecs_id(Position) }}
+    });
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, 0, ecs_id(NetworkId),
+        &(NetworkId){20}), e2);
+    test_bool(false, ecs_query_next(&it));
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_query_set_var_cached(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_set(world, e1, Position, {1, 2});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {20});
+    ecs_set(world, e2, Position, {3, 4});
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ ecs_id(NetworkId) }, { ecs_id(Position) }},
+        .cache_kind = EcsQueryCacheAuto
+    });
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, 0, ecs_id(NetworkId),
+        &(NetworkId){10}), e1);
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e1);
+    test_bool(false, ecs_query_next(&it));
+
+    it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, 0, ecs_id(NetworkId),
+        &(NetworkId){30}), 0);
+    test_bool(false, ecs_query_next(&it));
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_query_set_var_duplicate_key(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_set(world, e1, Position, {1, 2});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, NetworkId, {10});
+    ecs_entity_t e3 = ecs_new_w(world, Tag);
+    ecs_set(world, e3, NetworkId, {10});
+    ecs_set(world, e3, Position, {5, 6});
+    ecs_entity_t e4 = ecs_new(world);
+    ecs_set(world, e4, NetworkId, {20});
+    ecs_set(world, e4, Position, {7, 8});
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ ecs_id(NetworkId) }, { ecs_id(Position) }}
+    });
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, 0, ecs_id(NetworkId),
+        &(NetworkId){10}), e1);
+
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e1);
+    Position *p = ecs_field(&it, Position, 1);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    /* e2 doesn't match the query */
+
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e3);
+    p = ecs_field(&it, Position, 1);
+    test_int(p->x, 5);
+    test_int(p->y, 6);
+
+    test_bool(false, ecs_query_next(&it));
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_query_set_var_duplicate_key_cached(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, NetworkId, {10});
+    ecs_set(world, e1, Position, {1, 2});
+    ecs_entity_t e2 = ecs_new_w(world, Tag);
+    ecs_set(world, e2, NetworkId, {10});
+    ecs_set(world, e2, Position, {3, 4});
+    ecs_entity_t e3 = ecs_new(world);
+    ecs_set(world, e3, NetworkId, {10});
+    ecs_set(world, e3, Position, {5, 6});
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ ecs_id(NetworkId) }, { ecs_id(Position) }},
+        .cache_kind = EcsQueryCacheAuto
+    });
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, 0, ecs_id(NetworkId),
+        &(NetworkId){10}), e1);
+
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e1);
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e2);
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e3);
+    test_bool(false, ecs_query_next(&it));
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_query_set_var_duplicate_key_w_var(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, NetworkId);
+    ECS_TAG(world, Likes);
+
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(NetworkId)
+    });
+
+    ecs_entity_t p1 = ecs_new(world);
+    ecs_set(world, p1, NetworkId, {10});
+    ecs_entity_t p2 = ecs_new(world);
+    ecs_set(world, p2, NetworkId, {10});
+    ecs_entity_t p3 = ecs_new(world);
+    ecs_set(world, p3, NetworkId, {20});
+
+    ecs_entity_t e1 = ecs_new_w_pair(world, Likes, p1);
+    ecs_entity_t e2 = ecs_new_w_pair(world, Likes, p2);
+    ecs_new_w_pair(world, Likes, p3);
+
+    ecs_query_t *q = ecs_query(world, {
+        .expr = "(Likes, $x)"
+    });
+
+    int32_t x_var = ecs_query_find_var(q, "x");
+    test_assert(x_var != -1);
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_uint(ecs_iter_set_var_by_value(&it, x_var, ecs_id(NetworkId),
+        &(NetworkId){10}), p1);
+
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e1);
+    test_uint(ecs_iter_get_var(&it, x_var), p1);
+    test_bool(true, ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_uint(it.entities[0], e2);
+    test_uint(ecs_iter_get_var(&it, x_var), p2);
+    test_bool(false, ecs_query_next(&it));
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
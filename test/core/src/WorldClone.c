@@ -0,0 +1,492 @@
+#include <core.h>
+
+typedef struct Name {
+    char *value;
+} Name;
+
+static int name_dtor_invoked = 0;
+
+static ECS_COPY(Name, dst, src, {
+    ecs_os_strset(&dst->value, src->value);
+})
+
+static ECS_MOVE(Name, dst, src, {
+    ecs_os_free(dst->value);
+    dst->value = src->value;
+    src->value = NULL;
+})
+
+static ECS_DTOR(Name, ptr, {
+    ecs_os_free(ptr->value);
+    name_dtor_invoked ++;
+})
+
+void WorldClone_clone_empty(void) {
+    ecs_world_t *template = ecs_init();
+
+    ecs_world_t *world = ecs_world_clone(template);
+    test_assert(world != NULL);
+    test_assert(world != template);
+
+    test_assert(ecs_lookup(world, "flecs.core") == EcsFlecsCore);
+    test_int(ecs_count_id(world, EcsAny), ecs_count_id(template, EcsAny));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_entities(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+    ECS_COMPONENT(template, Velocity);
+    ECS_TAG(template, Foo);
+
+    ecs_entity_t e1 = ecs_entity(template, { .name = "e1" });
+    ecs_set(template, e1, Position, {10, 20});
+    ecs_set(template, e1, Velocity, {1, 2});
+
+    ecs_entity_t e2 = ecs_entity(template, { .name = "e2" });
+    ecs_set(template, e2, Position, {30, 40});
+    ecs_add(template, e2, Foo);
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(ecs_is_alive(world, e1));
+    test_assert(ecs_is_alive(world, e2));
+    test_assert(ecs_lookup(world, "e1") == e1);
+    test_assert(ecs_lookup(world, "e2") == e2);
+    test_assert(ecs_lookup(world, "Position") == ecs_id(Position));
+    test_assert(ecs_lookup(world, "Foo") == Foo);
+
+    const EcsComponent *c = ecs_get(world, ecs_id(Position), EcsComponent);
+    test_assert(c != NULL);
+    test_int(c->size, ECS_SIZEOF(Position));
+
+    const Position *p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e1, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+    test_assert(ecs_has(world, e2, Foo));
+    test_assert(!ecs_has(world, e2, Velocity));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_is_independent(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+
+    ecs_entity_t e = ecs_new(template);
+    ecs_set(template, e, Position, {10, 20});
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    ecs_set(world, e, Position, {30, 40});
+    ecs_entity_t e2 = ecs_new_w(world, Position);
+    test_assert(!ecs_is_alive(template, e2));
+
+    const Position *p = ecs_get(template, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get(world, e, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_delete(world, e);
+    test_assert(ecs_is_alive(template, e));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_many_entities(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+    ECS_COMPONENT(template, Velocity);
+
+    const ecs_entity_t *ids = ecs_bulk_new(template, Position, 1000);
+    test_assert(ids != NULL);
+    ecs_entity_t first = ids[0];
+
+    int32_t i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_entity_t e = first + (ecs_entity_t)i;
+        ecs_set(template, e, Position, {(float)i, (float)-i});
+        if (i % 2) {
+            ecs_set(template, e, Velocity, {1, 1});
+        }
+    }
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    ecs_query_t *q = ecs_query(world, { .terms = {{ ecs_id(Position) }} });
+    test_int(1000, ecs_query_count(q).entities);
+    ecs_query_fini(q);
+
+    for (i = 0; i < 1000; i ++) {
+        ecs_entity_t e = first + (ecs_entity_t)i;
+        const Position *p = ecs_get(world, e, Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, -i);
+        test_bool(ecs_has(world, e, Velocity), (i % 2) != 0);
+    }
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_hierarchy(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+
+    ecs_entity_t parent = ecs_entity(template, { .name = "parent" });
+    ecs_entity_t child = ecs_entity(template, { .name = "parent.child" });
+    ecs_set(template, child, Position, {10, 20});
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(ecs_lookup(world, "parent") == parent);
+    test_assert(ecs_lookup(world, "parent.child") == child);
+    test_assert(ecs_get_target(world, child, EcsChildOf, 0) == parent);
+
+    ecs_delete(world, parent);
+    test_assert(!ecs_is_alive(world, child));
+    test_assert(ecs_is_alive(template, child));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_w_copy_hook(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Name);
+
+    ecs_set_hooks(template, Name, {
+        .ctor = flecs_default_ctor,
+        .copy = ecs_copy(Name),
+        .move = ecs_move(Name),
+        .dtor = ecs_dtor(Name)
+    });
+
+    ecs_entity_t e = ecs_new(template);
+    ecs_set(template, e, Name, { "foo" });
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    const Name *src = ecs_get(template, e, Name);
+    const Name *dst = ecs_get(world, e, Name);
+    test_assert(dst != NULL);
+    test_str(dst->value, "foo");
+    test_assert(dst->value != src->value);
+
+    name_dtor_invoked = 0;
+    ecs_fini(world);
+    test_assert(name_dtor_invoked != 0);
+    test_str(ecs_get(template, e, Name)->value, "foo");
+
+    ecs_fini(template);
+}
+
+void WorldClone_clone_skip_dtor_without_copy(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+    ECS_COMPONENT(template, Name);
+
+    ecs_set_hooks(template, Name, {
+        .ctor = flecs_default_ctor,
+        .dtor = ecs_dtor(Name)
+    });
+
+    ecs_entity_t e1 = ecs_new(template);
+    ecs_set(template, e1, Position, {10, 20});
+    ecs_set(template, e1, Name, { ecs_os_strdup("foo") });
+
+    ecs_entity_t e2 = ecs_new(template);
+    ecs_set(template, e2, Position, {30, 40});
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(!ecs_is_alive(world, e1));
+    test_assert(ecs_is_alive(world, e2));
+    test_assert(ecs_has(world, e2, Position));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_skip_query(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+
+    ecs_query_t *q = ecs_query(template, {
+        .entity = ecs_entity(template, { .name = "q" }),
+        .terms = {{ ecs_id(Position) }}
+    });
+    test_assert(q != NULL);
+
+    ecs_entity_t e = ecs_new_w(template, Position);
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(ecs_lookup(world, "q") == 0);
+    test_assert(!ecs_is_alive(world, q->entity));
+    test_assert(ecs_is_alive(world, e));
+    test_assert(ecs_has(world, e, Position));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_prefab_instance(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+
+    ecs_entity_t base = ecs_new_w_id(template, EcsPrefab);
+    ecs_set(template, base, Position, {10, 20});
+    ecs_entity_t base_child = ecs_new_w_pair(template, EcsChildOf, base);
+    ecs_add_id(template, base_child, EcsPrefab);
+
+    ecs_entity_t inst = ecs_new_w_pair(template, EcsIsA, base);
+    test_int(1, ecs_count_id(template, ecs_childof(inst)));
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(ecs_has_pair(world, inst, EcsIsA, base));
+    test_int(1, ecs_count_id(world, ecs_childof(inst)));
+
+    const Position *p = ecs_get(world, inst, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_entity_t inst_2 = ecs_new_w_pair(world, EcsIsA, base);
+    test_int(1, ecs_count_id(world, ecs_childof(inst_2)));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_traits(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+    ECS_TAG(template, Rel);
+    ECS_TAG(template, Tgt);
+
+    ecs_add_id(template, Rel, EcsExclusive);
+    ecs_add_pair(template, Rel, EcsOnDeleteTarget, EcsDelete);
+
+    ecs_entity_t e = ecs_new(template);
+    ecs_add_pair(template, e, Rel, Tgt);
+
+    /* Move Rel to a table created after the table of e */
+    ecs_set_name(template, Rel, "Rel");
+    ecs_set(template, Rel, Position, {0, 0});
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(ecs_has_pair(world, e, Rel, Tgt));
+    test_assert(ecs_has_id(world, Rel, EcsExclusive));
+
+    ecs_delete(world, Tgt);
+    test_assert(!ecs_is_alive(world, e));
+    test_assert(ecs_is_alive(template, e));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_sparse(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+    ecs_add_id(template, ecs_id(Position), EcsSparse);
+
+    ecs_entity_t e = ecs_new(template);
+    ecs_set(template, e, Position, {10, 20});
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_assert(p != ecs_get(template, e, Position));
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_dont_fragment(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+    ecs_add_id(template, ecs_id(Position), EcsDontFragment);
+
+    ecs_entity_t e = ecs_new(template);
+    ecs_set(template, e, Position, {10, 20});
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_union(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_ENTITY(template, Movement, Union);
+    ECS_TAG(template, Walking);
+    ECS_TAG(template, Running);
+
+    ecs_entity_t e1 = ecs_new(template);
+    ecs_add_pair(template, e1, Movement, Walking);
+    ecs_entity_t e2 = ecs_new(template);
+    ecs_add_pair(template, e2, Movement, Running);
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(ecs_has_pair(world, e1, Movement, Walking));
+    test_assert(!ecs_has_pair(world, e1, Movement, Running));
+    test_assert(ecs_has_pair(world, e2, Movement, Running));
+    test_assert(!ecs_has_pair(world, e2, Movement, Walking));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_toggle(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+    ecs_add_id(template, ecs_id(Position), EcsCanToggle);
+
+    ecs_entity_t e1 = ecs_new(template);
+    ecs_set(template, e1, Position, {10, 20});
+    ecs_enable_component(template, e1, Position, true);
+    ecs_entity_t e2 = ecs_new(template);
+    ecs_set(template, e2, Position, {30, 40});
+    ecs_enable_component(template, e2, Position, false);
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    test_assert(ecs_is_enabled(world, e1, Position));
+    test_assert(!ecs_is_enabled(world, e2, Position));
+    test_int(ecs_get(world, e2, Position)->x, 30);
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+static int position_set_invoked = 0;
+
+static
+void OnSetPosition(ecs_iter_t *it) {
+    position_set_invoked += it->count;
+}
+
+void WorldClone_clone_w_observer(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+
+    ecs_new_w(template, Position);
+    ecs_new_w(template, Position);
+
+    /* Keep entities of the destination world out of the template's range */
+    ecs_world_t *world = ecs_mini();
+    ecs_set_entity_range(world, 5000, 0);
+    ECS_COMPONENT_DEFINE(world, Position);
+    ECS_OBSERVER(world, OnSetPosition, EcsOnSet, Position);
+
+    position_set_invoked = 0;
+    test_int(0, ecs_world_clone_into(world, template));
+    test_int(2, position_set_invoked);
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_new_component(void) {
+    ecs_world_t *template = ecs_mini();
+
+    ECS_COMPONENT(template, Position);
+
+    ecs_world_t *world = ecs_mini();
+    test_int(0, ecs_world_clone_into(world, template));
+
+    ecs_entity_t c = ecs_component(world, {
+        .type.size = ECS_SIZEOF(Velocity),
+        .type.alignment = ECS_ALIGNOF(Velocity)
+    });
+    test_assert(c != 0);
+    test_assert(c != ecs_id(Position));
+    test_assert(ecs_has(world, ecs_id(Position), EcsComponent));
+
+    ecs_fini(world);
+    ecs_fini(template);
+}
+
+void WorldClone_clone_twice(void) {
+    ecs_world_t *template = ecs_init();
+
+    ECS_COMPONENT(template, Position);
+
+    ecs_entity_t e = ecs_entity(template, { .name = "e" });
+    ecs_set(template, e, Position, {10, 20});
+
+    ecs_world_t *world_1 = ecs_world_clone(template);
+    ecs_world_t *world_2 = ecs_world_clone(template);
+
+    ecs_set(world_1, e, Position, {30, 40});
+
+    test_assert(ecs_lookup(world_2, "e") == e);
+    test_int(ecs_get(world_2, e, Position)->x, 10);
+    test_int(ecs_get(world_1, e, Position)->x, 30);
+
+    test_assert(ecs_progress(world_1, 1));
+    test_assert(ecs_progress(world_2, 1));
+
+    ecs_fini(world_1);
+    ecs_fini(world_2);
+    ecs_fini(template);
+}
@@ -577,6 +577,65 @@ void Union_defer_add_union_relationship_2_ops(void);
 void Union_defer_add_existing_union_relationship_2_ops(void);
 void Union_stress_test_1(void);
 
+// Testsuite 'DontFragment'
+void DontFragment_has(void);
+void DontFragment_get(void);
+void DontFragment_set(void);
+void DontFragment_ensure(void);
+void DontFragment_emplace(void);
+void DontFragment_remove(void);
+void DontFragment_add_doesnt_change_table(void);
+void DontFragment_add_to_empty_entity(void);
+void DontFragment_not_in_type(void);
+void DontFragment_clear(void);
+void DontFragment_delete(void);
+void DontFragment_delete_parent(void);
+void DontFragment_ctor_dtor(void);
+void DontFragment_dtor_after_fini(void);
+void DontFragment_on_add_remove_hooks(void);
+void DontFragment_on_set_hook(void);
+void DontFragment_on_add_observer(void);
+void DontFragment_on_set_observer(void);
+void DontFragment_on_remove_observer(void);
+void DontFragment_defer_add(void);
+void DontFragment_defer_set(void);
+void DontFragment_defer_remove(void);
+void DontFragment_defer_set_remove(void);
+void DontFragment_defer_set_clear(void);
+void DontFragment_entity_init_w_add(void);
+void DontFragment_entity_init_w_set(void);
+void DontFragment_no_tables_created(void);
+void DontFragment_observers_empty_entity(void);
+void DontFragment_defer_set_empty_entity(void);
+
+// Testsuite 'ValueIndex'
+void ValueIndex_setup(void);
+void ValueIndex_lookup(void);
+void ValueIndex_lookup_not_found(void);
+void ValueIndex_lookup_existing(void);
+void ValueIndex_lookup_after_set(void);
+void ValueIndex_lookup_after_modified(void);
+void ValueIndex_lookup_after_remove(void);
+void ValueIndex_lookup_after_delete(void);
+void ValueIndex_lookup_after_table_move(void);
+void ValueIndex_lookup_duplicate_key(void);
+void ValueIndex_lookup_deferred(void);
+void ValueIndex_lookup_w_hash(void);
+void ValueIndex_lookup_inherited(void);
+void ValueIndex_lookup_prefab(void);
+void ValueIndex_delete_index(void);
+void ValueIndex_init_w_entity(void);
+void ValueIndex_init_twice(void);
+void ValueIndex_init_tag(void);
+void ValueIndex_lookup_no_index(void);
+void ValueIndex_query_set_var(void);
+void ValueIndex_query_set_var_not_found(void);
+void ValueIndex_query_set_var_no_match(void);
+void ValueIndex_query_set_var_cached(void);
+void ValueIndex_query_set_var_duplicate_key(void);
+void ValueIndex_query_set_var_duplicate_key_cached(void);
+void ValueIndex_query_set_var_duplicate_key_w_var(void);
+
 // Testsuite 'Hierarchies'
 void Hierarchies_setup(void);
 void Hierarchies_empty_scope(void);
@@ -907,6 +966,14 @@ void OnDelete_remove_all_3(void);
 void OnDelete_delete_with_1(void);
 void OnDelete_delete_with_2(void);
 void OnDelete_delete_with_3(void);
+void OnDelete_delete_children_w_dtor_multi_stage(void);
+void OnDelete_delete_large_hierarchy_w_dtor_multi_stage(void);
+void OnDelete_delete_with_w_dtor_multi_stage(void);
+void OnDelete_delete_deep_hierarchy(void);
+void OnDelete_on_remove_before_dtor_multi_stage(void);
+void OnDelete_threaded_dtors_disabled_by_default(void);
+void OnDelete_threaded_dtors_after_on_remove(void);
+void OnDelete_threaded_dtors_not_thread_safe(void);
 
 // Testsuite 'Set'
 void Set_set_empty(void);
@@ -1022,6 +1089,16 @@ void Lookup_lookup_name_65_chars(void);
 void Lookup_lookup_path_63_chars(void);
 void Lookup_lookup_path_64_chars(void);
 void Lookup_lookup_path_65_chars(void);
+void Lookup_lookup_cached_after_rename(void);
+void Lookup_lookup_cached_after_reparent(void);
+void Lookup_lookup_cached_after_delete(void);
+void Lookup_lookup_cached_w_scope(void);
+void Lookup_lookup_hashed(void);
+void Lookup_lookup_hashed_w_sep(void);
+void Lookup_lookup_hashed_builtin(void);
+void Lookup_lookup_hashed_w_scope(void);
+void Lookup_lookup_hashed_w_lookup_path(void);
+void Lookup_lookup_cached_after_set_other_name(void);
 
 // Testsuite 'Singleton'
 void Singleton_add_singleton(void);
@@ -1922,6 +1999,13 @@ void Prefab_prefab_child_offset_w_smaller_child_id(void);
 void Prefab_prefab_w_union(void);
 void Prefab_prefab_child_w_union(void);
 void Prefab_prefab_w_union_and_component(void);
+void Prefab_instantiate_n(void);
+void Prefab_instantiate_n_w_children(void);
+void Prefab_instantiate_n_w_nested_children(void);
+void Prefab_instantiate_n_w_override(void);
+void Prefab_instantiate_n_w_slot(void);
+void Prefab_instantiate_n_deferred(void);
+void Prefab_instantiate_n_zero(void);
 
 // Testsuite 'World'
 void World_setup(void);
@@ -1995,6 +2079,25 @@ void World_exclusive_on_delete(void);
 void World_exclusive_on_delete_target(void);
 void World_exclusive_on_instantiate(void);
 
+// Testsuite 'WorldClone'
+void WorldClone_clone_empty(void);
+void WorldClone_clone_entities(void);
+void WorldClone_clone_is_independent(void);
+void WorldClone_clone_many_entities(void);
+void WorldClone_clone_hierarchy(void);
+void WorldClone_clone_w_copy_hook(void);
+void WorldClone_clone_skip_dtor_without_copy(void);
+void WorldClone_clone_skip_query(void);
+void WorldClone_clone_prefab_instance(void);
+void WorldClone_clone_traits(void);
+void WorldClone_clone_sparse(void);
+void WorldClone_clone_dont_fragment(void);
+void WorldClone_clone_union(void);
+void WorldClone_clone_toggle(void);
+void WorldClone_clone_w_observer(void);
+void WorldClone_clone_new_component(void);
+void WorldClone_clone_twice(void);
+
 // Testsuite 'WorldInfo'
 void WorldInfo_get_tick(void);
 void WorldInfo_table_count(void);
@@ -4553,6 +4656,228 @@ bake_test_case Union_testcases[] = {
     }
 };
 
+bake_test_case DontFragment_testcases[] = {
+    {
+        "has",
+        DontFragment_has
+    },
+    {
+        "get",
+        DontFragment_get
+    },
+    {
+        "set",
+        DontFragment_set
+    },
+    {
+        "ensure",
+        DontFragment_ensure
+    },
+    {
+        "emplace",
+        DontFragment_emplace
+    },
+    {
+        "remove",
+        DontFragment_remove
+    },
+    {
+        "add_doesnt_change_table",
+        DontFragment_add_doesnt_change_table
+    },
+    {
+        "add_to_empty_entity",
+        DontFragment_add_to_empty_entity
+    },
+    {
+        "not_in_type",
+        DontFragment_not_in_type
+    },
+    {
+        "clear",
+        DontFragment_clear
+    },
+    {
+        "delete",
+        DontFragment_delete
+    },
+    {
+        "delete_parent",
+        DontFragment_delete_parent
+    },
+    {
+        "ctor_dtor",
+        DontFragment_ctor_dtor
+    },
+    {
+        "dtor_after_fini",
+        DontFragment_dtor_after_fini
+    },
+    {
+        "on_add_remove_hooks",
+        DontFragment_on_add_remove_hooks
+    },
+    {
+        "on_set_hook",
+        DontFragment_on_set_hook
+    },
+    {
+        "on_add_observer",
+        DontFragment_on_add_observer
+    },
+    {
+        "on_set_observer",
+        DontFragment_on_set_observer
+    },
+    {
+        "on_remove_observer",
+        DontFragment_on_remove_observer
+    },
+    {
+        "defer_add",
+        DontFragment_defer_add
+    },
+    {
+        "defer_set",
+        DontFragment_defer_set
+    },
+    {
+        "defer_remove",
+        DontFragment_defer_remove
+    },
+    {
+        "defer_set_remove",
+        DontFragment_defer_set_remove
+    },
+    {
+        "defer_set_clear",
+        DontFragment_defer_set_clear
+    },
+    {
+        "entity_init_w_add",
+        DontFragment_entity_init_w_add
+    },
+    {
+        "entity_init_w_set",
+        DontFragment_entity_init_w_set
+    },
+    {
+        "no_tables_created",
+        DontFragment_no_tables_created
+    },
+    {
+        "observers_empty_entity",
+        DontFragment_observers_empty_entity
+    },
+    {
+        "defer_set_empty_entity",
+        DontFragment_defer_set_empty_entity
+    }
+};
+
+bake_test_case ValueIndex_testcases[] = {
+    {
+        "lookup",
+        ValueIndex_lookup
+    },
+    {
+        "lookup_not_found",
+        ValueIndex_lookup_not_found
+    },
+    {
+        "lookup_existing",
+        ValueIndex_lookup_existing
+    },
+    {
+        "lookup_after_set",
+        ValueIndex_lookup_after_set
+    },
+    {
+        "lookup_after_modified",
+        ValueIndex_lookup_after_modified
+    },
+    {
+        "lookup_after_remove",
+        ValueIndex_lookup_after_remove
+    },
+    {
+        "lookup_after_delete",
+        ValueIndex_lookup_after_delete
+    },
+    {
+        "lookup_after_table_move",
+        ValueIndex_lookup_after_table_move
+    },
+    {
+        "lookup_duplicate_key",
+        ValueIndex_lookup_duplicate_key
+    },
+    {
+        "lookup_deferred",
+        ValueIndex_lookup_deferred
+    },
+    {
+        "lookup_w_hash",
+        ValueIndex_lookup_w_hash
+    },
+    {
+        "lookup_inherited",
+        ValueIndex_lookup_inherited
+    },
+    {
+        "lookup_prefab",
+        ValueIndex_lookup_prefab
+    },
+    {
+        "delete_index",
+        ValueIndex_delete_index
+    },
+    {
+        "init_w_entity",
+        ValueIndex_init_w_entity
+    },
+    {
+        "init_twice",
+        ValueIndex_init_twice
+    },
+    {
+        "init_tag",
+        ValueIndex_init_tag
+    },
+    {
+        "lookup_no_index",
+        ValueIndex_lookup_no_index
+    },
+    {
+        "query_set_var",
+        ValueIndex_query_set_var
+    },
+    {
+        "query_set_var_not_found",
+        ValueIndex_query_set_var_not_found
+    },
+    {
+        "query_set_var_no_match",
+        ValueIndex_query_set_var_no_match
+    },
+    {
+        "query_set_var_cached",
+        ValueIndex_query_set_var_cached
+    },
+    {
+        "query_set_var_duplicate_key",
+        ValueIndex_query_set_var_duplicate_key
+    },
+    {
+        "query_set_var_duplicate_key_cached",
+        ValueIndex_query_set_var_duplicate_key_cached
+    },
+    {
+        "query_set_var_duplicate_key_w_var",
+        ValueIndex_query_set_var_duplicate_key_w_var
+    }
+};
+
 bake_test_case Hierarchies_testcases[] = {
     {
         "empty_scope",
@@ -5823,6 +6148,38 @@ bake_test_case OnDelete_testcases[] = {
     {
         "delete_with_3",
         OnDelete_delete_with_3
+    },
+    {
+        "delete_children_w_dtor_multi_stage",
+        OnDelete_delete_children_w_dtor_multi_stage
+    },
+    {
+        "delete_large_hierarchy_w_dtor_multi_stage",
+        OnDelete_delete_large_hierarchy_w_dtor_multi_stage
+    },
+    {
+        "delete_with_w_dtor_multi_stage",
+        OnDelete_delete_with_w_dtor_multi_stage
+    },
+    {
+        "delete_deep_hierarchy",
+        OnDelete_delete_deep_hierarchy
+    },
+    {
+        "on_remove_before_dtor_multi_stage",
+        OnDelete_on_remove_before_dtor_multi_stage
+    },
+    {
+        "threaded_dtors_disabled_by_default",
+        OnDelete_threaded_dtors_disabled_by_default
+    },
+    {
+        "threaded_dtors_after_on_remove",
+        OnDelete_threaded_dtors_after_on_remove
+    },
+    {
+        "threaded_dtors_not_thread_safe",
+        OnDelete_threaded_dtors_not_thread_safe
     }
 };
 
@@ -6264,6 +6621,46 @@ bake_test_case Lookup_testcases[] = {
     {
         "lookup_path_65_chars",
         Lookup_lookup_path_65_chars
+    },
+    {
+        "lookup_cached_after_rename",
+        Lookup_lookup_cached_after_rename
+    },
+    {
+        "lookup_cached_after_reparent",
+        Lookup_lookup_cached_after_reparent
+    },
+    {
+        "lookup_cached_after_delete",
+        Lookup_lookup_cached_after_delete
+    },
+    {
+        "lookup_cached_w_scope",
+        Lookup_lookup_cached_w_scope
+    },
+    {
+        "lookup_hashed",
+        Lookup_lookup_hashed
+    },
+    {
+        "lookup_hashed_w_sep",
+        Lookup_lookup_hashed_w_sep
+    },
+    {
+        "lookup_hashed_builtin",
+        Lookup_lookup_hashed_builtin
+    },
+    {
+        "lookup_hashed_w_scope",
+        Lookup_lookup_hashed_w_scope
+    },
+    {
+        "lookup_hashed_w_lookup_path",
+        Lookup_lookup_hashed_w_lookup_path
+    },
+    {
+        "lookup_cached_after_set_other_name",
+        Lookup_lookup_cached_after_set_other_name
     }
 };
 
@@ -9792,6 +10189,34 @@ bake_test_case Prefab_testcases[] = {
     {
         "prefab_w_union_and_component",
         Prefab_prefab_w_union_and_component
+    },
+    {
+        "instantiate_n",
+        Prefab_instantiate_n
+    },
+    {
+        "instantiate_n_w_children",
+        Prefab_instantiate_n_w_children
+    },
+    {
+        "instantiate_n_w_nested_children",
+        Prefab_instantiate_n_w_nested_children
+    },
+    {
+        "instantiate_n_w_override",
+        Prefab_instantiate_n_w_override
+    },
+    {
+        "instantiate_n_w_slot",
+        Prefab_instantiate_n_w_slot
+    },
+    {
+        "instantiate_n_deferred",
+        Prefab_instantiate_n_deferred
+    },
+    {
+        "instantiate_n_zero",
+        Prefab_instantiate_n_zero
     }
 };
 
@@ -10074,6 +10499,77 @@ bake_test_case World_testcases[] = {
     }
 };
 
+bake_test_case WorldClone_testcases[] = {
+    {
+        "clone_empty",
+        WorldClone_clone_empty
+    },
+    {
+        "clone_entities",
+        WorldClone_clone_entities
+    },
+    {
+        "clone_is_independent",
+        WorldClone_clone_is_independent
+    },
+    {
+        "clone_many_entities",
+        WorldClone_clone_many_entities
+    },
+    {
+        "clone_hierarchy",
+        WorldClone_clone_hierarchy
+    },
+    {
+        "clone_w_copy_hook",
+        WorldClone_clone_w_copy_hook
+    },
+    {
+        "clone_skip_dtor_without_copy",
+        WorldClone_clone_skip_dtor_without_copy
+    },
+    {
+        "clone_skip_query",
+        WorldClone_clone_skip_query
+    },
+    {
+        "clone_prefab_instance",
+        WorldClone_clone_prefab_instance
+    },
+    {
+        "clone_traits",
+        WorldClone_clone_traits
+    },
+    {
+        "clone_sparse",
+        WorldClone_clone_sparse
+    },
+    {
+        "clone_dont_fragment",
+        WorldClone_clone_dont_fragment
+    },
+    {
+        "clone_union",
+        WorldClone_clone_union
+    },
+    {
+        "clone_toggle",
+        WorldClone_clone_toggle
+    },
+    {
+        "clone_w_observer",
+        WorldClone_clone_w_observer
+    },
+    {
+        "clone_new_component",
+        WorldClone_clone_new_component
+    },
+    {
+        "clone_twice",
+        WorldClone_clone_twice
+    }
+};
+
 bake_test_case WorldInfo_testcases[] = {
     {
         "get_tick",
@@ -11501,6 +11997,20 @@ static bake_test_suite suites[] = {
         52,
         Union_testcases
     },
+    {
+        "DontFragment",
+        NULL,
+        NULL,
+        29,
+        DontFragment_testcases
+    },
+    {
+        "ValueIndex",
+        ValueIndex_setup,
+        NULL,
+        25,
+        ValueIndex_testcases
+    },
     {
         "Hierarchies",
         Hierarchies_setup,
@@ -11547,7 +12057,7 @@ static bake_test_suite suites[] = {
         "OnDelete",
         NULL,
         NULL,
-        125,
+        133,
         OnDelete_testcases
     },
     {
@@ -11568,7 +12078,7 @@ static bake_test_suite suites[] = {
         "Lookup",
         Lookup_setup,
         NULL,
-        63,
+        73,
         Lookup_testcases
     },
     {
@@ -11652,7 +12162,7 @@ static bake_test_suite suites[] = {
         "Prefab",
         Prefab_setup,
         NULL,
-        153,
+        160,
         Prefab_testcases
     },
     {
@@ -11662,6 +12172,13 @@ static bake_test_suite suites[] = {
         69,
         World_testcases
     },
+    {
+        "WorldClone",
+        NULL,
+        NULL,
+        17,
+        WorldClone_testcases
+    },
     {
         "WorldInfo",
         NULL,
@@ -11735,5 +12252,5 @@ static bake_test_suite suites[] = {
 };
 
 int main(int argc, char *argv[]) {
-    return bake_test_run("core", argc, argv, suites, 46);
+    return bake_test_run("core", argc, argv, suites, 49);
 }
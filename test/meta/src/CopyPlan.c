@@ -0,0 +1,525 @@
+#include <meta.h>
+
+typedef struct Vec3d {
+    ecs_f64_t x, y, z;
+} Vec3d;
+
+typedef struct Vec3f {
+    ecs_f32_t x, y, z;
+} Vec3f;
+
+static
+ecs_entity_t register_vec3d(
+    ecs_world_t *world)
+{
+    ecs_entity_t t = ecs_struct(world, {
+        .entity = ecs_entity(world, {.name = "Vec3d"}),
+        .members = {
+            {"x", ecs_id(ecs_f64_t)},
+            {"y", ecs_id(ecs_f64_t)},
+            {"z", ecs_id(ecs_f64_t)}
+        }
+    });
+    test_assert(t != 0);
+    return t;
+}
+
+static
+ecs_entity_t register_vec3f(
+    ecs_world_t *world)
+{
+    ecs_entity_t t = ecs_struct(world, {
+        .entity = ecs_entity(world, {.name = "Vec3f"}),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)},
+            {"z", ecs_id(ecs_f32_t)}
+        }
+    });
+    test_assert(t != 0);
+    return t;
+}
+
+void CopyPlan_same_type(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t t = register_vec3d(world);
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, t, t);
+    test_assert(plan != NULL);
+
+    Vec3d src[3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    Vec3d dst[3] = {{0}};
+    ecs_meta_copy_plan_run(plan, dst, src, 3);
+
+    test_flt(dst[0].x, 1); test_flt(dst[0].y, 2); test_flt(dst[0].z, 3);
+    test_flt(dst[1].x, 4); test_flt(dst[1].y, 5); test_flt(dst[1].z, 6);
+    test_flt(dst[2].x, 7); test_flt(dst[2].y, 8); test_flt(dst[2].z, 9);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_f64_to_f32(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t td = register_vec3d(world);
+    ecs_entity_t tf = register_vec3f(world);
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, tf, td);
+    test_assert(plan != NULL);
+
+    Vec3d src[2] = {{1.5, 2.5, 3.5}, {-4, 5, -6}};
+    Vec3f dst[2] = {{0}};
+    ecs_meta_copy_plan_run(plan, dst, src, 2);
+
+    test_flt(dst[0].x, 1.5); test_flt(dst[0].y, 2.5); test_flt(dst[0].z, 3.5);
+    test_flt(dst[1].x, -4); test_flt(dst[1].y, 5); test_flt(dst[1].z, -6);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_f32_to_f64(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t td = register_vec3d(world);
+    ecs_entity_t tf = register_vec3f(world);
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, td, tf);
+    test_assert(plan != NULL);
+
+    Vec3f src[2] = {{1.5, 2.5, 3.5}, {-4, 5, -6}};
+    Vec3d dst[2] = {{0}};
+    ecs_meta_copy_plan_run(plan, dst, src, 2);
+
+    test_flt(dst[0].x, 1.5); test_flt(dst[0].y, 2.5); test_flt(dst[0].z, 3.5);
+    test_flt(dst[1].x, -4); test_flt(dst[1].y, 5); test_flt(dst[1].z, -6);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_int_conversions(void) {
+    typedef struct {
+        ecs_i8_t a;
+        ecs_u16_t b;
+        ecs_i64_t c;
+        bool d;
+    } Src;
+
+    typedef struct {
+        ecs_i32_t a;
+        ecs_u64_t b;
+        ecs_f64_t c;
+        ecs_u8_t d;
+    } Dst;
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t ts = ecs_struct(world, {
+        .members = {
+            {"a", ecs_id(ecs_i8_t)},
+            {"b", ecs_id(ecs_u16_t)},
+            {"c", ecs_id(ecs_i64_t)},
+            {"d", ecs_id(ecs_bool_t)}
+        }
+    });
+
+    ecs_entity_t td = ecs_struct(world, {
+        .members = {
+            {"a", ecs_id(ecs_i32_t)},
+            {"b", ecs_id(ecs_u64_t)},
+            {"c", ecs_id(ecs_f64_t)},
+            {"d", ecs_id(ecs_u8_t)}
+        }
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, td, ts);
+    test_assert(plan != NULL);
+
+    Src src = {-10, 60000, -5000000000, true};
+    Dst dst = {0};
+    ecs_meta_copy_plan_run(plan, &dst, &src, 1);
+
+    test_int(dst.a, -10);
+    test_uint(dst.b, 60000);
+    test_flt(dst.c, -5000000000.0);
+    test_uint(dst.d, 1);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_member_order(void) {
+    typedef struct {
+        ecs_f32_t z, y, x;
+    } Zyx;
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t td = register_vec3d(world);
+    ecs_entity_t tz = ecs_struct(world, {
+        .members = {
+            {"z", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)},
+            {"x", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, tz, td);
+    test_assert(plan != NULL);
+
+    Vec3d src = {1, 2, 3};
+    Zyx dst = {0};
+    ecs_meta_copy_plan_run(plan, &dst, &src, 1);
+
+    test_flt(dst.x, 1);
+    test_flt(dst.y, 2);
+    test_flt(dst.z, 3);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_missing_member(void) {
+    typedef struct {
+        ecs_f64_t x, y;
+    } Vec2d;
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t td = register_vec3d(world);
+    ecs_entity_t t2 = ecs_struct(world, {
+        .members = {
+            {"x", ecs_id(ecs_f64_t)},
+            {"y", ecs_id(ecs_f64_t)}
+        }
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, td, t2);
+    test_assert(plan != NULL);
+
+    Vec2d src = {1, 2};
+    Vec3d dst = {10, 20, 30};
+    ecs_meta_copy_plan_run(plan, &dst, &src, 1);
+
+    test_flt(dst.x, 1);
+    test_flt(dst.y, 2);
+    test_flt(dst.z, 30);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_nested_struct(void) {
+    typedef struct {
+        Vec3d position;
+        ecs_i32_t id;
+    } SrcT;
+
+    typedef struct {
+        ecs_i32_t id;
+        Vec3f position;
+    } DstT;
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t td = register_vec3d(world);
+    ecs_entity_t tf = register_vec3f(world);
+
+    ecs_entity_t ts = ecs_struct(world, {
+        .members = {
+            {"position", td},
+            {"id", ecs_id(ecs_i32_t)}
+        }
+    });
+
+    ecs_entity_t tt = ecs_struct(world, {
+        .members = {
+            {"id", ecs_id(ecs_i32_t)},
+            {"position", tf}
+        }
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, tt, ts);
+    test_assert(plan != NULL);
+
+    SrcT src[2] = {{{1, 2, 3}, 10}, {{4, 5, 6}, 20}};
+    DstT dst[2] = {{0}};
+    ecs_meta_copy_plan_run(plan, dst, src, 2);
+
+    test_int(dst[0].id, 10);
+    test_flt(dst[0].position.x, 1);
+    test_flt(dst[0].position.y, 2);
+    test_flt(dst[0].position.z, 3);
+    test_int(dst[1].id, 20);
+    test_flt(dst[1].position.x, 4);
+    test_flt(dst[1].position.y, 5);
+    test_flt(dst[1].position.z, 6);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_array_member(void) {
+    typedef struct {
+        ecs_f64_t v[3];
+    } SrcT;
+
+    typedef struct {
+        ecs_f32_t v[3];
+    } DstT;
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t ts = ecs_struct(world, {
+        .members = {
+            {"v", ecs_id(ecs_f64_t), 3}
+        }
+    });
+
+    ecs_entity_t tt = ecs_struct(world, {
+        .members = {
+            {"v", ecs_id(ecs_f32_t), 3}
+        }
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, tt, ts);
+    test_assert(plan != NULL);
+
+    SrcT src = {{1, 2, 3}};
+    DstT dst = {{0}};
+    ecs_meta_copy_plan_run(plan, &dst, &src, 1);
+
+    test_flt(dst.v[0], 1);
+    test_flt(dst.v[1], 2);
+    test_flt(dst.v[2], 3);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_string_member(void) {
+    typedef struct {
+        ecs_i32_t x;
+        ecs_string_t name;
+    } SrcT;
+
+    typedef struct {
+        ecs_string_t name;
+        ecs_i64_t x;
+    } DstT;
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t ts = ecs_struct(world, {
+        .members = {
+            {"x", ecs_id(ecs_i32_t)},
+            {"name", ecs_id(ecs_string_t)}
+        }
+    });
+
+    ecs_entity_t tt = ecs_struct(world, {
+        .members = {
+            {"name", ecs_id(ecs_string_t)},
+            {"x", ecs_id(ecs_i64_t)}
+        }
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, tt, ts);
+    test_assert(plan != NULL);
+
+    SrcT src[2] = {{10, "foo"}, {20, NULL}};
+    DstT dst[2] = {{ecs_os_strdup("bar"), 0}, {ecs_os_strdup("hello"), 0}};
+    ecs_meta_copy_plan_run(plan, dst, src, 2);
+
+    test_int(dst[0].x, 10);
+    test_str(dst[0].name, "foo");
+    test_assert(dst[0].name != src[0].name);
+    test_int(dst[1].x, 20);
+    test_str(dst[1].name, NULL);
+
+    ecs_os_free(dst[0].name);
+    ecs_os_free(dst[1].name);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_vector_member(void) {
+    typedef struct {
+        ecs_vec_t v;
+        ecs_f32_t w;
+    } SrcT;
+
+    typedef struct {
+        ecs_f64_t w;
+        ecs_vec_t v;
+    } DstT;
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t vt = ecs_vector(world, {
+        .type = ecs_id(ecs_i32_t)
+    });
+
+    ecs_entity_t ts = ecs_struct(world, {
+        .members = {
+            {"v", vt},
+            {"w", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    ecs_entity_t tt = ecs_struct(world, {
+        .members = {
+            {"w", ecs_id(ecs_f64_t)},
+            {"v", vt}
+        }
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, tt, ts);
+    test_assert(plan != NULL);
+
+    SrcT src;
+    ecs_vec_init_t(NULL, &src.v, ecs_i32_t, 3);
+    ecs_vec_append_t(NULL, &src.v, ecs_i32_t)[0] = 1;
+    ecs_vec_append_t(NULL, &src.v, ecs_i32_t)[0] = 2;
+    ecs_vec_append_t(NULL, &src.v, ecs_i32_t)[0] = 3;
+    src.w = 0.5;
+
+    DstT dst;
+    ecs_vec_init_t(NULL, &dst.v, ecs_i32_t, 0);
+    ecs_vec_append_t(NULL, &dst.v, ecs_i32_t)[0] = 10;
+    dst.w = 0;
+
+    ecs_meta_copy_plan_run(plan, &dst, &src, 1);
+
+    test_flt(dst.w, 0.5);
+    test_int(ecs_vec_count(&dst.v), 3);
+    test_int(ecs_vec_get_t(&dst.v, ecs_i32_t, 0)[0], 1);
+    test_int(ecs_vec_get_t(&dst.v, ecs_i32_t, 1)[0], 2);
+    test_int(ecs_vec_get_t(&dst.v, ecs_i32_t, 2)[0], 3);
+    test_assert(dst.v.array != src.v.array);
+
+    ecs_vec_fini_t(NULL, &src.v, ecs_i32_t);
+    ecs_vec_fini_t(NULL, &dst.v, ecs_i32_t);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_vector_of_strings(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t vt = ecs_vector(world, {
+        .type = ecs_id(ecs_string_t)
+    });
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, vt, vt);
+    test_assert(plan != NULL);
+
+    ecs_vec_t src;
+    ecs_vec_init_t(NULL, &src, ecs_string_t, 2);
+    ecs_vec_append_t(NULL, &src, ecs_string_t)[0] = ecs_os_strdup("foo");
+    ecs_vec_append_t(NULL, &src, ecs_string_t)[0] = ecs_os_strdup("bar");
+
+    ecs_vec_t dst;
+    ecs_vec_init_t(NULL, &dst, ecs_string_t, 0);
+
+    ecs_meta_copy_plan_run(plan, &dst, &src, 1);
+
+    test_int(ecs_vec_count(&dst), 2);
+    test_str(ecs_vec_get_t(&dst, ecs_string_t, 0)[0], "foo");
+    test_str(ecs_vec_get_t(&dst, ecs_string_t, 1)[0], "bar");
+    test_assert(ecs_vec_get_t(&dst, ecs_string_t, 0)[0] !=
+        ecs_vec_get_t(&src, ecs_string_t, 0)[0]);
+
+    const ecs_type_info_t *ti = ecs_get_type_info(world, vt);
+    test_assert(ti != NULL);
+    ti->hooks.dtor(&src, 1, ti);
+    ti->hooks.dtor(&dst, 1, ti);
+
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_column(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t td = register_vec3d(world);
+    ecs_entity_t tf = register_vec3f(world);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_entity_t e3 = ecs_new(world);
+    ecs_set_id(world, e1, td, sizeof(Vec3d), &(Vec3d){1, 2, 3});
+    ecs_set_id(world, e2, td, sizeof(Vec3d), &(Vec3d){4, 5, 6});
+    ecs_set_id(world, e3, td, sizeof(Vec3d), &(Vec3d){7, 8, 9});
+
+    ecs_meta_copy_plan_t *plan = ecs_meta_copy_plan_init(world, tf, td);
+    test_assert(plan != NULL);
+
+    ecs_query_t *q = ecs_query(world, { .terms = {{ td }} });
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 3);
+
+    Vec3f dst[3] = {{0}};
+    ecs_meta_copy_plan_run(plan, dst, ecs_field_w_size(&it, sizeof(Vec3d), 0),
+        it.count);
+    test_bool(ecs_query_next(&it), false);
+
+    test_flt(dst[0].x, 1); test_flt(dst[0].y, 2); test_flt(dst[0].z, 3);
+    test_flt(dst[1].x, 4); test_flt(dst[1].y, 5); test_flt(dst[1].z, 6);
+    test_flt(dst[2].x, 7); test_flt(dst[2].y, 8); test_flt(dst[2].z, 9);
+
+    ecs_query_fini(q);
+    ecs_meta_copy_plan_fini(plan);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_invalid_conversion(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t ts = ecs_struct(world, {
+        .members = {
+            {"x", ecs_id(ecs_string_t)}
+        }
+    });
+
+    ecs_entity_t tt = ecs_struct(world, {
+        .members = {
+            {"x", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    ecs_log_set_level(-4);
+    test_assert(ecs_meta_copy_plan_init(world, tt, ts) == NULL);
+
+    ecs_fini(world);
+}
+
+void CopyPlan_no_reflection(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Vec3d);
+    ecs_entity_t tf = register_vec3f(world);
+
+    ecs_log_set_level(-4);
+    test_assert(ecs_meta_copy_plan_init(world, tf, ecs_id(Vec3d)) == NULL);
+
+    ecs_fini(world);
+}
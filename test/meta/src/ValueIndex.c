@@ -0,0 +1,167 @@
+#include <meta.h>
+
+typedef struct Player {
+    ecs_f32_t health;
+    ecs_u32_t id;
+    ecs_string_t name;
+    ecs_entity_t team;
+} Player;
+
+static
+ecs_entity_t register_player(
+    ecs_world_t *world,
+    ecs_entity_t player)
+{
+    ecs_entity_t t = ecs_struct(world, {
+        .entity = player,
+        .members = {
+            {"health", ecs_id(ecs_f32_t)},
+            {"id", ecs_id(ecs_u32_t)},
+            {"name", ecs_id(ecs_string_t)},
+            {"team", ecs_id(ecs_entity_t)}
+        }
+    });
+    test_assert(t != 0);
+    return t;
+}
+
+static
+ecs_entity_t init_index(
+    ecs_world_t *world,
+    ecs_entity_t player,
+    const char *member)
+{
+    ecs_entity_t m = ecs_lookup_child(world, player, member);
+    test_assert(m != 0);
+
+    ecs_entity_t index = ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = player,
+        .member = m
+    });
+    test_assert(index != 0);
+    return index;
+}
+
+void ValueIndex_member_u32(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Player);
+    register_player(world, ecs_id(Player));
+    init_index(world, ecs_id(Player), "id");
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, Player, {10.0f, 1});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, Player, {20.0f, 2});
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &(ecs_u32_t){1}), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &(ecs_u32_t){2}), e2);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &(ecs_u32_t){3}), 0);
+
+    /* Members that aren't the key don't change the lookup */
+    ecs_set(world, e1, Player, {30.0f, 1});
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &(ecs_u32_t){1}), e1);
+
+    ecs_set(world, e1, Player, {30.0f, 3});
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &(ecs_u32_t){1}), 0);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &(ecs_u32_t){3}), e1);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_member_string(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Player);
+    register_player(world, ecs_id(Player));
+    init_index(world, ecs_id(Player), "name");
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, Player, {10.0f, 1, "Alice"});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, Player, {20.0f, 2, "Bob"});
+    ecs_entity_t e3 = ecs_new(world);
+    ecs_set(world, e3, Player, {30.0f, 3, NULL});
+
+    /* Keys are compared by string value, not by pointer */
+    char name[] = "Alice";
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player),
+        &(ecs_string_t){name}), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player),
+        &(ecs_string_t){"Bob"}), e2);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player),
+        &(ecs_string_t){NULL}), e3);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player),
+        &(ecs_string_t){"Carol"}), 0);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_member_entity(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Player);
+    register_player(world, ecs_id(Player));
+    init_index(world, ecs_id(Player), "team");
+
+    ecs_entity_t red = ecs_new(world);
+    ecs_entity_t blue = ecs_new(world);
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, Player, {10.0f, 1, NULL, red});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, Player, {20.0f, 2, NULL, blue});
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &red), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player), &blue), e2);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_member_existing(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Player);
+    register_player(world, ecs_id(Player));
+
+    ecs_entity_t e1 = ecs_new(world);
+    ecs_set(world, e1, Player, {10.0f, 1, "Alice"});
+    ecs_entity_t e2 = ecs_new(world);
+    ecs_set(world, e2, Player, {20.0f, 2, "Bob"});
+
+    init_index(world, ecs_id(Player), "name");
+
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player),
+        &(ecs_string_t){"Alice"}), e1);
+    test_uint(ecs_lookup_by_value(world, ecs_id(Player),
+        &(ecs_string_t){"Bob"}), e2);
+
+    ecs_fini(world);
+}
+
+void ValueIndex_member_of_other_type(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Player);
+    ECS_COMPONENT(world, Position);
+    register_player(world, ecs_id(Player));
+
+    ecs_entity_t t = ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+    test_assert(t != 0);
+
+    ecs_entity_t m = ecs_lookup_child(world, ecs_id(Position), "x");
+    test_assert(m != 0);
+
+    ecs_log_set_level(-4);
+    test_expect_abort();
+    ecs_value_index_init(world, &(ecs_value_index_desc_t){
+        .component = ecs_id(Player),
+        .member = m
+    });
+}
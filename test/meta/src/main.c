@@ -1029,6 +1029,29 @@ void Misc_unit_from_suspend_defer(void);
 void Misc_unit_prefix_from_suspend_defer(void);
 void Misc_quantity_from_suspend_defer(void);
 
+// Testsuite 'CopyPlan'
+void CopyPlan_same_type(void);
+void CopyPlan_f64_to_f32(void);
+void CopyPlan_f32_to_f64(void);
+void CopyPlan_int_conversions(void);
+void CopyPlan_member_order(void);
+void CopyPlan_missing_member(void);
+void CopyPlan_nested_struct(void);
+void CopyPlan_array_member(void);
+void CopyPlan_string_member(void);
+void CopyPlan_vector_member(void);
+void CopyPlan_vector_of_strings(void);
+void CopyPlan_column(void);
+void CopyPlan_invalid_conversion(void);
+void CopyPlan_no_reflection(void);
+
+// Testsuite 'ValueIndex'
+void ValueIndex_member_u32(void);
+void ValueIndex_member_string(void);
+void ValueIndex_member_entity(void);
+void ValueIndex_member_existing(void);
+void ValueIndex_member_of_other_type(void);
+
 bake_test_case PrimitiveTypes_testcases[] = {
     {
         "bool",
@@ -5008,6 +5031,87 @@ bake_test_case Misc_testcases[] = {
     }
 };
 
+bake_test_case CopyPlan_testcases[] = {
+    {
+        "same_type",
+        CopyPlan_same_type
+    },
+    {
+        "f64_to_f32",
+        CopyPlan_f64_to_f32
+    },
+    {
+        "f32_to_f64",
+        CopyPlan_f32_to_f64
+    },
+    {
+        "int_conversions",
+        CopyPlan_int_conversions
+    },
+    {
+        "member_order",
+        CopyPlan_member_order
+    },
+    {
+        "missing_member",
+        CopyPlan_missing_member
+    },
+    {
+        "nested_struct",
+        CopyPlan_nested_struct
+    },
+    {
+        "array_member",
+        CopyPlan_array_member
+    },
+    {
+        "string_member",
+        CopyPlan_string_member
+    },
+    {
+        "vector_member",
+        CopyPlan_vector_member
+    },
+    {
+        "vector_of_strings",
+        CopyPlan_vector_of_strings
+    },
+    {
+        "column",
+        CopyPlan_column
+    },
+    {
+        "invalid_conversion",
+        CopyPlan_invalid_conversion
+    },
+    {
+        "no_reflection",
+        CopyPlan_no_reflection
+    }
+};
+
+bake_test_case ValueIndex_testcases[] = {
+    {
+        "member_u32",
+        ValueIndex_member_u32
+    },
+    {
+        "member_string",
+        ValueIndex_member_string
+    },
+    {
+        "member_entity",
+        ValueIndex_member_entity
+    },
+    {
+        "member_existing",
+        ValueIndex_member_existing
+    },
+    {
+        "member_of_other_type",
+        ValueIndex_member_of_other_type
+    }
+};
 
 static bake_test_suite suites[] = {
     {
@@ -5156,9 +5260,23 @@ static bake_test_suite suites[] = {
         NULL,
         40,
         Misc_testcases
+    },
+    {
+        "CopyPlan",
+        NULL,
+        NULL,
+        14,
+        CopyPlan_testcases
+    },
+    {
+        "ValueIndex",
+        NULL,
+        NULL,
+        5,
+        ValueIndex_testcases
     }
 };
 
 int main(int argc, char *argv[]) {
-    return bake_test_run("meta", argc, argv, suites, 21);
+    return bake_test_run("meta", argc, argv, suites, 23);
 }
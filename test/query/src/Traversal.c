@@ -11038,3 +11038,436 @@ void Traversal_this_written_up_isa_childof_2_lvl_after_remove_override(void) {
 
     ecs_fini(world);
 }
+
+void Traversal_trav_cache_up_childof(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t p = ecs_new_w(world, Foo);
+    ecs_entity_t e1 = ecs_new_w_pair(world, EcsChildOf, p);
+    ecs_add(world, e1, Bar);
+    ecs_entity_t e2 = ecs_new_w_pair(world, EcsChildOf, e1);
+    ecs_add(world, e2, Bar);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    for (int i = 0; i < 2; i ++) {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_int(1, it.count);
+        test_uint(e1, it.entities[0]);
+        test_uint(0, ecs_field_src(&it, 0));
+        test_uint(p, ecs_field_src(&it, 1));
+
+        test_bool(true, ecs_query_next(&it));
+        test_int(1, it.count);
+        test_uint(e2, it.entities[0]);
+        test_uint(0, ecs_field_src(&it, 0));
+        test_uint(p, ecs_field_src(&it, 1));
+
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_remove_from_parent(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t p = ecs_new_w(world, Foo);
+    ecs_entity_t e1 = ecs_new_w_pair(world, EcsChildOf, p);
+    ecs_entity_t e2 = ecs_new_w_pair(world, EcsChildOf, e1);
+    ecs_add(world, e2, Bar);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_int(1, it.count);
+        test_uint(e2, it.entities[0]);
+        test_uint(p, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_remove(world, p, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_add(world, e1, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_int(1, it.count);
+        test_uint(e2, it.entities[0]);
+        test_uint(e1, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_add_to_parent(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t p = ecs_new_w(world, Foo);
+    ecs_entity_t e1 = ecs_new_w_pair(world, EcsChildOf, p);
+    ecs_entity_t e2 = ecs_new_w_pair(world, EcsChildOf, e1);
+    ecs_add(world, e2, Bar);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(p, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_add(world, e1, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_int(1, it.count);
+        test_uint(e2, it.entities[0]);
+        test_uint(e1, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_reparent(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t p1 = ecs_new_w(world, Foo);
+    ecs_entity_t p2 = ecs_new(world);
+    ecs_entity_t e1 = ecs_new_w_pair(world, EcsChildOf, p1);
+    ecs_entity_t e2 = ecs_new_w_pair(world, EcsChildOf, e1);
+    ecs_add(world, e2, Bar);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e2, it.entities[0]);
+        test_uint(p1, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_add_pair(world, e1, EcsChildOf, p2);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_add(world, p2, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e2, it.entities[0]);
+        test_uint(p2, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_delete_parent(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+    ECS_ENTITY(world, Rel, Traversable);
+
+    ecs_entity_t p1 = ecs_new_w(world, Foo);
+    ecs_entity_t p2 = ecs_new_w(world, Foo);
+    ecs_entity_t e = ecs_new_w(world, Bar);
+    ecs_add_pair(world, e, Rel, p1);
+    ecs_add_pair(world, e, Rel, p2);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp, .trav = Rel }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e, it.entities[0]);
+        test_uint(p1, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_delete(world, p1);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e, it.entities[0]);
+        test_uint(p2, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_delete(world, p2);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_isa(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_ENTITY(world, Foo, (OnInstantiate, Inherit));
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t base = ecs_new_w(world, Foo);
+    ecs_entity_t inst = ecs_new_w_pair(world, EcsIsA, base);
+    ecs_add(world, inst, Bar);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp, .trav = EcsIsA }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(inst, it.entities[0]);
+        test_uint(base, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_remove(world, base, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_childof_inherit_from_parent_base(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_ENTITY(world, Foo, (OnInstantiate, Inherit));
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t base = ecs_new_w(world, Foo);
+    ecs_entity_t p = ecs_new_w_pair(world, EcsIsA, base);
+    ecs_entity_t e = ecs_new_w_pair(world, EcsChildOf, p);
+    ecs_add(world, e, Bar);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp, .trav = EcsChildOf }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e, it.entities[0]);
+        test_uint(base, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_add(world, p, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e, it.entities[0]);
+        test_uint(p, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_shared_by_queries(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+    ECS_TAG(world, Hello);
+
+    ecs_entity_t p = ecs_new_w(world, Foo);
+    ecs_entity_t e1 = ecs_new_w_pair(world, EcsChildOf, p);
+    ecs_add(world, e1, Bar);
+    ecs_add(world, e1, Hello);
+
+    ecs_query_t *q1 = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp }},
+        .cache_kind = cache_kind
+    });
+
+    ecs_query_t *q2 = ecs_query(world, {
+        .terms = {{ Hello }, { Foo, .src.id = EcsUp }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q1 != NULL);
+    test_assert(q2 != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q1);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e1, it.entities[0]);
+        test_uint(p, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+    {
+        ecs_iter_t it = ecs_query_iter(world, q2);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e1, it.entities[0]);
+        test_uint(p, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_remove(world, p, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q1);
+        test_bool(false, ecs_query_next(&it));
+    }
+    {
+        ecs_iter_t it = ecs_query_iter(world, q2);
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q1);
+    ecs_query_fini(q2);
+
+    ecs_fini(world);
+}
+
+void Traversal_trav_cache_disable(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_trav_cache(world, true);
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t p = ecs_new_w(world, Foo);
+    ecs_entity_t e = ecs_new_w_pair(world, EcsChildOf, p);
+    ecs_add(world, e, Bar);
+
+    ecs_query_t *q = ecs_query(world, {
+        .terms = {{ Bar }, { Foo, .src.id = EcsUp }},
+        .cache_kind = cache_kind
+    });
+
+    test_assert(q != NULL);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e, it.entities[0]);
+        test_uint(p, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_enable_trav_cache(world, false);
+    ecs_remove(world, p, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_enable_trav_cache(world, true);
+    ecs_add(world, p, Foo);
+
+    {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        test_bool(true, ecs_query_next(&it));
+        test_uint(e, it.entities[0]);
+        test_uint(p, ecs_field_src(&it, 1));
+        test_bool(false, ecs_query_next(&it));
+    }
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
@@ -1524,6 +1524,15 @@ void Traversal_this_written_up_isa_childof_2_lvl(void);
 void Traversal_this_written_up_isa_childof_2_lvl_w_on_instantiate_inherit(void);
 void Traversal_this_written_up_isa_childof_2_lvl_w_on_instantiate_dont_inherit(void);
 void Traversal_this_written_up_isa_childof_2_lvl_after_remove_override(void);
+void Traversal_trav_cache_up_childof(void);
+void Traversal_trav_cache_remove_from_parent(void);
+void Traversal_trav_cache_add_to_parent(void);
+void Traversal_trav_cache_reparent(void);
+void Traversal_trav_cache_delete_parent(void);
+void Traversal_trav_cache_isa(void);
+void Traversal_trav_cache_childof_inherit_from_parent_base(void);
+void Traversal_trav_cache_shared_by_queries(void);
+void Traversal_trav_cache_disable(void);
 
 // Testsuite 'Cascade'
 void Cascade_parent_cascade(void);
@@ -1947,6 +1956,24 @@ void Sparse_1_sparse_written_self_up(void);
 void Sparse_sparse_0_src_only_term(void);
 void Sparse_sparse_0_src(void);
 
+// Testsuite 'DontFragment'
+void DontFragment_setup(void);
+void DontFragment_1_fixed(void);
+void DontFragment_1_fixed_no_match(void);
+void DontFragment_1_this(void);
+void DontFragment_1_this_simple(void);
+void DontFragment_1_this_empty_entity(void);
+void DontFragment_1_this_after_remove(void);
+void DontFragment_1_this_w_prefab(void);
+void DontFragment_1_var(void);
+void DontFragment_2_this_written(void);
+void DontFragment_2_this_select_and_regular(void);
+void DontFragment_not_this(void);
+void DontFragment_not_fixed(void);
+void DontFragment_optional_this(void);
+void DontFragment_up_not_supported(void);
+void DontFragment_or_not_supported(void);
+
 // Testsuite 'Union'
 void Union_setup(void);
 void Union_1_fixed_union_any(void);
@@ -8100,6 +8127,42 @@ bake_test_case Traversal_testcases[] = {
     {
         "this_written_up_isa_childof_2_lvl_after_remove_override",
         Traversal_this_written_up_isa_childof_2_lvl_after_remove_override
+    },
+    {
+        "trav_cache_up_childof",
+        Traversal_trav_cache_up_childof
+    },
+    {
+        "trav_cache_remove_from_parent",
+        Traversal_trav_cache_remove_from_parent
+    },
+    {
+        "trav_cache_add_to_parent",
+        Traversal_trav_cache_add_to_parent
+    },
+    {
+        "trav_cache_reparent",
+        Traversal_trav_cache_reparent
+    },
+    {
+        "trav_cache_delete_parent",
+        Traversal_trav_cache_delete_parent
+    },
+    {
+        "trav_cache_isa",
+        Traversal_trav_cache_isa
+    },
+    {
+        "trav_cache_childof_inherit_from_parent_base",
+        Traversal_trav_cache_childof_inherit_from_parent_base
+    },
+    {
+        "trav_cache_shared_by_queries",
+        Traversal_trav_cache_shared_by_queries
+    },
+    {
+        "trav_cache_disable",
+        Traversal_trav_cache_disable
     }
 };
 
@@ -9744,6 +9807,69 @@ bake_test_case Sparse_testcases[] = {
     }
 };
 
+bake_test_case DontFragment_testcases[] = {
+    {
+        "1_fixed",
+        DontFragment_1_fixed
+    },
+    {
+        "1_fixed_no_match",
+        DontFragment_1_fixed_no_match
+    },
+    {
+        "1_this",
+        DontFragment_1_this
+    },
+    {
+        "1_this_simple",
+        DontFragment_1_this_simple
+    },
+    {
+        "1_this_empty_entity",
+        DontFragment_1_this_empty_entity
+    },
+    {
+        "1_this_after_remove",
+        DontFragment_1_this_after_remove
+    },
+    {
+        "1_this_w_prefab",
+        DontFragment_1_this_w_prefab
+    },
+    {
+        "1_var",
+        DontFragment_1_var
+    },
+    {
+        "2_this_written",
+        DontFragment_2_this_written
+    },
+    {
+        "2_this_select_and_regular",
+        DontFragment_2_this_select_and_regular
+    },
+    {
+        "not_this",
+        DontFragment_not_this
+    },
+    {
+        "not_fixed",
+        DontFragment_not_fixed
+    },
+    {
+        "optional_this",
+        DontFragment_optional_this
+    },
+    {
+        "up_not_supported",
+        DontFragment_up_not_supported
+    },
+    {
+        "or_not_supported",
+        DontFragment_or_not_supported
+    }
+};
+
 bake_test_case Union_testcases[] = {
     {
         "1_fixed_union_any",
@@ -10548,6 +10674,10 @@ const char* Sparse_cache_kind_param[] = {"default", "auto"};
 bake_test_param Sparse_params[] = {
     {"cache_kind", (char**)Sparse_cache_kind_param, 2}
 };
+const char* DontFragment_cache_kind_param[] = {"default", "auto"};
+bake_test_param DontFragment_params[] = {
+    {"cache_kind", (char**)DontFragment_cache_kind_param, 2}
+};
 const char* Union_cache_kind_param[] = {"default", "auto"};
 bake_test_param Union_params[] = {
     {"cache_kind", (char**)Union_cache_kind_param, 2}
@@ -10665,7 +10795,7 @@ static bake_test_suite suites[] = {
         "Traversal",
         Traversal_setup,
         NULL,
-        155,
+        164,
         Traversal_testcases,
         1,
         Traversal_params
@@ -10725,6 +10855,15 @@ static bake_test_suite suites[] = {
         1,
         Sparse_params
     },
+    {
+        "DontFragment",
+        DontFragment_setup,
+        NULL,
+        15,
+        DontFragment_testcases,
+        1,
+        DontFragment_params
+    },
     {
         "Union",
         Union_setup,
@@ -10758,5 +10897,5 @@ static bake_test_suite suites[] = {
 };
 
 int main(int argc, char *argv[]) {
-    return bake_test_run("query", argc, argv, suites, 25);
+    return bake_test_run("query", argc, argv, suites, 26);
 }
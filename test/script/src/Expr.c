@@ -5974,3 +5974,354 @@ void Expr_escape_newline(void) {
 
     ecs_fini(world);
 }
+
+void Expr_parse_eval_bytecode_vs_ast(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_var_t *x = ecs_script_vars_define(vars, "x", ecs_i32_t);
+    ecs_script_var_t *y = ecs_script_vars_define(vars, "y", ecs_f32_t);
+    ecs_script_var_t *z = ecs_script_vars_define(vars, "z", ecs_u8_t);
+
+    const char *exprs[] = {
+        "$x + $x * 2",
+        "$x * $y - 1",
+        "$x / 3",
+        "$x % 7",
+        "$z + $z",
+        "$z * 200",
+        "$x > 10 && $y < 20",
+        "!($x == 42) || $z != 0",
+        "($z << 2) | 1",
+        "$y * $y + 0.5",
+        "$x - 100"
+    };
+
+    int32_t xs[] = { 0, 1, 42, -17, 100000 };
+    float ys[] = { 0.0f, 1.5f, -2.25f, 19.0f, 1e10f };
+    uint8_t zs[] = { 0, 1, 127, 128, 255 };
+
+    int32_t e, i;
+    for (e = 0; e < (int32_t)(sizeof(exprs) / sizeof(exprs[0])); e ++) {
+        ecs_expr_eval_desc_t desc = { 
+            .vars = vars, .disable_folding = disable_folding };
+        ecs_expr_eval_desc_t ast_desc = desc;
+        ast_desc.disable_bytecode = true;
+
+        ecs_script_t *s = ecs_expr_parse(world, exprs[e], &desc);
+        test_assert(s != NULL);
+
+        for (i = 0; i < 5; i ++) {
+            *(int32_t*)x->value.ptr = xs[i];
+            *(float*)y->value.ptr = ys[i];
+            *(uint8_t*)z->value.ptr = zs[i];
+
+            ecs_value_t v = {0}, ast_v = {0};
+            test_int(0, ecs_expr_eval(s, &v, &desc));
+            test_int(0, ecs_expr_eval(s, &ast_v, &ast_desc));
+            test_assert(v.type != 0);
+            test_assert(v.type == ast_v.type);
+
+            const ecs_type_info_t *ti = ecs_get_type_info(world, v.type);
+            test_assert(ti != NULL);
+            test_assert(!ecs_os_memcmp(v.ptr, ast_v.ptr, ti->size));
+
+            ecs_value_free(world, v.type, v.ptr);
+            ecs_value_free(world, ast_v.type, ast_v.ptr);
+        }
+
+        ecs_script_free(s);
+    }
+
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_parse_eval_bytecode_div_by_0(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_var_t *foo = ecs_script_vars_define(vars, "foo", ecs_i32_t);
+    *(int32_t*)foo->value.ptr = 0;
+
+    ecs_expr_eval_desc_t desc = { .vars = vars, .disable_folding = disable_folding };
+    ecs_script_t *s = ecs_expr_parse(world, "10 / $foo", &desc);
+    test_assert(s != NULL);
+
+    ecs_value_t v = {0};
+    ecs_log_set_level(-4);
+    test_assert(ecs_expr_eval(s, &v, &desc) != 0);
+    ecs_log_set_level(-1);
+
+    *(int32_t*)foo->value.ptr = 4;
+    test_int(0, ecs_expr_eval(s, &v, &desc));
+    test_assert(v.type == ecs_id(ecs_f64_t));
+    test_flt(*(double*)v.ptr, 2.5);
+    ecs_value_free(world, v.type, v.ptr);
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_eval_batch(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define(vars, "x", ecs_i32_t);
+    ecs_script_vars_define(vars, "y", ecs_i32_t);
+
+    ecs_expr_eval_desc_t desc = { .vars = vars, .disable_folding = disable_folding };
+    ecs_script_t *s = ecs_expr_parse(world, "$x + $y * 2", &desc);
+    test_assert(s != NULL);
+
+    int32_t x[200], y[200], out[200];
+    int32_t i;
+    for (i = 0; i < 200; i ++) {
+        x[i] = i;
+        y[i] = i * 3;
+    }
+
+    test_int(0, ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+        .count = 200,
+        .columns = {
+            { "x", ecs_id(ecs_i32_t), x },
+            { "y", ecs_id(ecs_i32_t), y }
+        },
+        .type = ecs_id(ecs_i32_t),
+        .out = out
+    }));
+
+    for (i = 0; i < 200; i ++) {
+        test_int(out[i], i + i * 6);
+    }
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_eval_batch_member(void) {
+    ecs_world_t *world = ecs_init();
+
+    typedef struct {
+        float x;
+        float y;
+    } Vec2;
+
+    ecs_entity_t t = ecs_struct(world, {
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define_id(vars, "p", t);
+
+    ecs_expr_eval_desc_t desc = { .vars = vars, .disable_folding = disable_folding };
+    ecs_script_t *s = ecs_expr_parse(world, "$p.x * 10 + $p.y", &desc);
+    test_assert(s != NULL);
+
+    Vec2 p[100];
+    float out[100];
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        p[i].x = (float)i;
+        p[i].y = 0.5f;
+    }
+
+    test_int(0, ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+        .count = 100,
+        .columns = {{ "p", t, p }},
+        .out = out
+    }));
+
+    for (i = 0; i < 100; i ++) {
+        test_flt(out[i], (float)i * 10 + 0.5f);
+    }
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_eval_batch_stride(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define(vars, "x", ecs_i64_t);
+
+    ecs_expr_eval_desc_t desc = { .vars = vars, .disable_folding = disable_folding };
+    ecs_script_t *s = ecs_expr_parse(world, "$x * 2", &desc);
+    test_assert(s != NULL);
+
+    int64_t x[10][2];
+    double out[10][3];
+    int32_t i;
+    for (i = 0; i < 10; i ++) {
+        x[i][0] = i;
+        x[i][1] = -1;
+        out[i][1] = -1;
+    }
+
+    test_int(0, ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+        .count = 10,
+        .columns = {{ "x", ecs_id(ecs_i64_t), x, ECS_SIZEOF(int64_t[2]) }},
+        .type = ecs_id(ecs_f64_t),
+        .out = out,
+        .out_stride = ECS_SIZEOF(double[3])
+    }));
+
+    for (i = 0; i < 10; i ++) {
+        test_flt(out[i][0], i * 2);
+        test_flt(out[i][1], -1);
+    }
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_eval_batch_w_vars(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define(vars, "x", ecs_i32_t);
+    ecs_script_var_t *scale = ecs_script_vars_define(vars, "scale", ecs_i32_t);
+    *(int32_t*)scale->value.ptr = 3;
+
+    ecs_expr_eval_desc_t desc = { .vars = vars, .disable_folding = disable_folding };
+    ecs_script_t *s = ecs_expr_parse(world, "$x * $scale", &desc);
+    test_assert(s != NULL);
+
+    int32_t x[5] = { 1, 2, 3, 4, 5 }, out[5];
+    int32_t i;
+
+    test_int(0, ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+        .count = 5,
+        .columns = {{ "x", ecs_id(ecs_i32_t), x }},
+        .vars = vars,
+        .type = ecs_id(ecs_i32_t),
+        .out = out
+    }));
+
+    for (i = 0; i < 5; i ++) {
+        test_int(out[i], x[i] * 3);
+    }
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_eval_batch_no_bytecode(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define(vars, "x", ecs_i32_t);
+    ecs_script_vars_define(vars, "y", ecs_i32_t);
+    ecs_script_vars_define(vars, "z", ecs_i32_t);
+
+    ecs_expr_eval_desc_t desc = { 
+        .vars = vars, 
+        .disable_folding = disable_folding,
+        .disable_bytecode = true 
+    };
+
+    ecs_script_t *s = ecs_expr_parse(world, "$x * $y - $z", &desc);
+    test_assert(s != NULL);
+
+    int32_t x[100], y[100], z[100], out[100];
+    int32_t i;
+    for (i = 0; i < 100; i ++) {
+        x[i] = i;
+        y[i] = i + 1;
+        z[i] = 1;
+    }
+
+    test_int(0, ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+        .count = 100,
+        .columns = {
+            { "x", ecs_id(ecs_i32_t), x },
+            { "y", ecs_id(ecs_i32_t), y },
+            { "z", ecs_id(ecs_i32_t), z }
+        },
+        .type = ecs_id(ecs_i32_t),
+        .out = out
+    }));
+
+    for (i = 0; i < 100; i ++) {
+        test_int(out[i], i * (i + 1) - 1);
+    }
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_eval_batch_string(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define(vars, "x", ecs_i32_t);
+
+    ecs_expr_eval_desc_t desc = { .vars = vars, .disable_folding = disable_folding };
+    ecs_script_t *s = ecs_expr_parse(world, "\"x = {$x}\"", &desc);
+    test_assert(s != NULL);
+
+    int32_t x[3] = { 10, 20, 30 };
+    char *out[3] = { NULL };
+
+    test_int(0, ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+        .count = 3,
+        .columns = {{ "x", ecs_id(ecs_i32_t), x }},
+        .out = out
+    }));
+
+    test_str(out[0], "x = 10");
+    test_str(out[1], "x = 20");
+    test_str(out[2], "x = 30");
+
+    ecs_os_free(out[0]);
+    ecs_os_free(out[1]);
+    ecs_os_free(out[2]);
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
+
+void Expr_eval_batch_div_by_0(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_script_vars_t *vars = ecs_script_vars_init(world);
+    ecs_script_vars_define(vars, "x", ecs_i32_t);
+
+    ecs_expr_eval_desc_t desc = { .vars = vars, .disable_folding = disable_folding };
+    ecs_script_t *s = ecs_expr_parse(world, "10 % $x", &desc);
+    test_assert(s != NULL);
+
+    int32_t x[3] = { 1, 0, 2 };
+    int64_t out[3];
+
+    ecs_log_set_level(-4);
+    test_assert(0 != ecs_expr_eval_batch(s, &(ecs_expr_eval_batch_desc_t){
+        .count = 3,
+        .columns = {{ "x", ecs_id(ecs_i32_t), x }},
+        .out = out
+    }));
+
+    ecs_script_free(s);
+    ecs_script_vars_fini(vars);
+
+    ecs_fini(world);
+}
@@ -2599,3 +2599,406 @@ void Template_template_w_for(void) {
 
     ecs_fini(world);
 }
+
+void Template_update_prop_keeps_entities(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    ecs_struct(world, {
+        .entity = ecs_id(Velocity),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    const char *expr =
+    HEAD "template Foo {"
+    LINE "  prop x = f32: 0"
+    LINE "  a { Position: {$x, 0} }"
+    LINE "  b { Velocity: {1, 2} }"
+    LINE "}"
+    LINE "Foo e(x: 10)";
+
+    test_assert(ecs_script_run(world, NULL, expr) == 0);
+
+    ecs_entity_t foo = ecs_lookup(world, "Foo");
+    test_assert(foo != 0);
+    ecs_entity_t e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    ecs_entity_t a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+    ecs_entity_t b = ecs_lookup(world, "e.b");
+    test_assert(b != 0);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 10);
+    }
+
+    /* Statement that doesn't depend on prop is not reevaluated */
+    ecs_set(world, b, Velocity, {100, 200});
+
+    float x = 20;
+    ecs_set_id(world, e, foo, sizeof(float), &x);
+
+    test_assert(ecs_is_alive(world, a));
+    test_assert(ecs_is_alive(world, b));
+    test_assert(ecs_lookup(world, "e.a") == a);
+    test_assert(ecs_lookup(world, "e.b") == b);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 20);
+    }
+
+    {
+        const Velocity *v = ecs_get(world, b, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 100);
+        test_int(v->y, 200);
+    }
+
+    ecs_fini(world);
+}
+
+void Template_update_prop_same_value(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    const char *expr =
+    HEAD "template Foo {"
+    LINE "  prop x = f32: 0"
+    LINE "  a { Position: {$x, 0} }"
+    LINE "}"
+    LINE "Foo e(x: 10)";
+
+    test_assert(ecs_script_run(world, NULL, expr) == 0);
+
+    ecs_entity_t foo = ecs_lookup(world, "Foo");
+    test_assert(foo != 0);
+    ecs_entity_t e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    ecs_entity_t a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+
+    ecs_set(world, a, Position, {30, 40});
+
+    float x = 10;
+    ecs_set_id(world, e, foo, sizeof(float), &x);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 30);
+        test_int(p->y, 40);
+    }
+
+    x = 11;
+    ecs_set_id(world, e, foo, sizeof(float), &x);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 11);
+        test_int(p->y, 0);
+    }
+
+    ecs_fini(world);
+}
+
+void Template_update_prop_w_const(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    ecs_struct(world, {
+        .entity = ecs_id(Velocity),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    const char *expr =
+    HEAD "template Foo {"
+    LINE "  prop x = f32: 0"
+    LINE "  prop y = f32: 0"
+    LINE "  const z = $x * 2"
+    LINE "  a { Position: {$z, 0} }"
+    LINE "  b { Velocity: {$y, 0} }"
+    LINE "}"
+    LINE "Foo e(x: 10, y: 20)";
+
+    test_assert(ecs_script_run(world, NULL, expr) == 0);
+
+    ecs_entity_t foo = ecs_lookup(world, "Foo");
+    test_assert(foo != 0);
+    ecs_entity_t e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    ecs_entity_t a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+    ecs_entity_t b = ecs_lookup(world, "e.b");
+    test_assert(b != 0);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 20);
+    }
+
+    ecs_set(world, b, Velocity, {100, 100});
+
+    float props[] = { 15, 20 };
+    ecs_set_id(world, e, foo, sizeof(props), props);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 30);
+    }
+
+    {
+        const Velocity *v = ecs_get(world, b, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 100);
+    }
+
+    props[1] = 25;
+    ecs_set_id(world, e, foo, sizeof(props), props);
+
+    {
+        const Velocity *v = ecs_get(world, b, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 25);
+    }
+
+    ecs_fini(world);
+}
+
+void Template_update_prop_w_if(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    const char *expr =
+    HEAD "template Foo {"
+    LINE "  prop flag = bool: false"
+    LINE "  if $flag {"
+    LINE "    a { Position: {10, 20} }"
+    LINE "  }"
+    LINE "  b {"
+    LINE "    if $flag {"
+    LINE "      Position: {30, 40}"
+    LINE "    } else {"
+    LINE "      Tag"
+    LINE "    }"
+    LINE "  }"
+    LINE "}"
+    LINE "Foo e(flag: true)";
+
+    test_assert(ecs_script_run(world, NULL, expr) == 0);
+
+    ecs_entity_t foo = ecs_lookup(world, "Foo");
+    test_assert(foo != 0);
+    ecs_entity_t e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    ecs_entity_t a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+    ecs_entity_t b = ecs_lookup(world, "e.b");
+    test_assert(b != 0);
+
+    test_assert(ecs_has(world, a, Position));
+    test_assert(ecs_has(world, b, Position));
+    test_assert(!ecs_has(world, b, Tag));
+
+    bool flag = false;
+    ecs_set_id(world, e, foo, sizeof(bool), &flag);
+
+    test_assert(!ecs_is_alive(world, a));
+    test_assert(ecs_lookup(world, "e.a") == 0);
+    test_assert(ecs_is_alive(world, b));
+    test_assert(ecs_lookup(world, "e.b") == b);
+    test_assert(!ecs_has(world, b, Position));
+    test_assert(ecs_has(world, b, Tag));
+
+    flag = true;
+    ecs_set_id(world, e, foo, sizeof(bool), &flag);
+
+    a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+    test_assert(ecs_has(world, a, Position));
+    test_assert(ecs_lookup(world, "e.b") == b);
+    test_assert(ecs_has(world, b, Position));
+    test_assert(!ecs_has(world, b, Tag));
+
+    ecs_fini(world);
+}
+
+void Template_update_prop_after_child_delete(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    const char *expr =
+    HEAD "template Foo {"
+    LINE "  prop x = f32: 0"
+    LINE "  a { Position: {1, 2} }"
+    LINE "}"
+    LINE "Foo e(x: 10)";
+
+    test_assert(ecs_script_run(world, NULL, expr) == 0);
+
+    ecs_entity_t foo = ecs_lookup(world, "Foo");
+    test_assert(foo != 0);
+    ecs_entity_t e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    ecs_entity_t a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+
+    ecs_delete(world, a);
+
+    float x = 10;
+    ecs_set_id(world, e, foo, sizeof(float), &x);
+
+    a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 1);
+        test_int(p->y, 2);
+    }
+
+    ecs_fini(world);
+}
+
+void Template_update_prop_after_instance_delete(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_f32_t)},
+            {"y", ecs_id(ecs_f32_t)}
+        }
+    });
+
+    const char *expr =
+    HEAD "template Foo {"
+    LINE "  prop x = f32: 0"
+    LINE "  a { Position: {$x, 0} }"
+    LINE "}"
+    LINE "Foo e(x: 10)";
+
+    test_assert(ecs_script_run(world, NULL, expr) == 0);
+
+    ecs_entity_t foo = ecs_lookup(world, "Foo");
+    test_assert(foo != 0);
+    ecs_entity_t e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+
+    ecs_remove_id(world, e, foo);
+    test_assert(ecs_lookup(world, "e.a") != 0);
+    ecs_delete(world, ecs_lookup(world, "e.a"));
+
+    /* Template is evaluated from scratch when it's added again */
+    float x = 20;
+    ecs_set_id(world, e, foo, sizeof(float), &x);
+
+    ecs_entity_t a = ecs_lookup(world, "e.a");
+    test_assert(a != 0);
+
+    {
+        const Position *p = ecs_get(world, a, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 20);
+    }
+
+    ecs_delete(world, e);
+    test_assert(!ecs_is_alive(world, a));
+
+    ecs_fini(world);
+}
+
+void Template_update_prop_w_string(void) {
+    ecs_world_t *world = ecs_init();
+
+    const char *expr =
+    HEAD "template Foo {"
+    LINE "  prop name = string: \"a\""
+    LINE "  \"child_$name\" {}"
+    LINE "}"
+    LINE "Foo e(name: \"a\")";
+
+    test_assert(ecs_script_run(world, NULL, expr) == 0);
+
+    ecs_entity_t foo = ecs_lookup(world, "Foo");
+    test_assert(foo != 0);
+    ecs_entity_t e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    ecs_entity_t child_a = ecs_lookup(world, "e.child_a");
+    test_assert(child_a != 0);
+
+    const char *name = "a";
+    ecs_set_id(world, e, foo, sizeof(char*), &name);
+    test_assert(ecs_lookup(world, "e.child_a") == child_a);
+
+    name = "b";
+    ecs_set_id(world, e, foo, sizeof(char*), &name);
+    test_assert(!ecs_is_alive(world, child_a));
+    test_assert(ecs_lookup(world, "e.child_a") == 0);
+    test_assert(ecs_lookup(world, "e.child_b") != 0);
+
+    ecs_fini(world);
+}
@@ -340,6 +340,13 @@ void Template_bulk_create_template(void);
 void Template_template_w_expr_w_self_ref(void);
 void Template_entity_w_assign_with_nested_template(void);
 void Template_template_w_for(void);
+void Template_update_prop_keeps_entities(void);
+void Template_update_prop_same_value(void);
+void Template_update_prop_w_const(void);
+void Template_update_prop_w_if(void);
+void Template_update_prop_after_child_delete(void);
+void Template_update_prop_after_instance_delete(void);
+void Template_update_prop_w_string(void);
 
 // Testsuite 'Error'
 void Error_multi_line_comment_after_newline_before_newline_scope_open(void);
@@ -658,6 +665,15 @@ void Expr_newline_at_start(void);
 void Expr_global_const_var(void);
 void Expr_scoped_global_const_var(void);
 void Expr_escape_newline(void);
+void Expr_parse_eval_bytecode_vs_ast(void);
+void Expr_parse_eval_bytecode_div_by_0(void);
+void Expr_eval_batch(void);
+void Expr_eval_batch_member(void);
+void Expr_eval_batch_stride(void);
+void Expr_eval_batch_w_vars(void);
+void Expr_eval_batch_no_bytecode(void);
+void Expr_eval_batch_string(void);
+void Expr_eval_batch_div_by_0(void);
 
 // Testsuite 'ExprAst'
 void ExprAst_binary_f32_var_add_f32_var(void);
@@ -2171,6 +2187,34 @@ bake_test_case Template_testcases[] = {
     {
         "template_w_for",
         Template_template_w_for
+    },
+    {
+        "update_prop_keeps_entities",
+        Template_update_prop_keeps_entities
+    },
+    {
+        "update_prop_same_value",
+        Template_update_prop_same_value
+    },
+    {
+        "update_prop_w_const",
+        Template_update_prop_w_const
+    },
+    {
+        "update_prop_w_if",
+        Template_update_prop_w_if
+    },
+    {
+        "update_prop_after_child_delete",
+        Template_update_prop_after_child_delete
+    },
+    {
+        "update_prop_after_instance_delete",
+        Template_update_prop_after_instance_delete
+    },
+    {
+        "update_prop_w_string",
+        Template_update_prop_w_string
     }
 };
 
@@ -3429,6 +3473,42 @@ bake_test_case Expr_testcases[] = {
     {
         "escape_newline",
         Expr_escape_newline
+    },
+    {
+        "parse_eval_bytecode_vs_ast",
+        Expr_parse_eval_bytecode_vs_ast
+    },
+    {
+        "parse_eval_bytecode_div_by_0",
+        Expr_parse_eval_bytecode_div_by_0
+    },
+    {
+        "eval_batch",
+        Expr_eval_batch
+    },
+    {
+        "eval_batch_member",
+        Expr_eval_batch_member
+    },
+    {
+        "eval_batch_stride",
+        Expr_eval_batch_stride
+    },
+    {
+        "eval_batch_w_vars",
+        Expr_eval_batch_w_vars
+    },
+    {
+        "eval_batch_no_bytecode",
+        Expr_eval_batch_no_bytecode
+    },
+    {
+        "eval_batch_string",
+        Expr_eval_batch_string
+    },
+    {
+        "eval_batch_div_by_0",
+        Expr_eval_batch_div_by_0
     }
 };
 
@@ -4196,7 +4276,7 @@ static bake_test_suite suites[] = {
         "Template",
         NULL,
         NULL,
-        50,
+        57,
         Template_testcases
     },
     {
@@ -4210,7 +4290,7 @@ static bake_test_suite suites[] = {
         "Expr",
         Expr_setup,
         NULL,
-        232,
+        241,
         Expr_testcases,
         1,
         Expr_params